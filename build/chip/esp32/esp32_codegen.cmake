@@ -60,6 +60,7 @@ macro(chip_app_component_zapgen ZAP_NAME)
       GENERATOR "app-templates"
       OUTPUTS
             "zap-generated/access.h"
+            "zap-generated/attribute_access_tables.h"
             "zap-generated/CHIPClusters.h"
             "zap-generated/endpoint_config.h"
             "zap-generated/gen_config.h"
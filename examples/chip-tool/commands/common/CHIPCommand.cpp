@@ -42,8 +42,9 @@ constexpr chip::FabricId kIdentityAlphaFabricId = 1;
 constexpr chip::FabricId kIdentityBetaFabricId  = 2;
 constexpr chip::FabricId kIdentityGammaFabricId = 3;
 constexpr chip::FabricId kIdentityOtherFabricId = 4;
-constexpr char kPAATrustStorePathVariable[]     = "CHIPTOOL_PAA_TRUST_STORE_PATH";
-constexpr char kCDTrustStorePathVariable[]      = "CHIPTOOL_CD_TRUST_STORE_PATH";
+constexpr char kPAATrustStorePathVariable[]      = "CHIPTOOL_PAA_TRUST_STORE_PATH";
+constexpr char kPAATrustStoreIndexPathVariable[] = "CHIPTOOL_PAA_TRUST_STORE_INDEX_PATH";
+constexpr char kCDTrustStorePathVariable[]       = "CHIPTOOL_CD_TRUST_STORE_PATH";
 
 const chip::Credentials::AttestationTrustStore * CHIPCommand::sTrustStore = nullptr;
 chip::Credentials::GroupDataProviderImpl CHIPCommand::sGroupDataProvider{ kMaxGroupsPerFabric, kMaxGroupKeysPerFabric };
@@ -55,20 +56,26 @@ chip::app::CheckInHandler CHIPCommand::sCheckInHandler;
 
 namespace {
 
-CHIP_ERROR GetAttestationTrustStore(const char * paaTrustStorePath, const chip::Credentials::AttestationTrustStore ** trustStore)
+CHIP_ERROR GetAttestationTrustStore(const char * paaTrustStorePath, const char * paaTrustStoreIndexPath,
+                                    const chip::Credentials::AttestationTrustStore ** trustStore)
 {
     if (paaTrustStorePath == nullptr)
     {
         paaTrustStorePath = getenv(kPAATrustStorePathVariable);
     }
 
+    if (paaTrustStoreIndexPath == nullptr)
+    {
+        paaTrustStoreIndexPath = getenv(kPAATrustStoreIndexPathVariable);
+    }
+
     if (paaTrustStorePath == nullptr)
     {
         *trustStore = chip::Credentials::GetTestAttestationTrustStore();
         return CHIP_NO_ERROR;
     }
 
-    static chip::Credentials::FileAttestationTrustStore attestationTrustStore{ paaTrustStorePath };
+    static chip::Credentials::FileAttestationTrustStore attestationTrustStore{ paaTrustStorePath, paaTrustStoreIndexPath };
 
     if (paaTrustStorePath != nullptr && attestationTrustStore.paaCount() == 0)
     {
@@ -139,7 +146,8 @@ CHIP_ERROR CHIPCommand::MaybeSetUpStack()
     factoryInitParams.listenPort = port;
     ReturnLogErrorOnFailure(DeviceControllerFactory::GetInstance().Init(factoryInitParams));
 
-    ReturnErrorOnFailure(GetAttestationTrustStore(mPaaTrustStorePath.ValueOr(nullptr), &sTrustStore));
+    ReturnErrorOnFailure(
+        GetAttestationTrustStore(mPaaTrustStorePath.ValueOr(nullptr), mPaaTrustStoreIndexPath.ValueOr(nullptr), &sTrustStore));
 
     ReturnLogErrorOnFailure(sCheckInDelegate.Init(&sICDClientStorage));
     ReturnLogErrorOnFailure(sCheckInHandler.Init(DeviceControllerFactory::GetInstance().GetSystemState()->ExchangeMgr(),
@@ -70,6 +70,9 @@ public:
         AddArgument("paa-trust-store-path", &mPaaTrustStorePath,
                     "Path to directory holding PAA certificate information.  Can be absolute or relative to the current working "
                     "directory.");
+        AddArgument("paa-trust-store-index-path", &mPaaTrustStoreIndexPath,
+                    "Path to a file where the PAA trust store index is persisted, so that unchanged PAA certificates are not "
+                    "read again on later runs.");
         AddArgument("cd-trust-store-path", &mCDTrustStorePath,
                     "Path to directory holding CD certificate information.  Can be absolute or relative to the current working "
                     "directory.");
@@ -217,6 +220,7 @@ private:
     chip::Optional<chip::VendorId> mCommissionerVendorId;
     chip::Optional<uint16_t> mBleAdapterId;
     chip::Optional<char *> mPaaTrustStorePath;
+    chip::Optional<char *> mPaaTrustStoreIndexPath;
     chip::Optional<char *> mCDTrustStorePath;
     chip::Optional<bool> mUseMaxSizedCerts;
     chip::Optional<bool> mOnlyAllowTrustedCdKeys;
@@ -22,7 +22,8 @@
 #include "commands/common/Commands.h"
 #include "commands/interactive/InteractiveCommands.h"
 
-void registerCommandsInteractive(Commands & commands, CredentialIssuerCommands * credsIssuerConfig)
+void registerCommandsInteractive(Commands & commands, CredentialIssuerCommands * credsIssuerConfig,
+                                 InteractiveBatchCommand::CommandsFactory commandsFactory)
 {
     const char * clusterName = "interactive";
 
@@ -30,6 +31,7 @@ void registerCommandsInteractive(Commands & commands, CredentialIssuerCommands *
 #if CONFIG_USE_INTERACTIVE_MODE
         make_unique<InteractiveStartCommand>(&commands, credsIssuerConfig),
         make_unique<InteractiveServerCommand>(&commands, credsIssuerConfig),
+        ::make_unique<InteractiveBatchCommand>(&commands, commandsFactory, credsIssuerConfig),
 #endif // CONFIG_USE_INTERACTIVE_MODE
     };
 
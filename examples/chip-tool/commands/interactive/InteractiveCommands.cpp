@@ -18,16 +18,28 @@
 
 #include "InteractiveCommands.h"
 
+#include <lib/support/jsontlv/TlvJson.h>
 #include <platform/logging/LogV.h>
 
 #include <editline.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <thread>
+
 constexpr char kInteractiveModePrompt[]          = ">>> ";
 constexpr char kInteractiveModeHistoryFileName[] = "chip_tool_history";
 constexpr char kInteractiveModeStopCommand[]     = "quit()";
 constexpr char kCategoryError[]                  = "Error";
 constexpr char kCategoryProgress[]               = "Info";
 constexpr char kCategoryDetail[]                 = "Debug";
+constexpr char kBatchModeCommentPrefix           = '#';
+constexpr uint16_t kBatchModeDefaultMaxInFlight  = 8;
 
 namespace {
 
@@ -43,6 +55,16 @@ void ENFORCE_FORMAT(3, 0) LoggingCallback(const char * module, uint8_t category,
     ClearLine();
 }
 
+void ENFORCE_FORMAT(3, 0) BatchLoggingCallback(const char * module, uint8_t category, const char * msg, va_list args)
+{
+    // stdout carries the JSON result stream of the batch, so the logs go to stderr instead.
+    flockfile(stderr);
+    fprintf(stderr, "CHIP:%s: ", module);
+    vfprintf(stderr, msg, args);
+    fprintf(stderr, "\n");
+    funlockfile(stderr);
+}
+
 class ScopedLock
 {
 public:
@@ -378,6 +400,182 @@ CHIP_ERROR InteractiveStartCommand::RunCommand()
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR InteractiveBatchCommand::ReadCommands(std::vector<std::string> & commands)
+{
+    std::ifstream file;
+    if (mInputPath.HasValue())
+    {
+        file.open(mInputPath.Value());
+        if (!file.is_open())
+        {
+            ChipLogError(chipTool, "Can not open %s", mInputPath.Value());
+            return CHIP_ERROR_OPEN_FAILED;
+        }
+    }
+    std::istream & input = mInputPath.HasValue() ? file : std::cin;
+
+    std::string line;
+    while (std::getline(input, line))
+    {
+        line.erase(0, line.find_first_not_of(" \t"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (line.empty() || line[0] == kBatchModeCommentPrefix)
+        {
+            continue;
+        }
+
+        if (line == kInteractiveModeStopCommand)
+        {
+            break;
+        }
+
+        commands.push_back(line);
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+Commands * InteractiveBatchCommand::GetHandler(size_t index)
+{
+    if (index == 0)
+    {
+        return mHandler;
+    }
+
+    while (mAdditionalHandlers.size() < index)
+    {
+        mAdditionalHandlers.push_back(mCommandsFactory());
+    }
+    return mAdditionalHandlers[index - 1].get();
+}
+
+CHIP_ERROR InteractiveBatchCommand::RunCommand()
+{
+    std::vector<std::string> commands;
+    ReturnErrorOnFailure(ReadCommands(commands));
+
+    std::ofstream outputFile;
+    if (mOutputPath.HasValue())
+    {
+        outputFile.open(mOutputPath.Value());
+        VerifyOrReturnError(outputFile.is_open(), CHIP_ERROR_OPEN_FAILED,
+                            ChipLogError(chipTool, "Can not open %s", mOutputPath.Value()));
+    }
+    std::ostream & output = mOutputPath.HasValue() ? outputFile : std::cout;
+    if (!mOutputPath.HasValue())
+    {
+        chip::Logging::SetLogRedirectCallback(BatchLoggingCallback);
+    }
+
+    const size_t inFlight = std::min<size_t>(mMaxInFlight.ValueOr(kBatchModeDefaultMaxInFlight), commands.size());
+
+    std::vector<Commands *> handlers;
+    for (size_t i = 0; i < inFlight; i++)
+    {
+        handlers.push_back(GetHandler(i));
+    }
+
+    std::atomic<size_t> nextCommand{ 0 };
+    std::mutex outputMutex;
+    std::vector<double> latencies(commands.size());
+    size_t failures = 0;
+
+    // Every worker runs one command at a time on its own set of command objects. The commands themselves
+    // are still run on the Matter thread, which is where they spend their time waiting for the devices.
+    auto worker = [&](Commands * handler) {
+        for (size_t index = nextCommand++; index < commands.size(); index = nextCommand++)
+        {
+            const std::string & command = commands[index];
+
+            int status = EXIT_FAILURE;
+            auto start = std::chrono::steady_clock::now();
+            if (command.compare(0, strlen("interactive "), "interactive ") == 0)
+            {
+                ChipLogError(chipTool, "Interactive mode commands can not be batched: %s", command.c_str());
+            }
+            else
+            {
+                status = handler->RunInteractive(command.c_str(), GetStorageDirectory(), NeedsOperationalAdvertising());
+            }
+            std::chrono::duration<double, std::milli> latency = std::chrono::steady_clock::now() - start;
+
+            Json::Value result;
+            result["index"]     = static_cast<Json::UInt64>(index);
+            result["command"]   = command;
+            result["status"]    = (status == EXIT_SUCCESS) ? "success" : "failure";
+            result["latencyMs"] = latency.count();
+
+            auto lock        = ScopedLock(outputMutex);
+            latencies[index] = latency.count();
+            failures += (status == EXIT_SUCCESS) ? 0 : 1;
+            output << chip::JsonToString(result) << std::endl;
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (auto * handler : handlers)
+    {
+        workers.emplace_back(worker, handler);
+    }
+    for (auto & thread : workers)
+    {
+        thread.join();
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](size_t percent) {
+        return latencies.empty() ? 0.0 : latencies[(latencies.size() - 1) * percent / 100];
+    };
+
+    double totalLatency = 0;
+    for (auto latency : latencies)
+    {
+        totalLatency += latency;
+    }
+
+    Json::Value summary;
+    summary["commands"]          = static_cast<Json::UInt64>(commands.size());
+    summary["failures"]          = static_cast<Json::UInt64>(failures);
+    summary["maxInFlight"]       = static_cast<Json::UInt64>(inFlight);
+    summary["elapsedMs"]         = elapsed.count();
+    summary["latencyMs"]["min"]  = percentile(0);
+    summary["latencyMs"]["mean"] = latencies.empty() ? 0.0 : totalLatency / static_cast<double>(latencies.size());
+    summary["latencyMs"]["p50"]  = percentile(50);
+    summary["latencyMs"]["p90"]  = percentile(90);
+    summary["latencyMs"]["p99"]  = percentile(99);
+    summary["latencyMs"]["max"]  = percentile(100);
+
+    Json::Value root;
+    root["summary"] = summary;
+    output << chip::JsonToString(root) << std::endl;
+
+    // Like quit() in interactive mode, clean up the commands that deferred it (e.g. subscriptions) while their command
+    // objects are still around.
+    std::promise<void> cleanedUp;
+    CHIP_ERROR err = chip::DeviceLayer::PlatformMgr().ScheduleWork(RunDeferredCleanups, reinterpret_cast<intptr_t>(&cleanedUp));
+    if (err == CHIP_NO_ERROR)
+    {
+        cleanedUp.get_future().wait();
+    }
+    LogErrorOnFailure(err);
+
+    if (!mOutputPath.HasValue())
+    {
+        chip::Logging::SetLogRedirectCallback(nullptr);
+    }
+
+    SetCommandExitStatus(failures == 0 ? CHIP_NO_ERROR : CHIP_ERROR_INTERNAL);
+    return CHIP_NO_ERROR;
+}
+
+void InteractiveBatchCommand::RunDeferredCleanups(intptr_t context)
+{
+    ExecuteDeferredCleanups(0);
+    reinterpret_cast<std::promise<void> *>(context)->set_value();
+}
+
 bool InteractiveCommand::ParseCommand(char * command, int * status)
 {
     if (strcmp(command, kInteractiveModeStopCommand) == 0)
@@ -24,6 +24,10 @@
 
 #include <websocket-server/WebSocketServer.h>
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 class Commands;
 
 class InteractiveCommand : public CHIPCommand
@@ -44,8 +48,10 @@ public:
 
     bool ParseCommand(char * command, int * status);
 
-private:
+protected:
     Commands * mHandler = nullptr;
+
+private:
     chip::Optional<bool> mAdvertiseOperational;
 };
 
@@ -65,6 +71,44 @@ private:
     std::string GetHistoryFilePath() const;
 };
 
+class InteractiveBatchCommand : public InteractiveCommand
+{
+public:
+    // Builds an additional, fully registered, command handler. Every command that is in flight needs its own
+    // command objects since those hold the parsed arguments and the state of the running command.
+    using CommandsFactory = std::function<std::unique_ptr<Commands>()>;
+
+    InteractiveBatchCommand(Commands * commandsHandler, CommandsFactory commandsFactory,
+                            CredentialIssuerCommands * credsIssuerConfig) :
+        InteractiveCommand("batch", commandsHandler,
+                           "Run the commands read from a file or stdin, one per line, keeping several of them in flight.",
+                           credsIssuerConfig),
+        mCommandsFactory(commandsFactory)
+    {
+        AddArgument("input", &mInputPath, "File to read the commands from. Defaults to stdin.");
+        AddArgument("output", &mOutputPath,
+                    "File to write the JSON result stream to. Defaults to stdout, in which case the logs go to stderr.");
+        AddArgument("max-in-flight", 1, UINT16_MAX, &mMaxInFlight, "Number of commands run concurrently. Defaults to 8.");
+    }
+
+    /////////// CHIPCommand Interface /////////
+    CHIP_ERROR RunCommand() override;
+
+private:
+    CHIP_ERROR ReadCommands(std::vector<std::string> & commands);
+    Commands * GetHandler(size_t index);
+    static void RunDeferredCleanups(intptr_t context);
+
+    CommandsFactory mCommandsFactory;
+    // Handlers for the in-flight commands beyond the first one. Commands with deferred cleanups (e.g. subscriptions)
+    // are cleaned up at the end of the run, before the handlers go away.
+    std::vector<std::unique_ptr<Commands>> mAdditionalHandlers;
+
+    chip::Optional<char *> mInputPath;
+    chip::Optional<char *> mOutputPath;
+    chip::Optional<uint16_t> mMaxInFlight;
+};
+
 class InteractiveServerCommand : public InteractiveCommand, public WebSocketServerDelegate, public RemoteDataModelLoggerDelegate
 {
 public:
@@ -32,6 +32,29 @@
 
 #include <zap-generated/cluster/Commands.h>
 
+namespace {
+
+void registerCommands(Commands & commands, CredentialIssuerCommands * credIssuerCommands)
+{
+    registerCommandsDelay(commands, credIssuerCommands);
+    registerCommandsDiscover(commands, credIssuerCommands);
+    registerCommandsICD(commands, credIssuerCommands);
+    registerCommandsInteractive(commands, credIssuerCommands, [credIssuerCommands]() {
+        auto batchCommands = std::make_unique<Commands>();
+        registerCommands(*batchCommands, credIssuerCommands);
+        return batchCommands;
+    });
+    registerCommandsPayload(commands);
+    registerCommandsPairing(commands, credIssuerCommands);
+    registerCommandsGroup(commands, credIssuerCommands);
+    registerClusters(commands, credIssuerCommands);
+    registerCommandsSubscriptions(commands, credIssuerCommands);
+    registerCommandsStorage(commands);
+    registerCommandsSessionManagement(commands, credIssuerCommands);
+}
+
+} // namespace
+
 // ================================================================================
 // Main Code
 // ================================================================================
@@ -39,17 +62,7 @@ int main(int argc, char * argv[])
 {
     ExampleCredentialIssuerCommands credIssuerCommands;
     Commands commands;
-    registerCommandsDelay(commands, &credIssuerCommands);
-    registerCommandsDiscover(commands, &credIssuerCommands);
-    registerCommandsICD(commands, &credIssuerCommands);
-    registerCommandsInteractive(commands, &credIssuerCommands);
-    registerCommandsPayload(commands);
-    registerCommandsPairing(commands, &credIssuerCommands);
-    registerCommandsGroup(commands, &credIssuerCommands);
-    registerClusters(commands, &credIssuerCommands);
-    registerCommandsSubscriptions(commands, &credIssuerCommands);
-    registerCommandsStorage(commands);
-    registerCommandsSessionManagement(commands, &credIssuerCommands);
+    registerCommands(commands, &credIssuerCommands);
 
     return commands.Run(argc, argv);
 }
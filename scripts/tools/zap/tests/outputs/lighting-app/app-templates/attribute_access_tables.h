@@ -0,0 +1,42 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+// THIS FILE IS GENERATED BY ZAP
+
+// Prevent multiple inclusion
+#pragma once
+
+#include <app/util/attribute-access-table.h>
+
+// Lookup tables for the attributes of the fixed endpoints, built by the
+// compiler from the arrays of endpoint_config.h so that they always match
+// them. This is expanded by the attribute storage after those arrays when
+// CHIP_CONFIG_ATTRIBUTE_ACCESS_TABLES is enabled.
+// clang-format off
+#define GENERATED_ATTRIBUTE_ACCESS_TABLE \
+  constexpr const uint8_t generatedAccessTableFixedEndpointTypes[] = FIXED_ENDPOINT_TYPES; \
+  constexpr const chip::app::AttributeAccessTable< \
+      ArraySize(generatedAttributes), \
+      ArraySize(generatedClusters), \
+      ArraySize(generatedEmberAfEndpointTypes), \
+      ArraySize(generatedAccessTableFixedEndpointTypes), \
+      chip::app::AttributeAccessTableClusterSlotCount(generatedEmberAfEndpointTypes), \
+      chip::app::AttributeAccessTableAttributeSlotCount(generatedClusters)> \
+    generatedAttributeAccessTable(generatedAttributes, generatedClusters, generatedEmberAfEndpointTypes, \
+                                  generatedAccessTableFixedEndpointTypes); \
+  static_assert(generatedAttributeAccessTable.IsValid(), "Attribute access tables do not match endpoint_config.h");
+// clang-format on
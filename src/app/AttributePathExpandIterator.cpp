@@ -170,6 +170,26 @@ void AttributePathExpandIterator::ResetCurrentCluster()
     Next();
 }
 
+void AttributePathExpandIterator::SkipCurrentCluster()
+{
+    // A concrete path is emitted once, so the next call to Next() moves past its cluster anyway.
+    VerifyOrReturn(mpAttributePath != nullptr && mpAttributePath->mValue.IsWildcardPath());
+
+    // Exhaust the attribute ranges of the current cluster, Next() will then continue with the next cluster.
+    mAttributeIndex       = mEndAttributeIndex;
+    mGlobalAttributeIndex = mGlobalAttributeEndIndex;
+}
+
+void AttributePathExpandIterator::SkipCurrentEndpoint()
+{
+    VerifyOrReturn(mpAttributePath != nullptr && mpAttributePath->mValue.IsWildcardPath());
+
+    // The iterator points to a path of the current endpoint, so mClusterIndex < mEndClusterIndex.  Move to its last cluster rather
+    // than past it, so Next() does not mistake the index for the start of a new endpoint.
+    mClusterIndex = static_cast<uint8_t>(mEndClusterIndex - 1);
+    SkipCurrentCluster();
+}
+
 bool AttributePathExpandIterator::Next()
 {
     for (; mpAttributePath != nullptr; (mpAttributePath = mpAttributePath->mpNext, mEndpointIndex = UINT16_MAX))
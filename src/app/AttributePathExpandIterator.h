@@ -97,6 +97,18 @@ public:
      */
     void ResetCurrentCluster();
 
+    /**
+     * Make the next call to Next() skip the remaining paths of the cluster the iterator currently points to, when it is expanding
+     * a wildcard attribute id, so a whole cluster can be passed over without walking its attribute metadata.
+     */
+    void SkipCurrentCluster();
+
+    /**
+     * Make the next call to Next() skip the remaining paths of the endpoint the iterator currently points to, when it is expanding
+     * a wildcard path.
+     */
+    void SkipCurrentEndpoint();
+
     /**
      * Returns if the iterator is valid (not exhausted). An iterator is exhausted if and only if:
      * - Next() is called after iterating last path.
@@ -24,11 +24,21 @@ namespace chip {
 CHIP_ERROR CASESessionManager::Init(chip::System::Layer * systemLayer, const CASESessionManagerConfig & params)
 {
     ReturnErrorOnFailure(params.sessionInitParams.Validate());
-    mConfig = params;
+    mConfig      = params;
+    mSystemLayer = systemLayer;
     params.sessionInitParams.exchangeMgr->GetReliableMessageMgr()->RegisterSessionUpdateDelegate(this);
     return AddressResolve::Resolver::Instance().Init(systemLayer);
 }
 
+void CASESessionManager::Shutdown()
+{
+    if (mSystemLayer != nullptr)
+    {
+        mSystemLayer->CancelTimer(AdmitWaitingSessionSetups, this);
+        mSystemLayer = nullptr;
+    }
+}
+
 void CASESessionManager::FindOrEstablishSession(const ScopedNodeId & peerId, Callback::Callback<OnDeviceConnected> * onConnection,
                                                 Callback::Callback<OnDeviceConnectionFailure> * onFailure
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
@@ -136,6 +146,7 @@ void CASESessionManager::FindOrEstablishSessionHelper(const ScopedNodeId & peerI
 void CASESessionManager::ReleaseSessionsForFabric(FabricIndex fabricIndex)
 {
     mConfig.sessionSetupPool->ReleaseAllSessionSetupsForFabric(fabricIndex);
+    OnCASEClientReleased();
 }
 
 void CASESessionManager::ReleaseAllSessions()
@@ -193,6 +204,37 @@ void CASESessionManager::ReleaseSession(OperationalSessionSetup * session)
     if (session != nullptr)
     {
         mConfig.sessionSetupPool->Release(session);
+        // The released session setup may have been holding a CASE client.
+        OnCASEClientReleased();
+    }
+}
+
+void CASESessionManager::OnCASEClientReleased()
+{
+    VerifyOrReturn(mSystemLayer != nullptr);
+
+    // Admit waiting session setups asynchronously: the caller may be in the
+    // middle of a state transition (or about to be destroyed), and admitting a
+    // session setup may synchronously notify its consumers.  Restarting the
+    // timer also coalesces bursts of releases into a single admission pass.
+    CHIP_ERROR err = mSystemLayer->StartTimer(System::Clock::kZero, AdmitWaitingSessionSetups, this);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(CASESessionManager, "Failed to schedule CASE client admission: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
+void CASESessionManager::AdmitWaitingSessionSetups(System::Layer * systemLayer, void * context)
+{
+    auto * self = static_cast<CASESessionManager *>(context);
+
+    while (OperationalSessionSetup * sessionSetup = self->mConfig.sessionSetupPool->FindSessionSetupWaitingForCASEClient())
+    {
+        if (!sessionSetup->AdmitWaitingForCASEClient())
+        {
+            // Still no free CASE client; we will be called again once one is released.
+            break;
+        }
     }
 }
 
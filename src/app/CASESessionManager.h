@@ -53,6 +53,7 @@ public:
     CASESessionManager() = default;
     virtual ~CASESessionManager()
     {
+        Shutdown();
         if (mConfig.sessionInitParams.Validate() == CHIP_NO_ERROR)
         {
             mConfig.sessionInitParams.exchangeMgr->GetReliableMessageMgr()->RegisterSessionUpdateDelegate(nullptr);
@@ -60,7 +61,7 @@ public:
     }
 
     CHIP_ERROR Init(chip::System::Layer * systemLayer, const CASESessionManagerConfig & params);
-    void Shutdown() {}
+    void Shutdown();
 
     /**
      * Find an existing session for the given node ID, or trigger a new session
@@ -160,6 +161,7 @@ public:
 
     //////////// OperationalSessionReleaseDelegate Implementation ///////////////
     void ReleaseSession(OperationalSessionSetup * device) override;
+    void OnCASEClientReleased() override;
 
     //////////// SessionUpdateDelegate Implementation ///////////////
     void UpdatePeerAddress(ScopedNodeId peerId) override;
@@ -177,7 +179,14 @@ private:
 #endif
     );
 
+    /**
+     * Starts the CASE handshakes of session setups waiting for a CASE client,
+     * longest-waiting first, for as long as CASE clients are available.
+     */
+    static void AdmitWaitingSessionSetups(System::Layer * systemLayer, void * context);
+
     CASESessionManagerConfig mConfig;
+    System::Layer * mSystemLayer = nullptr;
 };
 
 } // namespace chip
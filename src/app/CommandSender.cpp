@@ -502,6 +502,12 @@ TLV::TLVWriter * CommandSender::GetCommandDataIBTLVWriter()
     return mInvokeRequestBuilder.GetInvokeRequests().GetCommandData().GetWriter();
 }
 
+void CommandSender::RollbackCommand(const TLV::TLVWriter & aBackupWriter)
+{
+    mInvokeRequestBuilder.GetInvokeRequests().Rollback(aBackupWriter);
+    MoveToState(State::AddedCommand);
+}
+
 CHIP_ERROR CommandSender::FinishCommand(const Optional<uint16_t> & aTimedInvokeTimeoutMs,
                                         const AdditionalCommandParameters & aOptionalArgs)
 {
@@ -419,13 +419,36 @@ private:
     CHIP_ERROR AddRequestDataInternal(const CommandPathParams & aCommandPath, const CommandDataT & aData,
                                       const Optional<uint16_t> & aTimedInvokeTimeoutMs, AdditionalCommandParameters & aOptionalArgs)
     {
-        ReturnErrorOnFailure(PrepareCommand(aCommandPath, aOptionalArgs));
-        TLV::TLVWriter * writer = GetCommandDataIBTLVWriter();
-        VerifyOrReturnError(writer != nullptr, CHIP_ERROR_INCORRECT_STATE);
-        ReturnErrorOnFailure(DataModel::Encode(*writer, TLV::ContextTag(CommandDataIB::Tag::kFields), aData));
-        return FinishCommand(aTimedInvokeTimeoutMs, aOptionalArgs);
+        // When adding to a batch that already holds commands, a failure (typically the new command not fitting in
+        // the message) must not corrupt the commands already added, so that they can still be sent.
+        TLV::TLVWriter backupWriter;
+        bool canRollback = (mState == State::AddedCommand);
+        if (canRollback)
+        {
+            mInvokeRequestBuilder.GetInvokeRequests().Checkpoint(backupWriter);
+        }
+
+        CHIP_ERROR err = PrepareCommand(aCommandPath, aOptionalArgs);
+        if (err == CHIP_NO_ERROR)
+        {
+            TLV::TLVWriter * writer = GetCommandDataIBTLVWriter();
+            VerifyOrReturnError(writer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+            err = DataModel::Encode(*writer, TLV::ContextTag(CommandDataIB::Tag::kFields), aData);
+        }
+        if (err == CHIP_NO_ERROR)
+        {
+            err = FinishCommand(aTimedInvokeTimeoutMs, aOptionalArgs);
+        }
+
+        if (err != CHIP_NO_ERROR && canRollback)
+        {
+            RollbackCommand(backupWriter);
+        }
+        return err;
     }
 
+    void RollbackCommand(const TLV::TLVWriter & aBackupWriter);
+
 public:
     // Sends a queued up command request to the target encapsulated by the secureSession handle.
     //
@@ -43,27 +43,32 @@ CHIP_ERROR DefaultAttributePersistenceProvider::InternalReadValue(const StorageK
 
     uint16_t size = static_cast<uint16_t>(min(aValue.size(), static_cast<size_t>(UINT16_MAX)));
     ReturnErrorOnFailure(mStorage->SyncGetKeyValue(aKey.KeyName(), aValue.data(), size));
-    EmberAfAttributeType type = aType;
-    if (emberAfIsStringAttributeType(type))
+    aValue.reduce_size(size);
+    return CheckReadValue(aType, aSize, aValue);
+}
+
+CHIP_ERROR DefaultAttributePersistenceProvider::CheckReadValue(EmberAfAttributeType aType, size_t aSize, const ByteSpan & aValue)
+{
+    const size_t size = aValue.size();
+    if (emberAfIsStringAttributeType(aType))
     {
         // Ensure that we've read enough bytes that we are not ending up with
         // un-initialized memory.  Should have read length + 1 (for the length
         // byte).
-        VerifyOrReturnError(size >= emberAfStringLength(aValue.data()) + 1, CHIP_ERROR_INCORRECT_STATE);
+        VerifyOrReturnError(size >= 1 && size >= emberAfStringLength(aValue.data()) + 1u, CHIP_ERROR_INCORRECT_STATE);
     }
-    else if (emberAfIsLongStringAttributeType(type))
+    else if (emberAfIsLongStringAttributeType(aType))
     {
         // Ensure that we've read enough bytes that we are not ending up with
         // un-initialized memory.  Should have read length + 2 (for the length
         // bytes).
-        VerifyOrReturnError(size >= emberAfLongStringLength(aValue.data()) + 2, CHIP_ERROR_INCORRECT_STATE);
+        VerifyOrReturnError(size >= 2 && size >= emberAfLongStringLength(aValue.data()) + 2u, CHIP_ERROR_INCORRECT_STATE);
     }
     else
     {
         // Ensure we got the expected number of bytes for all other types.
         VerifyOrReturnError(size == aSize, CHIP_ERROR_INVALID_ARGUMENT);
     }
-    aValue.reduce_size(size);
     return CHIP_NO_ERROR;
 }
 
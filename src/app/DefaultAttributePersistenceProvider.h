@@ -59,6 +59,9 @@ public:
     CHIP_ERROR SafeReadValue(const ConcreteAttributePath & aPath, MutableByteSpan & aValue) override;
 
 protected:
+    // Checks that aValue, read from storage, is a complete value of the given type and size.
+    static CHIP_ERROR CheckReadValue(EmberAfAttributeType aType, size_t aSize, const ByteSpan & aValue);
+
     PersistentStorageDelegate * mStorage;
 
 private:
@@ -98,5 +98,48 @@ CHIP_ERROR LogEvent(const T & aEventData, EndpointId aEndpoint, EventNumber & aE
     return logMgmt.LogEvent(&eventData, eventOptions, aEventNumber);
 }
 
+#if CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+/**
+ * @brief
+ *   Stage an event from any thread, without holding the CHIP stack lock.
+ *
+ * The event data is encoded right away on the calling thread; the event gets
+ * its event number when the CHIP thread merges it into the event log.  See
+ * EventManagement::StageEvent.
+ *
+ * StageEvent has 2 variant, one for fabric-scoped events and one for non-fabric-scoped events.
+ * @param[in] aEventData  The event cluster object
+ * @param[in] aEndpoint    The current cluster's Endpoint Id
+ *
+ * @return CHIP_ERROR  CHIP Error Code
+ */
+template <typename T, std::enable_if_t<DataModel::IsFabricScoped<T>::value, bool> = true>
+CHIP_ERROR StageEvent(const T & aEventData, EndpointId aEndpoint)
+{
+    EventLogger<T> eventData(aEventData);
+    ConcreteEventPath path(aEndpoint, aEventData.GetClusterId(), aEventData.GetEventId());
+    EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    EventOptions eventOptions;
+    eventOptions.mPath        = path;
+    eventOptions.mPriority    = aEventData.GetPriorityLevel();
+    eventOptions.mFabricIndex = aEventData.GetFabricIndex();
+    // this skips staging the event if it's fabric-scoped but no fabric association exists yet.
+    VerifyOrReturnError(eventOptions.mFabricIndex != kUndefinedFabricIndex, CHIP_ERROR_INVALID_FABRIC_INDEX);
+    return logMgmt.StageEvent(&eventData, eventOptions);
+}
+
+template <typename T, std::enable_if_t<!DataModel::IsFabricScoped<T>::value, bool> = true>
+CHIP_ERROR StageEvent(const T & aEventData, EndpointId aEndpoint)
+{
+    EventLogger<T> eventData(aEventData);
+    ConcreteEventPath path(aEndpoint, aEventData.GetClusterId(), aEventData.GetEventId());
+    EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    EventOptions eventOptions;
+    eventOptions.mPath     = path;
+    eventOptions.mPriority = aEventData.GetPriorityLevel();
+    return logMgmt.StageEvent(&eventData, eventOptions);
+}
+#endif // CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+
 } // namespace app
 } // namespace chip
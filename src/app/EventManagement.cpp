@@ -19,6 +19,7 @@
 #include <access/AccessControl.h>
 #include <access/RequestPath.h>
 #include <access/SubjectDescriptor.h>
+#include <algorithm>
 #include <app/EventManagement.h>
 #include <app/InteractionModelEngine.h>
 #include <app/RequiredPrivilege.h>
@@ -27,6 +28,8 @@
 #include <lib/core/TLVUtilities.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <system/TLVPacketBufferBackingStore.h>
 
 using namespace chip::TLV;
 
@@ -66,6 +69,7 @@ struct ReclaimEventCtx
 {
     CircularEventBuffer * mpEventBuffer = nullptr;
     size_t mSpaceNeededForMovedEvent    = 0;
+    PriorityLevel mEventPriority        = PriorityLevel::Invalid;
 };
 
 /**
@@ -126,7 +130,7 @@ void EventManagement::Init(Messaging::ExchangeManager * apExchangeManager, uint3
     mMonotonicStartupTime = aMonotonicStartupTime;
 }
 
-CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer)
+CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer, PriorityLevel aPriority)
 {
     CircularTLVWriter writer;
     CircularTLVReader reader;
@@ -155,6 +159,8 @@ CHIP_ERROR EventManagement::CopyToNextBuffer(CircularEventBuffer * apEventBuffer
     err = writer.Finalize();
     SuccessOrExit(err);
 
+    nextBuffer->RecordEvent(writer.GetLengthWritten(), aPriority);
+
     ChipLogDetail(EventLogging, "Copy Event to next buffer with priority %u", static_cast<unsigned>(nextBuffer->GetPriority()));
 exit:
     if (err != CHIP_NO_ERROR)
@@ -194,6 +200,43 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
     {
         if (requiredSpace > eventBuffer->AvailableDataLength())
         {
+            CircularEventBuffer::EventIndexEntry head;
+            if (eventBuffer->NeedsIndexing())
+            {
+                // The events that did not fit the index when they were logged are parsed once here; if that fails, the oldest
+                // event is parsed again below, which reports the error.
+                (void) IndexOldestEvents(*eventBuffer);
+            }
+            if (eventBuffer->GetIndexedHead(head))
+            {
+                // The eviction index tells the length and priority of the oldest event, so it can be dropped or moved to the
+                // next buffer without parsing it.
+                if (eventBuffer->IsFinalDestinationForPriority(head.mPriority))
+                {
+                    ChipLogProgress(EventLogging,
+                                    "Dropped 1 event from buffer with priority %u due to overflow: event priority_level: %u",
+                                    static_cast<unsigned>(eventBuffer->GetPriority()), static_cast<unsigned>(head.mPriority));
+                    err = eventBuffer->DiscardIndexedHead();
+                    SuccessOrExit(err);
+                    continue;
+                }
+
+                CircularEventBuffer * nextBuffer = eventBuffer->GetNextCircularEventBuffer();
+                VerifyOrExit(nextBuffer != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+                if (head.mLength <= nextBuffer->AvailableDataLength())
+                {
+                    err = eventBuffer->MoveIndexedHeadTo(*nextBuffer);
+                    SuccessOrExit(err);
+                    continue;
+                }
+
+                // Make room in the next buffer first, then come back to this one.
+                eventBuffer->SetRequiredSpaceforEvicted(requiredSpace);
+                eventBuffer   = nextBuffer;
+                requiredSpace = head.mLength;
+                continue;
+            }
+
             ctx.mpEventBuffer             = eventBuffer;
             ctx.mSpaceNeededForMovedEvent = 0;
 
@@ -217,7 +260,7 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace, P
                     // Since we're calling CopyElement and we've checked
                     // that there is space in the next buffer, we don't expect
                     // this to fail.
-                    err = CopyToNextBuffer(eventBuffer);
+                    err = CopyToNextBuffer(eventBuffer, ctx.mEventPriority);
                     SuccessOrExit(err);
                     // success; evict head unconditionally
                     eventBuffer->mProcessEvictedElement = nullptr;
@@ -264,28 +307,6 @@ exit:
     return err;
 }
 
-CHIP_ERROR EventManagement::CalculateEventSize(EventLoggingDelegate * apDelegate, const EventOptions * apOptions,
-                                               uint32_t & requiredSize)
-{
-    System::PacketBufferTLVWriter writer;
-    EventLoadOutContext ctxt       = EventLoadOutContext(writer, apOptions->mPriority, GetLastEventNumber());
-    System::PacketBufferHandle buf = System::PacketBufferHandle::New(kMaxEventSizeReserve);
-    if (buf.IsNull())
-    {
-        return CHIP_ERROR_NO_MEMORY;
-    }
-    writer.Init(std::move(buf));
-
-    ctxt.mCurrentEventNumber = mLastEventNumber;
-    ctxt.mCurrentTime        = mLastEventTimestamp;
-    CHIP_ERROR err           = ConstructEvent(&ctxt, apDelegate, apOptions);
-    if (err == CHIP_NO_ERROR)
-    {
-        requiredSize = writer.GetLengthWritten();
-    }
-    return err;
-}
-
 CHIP_ERROR EventManagement::ConstructEvent(EventLoadOutContext * apContext, EventLoggingDelegate * apDelegate,
                                            const EventOptions * apOptions)
 {
@@ -356,6 +377,10 @@ void EventManagement::DestroyEventManagement()
     sInstance.mState        = EventManagementStates::Shutdown;
     sInstance.mpEventBuffer = nullptr;
     sInstance.mpExchangeMgr = nullptr;
+#if CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+    // Drop the events that were staged for this log.
+    sInstance.LogStagedEvents();
+#endif // CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
 }
 
 CircularEventBuffer * EventManagement::GetPriorityBuffer(PriorityLevel aPriority) const
@@ -410,42 +435,44 @@ void EventManagement::VendEventNumber()
     mLastEventNumber = mpEventNumberCounter->GetValue();
 }
 
-CHIP_ERROR EventManagement::LogEvent(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions,
-                                     EventNumber & aEventNumber)
-{
-    VerifyOrReturnError(mState != EventManagementStates::Shutdown, CHIP_ERROR_INCORRECT_STATE);
-    return LogEventPrivate(apDelegate, aEventOptions, aEventNumber);
-}
-
-CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions,
-                                            EventNumber & aEventNumber)
+Timestamp EventManagement::GetCurrentTimestamp() const
 {
-    CircularTLVWriter writer;
-    CHIP_ERROR err               = CHIP_NO_ERROR;
-    uint32_t requestSize         = 0;
-    aEventNumber                 = 0;
-    CircularTLVWriter checkpoint = writer;
-    EventLoadOutContext ctxt     = EventLoadOutContext(writer, aEventOptions.mPriority, mLastEventNumber);
-    EventOptions opts;
-
-    Timestamp timestamp;
 #if CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
     System::Clock::Milliseconds64 utc_time;
-    err = System::SystemClock().GetClock_RealTimeMS(utc_time);
-    if (err == CHIP_NO_ERROR)
+    if (System::SystemClock().GetClock_RealTimeMS(utc_time) == CHIP_NO_ERROR)
     {
-        timestamp = Timestamp::Epoch(utc_time);
+        return Timestamp::Epoch(utc_time);
     }
-    else
 #endif // CHIP_DEVICE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+
+    auto systemTimeMs = System::SystemClock().GetMonotonicMilliseconds64() - mMonotonicStartupTime;
+    return Timestamp::System(systemTimeMs);
+}
+
+CHIP_ERROR EventManagement::LogEvent(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions,
+                                     EventNumber & aEventNumber)
+{
+    VerifyOrReturnError(mState != EventManagementStates::Shutdown, CHIP_ERROR_INCORRECT_STATE);
+#if CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+    // Events staged before this one come first in the log.
+    if (LogStagedEvents())
     {
-        auto systemTimeMs = System::SystemClock().GetMonotonicMilliseconds64() - mMonotonicStartupTime;
-        timestamp         = Timestamp::System(systemTimeMs);
+        ScheduleMergeStagedEvents();
     }
+#endif // CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+    return LogEventPrivate(apDelegate, aEventOptions, GetCurrentTimestamp(), aEventNumber);
+}
 
-    opts = EventOptions(timestamp);
-    // Start the event container (anonymous structure) in the circular buffer
-    writer.Init(*mpEventBuffer);
+CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions,
+                                            const Timestamp & aTimestamp, EventNumber & aEventNumber)
+{
+    System::PacketBufferTLVWriter writer;
+    System::PacketBufferHandle buf;
+    CHIP_ERROR err           = CHIP_NO_ERROR;
+    uint32_t eventSize       = 0;
+    aEventNumber             = 0;
+    EventLoadOutContext ctxt = EventLoadOutContext(writer, aEventOptions.mPriority, mLastEventNumber);
+    EventOptions opts(aTimestamp);
 
     opts.mPriority = aEventOptions.mPriority;
     // Create all event specific data
@@ -457,29 +484,37 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
     ctxt.mCurrentEventNumber = mLastEventNumber;
     ctxt.mCurrentTime.mValue = mLastEventTimestamp.mValue;
 
-    err = CalculateEventSize(apDelegate, &opts, requestSize);
+    // Serialize the event once, then copy it into the in-memory logging queues when they have room for it.
+    buf = System::PacketBufferHandle::New(kMaxEventSizeReserve);
+    VerifyOrExit(!buf.IsNull(), err = CHIP_ERROR_NO_MEMORY);
+    writer.Init(std::move(buf));
+
+    err = ConstructEvent(&ctxt, apDelegate, &opts);
+    SuccessOrExit(err);
+
+    eventSize = writer.GetLengthWritten();
+    err       = writer.Finalize(&buf);
     SuccessOrExit(err);
 
     // Ensure we have space in the in-memory logging queues
-    err = EnsureSpaceInCircularBuffer(requestSize, aEventOptions.mPriority);
+    err = EnsureSpaceInCircularBuffer(eventSize, aEventOptions.mPriority);
     SuccessOrExit(err);
 
-    err = ConstructEvent(&ctxt, apDelegate, &opts);
+    err = mpEventBuffer->AppendEvent(buf->Start(), eventSize, aEventOptions.mPriority);
     SuccessOrExit(err);
 
-    mBytesWritten += writer.GetLengthWritten();
+    mBytesWritten += eventSize;
 
 exit:
     if (err != CHIP_NO_ERROR)
     {
         ChipLogError(EventLogging, "Log event with error %" CHIP_ERROR_FORMAT, err.Format());
-        writer = checkpoint;
     }
     else if (opts.mPriority >= CHIP_CONFIG_EVENT_GLOBAL_PRIORITY)
     {
         aEventNumber = mLastEventNumber;
         VendEventNumber();
-        mLastEventTimestamp = timestamp;
+        mLastEventTimestamp = aTimestamp;
 #if CHIP_CONFIG_EVENT_LOGGING_VERBOSE_DEBUG_LOGS
         ChipLogDetail(EventLogging,
                       "LogEvent event number: 0x" ChipLogFormatX64 " priority: %u, endpoint id:  0x%x"
@@ -495,6 +530,123 @@ exit:
     return err;
 }
 
+#if CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+namespace {
+
+/**
+ * Writes the event data that a producer thread encoded into a staging ring.
+ */
+class StagedEventDataWriter : public EventLoggingDelegate
+{
+public:
+    StagedEventDataWriter(const EventStagingRing::StagedEvent & aEvent) : mEvent(aEvent) {}
+
+    CHIP_ERROR WriteEvent(TLV::TLVWriter & aWriter) override
+    {
+        TLVReader reader;
+        TLVType outerType;
+        reader.Init(mEvent.mData, mEvent.mDataLength);
+        ReturnErrorOnFailure(reader.Next(kTLVType_Structure, AnonymousTag()));
+        ReturnErrorOnFailure(reader.EnterContainer(outerType));
+        ReturnErrorOnFailure(reader.Next());
+        return aWriter.CopyElement(reader);
+    }
+
+private:
+    const EventStagingRing::StagedEvent & mEvent;
+};
+
+} // namespace
+
+CHIP_ERROR EventManagement::StageEvent(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions)
+{
+    VerifyOrReturnError(aEventOptions.mPriority <= PriorityLevel::Last, CHIP_ERROR_INVALID_ARGUMENT);
+
+    EventOptions opts(GetCurrentTimestamp());
+    opts.mPath        = aEventOptions.mPath;
+    opts.mPriority    = aEventOptions.mPriority;
+    opts.mFabricIndex = aEventOptions.mFabricIndex;
+
+    CHIP_ERROR err = mStagingRings[to_underlying(aEventOptions.mPriority)].Stage(apDelegate, opts);
+
+    // Even an event whose data failed to encode holds a slot until the merge.
+    ScheduleMergeStagedEvents();
+    return err;
+}
+
+void EventManagement::ScheduleMergeStagedEvents()
+{
+    if (mMergeScheduled.exchange(true))
+    {
+        return;
+    }
+
+    CHIP_ERROR err = DeviceLayer::PlatformMgr().ScheduleWork(
+        [](intptr_t) { EventManagement::GetInstance().MergeStagedEvents(); });
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(EventLogging, "Failed to schedule the merge of staged events: %" CHIP_ERROR_FORMAT, err.Format());
+        mMergeScheduled.store(false);
+    }
+}
+
+void EventManagement::MergeStagedEvents()
+{
+    // Clear the flag first, so that events staged from now on schedule another merge.
+    mMergeScheduled.store(false);
+
+    if (LogStagedEvents())
+    {
+        // Let other work run before merging the events that kept coming.
+        ScheduleMergeStagedEvents();
+    }
+}
+
+bool EventManagement::LogStagedEvents()
+{
+    for (size_t batch = 0; batch < CHIP_CONFIG_EVENT_STAGING_RING_SIZE * ArraySize(mStagingRings); batch++)
+    {
+        // Take the oldest event at the front of the rings, so that the log stays in timestamp order.
+        EventStagingRing * ring                           = nullptr;
+        const EventStagingRing::StagedEvent * stagedEvent = nullptr;
+        for (auto & candidate : mStagingRings)
+        {
+            const EventStagingRing::StagedEvent * front = candidate.Front();
+            if (front != nullptr &&
+                (stagedEvent == nullptr || front->mOptions.mTimestamp.mValue < stagedEvent->mOptions.mTimestamp.mValue))
+            {
+                ring        = &candidate;
+                stagedEvent = front;
+            }
+        }
+        VerifyOrReturnValue(ring != nullptr, false);
+
+        if (mState != EventManagementStates::Shutdown && stagedEvent->mDataLength > 0)
+        {
+            // Events logged on the CHIP thread in the meantime may have a later timestamp, and timestamps must not go back in
+            // the log since they are reported as deltas.
+            Timestamp timestamp = stagedEvent->mOptions.mTimestamp;
+            if (timestamp.mType == mLastEventTimestamp.mType && timestamp.mValue < mLastEventTimestamp.mValue)
+            {
+                timestamp.mValue = mLastEventTimestamp.mValue;
+            }
+
+            StagedEventDataWriter eventData(*stagedEvent);
+            EventNumber eventNumber;
+            // Errors are logged by LogEventPrivate, and the event is dropped like it would be by LogEvent.
+            LogEventPrivate(&eventData, stagedEvent->mOptions, timestamp, eventNumber);
+        }
+        ring->Pop();
+    }
+
+    for (auto & ring : mStagingRings)
+    {
+        VerifyOrReturnValue(ring.Front() == nullptr, true);
+    }
+    return false;
+}
+#endif // CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+
 CHIP_ERROR EventManagement::CopyEvent(const TLVReader & aReader, TLVWriter & aWriter, EventLoadOutContext * apContext)
 {
     TLVReader reader;
@@ -801,20 +953,16 @@ CHIP_ERROR EventManagement::FetchEventParameters(const TLVReader & aReader, size
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR EventManagement::EvictEvent(TLVCircularBuffer & apBuffer, void * apAppData, TLVReader & aReader)
+CHIP_ERROR EventManagement::ReadEventEnvelope(TLVReader & aReader, EventEnvelopeContext & aContext)
 {
-    // pull out the delta time, pull out the priority
-    ReturnErrorOnFailure(aReader.Next());
-
     TLVType containerType;
     TLVType containerType1;
     ReturnErrorOnFailure(aReader.EnterContainer(containerType));
     ReturnErrorOnFailure(aReader.Next());
 
     ReturnErrorOnFailure(aReader.EnterContainer(containerType1));
-    EventEnvelopeContext context;
     constexpr bool recurse = false;
-    CHIP_ERROR err         = TLV::Utilities::Iterate(aReader, FetchEventParameters, &context, recurse);
+    CHIP_ERROR err         = TLV::Utilities::Iterate(aReader, FetchEventParameters, &aContext, recurse);
     if (err == CHIP_END_OF_TLV)
     {
         err = CHIP_NO_ERROR;
@@ -822,7 +970,34 @@ CHIP_ERROR EventManagement::EvictEvent(TLVCircularBuffer & apBuffer, void * apAp
     ReturnErrorOnFailure(err);
 
     ReturnErrorOnFailure(aReader.ExitContainer(containerType1));
-    ReturnErrorOnFailure(aReader.ExitContainer(containerType));
+    return aReader.ExitContainer(containerType);
+}
+
+CHIP_ERROR EventManagement::IndexOldestEvents(CircularEventBuffer & aBuffer)
+{
+    VerifyOrReturnError(aBuffer.NeedsIndexing(), CHIP_ERROR_INCORRECT_STATE);
+
+    CircularTLVReader reader;
+    reader.Init(aBuffer);
+
+    while (aBuffer.CanIndexOldestEvent())
+    {
+        EventEnvelopeContext context;
+        uint32_t eventStart = reader.GetLengthRead();
+        ReturnErrorOnFailure(reader.Next());
+        ReturnErrorOnFailure(ReadEventEnvelope(reader, context));
+        aBuffer.IndexOldestEvent(reader.GetLengthRead() - eventStart, static_cast<PriorityLevel>(context.mPriority));
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EventManagement::EvictEvent(TLVCircularBuffer & apBuffer, void * apAppData, TLVReader & aReader)
+{
+    // pull out the delta time, pull out the priority
+    ReturnErrorOnFailure(aReader.Next());
+
+    EventEnvelopeContext context;
+    ReturnErrorOnFailure(ReadEventEnvelope(aReader, context));
     const PriorityLevel imp = static_cast<PriorityLevel>(context.mPriority);
 
     ReclaimEventCtx * const ctx             = static_cast<ReclaimEventCtx *>(apAppData);
@@ -840,6 +1015,7 @@ CHIP_ERROR EventManagement::EvictEvent(TLVCircularBuffer & apBuffer, void * apAp
 
     // event is not getting dropped. Note how much space it requires, and return.
     ctx->mSpaceNeededForMovedEvent = aReader.GetLengthRead();
+    ctx->mEventPriority            = imp;
     return CHIP_END_OF_TLV;
 }
 
@@ -853,9 +1029,100 @@ void CircularEventBuffer::Init(uint8_t * apBuffer, uint32_t aBufferLength, Circu
                                CircularEventBuffer * apNext, PriorityLevel aPriorityLevel)
 {
     TLVCircularBuffer::Init(apBuffer, aBufferLength);
-    mpPrev    = apPrev;
-    mpNext    = apNext;
-    mPriority = aPriorityLevel;
+    mpPrev               = apPrev;
+    mpNext               = apNext;
+    mPriority            = aPriorityLevel;
+    mIndexStart          = 0;
+    mIndexCount          = 0;
+    mUnindexedEventCount = 0;
+}
+
+CHIP_ERROR CircularEventBuffer::AppendEvent(const uint8_t * apEvent, uint32_t aLength, PriorityLevel aPriority)
+{
+    ReturnErrorOnFailure(AppendData(apEvent, aLength));
+    RecordEvent(aLength, aPriority);
+    return CHIP_NO_ERROR;
+}
+
+void CircularEventBuffer::RecordEvent(uint32_t aLength, PriorityLevel aPriority)
+{
+    // The index only covers consecutive events starting at the head, so once an event did not fit, all the events that follow
+    // it wait for IndexOldestEvent as well.
+    if (mUnindexedEventCount > 0 || mIndexCount == ArraySize(mIndex))
+    {
+        mUnindexedEventCount++;
+        return;
+    }
+
+    PushIndexedTail(aLength, aPriority);
+}
+
+void CircularEventBuffer::IndexOldestEvent(uint32_t aLength, PriorityLevel aPriority)
+{
+    VerifyOrReturn(CanIndexOldestEvent());
+    PushIndexedTail(aLength, aPriority);
+    mUnindexedEventCount--;
+}
+
+bool CircularEventBuffer::GetIndexedHead(EventIndexEntry & aEntry) const
+{
+    VerifyOrReturnValue(mIndexCount > 0, false);
+    aEntry = mIndex[mIndexStart];
+    return true;
+}
+
+void CircularEventBuffer::PushIndexedTail(uint32_t aLength, PriorityLevel aPriority)
+{
+    EventIndexEntry & entry = mIndex[(mIndexStart + mIndexCount) % ArraySize(mIndex)];
+    entry.mLength           = static_cast<uint16_t>(aLength);
+    entry.mPriority         = aPriority;
+    mIndexCount++;
+}
+
+void CircularEventBuffer::PopIndexedHead()
+{
+    mIndexStart = static_cast<uint16_t>((mIndexStart + 1) % ArraySize(mIndex));
+    mIndexCount--;
+}
+
+CHIP_ERROR CircularEventBuffer::DiscardIndexedHead()
+{
+    EventIndexEntry head;
+    VerifyOrReturnError(GetIndexedHead(head), CHIP_ERROR_INCORRECT_STATE);
+    ReturnErrorOnFailure(DiscardHead(head.mLength));
+    PopIndexedHead();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CircularEventBuffer::MoveIndexedHeadTo(CircularEventBuffer & aNextBuffer)
+{
+    EventIndexEntry head;
+    VerifyOrReturnError(GetIndexedHead(head), CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(head.mLength <= aNextBuffer.AvailableDataLength(), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    // The event may wrap around the end of this buffer.
+    uint32_t headOffset  = static_cast<uint32_t>(QueueHead() - GetQueue());
+    uint32_t firstLength = std::min<uint32_t>(head.mLength, GetTotalDataLength() - headOffset);
+    ReturnErrorOnFailure(aNextBuffer.AppendData(QueueHead(), firstLength));
+    ReturnErrorOnFailure(aNextBuffer.AppendData(GetQueue(), head.mLength - firstLength));
+    aNextBuffer.RecordEvent(head.mLength, head.mPriority);
+
+    return DiscardIndexedHead();
+}
+
+CHIP_ERROR CircularEventBuffer::EvictHead()
+{
+    ReturnErrorOnFailure(TLVCircularBuffer::EvictHead());
+
+    if (mIndexCount > 0)
+    {
+        PopIndexedHead();
+    }
+    else if (mUnindexedEventCount > 0)
+    {
+        mUnindexedEventCount--;
+    }
+    return CHIP_NO_ERROR;
 }
 
 bool CircularEventBuffer::IsFinalDestinationForPriority(PriorityLevel aPriority) const
@@ -29,6 +29,7 @@
 #include "EventLoggingDelegate.h"
 #include "EventLoggingTypes.h"
 #include <access/SubjectDescriptor.h>
+#include <app/EventStagingRing.h>
 #include <app/MessageDef/EventDataIB.h>
 #include <app/MessageDef/StatusIB.h>
 #include <app/ObjectList.h>
@@ -39,6 +40,8 @@
 #include <platform/CHIPDeviceConfig.h>
 #include <system/SystemClock.h>
 
+#include <atomic>
+
 /**
  * Events are stored in the LogStorageResources provided to
  * EventManagement::Init.
@@ -73,6 +76,9 @@ namespace app {
 inline constexpr const uint32_t kEventManagementProfile = 0x1;
 inline constexpr const uint32_t kFabricIndexTag         = 0x1;
 inline constexpr size_t kMaxEventSizeReserve            = 512;
+static_assert(kMaxEventSizeReserve <= UINT16_MAX, "Event lengths must fit the eviction index of CircularEventBuffer");
+static_assert(CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0 && CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE <= UINT16_MAX,
+              "CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE is out of range");
 constexpr uint16_t kRequiredEventField =
     (1 << to_underlying(EventDataIB::Tag::kPriority)) | (1 << to_underlying(EventDataIB::Tag::kPath));
 
@@ -128,9 +134,81 @@ public:
     void SetRequiredSpaceforEvicted(size_t aRequiredSpace) { mRequiredSpaceForEvicted = aRequiredSpace; }
     size_t GetRequiredSpaceforEvicted() const { return mRequiredSpaceForEvicted; }
 
+    /**
+     * @brief
+     *   The length and priority of an event stored in the buffer, which is all that is needed to evict it.
+     */
+    struct EventIndexEntry
+    {
+        uint16_t mLength        = 0;
+        PriorityLevel mPriority = PriorityLevel::Invalid;
+    };
+
+    /**
+     * @brief
+     *   Copy an encoded event to the tail of the buffer and add it to the eviction index.  The caller must have made room for the
+     *   event first.
+     */
+    CHIP_ERROR AppendEvent(const uint8_t * apEvent, uint32_t aLength, PriorityLevel aPriority);
+
+    /**
+     * @brief
+     *   Add an event that was just written at the tail of the buffer to the eviction index, or count it as unindexed if the
+     *   index is full.
+     */
+    void RecordEvent(uint32_t aLength, PriorityLevel aPriority);
+
+    /**
+     * @brief
+     *   Whether the index is empty while some events of the buffer were not indexed yet.  These have to be parsed, from the
+     *   head of the buffer, and added to the index with IndexOldestEvent.
+     */
+    bool NeedsIndexing() const { return mIndexCount == 0 && mUnindexedEventCount > 0; }
+
+    /**
+     * @brief
+     *   Whether IndexOldestEvent can add another event to the index.
+     */
+    bool CanIndexOldestEvent() const { return mUnindexedEventCount > 0 && mIndexCount < ArraySize(mIndex); }
+
+    /**
+     * @brief
+     *   Add the oldest event that was not indexed yet to the eviction index.
+     */
+    void IndexOldestEvent(uint32_t aLength, PriorityLevel aPriority);
+
+    /**
+     * @brief
+     *   Get the length and priority of the oldest event of the buffer.
+     *
+     * @retval false If the oldest event is not in the eviction index, e.g. because the buffer is empty.
+     */
+    bool GetIndexedHead(EventIndexEntry & aEntry) const;
+
+    /**
+     * @brief
+     *   Drop the oldest event of the buffer, which must be in the eviction index, without parsing it.
+     */
+    CHIP_ERROR DiscardIndexedHead();
+
+    /**
+     * @brief
+     *   Move the oldest event of the buffer, which must be in the eviction index, to the tail of aNextBuffer without parsing it.
+     */
+    CHIP_ERROR MoveIndexedHeadTo(CircularEventBuffer & aNextBuffer);
+
+    /**
+     * @brief
+     *   Parse and evict the oldest event of the buffer, see TLVCircularBuffer::EvictHead, keeping the eviction index in sync.
+     */
+    CHIP_ERROR EvictHead();
+
     ~CircularEventBuffer() override = default;
 
 private:
+    void PushIndexedTail(uint32_t aLength, PriorityLevel aPriority);
+    void PopIndexedHead();
+
     CircularEventBuffer * mpPrev = nullptr; ///< A pointer CircularEventBuffer storing events less important events
     CircularEventBuffer * mpNext = nullptr; ///< A pointer CircularEventBuffer storing events more important events
 
@@ -139,6 +217,12 @@ private:
 
     size_t mRequiredSpaceForEvicted = 0; ///< Required space for previous buffer to evict event to new buffer
 
+    // The eviction index covers the oldest events of the buffer, mUnindexedEventCount more recent events come after them.
+    EventIndexEntry mIndex[CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE];
+    uint16_t mIndexStart          = 0;
+    uint16_t mIndexCount          = 0;
+    uint32_t mUnindexedEventCount = 0;
+
     CHIP_ERROR OnInit(TLV::TLVWriter & writer, uint8_t *& bufStart, uint32_t & bufLen) override;
 };
 
@@ -304,6 +388,36 @@ public:
      */
     CHIP_ERROR LogEvent(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions, EventNumber & aEventNumber);
 
+#if CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+    /**
+     * @brief
+     *   Stage an event from any thread, without holding the CHIP stack lock.
+     *
+     * `apDelegate` encodes the event data right away, on the calling thread,
+     * into the staging ring of the event priority.  The event gets its
+     * timestamp now, but its event number only once the CHIP thread merges
+     * the staged events into the event log, which is scheduled by this
+     * call.  Events logged with LogEvent on the CHIP thread merge the events
+     * staged before them first.
+     *
+     * @param[in] apDelegate The EventLoggingDelegate to serialize the event data
+     *
+     * @param[in] aEventOptions    The options for the event metadata.
+     *
+     * @retval #CHIP_ERROR_NO_MEMORY If the staging ring of the event priority
+     *                               is full.
+     * @return CHIP_ERROR  CHIP Error Code
+     */
+    CHIP_ERROR StageEvent(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions);
+
+    /**
+     * @brief
+     *   Merge the events staged so far into the event log, oldest first.
+     *   Must be called on the CHIP thread; StageEvent schedules it.
+     */
+    void MergeStagedEvents();
+#endif // CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+
     /**
      * @brief
      *   A helper method to get tlv reader along with buffer has data from particular priority
@@ -412,7 +526,7 @@ private:
     };
 
     void VendEventNumber();
-    CHIP_ERROR CalculateEventSize(EventLoggingDelegate * apDelegate, const EventOptions * apOptions, uint32_t & requiredSize);
+    Timestamp GetCurrentTimestamp() const;
     /**
      * @brief Helper function for writing event header and data according to event
      *   logging protocol.
@@ -430,15 +544,25 @@ private:
     CHIP_ERROR ConstructEvent(EventLoadOutContext * apContext, EventLoggingDelegate * apDelegate, const EventOptions * apOptions);
 
     // Internal function to log event
-    CHIP_ERROR LogEventPrivate(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions, EventNumber & aEventNumber);
+    CHIP_ERROR LogEventPrivate(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions, const Timestamp & aTimestamp,
+                               EventNumber & aEventNumber);
+
+#if CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+    void ScheduleMergeStagedEvents();
+
+    // Log the staged events, up to one batch per staging ring.  Returns whether staged events are left.
+    bool LogStagedEvents();
+#endif // CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
 
     /**
      * @brief copy the event outright to next buffer with higher priority
      *
      * @param[in] apEventBuffer  CircularEventBuffer
      *
+     * @param[in] aPriority      priority of the event being copied
+     *
      */
-    CHIP_ERROR CopyToNextBuffer(CircularEventBuffer * apEventBuffer);
+    CHIP_ERROR CopyToNextBuffer(CircularEventBuffer * apEventBuffer, PriorityLevel aPriority);
 
     /**
      * @brief Ensure that:
@@ -512,6 +636,16 @@ private:
      * requires, and return.
      */
     static CHIP_ERROR EvictEvent(chip::TLV::TLVCircularBuffer & aBuffer, void * apAppData, TLV::TLVReader & aReader);
+
+    /**
+     * @brief Read the envelope of the event the reader is positioned on into aContext, leaving the reader after the event.
+     */
+    static CHIP_ERROR ReadEventEnvelope(TLV::TLVReader & aReader, EventEnvelopeContext & aContext);
+
+    /**
+     * @brief Parse the oldest events of a buffer whose eviction index is empty, and add as many of them as fit to the index.
+     */
+    static CHIP_ERROR IndexOldestEvents(CircularEventBuffer & aBuffer);
     static CHIP_ERROR AlwaysFail(chip::TLV::TLVCircularBuffer & aBuffer, void * apAppData, TLV::TLVReader & aReader)
     {
         return CHIP_ERROR_NO_MEMORY;
@@ -558,6 +692,13 @@ private:
     Timestamp mLastEventTimestamp;    ///< The timestamp of the last event in this buffer
 
     System::Clock::Milliseconds64 mMonotonicStartupTime;
+
+#if CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+    // Events staged from other threads, one ring per priority level so that a burst of events does not take the slots of
+    // events of other priorities.
+    EventStagingRing mStagingRings[to_underlying(PriorityLevel::Last) + 1];
+    std::atomic<bool> mMergeScheduled{ false };
+#endif // CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
 };
 } // namespace app
 } // namespace chip
@@ -35,6 +35,8 @@ struct EventPathParams
         return other.mEndpointId == mEndpointId && other.mClusterId == mClusterId && other.mEventId == mEventId;
     }
 
+    bool operator==(const EventPathParams & aOther) const { return IsSamePath(aOther) && mIsUrgentEvent == aOther.mIsUrgentEvent; }
+
     bool IsWildcardPath() const { return HasWildcardEndpointId() || HasWildcardClusterId() || HasWildcardEventId(); }
 
     // For event, an event id can only be interpreted if the cluster id is known.
@@ -0,0 +1,107 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/EventStagingRing.h>
+
+#include <lib/core/TLVWriter.h>
+
+#if CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+
+namespace chip {
+namespace app {
+
+EventStagingRing::EventStagingRing()
+{
+    for (uint32_t i = 0; i < CHIP_CONFIG_EVENT_STAGING_RING_SIZE; i++)
+    {
+        mSlots[i].mSequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+CHIP_ERROR EventStagingRing::Stage(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions)
+{
+    uint32_t position = mEnqueuePosition.load(std::memory_order_relaxed);
+    Slot * slot;
+
+    while (true)
+    {
+        slot              = &mSlots[position % CHIP_CONFIG_EVENT_STAGING_RING_SIZE];
+        uint32_t sequence = slot->mSequence.load(std::memory_order_acquire);
+        int32_t distance  = static_cast<int32_t>(sequence - position);
+
+        if (distance == 0)
+        {
+            // The slot is free: claim it, unless another producer got there first.
+            if (mEnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (distance < 0)
+        {
+            // The slot still holds the event staged one lap ago.
+            return CHIP_ERROR_NO_MEMORY;
+        }
+        else
+        {
+            position = mEnqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    // The event data element has a context tag, so it is encoded within an anonymous structure.
+    TLV::TLVWriter writer;
+    TLV::TLVType outerType;
+    writer.Init(slot->mEvent.mData);
+
+    CHIP_ERROR err = writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, outerType);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = apDelegate->WriteEvent(writer);
+    }
+    if (err == CHIP_NO_ERROR)
+    {
+        err = writer.EndContainer(outerType);
+    }
+    if (err == CHIP_NO_ERROR)
+    {
+        err = writer.Finalize();
+    }
+
+    slot->mEvent.mOptions    = aEventOptions;
+    slot->mEvent.mDataLength = (err == CHIP_NO_ERROR) ? static_cast<uint16_t>(writer.GetLengthWritten()) : 0;
+
+    // Publish the slot even if encoding failed, so that it does not block the events staged after it.
+    slot->mSequence.store(position + 1, std::memory_order_release);
+    return err;
+}
+
+const EventStagingRing::StagedEvent * EventStagingRing::Front() const
+{
+    const Slot & slot = mSlots[mDequeuePosition % CHIP_CONFIG_EVENT_STAGING_RING_SIZE];
+    return (slot.mSequence.load(std::memory_order_acquire) == mDequeuePosition + 1) ? &slot.mEvent : nullptr;
+}
+
+void EventStagingRing::Pop()
+{
+    Slot & slot = mSlots[mDequeuePosition % CHIP_CONFIG_EVENT_STAGING_RING_SIZE];
+    slot.mSequence.store(mDequeuePosition + CHIP_CONFIG_EVENT_STAGING_RING_SIZE, std::memory_order_release);
+    mDequeuePosition++;
+}
+
+} // namespace app
+} // namespace chip
+
+#endif // CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
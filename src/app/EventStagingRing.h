@@ -0,0 +1,93 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <app/EventLoggingDelegate.h>
+#include <app/EventLoggingTypes.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+
+#include <atomic>
+#include <stdint.h>
+
+#if CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+
+namespace chip {
+namespace app {
+
+/**
+ * A bounded queue of events whose data was encoded outside of the CHIP thread, waiting to be merged into the event log by
+ * EventManagement.
+ *
+ * Any number of threads can stage events at the same time without taking a lock: a producer claims the next free slot by
+ * advancing the enqueue position with a compare-and-swap, encodes the event data into the slot, then publishes the slot by
+ * updating its sequence number.  Only the CHIP thread consumes the events, in the order in which their slots were claimed.
+ */
+class EventStagingRing
+{
+public:
+    static_assert((CHIP_CONFIG_EVENT_STAGING_RING_SIZE & (CHIP_CONFIG_EVENT_STAGING_RING_SIZE - 1)) == 0,
+                  "CHIP_CONFIG_EVENT_STAGING_RING_SIZE must be a power of two");
+    static_assert(CHIP_CONFIG_EVENT_STAGING_MAX_EVENT_DATA_SIZE <= UINT16_MAX,
+                  "CHIP_CONFIG_EVENT_STAGING_MAX_EVENT_DATA_SIZE does not fit the staged event length");
+
+    struct StagedEvent
+    {
+        EventOptions mOptions;
+        // 0 if the event data could not be encoded; the event is then dropped when merged.
+        uint16_t mDataLength = 0;
+        uint8_t mData[CHIP_CONFIG_EVENT_STAGING_MAX_EVENT_DATA_SIZE];
+    };
+
+    EventStagingRing();
+
+    /**
+     * Encode the event data written by apDelegate into the next free slot.  Can be called from any thread.
+     *
+     * @retval #CHIP_ERROR_NO_MEMORY All the slots hold events that were not merged yet.
+     * @retval other                 The event data could not be encoded, e.g. it is larger than
+     *                               CHIP_CONFIG_EVENT_STAGING_MAX_EVENT_DATA_SIZE.
+     */
+    CHIP_ERROR Stage(EventLoggingDelegate * apDelegate, const EventOptions & aEventOptions);
+
+    /**
+     * The oldest staged event, or nullptr if there is none or if its data is still being encoded.  CHIP thread only.
+     */
+    const StagedEvent * Front() const;
+
+    /**
+     * Release the slot of the event returned by Front().  CHIP thread only.
+     */
+    void Pop();
+
+private:
+    struct Slot
+    {
+        // Equals the enqueue position that can claim the slot while it is free, and that position + 1 once the event it holds
+        // is published.
+        std::atomic<uint32_t> mSequence;
+        StagedEvent mEvent;
+    };
+
+    Slot mSlots[CHIP_CONFIG_EVENT_STAGING_RING_SIZE];
+    std::atomic<uint32_t> mEnqueuePosition{ 0 };
+    uint32_t mDequeuePosition = 0;
+};
+
+} // namespace app
+} // namespace chip
+
+#endif // CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
@@ -0,0 +1,403 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines an implementation of SubscriptionResumptionStorage that
+ *      keeps an index of the persisted subscriptions, so that saving, deleting and
+ *      counting subscriptions does not need to load every stored subscription.
+ */
+
+#include <app/IndexedSubscriptionResumptionStorage.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/SafeInt.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace app {
+
+constexpr TLV::Tag IndexedSubscriptionResumptionStorage::kSlotIndexTag;
+
+IndexedSubscriptionResumptionStorage::IndexedSubscriptionInfoIterator::IndexedSubscriptionInfoIterator(
+    IndexedSubscriptionResumptionStorage & storage, bool withPaths) :
+    mStorage(storage), mNextIndex(0), mWithPaths(withPaths)
+{}
+
+size_t IndexedSubscriptionResumptionStorage::IndexedSubscriptionInfoIterator::Count()
+{
+    return static_cast<size_t>(mStorage.IndexCount());
+}
+
+bool IndexedSubscriptionResumptionStorage::IndexedSubscriptionInfoIterator::Next(SubscriptionInfo & output)
+{
+    for (; mNextIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; mNextIndex++)
+    {
+        const IndexEntry & entry = mStorage.mIndex[mNextIndex];
+        if (!entry.mInUse)
+        {
+            continue;
+        }
+
+        if (!mWithPaths)
+        {
+            output.mNodeId         = entry.mNodeId;
+            output.mFabricIndex    = entry.mFabricIndex;
+            output.mSubscriptionId = entry.mSubscriptionId;
+            output.mMinInterval    = entry.mMinInterval;
+            output.mMaxInterval    = entry.mMaxInterval;
+            output.mFabricFiltered = entry.mFabricFiltered;
+            output.mAttributePaths.Free();
+            output.mEventPaths.Free();
+            mNextIndex++;
+            return true;
+        }
+
+        CHIP_ERROR err = mStorage.Load(mNextIndex, output);
+        if (err == CHIP_NO_ERROR)
+        {
+            if (!entry.Matches(output.mNodeId, output.mFabricIndex, output.mSubscriptionId) ||
+                entry.mMinInterval != output.mMinInterval || entry.mMaxInterval != output.mMaxInterval ||
+                entry.mFabricFiltered != output.mFabricFiltered)
+            {
+                // The slot was written without updating the index, trust the subscription.
+                mStorage.SetEntry(mNextIndex, output);
+                mStorage.SaveIndex();
+            }
+
+            // increment index for the next call
+            mNextIndex++;
+            return true;
+        }
+
+        ChipLogError(DataManagement, "Failed to load subscription at index %u error %" CHIP_ERROR_FORMAT,
+                     static_cast<unsigned>(mNextIndex), err.Format());
+        mStorage.SimpleSubscriptionResumptionStorage::Delete(mNextIndex);
+        mStorage.mIndex[mNextIndex].mInUse = false;
+        mStorage.SaveIndex();
+    }
+
+    return false;
+}
+
+void IndexedSubscriptionResumptionStorage::IndexedSubscriptionInfoIterator::Release()
+{
+    mStorage.mIndexedSubscriptionInfoIterators.ReleaseObject(this);
+}
+
+CHIP_ERROR IndexedSubscriptionResumptionStorage::Init(PersistentStorageDelegate * storage)
+{
+    ReturnErrorOnFailure(SimpleSubscriptionResumptionStorage::Init(storage));
+
+    for (auto & entry : mIndex)
+    {
+        entry = IndexEntry();
+    }
+
+    CHIP_ERROR err = LoadIndex();
+    if (err == CHIP_NO_ERROR)
+    {
+        // A firmware using SimpleSubscriptionResumptionStorage may have saved or deleted subscriptions since.
+        if (IndexMatchesSlots())
+        {
+            return CHIP_NO_ERROR;
+        }
+        ChipLogError(DataManagement, "Subscription resumption index is out of date, rebuilding it");
+    }
+    else if (err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+    {
+        ChipLogError(DataManagement, "Failed to load subscription resumption index error %" CHIP_ERROR_FORMAT, err.Format());
+    }
+    return RebuildIndex();
+}
+
+SubscriptionResumptionStorage::SubscriptionInfoIterator * IndexedSubscriptionResumptionStorage::IterateSubscriptions()
+{
+    return mIndexedSubscriptionInfoIterators.CreateObject(*this, true);
+}
+
+SubscriptionResumptionStorage::SubscriptionInfoIterator * IndexedSubscriptionResumptionStorage::IterateSubscriptionSummaries()
+{
+    return mIndexedSubscriptionInfoIterators.CreateObject(*this, false);
+}
+
+CHIP_ERROR IndexedSubscriptionResumptionStorage::Find(NodeId nodeId, FabricIndex fabricIndex, SubscriptionId subscriptionId,
+                                                      SubscriptionInfo & subscriptionInfo)
+{
+    for (uint16_t subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
+    {
+        if (mIndex[subscriptionIndex].Matches(nodeId, fabricIndex, subscriptionId))
+        {
+            return Load(subscriptionIndex, subscriptionInfo);
+        }
+    }
+
+    return CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND;
+}
+
+uint16_t IndexedSubscriptionResumptionStorage::IndexCount() const
+{
+    uint16_t subscriptionCount = 0;
+    for (const auto & entry : mIndex)
+    {
+        if (entry.mInUse)
+        {
+            subscriptionCount++;
+        }
+    }
+    return subscriptionCount;
+}
+
+void IndexedSubscriptionResumptionStorage::SetEntry(uint16_t subscriptionIndex, const SubscriptionInfo & subscriptionInfo)
+{
+    IndexEntry & entry    = mIndex[subscriptionIndex];
+    entry.mInUse          = true;
+    entry.mNodeId         = subscriptionInfo.mNodeId;
+    entry.mFabricIndex    = subscriptionInfo.mFabricIndex;
+    entry.mSubscriptionId = subscriptionInfo.mSubscriptionId;
+    entry.mMinInterval    = subscriptionInfo.mMinInterval;
+    entry.mMaxInterval    = subscriptionInfo.mMaxInterval;
+    entry.mFabricFiltered = subscriptionInfo.mFabricFiltered;
+}
+
+CHIP_ERROR IndexedSubscriptionResumptionStorage::LoadIndex()
+{
+    Platform::ScopedMemoryBuffer<uint8_t> backingBuffer;
+    backingBuffer.Calloc(MaxIndexSize());
+    ReturnErrorCodeIf(backingBuffer.Get() == nullptr, CHIP_ERROR_NO_MEMORY);
+
+    uint16_t len = static_cast<uint16_t>(MaxIndexSize());
+    ReturnErrorOnFailure(
+        mStorage->SyncGetKeyValue(DefaultStorageKeyAllocator::SubscriptionResumptionIndex().KeyName(), backingBuffer.Get(), len));
+
+    TLV::ScopedBufferTLVReader reader(std::move(backingBuffer), len);
+
+    ReturnErrorOnFailure(reader.Next(TLV::kTLVType_List, TLV::AnonymousTag()));
+    TLV::TLVType indexListType;
+    ReturnErrorOnFailure(reader.EnterContainer(indexListType));
+
+    CHIP_ERROR err;
+    while ((err = reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag())) == CHIP_NO_ERROR)
+    {
+        TLV::TLVType entryContainerType;
+        ReturnErrorOnFailure(reader.EnterContainer(entryContainerType));
+
+        uint16_t subscriptionIndex;
+        ReturnErrorOnFailure(reader.Next(kSlotIndexTag));
+        ReturnErrorOnFailure(reader.Get(subscriptionIndex));
+
+        IndexEntry entry;
+        ReturnErrorOnFailure(reader.Next(kPeerNodeIdTag));
+        ReturnErrorOnFailure(reader.Get(entry.mNodeId));
+        ReturnErrorOnFailure(reader.Next(kFabricIndexTag));
+        ReturnErrorOnFailure(reader.Get(entry.mFabricIndex));
+        ReturnErrorOnFailure(reader.Next(kSubscriptionIdTag));
+        ReturnErrorOnFailure(reader.Get(entry.mSubscriptionId));
+        ReturnErrorOnFailure(reader.Next(kMinIntervalTag));
+        ReturnErrorOnFailure(reader.Get(entry.mMinInterval));
+        ReturnErrorOnFailure(reader.Next(kMaxIntervalTag));
+        ReturnErrorOnFailure(reader.Get(entry.mMaxInterval));
+        ReturnErrorOnFailure(reader.Next(kFabricFilteredTag));
+        ReturnErrorOnFailure(reader.Get(entry.mFabricFiltered));
+
+        ReturnErrorOnFailure(reader.ExitContainer(entryContainerType));
+
+        // Slots beyond CHIP_IM_MAX_NUM_SUBSCRIPTIONS have been deleted by SimpleSubscriptionResumptionStorage::Init()
+        if (subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS)
+        {
+            entry.mInUse              = true;
+            mIndex[subscriptionIndex] = entry;
+        }
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+    ReturnErrorOnFailure(reader.ExitContainer(indexListType));
+
+    return CHIP_NO_ERROR;
+}
+
+bool IndexedSubscriptionResumptionStorage::IndexMatchesSlots() const
+{
+    for (uint16_t subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
+    {
+        if (mStorage->SyncDoesKeyExist(DefaultStorageKeyAllocator::SubscriptionResumption(subscriptionIndex).KeyName()) !=
+            mIndex[subscriptionIndex].mInUse)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+CHIP_ERROR IndexedSubscriptionResumptionStorage::RebuildIndex()
+{
+    for (uint16_t subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
+    {
+        mIndex[subscriptionIndex] = IndexEntry();
+
+        SubscriptionInfo subscriptionInfo;
+        CHIP_ERROR err = Load(subscriptionIndex, subscriptionInfo);
+        if (err == CHIP_NO_ERROR)
+        {
+            SetEntry(subscriptionIndex, subscriptionInfo);
+        }
+        else if (err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+        {
+            ChipLogError(DataManagement, "Failed to load subscription at index %u error %" CHIP_ERROR_FORMAT,
+                         static_cast<unsigned>(subscriptionIndex), err.Format());
+            SimpleSubscriptionResumptionStorage::Delete(subscriptionIndex);
+        }
+    }
+
+    return SaveIndex();
+}
+
+CHIP_ERROR IndexedSubscriptionResumptionStorage::SaveIndex()
+{
+    // Like SimpleSubscriptionResumptionStorage, leave nothing in storage once no subscription is persisted.
+    if (IndexCount() == 0)
+    {
+        CHIP_ERROR err = mStorage->SyncDeleteKeyValue(DefaultStorageKeyAllocator::SubscriptionResumptionIndex().KeyName());
+        VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND, err);
+        err = DeleteMaxCount();
+        VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND, err);
+        return CHIP_NO_ERROR;
+    }
+
+    Platform::ScopedMemoryBuffer<uint8_t> backingBuffer;
+    backingBuffer.Calloc(MaxIndexSize());
+    ReturnErrorCodeIf(backingBuffer.Get() == nullptr, CHIP_ERROR_NO_MEMORY);
+
+    TLV::ScopedBufferTLVWriter writer(std::move(backingBuffer), MaxIndexSize());
+
+    TLV::TLVType indexListType;
+    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_List, indexListType));
+    for (uint16_t subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
+    {
+        const IndexEntry & entry = mIndex[subscriptionIndex];
+        if (!entry.mInUse)
+        {
+            continue;
+        }
+
+        TLV::TLVType entryContainerType;
+        ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, entryContainerType));
+        ReturnErrorOnFailure(writer.Put(kSlotIndexTag, subscriptionIndex));
+        ReturnErrorOnFailure(writer.Put(kPeerNodeIdTag, entry.mNodeId));
+        ReturnErrorOnFailure(writer.Put(kFabricIndexTag, entry.mFabricIndex));
+        ReturnErrorOnFailure(writer.Put(kSubscriptionIdTag, entry.mSubscriptionId));
+        ReturnErrorOnFailure(writer.Put(kMinIntervalTag, entry.mMinInterval));
+        ReturnErrorOnFailure(writer.Put(kMaxIntervalTag, entry.mMaxInterval));
+        ReturnErrorOnFailure(writer.Put(kFabricFilteredTag, entry.mFabricFiltered));
+        ReturnErrorOnFailure(writer.EndContainer(entryContainerType));
+    }
+    ReturnErrorOnFailure(writer.EndContainer(indexListType));
+
+    const auto len = writer.GetLengthWritten();
+    VerifyOrReturnError(CanCastTo<uint16_t>(len), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    writer.Finalize(backingBuffer);
+
+    return mStorage->SyncSetKeyValue(DefaultStorageKeyAllocator::SubscriptionResumptionIndex().KeyName(), backingBuffer.Get(),
+                                     static_cast<uint16_t>(len));
+}
+
+CHIP_ERROR IndexedSubscriptionResumptionStorage::Save(SubscriptionInfo & subscriptionInfo)
+{
+    // Overwrite the same subscription if it is persisted, otherwise take the first empty slot
+    uint16_t subscriptionIndex           = CHIP_IM_MAX_NUM_SUBSCRIPTIONS;
+    uint16_t firstEmptySubscriptionIndex = CHIP_IM_MAX_NUM_SUBSCRIPTIONS;
+    for (uint16_t index = 0; index < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; index++)
+    {
+        if (mIndex[index].Matches(subscriptionInfo.mNodeId, subscriptionInfo.mFabricIndex, subscriptionInfo.mSubscriptionId))
+        {
+            subscriptionIndex = index;
+            break;
+        }
+        if (!mIndex[index].mInUse && firstEmptySubscriptionIndex == CHIP_IM_MAX_NUM_SUBSCRIPTIONS)
+        {
+            firstEmptySubscriptionIndex = index;
+        }
+    }
+    if (subscriptionIndex == CHIP_IM_MAX_NUM_SUBSCRIPTIONS)
+    {
+        subscriptionIndex = firstEmptySubscriptionIndex;
+    }
+
+    // Fail if no empty space
+    VerifyOrReturnError(subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS, CHIP_ERROR_NO_MEMORY);
+
+    // Write the subscription before the index, so that the index never refers to a slot that was not written.
+    ReturnErrorOnFailure(SimpleSubscriptionResumptionStorage::Save(subscriptionIndex, subscriptionInfo));
+    SetEntry(subscriptionIndex, subscriptionInfo);
+
+    return SaveIndex();
+}
+
+CHIP_ERROR IndexedSubscriptionResumptionStorage::Delete(NodeId nodeId, FabricIndex fabricIndex, SubscriptionId subscriptionId)
+{
+    for (uint16_t subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
+    {
+        if (mIndex[subscriptionIndex].Matches(nodeId, fabricIndex, subscriptionId))
+        {
+            CHIP_ERROR err = SimpleSubscriptionResumptionStorage::Delete(subscriptionIndex);
+            VerifyOrReturnError(err == CHIP_NO_ERROR || err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND, err);
+            mIndex[subscriptionIndex].mInUse = false;
+            return SaveIndex();
+        }
+    }
+
+    return CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND;
+}
+
+CHIP_ERROR IndexedSubscriptionResumptionStorage::DeleteAll(FabricIndex fabricIndex)
+{
+    CHIP_ERROR deleteErr = CHIP_NO_ERROR;
+    bool indexChanged    = false;
+
+    for (uint16_t subscriptionIndex = 0; subscriptionIndex < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; subscriptionIndex++)
+    {
+        IndexEntry & entry = mIndex[subscriptionIndex];
+        if (!entry.mInUse || entry.mFabricIndex != fabricIndex)
+        {
+            continue;
+        }
+
+        CHIP_ERROR err = SimpleSubscriptionResumptionStorage::Delete(subscriptionIndex);
+        if ((err != CHIP_NO_ERROR) && (err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND))
+        {
+            deleteErr = err;
+            continue;
+        }
+        entry.mInUse = false;
+        indexChanged = true;
+    }
+
+    if (indexChanged || IndexCount() == 0)
+    {
+        CHIP_ERROR err = SaveIndex();
+        if (err != CHIP_NO_ERROR)
+        {
+            deleteErr = err;
+        }
+    }
+
+    return deleteErr;
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,129 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines an implementation of SubscriptionResumptionStorage that
+ *      keeps an index of the persisted subscriptions, so that saving, deleting and
+ *      counting subscriptions does not need to load every stored subscription.
+ */
+
+#pragma once
+
+#include <app/SimpleSubscriptionResumptionStorage.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * A SubscriptionResumptionStorage that stores subscriptions in the same slots and format as
+ * SimpleSubscriptionResumptionStorage, plus a single persisted index of which slot holds which
+ * subscription. The index is mirrored in RAM, so that:
+ *
+ * - Save() and Delete() find the slot without reading any subscription from storage, and write the
+ *   subscription and the index.
+ * - IterateSubscriptions() only reads the slots in use.
+ * - IterateSubscriptionSummaries() does not read storage at all.
+ *
+ * Storage written by SimpleSubscriptionResumptionStorage is indexed the first time Init() finds no
+ * index. Init() also rebuilds the index when the slots in use no longer match it, as after running
+ * a firmware that only uses SimpleSubscriptionResumptionStorage. A slot that such a firmware
+ * rewrote in place is corrected in the index when IterateSubscriptions() loads it.
+ */
+class IndexedSubscriptionResumptionStorage : public SimpleSubscriptionResumptionStorage
+{
+public:
+    CHIP_ERROR Init(PersistentStorageDelegate * storage);
+
+    SubscriptionInfoIterator * IterateSubscriptions() override;
+
+    SubscriptionInfoIterator * IterateSubscriptionSummaries() override;
+
+    CHIP_ERROR Find(NodeId nodeId, FabricIndex fabricIndex, SubscriptionId subscriptionId,
+                    SubscriptionInfo & subscriptionInfo) override;
+
+    CHIP_ERROR Save(SubscriptionInfo & subscriptionInfo) override;
+
+    CHIP_ERROR Delete(NodeId nodeId, FabricIndex fabricIndex, SubscriptionId subscriptionId) override;
+
+    CHIP_ERROR DeleteAll(FabricIndex fabricIndex) override;
+
+protected:
+    struct IndexEntry
+    {
+        bool mInUse = false;
+        bool mFabricFiltered;
+        FabricIndex mFabricIndex;
+        uint16_t mMinInterval;
+        uint16_t mMaxInterval;
+        SubscriptionId mSubscriptionId;
+        NodeId mNodeId;
+
+        bool Matches(NodeId nodeId, FabricIndex fabricIndex, SubscriptionId subscriptionId) const
+        {
+            return mInUse && mNodeId == nodeId && mFabricIndex == fabricIndex && mSubscriptionId == subscriptionId;
+        }
+    };
+
+    class IndexedSubscriptionInfoIterator : public SubscriptionInfoIterator
+    {
+    public:
+        IndexedSubscriptionInfoIterator(IndexedSubscriptionResumptionStorage & storage, bool withPaths);
+        size_t Count() override;
+        bool Next(SubscriptionInfo & output) override;
+        void Release() override;
+
+    private:
+        IndexedSubscriptionResumptionStorage & mStorage;
+        uint16_t mNextIndex;
+        bool mWithPaths;
+    };
+
+    static constexpr size_t MaxIndexSize()
+    {
+        return TLV::EstimateStructOverhead(
+            TLV::EstimateStructOverhead(sizeof(uint16_t), sizeof(NodeId), sizeof(FabricIndex), sizeof(SubscriptionId),
+                                        sizeof(uint16_t), sizeof(uint16_t), sizeof(bool)) *
+            CHIP_IM_MAX_NUM_SUBSCRIPTIONS);
+    }
+
+    // Index of the persisted subscriptions, stored under DefaultStorageKeyAllocator::SubscriptionResumptionIndex():
+    //
+    //   List of:
+    //     Structure of: (Index entry)
+    //       Slot index
+    //       Node ID
+    //       Fabric Index
+    //       Subscription ID
+    //       Min interval
+    //       Max interval
+    //       Fabric filtered boolean
+
+    static constexpr TLV::Tag kSlotIndexTag = TLV::ContextTag(17);
+
+    CHIP_ERROR LoadIndex();
+    bool IndexMatchesSlots() const;
+    CHIP_ERROR RebuildIndex();
+    CHIP_ERROR SaveIndex();
+    uint16_t IndexCount() const;
+    void SetEntry(uint16_t subscriptionIndex, const SubscriptionInfo & subscriptionInfo);
+
+    IndexEntry mIndex[CHIP_IM_MAX_NUM_SUBSCRIPTIONS];
+    ObjectPool<IndexedSubscriptionInfoIterator, kIteratorsMax> mIndexedSubscriptionInfoIterators;
+};
+} // namespace app
+} // namespace chip
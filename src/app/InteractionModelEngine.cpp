@@ -82,6 +82,9 @@ CHIP_ERROR InteractionModelEngine::Init(Messaging::ExchangeManager * apExchangeM
     ReturnErrorOnFailure(mpExchangeMgr->RegisterUnsolicitedMessageHandlerForProtocol(Protocols::InteractionModel::Id, this));
 
     mReportingEngine.Init();
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    ReturnErrorOnFailure(mSubscriptionResumptionScheduler.Init(&mSubscriptionResumptionTimerDelegate, this));
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
     mMagic++;
 
     StatusIB::RegisterErrorFormatter();
@@ -92,6 +95,9 @@ CHIP_ERROR InteractionModelEngine::Init(Messaging::ExchangeManager * apExchangeM
 void InteractionModelEngine::Shutdown()
 {
     mpExchangeMgr->GetSessionManager()->SystemLayer()->CancelTimer(ResumeSubscriptionsTimerCallback, this);
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    mSubscriptionResumptionScheduler.Shutdown();
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
 
     CommandHandlerInterface * handlerIter = mCommandHandlerList;
 
@@ -160,6 +166,8 @@ void InteractionModelEngine::Shutdown()
     }
 
     mReportingEngine.Shutdown();
+    mSharedAttributePathLists.ReleaseAll();
+    mSharedEventPathLists.ReleaseAll();
     mAttributePathPool.ReleaseAll();
     mEventPathPool.ReleaseAll();
     mDataVersionFilterPool.ReleaseAll();
@@ -1477,7 +1485,12 @@ bool InteractionModelEngine::HasConflictWriteRequests(const WriteHandler * apWri
 
 void InteractionModelEngine::ReleaseAttributePathList(ObjectList<AttributePathParams> *& aAttributePathList)
 {
-    ReleasePool(aAttributePathList, mAttributePathPool);
+    mSharedAttributePathLists.Release(aAttributePathList, mAttributePathPool);
+}
+
+void InteractionModelEngine::ShareAttributePathList(ObjectList<AttributePathParams> *& aAttributePathList)
+{
+    mSharedAttributePathLists.Share(aAttributePathList, mAttributePathPool);
 }
 
 CHIP_ERROR InteractionModelEngine::PushFrontAttributePathList(ObjectList<AttributePathParams> *& aAttributePathList,
@@ -1549,7 +1562,12 @@ void InteractionModelEngine::RemoveDuplicateConcreteAttributePath(ObjectList<Att
 
 void InteractionModelEngine::ReleaseEventPathList(ObjectList<EventPathParams> *& aEventPathList)
 {
-    ReleasePool(aEventPathList, mEventPathPool);
+    mSharedEventPathLists.Release(aEventPathList, mEventPathPool);
+}
+
+void InteractionModelEngine::ShareEventPathList(ObjectList<EventPathParams> *& aEventPathList)
+{
+    mSharedEventPathLists.Share(aEventPathList, mEventPathPool);
 }
 
 CHIP_ERROR InteractionModelEngine::PushFrontEventPathParamsList(ObjectList<EventPathParams> *& aEventPathList,
@@ -1805,6 +1823,10 @@ size_t InteractionModelEngine::GetNumDirtySubscriptions() const
 
 void InteractionModelEngine::OnFabricRemoved(const FabricTable & fabricTable, FabricIndex fabricIndex)
 {
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    mSubscriptionResumptionScheduler.CancelFabric(fabricIndex);
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+
     mReadHandlers.ForEachActiveObject([fabricIndex](ReadHandler * handler) {
         if (handler->GetAccessingFabricIndex() == fabricIndex)
         {
@@ -1851,34 +1873,14 @@ CHIP_ERROR InteractionModelEngine::ResumeSubscriptions()
 #endif
 
     // To avoid the case of a reboot loop causing rapid traffic generation / power consumption, subscription resumption should make
-    // use of the persisted min-interval values, and wait before resumption. Ideally, each persisted subscription should wait their
-    // own min-interval value before resumption, but that both A) potentially runs into a timer resource issue, and B) having a
-    // low-powered device wake many times also has energy use implications. The logic below waits the largest of the persisted
-    // min-interval values before resuming subscriptions.
-
-    // Even though this causes subscription-to-subscription interaction by linking the min-interval values, this is the right thing
-    // to do for now because it's both simple and avoids the timer resource and multiple-wake problems. This issue is to track
-    // future improvements: https://github.com/project-chip/connectedhomeip/issues/25439
-
-    SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo;
-    auto * iterator           = mpSubscriptionResumptionStorage->IterateSubscriptions();
-    int subscriptionsToResume = 0;
-    uint16_t minInterval      = 0;
-    while (iterator->Next(subscriptionInfo))
-    {
-        subscriptionsToResume++;
-        minInterval = std::max(minInterval, subscriptionInfo.mMinInterval);
-    }
-    iterator->Release();
-
+    // use of the persisted min-interval values, and wait before resumption. Each persisted subscription waits its own min-interval
+    // value, plus some jitter. The scheduler only keeps a single timer armed for the earliest one, and bounds the number of CASE
+    // sessions being established at the same time so that a device with many subscriptions does not resume them in one burst.
+    size_t subscriptionsToResume = ScheduleSubscriptionResumptions(/* afterMinInterval = */ true);
     if (subscriptionsToResume)
     {
-#if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
-        mSubscriptionResumptionScheduled = true;
-#endif
-        ChipLogProgress(InteractionModel, "Resuming %d subscriptions in %u seconds", subscriptionsToResume, minInterval);
-        ReturnErrorOnFailure(mpExchangeMgr->GetSessionManager()->SystemLayer()->StartTimer(System::Clock::Seconds16(minInterval),
-                                                                                           ResumeSubscriptionsTimerCallback, this));
+        ChipLogProgress(InteractionModel, "Resuming %u subscriptions after their min interval",
+                        static_cast<unsigned>(subscriptionsToResume));
     }
     else
     {
@@ -1896,56 +1898,97 @@ void InteractionModelEngine::ResumeSubscriptionsTimerCallback(System::Layer * ap
     InteractionModelEngine * imEngine = static_cast<InteractionModelEngine *>(apAppState);
 #if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
     imEngine->mSubscriptionResumptionScheduled = false;
-    bool resumedSubscriptions                  = false;
 #endif // CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
+    size_t subscriptionsToResume = imEngine->ScheduleSubscriptionResumptions(/* afterMinInterval = */ false);
+
+#if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
+    // If no persisted subscriptions needed resumption then all resumption retries are done
+    if (subscriptionsToResume == 0)
+    {
+        imEngine->mNumSubscriptionResumptionRetries = 0;
+    }
+#else
+    (void) subscriptionsToResume;
+#endif // CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
+
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+}
+
+CHIP_ERROR InteractionModelEngine::StartResumption(const SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo)
+{
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    VerifyOrReturnError(mpSubscriptionResumptionStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mpCASESessionMgr != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    // If subscription happens between reboot and its resumption, it's already live and should skip resumption
+    if (IsSubscriptionActive(subscriptionInfo.mSubscriptionId))
+    {
+        ChipLogProgress(InteractionModel, "Skip resuming live subscriptionId %" PRIu32, subscriptionInfo.mSubscriptionId);
+        mSubscriptionResumptionScheduler.OnResumptionDone(subscriptionInfo.mNodeId, subscriptionInfo.mFabricIndex,
+                                                          subscriptionInfo.mSubscriptionId);
+        return CHIP_NO_ERROR;
+    }
+
+    // The scheduler only keeps the summary of the subscription, load its paths now
+    SubscriptionResumptionStorage::SubscriptionInfo persistedSubscriptionInfo;
+    ReturnErrorOnFailure(mpSubscriptionResumptionStorage->Find(subscriptionInfo.mNodeId, subscriptionInfo.mFabricIndex,
+                                                               subscriptionInfo.mSubscriptionId, persistedSubscriptionInfo));
+
+    auto subscriptionResumptionSessionEstablisher = Platform::MakeUnique<SubscriptionResumptionSessionEstablisher>();
+    VerifyOrReturnError(subscriptionResumptionSessionEstablisher != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    // The establisher notifies the scheduler when it is destroyed, once the session is established or failed
+    ReturnErrorOnFailure(
+        subscriptionResumptionSessionEstablisher->ResumeSubscription(*mpCASESessionMgr, persistedSubscriptionInfo));
+    subscriptionResumptionSessionEstablisher.release();
+    return CHIP_NO_ERROR;
+#else
+    return CHIP_ERROR_NOT_IMPLEMENTED;
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+}
+
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+size_t InteractionModelEngine::ScheduleSubscriptionResumptions(bool afterMinInterval)
+{
+    VerifyOrReturnValue(mpSubscriptionResumptionStorage != nullptr, 0);
+
+    size_t subscriptionsToResume = 0;
     SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo;
-    AutoReleaseSubscriptionInfoIterator iterator(imEngine->mpSubscriptionResumptionStorage->IterateSubscriptions());
+    AutoReleaseSubscriptionInfoIterator iterator(mpSubscriptionResumptionStorage->IterateSubscriptionSummaries());
     while (iterator->Next(subscriptionInfo))
     {
-        // If subscription happens between reboot and this timer callback, it's already live and should skip resumption
-        if (Loop::Break == imEngine->mReadHandlers.ForEachActiveObject([&](ReadHandler * handler) {
-                SubscriptionId subscriptionId;
-                handler->GetSubscriptionId(subscriptionId);
-                if (subscriptionId == subscriptionInfo.mSubscriptionId)
-                {
-                    return Loop::Break;
-                }
-                return Loop::Continue;
-            }))
+        if (IsSubscriptionActive(subscriptionInfo.mSubscriptionId))
         {
-            ChipLogProgress(InteractionModel, "Skip resuming live subscriptionId %" PRIu32, subscriptionInfo.mSubscriptionId);
             continue;
         }
 
-        auto subscriptionResumptionSessionEstablisher = Platform::MakeUnique<SubscriptionResumptionSessionEstablisher>();
-        if (subscriptionResumptionSessionEstablisher == nullptr)
-        {
-            ChipLogProgress(InteractionModel, "Failed to create SubscriptionResumptionSessionEstablisher");
-            return;
-        }
-
-        if (subscriptionResumptionSessionEstablisher->ResumeSubscription(*imEngine->mpCASESessionMgr, subscriptionInfo) !=
-            CHIP_NO_ERROR)
+        CHIP_ERROR err = afterMinInterval ? mSubscriptionResumptionScheduler.Schedule(subscriptionInfo)
+                                          : mSubscriptionResumptionScheduler.Schedule(subscriptionInfo, System::Clock::kZero);
+        if (err != CHIP_NO_ERROR)
         {
-            ChipLogProgress(InteractionModel, "Failed to ResumeSubscription 0x%" PRIx32, subscriptionInfo.mSubscriptionId);
-            return;
+            ChipLogProgress(InteractionModel, "Failed to schedule resumption of subscription 0x%" PRIx32 ": %" CHIP_ERROR_FORMAT,
+                            subscriptionInfo.mSubscriptionId, err.Format());
+            continue;
         }
-        subscriptionResumptionSessionEstablisher.release();
-#if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
-        resumedSubscriptions = true;
-#endif // CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
+        subscriptionsToResume++;
     }
 
-#if CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
-    // If no persisted subscriptions needed resumption then all resumption retries are done
-    if (!resumedSubscriptions)
-    {
-        imEngine->mNumSubscriptionResumptionRetries = 0;
-    }
-#endif // CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
+    return subscriptionsToResume;
+}
 
-#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+bool InteractionModelEngine::IsSubscriptionActive(SubscriptionId subscriptionId)
+{
+    return Loop::Break == mReadHandlers.ForEachActiveObject([&](ReadHandler * handler) {
+        SubscriptionId handlerSubscriptionId;
+        handler->GetSubscriptionId(handlerSubscriptionId);
+        if (handlerSubscriptionId == subscriptionId)
+        {
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    });
 }
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
 
 #if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS && CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION
 uint32_t InteractionModelEngine::ComputeTimeSecondsTillNextSubscriptionResumption()
@@ -1964,21 +2007,14 @@ bool InteractionModelEngine::HasSubscriptionsToResume()
 {
     VerifyOrReturnValue(mpSubscriptionResumptionStorage != nullptr, false);
 
-    // Look through persisted subscriptions and see if any aren't already in mReadHandlers pool
+    // Look through persisted subscriptions and see if any aren't already in mReadHandlers pool or waiting to be resumed
     SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo;
-    auto * iterator                = mpSubscriptionResumptionStorage->IterateSubscriptions();
+    auto * iterator                = mpSubscriptionResumptionStorage->IterateSubscriptionSummaries();
     bool foundSubscriptionToResume = false;
     while (iterator->Next(subscriptionInfo))
     {
-        if (Loop::Break == mReadHandlers.ForEachActiveObject([&](ReadHandler * handler) {
-                SubscriptionId subscriptionId;
-                handler->GetSubscriptionId(subscriptionId);
-                if (subscriptionId == subscriptionInfo.mSubscriptionId)
-                {
-                    return Loop::Break;
-                }
-                return Loop::Continue;
-            }))
+        if (IsSubscriptionActive(subscriptionInfo.mSubscriptionId) ||
+            mSubscriptionResumptionScheduler.IsScheduled(subscriptionInfo.mSubscriptionId))
         {
             continue;
         }
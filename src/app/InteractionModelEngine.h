@@ -29,6 +29,7 @@
 #include <app/AppConfig.h>
 #include <app/MessageDef/AttributeReportIBs.h>
 #include <app/MessageDef/ReportDataMessage.h>
+#include <app/SubscriptionResumptionScheduler.h>
 #include <app/SubscriptionResumptionSessionEstablisher.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
@@ -54,8 +55,10 @@
 #include <app/ObjectList.h>
 #include <app/ReadClient.h>
 #include <app/ReadHandler.h>
+#include <app/SharedObjectLists.h>
 #include <app/StatusResponse.h>
 #include <app/TimedHandler.h>
+#include <app/TimerDelegates.h>
 #include <app/WriteClient.h>
 #include <app/WriteHandler.h>
 #include <app/reporting/Engine.h>
@@ -79,7 +82,8 @@ class InteractionModelEngine : public Messaging::UnsolicitedMessageHandler,
                                public Messaging::ExchangeDelegate,
                                public CommandHandler::Callback,
                                public ReadHandler::ManagementCallback,
-                               public FabricTable::Delegate
+                               public FabricTable::Delegate,
+                               public SubscriptionResumptionScheduler::Delegate
 {
 public:
     /**
@@ -196,6 +200,14 @@ public:
 
     void ReleaseEventPathList(ObjectList<EventPathParams> *& aEventPathList);
 
+    /**
+     * Replace the path list of a subscription, once it will not be modified anymore, with an equal list that other
+     * subscriptions already use, if any.  Lists shared this way are released with ReleaseAttributePathList() and
+     * ReleaseEventPathList() as usual.
+     */
+    void ShareAttributePathList(ObjectList<AttributePathParams> *& aAttributePathList);
+    void ShareEventPathList(ObjectList<EventPathParams> *& aEventPathList);
+
     CHIP_ERROR PushFrontEventPathParamsList(ObjectList<EventPathParams> *& aEventPathList, EventPathParams & aEventPath);
 
     void ReleaseDataVersionFilterList(ObjectList<DataVersionFilter> *& aDataVersionFilterList);
@@ -324,6 +336,15 @@ public:
     //
     auto & GetReadHandlerPool() { return mReadHandlers; }
 
+    //
+    // Inspect how the attribute paths of subscriptions are shared, see ShareAttributePathList()
+    //
+    size_t GetNumAllocatedAttributePaths() const { return mAttributePathPool.Allocated(); }
+    uint32_t GetAttributePathListRefCount(const ObjectList<AttributePathParams> * aList)
+    {
+        return mSharedAttributePathLists.GetRefCount(aList);
+    }
+
     //
     // Override the maximal capacity of the fabric table only for interaction model engine
     //
@@ -395,6 +416,9 @@ private:
     void OnDone(CommandHandler & apCommandObj) override;
     void OnDone(ReadHandler & apReadObj) override;
 
+    // SubscriptionResumptionScheduler::Delegate
+    CHIP_ERROR StartResumption(const SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo) override;
+
     ReadHandler::ApplicationCallback * GetAppCallback() override { return mpReadHandlerApplicationCallback; }
 
     CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader, ExchangeDelegate *& newDelegate) override;
@@ -576,6 +600,17 @@ private:
 
     static void ResumeSubscriptionsTimerCallback(System::Layer * apSystemLayer, void * apAppState);
 
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    /**
+     * Hand the persisted subscriptions that are not live to the resumption scheduler, either after their own min interval or
+     * as soon as possible.
+     *
+     * @return the number of subscriptions scheduled.
+     */
+    size_t ScheduleSubscriptionResumptions(bool afterMinInterval);
+    bool IsSubscriptionActive(SubscriptionId subscriptionId);
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+
     template <typename T, size_t N>
     void ReleasePool(ObjectList<T> *& aObjectList, ObjectPool<ObjectList<T>, N> & aObjectPool);
     template <typename T, size_t N>
@@ -617,6 +652,10 @@ private:
                CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_READS + CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS_FOR_SUBSCRIPTIONS>
         mDataVersionFilterPool;
 
+    // Path lists shared between subscriptions, see ShareAttributePathList().
+    SharedObjectLists<AttributePathParams, CHIP_IM_MAX_NUM_SUBSCRIPTIONS> mSharedAttributePathLists;
+    SharedObjectLists<EventPathParams, CHIP_IM_MAX_NUM_SUBSCRIPTIONS> mSharedEventPathLists;
+
     ObjectPool<ReadHandler, CHIP_IM_MAX_NUM_READS + CHIP_IM_MAX_NUM_SUBSCRIPTIONS> mReadHandlers;
 
 #if CHIP_CONFIG_ENABLE_READ_CLIENT
@@ -653,6 +692,11 @@ private:
 
     SubscriptionResumptionStorage * mpSubscriptionResumptionStorage = nullptr;
 
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    DefaultTimerDelegate mSubscriptionResumptionTimerDelegate;
+    SubscriptionResumptionScheduler mSubscriptionResumptionScheduler;
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+
     // A magic number for tracking values between stack Shutdown()-s and Init()-s.
     // An ObjectHandle is valid iff. its magic equals to this one.
     uint32_t mMagic = 0;
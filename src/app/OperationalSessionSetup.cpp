@@ -46,6 +46,11 @@ using chip::AddressResolve::ResolveResult;
 
 namespace chip {
 
+namespace {
+// Source of OperationalSessionSetup::mCASEClientAdmissionTicket values; only touched on the Matter thread.
+uint32_t sNextCASEClientAdmissionTicket = 0;
+} // namespace
+
 void OperationalSessionSetup::MoveToState(State aTargetState)
 {
     if (mState != aTargetState)
@@ -73,7 +78,7 @@ void OperationalSessionSetup::MoveToState(State aTargetState)
 bool OperationalSessionSetup::AttachToExistingSecureSession()
 {
     VerifyOrReturnError(mState == State::NeedsAddress || mState == State::ResolvingAddress || mState == State::HasAddress ||
-                            mState == State::WaitingForRetry,
+                            mState == State::WaitingForRetry || mState == State::WaitingForCASEClient,
                         false);
 
     auto sessionHandle =
@@ -131,6 +136,7 @@ void OperationalSessionSetup::Connect(Callback::Callback<OnDeviceConnected> * on
 
     case State::ResolvingAddress:
     case State::WaitingForRetry:
+    case State::WaitingForCASEClient:
         isConnected = AttachToExistingSecureSession();
         break;
 
@@ -288,7 +294,22 @@ void OperationalSessionSetup::UpdateDeviceData(const Transport::PeerAddress & ad
 
 CHIP_ERROR OperationalSessionSetup::EstablishConnection(const ReliableMessageProtocolConfig & config)
 {
-    mCASEClient = mClientPool->Allocate();
+    // AdmitWaitingForCASEClient allocates our CASE client before calling us.
+    if (mCASEClient == nullptr)
+    {
+        mCASEClient = mClientPool->Allocate();
+    }
+#if CHIP_CONFIG_ENABLE_CASE_CLIENT_ADMISSION_CONTROL
+    if (mCASEClient == nullptr)
+    {
+        // All CASE clients are busy with other handshakes.  Wait for one of them to be
+        // released instead of failing; our release delegate will admit us then.
+        mAdmissionRemoteMRPConfig  = config;
+        mCASEClientAdmissionTicket = sNextCASEClientAdmissionTicket++;
+        MoveToState(State::WaitingForCASEClient);
+        return CHIP_NO_ERROR;
+    }
+#endif // CHIP_CONFIG_ENABLE_CASE_CLIENT_ADMISSION_CONTROL
     ReturnErrorCodeIf(mCASEClient == nullptr, CHIP_ERROR_NO_MEMORY);
 
     CHIP_ERROR err = mCASEClient->EstablishSession(mInitParams, mPeerId, mDeviceAddress, config, this);
@@ -303,6 +324,55 @@ CHIP_ERROR OperationalSessionSetup::EstablishConnection(const ReliableMessagePro
     return CHIP_NO_ERROR;
 }
 
+bool OperationalSessionSetup::AdmitWaitingForCASEClient()
+{
+    VerifyOrReturnValue(mState == State::WaitingForCASEClient, false);
+
+    // EstablishConnection is only ever called from State::HasAddress.
+    MoveToState(State::HasAddress);
+
+    mCASEClient = mClientPool->Allocate();
+    if (mCASEClient == nullptr)
+    {
+        // Keep waiting with our current admission ticket, so that we do not
+        // lose our place in line.
+        MoveToState(State::WaitingForCASEClient);
+        return false;
+    }
+
+    CHIP_ERROR err = EstablishConnection(mAdmissionRemoteMRPConfig);
+    if (err == CHIP_NO_ERROR)
+    {
+        return true;
+    }
+
+    ChipLogError(Discovery, "OperationalSessionSetup[%u:" ChipLogFormatX64 "]: Failed to start CASE handshake: %" CHIP_ERROR_FORMAT,
+                 mPeerId.GetFabricIndex(), ChipLogValueX64(mPeerId.GetNodeId()), err.Format());
+    DequeueConnectionCallbacks(err);
+    // Do not touch `this` instance anymore; it has been destroyed in DequeueConnectionCallbacks.
+    return true;
+}
+
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+void OperationalSessionSetup::TestOnlyConnectToAddress(const Transport::PeerAddress & addr,
+                                                       Callback::Callback<OnDeviceConnected> * onConnection,
+                                                       Callback::Callback<OnDeviceConnectionFailure> * onFailure)
+{
+    EnqueueConnectionCallbacks(onConnection, onFailure, nullptr);
+
+    if (mState != State::NeedsAddress)
+    {
+        DequeueConnectionCallbacks(CHIP_ERROR_INCORRECT_STATE);
+        // Do not touch `this` instance anymore; it has been destroyed in DequeueConnectionCallbacks.
+        return;
+    }
+
+    // Pretend that the address lookup just completed.
+    MoveToState(State::ResolvingAddress);
+    UpdateDeviceData(addr, GetDefaultMRPConfig());
+}
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+
 void OperationalSessionSetup::EnqueueConnectionCallbacks(Callback::Callback<OnDeviceConnected> * onConnection,
                                                          Callback::Callback<OnDeviceConnectionFailure> * onFailure,
                                                          Callback::Callback<OnSetupFailure> * onSetupFailure)
@@ -506,6 +576,7 @@ void OperationalSessionSetup::CleanupCASEClient()
     {
         mClientPool->Release(mCASEClient);
         mCASEClient = nullptr;
+        mReleaseDelegate->OnCASEClientReleased();
     }
 }
 
@@ -540,7 +611,7 @@ OperationalSessionSetup::~OperationalSessionSetup()
     DequeueConnectionCallbacks(CHIP_ERROR_CANCELLED, ReleaseBehavior::DoNotRelease);
 }
 
-CHIP_ERROR OperationalSessionSetup::LookupPeerAddress()
+CHIP_ERROR OperationalSessionSetup::LookupPeerAddress(bool bypassCache)
 {
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
     if (mRemainingAttempts > 0)
@@ -575,6 +646,7 @@ CHIP_ERROR OperationalSessionSetup::LookupPeerAddress()
     PeerId peerId(fabricInfo->GetCompressedFabricId(), mPeerId.GetNodeId());
 
     NodeLookupRequest request(peerId);
+    request.SetBypassCache(bypassCache);
 
     return Resolver::Instance().LookupNode(request, mAddressLookupHandle);
 }
@@ -595,7 +667,7 @@ void OperationalSessionSetup::PerformAddressUpdate()
     // We are doing an address lookup whether we have an active session for this peer or not.
     mPerformingAddressUpdate = true;
     MoveToState(State::ResolvingAddress);
-    CHIP_ERROR err = LookupPeerAddress();
+    CHIP_ERROR err = LookupPeerAddress(/* bypassCache = */ true);
     if (err != CHIP_NO_ERROR)
     {
         ChipLogError(Discovery, "Failed to look up peer address: %" CHIP_ERROR_FORMAT, err.Format());
@@ -748,7 +820,8 @@ void OperationalSessionSetup::TrySetupAgain(System::Layer * systemLayer, void *
     auto * self = static_cast<OperationalSessionSetup *>(state);
 
     self->MoveToState(State::ResolvingAddress);
-    CHIP_ERROR err = self->LookupPeerAddress();
+    // The previous attempt failed with the resolved address, so do not reuse cached records.
+    CHIP_ERROR err = self->LookupPeerAddress(/* bypassCache = */ true);
     if (err == CHIP_NO_ERROR)
     {
         return;
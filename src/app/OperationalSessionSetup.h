@@ -62,6 +62,12 @@ class OperationalSessionReleaseDelegate
 public:
     virtual ~OperationalSessionReleaseDelegate()                        = default;
     virtual void ReleaseSession(OperationalSessionSetup * sessionSetup) = 0;
+
+    /**
+     * Called when an OperationalSessionSetup hands its CASE client back to the
+     * pool, so that session setups waiting for a free CASE client can be admitted.
+     */
+    virtual void OnCASEClientReleased() {}
 };
 
 /**
@@ -254,6 +260,40 @@ public:
 
     void PerformAddressUpdate();
 
+    /**
+     * Returns true if this session setup has an address for its peer, but is
+     * waiting for a CASE client to become available before starting the CASE
+     * handshake.  See CHIP_CONFIG_ENABLE_CASE_CLIENT_ADMISSION_CONTROL.
+     */
+    bool IsWaitingForCASEClient() const { return mState == State::WaitingForCASEClient; }
+
+    /**
+     * Monotonically increasing value assigned when this session setup started
+     * waiting for a CASE client.  Lower values have been waiting longer.
+     */
+    uint32_t GetCASEClientAdmissionTicket() const { return mCASEClientAdmissionTicket; }
+
+    /**
+     * Try to start the CASE handshake of a session setup that is waiting for a
+     * CASE client.
+     *
+     * Returns false if no CASE client could be allocated, in which case the
+     * session setup keeps waiting.  Returns true otherwise; note that if the
+     * handshake could not be started, the session setup has notified its
+     * failure callbacks and released itself, so callers must not touch it
+     * after this call.
+     */
+    bool AdmitWaitingForCASEClient();
+
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    /**
+     * Version of Connect that skips the address lookup and establishes a
+     * session with the peer at the given address.  For use in tests only.
+     */
+    void TestOnlyConnectToAddress(const Transport::PeerAddress & addr, Callback::Callback<OnDeviceConnected> * onConnection,
+                                  Callback::Callback<OnDeviceConnectionFailure> * onFailure);
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+
     // AddressResolve::NodeListener - notifications when dnssd finds a node IP address
     void OnNodeAddressResolved(const PeerId & peerId, const AddressResolve::ResolveResult & result) override;
     void OnNodeAddressResolutionFailed(const PeerId & peerId, CHIP_ERROR reason) override;
@@ -269,14 +309,16 @@ public:
 private:
     enum class State : uint8_t
     {
-        Uninitialized,    // Error state: OperationalSessionSetup is useless
-        NeedsAddress,     // No address known, lookup not started yet.
-        ResolvingAddress, // Address lookup in progress.
-        HasAddress,       // Have an address, CASE handshake not started yet.
-        Connecting,       // CASE handshake in progress.
-        SecureConnected,  // CASE session established.
-        WaitingForRetry,  // No address known, but a retry is pending.  Added at
-                          // end to make logs easier to understand.
+        Uninitialized,        // Error state: OperationalSessionSetup is useless
+        NeedsAddress,         // No address known, lookup not started yet.
+        ResolvingAddress,     // Address lookup in progress.
+        HasAddress,           // Have an address, CASE handshake not started yet.
+        Connecting,           // CASE handshake in progress.
+        SecureConnected,      // CASE session established.
+        WaitingForRetry,      // No address known, but a retry is pending.  Added at
+                              // end to make logs easier to understand.
+        WaitingForCASEClient, // Have an address, waiting for a free CASE client
+                              // to start the CASE handshake.
     };
 
     CASEClientInitParams mInitParams;
@@ -305,6 +347,11 @@ private:
 
     bool mPerformingAddressUpdate = false;
 
+    // Remote MRP config to hand to the CASE client once we are admitted out of
+    // State::WaitingForCASEClient.
+    ReliableMessageProtocolConfig mAdmissionRemoteMRPConfig = GetDefaultMRPConfig();
+    uint32_t mCASEClientAdmissionTicket                     = 0;
+
 #if CHIP_DEVICE_CONFIG_ENABLE_AUTOMATIC_CASE_RETRIES
     // When we TryNextResult on the resolver, it will synchronously call back
     // into our OnNodeAddressResolved when it succeeds.  We need to track
@@ -386,8 +433,12 @@ private:
 
     /**
      * Triggers a DNSSD lookup to find a usable peer address.
+     *
+     * @param[in] bypassCache Whether the lookup is retried because the previously
+     *                        resolved address did not work, in which case cached
+     *                        DNSSD records for the peer are not reused.
      */
-    CHIP_ERROR LookupPeerAddress();
+    CHIP_ERROR LookupPeerAddress(bool bypassCache = false);
 
     /**
      * This function will set new IP address, port and MRP retransmission intervals of the device.
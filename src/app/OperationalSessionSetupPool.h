@@ -34,6 +34,9 @@ public:
 
     virtual OperationalSessionSetup * FindSessionSetup(ScopedNodeId peerId, bool forAddressUpdate) = 0;
 
+    // Returns the session setup that has been waiting the longest for a CASE client, if any.
+    virtual OperationalSessionSetup * FindSessionSetupWaitingForCASEClient() = 0;
+
     virtual void ReleaseAllSessionSetupsForFabric(FabricIndex fabricIndex) = 0;
 
     virtual void ReleaseAllSessionSetup() = 0;
@@ -70,6 +73,27 @@ public:
         return foundDevice;
     }
 
+    OperationalSessionSetup * FindSessionSetupWaitingForCASEClient() override
+    {
+        OperationalSessionSetup * foundDevice = nullptr;
+        uint32_t foundTicket                  = 0;
+        mSessionSetupPool.ForEachActiveObject([&](auto * activeSetup) {
+            if (activeSetup->IsWaitingForCASEClient())
+            {
+                uint32_t ticket = activeSetup->GetCASEClientAdmissionTicket();
+                // Tickets only increase, so compare by difference to tolerate wraparound.
+                if (foundDevice == nullptr || static_cast<int32_t>(ticket - foundTicket) < 0)
+                {
+                    foundDevice = activeSetup;
+                    foundTicket = ticket;
+                }
+            }
+            return Loop::Continue;
+        });
+
+        return foundDevice;
+    }
+
     void ReleaseAllSessionSetupsForFabric(FabricIndex fabricIndex) override
     {
         mSessionSetupPool.ForEachActiveObject([&](auto * activeSetup) {
@@ -120,6 +120,9 @@ void ReadHandler::OnSubscriptionResumed(const SessionHandle & sessionHandle,
         }
     }
 
+    InteractionModelEngine::GetInstance()->ShareAttributePathList(mpAttributePathList);
+    InteractionModelEngine::GetInstance()->ShareEventPathList(mpEventPathList);
+
     mSessionHandle.Grab(sessionHandle);
 
     SetStateFlag(ReadHandlerFlags::ActiveSubscription);
@@ -354,6 +357,7 @@ CHIP_ERROR ReadHandler::SendReportData(System::PacketBufferHandle && aPayload, b
         mPreviousReportsBeginGeneration = mCurrentReportsBeginGeneration;
         ClearForceDirtyFlag();
         InteractionModelEngine::GetInstance()->ReleaseDataVersionFilterList(mpDataVersionFilterList);
+        ReleasePathIterator();
     }
 
     return err;
@@ -495,8 +499,7 @@ CHIP_ERROR ReadHandler::ProcessAttributePaths(AttributePathIBs::Parser & aAttrib
     if (CHIP_END_OF_TLV == err)
     {
         InteractionModelEngine::GetInstance()->RemoveDuplicateConcreteAttributePath(mpAttributePathList);
-        mAttributePathExpandIterator = AttributePathExpandIterator(mpAttributePathList);
-        err                          = CHIP_NO_ERROR;
+        err = CHIP_NO_ERROR;
     }
     return err;
 }
@@ -725,6 +728,10 @@ CHIP_ERROR ReadHandler::ProcessSubscribeRequest(System::PacketBufferHandle && aP
     }
     ReturnErrorOnFailure(err);
 
+    // The paths of a subscription do not change anymore, share them with the subscriptions that requested the same paths.
+    InteractionModelEngine::GetInstance()->ShareAttributePathList(mpAttributePathList);
+    InteractionModelEngine::GetInstance()->ShareEventPathList(mpEventPathList);
+
     ReturnErrorOnFailure(subscribeRequestParser.GetMinIntervalFloorSeconds(&mMinIntervalFloorSeconds));
     ReturnErrorOnFailure(subscribeRequestParser.GetMaxIntervalCeilingSeconds(&mMaxInterval));
     VerifyOrReturnError(mMinIntervalFloorSeconds <= mMaxInterval, CHIP_ERROR_INVALID_ARGUMENT);
@@ -835,8 +842,34 @@ void ReadHandler::PersistSubscription()
 
 void ReadHandler::ResetPathIterator()
 {
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    if (mpAttributePathExpandIterator)
+    {
+        *mpAttributePathExpandIterator = AttributePathExpandIterator(mpAttributePathList);
+    }
+    else
+    {
+        mpAttributePathExpandIterator = Platform::MakeUnique<AttributePathExpandIterator>(mpAttributePathList);
+    }
+#else
     mAttributePathExpandIterator = AttributePathExpandIterator(mpAttributePathList);
-    mAttributeEncoderState       = AttributeValueEncoder::AttributeEncodeState();
+#endif
+    mAttributeEncoderState = AttributeValueEncoder::AttributeEncodeState();
+    ReleaseEncodedListBuffer();
+}
+
+void ReadHandler::ReleasePathIterator()
+{
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    mpAttributePathExpandIterator.reset();
+#endif
+}
+
+void ReadHandler::ReleaseEncodedListBuffer()
+{
+#if CHIP_IM_SERVER_ENCODED_LIST_BUFFER_SIZE > 0
+    mpEncodedListBuffer.reset();
+#endif
 }
 
 void ReadHandler::AttributePathIsDirty(const AttributePathParams & aAttributeChanged)
@@ -854,7 +887,8 @@ void ReadHandler::AttributePathIsDirty(const AttributePathParams & aAttributeCha
     // TODO (#16699): Currently we can only guarantee the reports generated from a single path in the request are consistent. The
     // data might be inconsistent if the user send a request with two paths from the same cluster. We need to clearify the behavior
     // or make it consistent.
-    if (mAttributePathExpandIterator.Get(path) &&
+    AttributePathExpandIterator * iterator = GetAttributePathExpandIterator();
+    if (iterator != nullptr && iterator->Get(path) &&
         (aAttributeChanged.HasWildcardEndpointId() || aAttributeChanged.mEndpointId == path.mEndpointId) &&
         (aAttributeChanged.HasWildcardClusterId() || aAttributeChanged.mClusterId == path.mClusterId))
     {
@@ -864,8 +898,9 @@ void ReadHandler::AttributePathIsDirty(const AttributePathParams & aAttributeCha
         // If we're currently in the middle of generating reports for a given cluster and that in turn is marked dirty, let's reset
         // our iterator to point back to the beginning of that cluster. This ensures that the receiver will get a coherent view of
         // the state of the cluster as present on the server
-        mAttributePathExpandIterator.ResetCurrentCluster();
+        iterator->ResetCurrentCluster();
         mAttributeEncoderState = AttributeValueEncoder::AttributeEncodeState();
+        ReleaseEncodedListBuffer();
     }
 
     // ReportScheduler will take care of verifying the reportability of the handler and schedule the run
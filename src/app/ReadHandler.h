@@ -40,9 +40,11 @@
 #include <app/OperationalSessionSetup.h>
 #include <app/SubscriptionResumptionSessionEstablisher.h>
 #include <app/SubscriptionResumptionStorage.h>
+#include <app/reporting/EncodedListBuffer.h>
 #include <lib/core/CHIPCallback.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/TLVDebug.h>
+#include <lib/support/CHIPMem.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/DLLUtil.h>
 #include <lib/support/logging/CHIPLogging.h>
@@ -356,6 +358,12 @@ private:
     // Resets the path iterator to the beginning of the whole report for generating a series of new reports.
     void ResetPathIterator();
 
+    // Frees the path iterator once a report has been generated.
+    void ReleasePathIterator();
+
+    // Frees the encoded items of the list being chunked, the next chunk will read the list again.
+    void ReleaseEncodedListBuffer();
+
     CHIP_ERROR ProcessDataVersionFilterList(DataVersionFilterIBs::Parser & aDataVersionFilterListParser);
 
     // if current priority is in the middle, it has valid snapshoted last event number, it check cleaness via comparing
@@ -373,7 +381,16 @@ private:
     bool IsFabricFiltered() const { return mFlags.Has(ReadHandlerFlags::FabricFiltered); }
     CHIP_ERROR OnSubscribeRequest(Messaging::ExchangeContext * apExchangeContext, System::PacketBufferHandle && aPayload);
     void GetSubscriptionId(SubscriptionId & aSubscriptionId) const { aSubscriptionId = mSubscriptionId; }
-    AttributePathExpandIterator * GetAttributePathExpandIterator() { return &mAttributePathExpandIterator; }
+    // Only valid while generating a report, i.e. after ResetPathIterator() and until the last chunk is sent.  May be null if
+    // the iterator could not be allocated.
+    AttributePathExpandIterator * GetAttributePathExpandIterator()
+    {
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+        return mpAttributePathExpandIterator.get();
+#else
+        return &mAttributePathExpandIterator;
+#endif
+    }
 
     /// @brief Notifies the read handler that a set of attribute paths has been marked dirty. This will schedule a reporting engine
     /// run if the change to the attribute path makes the ReadHandler reportable.
@@ -484,7 +501,12 @@ private:
     /// @param aFlag Flag to clear
     void ClearStateFlag(ReadHandlerFlags aFlag);
 
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    // Subscriptions spend most of their time between reports, so the iterator is only allocated while generating one.
+    Platform::UniquePtr<AttributePathExpandIterator> mpAttributePathExpandIterator;
+#else
     AttributePathExpandIterator mAttributePathExpandIterator = AttributePathExpandIterator(nullptr);
+#endif
 
     // The current generation of the reporting engine dirty set the last time we were notified that a path we're interested in was
     // marked dirty.
@@ -557,6 +579,11 @@ private:
     // The size of AttributeEncoderState is 2 bytes for now.
     AttributeValueEncoder::AttributeEncodeState mAttributeEncoderState;
 
+#if CHIP_IM_SERVER_ENCODED_LIST_BUFFER_SIZE > 0
+    // The already encoded items of the list being chunked, if any.  Only allocated while a list is chunked.
+    Platform::UniquePtr<reporting::EncodedListBuffer> mpEncodedListBuffer;
+#endif
+
     // Current Handler state
     HandlerState mState            = HandlerState::Idle;
     PriorityLevel mCurrentPriority = PriorityLevel::Invalid;
@@ -0,0 +1,156 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/ObjectList.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/Pool.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Deduplicates identical, immutable ObjectLists allocated from an ObjectPool, e.g. the path lists of the many
+ * subscriptions that controllers with the same configuration establish with a bridge.
+ *
+ * Share() replaces a list with an equal list that is already shared, if any, and releases the nodes of the replaced
+ * list.  A shared list is reference counted and must not be modified.  Release() drops a reference and releases the
+ * nodes with the last one.  Lists that were never shared, e.g. because the registry is full, are released right away,
+ * so Release() can be used for every list allocated from the pool.
+ *
+ * Lists are equal if they hold equal elements in the same order.
+ */
+template <typename T, size_t N>
+class SharedObjectLists
+{
+public:
+    template <size_t M>
+    void Share(ObjectList<T> *& aList, ObjectPool<ObjectList<T>, M> & aPool)
+    {
+        VerifyOrReturn(aList != nullptr);
+
+        const size_t count = aList->Count();
+        Entry * existing   = nullptr;
+        mEntries.ForEachActiveObject([&](Entry * entry) {
+            if (entry->mCount == count && Equal(entry->mpList, aList))
+            {
+                existing = entry;
+                return Loop::Break;
+            }
+            return Loop::Continue;
+        });
+
+        if (existing != nullptr)
+        {
+            existing->mRefCount++;
+            ReleaseNodes(aList, aPool);
+            aList = existing->mpList;
+            return;
+        }
+
+        // If the registry is full, the list just stays private to its owner.
+        mEntries.CreateObject(aList, count);
+    }
+
+    template <size_t M>
+    void Release(ObjectList<T> *& aList, ObjectPool<ObjectList<T>, M> & aPool)
+    {
+        VerifyOrReturn(aList != nullptr);
+
+        Entry * entry = Find(aList);
+        if (entry != nullptr)
+        {
+            if (--entry->mRefCount > 0)
+            {
+                aList = nullptr;
+                return;
+            }
+            mEntries.ReleaseObject(entry);
+        }
+        ReleaseNodes(aList, aPool);
+    }
+
+    /**
+     * The number of references to aList, 0 if aList is not shared.
+     */
+    uint32_t GetRefCount(const ObjectList<T> * aList)
+    {
+        Entry * entry = Find(aList);
+        return entry == nullptr ? 0 : entry->mRefCount;
+    }
+
+    size_t GetSharedCount() const { return mEntries.Allocated(); }
+
+    /**
+     * Forget every shared list, without releasing any node.  To be used along with releasing all the objects of the pool.
+     */
+    void ReleaseAll() { mEntries.ReleaseAll(); }
+
+private:
+    struct Entry
+    {
+        Entry(ObjectList<T> * list, size_t count) : mpList(list), mCount(count) {}
+
+        ObjectList<T> * mpList;
+        size_t mCount;
+        uint32_t mRefCount = 1;
+    };
+
+    static bool Equal(const ObjectList<T> * a, const ObjectList<T> * b)
+    {
+        for (; a != nullptr && b != nullptr; a = a->mpNext, b = b->mpNext)
+        {
+            if (!(a->mValue == b->mValue))
+            {
+                return false;
+            }
+        }
+        return a == b;
+    }
+
+    template <size_t M>
+    static void ReleaseNodes(ObjectList<T> *& aList, ObjectPool<ObjectList<T>, M> & aPool)
+    {
+        while (aList != nullptr)
+        {
+            ObjectList<T> * next = aList->mpNext;
+            aPool.ReleaseObject(aList);
+            aList = next;
+        }
+    }
+
+    Entry * Find(const ObjectList<T> * aList)
+    {
+        Entry * found = nullptr;
+        mEntries.ForEachActiveObject([&](Entry * entry) {
+            if (entry->mpList == aList)
+            {
+                found = entry;
+                return Loop::Break;
+            }
+            return Loop::Continue;
+        });
+        return found;
+    }
+
+    ObjectPool<Entry, N> mEntries;
+};
+
+} // namespace app
+} // namespace chip
@@ -352,7 +352,12 @@ CHIP_ERROR SimpleSubscriptionResumptionStorage::Save(SubscriptionInfo & subscrip
         return CHIP_ERROR_NO_MEMORY;
     }
 
-    // Now construct subscription state and save
+    return Save(firstEmptySubscriptionIndex, subscriptionInfo);
+}
+
+CHIP_ERROR SimpleSubscriptionResumptionStorage::Save(uint16_t subscriptionIndex, SubscriptionInfo & subscriptionInfo)
+{
+    // Construct subscription state and save
     Platform::ScopedMemoryBuffer<uint8_t> backingBuffer;
     backingBuffer.Calloc(MaxSubscriptionSize());
     ReturnErrorCodeIf(backingBuffer.Get() == nullptr, CHIP_ERROR_NO_MEMORY);
@@ -366,9 +371,8 @@ CHIP_ERROR SimpleSubscriptionResumptionStorage::Save(SubscriptionInfo & subscrip
 
     writer.Finalize(backingBuffer);
 
-    ReturnErrorOnFailure(
-        mStorage->SyncSetKeyValue(DefaultStorageKeyAllocator::SubscriptionResumption(firstEmptySubscriptionIndex).KeyName(),
-                                  backingBuffer.Get(), static_cast<uint16_t>(len)));
+    ReturnErrorOnFailure(mStorage->SyncSetKeyValue(DefaultStorageKeyAllocator::SubscriptionResumption(subscriptionIndex).KeyName(),
+                                                   backingBuffer.Get(), static_cast<uint16_t>(len)));
 
     return CHIP_NO_ERROR;
 }
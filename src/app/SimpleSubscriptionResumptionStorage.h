@@ -52,6 +52,7 @@ public:
 
 protected:
     CHIP_ERROR Save(TLV::TLVWriter & writer, SubscriptionInfo & subscriptionInfo);
+    CHIP_ERROR Save(uint16_t subscriptionIndex, SubscriptionInfo & subscriptionInfo);
     CHIP_ERROR Load(uint16_t subscriptionIndex, SubscriptionInfo & subscriptionInfo);
     CHIP_ERROR Delete(uint16_t subscriptionIndex);
     uint16_t Count();
@@ -0,0 +1,245 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/SubscriptionResumptionScheduler.h>
+
+#include <crypto/RandUtils.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace app {
+
+CHIP_ERROR SubscriptionResumptionScheduler::Init(TimerDelegate * timerDelegate, Delegate * delegate,
+                                                 System::Clock::Milliseconds32 maxJitter)
+{
+    VerifyOrReturnError(timerDelegate != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(delegate != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mTimerDelegate = timerDelegate;
+    mDelegate      = delegate;
+    mMaxJitter     = maxJitter;
+    for (auto & entry : mEntries)
+    {
+        entry.mState = State::kFree;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+void SubscriptionResumptionScheduler::Shutdown()
+{
+    VerifyOrReturn(mTimerDelegate != nullptr);
+
+    mTimerDelegate->CancelTimer(this);
+    for (auto & entry : mEntries)
+    {
+        entry.mState = State::kFree;
+    }
+    mTimerDelegate = nullptr;
+    mDelegate      = nullptr;
+}
+
+CHIP_ERROR SubscriptionResumptionScheduler::Schedule(const SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo,
+                                                     System::Clock::Timeout delay)
+{
+    VerifyOrReturnError(mTimerDelegate != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    ReturnErrorCodeIf(IsScheduled(subscriptionInfo.mSubscriptionId), CHIP_NO_ERROR);
+
+    Entry * freeEntry = nullptr;
+    for (auto & entry : mEntries)
+    {
+        if (entry.mState == State::kFree)
+        {
+            freeEntry = &entry;
+            break;
+        }
+    }
+    VerifyOrReturnError(freeEntry != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    System::Clock::Milliseconds32 jitter(0);
+    if (mMaxJitter.count() > 0)
+    {
+        jitter = System::Clock::Milliseconds32(Crypto::GetRandU32() % mMaxJitter.count());
+    }
+
+    freeEntry->mState          = State::kPending;
+    freeEntry->mFabricIndex    = subscriptionInfo.mFabricIndex;
+    freeEntry->mNodeId         = subscriptionInfo.mNodeId;
+    freeEntry->mSubscriptionId = subscriptionInfo.mSubscriptionId;
+    freeEntry->mMinInterval    = subscriptionInfo.mMinInterval;
+    freeEntry->mMaxInterval    = subscriptionInfo.mMaxInterval;
+    freeEntry->mDueTime        = mTimerDelegate->GetCurrentMonotonicTimestamp() + delay + jitter;
+
+    ArmTimer();
+    return CHIP_NO_ERROR;
+}
+
+void SubscriptionResumptionScheduler::OnResumptionDone(NodeId nodeId, FabricIndex fabricIndex, SubscriptionId subscriptionId)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.mState == State::kInFlight && entry.mNodeId == nodeId && entry.mFabricIndex == fabricIndex &&
+            entry.mSubscriptionId == subscriptionId)
+        {
+            entry.mState = State::kFree;
+            break;
+        }
+    }
+
+    VerifyOrReturn(mTimerDelegate != nullptr && !mStartingResumptions);
+    StartDueResumptions();
+    ArmTimer();
+}
+
+void SubscriptionResumptionScheduler::CancelFabric(FabricIndex fabricIndex)
+{
+    for (auto & entry : mEntries)
+    {
+        if (entry.mState == State::kPending && entry.mFabricIndex == fabricIndex)
+        {
+            entry.mState = State::kFree;
+        }
+    }
+
+    VerifyOrReturn(mTimerDelegate != nullptr);
+    ArmTimer();
+}
+
+bool SubscriptionResumptionScheduler::IsScheduled(SubscriptionId subscriptionId) const
+{
+    for (const auto & entry : mEntries)
+    {
+        if (entry.mState != State::kFree && entry.mSubscriptionId == subscriptionId)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SubscriptionResumptionScheduler::TimerFired()
+{
+    StartDueResumptions();
+    ArmTimer();
+}
+
+size_t SubscriptionResumptionScheduler::Count(State state) const
+{
+    size_t count = 0;
+    for (const auto & entry : mEntries)
+    {
+        if (entry.mState == state)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+size_t SubscriptionResumptionScheduler::InFlightCountForFabric(FabricIndex fabricIndex) const
+{
+    size_t count = 0;
+    for (const auto & entry : mEntries)
+    {
+        if (entry.mState == State::kInFlight && entry.mFabricIndex == fabricIndex)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+SubscriptionResumptionScheduler::Entry * SubscriptionResumptionScheduler::NextDue(Timestamp now)
+{
+    Entry * next          = nullptr;
+    size_t nextFabricLoad = 0;
+    for (auto & entry : mEntries)
+    {
+        if (entry.mState != State::kPending || entry.mDueTime > now)
+        {
+            continue;
+        }
+
+        size_t fabricLoad = InFlightCountForFabric(entry.mFabricIndex);
+        if (next == nullptr || fabricLoad < nextFabricLoad || (fabricLoad == nextFabricLoad && entry.mDueTime < next->mDueTime))
+        {
+            next           = &entry;
+            nextFabricLoad = fabricLoad;
+        }
+    }
+    return next;
+}
+
+void SubscriptionResumptionScheduler::StartDueResumptions()
+{
+    mStartingResumptions = true;
+
+    Timestamp now = mTimerDelegate->GetCurrentMonotonicTimestamp();
+    Entry * entry;
+    while (GetInFlightCount() < kMaxConcurrent && (entry = NextDue(now)) != nullptr)
+    {
+        SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo;
+        subscriptionInfo.mNodeId         = entry->mNodeId;
+        subscriptionInfo.mFabricIndex    = entry->mFabricIndex;
+        subscriptionInfo.mSubscriptionId = entry->mSubscriptionId;
+        subscriptionInfo.mMinInterval    = entry->mMinInterval;
+        subscriptionInfo.mMaxInterval    = entry->mMaxInterval;
+
+        // Mark the entry in flight first, the delegate may report completion before returning
+        entry->mState  = State::kInFlight;
+        CHIP_ERROR err = mDelegate->StartResumption(subscriptionInfo);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(InteractionModel, "Failed to resume subscription 0x%" PRIx32 ": %" CHIP_ERROR_FORMAT,
+                         subscriptionInfo.mSubscriptionId, err.Format());
+            entry->mState = State::kFree;
+        }
+    }
+
+    mStartingResumptions = false;
+}
+
+void SubscriptionResumptionScheduler::ArmTimer()
+{
+    mTimerDelegate->CancelTimer(this);
+
+    // Nothing can start before an in-flight resumption completes, OnResumptionDone() will re-arm the timer
+    VerifyOrReturn(GetInFlightCount() < kMaxConcurrent);
+
+    const Entry * next = nullptr;
+    for (const auto & entry : mEntries)
+    {
+        if (entry.mState == State::kPending && (next == nullptr || entry.mDueTime < next->mDueTime))
+        {
+            next = &entry;
+        }
+    }
+    VerifyOrReturn(next != nullptr);
+
+    Timestamp now = mTimerDelegate->GetCurrentMonotonicTimestamp();
+    System::Clock::Timeout timeout =
+        (next->mDueTime > now) ? std::chrono::duration_cast<System::Clock::Timeout>(next->mDueTime - now) : System::Clock::kZero;
+    CHIP_ERROR err = mTimerDelegate->StartTimer(this, timeout);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(InteractionModel, "Failed to schedule subscription resumption: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
+} // namespace app
+} // namespace chip
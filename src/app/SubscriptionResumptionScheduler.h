@@ -0,0 +1,134 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/SubscriptionResumptionStorage.h>
+#include <app/reporting/ReportScheduler.h>
+#include <lib/core/CHIPConfig.h>
+#include <system/SystemClock.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Spreads the resumption of persisted subscriptions over time.
+ *
+ * Each scheduled subscription becomes due after its own min interval plus a random jitter. Due subscriptions are handed to the
+ * Delegate at most kMaxConcurrent at a time; the others wait until an in-flight resumption completes. When several subscriptions
+ * are due, the one whose fabric has the fewest resumptions in flight goes first, so that a fabric with many subscriptions does
+ * not delay the others, and the earliest due time breaks ties.
+ *
+ * A single timer is armed for the earliest due subscription.
+ */
+class SubscriptionResumptionScheduler : public reporting::TimerContext
+{
+public:
+    using TimerDelegate = reporting::ReportScheduler::TimerDelegate;
+    using Timestamp     = System::Clock::Timestamp;
+
+    static constexpr size_t kMaxConcurrent = CHIP_CONFIG_SUBSCRIPTION_RESUMPTION_MAX_CONCURRENT;
+    static_assert(kMaxConcurrent > 0, "CHIP_CONFIG_SUBSCRIPTION_RESUMPTION_MAX_CONCURRENT must allow at least one resumption");
+
+    class Delegate
+    {
+    public:
+        virtual ~Delegate() = default;
+
+        /**
+         * Start resuming the given subscription. Only the node id, fabric index, subscription id and intervals of the
+         * subscription are set.
+         *
+         * On success, OnResumptionDone() must be called for this subscription once the attempt completes, which may happen
+         * before this returns. On failure the subscription is dropped from the schedule.
+         */
+        virtual CHIP_ERROR StartResumption(const SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo) = 0;
+    };
+
+    CHIP_ERROR Init(TimerDelegate * timerDelegate, Delegate * delegate,
+                    System::Clock::Milliseconds32 maxJitter = System::Clock::Milliseconds32(
+                        CHIP_CONFIG_SUBSCRIPTION_RESUMPTION_MAX_JITTER_MS));
+    void Shutdown();
+
+    /**
+     * Schedule the resumption of a subscription after the given delay, plus jitter. A subscription that is already scheduled
+     * or in flight is left as is.
+     *
+     * @retval CHIP_ERROR_NO_MEMORY if CHIP_IM_MAX_NUM_SUBSCRIPTIONS subscriptions are already scheduled or in flight.
+     */
+    CHIP_ERROR Schedule(const SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo, System::Clock::Timeout delay);
+
+    /**
+     * Schedule the resumption of a subscription after its own min interval, plus jitter.
+     */
+    CHIP_ERROR Schedule(const SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo)
+    {
+        return Schedule(subscriptionInfo, System::Clock::Seconds16(subscriptionInfo.mMinInterval));
+    }
+
+    /**
+     * Notify that the resumption of a subscription started by the Delegate has completed, successfully or not.
+     */
+    void OnResumptionDone(NodeId nodeId, FabricIndex fabricIndex, SubscriptionId subscriptionId);
+
+    /**
+     * Drop the subscriptions of a fabric that are waiting to be resumed. Resumptions in flight are left to complete.
+     */
+    void CancelFabric(FabricIndex fabricIndex);
+
+    bool IsScheduled(SubscriptionId subscriptionId) const;
+    size_t GetPendingCount() const { return Count(State::kPending); }
+    size_t GetInFlightCount() const { return Count(State::kInFlight); }
+
+    // TimerContext
+    void TimerFired() override;
+
+private:
+    enum class State : uint8_t
+    {
+        kFree,
+        kPending,
+        kInFlight,
+    };
+
+    struct Entry
+    {
+        State mState = State::kFree;
+        FabricIndex mFabricIndex;
+        NodeId mNodeId;
+        SubscriptionId mSubscriptionId;
+        uint16_t mMinInterval;
+        uint16_t mMaxInterval;
+        Timestamp mDueTime;
+    };
+
+    size_t Count(State state) const;
+    size_t InFlightCountForFabric(FabricIndex fabricIndex) const;
+    Entry * NextDue(Timestamp now);
+    void StartDueResumptions();
+    void ArmTimer();
+
+    TimerDelegate * mTimerDelegate = nullptr;
+    Delegate * mDelegate           = nullptr;
+    System::Clock::Milliseconds32 mMaxJitter;
+    // Set while resumptions are being started, so that a resumption completing synchronously does not start others re-entrantly
+    bool mStartingResumptions = false;
+    Entry mEntries[CHIP_IM_MAX_NUM_SUBSCRIPTIONS];
+};
+
+} // namespace app
+} // namespace chip
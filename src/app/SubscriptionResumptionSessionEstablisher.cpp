@@ -40,6 +40,13 @@ SubscriptionResumptionSessionEstablisher::SubscriptionResumptionSessionEstablish
     mOnConnectedCallback(HandleDeviceConnected, this), mOnConnectionFailureCallback(HandleDeviceConnectionFailure, this)
 {}
 
+SubscriptionResumptionSessionEstablisher::~SubscriptionResumptionSessionEstablisher()
+{
+    // Whether the session was established or not, this resumption is no longer in flight
+    InteractionModelEngine::GetInstance()->mSubscriptionResumptionScheduler.OnResumptionDone(
+        mSubscriptionInfo.mNodeId, mSubscriptionInfo.mFabricIndex, mSubscriptionInfo.mSubscriptionId);
+}
+
 CHIP_ERROR
 SubscriptionResumptionSessionEstablisher::ResumeSubscription(
     CASESessionManager & caseSessionManager, const SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo)
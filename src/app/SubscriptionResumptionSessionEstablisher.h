@@ -35,6 +35,7 @@ class SubscriptionResumptionSessionEstablisher
 {
 public:
     SubscriptionResumptionSessionEstablisher();
+    ~SubscriptionResumptionSessionEstablisher();
 
     CHIP_ERROR ResumeSubscription(CASESessionManager & caseSessionManager,
                                   const SubscriptionResumptionStorage::SubscriptionInfo & subscriptionInfo);
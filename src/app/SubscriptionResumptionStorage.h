@@ -141,6 +141,45 @@ public:
      */
     virtual SubscriptionInfoIterator * IterateSubscriptions() = 0;
 
+    /**
+     * Iterate through persisted subscriptions when only their node ID, fabric index, subscription ID, intervals and
+     * fabric filtering are needed, e.g. to count them or to find the ones that are not live.
+     *
+     * The paths of the provided SubscriptionInfo may be left empty. Implementations that can provide the other fields
+     * without loading each subscription should override this.
+     *
+     * @return A valid iterator on success. Use CommonIterator accessor to retrieve SubscriptionInfo
+     */
+    virtual SubscriptionInfoIterator * IterateSubscriptionSummaries() { return IterateSubscriptions(); }
+
+    /**
+     * Load a single persisted subscription, including its paths, by node ID, fabric index, and subscription ID.
+     *
+     * Implementations that know where the subscription is stored should override this, the default iterates through all
+     * persisted subscriptions.
+     *
+     * @retval CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND if the subscription is not persisted.
+     */
+    virtual CHIP_ERROR Find(NodeId nodeId, FabricIndex fabricIndex, SubscriptionId subscriptionId,
+                            SubscriptionInfo & subscriptionInfo)
+    {
+        auto * iterator = IterateSubscriptions();
+        VerifyOrReturnError(iterator != nullptr, CHIP_ERROR_NO_MEMORY);
+
+        CHIP_ERROR err = CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND;
+        while (iterator->Next(subscriptionInfo))
+        {
+            if (subscriptionInfo.mNodeId == nodeId && subscriptionInfo.mFabricIndex == fabricIndex &&
+                subscriptionInfo.mSubscriptionId == subscriptionId)
+            {
+                err = CHIP_NO_ERROR;
+                break;
+            }
+        }
+        iterator->Release();
+        return err;
+    }
+
     /**
      * Save subscription resumption information to storage.
      *
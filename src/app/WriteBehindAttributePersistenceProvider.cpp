@@ -0,0 +1,373 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/WriteBehindAttributePersistenceProvider.h>
+
+#include <lib/core/TLV.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/SafeInt.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+// A record is an anonymous array with a structure per attribute.
+constexpr TLV::Tag kAttributeIdTag = TLV::ContextTag(1);
+constexpr TLV::Tag kValueTag       = TLV::ContextTag(2);
+
+constexpr uint32_t kReservedSizeEndOfArray = 1;
+
+static_assert(WriteBehindAttributePersistenceProvider::kRecordSize <= UINT16_MAX, "Records are limited by the storage API");
+
+bool IsSameCluster(const ConcreteAttributePath & aPath, const ConcreteClusterPath & aCluster)
+{
+    return aPath.mEndpointId == aCluster.mEndpointId && aPath.mClusterId == aCluster.mClusterId;
+}
+
+bool IsOutOfWriterSpaceError(CHIP_ERROR err)
+{
+    return err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL;
+}
+
+/**
+ * Position aReader, initialized on a record, on the value of aAttributeId.
+ */
+CHIP_ERROR FindRecordValue(TLV::TLVReader & aReader, AttributeId aAttributeId)
+{
+    TLV::TLVType arrayType;
+    ReturnErrorOnFailure(aReader.Next(TLV::kTLVType_Array, TLV::AnonymousTag()));
+    ReturnErrorOnFailure(aReader.EnterContainer(arrayType));
+
+    CHIP_ERROR err;
+    while ((err = aReader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag())) == CHIP_NO_ERROR)
+    {
+        TLV::TLVType structureType;
+        AttributeId attributeId;
+        ReturnErrorOnFailure(aReader.EnterContainer(structureType));
+        ReturnErrorOnFailure(aReader.Next(kAttributeIdTag));
+        ReturnErrorOnFailure(aReader.Get(attributeId));
+        if (attributeId == aAttributeId)
+        {
+            return aReader.Next(TLV::kTLVType_ByteString, kValueTag);
+        }
+        ReturnErrorOnFailure(aReader.ExitContainer(structureType));
+    }
+
+    return err == CHIP_END_OF_TLV ? CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND : err;
+}
+
+CHIP_ERROR WriteRecordValue(TLV::TLVWriter & aWriter, AttributeId aAttributeId, const ByteSpan & aValue)
+{
+    TLV::TLVType structureType;
+    ReturnErrorOnFailure(aWriter.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, structureType));
+    ReturnErrorOnFailure(aWriter.Put(kAttributeIdTag, aAttributeId));
+    ReturnErrorOnFailure(aWriter.Put(kValueTag, aValue));
+    return aWriter.EndContainer(structureType);
+}
+
+} // namespace
+
+CHIP_ERROR WriteBehindAttributePersistenceProvider::Init(PersistentStorageDelegate * storage, System::Layer * systemLayer)
+{
+    VerifyOrReturnError(systemLayer != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    ReturnErrorOnFailure(DefaultAttributePersistenceProvider::Init(storage));
+    mSystemLayer = systemLayer;
+    return CHIP_NO_ERROR;
+}
+
+void WriteBehindAttributePersistenceProvider::Shutdown()
+{
+    VerifyOrReturn(mSystemLayer != nullptr);
+
+    Flush();
+    mSystemLayer->CancelTimer(OnFlushTimer, this);
+    mSystemLayer = nullptr;
+    mCachedValues.ReleaseAll();
+}
+
+CHIP_ERROR WriteBehindAttributePersistenceProvider::WriteValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue)
+{
+    VerifyOrReturnError(mSystemLayer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(CanCastTo<uint16_t>(aValue.size()), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    CachedValue * cached = FindCachedValue(aPath);
+    if (cached == nullptr)
+    {
+        cached = mCachedValues.CreateObject(aPath);
+    }
+    if (cached == nullptr)
+    {
+        // The cache is full, make room by writing it to storage.
+        CHIP_ERROR err = Flush();
+        cached         = mCachedValues.CreateObject(aPath);
+        VerifyOrReturnError(cached != nullptr, err == CHIP_NO_ERROR ? CHIP_ERROR_NO_MEMORY : err);
+    }
+
+    if (cached->mValue.AllocatedSize() != aValue.size())
+    {
+        // Keep the previous value if the new one cannot be cached.
+        Platform::ScopedMemoryBufferWithSize<uint8_t> value;
+        value.Alloc(aValue.size());
+        if (!value)
+        {
+            if (!cached->mValue)
+            {
+                mCachedValues.ReleaseObject(cached);
+            }
+            return CHIP_ERROR_NO_MEMORY;
+        }
+        cached->mValue = std::move(value);
+    }
+
+    memcpy(cached->mValue.Get(), aValue.data(), aValue.size());
+    ScheduleFlush();
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR WriteBehindAttributePersistenceProvider::ReadValue(const ConcreteAttributePath & aPath,
+                                                              const EmberAfAttributeMetadata * aMetadata, MutableByteSpan & aValue)
+{
+    CachedValue * cached = FindCachedValue(aPath);
+    if (cached != nullptr)
+    {
+        return CopySpanToMutableSpan(cached->GetValue(), aValue);
+    }
+
+    CHIP_ERROR err = ReadRecordValue(aPath, aValue);
+    if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+    {
+        // Not stored in the record of its cluster, either because it is too large or because it was stored before records were
+        // used.
+        return DefaultAttributePersistenceProvider::ReadValue(aPath, aMetadata, aValue);
+    }
+    ReturnErrorOnFailure(err);
+    return CheckReadValue(aMetadata->attributeType, aMetadata->size, aValue);
+}
+
+CHIP_ERROR WriteBehindAttributePersistenceProvider::Flush()
+{
+    VerifyOrReturnError(mSystemLayer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    CHIP_ERROR result = CHIP_NO_ERROR;
+
+    // Each pass of FlushCluster() handles all the cached values of one cluster, whether it succeeds or not.
+    mFlushPass++;
+    while (true)
+    {
+        CachedValue * next = nullptr;
+        mCachedValues.ForEachActiveObject([&](CachedValue * cached) {
+            if (cached->mFlushPass != mFlushPass)
+            {
+                next = cached;
+                return Loop::Break;
+            }
+            return Loop::Continue;
+        });
+        if (next == nullptr)
+        {
+            break;
+        }
+
+        const ConcreteClusterPath cluster(next->mPath.mEndpointId, next->mPath.mClusterId);
+        CHIP_ERROR err = FlushCluster(cluster);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(Zcl, "Failed to store attributes of cluster " ChipLogFormatMEI " on endpoint %u: %" CHIP_ERROR_FORMAT,
+                         ChipLogValueMEI(cluster.mClusterId), cluster.mEndpointId, err.Format());
+            result = err;
+        }
+    }
+
+    // Values that could not be stored are tried again later.
+    mSystemLayer->CancelTimer(OnFlushTimer, this);
+    if (mCachedValues.Allocated() > 0)
+    {
+        ScheduleFlush();
+    }
+    return result;
+}
+
+CHIP_ERROR WriteBehindAttributePersistenceProvider::FlushCluster(const ConcreteClusterPath & aCluster)
+{
+    mCachedValues.ForEachActiveObject([&](CachedValue * cached) {
+        if (IsSameCluster(cached->mPath, aCluster))
+        {
+            cached->mFlushPass = mFlushPass;
+        }
+        return Loop::Continue;
+    });
+
+    Platform::ScopedMemoryBuffer<uint8_t> stored;
+    Platform::ScopedMemoryBuffer<uint8_t> record;
+    VerifyOrReturnError(stored.Alloc(kRecordSize) && record.Alloc(kRecordSize), CHIP_ERROR_NO_MEMORY);
+
+    const StorageKeyName key = DefaultStorageKeyAllocator::ClusterAttributeValues(aCluster.mEndpointId, aCluster.mClusterId);
+    uint16_t storedSize      = static_cast<uint16_t>(kRecordSize);
+    CHIP_ERROR err           = mStorage->SyncGetKeyValue(key.KeyName(), stored.Get(), storedSize);
+    if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+    {
+        storedSize = 0;
+        err        = CHIP_NO_ERROR;
+    }
+    ReturnErrorOnFailure(err);
+
+    TLV::TLVWriter writer;
+    TLV::TLVType arrayType;
+    writer.Init(record.Get(), kRecordSize);
+    ReturnErrorOnFailure(writer.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Array, arrayType));
+    ReturnErrorOnFailure(writer.ReserveBuffer(kReservedSizeEndOfArray));
+
+    // The cached values replace the stored ones.  The ones that do not fit go under their own key, like
+    // DefaultAttributePersistenceProvider stores them.
+    mCachedValues.ForEachActiveObject([&](CachedValue * cached) {
+        if (IsSameCluster(cached->mPath, aCluster))
+        {
+            TLV::TLVWriter checkpoint = writer;
+            CHIP_ERROR writeErr       = WriteRecordValue(writer, cached->mPath.mAttributeId, cached->GetValue());
+            if (IsOutOfWriterSpaceError(writeErr))
+            {
+                writer = checkpoint;
+            }
+            else if (writeErr != CHIP_NO_ERROR)
+            {
+                err = writeErr;
+                return Loop::Break;
+            }
+        }
+        return Loop::Continue;
+    });
+    ReturnErrorOnFailure(err);
+
+    if (storedSize > 0)
+    {
+        TLV::TLVReader reader;
+        TLV::TLVType storedArrayType;
+        reader.Init(stored.Get(), storedSize);
+        ReturnErrorOnFailure(reader.Next(TLV::kTLVType_Array, TLV::AnonymousTag()));
+        ReturnErrorOnFailure(reader.EnterContainer(storedArrayType));
+        while ((err = reader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag())) == CHIP_NO_ERROR)
+        {
+            TLV::TLVReader entry = reader;
+            TLV::TLVType structureType;
+            AttributeId attributeId;
+            ReturnErrorOnFailure(entry.EnterContainer(structureType));
+            ReturnErrorOnFailure(entry.Next(kAttributeIdTag));
+            ReturnErrorOnFailure(entry.Get(attributeId));
+            if (FindCachedValue(ConcreteAttributePath(aCluster.mEndpointId, aCluster.mClusterId, attributeId)) == nullptr)
+            {
+                // The stored values fit in a record already, unless kRecordSize was reduced.
+                ReturnErrorOnFailure(writer.CopyElement(reader));
+            }
+        }
+        VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+    }
+
+    ReturnErrorOnFailure(writer.UnreserveBuffer(kReservedSizeEndOfArray));
+    ReturnErrorOnFailure(writer.EndContainer(arrayType));
+    ReturnErrorOnFailure(writer.Finalize());
+    ReturnErrorOnFailure(mStorage->SyncSetKeyValue(key.KeyName(), record.Get(), static_cast<uint16_t>(writer.GetLengthWritten())));
+
+    // The record is stored, release the values it holds.  The keys of values that were stored on their own before the record
+    // held them are removed; values that were already in the stored record have no such key.
+    CHIP_ERROR result = CHIP_NO_ERROR;
+    mCachedValues.ForEachActiveObject([&](CachedValue * cached) {
+        VerifyOrReturnValue(IsSameCluster(cached->mPath, aCluster), Loop::Continue);
+
+        const ConcreteAttributePath & path = cached->mPath;
+        TLV::TLVReader recordReader;
+        recordReader.Init(record.Get(), writer.GetLengthWritten());
+        if (FindRecordValue(recordReader, path.mAttributeId) != CHIP_NO_ERROR)
+        {
+            // Did not fit in the record.
+            CHIP_ERROR writeErr = DefaultAttributePersistenceProvider::WriteValue(path, cached->GetValue());
+            if (writeErr != CHIP_NO_ERROR)
+            {
+                result = writeErr;
+                return Loop::Continue;
+            }
+        }
+        else
+        {
+            TLV::TLVReader storedReader;
+            storedReader.Init(stored.Get(), storedSize);
+            if (FindRecordValue(storedReader, path.mAttributeId) != CHIP_NO_ERROR)
+            {
+                mStorage->SyncDeleteKeyValue(
+                    DefaultStorageKeyAllocator::AttributeValue(path.mEndpointId, path.mClusterId, path.mAttributeId).KeyName());
+            }
+        }
+        mCachedValues.ReleaseObject(cached);
+        return Loop::Continue;
+    });
+    return result;
+}
+
+CHIP_ERROR WriteBehindAttributePersistenceProvider::ReadRecordValue(const ConcreteAttributePath & aPath, MutableByteSpan & aValue)
+{
+    VerifyOrReturnError(mStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    Platform::ScopedMemoryBuffer<uint8_t> record;
+    VerifyOrReturnError(record.Alloc(kRecordSize), CHIP_ERROR_NO_MEMORY);
+
+    const StorageKeyName key = DefaultStorageKeyAllocator::ClusterAttributeValues(aPath.mEndpointId, aPath.mClusterId);
+    uint16_t size            = static_cast<uint16_t>(kRecordSize);
+    ReturnErrorOnFailure(mStorage->SyncGetKeyValue(key.KeyName(), record.Get(), size));
+
+    TLV::TLVReader reader;
+    reader.Init(record.Get(), size);
+    ReturnErrorOnFailure(FindRecordValue(reader, aPath.mAttributeId));
+    const uint32_t length = reader.GetLength();
+    ReturnErrorOnFailure(reader.GetBytes(aValue.data(), aValue.size()));
+    aValue.reduce_size(length);
+    return CHIP_NO_ERROR;
+}
+
+WriteBehindAttributePersistenceProvider::CachedValue *
+WriteBehindAttributePersistenceProvider::FindCachedValue(const ConcreteAttributePath & aPath)
+{
+    CachedValue * found = nullptr;
+    mCachedValues.ForEachActiveObject([&](CachedValue * cached) {
+        if (cached->mPath == aPath)
+        {
+            found = cached;
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    });
+    return found;
+}
+
+void WriteBehindAttributePersistenceProvider::ScheduleFlush()
+{
+    // The interval runs from the first change after a flush, so that values changing all the time still get stored.
+    VerifyOrReturn(!mSystemLayer->IsTimerActive(OnFlushTimer, this));
+    CHIP_ERROR err = mSystemLayer->StartTimer(kFlushInterval, OnFlushTimer, this);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Zcl, "Failed to schedule storing attributes: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
+void WriteBehindAttributePersistenceProvider::OnFlushTimer(System::Layer * aLayer, void * aAppState)
+{
+    static_cast<WriteBehindAttributePersistenceProvider *>(aAppState)->Flush();
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,102 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <app/ConcreteClusterPath.h>
+#include <app/DefaultAttributePersistenceProvider.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/support/Pool.h>
+#include <lib/support/ScopedBuffer.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * AttributePersistenceProvider that caches the written attribute values and
+ * writes them to storage later, batched per cluster.
+ *
+ * The values of all the persisted attributes of a cluster instance are stored
+ * in a single record, so a flush costs one storage write per changed cluster
+ * rather than one per change of each attribute.  Changed values are flushed
+ * CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_INTERVAL_MS after the first change that
+ * follows a flush, when the cache is full, and by Flush() and Shutdown().
+ * Reads return the last written value, whether it has been flushed or not.
+ *
+ * Values that were stored by DefaultAttributePersistenceProvider under their
+ * own key are still read, and their keys are removed once the values are
+ * stored in the record of their cluster.  Values too large for the record
+ * keep being stored under their own key.
+ *
+ * SafeAttributePersistenceProvider writes are not cached.
+ */
+class WriteBehindAttributePersistenceProvider : public DefaultAttributePersistenceProvider
+{
+public:
+    static constexpr System::Clock::Milliseconds32 kFlushInterval{ CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_INTERVAL_MS };
+    static constexpr size_t kCacheSize  = CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_CACHE_SIZE;
+    static constexpr size_t kRecordSize = CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_RECORD_SIZE;
+
+    WriteBehindAttributePersistenceProvider() {}
+    // Values that were not flushed by Shutdown() are lost.
+    ~WriteBehindAttributePersistenceProvider() override { mCachedValues.ReleaseAll(); }
+
+    // Passed-in storage and system layer must outlive this object.
+    CHIP_ERROR Init(PersistentStorageDelegate * storage, System::Layer * systemLayer);
+
+    /**
+     * Flush the cached values, then stop caching.
+     */
+    void Shutdown();
+
+    /**
+     * Write all the cached values to storage, e.g. when the device is about to
+     * reboot or when the fail-safe is committed.  Values that could not be
+     * written stay cached and are tried again on the next flush.
+     */
+    CHIP_ERROR Flush();
+
+    // AttributePersistenceProvider implementation.
+    CHIP_ERROR WriteValue(const ConcreteAttributePath & aPath, const ByteSpan & aValue) override;
+    CHIP_ERROR ReadValue(const ConcreteAttributePath & aPath, const EmberAfAttributeMetadata * aMetadata,
+                         MutableByteSpan & aValue) override;
+
+private:
+    struct CachedValue
+    {
+        explicit CachedValue(const ConcreteAttributePath & path) : mPath(path) {}
+
+        ByteSpan GetValue() const { return ByteSpan(mValue.Get(), mValue.AllocatedSize()); }
+
+        const ConcreteAttributePath mPath;
+        Platform::ScopedMemoryBufferWithSize<uint8_t> mValue;
+        // The flush pass that last handled this value.
+        uint32_t mFlushPass = 0;
+    };
+
+    CachedValue * FindCachedValue(const ConcreteAttributePath & aPath);
+    CHIP_ERROR FlushCluster(const ConcreteClusterPath & aCluster);
+    CHIP_ERROR ReadRecordValue(const ConcreteAttributePath & aPath, MutableByteSpan & aValue);
+    void ScheduleFlush();
+    static void OnFlushTimer(System::Layer * aLayer, void * aAppState);
+
+    System::Layer * mSystemLayer = nullptr;
+    ObjectPool<CachedValue, kCacheSize> mCachedValues;
+    uint32_t mFlushPass = 0;
+};
+
+} // namespace app
+} // namespace chip
@@ -122,6 +122,7 @@ function(chip_configure_data_model APP_TARGET)
         GENERATOR "app-templates"
         OUTPUTS
         "zap-generated/access.h"
+        "zap-generated/attribute_access_tables.h"
         "zap-generated/CHIPClusters.h"
         "zap-generated/endpoint_config.h"
         "zap-generated/gen_config.h"
@@ -0,0 +1,159 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/AttributeChangeCoalescer.h>
+
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+uint32_t AttributeChangeCoalescer::ClusterStatistics::ChangesPerSecond() const
+{
+    uint64_t elapsedMs = (lastChange - firstChange).count();
+    if (changes < 2 || elapsedMs == 0)
+    {
+        return 0;
+    }
+    uint64_t rate = (static_cast<uint64_t>(changes - 1) * 1000) / elapsedMs;
+    return static_cast<uint32_t>(rate > UINT32_MAX ? UINT32_MAX : rate);
+}
+
+BitFlags<AttributeChangeCoalescer::Action> AttributeChangeCoalescer::OnAttributeChanged(const ConcreteAttributePath & aPath)
+{
+    BitFlags<Action> actions(Action::kIncreaseDataVersion, Action::kSetDirty);
+
+    Entry * entry = FindOrAllocate(aPath);
+    VerifyOrReturnValue(entry != nullptr, actions);
+
+    if (aPath.mAttributeId < kMaxCoalescedAttributeId)
+    {
+        uint64_t bit = static_cast<uint64_t>(1) << aPath.mAttributeId;
+        if (entry->mPendingDirty & bit)
+        {
+            actions.Clear(Action::kSetDirty);
+        }
+        entry->mPendingDirty |= bit;
+    }
+
+    if (entry->mDataVersionUnobserved)
+    {
+        actions.Clear(Action::kIncreaseDataVersion);
+    }
+    else
+    {
+        entry->mDataVersionUnobserved = true;
+        mUnobservedDataVersions++;
+    }
+
+    System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    ClusterStatistics & stats    = entry->mStatistics;
+    if (stats.changes == 0)
+    {
+        stats.firstChange = now;
+    }
+    stats.lastChange = now;
+    stats.changes++;
+    stats.dirtyMarks += actions.Has(Action::kSetDirty) ? 1 : 0;
+    stats.dataVersionIncreases += actions.Has(Action::kIncreaseDataVersion) ? 1 : 0;
+
+    return actions;
+}
+
+void AttributeChangeCoalescer::OnReportRun()
+{
+    for (size_t i = 0; i < mCapacity; i++)
+    {
+        mEntries[i].mPendingDirty = 0;
+    }
+}
+
+void AttributeChangeCoalescer::Reset()
+{
+    for (size_t i = 0; i < mCapacity; i++)
+    {
+        mEntries[i] = Entry();
+    }
+    mUnobservedDataVersions = 0;
+}
+
+bool AttributeChangeCoalescer::GetStatistics(const ConcreteClusterPath & aPath, ClusterStatistics & aStatistics) const
+{
+    for (size_t i = 0; i < mCapacity; i++)
+    {
+        if (mEntries[i].Matches(aPath))
+        {
+            aStatistics = mEntries[i].mStatistics;
+            return true;
+        }
+    }
+    return false;
+}
+
+AttributeChangeCoalescer::Entry * AttributeChangeCoalescer::FindOrAllocate(const ConcreteClusterPath & aPath)
+{
+    Entry * candidate = nullptr;
+    for (size_t i = 0; i < mCapacity; i++)
+    {
+        Entry & entry = mEntries[i];
+        if (entry.Matches(aPath))
+        {
+            return &entry;
+        }
+
+        // Prefer free entries, then the least recently changed cluster.  Evicting an entry only means that the next
+        // change of that cluster does the work again.
+        if (candidate == nullptr || (candidate->mEndpointId != kInvalidEndpointId &&
+                                     (entry.mEndpointId == kInvalidEndpointId ||
+                                      entry.mStatistics.lastChange < candidate->mStatistics.lastChange)))
+        {
+            candidate = &entry;
+        }
+    }
+
+    VerifyOrReturnValue(candidate != nullptr && aPath.mEndpointId != kInvalidEndpointId, nullptr);
+    if (candidate->mDataVersionUnobserved)
+    {
+        mUnobservedDataVersions--;
+    }
+    *candidate             = Entry();
+    candidate->mEndpointId = aPath.mEndpointId;
+    candidate->mClusterId  = aPath.mClusterId;
+    return candidate;
+}
+
+void AttributeChangeCoalescer::MarkDataVersionObserved(const ConcreteClusterPath & aPath)
+{
+    for (size_t i = 0; i < mCapacity; i++)
+    {
+        if (mEntries[i].Matches(aPath))
+        {
+            if (mEntries[i].mDataVersionUnobserved)
+            {
+                mEntries[i].mDataVersionUnobserved = false;
+                mUnobservedDataVersions--;
+            }
+            return;
+        }
+    }
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -0,0 +1,167 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <lib/support/BitFlags.h>
+#include <system/SystemClock.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/*
+ *  @class AttributeChangeCoalescer
+ *
+ *  @brief Filters the work done for repeated changes of the same attributes, e.g. a sensor updating a measured
+ *  value far more often than any subscriber's minimum interval.
+ *
+ *  Two kinds of work are skipped:
+ *
+ *  - Marking a path dirty again before the reporting engine has run since it was last marked dirty.  No ReadHandler
+ *    can have consumed the first mark in between, so the second one would not change what gets reported.
+ *  - Increasing a cluster data version that nobody has read since it was last increased.  Nobody can hold the
+ *    current version with older data, so a single increase covers any number of changes.
+ *
+ *  Pending dirty marks are tracked in a per-cluster bitmap indexed by attribute id, for attribute ids below
+ *  kMaxCoalescedAttributeId; other attributes are always marked dirty.  A bounded number of clusters is tracked,
+ *  the least recently changed one being forgotten to make room for another.  The entries are provided by the
+ *  derived FixedAttributeChangeCoalescer; with none, every change does all the work.
+ *
+ *  The coalescer also counts changes per tracked cluster so that applications can find attributes that change at
+ *  high rates.
+ */
+class AttributeChangeCoalescer
+{
+public:
+    AttributeChangeCoalescer(const AttributeChangeCoalescer &)             = delete;
+    AttributeChangeCoalescer & operator=(const AttributeChangeCoalescer &) = delete;
+
+    enum class Action : uint8_t
+    {
+        kIncreaseDataVersion = 0x01, ///< The cluster data version must be increased.
+        kSetDirty            = 0x02, ///< The attribute path must be marked dirty in the reporting engine.
+    };
+
+    struct ClusterStatistics
+    {
+        uint32_t changes              = 0; ///< Attribute changes reported for the cluster.
+        uint32_t dirtyMarks           = 0; ///< Changes that marked a path dirty.
+        uint32_t dataVersionIncreases = 0; ///< Changes that increased the cluster data version.
+        System::Clock::Timestamp firstChange;
+        System::Clock::Timestamp lastChange;
+
+        /**
+         * Average number of changes per second between the first and the last change, 0 if that can't be told yet.
+         */
+        uint32_t ChangesPerSecond() const;
+    };
+
+    static constexpr AttributeId kMaxCoalescedAttributeId = 64;
+
+    /**
+     * Records a change of aPath and returns the work that still needs to be done for it.
+     */
+    BitFlags<Action> OnAttributeChanged(const ConcreteAttributePath & aPath);
+
+    /**
+     * Must be called whenever the data version of aPath is read or compared, so that the next change increases it.
+     */
+    void OnDataVersionRead(const ConcreteClusterPath & aPath)
+    {
+        if (mUnobservedDataVersions > 0)
+        {
+            MarkDataVersionObserved(aPath);
+        }
+    }
+
+    /**
+     * Must be called when the reporting engine runs, so that the next change of any path marks it dirty.
+     */
+    void OnReportRun();
+
+    void Reset();
+
+    /**
+     * Returns false if the cluster is not tracked.
+     */
+    bool GetStatistics(const ConcreteClusterPath & aPath, ClusterStatistics & aStatistics) const;
+
+    /**
+     * Calls aFunction(const ConcreteClusterPath &, const ClusterStatistics &) for every tracked cluster.
+     */
+    template <typename Function>
+    void ForEachCluster(Function && aFunction) const
+    {
+        for (size_t i = 0; i < mCapacity; i++)
+        {
+            if (mEntries[i].mEndpointId != kInvalidEndpointId)
+            {
+                aFunction(ConcreteClusterPath(mEntries[i].mEndpointId, mEntries[i].mClusterId), mEntries[i].mStatistics);
+            }
+        }
+    }
+
+protected:
+    struct Entry
+    {
+        EndpointId mEndpointId = kInvalidEndpointId;
+        ClusterId mClusterId   = kInvalidClusterId;
+        // Bit n is set if attribute n was marked dirty since the last report run.
+        uint64_t mPendingDirty = 0;
+        // Set if the data version was increased and not read since.
+        bool mDataVersionUnobserved = false;
+        ClusterStatistics mStatistics;
+
+        bool Matches(const ConcreteClusterPath & aPath) const
+        {
+            return mEndpointId == aPath.mEndpointId && mClusterId == aPath.mClusterId;
+        }
+    };
+
+    AttributeChangeCoalescer(Entry * aEntries, size_t aCapacity) : mEntries(aEntries), mCapacity(aCapacity) {}
+
+private:
+    static_assert(kMaxCoalescedAttributeId <= 64, "Pending dirty bitmap is 64 bits wide");
+
+    Entry * FindOrAllocate(const ConcreteClusterPath & aPath);
+    void MarkDataVersionObserved(const ConcreteClusterPath & aPath);
+
+    Entry * const mEntries;
+    const size_t mCapacity;
+    // Number of entries with mDataVersionUnobserved set, lets OnDataVersionRead return early.
+    size_t mUnobservedDataVersions = 0;
+};
+
+/**
+ * An AttributeChangeCoalescer tracking up to kMaxClusters clusters.  kMaxClusters may be 0, which disables coalescing.
+ */
+template <size_t kMaxClusters>
+class FixedAttributeChangeCoalescer : public AttributeChangeCoalescer
+{
+public:
+    FixedAttributeChangeCoalescer() : AttributeChangeCoalescer(mStorage, kMaxClusters) {}
+
+private:
+    Entry mStorage[kMaxClusters > 0 ? kMaxClusters : 1];
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -0,0 +1,127 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/EncodedListBuffer.h>
+
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+namespace {
+
+constexpr uint32_t kReservedSizeEndOfArray = 1;
+
+bool IsOutOfWriterSpaceError(CHIP_ERROR err)
+{
+    return err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL;
+}
+
+} // namespace
+
+CHIP_ERROR EncodedListBuffer::StartFill(const ConcreteAttributePath & aPath, TLV::TLVWriter & aWriter,
+                                        AttributeReportIBs::Builder & aBuilder)
+{
+    Clear();
+
+    if (mBuffer.Get() == nullptr)
+    {
+        VerifyOrReturnError(mBuffer.Alloc(kBufferSize), CHIP_ERROR_NO_MEMORY);
+    }
+
+    aWriter.Init(mBuffer.Get(), kBufferSize);
+    ReturnErrorOnFailure(aBuilder.Init(&aWriter));
+    ReturnErrorOnFailure(aWriter.ReserveBuffer(kReservedSizeEndOfArray));
+    mPath = aPath;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EncodedListBuffer::FinishFill(TLV::TLVWriter & aWriter, AttributeReportIBs::Builder & aBuilder,
+                                         CHIP_ERROR aEncodeError, const AttributeEncodeState & aState)
+{
+    if (aEncodeError == CHIP_NO_ERROR)
+    {
+        mComplete = true;
+    }
+    else if (IsOutOfWriterSpaceError(aEncodeError) && aState.AllowPartialData())
+    {
+        // The encoder rolled back the item that did not fit, the builder holds whole AttributeReportIBs only.
+        mComplete        = false;
+        mNextEncodeState = aState;
+    }
+    else
+    {
+        return aEncodeError;
+    }
+
+    ReturnErrorOnFailure(aWriter.UnreserveBuffer(kReservedSizeEndOfArray));
+    ReturnErrorOnFailure(aBuilder.EndOfAttributeReportIBs());
+    ReturnErrorOnFailure(aWriter.Finalize());
+
+    TLV::TLVType arrayType;
+    mReader.Init(mBuffer.Get(), aWriter.GetLengthWritten());
+    ReturnErrorOnFailure(mReader.Next(TLV::kTLVType_Array, TLV::AnonymousTag()));
+    ReturnErrorOnFailure(mReader.EnterContainer(arrayType));
+
+    TLV::TLVReader first = mReader;
+    CHIP_ERROR err       = first.Next();
+    VerifyOrReturnError(err != CHIP_END_OF_TLV, CHIP_ERROR_BUFFER_TOO_SMALL);
+    ReturnErrorOnFailure(err);
+
+    mHoldsItems = true;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR EncodedListBuffer::Drain(AttributeReportIBs::Builder & aBuilder)
+{
+    VerifyOrReturnError(mHoldsItems, CHIP_ERROR_INCORRECT_STATE);
+
+    while (true)
+    {
+        TLV::TLVReader next = mReader;
+        CHIP_ERROR err      = next.Next();
+        if (err == CHIP_END_OF_TLV)
+        {
+            mHoldsItems = false;
+            return CHIP_NO_ERROR;
+        }
+        ReturnErrorOnFailure(err);
+
+        TLV::TLVWriter backup;
+        aBuilder.Checkpoint(backup);
+        err = aBuilder.GetWriter()->CopyContainer(next);
+        if (err != CHIP_NO_ERROR)
+        {
+            aBuilder.Rollback(backup);
+            return err;
+        }
+        mReader = next;
+    }
+}
+
+void EncodedListBuffer::Clear()
+{
+    mHoldsItems      = false;
+    mComplete        = false;
+    mNextEncodeState = AttributeEncodeState();
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -0,0 +1,117 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/AttributeAccessInterface.h>
+#include <app/ConcreteAttributePath.h>
+#include <app/MessageDef/AttributeReportIBs.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/TLVReader.h>
+#include <lib/core/TLVWriter.h>
+#include <lib/support/ScopedBuffer.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/*
+ *  @class EncodedListBuffer
+ *
+ *  @brief Holds the already encoded items of a list attribute that is being chunked across several reports.
+ *
+ *  Without it, each chunk of a long list reads the whole attribute again and the encoder skips the items that were
+ *  already sent, so reporting a list of N items over K chunks visits about N * K / 2 items.  Instead, once a chunk is
+ *  full, Fill() encodes the rest of the list, as AttributeReportIBs appending one item each, into a scratch buffer of
+ *  CHIP_IM_SERVER_ENCODED_LIST_BUFFER_SIZE bytes.  The following chunks Drain() whole AttributeReportIBs from that
+ *  buffer without reading the attribute.
+ *
+ *  The buffer is a window, not a snapshot: when the list does not fit in it, the encode state after the last buffered
+ *  item is kept, and the reporting engine reads the attribute again from there once the buffer is drained.
+ */
+class EncodedListBuffer
+{
+public:
+    using AttributeEncodeState = AttributeValueEncoder::AttributeEncodeState;
+
+    static constexpr size_t kBufferSize = CHIP_IM_SERVER_ENCODED_LIST_BUFFER_SIZE;
+
+    /**
+     * Encode the items of the list at aPath that follow aState into the buffer, replacing its contents.
+     *
+     * aEncode is called as aEncode(AttributeReportIBs::Builder &, AttributeEncodeState &) to encode the attribute into the
+     * given builder starting from, and updating, the given state, like ReadSingleClusterData does.
+     *
+     * @retval CHIP_ERROR_NO_MEMORY if the buffer could not be allocated.
+     * @retval CHIP_ERROR_BUFFER_TOO_SMALL if not even one item fits in the buffer.
+     * @retval other errors returned by aEncode, other than running out of space.
+     *
+     * On failure the buffer holds nothing.
+     */
+    template <typename EncodeFunction>
+    CHIP_ERROR Fill(const ConcreteAttributePath & aPath, const AttributeEncodeState & aState, EncodeFunction && aEncode)
+    {
+        TLV::TLVWriter writer;
+        AttributeReportIBs::Builder builder;
+        ReturnErrorOnFailure(StartFill(aPath, writer, builder));
+
+        AttributeEncodeState state = aState;
+        CHIP_ERROR err             = aEncode(builder, state);
+        return FinishFill(writer, builder, err, state);
+    }
+
+    /**
+     * Copy the buffered AttributeReportIBs into aBuilder, as many as fit.  Each AttributeReportIB is either copied whole or
+     * not at all.
+     *
+     * @retval CHIP_NO_ERROR if the buffer was drained.
+     * @retval CHIP_ERROR_NO_MEMORY or CHIP_ERROR_BUFFER_TOO_SMALL if aBuilder is full; the remaining items stay buffered.
+     */
+    CHIP_ERROR Drain(AttributeReportIBs::Builder & aBuilder);
+
+    /**
+     * Whether the buffer holds items of the list at aPath.
+     */
+    bool Holds(const ConcreteAttributePath & aPath) const { return mHoldsItems && mPath == aPath; }
+
+    /**
+     * Whether the buffered items run to the end of the list.  Once a buffer that is not complete is drained, encoding
+     * continues from GetNextEncodeState().
+     */
+    bool IsComplete() const { return mComplete; }
+    const AttributeEncodeState & GetNextEncodeState() const { return mNextEncodeState; }
+
+    void Clear();
+
+private:
+    CHIP_ERROR StartFill(const ConcreteAttributePath & aPath, TLV::TLVWriter & aWriter, AttributeReportIBs::Builder & aBuilder);
+    CHIP_ERROR FinishFill(TLV::TLVWriter & aWriter, AttributeReportIBs::Builder & aBuilder, CHIP_ERROR aEncodeError,
+                          const AttributeEncodeState & aState);
+
+    Platform::ScopedMemoryBuffer<uint8_t> mBuffer;
+    // Positioned before the next AttributeReportIB to copy, inside the anonymous array written by Fill().
+    TLV::TLVReader mReader;
+    ConcreteAttributePath mPath;
+    AttributeEncodeState mNextEncodeState;
+    bool mHoldsItems = false;
+    bool mComplete   = false;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
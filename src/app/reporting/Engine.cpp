@@ -49,6 +49,7 @@ void Engine::Shutdown()
     mNumReportsInFlight = 0;
     mCurReadHandlerIdx  = 0;
     mGlobalDirtySet.ReleaseAll();
+    mAttributeChangeCoalescer.Reset();
 }
 
 bool Engine::IsClusterDataVersionMatch(const ObjectList<DataVersionFilter> * aDataVersionFilterList,
@@ -71,6 +72,20 @@ bool Engine::IsClusterDataVersionMatch(const ObjectList<DataVersionFilter> * aDa
     return existPathMatch && !existVersionMismatch;
 }
 
+bool Engine::HasDirtyPathSince(const AttributePathParams & aPath, uint64_t aGeneration)
+{
+    bool dirty = false;
+    mGlobalDirtySet.ForEachActiveObject([&](auto * dirtyPath) {
+        if (dirtyPath->mGeneration > aGeneration && dirtyPath->Intersects(aPath))
+        {
+            dirty = true;
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    });
+    return dirty;
+}
+
 CHIP_ERROR
 Engine::RetrieveClusterData(const SubjectDescriptor & aSubjectDescriptor, bool aIsFabricFiltered,
                             AttributeReportIBs::Builder & aAttributeReportIBs, const ConcreteReadAttributePath & aPath,
@@ -130,15 +145,53 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
         {
             apReadHandler->ResetPathIterator();
         }
+        AttributePathExpandIterator * pathIterator = apReadHandler->GetAttributePathExpandIterator();
+        VerifyOrExit(pathIterator != nullptr, err = CHIP_ERROR_NO_MEMORY);
 
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
         uint32_t attributesRead = 0;
 #endif
 
+        // The data version filters and the dirty set are checked once per cluster rather than once per attribute, and the
+        // clusters and endpoints with nothing to report are skipped without walking the metadata of their attributes.
+        ConcreteClusterPath currentCluster(kInvalidEndpointId, kInvalidClusterId);
+        bool skipCurrentCluster = false;
+
         // For each path included in the interested path of the read handler...
-        for (; apReadHandler->GetAttributePathExpandIterator()->Get(readPath);
-             apReadHandler->GetAttributePathExpandIterator()->Next())
+        for (; pathIterator->Get(readPath); pathIterator->Next())
         {
+            if (currentCluster != ConcreteClusterPath(readPath.mEndpointId, readPath.mClusterId))
+            {
+                const bool newEndpoint = (currentCluster.mEndpointId != readPath.mEndpointId);
+                currentCluster         = ConcreteClusterPath(readPath.mEndpointId, readPath.mClusterId);
+
+                if (apReadHandler->IsPriming())
+                {
+                    skipCurrentCluster = IsClusterDataVersionMatch(apReadHandler->GetDataVersionFilterList(), readPath);
+                }
+                else
+                {
+                    // Paths marked dirty before the last report this read handler completed have already been reported.
+                    AttributePathParams dirtyPath(readPath.mEndpointId, readPath.mClusterId);
+                    skipCurrentCluster = !HasDirtyPathSince(dirtyPath, apReadHandler->mPreviousReportsBeginGeneration);
+                    if (skipCurrentCluster && newEndpoint)
+                    {
+                        dirtyPath.SetWildcardClusterId();
+                        if (!HasDirtyPathSince(dirtyPath, apReadHandler->mPreviousReportsBeginGeneration))
+                        {
+                            pathIterator->SkipCurrentEndpoint();
+                            continue;
+                        }
+                    }
+                }
+            }
+
+            if (skipCurrentCluster)
+            {
+                pathIterator->SkipCurrentCluster();
+                continue;
+            }
+
             if (!apReadHandler->IsPriming())
             {
                 bool concretePathDirty = false;
@@ -163,13 +216,6 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
                     continue;
                 }
             }
-            else
-            {
-                if (IsClusterDataVersionMatch(apReadHandler->GetDataVersionFilterList(), readPath))
-                {
-                    continue;
-                }
-            }
 
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
             attributesRead++;
@@ -179,6 +225,19 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
             }
 #endif
 
+#if CHIP_IM_SERVER_ENCODED_LIST_BUFFER_SIZE > 0
+            // The next items of a chunked list may already be encoded, copy them instead of reading the list again.
+            if (apReadHandler->mpEncodedListBuffer && apReadHandler->mpEncodedListBuffer->Holds(readPath))
+            {
+                bool listDone = false;
+                SuccessOrExit(err = CopyBufferedListItems(apReadHandler, readPath, attributeReportIBs, listDone));
+                if (listDone)
+                {
+                    continue;
+                }
+            }
+#endif
+
             // If we are processing a read request, or the initial report of a subscription, just regard all paths as dirty
             // paths.
             TLV::TLVWriter attributeBackup;
@@ -206,6 +265,9 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
                     // is true, we may not have encoded a complete attribute value, but we did, if we encoded anything, encode a
                     // set of complete AttributeReportIB instances that represent part of the attribute value.
                     apReadHandler->SetAttributeEncodeState(encodeState);
+#if CHIP_IM_SERVER_ENCODED_LIST_BUFFER_SIZE > 0
+                    BufferListItems(apReadHandler, pathForRetrieval);
+#endif
                 }
                 else
                 {
@@ -297,6 +359,62 @@ exit:
     return err;
 }
 
+#if CHIP_IM_SERVER_ENCODED_LIST_BUFFER_SIZE > 0
+CHIP_ERROR Engine::CopyBufferedListItems(ReadHandler * apReadHandler, const ConcreteReadAttributePath & aPath,
+                                         AttributeReportIBs::Builder & aAttributeReportIBs, bool & aListDone)
+{
+    aListDone = false;
+    while (apReadHandler->mpEncodedListBuffer && apReadHandler->mpEncodedListBuffer->Holds(aPath))
+    {
+        EncodedListBuffer & listBuffer = *apReadHandler->mpEncodedListBuffer;
+        CHIP_ERROR err                 = listBuffer.Drain(aAttributeReportIBs);
+        if (err != CHIP_NO_ERROR)
+        {
+            if (!IsOutOfWriterSpaceError(err))
+            {
+                apReadHandler->ReleaseEncodedListBuffer();
+            }
+            return err;
+        }
+
+        if (listBuffer.IsComplete())
+        {
+            apReadHandler->ReleaseEncodedListBuffer();
+            apReadHandler->SetAttributeEncodeState(AttributeValueEncoder::AttributeEncodeState());
+            aListDone = true;
+            return CHIP_NO_ERROR;
+        }
+
+        // This chunk has room left, buffer the items that follow.  If that fails, the caller reads the list from them.
+        apReadHandler->SetAttributeEncodeState(listBuffer.GetNextEncodeState());
+        BufferListItems(apReadHandler, aPath);
+    }
+    return CHIP_NO_ERROR;
+}
+
+void Engine::BufferListItems(ReadHandler * apReadHandler, const ConcreteReadAttributePath & aPath)
+{
+    if (!apReadHandler->mpEncodedListBuffer)
+    {
+        apReadHandler->mpEncodedListBuffer = Platform::MakeUnique<EncodedListBuffer>();
+        VerifyOrReturn(apReadHandler->mpEncodedListBuffer);
+    }
+
+    CHIP_ERROR err = apReadHandler->mpEncodedListBuffer->Fill(
+        aPath, apReadHandler->GetAttributeEncodeState(),
+        [&](AttributeReportIBs::Builder & aBuilder, AttributeValueEncoder::AttributeEncodeState & aState) {
+            return RetrieveClusterData(apReadHandler->GetSubjectDescriptor(), apReadHandler->IsFabricFiltered(), aBuilder, aPath,
+                                       &aState);
+        });
+    if (err != CHIP_NO_ERROR)
+    {
+        // The following chunks will read the list again, as without the buffer.
+        ChipLogDetail(DataManagement, "Not buffering list items: %" CHIP_ERROR_FORMAT, err.Format());
+        apReadHandler->ReleaseEncodedListBuffer();
+    }
+}
+#endif
+
 CHIP_ERROR Engine::CheckAccessDeniedEventPaths(TLV::TLVWriter & aWriter, bool & aHasEncodedData, ReadHandler * apReadHandler)
 {
     using Protocols::InteractionModel::Status;
@@ -632,6 +750,9 @@ void Engine::Run()
 
     InteractionModelEngine * imEngine = InteractionModelEngine::GetInstance();
 
+    // ReadHandlers may consume dirty paths from here on, so later changes have to mark them dirty again.
+    mAttributeChangeCoalescer.OnReportRun();
+
     // We may be deallocating read handlers as we go.  Track how many we had
     // initially, so we make sure to go through all of them.
     size_t initialAllocated = imEngine->mReadHandlers.Allocated();
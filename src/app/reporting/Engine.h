@@ -27,6 +27,7 @@
 #include <access/AccessControl.h>
 #include <app/MessageDef/ReportDataMessage.h>
 #include <app/ReadHandler.h>
+#include <app/reporting/AttributeChangeCoalescer.h>
 #include <app/util/basic-types.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
@@ -122,6 +123,11 @@ public:
 
     uint64_t GetDirtySetGeneration() const { return mDirtyGeneration; }
 
+    /**
+     * Filters repeated attribute changes between report runs, see AttributeChangeCoalescer.
+     */
+    AttributeChangeCoalescer & GetAttributeChangeCoalescer() { return mAttributeChangeCoalescer; }
+
     /**
      * Schedule event delivery to happen immediately and run reporting to get
      * those reports into messages and on the wire.  This can be done either for
@@ -166,6 +172,15 @@ private:
                                    AttributeReportIBs::Builder & aAttributeReportIBs,
                                    const ConcreteReadAttributePath & aClusterInfo,
                                    AttributeValueEncoder::AttributeEncodeState * apEncoderState);
+#if CHIP_IM_SERVER_ENCODED_LIST_BUFFER_SIZE > 0
+    // Copy the buffered items of the list at aPath into the chunk, buffering the following items while the chunk has room.
+    // aListDone is set once the whole list has been copied; otherwise, unless the chunk is full, the list must be read from
+    // the ReadHandler's attribute encode state.
+    CHIP_ERROR CopyBufferedListItems(ReadHandler * apReadHandler, const ConcreteReadAttributePath & aPath,
+                                     AttributeReportIBs::Builder & aAttributeReportIBs, bool & aListDone);
+    // Encode the rest of the list being chunked into the ReadHandler's EncodedListBuffer, so that the following chunks copy it.
+    void BufferListItems(ReadHandler * apReadHandler, const ConcreteReadAttributePath & aPath);
+#endif
     CHIP_ERROR CheckAccessDeniedEventPaths(TLV::TLVWriter & aWriter, bool & aHasEncodedData, ReadHandler * apReadHandler);
 
     // If version match, it means don't send, if version mismatch, it means send.
@@ -176,6 +191,9 @@ private:
     bool IsClusterDataVersionMatch(const ObjectList<DataVersionFilter> * aDataVersionFilterList,
                                    const ConcreteReadAttributePath & aPath);
 
+    // Returns whether a path of the dirty set that was marked dirty after aGeneration intersects aPath.
+    bool HasDirtyPathSince(const AttributePathParams & aPath, uint64_t aGeneration);
+
     /**
      * Send Report via ReadHandler
      *
@@ -275,6 +293,8 @@ private:
      */
     uint64_t mDirtyGeneration = 1;
 
+    FixedAttributeChangeCoalescer<CHIP_IM_SERVER_MAX_NUM_COALESCED_CLUSTERS> mAttributeChangeCoalescer;
+
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     uint32_t mReservedSize          = 0;
     uint32_t mMaxAttributesPerChunk = UINT32_MAX;
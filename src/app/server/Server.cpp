@@ -152,7 +152,11 @@ CHIP_ERROR Server::Init(const ServerInitParams & initParams)
 
     // Set up attribute persistence before we try to bring up the data model
     // handler.
+#if CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND
+    SuccessOrExit(err = mAttributePersister.Init(mDeviceStorage, &DeviceLayer::SystemLayer()));
+#else
     SuccessOrExit(err = mAttributePersister.Init(mDeviceStorage));
+#endif // CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND
     SetAttributePersistenceProvider(&mAttributePersister);
     SetSafeAttributePersistenceProvider(&mAttributePersister);
 
@@ -439,6 +443,13 @@ void Server::OnPlatformEvent(const DeviceLayer::ChipDeviceEvent & event)
         ResumeSubscriptions();
 #endif
         break;
+#if CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND
+    case DeviceEventType::kCommissioningComplete:
+        // The fail-safe was committed, store the attribute values written while it was armed along with the rest of the
+        // committed state.
+        mAttributePersister.Flush();
+        break;
+#endif // CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND
 #if CHIP_SYSTEM_CONFIG_USE_OPEN_THREAD_ENDPOINT
     case DeviceEventType::kThreadConnectivityChange:
         if (event.ThreadConnectivityChange.Result == kConnectivity_Established)
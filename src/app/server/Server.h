@@ -29,6 +29,9 @@
 #include <app/OperationalSessionSetupPool.h>
 #include <app/SimpleSubscriptionResumptionStorage.h>
 #include <app/TestEventTriggerDelegate.h>
+#if CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND
+#include <app/WriteBehindAttributePersistenceProvider.h>
+#endif // CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND
 #include <app/server/AclStorage.h>
 #include <app/server/AppDelegate.h>
 #include <app/server/CommissioningWindowManager.h>
@@ -617,7 +620,11 @@ private:
     app::SubscriptionResumptionStorage * mSubscriptionResumptionStorage;
     Credentials::GroupDataProvider * mGroupsProvider;
     Crypto::SessionKeystore * mSessionKeystore;
+#if CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND
+    app::WriteBehindAttributePersistenceProvider mAttributePersister;
+#else
     app::DefaultAttributePersistenceProvider mAttributePersister;
+#endif // CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND
     GroupDataProviderListener mListener;
     ServerFabricDelegate mFabricDelegate;
     app::reporting::ReportScheduler * mReportScheduler;
@@ -0,0 +1,416 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Tests of the attribute storage of fixed endpoints, with the attribute
+ *      access tables and with the search, using the data model of
+ *      test-data-model/zap-generated/endpoint_config.h.
+ */
+
+#include <app/InteractionModelEngine.h>
+#include <app/util/af.h>
+#include <app/util/attribute-storage.h>
+#include <app/util/endpoint-config-api.h>
+#include <app/util/generic-callbacks.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <nlunit-test.h>
+#include <system/SystemClock.h>
+
+#include <string.h>
+
+#if !CHIP_CONFIG_ATTRIBUTE_ACCESS_TABLES
+#error "This test needs CHIP_CONFIG_ATTRIBUTE_ACCESS_TABLES"
+#endif
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr ClusterId kOnOffClusterId       = 0x0000'0006;
+constexpr ClusterId kLevelControlId       = 0x0000'0008;
+constexpr ClusterId kBasicInformationId   = 0x0000'0028;
+constexpr ClusterId kUnitTestingClusterId = 0xFFF1'FC05;
+
+// Attribute for which the access callbacks deny access.
+constexpr EndpointId kDeniedEndpoint   = 2;
+constexpr ClusterId kDeniedCluster     = kOnOffClusterId;
+constexpr AttributeId kDeniedAttribute = 0x0000'4001;
+
+bool IsDenied(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
+{
+    return endpoint == kDeniedEndpoint && clusterId == kDeniedCluster && attributeId == kDeniedAttribute;
+}
+
+EmberAfStatus ReadOrWrite(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId,
+                          const EmberAfAttributeMetadata ** metadata, uint8_t * buffer, uint16_t readLength, bool write)
+{
+    EmberAfAttributeSearchRecord record;
+    record.endpoint    = endpoint;
+    record.clusterId   = clusterId;
+    record.attributeId = attributeId;
+    return emAfReadOrWriteAttribute(&record, metadata, buffer, readLength, write);
+}
+
+template <typename T>
+T ReadValue(nlTestSuite * aSuite, EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
+{
+    T value{};
+    NL_TEST_ASSERT(aSuite,
+                   ReadOrWrite(endpoint, clusterId, attributeId, nullptr, reinterpret_cast<uint8_t *>(&value), sizeof(value),
+                               false) == EMBER_ZCL_STATUS_SUCCESS);
+    return value;
+}
+
+// Calls aFunction with the endpoint, the cluster and the metadata of every attribute of the fixed endpoints.
+template <typename F>
+void ForEachAttribute(F aFunction)
+{
+    for (uint16_t ep = 0; ep < emberAfFixedEndpointCount(); ep++)
+    {
+        const EndpointId endpoint                = emberAfEndpointFromIndex(ep);
+        const EmberAfEndpointType * endpointType = emberAfFindEndpointType(endpoint);
+        for (uint8_t c = 0; c < endpointType->clusterCount; c++)
+        {
+            const EmberAfCluster & cluster = endpointType->cluster[c];
+            for (uint16_t a = 0; a < cluster.attributeCount; a++)
+            {
+                aFunction(endpoint, cluster, cluster.attributes[a]);
+            }
+        }
+    }
+}
+
+// Fills aValue with a valid value of the attribute that depends on aSeed and on the attribute.
+void MakeValue(const EmberAfAttributeMetadata & am, EndpointId endpoint, uint8_t aSeed, uint8_t * aValue)
+{
+    const uint16_t size = emberAfAttributeSize(&am);
+    for (uint16_t i = 0; i < size; i++)
+    {
+        aValue[i] = static_cast<uint8_t>(aSeed + endpoint * 31 + am.attributeId * 7 + i);
+    }
+    if (emberAfIsStringAttributeType(am.attributeType))
+    {
+        aValue[0] = static_cast<uint8_t>(size - 1);
+    }
+    else if (emberAfIsLongStringAttributeType(am.attributeType))
+    {
+        aValue[0] = static_cast<uint8_t>(size - 2);
+        aValue[1] = static_cast<uint8_t>((size - 2) >> 8);
+    }
+}
+
+void TestDefaults(nlTestSuite * aSuite, void * aContext)
+{
+    for (bool tables : { true, false })
+    {
+        emberAfSetAttributeAccessTablesEnabled(tables);
+
+        // Singletons of endpoint 0.
+        NL_TEST_ASSERT(aSuite, ReadValue<uint16_t>(aSuite, 0, kBasicInformationId, 0x0000'0000) == 17);
+        NL_TEST_ASSERT(aSuite, ReadValue<uint16_t>(aSuite, 0, kBasicInformationId, 0x0000'0002) == 0xFFF1);
+        NL_TEST_ASSERT(aSuite, ReadValue<uint16_t>(aSuite, 0, kBasicInformationId, 0x0000'FFFD) == 2);
+
+        // Defaults longer than four bytes.
+        NL_TEST_ASSERT(aSuite, ReadValue<uint64_t>(aSuite, 1, kUnitTestingClusterId, 0x0000'0013) == 42);
+        NL_TEST_ASSERT(aSuite, ReadValue<uint64_t>(aSuite, 2, kUnitTestingClusterId, 0x0000'0020) == 0x0001'0203'0405'0607);
+
+        // Same cluster with different defaults on endpoints of different types.
+        NL_TEST_ASSERT(aSuite, ReadValue<uint8_t>(aSuite, 1, kOnOffClusterId, 0x0000'0000) == 0);
+        NL_TEST_ASSERT(aSuite, ReadValue<uint8_t>(aSuite, 16, kOnOffClusterId, 0x0000'0000) == 1);
+        NL_TEST_ASSERT(aSuite, ReadValue<uint8_t>(aSuite, 2, kLevelControlId, 0x0000'0003) == 0xFE);
+        NL_TEST_ASSERT(aSuite, ReadValue<uint32_t>(aSuite, 2, kLevelControlId, 0x0000'FFFC) == 3);
+    }
+    emberAfSetAttributeAccessTablesEnabled(true);
+}
+
+void TestTablesMatchSearch(nlTestSuite * aSuite, void * aContext)
+{
+    // Every attribute of every cluster of the fixed endpoints, attribute ids that these clusters do not have, and
+    // clusters and endpoints that do not exist, must give the same result with and without the tables.
+    constexpr AttributeId kUnknownAttributeIds[] = { 0x0000'0004, 0x0000'1234, 0x0000'FFF8, 0xFFF1'0000, kInvalidAttributeId };
+    constexpr ClusterId kUnknownClusterIds[]     = { 0x0000'0003, 0x0000'0300, 0xFFF1'FC06, kInvalidClusterId };
+    constexpr uint16_t kReadLengths[]            = { ATTRIBUTE_LARGEST, 1, 0 };
+
+    size_t checked = 0;
+    auto check     = [&](EndpointId endpoint, ClusterId clusterId, AttributeId attributeId) {
+        for (uint16_t readLength : kReadLengths)
+        {
+            const EmberAfAttributeMetadata * metadata[2] = { nullptr, nullptr };
+            EmberAfStatus status[2];
+            EmberAfStatus metadataStatus[2];
+            uint8_t buffer[2][ATTRIBUTE_LARGEST];
+            memset(buffer, 0xA5, sizeof(buffer));
+
+            for (int tables = 0; tables < 2; tables++)
+            {
+                emberAfSetAttributeAccessTablesEnabled(tables != 0);
+                const EmberAfAttributeMetadata * unused = nullptr;
+                metadataStatus[tables] = ReadOrWrite(endpoint, clusterId, attributeId, &unused, nullptr, 0, false);
+                status[tables]         = ReadOrWrite(endpoint, clusterId, attributeId, &metadata[tables], buffer[tables],
+                                                     readLength, false);
+            }
+            NL_TEST_ASSERT(aSuite, status[0] == status[1]);
+            NL_TEST_ASSERT(aSuite, metadataStatus[0] == metadataStatus[1]);
+            NL_TEST_ASSERT(aSuite, metadata[0] == metadata[1]);
+            NL_TEST_ASSERT(aSuite, memcmp(buffer[0], buffer[1], sizeof(buffer[0])) == 0);
+            checked++;
+        }
+    };
+
+    ForEachAttribute([&](EndpointId endpoint, const EmberAfCluster & cluster, const EmberAfAttributeMetadata & am) {
+        check(endpoint, cluster.clusterId, am.attributeId);
+    });
+    for (uint16_t ep = 0; ep < emberAfFixedEndpointCount(); ep++)
+    {
+        const EndpointId endpoint                = emberAfEndpointFromIndex(ep);
+        const EmberAfEndpointType * endpointType = emberAfFindEndpointType(endpoint);
+        for (uint8_t c = 0; c < endpointType->clusterCount; c++)
+        {
+            for (AttributeId attributeId : kUnknownAttributeIds)
+            {
+                check(endpoint, endpointType->cluster[c].clusterId, attributeId);
+            }
+        }
+        for (ClusterId clusterId : kUnknownClusterIds)
+        {
+            check(endpoint, clusterId, 0x0000'0000);
+        }
+    }
+    check(3, kOnOffClusterId, 0x0000'0000);
+    check(kInvalidEndpointId, kOnOffClusterId, 0x0000'0000);
+
+    // A read of a value larger than the buffer fails, and the denied attribute cannot be read or written.
+    for (bool tables : { true, false })
+    {
+        emberAfSetAttributeAccessTablesEnabled(tables);
+        uint8_t buffer[8];
+        NL_TEST_ASSERT(aSuite,
+                       ReadOrWrite(1, kUnitTestingClusterId, 0x0000'0013, nullptr, buffer, 4, false) ==
+                           EMBER_ZCL_STATUS_RESOURCE_EXHAUSTED);
+        NL_TEST_ASSERT(aSuite,
+                       ReadOrWrite(kDeniedEndpoint, kDeniedCluster, kDeniedAttribute, nullptr, buffer, sizeof(buffer), false) ==
+                           EMBER_ZCL_STATUS_UNSUPPORTED_ACCESS);
+        NL_TEST_ASSERT(aSuite,
+                       ReadOrWrite(kDeniedEndpoint, kDeniedCluster, kDeniedAttribute, nullptr, buffer, 0, true) ==
+                           EMBER_ZCL_STATUS_UNSUPPORTED_ACCESS);
+    }
+    emberAfSetAttributeAccessTablesEnabled(true);
+    NL_TEST_ASSERT(aSuite, checked > 0);
+}
+
+void TestWriteAndReadBack(nlTestSuite * aSuite, void * aContext)
+{
+    // Write every stored attribute in one mode and read all of them back in the other, so that values written through
+    // the tables land where the search finds them and the other way around, without overlapping each other.
+    uint8_t seed = 1;
+    for (bool writeTables : { true, false })
+    {
+        emberAfSetAttributeAccessTablesEnabled(writeTables);
+        ForEachAttribute([&](EndpointId endpoint, const EmberAfCluster & cluster, const EmberAfAttributeMetadata & am) {
+            if (am.IsExternal() || IsDenied(endpoint, cluster.clusterId, am.attributeId))
+            {
+                return;
+            }
+            uint8_t value[ATTRIBUTE_LARGEST];
+            MakeValue(am, endpoint, seed, value);
+            NL_TEST_ASSERT(aSuite,
+                           ReadOrWrite(endpoint, cluster.clusterId, am.attributeId, nullptr, value, 0, true) ==
+                               EMBER_ZCL_STATUS_SUCCESS);
+        });
+
+        emberAfSetAttributeAccessTablesEnabled(!writeTables);
+        size_t verified = 0;
+        ForEachAttribute([&](EndpointId endpoint, const EmberAfCluster & cluster, const EmberAfAttributeMetadata & am) {
+            if (am.IsExternal() || IsDenied(endpoint, cluster.clusterId, am.attributeId))
+            {
+                return;
+            }
+            uint8_t expected[ATTRIBUTE_LARGEST];
+            uint8_t value[ATTRIBUTE_LARGEST];
+            MakeValue(am, endpoint, seed, expected);
+            NL_TEST_ASSERT(aSuite,
+                           ReadOrWrite(endpoint, cluster.clusterId, am.attributeId, nullptr, value, sizeof(value), false) ==
+                               EMBER_ZCL_STATUS_SUCCESS);
+            NL_TEST_ASSERT(aSuite, memcmp(value, expected, emberAfAttributeSize(&am)) == 0);
+            verified++;
+        });
+        NL_TEST_ASSERT(aSuite, verified > 0);
+        seed = static_cast<uint8_t>(seed + 0x40);
+    }
+
+    emberAfSetAttributeAccessTablesEnabled(true);
+    emberAfResetAttributes(EMBER_BROADCAST_ENDPOINT);
+}
+
+void TestAttributeAccessBenchmark(nlTestSuite * aSuite, void * aContext)
+{
+    // Read and write every stored attribute of every fixed endpoint through the attribute storage, with the search and
+    // with the tables.
+    constexpr unsigned kRounds = 200;
+
+    auto run = [&](bool tables, size_t & accesses) {
+        emberAfSetAttributeAccessTablesEnabled(tables);
+        accesses       = 0;
+        uint64_t start = System::SystemClock().GetMonotonicMicroseconds64().count();
+        for (unsigned round = 0; round < kRounds; round++)
+        {
+            ForEachAttribute([&](EndpointId endpoint, const EmberAfCluster & cluster, const EmberAfAttributeMetadata & am) {
+                if (am.IsExternal() || IsDenied(endpoint, cluster.clusterId, am.attributeId))
+                {
+                    return;
+                }
+                uint8_t value[ATTRIBUTE_LARGEST];
+                ReadOrWrite(endpoint, cluster.clusterId, am.attributeId, nullptr, value, sizeof(value), false);
+                ReadOrWrite(endpoint, cluster.clusterId, am.attributeId, nullptr, value, 0, true);
+                accesses += 2;
+            });
+        }
+        return System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+    };
+
+    size_t searchAccesses = 0;
+    size_t tableAccesses  = 0;
+    uint64_t searchMicros = run(false, searchAccesses);
+    uint64_t tableMicros  = run(true, tableAccesses);
+    NL_TEST_ASSERT(aSuite, searchAccesses == tableAccesses);
+    NL_TEST_ASSERT(aSuite, tableAccesses > 0);
+
+    ChipLogProgress(DataManagement, "%u attribute reads and writes: search %u ns each, attribute access tables %u ns each",
+                    static_cast<unsigned>(tableAccesses), static_cast<unsigned>(searchMicros * 1000 / searchAccesses),
+                    static_cast<unsigned>(tableMicros * 1000 / tableAccesses));
+}
+
+int TestSetup(void * inContext)
+{
+    VerifyOrReturnError(Platform::MemoryInit() == CHIP_NO_ERROR, FAILURE);
+    emberAfEndpointConfigure();
+    emberAfInitializeAttributes(EMBER_BROADCAST_ENDPOINT);
+    return SUCCESS;
+}
+
+int TestTeardown(void * inContext)
+{
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+// Callbacks the application provides to the attribute storage.
+
+void emberAfClusterInitCallback(EndpointId endpoint, ClusterId clusterId) {}
+
+bool emberAfAttributeReadAccessCallback(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
+{
+    return !IsDenied(endpoint, clusterId, attributeId);
+}
+
+bool emberAfAttributeWriteAccessCallback(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
+{
+    return !IsDenied(endpoint, clusterId, attributeId);
+}
+
+EmberAfStatus emberAfExternalAttributeReadCallback(EndpointId endpoint, ClusterId clusterId,
+                                                   const EmberAfAttributeMetadata * attributeMetadata, uint8_t * buffer,
+                                                   uint16_t maxReadLength)
+{
+    return EMBER_ZCL_STATUS_FAILURE;
+}
+
+EmberAfStatus emberAfExternalAttributeWriteCallback(EndpointId endpoint, ClusterId clusterId,
+                                                    const EmberAfAttributeMetadata * attributeMetadata, uint8_t * buffer)
+{
+    return EMBER_ZCL_STATUS_FAILURE;
+}
+
+void MatterReportingAttributeChangeCallback(EndpointId endpoint) {}
+
+// The attribute storage uses the interaction model engine, which needs the data model the application normally
+// provides through ember-compatibility-functions.cpp.  This test does not go through the interaction model.
+namespace chip {
+namespace app {
+
+Protocols::InteractionModel::Status ServerClusterCommandExists(const ConcreteCommandPath & aCommandPath)
+{
+    return Protocols::InteractionModel::Status::UnsupportedCommand;
+}
+
+void DispatchSingleClusterCommand(const ConcreteCommandPath & aCommandPath, TLV::TLVReader & aReader,
+                                  CommandHandler * apCommandObj)
+{}
+
+CHIP_ERROR ReadSingleClusterData(const Access::SubjectDescriptor & aSubjectDescriptor, bool aIsFabricFiltered,
+                                 const ConcreteReadAttributePath & aPath, AttributeReportIBs::Builder & aAttributeReports,
+                                 AttributeValueEncoder::AttributeEncodeState * apEncoderState)
+{
+    return CHIP_ERROR_NOT_IMPLEMENTED;
+}
+
+bool ConcreteAttributePathExists(const ConcreteAttributePath & aPath)
+{
+    return false;
+}
+
+Protocols::InteractionModel::Status CheckEventSupportStatus(const ConcreteEventPath & aPath)
+{
+    return Protocols::InteractionModel::Status::UnsupportedEvent;
+}
+
+const EmberAfAttributeMetadata * GetAttributeMetadata(const ConcreteAttributePath & aPath)
+{
+    return nullptr;
+}
+
+CHIP_ERROR WriteSingleClusterData(const Access::SubjectDescriptor & aSubjectDescriptor, const ConcreteDataAttributePath & aPath,
+                                  TLV::TLVReader & aReader, WriteHandler * apWriteHandler)
+{
+    return CHIP_ERROR_NOT_IMPLEMENTED;
+}
+
+bool IsClusterDataVersionEqual(const ConcreteClusterPath & aConcreteClusterPath, DataVersion aRequiredVersion)
+{
+    return false;
+}
+
+} // namespace app
+} // namespace chip
+
+int TestAttributeAccessTable()
+{
+    static nlTest sTests[] = {
+        NL_TEST_DEF("TestDefaults", TestDefaults),
+        NL_TEST_DEF("TestTablesMatchSearch", TestTablesMatchSearch),
+        NL_TEST_DEF("TestWriteAndReadBack", TestWriteAndReadBack),
+        NL_TEST_DEF("TestAttributeAccessBenchmark", TestAttributeAccessBenchmark),
+        NL_TEST_SENTINEL(),
+    };
+
+    nlTestSuite theSuite = {
+        "AttributeAccessTable",
+        &sTests[0],
+        TestSetup,
+        TestTeardown,
+    };
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestAttributeAccessTable)
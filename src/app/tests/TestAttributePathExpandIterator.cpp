@@ -417,6 +417,62 @@ void TestMultipleClusInfo(nlTestSuite * apSuite, void * apContext)
     NL_TEST_ASSERT(apSuite, index == ArraySize(paths));
 }
 
+void TestSkipClusterAndEndpoint(nlTestSuite * apSuite, void * apContext)
+{
+    app::ObjectList<app::AttributePathParams> clusInfo1;
+    app::ObjectList<app::AttributePathParams> clusInfo2;
+    clusInfo1.mpNext = &clusInfo2;
+
+    clusInfo2.mValue.mEndpointId  = Test::kMockEndpoint2;
+    clusInfo2.mValue.mClusterId   = Test::MockClusterId(3);
+    clusInfo2.mValue.mAttributeId = Test::MockAttributeId(3);
+
+    app::ConcreteAttributePath path;
+    P paths[] = {
+        { kMockEndpoint1, MockClusterId(1), Clusters::Globals::Attributes::ClusterRevision::Id },
+        { kMockEndpoint1, MockClusterId(2), Clusters::Globals::Attributes::ClusterRevision::Id },
+        { kMockEndpoint2, MockClusterId(1), Clusters::Globals::Attributes::ClusterRevision::Id },
+        { kMockEndpoint3, MockClusterId(1), Clusters::Globals::Attributes::ClusterRevision::Id },
+        { kMockEndpoint3, MockClusterId(2), Clusters::Globals::Attributes::ClusterRevision::Id },
+        { kMockEndpoint3, MockClusterId(2), Clusters::Globals::Attributes::FeatureMap::Id },
+        { kMockEndpoint3, MockClusterId(2), MockAttributeId(1) },
+        { kMockEndpoint3, MockClusterId(2), MockAttributeId(2) },
+        { kMockEndpoint3, MockClusterId(2), MockAttributeId(3) },
+        { kMockEndpoint3, MockClusterId(2), MockAttributeId(4) },
+        { kMockEndpoint3, MockClusterId(2), Clusters::Globals::Attributes::GeneratedCommandList::Id },
+        { kMockEndpoint3, MockClusterId(2), Clusters::Globals::Attributes::AcceptedCommandList::Id },
+#if CHIP_CONFIG_ENABLE_EVENTLIST_ATTRIBUTE
+        { kMockEndpoint3, MockClusterId(2), Clusters::Globals::Attributes::EventList::Id },
+#endif
+        { kMockEndpoint3, MockClusterId(2), Clusters::Globals::Attributes::AttributeList::Id },
+        { kMockEndpoint3, MockClusterId(3), Clusters::Globals::Attributes::ClusterRevision::Id },
+        { kMockEndpoint3, MockClusterId(4), Clusters::Globals::Attributes::ClusterRevision::Id },
+        { kMockEndpoint2, MockClusterId(3), MockAttributeId(3) },
+    };
+
+    size_t index = 0;
+
+    for (app::AttributePathExpandIterator iter(&clusInfo1); iter.Get(path); iter.Next())
+    {
+        ChipLogDetail(AppServer, "Visited Attribute: 0x%04X / " ChipLogFormatMEI " / " ChipLogFormatMEI, path.mEndpointId,
+                      ChipLogValueMEI(path.mClusterId), ChipLogValueMEI(path.mAttributeId));
+        NL_TEST_ASSERT(apSuite, index < ArraySize(paths) && paths[index] == path);
+        index++;
+
+        // Skip every cluster of endpoint 1, the whole of endpoint 2 and every cluster but the second one of endpoint 3.  The
+        // concrete path is emitted once whatever is skipped.
+        if (path.mEndpointId == kMockEndpoint2)
+        {
+            iter.SkipCurrentEndpoint();
+        }
+        else if (path.mEndpointId == kMockEndpoint1 || path.mClusterId != MockClusterId(2))
+        {
+            iter.SkipCurrentCluster();
+        }
+    }
+    NL_TEST_ASSERT(apSuite, index == ArraySize(paths));
+}
+
 static int TestSetup(void * inContext)
 {
     return SUCCESS;
@@ -445,6 +501,7 @@ const nlTest sTests[] =
         NL_TEST_DEF("TestWildcardAttribute", TestWildcardAttribute),
         NL_TEST_DEF("TestNoWildcard", TestNoWildcard),
         NL_TEST_DEF("TestMultipleClusInfo", TestMultipleClusInfo),
+        NL_TEST_DEF("TestSkipClusterAndEndpoint", TestSkipClusterAndEndpoint),
         NL_TEST_SENTINEL()
 };
 // clang-format on
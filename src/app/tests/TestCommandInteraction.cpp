@@ -296,6 +296,7 @@ public:
     static void TestCommandSenderExtendableCallbackUnsupportedCommand(nlTestSuite * apSuite, void * apContext);
     static void TestCommandSenderLegacyCallbackBuildingBatchCommandFails(nlTestSuite * apSuite, void * apContext);
     static void TestCommandSenderExtendableCallbackBuildingBatchCommandFails(nlTestSuite * apSuite, void * apContext);
+    static void TestCommandSenderBatchRollsBackCommandThatDoesNotFit(nlTestSuite * apSuite, void * apContext);
     static void TestCommandSenderCommandSuccessResponseFlow(nlTestSuite * apSuite, void * apContext);
     static void TestCommandSenderCommandAsyncSuccessResponseFlow(nlTestSuite * apSuite, void * apContext);
     static void TestCommandSenderCommandFailureResponseFlow(nlTestSuite * apSuite, void * apContext);
@@ -689,6 +690,7 @@ void TestCommandInteraction::TestCommandHandlerWithSendSimpleCommandData(nlTestS
 struct Fields
 {
     static constexpr chip::CommandId GetCommandId() { return 4; }
+    static constexpr bool MustUseTimedInvoke() { return false; }
     CHIP_ERROR Encode(TLV::TLVWriter & aWriter, TLV::Tag aTag) const
     {
         TLV::TLVType outerContainerType;
@@ -701,6 +703,7 @@ struct Fields
 struct BadFields
 {
     static constexpr chip::CommandId GetCommandId() { return 4; }
+    static constexpr bool MustUseTimedInvoke() { return false; }
     CHIP_ERROR Encode(TLV::TLVWriter & aWriter, TLV::Tag aTag) const
     {
         TLV::TLVType outerContainerType;
@@ -1344,6 +1347,62 @@ void TestCommandInteraction::TestCommandSenderExtendableCallbackBuildingBatchCom
     NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
 }
 
+void TestCommandInteraction::TestCommandSenderBatchRollsBackCommandThatDoesNotFit(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = CHIP_NO_ERROR;
+    mockCommandSenderExtendedDelegate.ResetCounter();
+    app::CommandSender commandSender(&mockCommandSenderExtendedDelegate, &ctx.GetExchangeManager());
+
+    // TODO(#30453): Once CHIP_CONFIG_SENDING_BATCH_COMMANDS_ENABLED is removed we will need
+    // to call SetCommandSenderConfig with remoteMaxPathsPerInvoke set to 4.
+    commandSender.mBatchCommandsEnabled    = true;
+    commandSender.mRemoteMaxPathsPerInvoke = 4;
+
+    app::CommandSender::AdditionalCommandParameters firstCommandParameters;
+    err = commandSender.AddRequestData(MakeTestCommandPath(kTestCommandIdWithData), Fields(), firstCommandParameters);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    uint32_t lengthAfterFirstCommand = commandSender.mCommandMessageWriter.GetLengthWritten();
+
+    // BadFields does not fit in the message. Adding it must leave the batch as it was before.
+    app::CommandSender::AdditionalCommandParameters badCommandParameters;
+    err = commandSender.AddRequestData(MakeTestCommandPath(kTestCommandIdCommandSpecificResponse), BadFields(),
+                                       badCommandParameters);
+    NL_TEST_ASSERT(apSuite, err != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, commandSender.mState == app::CommandSender::State::AddedCommand);
+    NL_TEST_ASSERT(apSuite, commandSender.mFinishedCommandCount == 1);
+    NL_TEST_ASSERT(apSuite, commandSender.mCommandMessageWriter.GetLengthWritten() == lengthAfterFirstCommand);
+
+    // The batch can still grow, and the next command reuses the CommandRef of the rolled back one.
+    app::CommandSender::AdditionalCommandParameters secondCommandParameters;
+    err = commandSender.AddRequestData(MakeTestCommandPath(kTestCommandIdCommandSpecificResponse), Fields(),
+                                       secondCommandParameters);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, secondCommandParameters.commandRef.HasValue() && secondCommandParameters.commandRef.Value() == 1);
+
+    // Both commands reach a CommandHandler that accepts batches intact.
+    BasicCommandPathRegistry<4> mBasicCommandPathRegistry;
+    CommandHandler commandHandler(kThisIsForTestOnly, &mockCommandHandlerDelegate, &mBasicCommandPathRegistry);
+    TestExchangeDelegate delegate;
+    auto exchange = ctx.NewExchangeToAlice(&delegate, false);
+    commandHandler.mExchangeCtx.Grab(exchange);
+
+    // Hackery to steal the InvokeRequest buffer from commandSender.
+    System::PacketBufferHandle commandDatabuf;
+    err = commandSender.Finalize(commandDatabuf);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    mockCommandHandlerDelegate.ResetCounter();
+    commandDispatchedCount = 0;
+
+    InteractionModel::Status status = commandHandler.ProcessInvokeRequest(std::move(commandDatabuf), false);
+    NL_TEST_ASSERT(apSuite, status == InteractionModel::Status::Success);
+    NL_TEST_ASSERT(apSuite, commandDispatchedCount == 2);
+
+    // See TestCommandHandlerAcceptMultipleCommands for why the exchange has to be closed explicitly.
+    exchange->Close();
+}
+
 void TestCommandInteraction::TestCommandSenderCommandSuccessResponseFlow(nlTestSuite * apSuite, void * apContext)
 {
     TestContext & ctx = *static_cast<TestContext *>(apContext);
@@ -1835,6 +1894,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("TestCommandSenderExtendableCallbackUnsupportedCommand", chip::app::TestCommandInteraction::TestCommandSenderExtendableCallbackUnsupportedCommand),
     NL_TEST_DEF("TestCommandSenderLegacyCallbackBuildingBatchCommandFails", chip::app::TestCommandInteraction::TestCommandSenderLegacyCallbackBuildingBatchCommandFails),
     NL_TEST_DEF("TestCommandSenderExtendableCallbackBuildingBatchCommandFails", chip::app::TestCommandInteraction::TestCommandSenderExtendableCallbackBuildingBatchCommandFails),
+    NL_TEST_DEF("TestCommandSenderBatchRollsBackCommandThatDoesNotFit", chip::app::TestCommandInteraction::TestCommandSenderBatchRollsBackCommandThatDoesNotFit),
     NL_TEST_DEF("TestCommandSenderCommandSuccessResponseFlow", chip::app::TestCommandInteraction::TestCommandSenderCommandSuccessResponseFlow),
     NL_TEST_DEF("TestCommandSenderCommandAsyncSuccessResponseFlow", chip::app::TestCommandInteraction::TestCommandSenderCommandAsyncSuccessResponseFlow),
     NL_TEST_DEF("TestCommandSenderCommandSpecificResponseFlow", chip::app::TestCommandInteraction::TestCommandSenderCommandSpecificResponseFlow),
@@ -0,0 +1,564 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/util/DynamicEndpointRegistry.h>
+#include <app/util/attribute-storage.h>
+#include <app/util/endpoint-index-table.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <nlunit-test.h>
+#include <system/SystemClock.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr uint16_t kEmberDynamicSlots   = 2048;
+constexpr EndpointId kFixedEndpointId   = 0;
+constexpr size_t kMaxPartsListEndpoints = kEmberDynamicSlots + 1;
+constexpr EndpointId kMaxCountedId      = 64;
+
+// Minimal model of the dynamic endpoint part of the attribute storage, just
+// enough to observe what the registry asks of it.  Id lookups and PartsList
+// report coalescing use the same index table and deferral as the attribute
+// storage.
+struct EmberSlot
+{
+    EndpointId id = kInvalidEndpointId;
+    const EmberAfEndpointType * endpointType;
+    Span<DataVersion> dataVersions;
+    EndpointId parentId;
+};
+
+EmberSlot gEmberSlots[kEmberDynamicSlots];
+EndpointIndexTable<kEmberDynamicSlots> gEmberIndex;
+PartsListReportDeferral<kMaxPartsListEndpoints> gPartsListDeferral;
+unsigned gPartsListReports = 0;
+unsigned gPartsListReportsByEndpoint[kMaxCountedId];
+unsigned gPartsListReportAlls = 0;
+
+void ReportPartsList(EndpointId endpoint)
+{
+    if (gPartsListDeferral.Defer(endpoint))
+    {
+        return;
+    }
+    gPartsListReports++;
+    if (endpoint < kMaxCountedId)
+    {
+        gPartsListReportsByEndpoint[endpoint]++;
+    }
+}
+
+// Same reports as emberAfEndpointEnableDisable: the PartsList of every
+// ancestor and of the root endpoint.
+void ReportPartsListChanges(EndpointId parentId)
+{
+    while (parentId != kInvalidEndpointId)
+    {
+        ReportPartsList(parentId);
+        uint16_t parentIndex = gEmberIndex.Lookup(parentId);
+        if (parentIndex == decltype(gEmberIndex)::kInvalidIndex)
+        {
+            break;
+        }
+        parentId = gEmberSlots[parentIndex].parentId;
+    }
+    ReportPartsList(kFixedEndpointId);
+}
+
+void ResetPartsListReports()
+{
+    gPartsListReports    = 0;
+    gPartsListReportAlls = 0;
+    memset(gPartsListReportsByEndpoint, 0, sizeof(gPartsListReportsByEndpoint));
+}
+
+void ResetEmber()
+{
+    for (auto & slot : gEmberSlots)
+    {
+        slot = EmberSlot();
+    }
+    gEmberIndex.Clear();
+    ResetPartsListReports();
+}
+
+const EmberAfCluster kLightClusters[] = {
+    { 0x0006, nullptr, 0, 0, CLUSTER_MASK_SERVER, nullptr, nullptr, nullptr, nullptr, 0 },
+    { 0x0008, nullptr, 0, 0, CLUSTER_MASK_SERVER, nullptr, nullptr, nullptr, nullptr, 0 },
+    { 0x001D, nullptr, 0, 0, CLUSTER_MASK_SERVER, nullptr, nullptr, nullptr, nullptr, 0 },
+    { 0x0039, nullptr, 0, 0, CLUSTER_MASK_SERVER, nullptr, nullptr, nullptr, nullptr, 0 },
+    { 0x0003, nullptr, 0, 0, CLUSTER_MASK_CLIENT, nullptr, nullptr, nullptr, nullptr, 0 },
+};
+const EmberAfEndpointType kLightEndpoint = { kLightClusters, ArraySize(kLightClusters), 0 };
+
+const EmberAfCluster kSensorClusters[] = {
+    { 0x0402, nullptr, 0, 0, CLUSTER_MASK_SERVER, nullptr, nullptr, nullptr, nullptr, 0 },
+    { 0x001D, nullptr, 0, 0, CLUSTER_MASK_SERVER, nullptr, nullptr, nullptr, nullptr, 0 },
+};
+const EmberAfEndpointType kSensorEndpoint = { kSensorClusters, ArraySize(kSensorClusters), 0 };
+
+const EmberAfDeviceType kLightDeviceTypes[]  = { { 0x0100, 1 }, { 0x0013, 1 } };
+const EmberAfDeviceType kSensorDeviceTypes[] = { { 0x0302, 1 }, { 0x0013, 1 } };
+
+const DynamicEndpointTemplate kLight  = { &kLightEndpoint, Span<const EmberAfDeviceType>(kLightDeviceTypes) };
+const DynamicEndpointTemplate kSensor = { &kSensorEndpoint, Span<const EmberAfDeviceType>(kSensorDeviceTypes) };
+
+constexpr uint8_t kMaxClusters = 4;
+
+} // namespace
+
+uint8_t emberAfClusterCountForEndpointType(const EmberAfEndpointType * type, bool server)
+{
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < type->clusterCount; i++)
+    {
+        if (type->cluster[i].mask & (server ? CLUSTER_MASK_SERVER : CLUSTER_MASK_CLIENT))
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+EmberAfStatus emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const EmberAfEndpointType * ep,
+                                        const Span<DataVersion> & dataVersionStorage, Span<const EmberAfDeviceType> deviceTypeList,
+                                        EndpointId parentEndpointId)
+{
+    if (index >= kEmberDynamicSlots)
+    {
+        return EMBER_ZCL_STATUS_RESOURCE_EXHAUSTED;
+    }
+    if (id == kInvalidEndpointId)
+    {
+        return EMBER_ZCL_STATUS_CONSTRAINT_ERROR;
+    }
+    if (dataVersionStorage.size() < emberAfClusterCountForEndpointType(ep, /* server = */ true))
+    {
+        return EMBER_ZCL_STATUS_RESOURCE_EXHAUSTED;
+    }
+    if (id == kFixedEndpointId || gEmberIndex.Lookup(id) != decltype(gEmberIndex)::kInvalidIndex)
+    {
+        return EMBER_ZCL_STATUS_DUPLICATE_EXISTS;
+    }
+
+    gEmberSlots[index] = { id, ep, dataVersionStorage, parentEndpointId };
+    gEmberIndex.Insert(id, index);
+    ReportPartsListChanges(parentEndpointId);
+    return EMBER_ZCL_STATUS_SUCCESS;
+}
+
+EndpointId emberAfClearDynamicEndpoint(uint16_t index)
+{
+    if (index >= kEmberDynamicSlots || gEmberSlots[index].id == kInvalidEndpointId)
+    {
+        return kInvalidEndpointId;
+    }
+    EndpointId id = gEmberSlots[index].id;
+    ReportPartsListChanges(gEmberSlots[index].parentId);
+    gEmberIndex.Remove(id);
+    gEmberSlots[index].id = kInvalidEndpointId;
+    return id;
+}
+
+uint16_t emberAfGetDynamicIndexFromEndpoint(EndpointId id)
+{
+    return gEmberIndex.Lookup(id);
+}
+
+void emberAfBeginDeferredPartsListReporting()
+{
+    gPartsListDeferral.Begin();
+}
+
+void emberAfEndDeferredPartsListReporting()
+{
+    gPartsListDeferral.End(ReportPartsList, [] { gPartsListReportAlls++; });
+}
+
+namespace {
+
+void TestAddRemove(nlTestSuite * aSuite, void * aContext)
+{
+    ResetEmber();
+    DynamicEndpointRegistry registry;
+    NL_TEST_ASSERT(aSuite, registry.Init(kMaxClusters, 3) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, registry.Capacity() == 3);
+
+    NL_TEST_ASSERT(aSuite, registry.AddEndpoint(10, kLight) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, registry.AddEndpoint(11, kSensor, 10) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, registry.Count() == 2);
+    NL_TEST_ASSERT(aSuite, registry.Contains(10) && registry.Contains(11) && !registry.Contains(12));
+    NL_TEST_ASSERT(aSuite, registry.GetTemplate(10) == &kLight);
+    NL_TEST_ASSERT(aSuite, registry.GetTemplate(11) == &kSensor);
+    NL_TEST_ASSERT(aSuite, registry.GetTemplate(12) == nullptr);
+
+    uint16_t lightIndex  = registry.GetDynamicIndex(10);
+    uint16_t sensorIndex = registry.GetDynamicIndex(11);
+    NL_TEST_ASSERT(aSuite, lightIndex == 0 && sensorIndex == 1);
+    NL_TEST_ASSERT(aSuite, gEmberSlots[sensorIndex].parentId == 10);
+    NL_TEST_ASSERT(aSuite, gEmberSlots[lightIndex].endpointType == &kLightEndpoint);
+
+    // Every endpoint gets its own DataVersion storage.
+    const Span<DataVersion> & lightVersions  = gEmberSlots[lightIndex].dataVersions;
+    const Span<DataVersion> & sensorVersions = gEmberSlots[sensorIndex].dataVersions;
+    NL_TEST_ASSERT(aSuite, lightVersions.size() >= 4 && sensorVersions.size() >= 2);
+    NL_TEST_ASSERT(aSuite,
+                   lightVersions.data() + lightVersions.size() <= sensorVersions.data() ||
+                       sensorVersions.data() + sensorVersions.size() <= lightVersions.data());
+
+    NL_TEST_ASSERT(aSuite, registry.RemoveEndpoint(10) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, registry.RemoveEndpoint(10) == CHIP_ERROR_NOT_FOUND);
+    NL_TEST_ASSERT(aSuite, !registry.Contains(10));
+    NL_TEST_ASSERT(aSuite, gEmberSlots[lightIndex].id == kInvalidEndpointId);
+    NL_TEST_ASSERT(aSuite, emberAfGetDynamicIndexFromEndpoint(10) == kEmberInvalidEndpointIndex);
+    NL_TEST_ASSERT(aSuite, emberAfGetDynamicIndexFromEndpoint(11) == sensorIndex);
+    NL_TEST_ASSERT(aSuite, registry.Count() == 1);
+
+    // The freed slot is reused first.
+    NL_TEST_ASSERT(aSuite, registry.AddEndpoint(12, kSensor) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, registry.GetDynamicIndex(12) == lightIndex);
+
+    registry.Shutdown();
+    NL_TEST_ASSERT(aSuite, registry.Count() == 0);
+    NL_TEST_ASSERT(aSuite, gEmberSlots[0].id == kInvalidEndpointId && gEmberSlots[1].id == kInvalidEndpointId);
+}
+
+void TestAddErrors(nlTestSuite * aSuite, void * aContext)
+{
+    ResetEmber();
+    DynamicEndpointRegistry registry;
+    NL_TEST_ASSERT(aSuite, registry.AddEndpoint(10, kLight) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(aSuite, registry.Init(kMaxClusters, 0) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(aSuite, registry.Init(kMaxClusters, 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, registry.Init(kMaxClusters, 2) == CHIP_ERROR_INCORRECT_STATE);
+
+    NL_TEST_ASSERT(aSuite, registry.AddEndpoint(kInvalidEndpointId, kLight) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(aSuite, registry.AddEndpoint(10, DynamicEndpointTemplate()) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(aSuite, registry.AddEndpoint(kFixedEndpointId, kLight) == CHIP_ERROR_DUPLICATE_KEY_ID);
+
+    NL_TEST_ASSERT(aSuite, registry.AddEndpoint(10, kLight) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, registry.AddEndpoint(10, kSensor) == CHIP_ERROR_DUPLICATE_KEY_ID);
+    NL_TEST_ASSERT(aSuite, registry.AddEndpoint(11, kSensor) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, registry.AddEndpoint(12, kSensor) == CHIP_ERROR_NO_MEMORY);
+    NL_TEST_ASSERT(aSuite, registry.Count() == 2);
+    registry.Shutdown();
+
+    // Templates with more server clusters than there is DataVersion storage for are refused.
+    NL_TEST_ASSERT(aSuite, registry.Init(2, 2) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, registry.AddEndpoint(10, kLight) == CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(aSuite, registry.AddEndpoint(10, kSensor) == CHIP_NO_ERROR);
+}
+
+void TestBatch(nlTestSuite * aSuite, void * aContext)
+{
+    ResetEmber();
+    DynamicEndpointRegistry registry;
+    NL_TEST_ASSERT(aSuite, registry.Init(kMaxClusters, 8) == CHIP_NO_ERROR);
+
+    const DynamicEndpointRegistry::EndpointDescription endpoints[] = {
+        { 20, &kLight, kInvalidEndpointId },
+        { 21, &kSensor, 20 },
+        { 22, &kSensor, 20 },
+    };
+    NL_TEST_ASSERT(aSuite, registry.AddEndpoints(Span<const DynamicEndpointRegistry::EndpointDescription>(endpoints)) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, registry.Count() == 3);
+    // The whole batch reports the PartsList of the root and of endpoint 20 once each.
+    NL_TEST_ASSERT(aSuite, gPartsListReports == 2);
+    NL_TEST_ASSERT(aSuite, gPartsListReportsByEndpoint[kFixedEndpointId] == 1 && gPartsListReportsByEndpoint[20] == 1);
+
+    // A failing batch is rolled back completely.
+    const DynamicEndpointRegistry::EndpointDescription badEndpoints[] = {
+        { 23, &kLight, kInvalidEndpointId },
+        { 24, &kSensor, 23 },
+        { 21, &kSensor, 23 },
+    };
+    NL_TEST_ASSERT(aSuite, registry.AddEndpoints(Span<const DynamicEndpointRegistry::EndpointDescription>(badEndpoints)) ==
+                       CHIP_ERROR_DUPLICATE_KEY_ID);
+    NL_TEST_ASSERT(aSuite, registry.Count() == 3);
+    NL_TEST_ASSERT(aSuite, !registry.Contains(23) && !registry.Contains(24) && registry.Contains(21));
+
+    // Batches that cannot fit are refused up front.
+    const DynamicEndpointRegistry::EndpointDescription tooMany[] = {
+        { 30, &kSensor }, { 31, &kSensor }, { 32, &kSensor }, { 33, &kSensor }, { 34, &kSensor }, { 35, &kSensor },
+    };
+    NL_TEST_ASSERT(aSuite,
+                   registry.AddEndpoints(Span<const DynamicEndpointRegistry::EndpointDescription>(tooMany)) ==
+                       CHIP_ERROR_NO_MEMORY);
+    NL_TEST_ASSERT(aSuite, registry.Count() == 3);
+
+    ResetPartsListReports();
+    const EndpointId toRemove[] = { 21, 22, 99 };
+    NL_TEST_ASSERT(aSuite, registry.RemoveEndpoints(Span<const EndpointId>(toRemove)) == CHIP_ERROR_NOT_FOUND);
+    NL_TEST_ASSERT(aSuite, registry.Count() == 1 && registry.Contains(20));
+    NL_TEST_ASSERT(aSuite, gPartsListReports == 2);
+    NL_TEST_ASSERT(aSuite, gPartsListReportsByEndpoint[kFixedEndpointId] == 1 && gPartsListReportsByEndpoint[20] == 1);
+    NL_TEST_ASSERT(aSuite, gPartsListReportAlls == 0);
+
+    // A batch changing many PartsLists still reports each of them once.
+    constexpr EndpointId kParentCount = 12;
+    registry.Shutdown();
+    NL_TEST_ASSERT(aSuite, registry.Init(kMaxClusters, 2 * kParentCount) == CHIP_NO_ERROR);
+    ResetPartsListReports();
+    DynamicEndpointRegistry::EndpointDescription manyParents[2 * kParentCount];
+    for (EndpointId i = 0; i < kParentCount; ++i)
+    {
+        manyParents[2 * i]     = { static_cast<EndpointId>(40 + i), &kLight, kInvalidEndpointId };
+        manyParents[2 * i + 1] = { static_cast<EndpointId>(52 + i), &kSensor, static_cast<EndpointId>(40 + i) };
+    }
+    NL_TEST_ASSERT(aSuite,
+                   registry.AddEndpoints(Span<const DynamicEndpointRegistry::EndpointDescription>(manyParents)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(aSuite, gPartsListReports == kParentCount + 1 && gPartsListReportAlls == 0);
+    NL_TEST_ASSERT(aSuite, gPartsListReportsByEndpoint[kFixedEndpointId] == 1 && gPartsListReportsByEndpoint[40] == 1);
+}
+
+void TestPartsListOverflow(nlTestSuite * aSuite, void * aContext)
+{
+    ResetEmber();
+    DynamicEndpointRegistry registry;
+    NL_TEST_ASSERT(aSuite, registry.Init(kMaxClusters, 1) == CHIP_NO_ERROR);
+
+    // Every endpoint added and removed again under a different parent changes
+    // the PartsList of that parent and of the root.
+    auto changeParents = [&](size_t parentCount) {
+        for (size_t i = 0; i < parentCount; ++i)
+        {
+            NL_TEST_ASSERT(aSuite, registry.AddEndpoint(10, kSensor, static_cast<EndpointId>(100 + i)) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(aSuite, registry.RemoveEndpoint(10) == CHIP_NO_ERROR);
+        }
+    };
+
+    // As many changed PartsLists as there are endpoints are reported one by one.
+    emberAfBeginDeferredPartsListReporting();
+    changeParents(kMaxPartsListEndpoints - 1);
+    emberAfEndDeferredPartsListReporting();
+    NL_TEST_ASSERT(aSuite, gPartsListReports == kMaxPartsListEndpoints && gPartsListReportAlls == 0);
+    NL_TEST_ASSERT(aSuite, gPartsListReportsByEndpoint[kFixedEndpointId] == 1);
+
+    // One more overflows and reports every endpoint, once.
+    ResetPartsListReports();
+    emberAfBeginDeferredPartsListReporting();
+    changeParents(kMaxPartsListEndpoints);
+    emberAfEndDeferredPartsListReporting();
+    NL_TEST_ASSERT(aSuite, gPartsListReports == 0 && gPartsListReportAlls == 1);
+
+    // The next batch is tracked again.
+    emberAfBeginDeferredPartsListReporting();
+    changeParents(1);
+    emberAfEndDeferredPartsListReporting();
+    NL_TEST_ASSERT(aSuite, gPartsListReports == 2 && gPartsListReportAlls == 1);
+}
+
+void TestEndpointIndexTable(nlTestSuite * aSuite, void * aContext)
+{
+    // 32 slots: ids 32 apart share their home slot.
+    constexpr size_t kMaxEntries = 16;
+    EndpointIndexTable<kMaxEntries> table;
+    constexpr uint16_t kInvalidIndex = EndpointIndexTable<kMaxEntries>::kInvalidIndex;
+
+    NL_TEST_ASSERT(aSuite, table.Lookup(1) == kInvalidIndex);
+    table.Insert(1, 0);
+    table.Insert(33, 1);
+    table.Insert(65, 2);
+    table.Insert(2, 3);
+    NL_TEST_ASSERT(aSuite, table.Lookup(1) == 0 && table.Lookup(33) == 1 && table.Lookup(65) == 2 && table.Lookup(2) == 3);
+    NL_TEST_ASSERT(aSuite, table.Lookup(97) == kInvalidIndex);
+
+    // Removing from the middle of a probe run keeps the rest of the run reachable.
+    table.Remove(33);
+    NL_TEST_ASSERT(aSuite, table.Lookup(33) == kInvalidIndex);
+    NL_TEST_ASSERT(aSuite, table.Lookup(1) == 0 && table.Lookup(65) == 2 && table.Lookup(2) == 3);
+    table.Remove(1);
+    NL_TEST_ASSERT(aSuite, table.Lookup(65) == 2 && table.Lookup(2) == 3);
+    table.Remove(1);
+    NL_TEST_ASSERT(aSuite, table.Lookup(65) == 2 && table.Lookup(2) == 3);
+    table.Insert(33, 4);
+    NL_TEST_ASSERT(aSuite, table.Lookup(33) == 4 && table.Lookup(65) == 2);
+
+    // Random adds and removes, checked against a plain array after every step.
+    constexpr EndpointId kIdRange = 200;
+    uint16_t expected[kIdRange];
+    for (auto & index : expected)
+    {
+        index = kInvalidIndex;
+    }
+    table.Clear();
+    size_t count  = 0;
+    uint32_t seed = 1;
+    for (uint16_t step = 0; step < 2000; ++step)
+    {
+        seed          = seed * 1103515245u + 12345u;
+        EndpointId id = static_cast<EndpointId>((seed >> 16) % kIdRange);
+        if (expected[id] != kInvalidIndex)
+        {
+            table.Remove(id);
+            expected[id] = kInvalidIndex;
+            count--;
+        }
+        else if (count < kMaxEntries)
+        {
+            table.Insert(id, step);
+            expected[id] = step;
+            count++;
+        }
+
+        bool allFound = true;
+        for (EndpointId i = 0; i < kIdRange; ++i)
+        {
+            allFound = allFound && (table.Lookup(i) == expected[i]);
+        }
+        NL_TEST_ASSERT(aSuite, allFound);
+    }
+}
+
+void TestPartsListReportDeferral(nlTestSuite * aSuite, void * aContext)
+{
+    PartsListReportDeferral<2> deferral;
+    EndpointId reported[4];
+    size_t reportCount  = 0;
+    unsigned reportAlls = 0;
+    auto report         = [&](EndpointId endpoint) { reported[reportCount++] = endpoint; };
+    auto reportAll      = [&] { reportAlls++; };
+
+    // Nothing is deferred outside of Begin/End.
+    NL_TEST_ASSERT(aSuite, !deferral.Defer(1));
+    deferral.End(report, reportAll);
+    NL_TEST_ASSERT(aSuite, reportCount == 0 && reportAlls == 0);
+
+    // Nested deferrals report every changed endpoint once, at the outermost End.
+    deferral.Begin();
+    NL_TEST_ASSERT(aSuite, deferral.Defer(1));
+    deferral.Begin();
+    NL_TEST_ASSERT(aSuite, deferral.Defer(2));
+    NL_TEST_ASSERT(aSuite, deferral.Defer(1));
+    deferral.End(report, reportAll);
+    NL_TEST_ASSERT(aSuite, reportCount == 0);
+    NL_TEST_ASSERT(aSuite, deferral.Defer(2));
+    deferral.End(report, reportAll);
+    NL_TEST_ASSERT(aSuite, reportCount == 2 && reported[0] == 1 && reported[1] == 2 && reportAlls == 0);
+    NL_TEST_ASSERT(aSuite, !deferral.Defer(1));
+
+    // Too many endpoints to track: a single report of everything.
+    reportCount = 0;
+    deferral.Begin();
+    NL_TEST_ASSERT(aSuite, deferral.Defer(1) && deferral.Defer(2) && deferral.Defer(3) && deferral.Defer(4));
+    deferral.End(report, reportAll);
+    NL_TEST_ASSERT(aSuite, reportCount == 0 && reportAlls == 1);
+
+    // The overflow does not carry over to the next batch.
+    deferral.Begin();
+    NL_TEST_ASSERT(aSuite, deferral.Defer(3));
+    deferral.End(report, reportAll);
+    NL_TEST_ASSERT(aSuite, reportCount == 1 && reported[0] == 3 && reportAlls == 1);
+}
+
+void TestBenchmark(nlTestSuite * aSuite, void * aContext)
+{
+    constexpr uint16_t kEndpointCount = 2000;
+    constexpr EndpointId kFirstId     = 100;
+
+    ResetEmber();
+    DynamicEndpointRegistry registry;
+    NL_TEST_ASSERT(aSuite, registry.Init(kMaxClusters, kEndpointCount) == CHIP_NO_ERROR);
+
+    Platform::ScopedMemoryBuffer<DynamicEndpointRegistry::EndpointDescription> endpoints;
+    Platform::ScopedMemoryBuffer<EndpointId> ids;
+    NL_TEST_ASSERT(aSuite, endpoints.Calloc(kEndpointCount) && ids.Calloc(kEndpointCount));
+    for (uint16_t i = 0; i < kEndpointCount; ++i)
+    {
+        ids[i]       = static_cast<EndpointId>(kFirstId + i);
+        endpoints[i] = { ids[i], (i % 2) ? &kSensor : &kLight, kInvalidEndpointId };
+    }
+
+    uint64_t start = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (uint16_t i = 0; i < kEndpointCount; ++i)
+    {
+        NL_TEST_ASSERT(aSuite, registry.AddEndpoint(endpoints[i].id, *endpoints[i].endpointTemplate) == CHIP_NO_ERROR);
+    }
+    uint64_t addMicros = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+    NL_TEST_ASSERT(aSuite, registry.Count() == kEndpointCount);
+    NL_TEST_ASSERT(aSuite, gPartsListReports == kEndpointCount);
+
+    start = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (uint16_t i = 0; i < kEndpointCount; ++i)
+    {
+        NL_TEST_ASSERT(aSuite, registry.RemoveEndpoint(ids[kEndpointCount - 1 - i]) == CHIP_NO_ERROR);
+    }
+    uint64_t removeMicros = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+    NL_TEST_ASSERT(aSuite, registry.Count() == 0);
+
+    gPartsListReports = 0;
+    start             = System::SystemClock().GetMonotonicMicroseconds64().count();
+    NL_TEST_ASSERT(aSuite,
+                   registry.AddEndpoints(Span<const DynamicEndpointRegistry::EndpointDescription>(endpoints.Get(),
+                                                                                                  kEndpointCount)) ==
+                       CHIP_NO_ERROR);
+    uint64_t bulkAddMicros = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+    start                  = System::SystemClock().GetMonotonicMicroseconds64().count();
+    NL_TEST_ASSERT(aSuite, registry.RemoveEndpoints(Span<const EndpointId>(ids.Get(), kEndpointCount)) == CHIP_NO_ERROR);
+    uint64_t bulkRemoveMicros = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+    NL_TEST_ASSERT(aSuite, registry.Count() == 0);
+    NL_TEST_ASSERT(aSuite, gPartsListReports == 2);
+
+    ChipLogProgress(DataManagement,
+                    "%u dynamic endpoints: add %u us, remove %u us, bulk add %u us, bulk remove %u us, %u PartsList reports "
+                    "for the bulk operations",
+                    kEndpointCount, static_cast<unsigned>(addMicros), static_cast<unsigned>(removeMicros),
+                    static_cast<unsigned>(bulkAddMicros), static_cast<unsigned>(bulkRemoveMicros), gPartsListReports);
+}
+
+int Setup(void * inContext)
+{
+    return (Platform::MemoryInit() == CHIP_NO_ERROR) ? SUCCESS : FAILURE;
+}
+
+int Teardown(void * inContext)
+{
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestDynamicEndpointRegistry()
+{
+    static nlTest sTests[] = {
+        NL_TEST_DEF("TestAddRemove", TestAddRemove),
+        NL_TEST_DEF("TestAddErrors", TestAddErrors),
+        NL_TEST_DEF("TestBatch", TestBatch),
+        NL_TEST_DEF("TestPartsListOverflow", TestPartsListOverflow),
+        NL_TEST_DEF("TestEndpointIndexTable", TestEndpointIndexTable),
+        NL_TEST_DEF("TestPartsListReportDeferral", TestPartsListReportDeferral),
+        NL_TEST_DEF("TestBenchmark", TestBenchmark),
+        NL_TEST_SENTINEL(),
+    };
+
+    nlTestSuite theSuite = {
+        "DynamicEndpointRegistry",
+        &sTests[0],
+        Setup,
+        Teardown,
+    };
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestDynamicEndpointRegistry)
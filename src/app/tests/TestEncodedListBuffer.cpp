@@ -0,0 +1,371 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/AttributeAccessInterface.h>
+#include <app/MessageDef/AttributeDataIB.h>
+#include <app/MessageDef/AttributeReportIB.h>
+#include <app/reporting/EncodedListBuffer.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+
+#include <nlunit-test.h>
+
+#include <inttypes.h>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::reporting;
+
+namespace {
+
+using AttributeEncodeState = AttributeValueEncoder::AttributeEncodeState;
+
+const ConcreteAttributePath kPath(1, 0x0000001F, 0x00000000);
+constexpr DataVersion kDataVersion = 0x42;
+// About what is left of an IPv6 MTU for attribute reports once the headers are written
+constexpr size_t kChunkSize = 1024;
+
+bool IsOutOfWriterSpaceError(CHIP_ERROR err)
+{
+    return err == CHIP_ERROR_NO_MEMORY || err == CHIP_ERROR_BUFFER_TOO_SMALL;
+}
+
+// A list attribute of uint32 items 0..mSize-1, counting how many items it is asked for
+class ListSource
+{
+public:
+    explicit ListSource(uint32_t size) : mSize(size) {}
+
+    CHIP_ERROR Read(AttributeReportIBs::Builder & aBuilder, AttributeEncodeState & aState)
+    {
+        AttributeValueEncoder encoder(aBuilder, kUndefinedFabricIndex, kPath, kDataVersion, false, aState);
+        CHIP_ERROR err = encoder.EncodeList([this](const auto & listEncoder) -> CHIP_ERROR {
+            for (uint32_t i = 0; i < mSize; i++)
+            {
+                mVisits++;
+                ReturnErrorOnFailure(listEncoder.Encode(i));
+            }
+            return CHIP_NO_ERROR;
+        });
+        aState = encoder.GetState();
+        return err;
+    }
+
+    uint32_t mSize;
+    uint32_t mVisits = 0;
+};
+
+struct Chunk
+{
+    Chunk(nlTestSuite * apSuite, size_t size = kChunkSize)
+    {
+        writer.Init(buf, size);
+        NL_TEST_ASSERT(apSuite, builder.Init(&writer) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, writer.ReserveBuffer(1) == CHIP_NO_ERROR);
+    }
+
+    void Close(nlTestSuite * apSuite)
+    {
+        NL_TEST_ASSERT(apSuite, writer.UnreserveBuffer(1) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, builder.EndOfAttributeReportIBs() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, writer.Finalize() == CHIP_NO_ERROR);
+    }
+
+    uint8_t buf[kChunkSize];
+    TLV::TLVWriter writer;
+    AttributeReportIBs::Builder builder;
+};
+
+// Appends the list items reported in a closed chunk to aItems, the way a client would reassemble the list
+void CollectItems(nlTestSuite * apSuite, Chunk & aChunk, uint32_t * aItems, size_t aMaxItems, size_t & aCount)
+{
+    TLV::TLVReader reader;
+    TLV::TLVType arrayType;
+    reader.Init(aChunk.buf, aChunk.writer.GetLengthWritten());
+    NL_TEST_ASSERT(apSuite, reader.Next(TLV::kTLVType_Array, TLV::AnonymousTag()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, reader.EnterContainer(arrayType) == CHIP_NO_ERROR);
+
+    while (reader.Next() == CHIP_NO_ERROR)
+    {
+        AttributeReportIB::Parser report;
+        AttributeDataIB::Parser data;
+        TLV::TLVReader dataReader;
+        uint32_t item;
+        NL_TEST_ASSERT(apSuite, report.Init(reader) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, report.GetAttributeData(&data) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, data.GetData(&dataReader) == CHIP_NO_ERROR);
+
+        if (dataReader.GetType() != TLV::kTLVType_Array)
+        {
+            NL_TEST_ASSERT(apSuite, dataReader.Get(item) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(apSuite, aCount < aMaxItems);
+            VerifyOrReturn(aCount < aMaxItems);
+            aItems[aCount++] = item;
+            continue;
+        }
+
+        TLV::TLVType listType;
+        NL_TEST_ASSERT(apSuite, dataReader.EnterContainer(listType) == CHIP_NO_ERROR);
+        while (dataReader.Next() == CHIP_NO_ERROR)
+        {
+            NL_TEST_ASSERT(apSuite, dataReader.Get(item) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(apSuite, aCount < aMaxItems);
+            VerifyOrReturn(aCount < aMaxItems);
+            aItems[aCount++] = item;
+        }
+    }
+}
+
+// Reports the next chunk of the list the way Engine::BuildSingleReportDataAttributeReportIBs does, with or without a buffer
+CHIP_ERROR ReportChunk(ListSource & aSource, EncodedListBuffer * apListBuffer, AttributeEncodeState & aState, Chunk & aChunk,
+                       bool & aDone)
+{
+    auto fillFunction = [&aSource](AttributeReportIBs::Builder & aBuilder, AttributeEncodeState & aFillState) {
+        return aSource.Read(aBuilder, aFillState);
+    };
+
+    aDone = false;
+
+    while (apListBuffer != nullptr && apListBuffer->Holds(kPath))
+    {
+        CHIP_ERROR err = apListBuffer->Drain(aChunk.builder);
+        if (err != CHIP_NO_ERROR)
+        {
+            return IsOutOfWriterSpaceError(err) ? CHIP_NO_ERROR : err;
+        }
+
+        if (apListBuffer->IsComplete())
+        {
+            apListBuffer->Clear();
+            aState = AttributeEncodeState();
+            aDone  = true;
+            return CHIP_NO_ERROR;
+        }
+
+        aState = apListBuffer->GetNextEncodeState();
+        (void) apListBuffer->Fill(kPath, aState, fillFunction);
+    }
+
+    AttributeEncodeState encodeState = aState;
+    CHIP_ERROR err                   = aSource.Read(aChunk.builder, encodeState);
+    if (err == CHIP_NO_ERROR)
+    {
+        aState = AttributeEncodeState();
+        aDone  = true;
+        return CHIP_NO_ERROR;
+    }
+    VerifyOrReturnError(IsOutOfWriterSpaceError(err) && encodeState.AllowPartialData(), err);
+
+    aState = encodeState;
+    if (apListBuffer != nullptr)
+    {
+        (void) apListBuffer->Fill(kPath, aState, fillFunction);
+    }
+    return CHIP_NO_ERROR;
+}
+
+struct ReportResult
+{
+    size_t mChunks         = 0;
+    size_t mItemCount      = 0;
+    uint64_t mMicroseconds = 0;
+};
+
+void ReportList(nlTestSuite * apSuite, ListSource & aSource, EncodedListBuffer * apListBuffer, uint32_t * aItems, size_t aMaxItems,
+                ReportResult & aResult)
+{
+    AttributeEncodeState state;
+    bool done = false;
+
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    while (!done && aResult.mChunks < aMaxItems)
+    {
+        Chunk chunk(apSuite);
+        NL_TEST_ASSERT(apSuite, ReportChunk(aSource, apListBuffer, state, chunk, done) == CHIP_NO_ERROR);
+        chunk.Close(apSuite);
+        aResult.mChunks++;
+        CollectItems(apSuite, chunk, aItems, aMaxItems, aResult.mItemCount);
+    }
+    aResult.mMicroseconds = (System::SystemClock().GetMonotonicMicroseconds64() - start).count();
+    NL_TEST_ASSERT(apSuite, done);
+}
+
+void VerifyItems(nlTestSuite * apSuite, const uint32_t * aItems, size_t aCount, uint32_t aExpectedCount)
+{
+    NL_TEST_ASSERT(apSuite, aCount == aExpectedCount);
+    for (uint32_t i = 0; i < aCount; i++)
+    {
+        NL_TEST_ASSERT(apSuite, aItems[i] == i);
+    }
+}
+
+void TestDrainAcrossChunks(nlTestSuite * apSuite, void * apContext)
+{
+    ListSource source(100);
+    EncodedListBuffer listBuffer;
+    uint32_t items[100];
+    size_t count = 0;
+
+    // The first chunk takes as many items as fit, the buffer takes the rest of the list
+    Chunk first(apSuite, 128);
+    AttributeEncodeState state;
+    CHIP_ERROR err = source.Read(first.builder, state);
+    NL_TEST_ASSERT(apSuite, IsOutOfWriterSpaceError(err) && state.AllowPartialData());
+    NL_TEST_ASSERT(apSuite,
+                   listBuffer.Fill(kPath, state, [&source](AttributeReportIBs::Builder & aBuilder, AttributeEncodeState & aState) {
+                       return source.Read(aBuilder, aState);
+                   }) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, listBuffer.Holds(kPath));
+    NL_TEST_ASSERT(apSuite, !listBuffer.Holds(ConcreteAttributePath(1, 0x0000001F, 0x00000001)));
+    NL_TEST_ASSERT(apSuite, listBuffer.IsComplete());
+    first.Close(apSuite);
+    CollectItems(apSuite, first, items, 100, count);
+
+    // Later chunks copy the buffered items without reading the list
+    uint32_t visits = source.mVisits;
+    size_t chunks   = 0;
+    while (listBuffer.Holds(kPath))
+    {
+        Chunk chunk(apSuite, 128);
+        err = listBuffer.Drain(chunk.builder);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR || IsOutOfWriterSpaceError(err));
+        chunk.Close(apSuite);
+        CollectItems(apSuite, chunk, items, 100, count);
+        chunks++;
+    }
+    NL_TEST_ASSERT(apSuite, chunks > 1);
+    NL_TEST_ASSERT(apSuite, source.mVisits == visits);
+    VerifyItems(apSuite, items, count, 100);
+}
+
+void TestWindowRefill(nlTestSuite * apSuite, void * apContext)
+{
+    // Enough items that the rest of the list does not fit in the buffer
+    constexpr uint32_t kListSize = static_cast<uint32_t>(EncodedListBuffer::kBufferSize / 8);
+    ListSource source(kListSize);
+    EncodedListBuffer listBuffer;
+    uint32_t items[kListSize];
+    ReportResult result;
+
+    ReportList(apSuite, source, &listBuffer, items, kListSize, result);
+    VerifyItems(apSuite, items, result.mItemCount, kListSize);
+    NL_TEST_ASSERT(apSuite, !listBuffer.Holds(kPath));
+}
+
+uint8_t sLargeItem[EncodedListBuffer::kBufferSize];
+
+void TestItemLargerThanBuffer(nlTestSuite * apSuite, void * apContext)
+{
+    auto readList = [](AttributeReportIBs::Builder & aBuilder, AttributeEncodeState & aState) -> CHIP_ERROR {
+        AttributeValueEncoder encoder(aBuilder, kUndefinedFabricIndex, kPath, kDataVersion, false, aState);
+        CHIP_ERROR err = encoder.EncodeList([](const auto & listEncoder) -> CHIP_ERROR {
+            ReturnErrorOnFailure(listEncoder.Encode(ByteSpan(sLargeItem, 1)));
+            return listEncoder.Encode(ByteSpan(sLargeItem));
+        });
+        aState = encoder.GetState();
+        return err;
+    };
+
+    // The first chunk only takes the small item
+    Chunk first(apSuite, 64);
+    AttributeEncodeState state;
+    CHIP_ERROR err = readList(first.builder, state);
+    NL_TEST_ASSERT(apSuite, IsOutOfWriterSpaceError(err) && state.AllowPartialData());
+
+    // The large item does not fit in the buffer either, the list has to be read again for the next chunk
+    EncodedListBuffer listBuffer;
+    err = listBuffer.Fill(kPath, state, readList);
+    NL_TEST_ASSERT(apSuite, err == CHIP_ERROR_BUFFER_TOO_SMALL);
+    NL_TEST_ASSERT(apSuite, !listBuffer.Holds(kPath));
+}
+
+void TestLargeListBenchmark(nlTestSuite * apSuite, void * apContext)
+{
+    constexpr uint32_t kListSize = 2000;
+    static uint32_t sItems[kListSize];
+
+    ListSource reencodeSource(kListSize);
+    ReportResult reencode;
+    ReportList(apSuite, reencodeSource, nullptr, sItems, kListSize, reencode);
+    VerifyItems(apSuite, sItems, reencode.mItemCount, kListSize);
+
+    ListSource bufferedSource(kListSize);
+    EncodedListBuffer listBuffer;
+    ReportResult buffered;
+    ReportList(apSuite, bufferedSource, &listBuffer, sItems, kListSize, buffered);
+    VerifyItems(apSuite, sItems, buffered.mItemCount, kListSize);
+
+    ChipLogProgress(Test, "List of %" PRIu32 " items in %u chunks of %u bytes:", kListSize, static_cast<unsigned>(reencode.mChunks),
+                    static_cast<unsigned>(kChunkSize));
+    ChipLogProgress(Test, "  re-encoding each chunk: %" PRIu32 " item visits, %u us", reencodeSource.mVisits,
+                    static_cast<unsigned>(reencode.mMicroseconds));
+    ChipLogProgress(Test, "  encoded list buffer:    %" PRIu32 " item visits, %u us", bufferedSource.mVisits,
+                    static_cast<unsigned>(buffered.mMicroseconds));
+
+    // The same chunks are sent, the buffer only changes how they are produced
+    NL_TEST_ASSERT(apSuite, buffered.mChunks == reencode.mChunks);
+    // Re-encoding visits the skipped items again for each chunk, the buffer only revisits them once per buffer refill
+    NL_TEST_ASSERT(apSuite, bufferedSource.mVisits * 3 < reencodeSource.mVisits);
+}
+
+int Initialize(void * apSuite)
+{
+    VerifyOrReturnError(Platform::MemoryInit() == CHIP_NO_ERROR, FAILURE);
+    return SUCCESS;
+}
+
+int Finalize(void * apSuite)
+{
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestDrainAcrossChunks", TestDrainAcrossChunks),
+    NL_TEST_DEF("TestWindowRefill", TestWindowRefill),
+    NL_TEST_DEF("TestItemLargerThanBuffer", TestItemLargerThanBuffer),
+    NL_TEST_DEF("TestLargeListBenchmark", TestLargeListBenchmark),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestEncodedListBuffer()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "EncodedListBuffer",
+        &sTests[0],
+        Initialize,
+        Finalize
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestEncodedListBuffer)
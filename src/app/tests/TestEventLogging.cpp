@@ -39,6 +39,7 @@
 #include <lib/support/EnforceFormat.h>
 #include <lib/support/UnitTestContext.h>
 #include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
 #include <lib/support/logging/Constants.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/Flags.h>
@@ -47,6 +48,10 @@
 
 #include <nlunit-test.h>
 
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <pthread.h>
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
 namespace {
 
 static const chip::ClusterId kLivenessClusterId   = 0x00000022;
@@ -60,6 +65,9 @@ static uint8_t gInfoEventBuffer[120];
 static uint8_t gCritEventBuffer[120];
 static chip::app::CircularEventBuffer gCircularEventBuffer[3];
 
+// Large enough for each buffer to hold more events than CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE.
+static uint8_t gLargeEventBuffers[3][2048];
+
 class TestContext : public chip::Test::AppContext
 {
 public:
@@ -311,9 +319,228 @@ static void CheckLogEventWithDiscardLowEvent(nlTestSuite * apSuite, void * apCon
     CheckLogState(apSuite, logMgmt, 3, chip::app::PriorityLevel::Debug);
 }
 
+void UseLargeEventBuffers(TestContext & aContext, chip::MonotonicallyIncreasingCounter<chip::EventNumber> & aEventCounter)
+{
+    const chip::app::LogStorageResources logStorageResources[] = {
+        { &gLargeEventBuffers[0][0], sizeof(gLargeEventBuffers[0]), chip::app::PriorityLevel::Debug },
+        { &gLargeEventBuffers[1][0], sizeof(gLargeEventBuffers[1]), chip::app::PriorityLevel::Info },
+        { &gLargeEventBuffers[2][0], sizeof(gLargeEventBuffers[2]), chip::app::PriorityLevel::Critical },
+    };
+
+    chip::app::EventManagement::DestroyEventManagement();
+    VerifyOrDie(aEventCounter.Init(0) == CHIP_NO_ERROR);
+    chip::app::EventManagement::CreateEventManagement(&aContext.GetExchangeManager(), ArraySize(logStorageResources),
+                                                      gCircularEventBuffer, logStorageResources, &aEventCounter);
+}
+
+chip::app::PriorityLevel PriorityOfEvent(uint32_t aIndex)
+{
+    // Mostly debug events, with info and critical events in between that get moved to the next buffers.
+    switch (aIndex % 5)
+    {
+    case 1:
+        return chip::app::PriorityLevel::Info;
+    case 3:
+        return chip::app::PriorityLevel::Critical;
+    default:
+        return chip::app::PriorityLevel::Debug;
+    }
+}
+
+void ENFORCE_FORMAT(3, 0) DropLogs(const char * module, uint8_t category, const char * msg, va_list args) {}
+
+static void CheckLogEventWithFullEvictionIndex(nlTestSuite * apSuite, void * apContext)
+{
+    chip::MonotonicallyIncreasingCounter<chip::EventNumber> eventCounter;
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    TestEventGenerator testEventGenerator;
+    chip::app::EventOptions options;
+    chip::EventNumber eid          = 0;
+    constexpr uint32_t kEventCount = 1000;
+
+    UseLargeEventBuffers(*static_cast<TestContext *>(apContext), eventCounter);
+
+    // Each buffer holds more events than its eviction index covers, so the events that did not fit are parsed into the index as
+    // the indexed ones get evicted.
+    chip::Logging::SetLogRedirectCallback(DropLogs);
+    for (uint32_t i = 0; i < kEventCount; i++)
+    {
+        options.mPath     = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+        options.mPriority = PriorityOfEvent(i);
+        testEventGenerator.SetStatus(static_cast<int32_t>(i));
+        NL_TEST_ASSERT(apSuite, logMgmt.LogEvent(&testEventGenerator, options, eid) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, eid == i);
+    }
+    chip::Logging::SetLogRedirectCallback(nullptr);
+
+    // The log is still made of whole events, every buffer is nearly full, and the most recent event is there.
+    chip::TLV::TLVReader reader;
+    size_t elementCount = 0;
+    chip::app::CircularEventBufferWrapper bufWrapper;
+    NL_TEST_ASSERT(apSuite, logMgmt.GetEventReader(reader, chip::app::PriorityLevel::Critical, &bufWrapper) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, chip::TLV::Utilities::Count(reader, elementCount, false) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, elementCount > 3 * CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE);
+    for (auto & buffer : gCircularEventBuffer)
+    {
+        NL_TEST_ASSERT(apSuite, buffer.AvailableDataLength() < chip::app::kMaxEventSizeReserve);
+    }
+
+    chip::app::ObjectList<chip::app::EventPathParams> path;
+    CheckLogReadOut(apSuite, logMgmt, kEventCount - 1, 1, &path);
+}
+
+#if CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+constexpr uint32_t kStagingThreadCount = 4;
+
+void * StageEventsFromThread(void * apContext)
+{
+    TestEventGenerator testEventGenerator;
+    chip::app::EventOptions options;
+    options.mPath     = { kTestEndpointId2, kLivenessClusterId, kLivenessChangeEvent };
+    options.mPriority = chip::app::PriorityLevel::Critical;
+
+    for (uint32_t i = 0; i < CHIP_CONFIG_EVENT_STAGING_RING_SIZE / kStagingThreadCount; i++)
+    {
+        testEventGenerator.SetStatus(static_cast<int32_t>(i));
+        if (chip::app::EventManagement::GetInstance().StageEvent(&testEventGenerator, options) != CHIP_NO_ERROR)
+        {
+            return apContext;
+        }
+    }
+    return nullptr;
+}
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+static void CheckStageEvents(nlTestSuite * apSuite, void * apContext)
+{
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    TestEventGenerator testEventGenerator;
+    chip::app::EventOptions options;
+    chip::EventNumber eid;
+    chip::EventNumber startingEventNumber = logMgmt.GetLastEventNumber();
+
+    options.mPath     = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+    options.mPriority = chip::app::PriorityLevel::Debug;
+
+    // Staged events get their event number when they are merged into the log.
+    testEventGenerator.SetStatus(0);
+    NL_TEST_ASSERT(apSuite, logMgmt.StageEvent(&testEventGenerator, options) == CHIP_NO_ERROR);
+    testEventGenerator.SetStatus(1);
+    NL_TEST_ASSERT(apSuite, logMgmt.StageEvent(&testEventGenerator, options) == CHIP_NO_ERROR);
+    CheckLogState(apSuite, logMgmt, 0, chip::app::PriorityLevel::Debug);
+    NL_TEST_ASSERT(apSuite, logMgmt.GetLastEventNumber() == startingEventNumber);
+
+    logMgmt.MergeStagedEvents();
+    CheckLogState(apSuite, logMgmt, 2, chip::app::PriorityLevel::Debug);
+    NL_TEST_ASSERT(apSuite, logMgmt.GetLastEventNumber() == startingEventNumber + 2);
+
+    // Events logged on the CHIP thread come after the events staged before them.
+    NL_TEST_ASSERT(apSuite, logMgmt.StageEvent(&testEventGenerator, options) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, logMgmt.LogEvent(&testEventGenerator, options, eid) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, eid == startingEventNumber + 3);
+    CheckLogState(apSuite, logMgmt, 3, chip::app::PriorityLevel::Debug);
+
+    // A full staging ring rejects events until it is merged, while the rings of other priorities still have room.
+    options.mPriority = chip::app::PriorityLevel::Info;
+    for (uint32_t i = 0; i < CHIP_CONFIG_EVENT_STAGING_RING_SIZE; i++)
+    {
+        NL_TEST_ASSERT(apSuite, logMgmt.StageEvent(&testEventGenerator, options) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(apSuite, logMgmt.StageEvent(&testEventGenerator, options) == CHIP_ERROR_NO_MEMORY);
+    options.mPriority = chip::app::PriorityLevel::Critical;
+    NL_TEST_ASSERT(apSuite, logMgmt.StageEvent(&testEventGenerator, options) == CHIP_NO_ERROR);
+
+    logMgmt.MergeStagedEvents();
+    NL_TEST_ASSERT(apSuite, logMgmt.GetLastEventNumber() == startingEventNumber + 4 + CHIP_CONFIG_EVENT_STAGING_RING_SIZE + 1);
+    options.mPriority = chip::app::PriorityLevel::Info;
+    NL_TEST_ASSERT(apSuite, logMgmt.StageEvent(&testEventGenerator, options) == CHIP_NO_ERROR);
+    logMgmt.MergeStagedEvents();
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    // Several threads can stage events at the same time.
+    startingEventNumber = logMgmt.GetLastEventNumber();
+    pthread_t threads[kStagingThreadCount];
+    for (auto & thread : threads)
+    {
+        NL_TEST_ASSERT(apSuite, pthread_create(&thread, nullptr, StageEventsFromThread, apSuite) == 0);
+    }
+    for (auto & thread : threads)
+    {
+        void * result = apSuite;
+        NL_TEST_ASSERT(apSuite, pthread_join(thread, &result) == 0);
+        NL_TEST_ASSERT(apSuite, result == nullptr);
+    }
+
+    logMgmt.MergeStagedEvents();
+    NL_TEST_ASSERT(apSuite, logMgmt.GetLastEventNumber() == startingEventNumber + CHIP_CONFIG_EVENT_STAGING_RING_SIZE);
+
+    chip::app::ObjectList<chip::app::EventPathParams> path;
+    path.mValue.mEndpointId = kTestEndpointId2;
+    CheckLogReadOut(apSuite, logMgmt, logMgmt.GetLastEventNumber() - 3, 3, &path);
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+}
+#endif // CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+
+static void CheckLogEventBenchmark(nlTestSuite * apSuite, void * apContext)
+{
+    chip::MonotonicallyIncreasingCounter<chip::EventNumber> eventCounter;
+    chip::app::EventManagement & logMgmt = chip::app::EventManagement::GetInstance();
+    TestEventGenerator testEventGenerator;
+    chip::app::EventOptions options;
+    chip::EventNumber eid;
+    constexpr uint32_t kEventCount = 20000;
+
+    UseLargeEventBuffers(*static_cast<TestContext *>(apContext), eventCounter);
+    options.mPath = { kTestEndpointId1, kLivenessClusterId, kLivenessChangeEvent };
+
+    // Keep logging out of the measurements.
+    chip::Logging::SetLogRedirectCallback(DropLogs);
+
+    uint64_t startMicros = chip::System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (uint32_t i = 0; i < kEventCount; i++)
+    {
+        options.mPriority = PriorityOfEvent(i);
+        testEventGenerator.SetStatus(static_cast<int32_t>(i));
+        NL_TEST_ASSERT(apSuite, logMgmt.LogEvent(&testEventGenerator, options, eid) == CHIP_NO_ERROR);
+    }
+    uint64_t logMicros = chip::System::SystemClock().GetMonotonicMicroseconds64().count() - startMicros;
+
+#if CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+    startMicros = chip::System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (uint32_t i = 0; i < kEventCount; i++)
+    {
+        options.mPriority = PriorityOfEvent(i);
+        testEventGenerator.SetStatus(static_cast<int32_t>(i));
+        if (logMgmt.StageEvent(&testEventGenerator, options) == CHIP_ERROR_NO_MEMORY)
+        {
+            logMgmt.MergeStagedEvents();
+            NL_TEST_ASSERT(apSuite, logMgmt.StageEvent(&testEventGenerator, options) == CHIP_NO_ERROR);
+        }
+    }
+    logMgmt.MergeStagedEvents();
+    uint64_t stageMicros = chip::System::SystemClock().GetMonotonicMicroseconds64().count() - startMicros;
+    NL_TEST_ASSERT(apSuite, logMgmt.GetLastEventNumber() == 2 * kEventCount);
+#endif // CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+
+    chip::Logging::SetLogRedirectCallback(nullptr);
+
+    ChipLogProgress(EventLogging, "LogEvent: %u events in %u us, %u events/s", static_cast<unsigned>(kEventCount),
+                    static_cast<unsigned>(logMicros), static_cast<unsigned>(kEventCount * 1000000ull / (logMicros + 1)));
+#if CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+    ChipLogProgress(EventLogging, "StageEvent and merge: %u events in %u us, %u events/s", static_cast<unsigned>(kEventCount),
+                    static_cast<unsigned>(stageMicros), static_cast<unsigned>(kEventCount * 1000000ull / (stageMicros + 1)));
+#endif // CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+}
+
 const nlTest sTests[] = {
     NL_TEST_DEF("CheckLogEventWithEvictToNextBuffer", CheckLogEventWithEvictToNextBuffer),
     NL_TEST_DEF("CheckLogEventWithDiscardLowEvent", CheckLogEventWithDiscardLowEvent),
+    NL_TEST_DEF("CheckLogEventWithFullEvictionIndex", CheckLogEventWithFullEvictionIndex),
+#if CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+    NL_TEST_DEF("CheckStageEvents", CheckStageEvents),
+#endif // CHIP_CONFIG_EVENT_STAGING_RING_SIZE > 0
+    NL_TEST_DEF("CheckLogEventBenchmark", CheckLogEventBenchmark),
     NL_TEST_SENTINEL(),
 };
 
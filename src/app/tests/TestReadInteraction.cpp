@@ -69,6 +69,13 @@ chip::DataVersion kTestDataVersion2     = 5;
 // Number of items in the list for MockAttributeId(4).
 constexpr int kMockAttribute4ListLength = 6;
 
+// List attribute of kTestClusterId on kTestEndpointId, long enough to be reported over several chunks.  Its items are
+// gTestListBase + index, and gTestListItemsVisited counts the items the data model encodes or skips.
+constexpr chip::AttributeId kTestListAttributeId = 0x0010;
+constexpr uint32_t kTestListLength              = 500;
+static uint32_t gTestListBase                   = 0;
+static size_t gTestListItemsVisited             = 0;
+
 static chip::System::Clock::Internal::MockClock gMockClock;
 static chip::System::Clock::ClockBase * gRealClock;
 static chip::app::reporting::ReportSchedulerImpl * gReportScheduler;
@@ -326,6 +333,28 @@ CHIP_ERROR ReadSingleClusterData(const Access::SubjectDescriptor & aSubjectDescr
         return attributeReport.EndOfAttributeReportIB();
     }
 
+    if (aPath.mAttributeId == kTestListAttributeId)
+    {
+        AttributeValueEncoder::AttributeEncodeState state =
+            (apEncoderState == nullptr ? AttributeValueEncoder::AttributeEncodeState() : *apEncoderState);
+        AttributeValueEncoder valueEncoder(aAttributeReports, 0, aPath, 0, false, state);
+
+        CHIP_ERROR err = valueEncoder.EncodeList([](const auto & encoder) -> CHIP_ERROR {
+            for (uint32_t i = 0; i < kTestListLength; i++)
+            {
+                gTestListItemsVisited++;
+                ReturnErrorOnFailure(encoder.Encode(gTestListBase + i));
+            }
+            return CHIP_NO_ERROR;
+        });
+
+        if (apEncoderState != nullptr)
+        {
+            *apEncoderState = valueEncoder.GetState();
+        }
+        return err;
+    }
+
     return AttributeValueEncoder(aAttributeReports, 0, aPath, 0).Encode(kTestFieldValue1);
 }
 
@@ -361,6 +390,7 @@ public:
     static void TestReadClientInvalidAttributeId(nlTestSuite * apSuite, void * apContext);
     static void TestReadHandlerInvalidAttributePath(nlTestSuite * apSuite, void * apContext);
     static void TestProcessSubscribeRequest(nlTestSuite * apSuite, void * apContext);
+    static void TestProcessSubscribeRequestSharesPaths(nlTestSuite * apSuite, void * apContext);
 #if CHIP_CONFIG_ENABLE_ICD_SERVER
     static void TestICDProcessSubscribeRequestSupMaxIntervalCeiling(nlTestSuite * apSuite, void * apContext);
     static void TestICDProcessSubscribeRequestInfMaxIntervalCeiling(nlTestSuite * apSuite, void * apContext);
@@ -377,6 +407,7 @@ public:
     static void TestReadWildcard(nlTestSuite * apSuite, void * apContext);
     static void TestReadChunking(nlTestSuite * apSuite, void * apContext);
     static void TestSetDirtyBetweenChunks(nlTestSuite * apSuite, void * apContext);
+    static void TestReadChunkedListReassembly(nlTestSuite * apSuite, void * apContext);
     static void TestSubscribeRoundtrip(nlTestSuite * apSuite, void * apContext);
     static void TestSubscribeEarlyReport(nlTestSuite * apSuite, void * apContext);
     static void TestSubscribeUrgentWildcardEvent(nlTestSuite * apSuite, void * apContext);
@@ -1479,6 +1510,151 @@ void TestReadInteraction::TestSetDirtyBetweenChunks(nlTestSuite * apSuite, void
     NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
 }
 
+// TestReadChunkedListReassembly reads a list that spans several chunks, whose items after the first chunk the reporting
+// engine copies from its encoded list buffer instead of reading the attribute again, and checks that the client gets
+// every item in order.  A dirty mark between two chunks must restart the list with the new value.
+void TestReadInteraction::TestReadChunkedListReassembly(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = CHIP_NO_ERROR;
+
+    Messaging::ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+    // Shouldn't have anything in the retransmit table when starting the test.
+    NL_TEST_ASSERT(apSuite, rm->TestGetCountRetransTable() == 0);
+
+    auto * engine = chip::app::InteractionModelEngine::GetInstance();
+    err           = engine->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(), gReportScheduler);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+    chip::app::AttributePathParams attributePathParams[1];
+    attributePathParams[0].mEndpointId  = kTestEndpointId;
+    attributePathParams[0].mClusterId   = kTestClusterId;
+    attributePathParams[0].mAttributeId = kTestListAttributeId;
+
+    ReadPrepareParams readPrepareParams(ctx.GetSessionBobToAlice());
+    readPrepareParams.mpAttributePathParamsList    = attributePathParams;
+    readPrepareParams.mAttributePathParamsListSize = 1;
+
+    // Base of the items the list holds once it has been marked dirty.
+    static constexpr uint32_t kNewListBase = 1000;
+
+    // Rebuilds the list from the initial list and the appended items, and marks the list dirty, with new items, once
+    // aDirtyAfterItems items have been received.
+    class ListDelegate : public MockInteractionModelApp
+    {
+    public:
+        ListDelegate(size_t aDirtyAfterItems) : mDirtyAfterItems(aDirtyAfterItems) {}
+
+        void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & status) override
+        {
+            if (status.mStatus != Protocols::InteractionModel::Status::Success || aPath.mAttributeId != kTestListAttributeId)
+            {
+                MockInteractionModelApp::OnAttributeData(aPath, apData, status);
+                return;
+            }
+
+            // The base class moves the reader into the list to count its items, so read from a copy.
+            TLV::TLVReader reader;
+            reader.Init(*apData);
+            MockInteractionModelApp::OnAttributeData(aPath, apData, status);
+
+            uint32_t item;
+            if (!aPath.IsListItemOperation())
+            {
+                TLV::TLVType containerType;
+                mNumListStarts++;
+                mItems.clear();
+                if (reader.EnterContainer(containerType) != CHIP_NO_ERROR)
+                {
+                    return;
+                }
+                while (reader.Next() == CHIP_NO_ERROR && reader.Get(item) == CHIP_NO_ERROR)
+                {
+                    mItems.push_back(item);
+                }
+            }
+            else if (reader.Get(item) == CHIP_NO_ERROR)
+            {
+                mItems.push_back(item);
+            }
+
+            if (!mDidSetDirty && mDirtyAfterItems > 0 && mItems.size() >= mDirtyAfterItems)
+            {
+                mDidSetDirty  = true;
+                gTestListBase = kNewListBase;
+                AttributePathParams dirtyPath(kTestEndpointId, kTestClusterId, kTestListAttributeId);
+                InteractionModelEngine::GetInstance()->GetReportingEngine().SetDirty(dirtyPath);
+            }
+        }
+
+        const size_t mDirtyAfterItems;
+        bool mDidSetDirty = false;
+        int mNumListStarts = 0;
+        std::vector<uint32_t> mItems;
+    };
+
+    auto itemsAre = [](const std::vector<uint32_t> & aItems, uint32_t aBase) {
+        if (aItems.size() != kTestListLength)
+        {
+            return false;
+        }
+        for (uint32_t i = 0; i < kTestListLength; i++)
+        {
+            if (aItems[i] != aBase + i)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    {
+        gTestListBase         = 0;
+        gTestListItemsVisited = 0;
+        ListDelegate delegate(0);
+        app::ReadClient readClient(engine, &ctx.GetExchangeManager(), delegate, chip::app::ReadClient::InteractionType::Read);
+
+        err = readClient.SendRequest(readPrepareParams);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+        ctx.DrainAndServiceIO();
+
+        NL_TEST_ASSERT(apSuite, !delegate.mReadError);
+        NL_TEST_ASSERT(apSuite, delegate.mNumListStarts == 1);
+        // The list did not fit in one report: most items came as appended items.
+        NL_TEST_ASSERT(apSuite, delegate.mNumAttributeResponse > 1);
+        NL_TEST_ASSERT(apSuite, itemsAre(delegate.mItems, 0));
+#if CHIP_IM_SERVER_ENCODED_LIST_BUFFER_SIZE > 0
+        // Reading the list again for every chunk would visit the first items once per chunk.
+        NL_TEST_ASSERT(apSuite, gTestListItemsVisited < 2 * kTestListLength);
+#endif
+        NL_TEST_ASSERT(apSuite, rm->TestGetCountRetransTable() == 0);
+    }
+
+    {
+        gTestListBase = 0;
+        ListDelegate delegate(kTestListLength / 2);
+        app::ReadClient readClient(engine, &ctx.GetExchangeManager(), delegate, chip::app::ReadClient::InteractionType::Read);
+
+        err = readClient.SendRequest(readPrepareParams);
+        NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+
+        ctx.DrainAndServiceIO();
+
+        // The items already sent are not reported again from the buffer: the list starts over with the new items.
+        NL_TEST_ASSERT(apSuite, !delegate.mReadError);
+        NL_TEST_ASSERT(apSuite, delegate.mDidSetDirty);
+        NL_TEST_ASSERT(apSuite, delegate.mNumListStarts == 2);
+        NL_TEST_ASSERT(apSuite, itemsAre(delegate.mItems, kNewListBase));
+        NL_TEST_ASSERT(apSuite, rm->TestGetCountRetransTable() == 0);
+    }
+
+    gTestListBase = 0;
+    NL_TEST_ASSERT(apSuite, engine->GetNumActiveReadClients() == 0);
+    engine->Shutdown();
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
 void TestReadInteraction::TestReadInvalidAttributePathRoundtrip(nlTestSuite * apSuite, void * apContext)
 {
     TestContext & ctx = *static_cast<TestContext *>(apContext);
@@ -1583,6 +1759,71 @@ void TestReadInteraction::TestProcessSubscribeRequest(nlTestSuite * apSuite, voi
     NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
 }
 
+void TestReadInteraction::TestProcessSubscribeRequestSharesPaths(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    auto * engine     = chip::app::InteractionModelEngine::GetInstance();
+    NL_TEST_ASSERT(apSuite, engine->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(), gReportScheduler) == CHIP_NO_ERROR);
+
+    // Subscribes to attribute aAttributeId of clusters 3 and 4 on endpoint 2
+    auto processSubscribeRequest = [&](ReadHandler & readHandler, AttributeId aAttributeId) {
+        System::PacketBufferTLVWriter writer;
+        System::PacketBufferHandle subscribeRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+        writer.Init(std::move(subscribeRequestbuf));
+
+        SubscribeRequestMessage::Builder subscribeRequestBuilder;
+        NL_TEST_ASSERT(apSuite, subscribeRequestBuilder.Init(&writer) == CHIP_NO_ERROR);
+        subscribeRequestBuilder.KeepSubscriptions(true).MinIntervalFloorSeconds(2).MaxIntervalCeilingSeconds(3);
+
+        AttributePathIBs::Builder & attributePathListBuilder = subscribeRequestBuilder.CreateAttributeRequests();
+        for (ClusterId clusterId = 3; clusterId <= 4; clusterId++)
+        {
+            AttributePathIB::Builder & attributePathBuilder = attributePathListBuilder.CreatePath();
+            attributePathBuilder.Endpoint(2).Cluster(clusterId).Attribute(aAttributeId).EndOfAttributePathIB();
+            NL_TEST_ASSERT(apSuite, attributePathBuilder.GetError() == CHIP_NO_ERROR);
+        }
+        attributePathListBuilder.EndOfAttributePathIBs();
+
+        subscribeRequestBuilder.IsFabricFiltered(false).EndOfSubscribeRequestMessage();
+        NL_TEST_ASSERT(apSuite, subscribeRequestBuilder.GetError() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, writer.Finalize(&subscribeRequestbuf) == CHIP_NO_ERROR);
+
+        NL_TEST_ASSERT(apSuite, readHandler.ProcessSubscribeRequest(std::move(subscribeRequestbuf)) == CHIP_NO_ERROR);
+    };
+
+    {
+        ReadHandler firstHandler(*engine, ctx.NewExchangeToAlice(nullptr, false), ReadHandler::InteractionType::Subscribe,
+                                 gReportScheduler);
+        processSubscribeRequest(firstHandler, 4);
+        NL_TEST_ASSERT(apSuite, engine->GetNumAllocatedAttributePaths() == 2);
+
+        ReadHandler otherHandler(*engine, ctx.NewExchangeToAlice(nullptr, false), ReadHandler::InteractionType::Subscribe,
+                                 gReportScheduler);
+        processSubscribeRequest(otherHandler, 5);
+        NL_TEST_ASSERT(apSuite, otherHandler.mpAttributePathList != firstHandler.mpAttributePathList);
+        NL_TEST_ASSERT(apSuite, engine->GetNumAllocatedAttributePaths() == 4);
+
+        {
+            // The same paths are stored once
+            ReadHandler secondHandler(*engine, ctx.NewExchangeToAlice(nullptr, false), ReadHandler::InteractionType::Subscribe,
+                                      gReportScheduler);
+            processSubscribeRequest(secondHandler, 4);
+            NL_TEST_ASSERT(apSuite, secondHandler.mpAttributePathList == firstHandler.mpAttributePathList);
+            NL_TEST_ASSERT(apSuite, engine->GetNumAllocatedAttributePaths() == 4);
+            NL_TEST_ASSERT(apSuite, engine->GetAttributePathListRefCount(firstHandler.mpAttributePathList) == 2);
+        }
+
+        // and stay allocated until the last handler using them is gone
+        NL_TEST_ASSERT(apSuite, engine->GetNumAllocatedAttributePaths() == 4);
+        NL_TEST_ASSERT(apSuite, engine->GetAttributePathListRefCount(firstHandler.mpAttributePathList) == 1);
+    }
+    NL_TEST_ASSERT(apSuite, engine->GetNumAllocatedAttributePaths() == 0);
+
+    engine->Shutdown();
+
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
 #if CHIP_CONFIG_ENABLE_ICD_SERVER
 /**
  * @brief Test validates that an ICD will choose its IdleModeDuration (GetPublisherSelectedIntervalLimit)
@@ -5067,6 +5308,7 @@ const nlTest sTests[] = {
     NL_TEST_DEF("TestReadWildcard", chip::app::TestReadInteraction::TestReadWildcard),
     NL_TEST_DEF("TestReadChunking", chip::app::TestReadInteraction::TestReadChunking),
     NL_TEST_DEF("TestSetDirtyBetweenChunks", chip::app::TestReadInteraction::TestSetDirtyBetweenChunks),
+    NL_TEST_DEF("TestReadChunkedListReassembly", chip::app::TestReadInteraction::TestReadChunkedListReassembly),
     NL_TEST_DEF("CheckReadClient", chip::app::TestReadInteraction::TestReadClient),
     NL_TEST_DEF("TestReadUnexpectedSubscriptionId", chip::app::TestReadInteraction::TestReadUnexpectedSubscriptionId),
     NL_TEST_DEF("CheckReadHandler", chip::app::TestReadInteraction::TestReadHandler),
@@ -5079,6 +5321,7 @@ const nlTest sTests[] = {
     NL_TEST_DEF("TestReadClientInvalidAttributeId", chip::app::TestReadInteraction::TestReadClientInvalidAttributeId),
     NL_TEST_DEF("TestReadHandlerInvalidAttributePath", chip::app::TestReadInteraction::TestReadHandlerInvalidAttributePath),
     NL_TEST_DEF("TestProcessSubscribeRequest", chip::app::TestReadInteraction::TestProcessSubscribeRequest),
+    NL_TEST_DEF("TestProcessSubscribeRequestSharesPaths", chip::app::TestReadInteraction::TestProcessSubscribeRequestSharesPaths),
 #if CHIP_CONFIG_ENABLE_ICD_SERVER
     NL_TEST_DEF("TestICDProcessSubscribeRequestSupMaxIntervalCeiling",
                 chip::app::TestReadInteraction::TestICDProcessSubscribeRequestSupMaxIntervalCeiling),
@@ -23,22 +23,28 @@
  */
 
 #include <app/ConcreteAttributePath.h>
+#include <app/GlobalAttributes.h>
 #include <app/InteractionModelEngine.h>
 #include <app/reporting/Engine.h>
 #include <app/reporting/tests/MockReportScheduler.h>
 #include <app/tests/AppTestContext.h>
+#include <app/util/mock/Constants.h>
+#include <app/util/mock/Functions.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/ErrorStr.h>
 #include <lib/core/TLV.h>
 #include <lib/core/TLVDebug.h>
 #include <lib/core/TLVUtilities.h>
+#include <lib/support/ScopedBuffer.h>
 #include <lib/support/UnitTestContext.h>
 #include <lib/support/UnitTestRegistration.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/Flags.h>
+#include <system/SystemClock.h>
 
 #include <cinttypes>
 #include <nlunit-test.h>
+#include <vector>
 
 using TestContext = chip::Test::AppContext;
 
@@ -57,6 +63,9 @@ public:
     static void TestBuildAndSendSingleReportData(nlTestSuite * apSuite, void * apContext);
     static void TestMergeOverlappedAttributePath(nlTestSuite * apSuite, void * apContext);
     static void TestMergeAttributePathWhenDirtySetPoolExhausted(nlTestSuite * apSuite, void * apContext);
+    static void TestAttributeChangeCoalescer(nlTestSuite * apSuite, void * apContext);
+    static void TestAttributeChangeCoalescingBenchmark(nlTestSuite * apSuite, void * apContext);
+    static void TestWildcardReportBridgeBenchmark(nlTestSuite * apSuite, void * apContext);
 
 private:
     static bool InsertToDirtySet(const AttributePathParams & aPath);
@@ -326,6 +335,320 @@ void TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted(nlTest
     InteractionModelEngine::GetInstance()->GetReportingEngine().Shutdown();
 }
 
+void TestReportingEngine::TestAttributeChangeCoalescer(nlTestSuite * apSuite, void * apContext)
+{
+    using Action = AttributeChangeCoalescer::Action;
+
+    constexpr size_t kMaxClusters = 4;
+
+    FixedAttributeChangeCoalescer<kMaxClusters> coalescer;
+    const ConcreteAttributePath path1(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    const ConcreteAttributePath path2(kTestEndpointId, kTestClusterId, kTestFieldId2);
+    const ConcreteClusterPath cluster(kTestEndpointId, kTestClusterId);
+    AttributeChangeCoalescer::ClusterStatistics stats;
+    BitFlags<Action> actions;
+
+    // Without room for any cluster, coalescing is disabled: every change does all the work and no cluster is tracked.
+    FixedAttributeChangeCoalescer<0> disabled;
+    for (int i = 0; i < 2; i++)
+    {
+        actions = disabled.OnAttributeChanged(path1);
+        NL_TEST_ASSERT(apSuite, actions.Has(Action::kSetDirty) && actions.Has(Action::kIncreaseDataVersion));
+    }
+    NL_TEST_ASSERT(apSuite, !disabled.GetStatistics(cluster, stats));
+
+    // The first change needs all the work.
+    actions = coalescer.OnAttributeChanged(path1);
+    NL_TEST_ASSERT(apSuite, actions.Has(Action::kSetDirty) && actions.Has(Action::kIncreaseDataVersion));
+
+    // Repeating it before a report run or a data version read needs none.
+    actions = coalescer.OnAttributeChanged(path1);
+    NL_TEST_ASSERT(apSuite, !actions.Has(Action::kSetDirty) && !actions.Has(Action::kIncreaseDataVersion));
+
+    // Another attribute of the cluster must be marked dirty, but shares the data version increase.
+    actions = coalescer.OnAttributeChanged(path2);
+    NL_TEST_ASSERT(apSuite, actions.Has(Action::kSetDirty) && !actions.Has(Action::kIncreaseDataVersion));
+
+    // Once the data version was read, the next change increases it again.
+    coalescer.OnDataVersionRead(cluster);
+    actions = coalescer.OnAttributeChanged(path1);
+    NL_TEST_ASSERT(apSuite, !actions.Has(Action::kSetDirty) && actions.Has(Action::kIncreaseDataVersion));
+
+    // Once the engine ran, the next change marks the path dirty again.
+    coalescer.OnReportRun();
+    actions = coalescer.OnAttributeChanged(path1);
+    NL_TEST_ASSERT(apSuite, actions.Has(Action::kSetDirty) && !actions.Has(Action::kIncreaseDataVersion));
+
+    // Attribute ids outside of the bitmap are always marked dirty.
+    const ConcreteAttributePath globalAttribute(kTestEndpointId, kTestClusterId, 0xFFFD);
+    NL_TEST_ASSERT(apSuite, coalescer.OnAttributeChanged(globalAttribute).Has(Action::kSetDirty));
+    NL_TEST_ASSERT(apSuite, coalescer.OnAttributeChanged(globalAttribute).Has(Action::kSetDirty));
+
+    NL_TEST_ASSERT(apSuite, coalescer.GetStatistics(cluster, stats));
+    NL_TEST_ASSERT(apSuite, stats.changes == 7);
+    NL_TEST_ASSERT(apSuite, stats.dirtyMarks == 5);
+    NL_TEST_ASSERT(apSuite, stats.dataVersionIncreases == 2);
+    NL_TEST_ASSERT(apSuite, !coalescer.GetStatistics(ConcreteClusterPath(kTestEndpointId, kTestClusterId + 1), stats));
+
+    // When more clusters change than are tracked, the least recently changed one is forgotten, which only means
+    // that its next change does the work again.
+    for (ClusterId i = 1; i <= kMaxClusters; i++)
+    {
+        coalescer.OnAttributeChanged(ConcreteAttributePath(kTestEndpointId + 1, i, kTestFieldId1));
+    }
+    NL_TEST_ASSERT(apSuite, !coalescer.GetStatistics(cluster, stats));
+    actions = coalescer.OnAttributeChanged(path1);
+    NL_TEST_ASSERT(apSuite, actions.Has(Action::kSetDirty) && actions.Has(Action::kIncreaseDataVersion));
+
+    size_t trackedClusters = 0;
+    coalescer.ForEachCluster([&](const ConcreteClusterPath &, const AttributeChangeCoalescer::ClusterStatistics &) {
+        trackedClusters++;
+    });
+    NL_TEST_ASSERT(apSuite, trackedClusters == kMaxClusters);
+
+    coalescer.Reset();
+    NL_TEST_ASSERT(apSuite, !coalescer.GetStatistics(cluster, stats));
+}
+
+void TestReportingEngine::TestAttributeChangeCoalescingBenchmark(nlTestSuite * apSuite, void * apContext)
+{
+    // A sensor updating one attribute 100 times per report run, with one reader interested in it.
+    constexpr uint32_t kChanges          = 20000;
+    constexpr uint32_t kChangesPerReport = 100;
+
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = InteractionModelEngine::GetInstance()->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(),
+                                                                    app::reporting::GetDefaultReportScheduler());
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+
+    System::PacketBufferTLVWriter writer;
+    System::PacketBufferHandle readRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    ReadRequestMessage::Builder readRequestBuilder;
+    writer.Init(std::move(readRequestbuf));
+    NL_TEST_ASSERT(apSuite, readRequestBuilder.Init(&writer) == CHIP_NO_ERROR);
+    AttributePathIBs::Builder & attributePathListBuilder = readRequestBuilder.CreateAttributeRequests();
+    attributePathListBuilder.CreatePath().Endpoint(kTestEndpointId).Cluster(kTestClusterId).EndOfAttributePathIB();
+    attributePathListBuilder.EndOfAttributePathIBs();
+    readRequestBuilder.IsFabricFiltered(false).EndOfReadRequestMessage();
+    NL_TEST_ASSERT(apSuite, readRequestBuilder.GetError() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, writer.Finalize(&readRequestbuf) == CHIP_NO_ERROR);
+
+    DummyDelegate dummy;
+    TestExchangeDelegate delegate;
+    ReadHandler * readHandler = InteractionModelEngine::GetInstance()->GetReadHandlerPool().CreateObject(
+        dummy, ctx.NewExchangeToAlice(&delegate), ReadHandler::InteractionType::Read, app::reporting::GetDefaultReportScheduler());
+    NL_TEST_ASSERT(apSuite, readHandler != nullptr);
+    readHandler->OnInitialRequest(std::move(readRequestbuf));
+
+    AttributePathParams dirtyPath(kTestEndpointId, kTestClusterId, kTestFieldId1);
+    const ConcreteAttributePath changedPath(kTestEndpointId, kTestClusterId, kTestFieldId1);
+
+    // Without coalescing, every change marks the path dirty.
+    uint64_t start = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (uint32_t i = 0; i < kChanges; i++)
+    {
+        engine.SetDirty(dirtyPath);
+    }
+    uint64_t uncoalescedMicros = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+
+    // Stands in for the engine's own coalescer, which has CHIP_IM_SERVER_MAX_NUM_COALESCED_CLUSTERS entries, possibly none.
+    FixedAttributeChangeCoalescer<8> coalescer;
+    uint64_t generationBefore = engine.GetDirtySetGeneration();
+    start                     = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (uint32_t i = 0; i < kChanges; i++)
+    {
+        if (i % kChangesPerReport == 0)
+        {
+            // Stands in for the report run (and the data version read) that a real device would do once per
+            // subscriber min interval.
+            coalescer.OnReportRun();
+            coalescer.OnDataVersionRead(changedPath);
+        }
+        if (coalescer.OnAttributeChanged(changedPath).Has(AttributeChangeCoalescer::Action::kSetDirty))
+        {
+            engine.SetDirty(dirtyPath);
+        }
+    }
+    uint64_t coalescedMicros = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+
+    AttributeChangeCoalescer::ClusterStatistics stats;
+    NL_TEST_ASSERT(apSuite, coalescer.GetStatistics(changedPath, stats));
+    NL_TEST_ASSERT(apSuite, stats.changes == kChanges);
+    NL_TEST_ASSERT(apSuite, stats.dirtyMarks == kChanges / kChangesPerReport);
+    NL_TEST_ASSERT(apSuite, stats.dataVersionIncreases == kChanges / kChangesPerReport);
+    NL_TEST_ASSERT(apSuite, engine.GetDirtySetGeneration() - generationBefore == kChanges / kChangesPerReport);
+
+    ChipLogProgress(DataManagement,
+                    "%" PRIu32 " attribute changes: %" PRIu64 " ns/change without coalescing, %" PRIu64
+                    " ns/change with coalescing (%" PRIu32 " changes/s)",
+                    kChanges, uncoalescedMicros * 1000 / kChanges, coalescedMicros * 1000 / kChanges, stats.ChangesPerSecond());
+
+    InteractionModelEngine::GetInstance()->GetReadHandlerPool().ReleaseObject(readHandler);
+    ctx.DrainAndServiceIO();
+    engine.Shutdown();
+}
+
+void TestReportingEngine::TestWildcardReportBridgeBenchmark(nlTestSuite * apSuite, void * apContext)
+{
+    // A bridge exposing one endpoint per bridged device to a wildcard subscriber, which resubscribes with data version filters
+    // for every cluster, after every thirtieth device changed.
+    constexpr EndpointId kBridgedDevices     = 300;
+    constexpr EndpointId kChangedDeviceEvery = 30;
+    constexpr uint16_t kClustersPerDevice    = 3;
+    constexpr size_t kAttributesPerCluster   = 3 + ArraySize(GlobalAttributesNotInMetadata);
+    constexpr size_t kReportBufferSize       = 32 * 1024;
+    // IsClusterDataVersionEqual() in TestReadInteraction.cpp only matches this version.
+    constexpr DataVersion kCurrentDataVersion = 3;
+
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    CHIP_ERROR err    = InteractionModelEngine::GetInstance()->Init(&ctx.GetExchangeManager(), &ctx.GetFabricTable(),
+                                                                    app::reporting::GetDefaultReportScheduler());
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    Engine & engine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+
+    std::vector<Test::MockEndpointConfig> devices;
+    for (EndpointId endpoint = 1; endpoint <= kBridgedDevices; endpoint++)
+    {
+        using namespace Clusters::Globals::Attributes;
+        devices.push_back(Test::MockEndpointConfig(
+            endpoint,
+            {
+                Test::MockClusterConfig(Test::MockClusterId(1), { ClusterRevision::Id, FeatureMap::Id, Test::MockAttributeId(1) }),
+                Test::MockClusterConfig(Test::MockClusterId(2), { ClusterRevision::Id, FeatureMap::Id, Test::MockAttributeId(2) }),
+                Test::MockClusterConfig(Test::MockClusterId(3), { ClusterRevision::Id, FeatureMap::Id, Test::MockAttributeId(3) }),
+            }));
+    }
+    const Test::MockNodeConfig bridge(std::move(devices));
+    Test::SetMockNodeConfig(bridge);
+
+    System::PacketBufferTLVWriter writer;
+    System::PacketBufferHandle readRequestbuf = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSize);
+    ReadRequestMessage::Builder readRequestBuilder;
+    writer.Init(std::move(readRequestbuf));
+    NL_TEST_ASSERT(apSuite, readRequestBuilder.Init(&writer) == CHIP_NO_ERROR);
+    AttributePathIBs::Builder & attributePathListBuilder = readRequestBuilder.CreateAttributeRequests();
+    attributePathListBuilder.CreatePath().EndOfAttributePathIB();
+    attributePathListBuilder.EndOfAttributePathIBs();
+    readRequestBuilder.IsFabricFiltered(false).EndOfReadRequestMessage();
+    NL_TEST_ASSERT(apSuite, readRequestBuilder.GetError() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, writer.Finalize(&readRequestbuf) == CHIP_NO_ERROR);
+
+    DummyDelegate dummy;
+    TestExchangeDelegate delegate;
+    ReadHandler * readHandler = InteractionModelEngine::GetInstance()->GetReadHandlerPool().CreateObject(
+        dummy, ctx.NewExchangeToAlice(&delegate), ReadHandler::InteractionType::Read, app::reporting::GetDefaultReportScheduler());
+    NL_TEST_ASSERT(apSuite, readHandler != nullptr);
+    readHandler->OnInitialRequest(std::move(readRequestbuf));
+
+    // Far more filters than fit in a request, so they are handed to the read handler directly.
+    std::vector<ObjectList<DataVersionFilter>> filters(kBridgedDevices * kClustersPerDevice);
+    for (size_t i = 0; i < filters.size(); i++)
+    {
+        const EndpointId endpoint = static_cast<EndpointId>(i / kClustersPerDevice + 1);
+        const ClusterId cluster   = Test::MockClusterId(static_cast<uint16_t>(i % kClustersPerDevice + 1));
+        const DataVersion version = (endpoint % kChangedDeviceEvery == 0) ? kCurrentDataVersion - 1 : kCurrentDataVersion;
+        filters[i].mValue         = DataVersionFilter(endpoint, cluster, version);
+        filters[i].mpNext         = (i + 1 < filters.size()) ? &filters[i + 1] : nullptr;
+    }
+    readHandler->mpDataVersionFilterList = filters.data();
+
+    Platform::ScopedMemoryBuffer<uint8_t> reportBuffer;
+    NL_TEST_ASSERT(apSuite, reportBuffer.Alloc(kReportBufferSize));
+
+    // Builds the whole report in a single chunk, returns the number of attribute reports in it.
+    auto buildReport = [&](uint64_t & aMicros) -> size_t {
+        TLV::TLVWriter reportWriter;
+        reportWriter.Init(reportBuffer.Get(), kReportBufferSize);
+        ReportDataMessage::Builder reportDataBuilder;
+        NL_TEST_ASSERT(apSuite, reportDataBuilder.Init(&reportWriter) == CHIP_NO_ERROR);
+
+        bool hasMoreChunks  = true;
+        bool hasEncodedData = false;
+        uint64_t start      = System::SystemClock().GetMonotonicMicroseconds64().count();
+        NL_TEST_ASSERT(apSuite,
+                       engine.BuildSingleReportDataAttributeReportIBs(reportDataBuilder, readHandler, &hasMoreChunks,
+                                                                      &hasEncodedData) == CHIP_NO_ERROR);
+        aMicros = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+        NL_TEST_ASSERT(apSuite, !hasMoreChunks);
+        NL_TEST_ASSERT(apSuite, reportDataBuilder.EndOfReportDataMessage() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, reportWriter.Finalize() == CHIP_NO_ERROR);
+
+        TLV::TLVReader reader;
+        reader.Init(reportBuffer.Get(), reportWriter.GetLengthWritten());
+        ReportDataMessage::Parser reportDataParser;
+        AttributeReportIBs::Parser attributeReportIBsParser;
+        NL_TEST_ASSERT(apSuite, reportDataParser.Init(reader) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, reportDataParser.GetAttributeReportIBs(&attributeReportIBsParser) == CHIP_NO_ERROR);
+        attributeReportIBsParser.GetReader(&reader);
+
+        size_t count = 0;
+        while (reader.Next() == CHIP_NO_ERROR)
+        {
+            count++;
+        }
+        return count;
+    };
+
+    // Stands in for the previous engine loop, which expanded the wildcard attribute by attribute and checked the data version
+    // filters or the dirty set for each of them, without encoding anything.
+    auto expandAttributeByAttribute = [&]() -> uint64_t {
+        uint64_t start    = System::SystemClock().GetMonotonicMicroseconds64().count();
+        size_t reportable = 0;
+        ConcreteReadAttributePath path;
+        for (AttributePathExpandIterator iterator(readHandler->mpAttributePathList); iterator.Get(path); iterator.Next())
+        {
+            if (readHandler->IsPriming())
+            {
+                reportable += engine.IsClusterDataVersionMatch(readHandler->GetDataVersionFilterList(), path) ? 0 : 1;
+                continue;
+            }
+            engine.mGlobalDirtySet.ForEachActiveObject([&](auto * dirtyPath) {
+                if (dirtyPath->IsAttributePathSupersetOf(path) &&
+                    dirtyPath->mGeneration > readHandler->mPreviousReportsBeginGeneration)
+                {
+                    reportable++;
+                    return Loop::Break;
+                }
+                return Loop::Continue;
+            });
+        }
+        NL_TEST_ASSERT(apSuite, reportable > 0);
+        return System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+    };
+
+    // Priming report: only the clusters of the changed devices fail their filter.
+    uint64_t primingMicros      = 0;
+    const size_t primingReports = buildReport(primingMicros);
+    NL_TEST_ASSERT(apSuite,
+                   primingReports == (kBridgedDevices / kChangedDeviceEvery) * kClustersPerDevice * kAttributesPerCluster);
+    const uint64_t primingBaselineMicros = expandAttributeByAttribute();
+
+    // Incremental report: the subscription is established and three attributes of different devices change.
+    readHandler->mFlags.Clear(ReadHandler::ReadHandlerFlags::PrimingReports);
+    readHandler->mPreviousReportsBeginGeneration = engine.GetDirtySetGeneration();
+    for (EndpointId endpoint : { EndpointId(1), EndpointId(kBridgedDevices / 2), kBridgedDevices })
+    {
+        AttributePathParams dirtyPath(endpoint, Test::MockClusterId(2), Test::MockAttributeId(2));
+        NL_TEST_ASSERT(apSuite, engine.SetDirty(dirtyPath) == CHIP_NO_ERROR);
+    }
+    uint64_t incrementalMicros = 0;
+    NL_TEST_ASSERT(apSuite, buildReport(incrementalMicros) == 3);
+    const uint64_t incrementalBaselineMicros = expandAttributeByAttribute();
+
+    ChipLogProgress(DataManagement,
+                    "%u bridged devices: priming report %" PRIu64 " us (%" PRIu64 " us expanding attribute by attribute), "
+                    "incremental report %" PRIu64 " us (%" PRIu64 " us expanding attribute by attribute)",
+                    static_cast<unsigned>(kBridgedDevices), primingMicros, primingBaselineMicros, incrementalMicros,
+                    incrementalBaselineMicros);
+
+    readHandler->mpDataVersionFilterList = nullptr;
+    InteractionModelEngine::GetInstance()->GetReadHandlerPool().ReleaseObject(readHandler);
+    ctx.DrainAndServiceIO();
+    engine.Shutdown();
+    Test::ResetMockNodeConfig();
+}
+
 } // namespace reporting
 } // namespace app
 } // namespace chip
@@ -337,6 +660,9 @@ const nlTest sTests[] =
     NL_TEST_DEF("CheckBuildAndSendSingleReportData", chip::app::reporting::TestReportingEngine::TestBuildAndSendSingleReportData),
     NL_TEST_DEF("TestMergeOverlappedAttributePath", chip::app::reporting::TestReportingEngine::TestMergeOverlappedAttributePath),
     NL_TEST_DEF("TestMergeAttributePathWhenDirtySetPoolExhausted", chip::app::reporting::TestReportingEngine::TestMergeAttributePathWhenDirtySetPoolExhausted),
+    NL_TEST_DEF("TestAttributeChangeCoalescer", chip::app::reporting::TestReportingEngine::TestAttributeChangeCoalescer),
+    NL_TEST_DEF("TestAttributeChangeCoalescingBenchmark", chip::app::reporting::TestReportingEngine::TestAttributeChangeCoalescingBenchmark),
+    NL_TEST_DEF("TestWildcardReportBridgeBenchmark", chip::app::reporting::TestReportingEngine::TestWildcardReportBridgeBenchmark),
     NL_TEST_SENTINEL()
 };
 // clang-format on
@@ -0,0 +1,212 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/AttributePathParams.h>
+#include <app/ReadHandler.h>
+#include <app/SharedObjectLists.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+using PathList = ObjectList<AttributePathParams>;
+
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+constexpr size_t kSubscriptions = 5000;
+#else
+// Inline pools are sized for the worst case, keep them small enough for embedded targets
+constexpr size_t kSubscriptions = 100;
+#endif
+constexpr size_t kPathsPerSubscription = 12;
+// Number of distinct path sets among the subscriptions, e.g. one per kind of controller subscribing to a bridge
+constexpr size_t kPathSets = 25;
+
+ObjectPool<PathList, kSubscriptions * kPathsPerSubscription> sPathPool;
+SharedObjectLists<AttributePathParams, kSubscriptions> sSharedLists;
+PathList * sSubscriptionPaths[kSubscriptions];
+
+PathList * MakeList(nlTestSuite * apSuite, size_t aPathSet, size_t aCount = kPathsPerSubscription)
+{
+    PathList * list = nullptr;
+    for (size_t i = 0; i < aCount; i++)
+    {
+        PathList * node = sPathPool.CreateObject();
+        NL_TEST_ASSERT(apSuite, node != nullptr);
+        VerifyOrReturnValue(node != nullptr, list);
+        // A wildcard endpoint path per cluster, as a bridge controller subscribes to the same clusters on every bridged device
+        node->mValue = AttributePathParams(kInvalidEndpointId, static_cast<ClusterId>(0x0006 + i),
+                                           static_cast<AttributeId>(aPathSet));
+        node->mpNext = list;
+        list         = node;
+    }
+    return list;
+}
+
+void TestShareEqualLists(nlTestSuite * apSuite, void * apContext)
+{
+    PathList * first  = MakeList(apSuite, 1);
+    PathList * second = MakeList(apSuite, 1);
+    PathList * other  = MakeList(apSuite, 2);
+    NL_TEST_ASSERT(apSuite, sPathPool.Allocated() == 3 * kPathsPerSubscription);
+
+    sSharedLists.Share(first, sPathPool);
+    sSharedLists.Share(second, sPathPool);
+    sSharedLists.Share(other, sPathPool);
+
+    // The second list was replaced by the first one and its nodes released
+    NL_TEST_ASSERT(apSuite, second == first);
+    NL_TEST_ASSERT(apSuite, other != first);
+    NL_TEST_ASSERT(apSuite, sPathPool.Allocated() == 2 * kPathsPerSubscription);
+    NL_TEST_ASSERT(apSuite, sSharedLists.GetSharedCount() == 2);
+    NL_TEST_ASSERT(apSuite, sSharedLists.GetRefCount(first) == 2);
+    NL_TEST_ASSERT(apSuite, sSharedLists.GetRefCount(other) == 1);
+
+    // The nodes are released with the last reference
+    sSharedLists.Release(second, sPathPool);
+    NL_TEST_ASSERT(apSuite, second == nullptr);
+    NL_TEST_ASSERT(apSuite, sPathPool.Allocated() == 2 * kPathsPerSubscription);
+    NL_TEST_ASSERT(apSuite, sSharedLists.GetRefCount(first) == 1);
+
+    sSharedLists.Release(first, sPathPool);
+    sSharedLists.Release(other, sPathPool);
+    NL_TEST_ASSERT(apSuite, first == nullptr && other == nullptr);
+    NL_TEST_ASSERT(apSuite, sPathPool.Allocated() == 0);
+    NL_TEST_ASSERT(apSuite, sSharedLists.GetSharedCount() == 0);
+}
+
+void TestListsThatDiffer(nlTestSuite * apSuite, void * apContext)
+{
+    // A list that is a prefix of another one is not equal to it
+    PathList * longer  = MakeList(apSuite, 1);
+    PathList * shorter = MakeList(apSuite, 1, kPathsPerSubscription - 1);
+    // The same paths in another order are not equal either
+    PathList * reversed = nullptr;
+    for (PathList * node = MakeList(apSuite, 1); node != nullptr;)
+    {
+        PathList * next = node->mpNext;
+        node->mpNext    = reversed;
+        reversed        = node;
+        node            = next;
+    }
+
+    sSharedLists.Share(longer, sPathPool);
+    sSharedLists.Share(shorter, sPathPool);
+    sSharedLists.Share(reversed, sPathPool);
+    NL_TEST_ASSERT(apSuite, sSharedLists.GetSharedCount() == 3);
+    NL_TEST_ASSERT(apSuite, sPathPool.Allocated() == 3 * kPathsPerSubscription - 1);
+
+    sSharedLists.Release(longer, sPathPool);
+    sSharedLists.Release(shorter, sPathPool);
+    sSharedLists.Release(reversed, sPathPool);
+    NL_TEST_ASSERT(apSuite, sPathPool.Allocated() == 0);
+}
+
+void TestReleasePrivateList(nlTestSuite * apSuite, void * apContext)
+{
+    // Lists of reads are never shared, Release() frees them right away
+    PathList * list = MakeList(apSuite, 1);
+    sSharedLists.Release(list, sPathPool);
+    NL_TEST_ASSERT(apSuite, list == nullptr);
+    NL_TEST_ASSERT(apSuite, sPathPool.Allocated() == 0);
+}
+
+void TestFootprintAtScale(nlTestSuite * apSuite, void * apContext)
+{
+    for (size_t i = 0; i < kSubscriptions; i++)
+    {
+        sSubscriptionPaths[i] = MakeList(apSuite, i % kPathSets);
+        sSharedLists.Share(sSubscriptionPaths[i], sPathPool);
+    }
+
+    NL_TEST_ASSERT(apSuite, sSharedLists.GetSharedCount() == kPathSets);
+    NL_TEST_ASSERT(apSuite, sPathPool.Allocated() == kPathSets * kPathsPerSubscription);
+
+    const size_t handlerBytes = sizeof(ReadHandler);
+    const size_t privateBytes = kPathsPerSubscription * sizeof(PathList);
+    const size_t sharedBytes  = (sPathPool.Allocated() * sizeof(PathList) + sSharedLists.GetSharedCount() * 3 * sizeof(void *)) /
+        kSubscriptions;
+    ChipLogProgress(Test, "%u subscriptions with %u attribute paths each, %u distinct path sets:",
+                    static_cast<unsigned>(kSubscriptions), static_cast<unsigned>(kPathsPerSubscription),
+                    static_cast<unsigned>(kPathSets));
+    ChipLogProgress(Test, "  ReadHandler: %u bytes", static_cast<unsigned>(handlerBytes));
+    ChipLogProgress(Test, "  attribute paths per subscription: %u bytes private, %u bytes shared",
+                    static_cast<unsigned>(privateBytes), static_cast<unsigned>(sharedBytes));
+#if CHIP_SYSTEM_CONFIG_POOL_USE_HEAP
+    ChipLogProgress(Test, "  path iterator: %u bytes, allocated only while a report is generated",
+                    static_cast<unsigned>(sizeof(AttributePathExpandIterator)));
+#endif
+    NL_TEST_ASSERT(apSuite, sharedBytes * 3 < privateBytes);
+
+    for (auto & paths : sSubscriptionPaths)
+    {
+        sSharedLists.Release(paths, sPathPool);
+    }
+    NL_TEST_ASSERT(apSuite, sSharedLists.GetSharedCount() == 0);
+    NL_TEST_ASSERT(apSuite, sPathPool.Allocated() == 0);
+}
+
+int Initialize(void * apSuite)
+{
+    VerifyOrReturnError(Platform::MemoryInit() == CHIP_NO_ERROR, FAILURE);
+    return SUCCESS;
+}
+
+int Finalize(void * apSuite)
+{
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestShareEqualLists", TestShareEqualLists),
+    NL_TEST_DEF("TestListsThatDiffer", TestListsThatDiffer),
+    NL_TEST_DEF("TestReleasePrivateList", TestReleasePrivateList),
+    NL_TEST_DEF("TestFootprintAtScale", TestFootprintAtScale),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestSharedObjectLists()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "SharedObjectLists",
+        &sTests[0],
+        Initialize,
+        Finalize
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestSharedObjectLists)
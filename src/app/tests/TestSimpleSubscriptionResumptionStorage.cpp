@@ -18,8 +18,10 @@
 #include <lib/support/UnitTestRegistration.h>
 #include <nlunit-test.h>
 
+#include <app/IndexedSubscriptionResumptionStorage.h>
 #include <app/SimpleSubscriptionResumptionStorage.h>
 #include <lib/support/TestPersistentStorageDelegate.h>
+#include <system/SystemClock.h>
 
 #include <lib/support/DefaultStorageKeyAllocator.h>
 
@@ -34,6 +36,19 @@ public:
     static constexpr size_t TestMaxSubscriptionSize() { return MaxSubscriptionSize(); }
 };
 
+class ReadCountingStorageDelegate : public chip::TestPersistentStorageDelegate
+{
+public:
+    size_t mReadCount = 0;
+
+protected:
+    CHIP_ERROR SyncGetKeyValueInternal(const char * key, void * buffer, uint16_t & size) override
+    {
+        mReadCount++;
+        return TestPersistentStorageDelegate::SyncGetKeyValueInternal(key, buffer, size);
+    }
+};
+
 struct TestSubscriptionInfo : public chip::app::SubscriptionResumptionStorage::SubscriptionInfo
 {
     bool operator==(const SubscriptionInfo & that) const
@@ -407,6 +422,269 @@ void TestSubscriptionStateJunkData(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, iterator->Count() == 0);
     iterator->Release();
 }
+
+void TestIndexedSubscriptionState(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::app::IndexedSubscriptionResumptionStorage subscriptionStorage;
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Init(&storage) == CHIP_NO_ERROR);
+
+    chip::app::SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo1 = {
+        .mNodeId         = 1111,
+        .mFabricIndex    = 41,
+        .mSubscriptionId = 1,
+        .mMinInterval    = 1,
+        .mMaxInterval    = 11,
+        .mFabricFiltered = true,
+    };
+    subscriptionInfo1.mAttributePaths.Calloc(1);
+    subscriptionInfo1.mAttributePaths[0].mEndpointId  = 1;
+    subscriptionInfo1.mAttributePaths[0].mClusterId   = 1;
+    subscriptionInfo1.mAttributePaths[0].mAttributeId = 1;
+
+    chip::app::SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo2 = {
+        .mNodeId         = 2222,
+        .mFabricIndex    = 42,
+        .mSubscriptionId = 2,
+        .mMinInterval    = 2,
+        .mMaxInterval    = 12,
+        .mFabricFiltered = false,
+    };
+    subscriptionInfo2.mEventPaths.Calloc(1);
+    subscriptionInfo2.mEventPaths[0].mEndpointId    = 3;
+    subscriptionInfo2.mEventPaths[0].mClusterId     = 3;
+    subscriptionInfo2.mEventPaths[0].mEventId       = 3;
+    subscriptionInfo2.mEventPaths[0].mIsUrgentEvent = true;
+
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Save(subscriptionInfo1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Save(subscriptionInfo2) == CHIP_NO_ERROR);
+
+    // Saving the same subscription again overwrites it in place
+    subscriptionInfo1.mMaxInterval = 21;
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Save(subscriptionInfo1) == CHIP_NO_ERROR);
+
+    auto * iterator = subscriptionStorage.IterateSubscriptions();
+    NL_TEST_ASSERT(inSuite, iterator->Count() == 2);
+    TestSubscriptionInfo subscriptionInfo;
+    NL_TEST_ASSERT(inSuite, iterator->Next(subscriptionInfo));
+    NL_TEST_ASSERT(inSuite, subscriptionInfo == subscriptionInfo1);
+    NL_TEST_ASSERT(inSuite, iterator->Next(subscriptionInfo));
+    NL_TEST_ASSERT(inSuite, subscriptionInfo == subscriptionInfo2);
+    NL_TEST_ASSERT(inSuite, !iterator->Next(subscriptionInfo));
+    iterator->Release();
+
+    // Summaries carry everything but the paths
+    iterator = subscriptionStorage.IterateSubscriptionSummaries();
+    NL_TEST_ASSERT(inSuite, iterator->Count() == 2);
+    NL_TEST_ASSERT(inSuite, iterator->Next(subscriptionInfo));
+    NL_TEST_ASSERT(inSuite, subscriptionInfo.mNodeId == subscriptionInfo1.mNodeId);
+    NL_TEST_ASSERT(inSuite, subscriptionInfo.mMaxInterval == 21);
+    NL_TEST_ASSERT(inSuite, subscriptionInfo.mFabricFiltered);
+    NL_TEST_ASSERT(inSuite, subscriptionInfo.mAttributePaths.AllocatedSize() == 0);
+    NL_TEST_ASSERT(inSuite, iterator->Next(subscriptionInfo));
+    NL_TEST_ASSERT(inSuite, subscriptionInfo.mSubscriptionId == subscriptionInfo2.mSubscriptionId);
+    NL_TEST_ASSERT(inSuite, subscriptionInfo.mEventPaths.AllocatedSize() == 0);
+    NL_TEST_ASSERT(inSuite, !iterator->Next(subscriptionInfo));
+    iterator->Release();
+
+    // The index survives a restart
+    chip::app::IndexedSubscriptionResumptionStorage restartedStorage;
+    NL_TEST_ASSERT(inSuite, restartedStorage.Init(&storage) == CHIP_NO_ERROR);
+    iterator = restartedStorage.IterateSubscriptionSummaries();
+    NL_TEST_ASSERT(inSuite, iterator->Count() == 2);
+    iterator->Release();
+
+    NL_TEST_ASSERT(inSuite,
+                   restartedStorage.Delete(subscriptionInfo1.mNodeId, subscriptionInfo1.mFabricIndex,
+                                           subscriptionInfo1.mSubscriptionId) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   restartedStorage.Delete(subscriptionInfo1.mNodeId, subscriptionInfo1.mFabricIndex,
+                                           subscriptionInfo1.mSubscriptionId) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, restartedStorage.DeleteAll(subscriptionInfo2.mFabricIndex) == CHIP_NO_ERROR);
+
+    iterator = restartedStorage.IterateSubscriptions();
+    NL_TEST_ASSERT(inSuite, iterator->Count() == 0);
+    NL_TEST_ASSERT(inSuite, !iterator->Next(subscriptionInfo));
+    iterator->Release();
+
+    // Nothing is left in storage once all subscriptions are deleted
+    NL_TEST_ASSERT(inSuite, storage.GetNumKeys() == 0);
+}
+
+void TestIndexedSubscriptionMigration(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+
+    // Subscriptions persisted by SimpleSubscriptionResumptionStorage are picked up by the first Init
+    {
+        SimpleSubscriptionResumptionStorageTest simpleStorage;
+        simpleStorage.Init(&storage);
+
+        chip::app::SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo = { .mNodeId = 6666, .mFabricIndex = 46 };
+        for (size_t i = 0; i < (CHIP_IM_MAX_NUM_SUBSCRIPTIONS / 2); i++)
+        {
+            subscriptionInfo.mSubscriptionId = static_cast<chip::SubscriptionId>(i);
+            NL_TEST_ASSERT(inSuite, simpleStorage.Save(subscriptionInfo) == CHIP_NO_ERROR);
+        }
+    }
+    NL_TEST_ASSERT(inSuite, !storage.SyncDoesKeyExist(chip::DefaultStorageKeyAllocator::SubscriptionResumptionIndex().KeyName()));
+
+    chip::app::IndexedSubscriptionResumptionStorage subscriptionStorage;
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Init(&storage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storage.SyncDoesKeyExist(chip::DefaultStorageKeyAllocator::SubscriptionResumptionIndex().KeyName()));
+
+    auto * iterator = subscriptionStorage.IterateSubscriptions();
+    NL_TEST_ASSERT(inSuite, iterator->Count() == (CHIP_IM_MAX_NUM_SUBSCRIPTIONS / 2));
+    size_t count = 0;
+    chip::app::SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo;
+    while (iterator->Next(subscriptionInfo))
+    {
+        NL_TEST_ASSERT(inSuite, subscriptionInfo.mNodeId == 6666);
+        count++;
+    }
+    iterator->Release();
+    NL_TEST_ASSERT(inSuite, count == (CHIP_IM_MAX_NUM_SUBSCRIPTIONS / 2));
+
+    NL_TEST_ASSERT(inSuite, subscriptionStorage.Delete(6666, 46, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !storage.SyncDoesKeyExist(chip::DefaultStorageKeyAllocator::SubscriptionResumption(0).KeyName()));
+}
+
+void TestIndexedSubscriptionDowngrade(nlTestSuite * inSuite, void * inContext)
+{
+    chip::TestPersistentStorageDelegate storage;
+    chip::app::SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo = { .mNodeId = 8888, .mFabricIndex = 48 };
+
+    {
+        chip::app::IndexedSubscriptionResumptionStorage indexedStorage;
+        NL_TEST_ASSERT(inSuite, indexedStorage.Init(&storage) == CHIP_NO_ERROR);
+        for (chip::SubscriptionId subscriptionId = 1; subscriptionId <= 3; subscriptionId++)
+        {
+            subscriptionInfo.mSubscriptionId = subscriptionId;
+            NL_TEST_ASSERT(inSuite, indexedStorage.Save(subscriptionInfo) == CHIP_NO_ERROR);
+        }
+    }
+
+    // A firmware without the index deletes and adds subscriptions, leaving the index as it was
+    {
+        SimpleSubscriptionResumptionStorageTest simpleStorage;
+        NL_TEST_ASSERT(inSuite, simpleStorage.Init(&storage) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, simpleStorage.Delete(8888, 48, 1) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, simpleStorage.Delete(8888, 48, 2) == CHIP_NO_ERROR);
+        subscriptionInfo.mSubscriptionId = 4;
+        NL_TEST_ASSERT(inSuite, simpleStorage.Save(subscriptionInfo) == CHIP_NO_ERROR);
+    }
+
+    // After upgrading again the index is rebuilt from the slots
+    {
+        chip::app::IndexedSubscriptionResumptionStorage indexedStorage;
+        NL_TEST_ASSERT(inSuite, indexedStorage.Init(&storage) == CHIP_NO_ERROR);
+
+        auto * iterator = indexedStorage.IterateSubscriptionSummaries();
+        NL_TEST_ASSERT(inSuite, iterator->Count() == 2);
+        iterator->Release();
+
+        chip::app::SubscriptionResumptionStorage::SubscriptionInfo found;
+        NL_TEST_ASSERT(inSuite, indexedStorage.Find(8888, 48, 1, found) == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+        NL_TEST_ASSERT(inSuite, indexedStorage.Find(8888, 48, 3, found) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, found.mSubscriptionId == 3);
+        NL_TEST_ASSERT(inSuite, indexedStorage.Find(8888, 48, 4, found) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, found.mSubscriptionId == 4);
+    }
+
+    // Same once the firmware without the index deleted every subscription, including its max count
+    {
+        SimpleSubscriptionResumptionStorageTest simpleStorage;
+        NL_TEST_ASSERT(inSuite, simpleStorage.Init(&storage) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, simpleStorage.DeleteAll(48) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, storage.SyncDoesKeyExist(chip::DefaultStorageKeyAllocator::SubscriptionResumptionIndex().KeyName()));
+    {
+        chip::app::IndexedSubscriptionResumptionStorage indexedStorage;
+        NL_TEST_ASSERT(inSuite, indexedStorage.Init(&storage) == CHIP_NO_ERROR);
+
+        auto * iterator = indexedStorage.IterateSubscriptionSummaries();
+        NL_TEST_ASSERT(inSuite, iterator->Count() == 0);
+        iterator->Release();
+        NL_TEST_ASSERT(inSuite, storage.GetNumKeys() == 0);
+    }
+}
+
+void TestIndexedSubscriptionMaxCapacity(nlTestSuite * inSuite, void * inContext)
+{
+    ReadCountingStorageDelegate simpleBackingStorage;
+    ReadCountingStorageDelegate indexedBackingStorage;
+    SimpleSubscriptionResumptionStorageTest simpleStorage;
+    chip::app::IndexedSubscriptionResumptionStorage indexedStorage;
+    simpleStorage.Init(&simpleBackingStorage);
+    NL_TEST_ASSERT(inSuite, indexedStorage.Init(&indexedBackingStorage) == CHIP_NO_ERROR);
+
+    chip::app::SubscriptionResumptionStorage::SubscriptionInfo subscriptionInfo = { .mNodeId = 7777, .mFabricIndex = 47 };
+    subscriptionInfo.mAttributePaths.Calloc(4);
+    for (size_t i = 0; i < 4; i++)
+    {
+        subscriptionInfo.mAttributePaths[i].mEndpointId  = static_cast<chip::EndpointId>(i);
+        subscriptionInfo.mAttributePaths[i].mClusterId   = 6;
+        subscriptionInfo.mAttributePaths[i].mAttributeId = 0;
+    }
+
+    auto fillAndEmpty = [&](chip::app::SubscriptionResumptionStorage & subscriptionStorage, ReadCountingStorageDelegate & backing,
+                            const char * name) {
+        backing.mReadCount = 0;
+        auto start         = chip::System::SystemClock().GetMonotonicMicroseconds64();
+        for (size_t i = 0; i < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; i++)
+        {
+            subscriptionInfo.mSubscriptionId = static_cast<chip::SubscriptionId>(i);
+            NL_TEST_ASSERT(inSuite, subscriptionStorage.Save(subscriptionInfo) == CHIP_NO_ERROR);
+        }
+        auto saved       = chip::System::SystemClock().GetMonotonicMicroseconds64();
+        size_t saveReads = backing.mReadCount;
+
+        // Storage is full: a new subscription is rejected
+        subscriptionInfo.mSubscriptionId = CHIP_IM_MAX_NUM_SUBSCRIPTIONS;
+        NL_TEST_ASSERT(inSuite, subscriptionStorage.Save(subscriptionInfo) == CHIP_ERROR_NO_MEMORY);
+
+        backing.mReadCount = 0;
+        auto resumeStart   = chip::System::SystemClock().GetMonotonicMicroseconds64();
+        auto * iterator    = subscriptionStorage.IterateSubscriptionSummaries();
+        NL_TEST_ASSERT(inSuite, iterator->Count() == CHIP_IM_MAX_NUM_SUBSCRIPTIONS);
+        chip::app::SubscriptionResumptionStorage::SubscriptionInfo summary;
+        while (iterator->Next(summary))
+        {
+        }
+        iterator->Release();
+        auto resumed       = chip::System::SystemClock().GetMonotonicMicroseconds64();
+        size_t resumeReads = backing.mReadCount;
+
+        backing.mReadCount = 0;
+        auto deleteStart   = chip::System::SystemClock().GetMonotonicMicroseconds64();
+        for (size_t i = 0; i < CHIP_IM_MAX_NUM_SUBSCRIPTIONS; i++)
+        {
+            NL_TEST_ASSERT(inSuite,
+                           subscriptionStorage.Delete(subscriptionInfo.mNodeId, subscriptionInfo.mFabricIndex,
+                                                      static_cast<chip::SubscriptionId>(i)) == CHIP_NO_ERROR);
+        }
+        auto deleted       = chip::System::SystemClock().GetMonotonicMicroseconds64();
+        size_t deleteReads = backing.mReadCount;
+
+        ChipLogProgress(Test,
+                        "%s with %u subscriptions: save %u us (%u reads), resume scan %u us (%u reads), delete %u us (%u reads)",
+                        name, static_cast<unsigned>(CHIP_IM_MAX_NUM_SUBSCRIPTIONS), static_cast<unsigned>((saved - start).count()),
+                        static_cast<unsigned>(saveReads), static_cast<unsigned>((resumed - resumeStart).count()),
+                        static_cast<unsigned>(resumeReads), static_cast<unsigned>((deleted - deleteStart).count()),
+                        static_cast<unsigned>(deleteReads));
+
+        return saveReads + resumeReads + deleteReads;
+    };
+
+    size_t simpleReads  = fillAndEmpty(simpleStorage, simpleBackingStorage, "SimpleSubscriptionResumptionStorage");
+    size_t indexedReads = fillAndEmpty(indexedStorage, indexedBackingStorage, "IndexedSubscriptionResumptionStorage");
+
+    // The index is only read by Init(), so saving, deleting and scanning never read from storage
+    NL_TEST_ASSERT(inSuite, indexedReads == 0);
+    NL_TEST_ASSERT(inSuite, simpleReads > indexedReads);
+    NL_TEST_ASSERT(inSuite, indexedBackingStorage.GetNumKeys() == 0);
+}
+
 /**
  *  Set up the test suite.
  */
@@ -440,6 +718,10 @@ static const nlTest sTests[] =
     NL_TEST_DEF("TestSubscriptionStateUnexpectedFields", TestSubscriptionStateUnexpectedFields),
     NL_TEST_DEF("TestSubscriptionStateTooBigToLoad", TestSubscriptionStateTooBigToLoad),
     NL_TEST_DEF("TestSubscriptionStateJunkData", TestSubscriptionStateJunkData),
+    NL_TEST_DEF("TestIndexedSubscriptionState", TestIndexedSubscriptionState),
+    NL_TEST_DEF("TestIndexedSubscriptionMigration", TestIndexedSubscriptionMigration),
+    NL_TEST_DEF("TestIndexedSubscriptionDowngrade", TestIndexedSubscriptionDowngrade),
+    NL_TEST_DEF("TestIndexedSubscriptionMaxCapacity", TestIndexedSubscriptionMaxCapacity),
 
     NL_TEST_SENTINEL()
 };
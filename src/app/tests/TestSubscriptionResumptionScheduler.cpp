@@ -0,0 +1,341 @@
+/*
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/SubscriptionResumptionScheduler.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <nlunit-test.h>
+
+namespace {
+
+using namespace chip;
+using namespace chip::app;
+using SubscriptionInfo = SubscriptionResumptionStorage::SubscriptionInfo;
+using Milliseconds64   = System::Clock::Milliseconds64;
+using Timestamp        = System::Clock::Timestamp;
+
+constexpr size_t kMaxResumptions = CHIP_IM_MAX_NUM_SUBSCRIPTIONS;
+
+// Single timer driven by a simulated monotonic clock
+class TestTimerDelegate : public SubscriptionResumptionScheduler::TimerDelegate
+{
+public:
+    CHIP_ERROR StartTimer(reporting::TimerContext * context, System::Clock::Timeout aTimeout) override
+    {
+        mContext = context;
+        mExpiry  = mNow + aTimeout;
+        return CHIP_NO_ERROR;
+    }
+    void CancelTimer(reporting::TimerContext * context) override { mContext = nullptr; }
+    bool IsTimerActive(reporting::TimerContext * context) override { return mContext != nullptr; }
+    Timestamp GetCurrentMonotonicTimestamp() override { return mNow; }
+
+    reporting::TimerContext * mContext = nullptr;
+    Timestamp mExpiry                  = System::Clock::kZero;
+    Timestamp mNow                     = System::Clock::kZero;
+};
+
+// Simulates CASE session establishment taking a fixed time for every resumption
+class TestResumptionDelegate : public SubscriptionResumptionScheduler::Delegate
+{
+public:
+    struct Resumption
+    {
+        SubscriptionInfo mInfo;
+        Timestamp mStartTime;
+        Timestamp mDoneTime;
+        bool mDone;
+    };
+
+    CHIP_ERROR StartResumption(const SubscriptionInfo & subscriptionInfo) override
+    {
+        VerifyOrReturnError(mCount < kMaxResumptions, CHIP_ERROR_NO_MEMORY);
+
+        Resumption & resumption          = mResumptions[mCount++];
+        resumption.mInfo.mNodeId         = subscriptionInfo.mNodeId;
+        resumption.mInfo.mFabricIndex    = subscriptionInfo.mFabricIndex;
+        resumption.mInfo.mSubscriptionId = subscriptionInfo.mSubscriptionId;
+        resumption.mStartTime            = mTimer.mNow;
+        resumption.mDoneTime             = mTimer.mNow + mSessionEstablishmentTime;
+        resumption.mDone                 = false;
+
+        mInFlight++;
+        mPeakInFlight = std::max(mPeakInFlight, mInFlight);
+
+        if (mCompleteSynchronously)
+        {
+            Complete(resumption);
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    void Complete(Resumption & resumption)
+    {
+        resumption.mDone = true;
+        mInFlight--;
+        mScheduler.OnResumptionDone(resumption.mInfo.mNodeId, resumption.mInfo.mFabricIndex, resumption.mInfo.mSubscriptionId);
+    }
+
+    // Advance the simulated clock to the next timer expiry or session establishment, until nothing is left to do
+    void Run()
+    {
+        while (true)
+        {
+            Resumption * nextDone = nullptr;
+            for (size_t i = 0; i < mCount; i++)
+            {
+                if (!mResumptions[i].mDone && (nextDone == nullptr || mResumptions[i].mDoneTime < nextDone->mDoneTime))
+                {
+                    nextDone = &mResumptions[i];
+                }
+            }
+
+            if (nextDone != nullptr && (mTimer.mContext == nullptr || nextDone->mDoneTime <= mTimer.mExpiry))
+            {
+                mTimer.mNow = nextDone->mDoneTime;
+                Complete(*nextDone);
+            }
+            else if (mTimer.mContext != nullptr)
+            {
+                mTimer.mNow                       = std::max(mTimer.mNow, mTimer.mExpiry);
+                reporting::TimerContext * context = mTimer.mContext;
+                mTimer.mContext                   = nullptr;
+                context->TimerFired();
+            }
+            else
+            {
+                return;
+            }
+        }
+    }
+
+    const Resumption * Find(SubscriptionId subscriptionId) const
+    {
+        for (size_t i = 0; i < mCount; i++)
+        {
+            if (mResumptions[i].mInfo.mSubscriptionId == subscriptionId)
+            {
+                return &mResumptions[i];
+            }
+        }
+        return nullptr;
+    }
+
+    TestTimerDelegate mTimer;
+    SubscriptionResumptionScheduler mScheduler;
+    System::Clock::Timeout mSessionEstablishmentTime = System::Clock::Milliseconds32(500);
+    bool mCompleteSynchronously                      = false;
+    Resumption mResumptions[kMaxResumptions];
+    size_t mCount        = 0;
+    size_t mInFlight     = 0;
+    size_t mPeakInFlight = 0;
+};
+
+SubscriptionInfo MakeSubscriptionInfo(FabricIndex fabricIndex, SubscriptionId subscriptionId, uint16_t minInterval)
+{
+    SubscriptionInfo subscriptionInfo;
+    subscriptionInfo.mNodeId         = 0x1000 + fabricIndex;
+    subscriptionInfo.mFabricIndex    = fabricIndex;
+    subscriptionInfo.mSubscriptionId = subscriptionId;
+    subscriptionInfo.mMinInterval    = minInterval;
+    subscriptionInfo.mMaxInterval    = static_cast<uint16_t>(minInterval + 60);
+    return subscriptionInfo;
+}
+
+void TestOwnMinInterval(nlTestSuite * apSuite, void * apContext)
+{
+    TestResumptionDelegate test;
+    NL_TEST_ASSERT(apSuite, test.mScheduler.Init(&test.mTimer, &test, System::Clock::Milliseconds32(0)) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(apSuite, test.mScheduler.Schedule(MakeSubscriptionInfo(1, 1, 30)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, test.mScheduler.Schedule(MakeSubscriptionInfo(1, 2, 10)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, test.mScheduler.Schedule(MakeSubscriptionInfo(2, 3, 20)) == CHIP_NO_ERROR);
+    // Scheduling the same subscription again is a no-op
+    NL_TEST_ASSERT(apSuite, test.mScheduler.Schedule(MakeSubscriptionInfo(2, 3, 0)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, test.mScheduler.GetPendingCount() == 3);
+    NL_TEST_ASSERT(apSuite, test.mScheduler.IsScheduled(3));
+
+    // The timer is armed for the earliest subscription only
+    NL_TEST_ASSERT(apSuite, test.mTimer.mContext == &test.mScheduler);
+    NL_TEST_ASSERT(apSuite, test.mTimer.mExpiry == Milliseconds64(10000));
+
+    test.Run();
+
+    // Every subscription waited its own min interval instead of the largest one
+    NL_TEST_ASSERT(apSuite, test.mCount == 3);
+    NL_TEST_ASSERT(apSuite, test.Find(2)->mStartTime == Milliseconds64(10000));
+    NL_TEST_ASSERT(apSuite, test.Find(3)->mStartTime == Milliseconds64(20000));
+    NL_TEST_ASSERT(apSuite, test.Find(1)->mStartTime == Milliseconds64(30000));
+    NL_TEST_ASSERT(apSuite, test.mPeakInFlight == 1);
+    NL_TEST_ASSERT(apSuite, test.mScheduler.GetPendingCount() == 0);
+    NL_TEST_ASSERT(apSuite, test.mScheduler.GetInFlightCount() == 0);
+    NL_TEST_ASSERT(apSuite, !test.mScheduler.IsScheduled(3));
+
+    test.mScheduler.Shutdown();
+}
+
+void TestBoundedConcurrency(nlTestSuite * apSuite, void * apContext)
+{
+    TestResumptionDelegate test;
+    constexpr uint16_t kMinInterval = 5;
+    NL_TEST_ASSERT(apSuite, test.mScheduler.Init(&test.mTimer, &test) == CHIP_NO_ERROR);
+
+    // Fill the device with subscriptions that share the same min interval, the worst case for a reboot
+    for (size_t i = 0; i < kMaxResumptions; i++)
+    {
+        FabricIndex fabricIndex = static_cast<FabricIndex>(1 + i % CHIP_CONFIG_MAX_FABRICS);
+        NL_TEST_ASSERT(apSuite,
+                       test.mScheduler.Schedule(MakeSubscriptionInfo(fabricIndex, static_cast<SubscriptionId>(i), kMinInterval)) ==
+                           CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(apSuite,
+                   test.mScheduler.Schedule(MakeSubscriptionInfo(1, kMaxResumptions, kMinInterval)) == CHIP_ERROR_NO_MEMORY);
+
+    test.Run();
+
+    Timestamp lastDone = System::Clock::kZero;
+    for (size_t i = 0; i < test.mCount; i++)
+    {
+        // No subscription was resumed before its min interval
+        NL_TEST_ASSERT(apSuite, test.mResumptions[i].mStartTime >= System::Clock::Seconds16(kMinInterval));
+        lastDone = std::max(lastDone, test.mResumptions[i].mDoneTime);
+    }
+
+    ChipLogProgress(Test, "Resumed %u subscriptions: peak %u sessions in flight (burst: %u), fully resumed %u ms after reboot",
+                    static_cast<unsigned>(test.mCount), static_cast<unsigned>(test.mPeakInFlight),
+                    static_cast<unsigned>(kMaxResumptions), static_cast<unsigned>(lastDone.count()));
+
+    NL_TEST_ASSERT(apSuite, test.mCount == kMaxResumptions);
+    NL_TEST_ASSERT(apSuite, test.mPeakInFlight <= SubscriptionResumptionScheduler::kMaxConcurrent);
+    NL_TEST_ASSERT(apSuite, test.mInFlight == 0);
+
+    // Never slower than resuming in back-to-back batches of kMaxConcurrent once the jitter window is over
+    constexpr size_t kBatches =
+        (kMaxResumptions + SubscriptionResumptionScheduler::kMaxConcurrent - 1) / SubscriptionResumptionScheduler::kMaxConcurrent;
+    NL_TEST_ASSERT(apSuite,
+                   lastDone <= System::Clock::Seconds16(kMinInterval) +
+                           System::Clock::Milliseconds32(CHIP_CONFIG_SUBSCRIPTION_RESUMPTION_MAX_JITTER_MS) +
+                           test.mSessionEstablishmentTime * kBatches);
+
+    test.mScheduler.Shutdown();
+}
+
+void TestFabricFairness(nlTestSuite * apSuite, void * apContext)
+{
+    TestResumptionDelegate test;
+    NL_TEST_ASSERT(apSuite, test.mScheduler.Init(&test.mTimer, &test, System::Clock::Milliseconds32(0)) == CHIP_NO_ERROR);
+
+    // Fabric 1 has many subscriptions due slightly before the single one of fabric 2
+    constexpr SubscriptionId kBusyFabricSubscriptions = 6;
+    for (SubscriptionId i = 0; i < kBusyFabricSubscriptions; i++)
+    {
+        NL_TEST_ASSERT(apSuite, test.mScheduler.Schedule(MakeSubscriptionInfo(1, i, 1)) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(apSuite, test.mScheduler.Schedule(MakeSubscriptionInfo(2, 100, 1), System::Clock::Milliseconds32(1001)) ==
+                       CHIP_NO_ERROR);
+
+    test.Run();
+
+    // Fabric 2 gets the first slot that frees up once it is due, instead of waiting for all of fabric 1
+    NL_TEST_ASSERT(apSuite, test.mCount == kBusyFabricSubscriptions + 1);
+    size_t position = 0;
+    while (test.mResumptions[position].mInfo.mSubscriptionId != 100)
+    {
+        position++;
+    }
+    NL_TEST_ASSERT(apSuite, position <= SubscriptionResumptionScheduler::kMaxConcurrent);
+
+    test.mScheduler.Shutdown();
+}
+
+void TestCancelFabric(nlTestSuite * apSuite, void * apContext)
+{
+    TestResumptionDelegate test;
+    NL_TEST_ASSERT(apSuite, test.mScheduler.Init(&test.mTimer, &test, System::Clock::Milliseconds32(0)) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(apSuite, test.mScheduler.Schedule(MakeSubscriptionInfo(1, 1, 10)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, test.mScheduler.Schedule(MakeSubscriptionInfo(2, 2, 10)) == CHIP_NO_ERROR);
+    test.mScheduler.CancelFabric(1);
+    NL_TEST_ASSERT(apSuite, test.mScheduler.GetPendingCount() == 1);
+
+    test.Run();
+    NL_TEST_ASSERT(apSuite, test.mCount == 1);
+    NL_TEST_ASSERT(apSuite, test.Find(1) == nullptr);
+    NL_TEST_ASSERT(apSuite, test.Find(2) != nullptr);
+
+    // Cancelling the last pending subscription disarms the timer
+    NL_TEST_ASSERT(apSuite, test.mScheduler.Schedule(MakeSubscriptionInfo(1, 3, 10)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, test.mTimer.mContext != nullptr);
+    test.mScheduler.CancelFabric(1);
+    NL_TEST_ASSERT(apSuite, test.mTimer.mContext == nullptr);
+
+    test.mScheduler.Shutdown();
+}
+
+void TestSynchronousCompletion(nlTestSuite * apSuite, void * apContext)
+{
+    TestResumptionDelegate test;
+    test.mCompleteSynchronously = true;
+    NL_TEST_ASSERT(apSuite, test.mScheduler.Init(&test.mTimer, &test, System::Clock::Milliseconds32(0)) == CHIP_NO_ERROR);
+
+    for (SubscriptionId i = 0; i < 4; i++)
+    {
+        NL_TEST_ASSERT(apSuite, test.mScheduler.Schedule(MakeSubscriptionInfo(1, i, 0)) == CHIP_NO_ERROR);
+    }
+
+    // A single timer expiry starts every resumption since each one completes before the next is started
+    test.Run();
+    NL_TEST_ASSERT(apSuite, test.mCount == 4);
+    NL_TEST_ASSERT(apSuite, test.mPeakInFlight == 1);
+    NL_TEST_ASSERT(apSuite, test.mScheduler.GetInFlightCount() == 0);
+    NL_TEST_ASSERT(apSuite, test.mScheduler.GetPendingCount() == 0);
+
+    test.mScheduler.Shutdown();
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestOwnMinInterval", TestOwnMinInterval),
+    NL_TEST_DEF("TestBoundedConcurrency", TestBoundedConcurrency),
+    NL_TEST_DEF("TestFabricFairness", TestFabricFairness),
+    NL_TEST_DEF("TestCancelFabric", TestCancelFabric),
+    NL_TEST_DEF("TestSynchronousCompletion", TestSynchronousCompletion),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestSubscriptionResumptionScheduler()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "SubscriptionResumptionScheduler",
+        &sTests[0],
+        nullptr,
+        nullptr
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestSubscriptionResumptionScheduler)
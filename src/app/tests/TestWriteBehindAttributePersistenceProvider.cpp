@@ -0,0 +1,386 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app-common/zap-generated/attribute-type.h>
+#include <app/DefaultAttributePersistenceProvider.h>
+#include <app/WriteBehindAttributePersistenceProvider.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemLayer.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr ClusterId kOnOffCluster        = 0x0006;
+constexpr ClusterId kLevelControlCluster = 0x0008;
+
+const ConcreteAttributePath kOnOff(1, kOnOffCluster, 0x0000);
+const ConcreteAttributePath kCurrentLevel(1, kLevelControlCluster, 0x0000);
+const ConcreteAttributePath kOnLevel(1, kLevelControlCluster, 0x0011);
+const ConcreteAttributePath kStartUpCurrentLevel(1, kLevelControlCluster, 0x4000);
+
+EmberAfAttributeMetadata Uint8Attribute(AttributeId id)
+{
+    EmberAfAttributeMetadata metadata = { .defaultValue = EmberAfDefaultOrMinMaxAttributeValue(uint32_t(0)) };
+    metadata.attributeId              = id;
+    metadata.size                     = 1;
+    metadata.attributeType            = ZCL_INT8U_ATTRIBUTE_TYPE;
+    metadata.mask                     = ATTRIBUTE_MASK_NONVOLATILE;
+    return metadata;
+}
+
+/**
+ * Storage that counts the writes it gets.
+ */
+class CountingStorage : public TestPersistentStorageDelegate
+{
+public:
+    CHIP_ERROR SyncSetKeyValue(const char * key, const void * value, uint16_t size) override
+    {
+        mWrites++;
+        return TestPersistentStorageDelegate::SyncSetKeyValue(key, value, size);
+    }
+
+    size_t mWrites = 0;
+};
+
+/**
+ * System layer with a single timer, fired by advancing a simulated clock.
+ */
+class ManualTimerLayer : public System::Layer
+{
+public:
+    CHIP_ERROR Init() override { return CHIP_NO_ERROR; }
+    void Shutdown() override {}
+    bool IsInitialized() const override { return true; }
+
+    CHIP_ERROR StartTimer(System::Clock::Timeout aDelay, System::TimerCompleteCallback aComplete, void * aAppState) override
+    {
+        mCallback = aComplete;
+        mAppState = aAppState;
+        mFireTime = mNow + aDelay;
+        return CHIP_NO_ERROR;
+    }
+    CHIP_ERROR ExtendTimerTo(System::Clock::Timeout aDelay, System::TimerCompleteCallback aComplete, void * aAppState) override
+    {
+        return StartTimer(aDelay, aComplete, aAppState);
+    }
+    bool IsTimerActive(System::TimerCompleteCallback aComplete, void * aAppState) override
+    {
+        return mCallback == aComplete && mAppState == aAppState;
+    }
+    void CancelTimer(System::TimerCompleteCallback aComplete, void * aAppState) override
+    {
+        if (IsTimerActive(aComplete, aAppState))
+        {
+            mCallback = nullptr;
+        }
+    }
+    CHIP_ERROR ScheduleWork(System::TimerCompleteCallback aComplete, void * aAppState) override
+    {
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+    void AdvanceClock(System::Clock::Milliseconds64 aTime)
+    {
+        mNow += aTime;
+        if (mCallback != nullptr && mNow >= mFireTime)
+        {
+            System::TimerCompleteCallback callback = mCallback;
+            mCallback                              = nullptr;
+            callback(this, mAppState);
+        }
+    }
+
+private:
+    System::Clock::Timestamp mNow{ 0 };
+    System::Clock::Timestamp mFireTime{ 0 };
+    System::TimerCompleteCallback mCallback = nullptr;
+    void * mAppState                        = nullptr;
+};
+
+CHIP_ERROR WriteUint8(AttributePersistenceProvider & aProvider, const ConcreteAttributePath & aPath, uint8_t aValue)
+{
+    return aProvider.WriteValue(aPath, ByteSpan(&aValue, sizeof(aValue)));
+}
+
+uint8_t ReadUint8(nlTestSuite * apSuite, AttributePersistenceProvider & aProvider, const ConcreteAttributePath & aPath)
+{
+    EmberAfAttributeMetadata metadata = Uint8Attribute(aPath.mAttributeId);
+    uint8_t value                     = 0;
+    MutableByteSpan span(&value, sizeof(value));
+    NL_TEST_ASSERT(apSuite, aProvider.ReadValue(aPath, &metadata, span) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, span.size() == sizeof(value));
+    return value;
+}
+
+void TestLastWriteWins(nlTestSuite * apSuite, void * apContext)
+{
+    CountingStorage storage;
+    ManualTimerLayer systemLayer;
+    WriteBehindAttributePersistenceProvider provider;
+    NL_TEST_ASSERT(apSuite, provider.Init(&storage, &systemLayer) == CHIP_NO_ERROR);
+
+    for (uint8_t level = 1; level <= 10; level++)
+    {
+        NL_TEST_ASSERT(apSuite, WriteUint8(provider, kCurrentLevel, level) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(apSuite, storage.mWrites == 0);
+    NL_TEST_ASSERT(apSuite, ReadUint8(apSuite, provider, kCurrentLevel) == 10);
+
+    // The timer runs from the first change, so values that keep changing are still stored
+    systemLayer.AdvanceClock(WriteBehindAttributePersistenceProvider::kFlushInterval - System::Clock::Milliseconds32(1));
+    NL_TEST_ASSERT(apSuite, WriteUint8(provider, kCurrentLevel, 11) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, storage.mWrites == 0);
+    systemLayer.AdvanceClock(System::Clock::Milliseconds32(1));
+    NL_TEST_ASSERT(apSuite, storage.mWrites == 1);
+    NL_TEST_ASSERT(apSuite, ReadUint8(apSuite, provider, kCurrentLevel) == 11);
+
+    // A value written after the flush replaces the stored one
+    NL_TEST_ASSERT(apSuite, WriteUint8(provider, kCurrentLevel, 12) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, ReadUint8(apSuite, provider, kCurrentLevel) == 12);
+    provider.Shutdown();
+    NL_TEST_ASSERT(apSuite, storage.mWrites == 2);
+
+    WriteBehindAttributePersistenceProvider rebooted;
+    NL_TEST_ASSERT(apSuite, rebooted.Init(&storage, &systemLayer) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, ReadUint8(apSuite, rebooted, kCurrentLevel) == 12);
+    rebooted.Shutdown();
+}
+
+void TestOneRecordPerCluster(nlTestSuite * apSuite, void * apContext)
+{
+    CountingStorage storage;
+    ManualTimerLayer systemLayer;
+    WriteBehindAttributePersistenceProvider provider;
+    NL_TEST_ASSERT(apSuite, provider.Init(&storage, &systemLayer) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(apSuite, WriteUint8(provider, kCurrentLevel, 100) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, WriteUint8(provider, kOnLevel, 200) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, WriteUint8(provider, kOnOff, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, provider.Flush() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, storage.mWrites == 2);
+    NL_TEST_ASSERT(apSuite, storage.GetNumKeys() == 2);
+    NL_TEST_ASSERT(apSuite,
+                   storage.HasKey(DefaultStorageKeyAllocator::ClusterAttributeValues(1, kLevelControlCluster).KeyName()));
+    NL_TEST_ASSERT(apSuite, storage.HasKey(DefaultStorageKeyAllocator::ClusterAttributeValues(1, kOnOffCluster).KeyName()));
+
+    // Changing one attribute keeps the others of its cluster
+    NL_TEST_ASSERT(apSuite, WriteUint8(provider, kStartUpCurrentLevel, 50) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, WriteUint8(provider, kCurrentLevel, 101) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, provider.Flush() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, storage.mWrites == 3);
+    NL_TEST_ASSERT(apSuite, ReadUint8(apSuite, provider, kCurrentLevel) == 101);
+    NL_TEST_ASSERT(apSuite, ReadUint8(apSuite, provider, kOnLevel) == 200);
+    NL_TEST_ASSERT(apSuite, ReadUint8(apSuite, provider, kStartUpCurrentLevel) == 50);
+    NL_TEST_ASSERT(apSuite, ReadUint8(apSuite, provider, kOnOff) == 1);
+
+    // Nothing to store
+    NL_TEST_ASSERT(apSuite, provider.Flush() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, storage.mWrites == 3);
+    provider.Shutdown();
+}
+
+void TestValuesStoredOnTheirOwn(nlTestSuite * apSuite, void * apContext)
+{
+    CountingStorage storage;
+    ManualTimerLayer systemLayer;
+
+    // A value stored before records were used is read, and its key removed once the record holds it
+    DefaultAttributePersistenceProvider previous;
+    NL_TEST_ASSERT(apSuite, previous.Init(&storage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, WriteUint8(previous, kOnLevel, 42) == CHIP_NO_ERROR);
+    const StorageKeyName onLevelKey =
+        DefaultStorageKeyAllocator::AttributeValue(kOnLevel.mEndpointId, kOnLevel.mClusterId, kOnLevel.mAttributeId);
+
+    WriteBehindAttributePersistenceProvider provider;
+    NL_TEST_ASSERT(apSuite, provider.Init(&storage, &systemLayer) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, ReadUint8(apSuite, provider, kOnLevel) == 42);
+    NL_TEST_ASSERT(apSuite, WriteUint8(provider, kOnLevel, 43) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, provider.Flush() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, !storage.HasKey(onLevelKey.KeyName()));
+    NL_TEST_ASSERT(apSuite, ReadUint8(apSuite, provider, kOnLevel) == 43);
+
+    // A value that does not fit in the record of its cluster is stored under its own key
+    const ConcreteAttributePath label(1, kLevelControlCluster, 0xFFF10000);
+    uint8_t longString[WriteBehindAttributePersistenceProvider::kRecordSize];
+    memset(longString, 'a', sizeof(longString));
+    // Long strings have a little-endian 2-byte length prefix
+    longString[0] = static_cast<uint8_t>((sizeof(longString) - 2) & 0xFF);
+    longString[1] = static_cast<uint8_t>((sizeof(longString) - 2) >> 8);
+    NL_TEST_ASSERT(apSuite, provider.WriteValue(label, ByteSpan(longString)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, provider.Flush() == CHIP_NO_ERROR);
+    const StorageKeyName labelKey =
+        DefaultStorageKeyAllocator::AttributeValue(label.mEndpointId, label.mClusterId, label.mAttributeId);
+    NL_TEST_ASSERT(apSuite, storage.HasKey(labelKey.KeyName()));
+
+    EmberAfAttributeMetadata metadata = { .defaultValue = EmberAfDefaultOrMinMaxAttributeValue(uint32_t(0)) };
+    metadata.attributeId              = label.mAttributeId;
+    metadata.size                     = static_cast<uint16_t>(sizeof(longString));
+    metadata.attributeType            = ZCL_LONG_CHAR_STRING_ATTRIBUTE_TYPE;
+    uint8_t readBack[sizeof(longString)];
+    MutableByteSpan readSpan(readBack);
+    NL_TEST_ASSERT(apSuite, provider.ReadValue(label, &metadata, readSpan) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, readSpan.data_equal(ByteSpan(longString)));
+    NL_TEST_ASSERT(apSuite, ReadUint8(apSuite, provider, kOnLevel) == 43);
+    provider.Shutdown();
+}
+
+void TestFullCacheIsFlushed(nlTestSuite * apSuite, void * apContext)
+{
+    CountingStorage storage;
+    ManualTimerLayer systemLayer;
+    WriteBehindAttributePersistenceProvider provider;
+    NL_TEST_ASSERT(apSuite, provider.Init(&storage, &systemLayer) == CHIP_NO_ERROR);
+
+    for (EndpointId endpoint = 1; endpoint <= WriteBehindAttributePersistenceProvider::kCacheSize; endpoint++)
+    {
+        const ConcreteAttributePath currentLevel(endpoint, kLevelControlCluster, 0);
+        NL_TEST_ASSERT(apSuite, WriteUint8(provider, currentLevel, static_cast<uint8_t>(endpoint)) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(apSuite, storage.mWrites == 0);
+
+    const EndpointId lastEndpoint = static_cast<EndpointId>(WriteBehindAttributePersistenceProvider::kCacheSize + 1);
+    NL_TEST_ASSERT(apSuite, WriteUint8(provider, ConcreteAttributePath(lastEndpoint, kLevelControlCluster, 0), 7) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, storage.mWrites == WriteBehindAttributePersistenceProvider::kCacheSize);
+
+    for (EndpointId endpoint = 1; endpoint <= lastEndpoint; endpoint++)
+    {
+        NL_TEST_ASSERT(apSuite,
+                       ReadUint8(apSuite, provider, ConcreteAttributePath(endpoint, kLevelControlCluster, 0)) ==
+                           (endpoint == lastEndpoint ? 7 : endpoint));
+    }
+    provider.Shutdown();
+}
+
+/**
+ * Storage writes while the level of a dimmable light ramps up and down continuously, as with a dimmer held down: a
+ * MoveToLevelWithOnOff from 1 to 254 over 10 s, i.e. a CurrentLevel change every 40 ms, and back down, with OnOff turning on
+ * and off at each end of the ramp.
+ */
+size_t CountRampWrites(nlTestSuite * apSuite, AttributePersistenceProvider & aProvider, CountingStorage & aStorage,
+                       ManualTimerLayer & aSystemLayer, System::Clock::Seconds32 aDuration)
+{
+    constexpr System::Clock::Milliseconds32 kStep(40);
+    const size_t steps = static_cast<size_t>(aDuration / kStep);
+    uint8_t level      = 1;
+    int8_t direction   = 1;
+    for (size_t i = 0; i < steps; i++)
+    {
+        if (level == 1)
+        {
+            NL_TEST_ASSERT(apSuite, WriteUint8(aProvider, kOnOff, direction > 0) == CHIP_NO_ERROR);
+        }
+        NL_TEST_ASSERT(apSuite, WriteUint8(aProvider, kCurrentLevel, level) == CHIP_NO_ERROR);
+        level = static_cast<uint8_t>(level + direction);
+        if (level == 1 || level == 254)
+        {
+            direction = static_cast<int8_t>(-direction);
+        }
+        aSystemLayer.AdvanceClock(kStep);
+    }
+    return aStorage.mWrites;
+}
+
+void TestLevelControlRamp(nlTestSuite * apSuite, void * apContext)
+{
+    constexpr System::Clock::Seconds32 kDuration(60);
+
+    CountingStorage directStorage;
+    ManualTimerLayer directLayer;
+    DefaultAttributePersistenceProvider direct;
+    NL_TEST_ASSERT(apSuite, direct.Init(&directStorage) == CHIP_NO_ERROR);
+    const size_t directWrites = CountRampWrites(apSuite, direct, directStorage, directLayer, kDuration);
+
+    CountingStorage storage;
+    ManualTimerLayer systemLayer;
+    WriteBehindAttributePersistenceProvider provider;
+    NL_TEST_ASSERT(apSuite, provider.Init(&storage, &systemLayer) == CHIP_NO_ERROR);
+    const size_t writeBehindWrites = CountRampWrites(apSuite, provider, storage, systemLayer, kDuration);
+    const uint8_t lastLevel        = ReadUint8(apSuite, provider, kCurrentLevel);
+    provider.Shutdown();
+
+    ChipLogProgress(Test, "Level control ramp over %u s, flushing every %u ms:", static_cast<unsigned>(kDuration.count()),
+                    static_cast<unsigned>(WriteBehindAttributePersistenceProvider::kFlushInterval.count()));
+    ChipLogProgress(Test, "  DefaultAttributePersistenceProvider: %u writes", static_cast<unsigned>(directWrites));
+    ChipLogProgress(Test, "  WriteBehindAttributePersistenceProvider: %u writes", static_cast<unsigned>(writeBehindWrites));
+
+    // At most one write per cluster per flush interval
+    const size_t flushes = kDuration / WriteBehindAttributePersistenceProvider::kFlushInterval;
+    NL_TEST_ASSERT(apSuite, writeBehindWrites <= 2 * flushes);
+    NL_TEST_ASSERT(apSuite, writeBehindWrites * 10 < directWrites);
+
+    // The last level is stored on shutdown
+    WriteBehindAttributePersistenceProvider rebooted;
+    NL_TEST_ASSERT(apSuite, rebooted.Init(&storage, &systemLayer) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, ReadUint8(apSuite, rebooted, kCurrentLevel) == lastLevel);
+    rebooted.Shutdown();
+}
+
+int Initialize(void * apSuite)
+{
+    VerifyOrReturnError(Platform::MemoryInit() == CHIP_NO_ERROR, FAILURE);
+    return SUCCESS;
+}
+
+int Finalize(void * apSuite)
+{
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+// clang-format off
+const nlTest sTests[] =
+{
+    NL_TEST_DEF("TestLastWriteWins", TestLastWriteWins),
+    NL_TEST_DEF("TestOneRecordPerCluster", TestOneRecordPerCluster),
+    NL_TEST_DEF("TestValuesStoredOnTheirOwn", TestValuesStoredOnTheirOwn),
+    NL_TEST_DEF("TestFullCacheIsFlushed", TestFullCacheIsFlushed),
+    NL_TEST_DEF("TestLevelControlRamp", TestLevelControlRamp),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+} // namespace
+
+int TestWriteBehindAttributePersistenceProvider()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "WriteBehindAttributePersistenceProvider",
+        &sTests[0],
+        Initialize,
+        Finalize
+    };
+    // clang-format on
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestWriteBehindAttributePersistenceProvider)
@@ -0,0 +1,213 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/util/DynamicEndpointRegistry.h>
+
+#include <app/util/attribute-storage.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+// Defers the PartsList reports of a batch of endpoint changes to the end of its scope.
+class ScopedPartsListDeferral
+{
+public:
+    ScopedPartsListDeferral() { emberAfBeginDeferredPartsListReporting(); }
+    ~ScopedPartsListDeferral() { emberAfEndDeferredPartsListReporting(); }
+};
+
+} // namespace
+
+CHIP_ERROR DynamicEndpointRegistry::Init(uint8_t maxServerClustersPerEndpoint, uint16_t capacity)
+{
+    VerifyOrReturnError(mCapacity == 0, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(capacity > 0 && capacity != kInvalidSlot, CHIP_ERROR_INVALID_ARGUMENT);
+
+    VerifyOrReturnError(mSlots.Calloc(capacity), CHIP_ERROR_NO_MEMORY);
+    if (maxServerClustersPerEndpoint > 0 &&
+        !mDataVersions.Calloc(static_cast<size_t>(capacity) * static_cast<size_t>(maxServerClustersPerEndpoint)))
+    {
+        mSlots.Free();
+        return CHIP_ERROR_NO_MEMORY;
+    }
+
+    // Chain the free list so that the lowest dynamic indices are used first.
+    for (uint16_t i = 0; i < capacity; ++i)
+    {
+        mSlots[i].nextFree = static_cast<uint16_t>(i + 1 < capacity ? i + 1 : kInvalidSlot);
+    }
+
+    mCapacity           = capacity;
+    mCount              = 0;
+    mFirstFree          = 0;
+    mMaxClustersPerSlot = maxServerClustersPerEndpoint;
+    return CHIP_NO_ERROR;
+}
+
+void DynamicEndpointRegistry::Shutdown()
+{
+    VerifyOrReturn(mCapacity != 0);
+
+    if (mCount > 0)
+    {
+        ScopedPartsListDeferral deferral;
+        for (uint16_t slot = 0; slot < mCapacity; ++slot)
+        {
+            if (mSlots[slot].endpointTemplate != nullptr)
+            {
+                emberAfClearDynamicEndpoint(slot);
+                ReleaseSlot(slot);
+            }
+        }
+    }
+
+    mSlots.Free();
+    mDataVersions.Free();
+    mCapacity           = 0;
+    mCount              = 0;
+    mFirstFree          = kInvalidSlot;
+    mMaxClustersPerSlot = 0;
+}
+
+CHIP_ERROR DynamicEndpointRegistry::AddEndpoint(EndpointId id, const DynamicEndpointTemplate & endpointTemplate,
+                                                EndpointId parentId)
+{
+    VerifyOrReturnError(mCapacity != 0, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(id != kInvalidEndpointId && endpointTemplate.endpointType != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(emberAfClusterCountForEndpointType(endpointTemplate.endpointType, /* server = */ true) <=
+                            mMaxClustersPerSlot,
+                        CHIP_ERROR_BUFFER_TOO_SMALL);
+    VerifyOrReturnError(mFirstFree != kInvalidSlot, CHIP_ERROR_NO_MEMORY);
+
+    uint16_t slot = mFirstFree;
+    Span<DataVersion> dataVersions;
+    if (mMaxClustersPerSlot > 0)
+    {
+        dataVersions = Span<DataVersion>(&mDataVersions[static_cast<size_t>(slot) * mMaxClustersPerSlot], mMaxClustersPerSlot);
+    }
+
+    EmberAfStatus status =
+        emberAfSetDynamicEndpoint(slot, id, endpointTemplate.endpointType, dataVersions, endpointTemplate.deviceTypes, parentId);
+    switch (status)
+    {
+    case EMBER_ZCL_STATUS_SUCCESS:
+        break;
+    case EMBER_ZCL_STATUS_DUPLICATE_EXISTS:
+        return CHIP_ERROR_DUPLICATE_KEY_ID;
+    case EMBER_ZCL_STATUS_RESOURCE_EXHAUSTED:
+        // The registry was configured with more slots than the attribute storage has.
+        return CHIP_ERROR_NO_MEMORY;
+    case EMBER_ZCL_STATUS_CONSTRAINT_ERROR:
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    default:
+        ChipLogError(DataManagement, "Failed to add dynamic endpoint %u: 0x%02x", id, to_underlying(status));
+        return CHIP_ERROR_INTERNAL;
+    }
+
+    mFirstFree                    = mSlots[slot].nextFree;
+    mSlots[slot].endpointTemplate = &endpointTemplate;
+    mSlots[slot].nextFree         = kInvalidSlot;
+    mCount++;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DynamicEndpointRegistry::RemoveEndpoint(EndpointId id)
+{
+    uint16_t slot = FindSlot(id);
+    VerifyOrReturnError(slot != kInvalidSlot, CHIP_ERROR_NOT_FOUND);
+
+    emberAfClearDynamicEndpoint(slot);
+    ReleaseSlot(slot);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DynamicEndpointRegistry::AddEndpoints(Span<const EndpointDescription> endpoints)
+{
+    VerifyOrReturnError(endpoints.size() <= static_cast<size_t>(mCapacity - mCount), CHIP_ERROR_NO_MEMORY);
+
+    ScopedPartsListDeferral deferral;
+    for (size_t i = 0; i < endpoints.size(); ++i)
+    {
+        const EndpointDescription & description = endpoints[i];
+        CHIP_ERROR err                          = (description.endpointTemplate == nullptr)
+                                     ? CHIP_ERROR_INVALID_ARGUMENT
+                                     : AddEndpoint(description.id, *description.endpointTemplate, description.parentId);
+        if (err != CHIP_NO_ERROR)
+        {
+            // Roll back so that the batch is applied atomically.
+            while (i-- > 0)
+            {
+                RemoveEndpoint(endpoints[i].id);
+            }
+            return err;
+        }
+    }
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DynamicEndpointRegistry::RemoveEndpoints(Span<const EndpointId> ids)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    ScopedPartsListDeferral deferral;
+    for (EndpointId id : ids)
+    {
+        if (RemoveEndpoint(id) != CHIP_NO_ERROR)
+        {
+            err = CHIP_ERROR_NOT_FOUND;
+        }
+    }
+    return err;
+}
+
+const DynamicEndpointTemplate * DynamicEndpointRegistry::GetTemplate(EndpointId id) const
+{
+    uint16_t slot = FindSlot(id);
+    return (slot == kInvalidSlot) ? nullptr : mSlots[slot].endpointTemplate;
+}
+
+uint16_t DynamicEndpointRegistry::GetDynamicIndex(EndpointId id) const
+{
+    uint16_t slot = FindSlot(id);
+    return (slot == kInvalidSlot) ? kEmberInvalidEndpointIndex : slot;
+}
+
+uint16_t DynamicEndpointRegistry::FindSlot(EndpointId id) const
+{
+    uint16_t slot = emberAfGetDynamicIndexFromEndpoint(id);
+    // The slot may belong to an endpoint that was set up without this registry.
+    if (slot >= mCapacity || mSlots[slot].endpointTemplate == nullptr)
+    {
+        return kInvalidSlot;
+    }
+    return slot;
+}
+
+void DynamicEndpointRegistry::ReleaseSlot(uint16_t slot)
+{
+    mSlots[slot].endpointTemplate = nullptr;
+    mSlots[slot].nextFree         = mFirstFree;
+    mFirstFree                    = slot;
+    mCount--;
+}
+
+} // namespace app
+} // namespace chip
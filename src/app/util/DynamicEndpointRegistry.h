@@ -0,0 +1,157 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/util/af-types.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/Span.h>
+#include <platform/CHIPDeviceConfig.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Composition shared by any number of dynamic endpoints, e.g. "bridged light".
+ * The endpoint type and device type list must outlive every endpoint that is
+ * added with this template; registering a template costs nothing per endpoint.
+ */
+struct DynamicEndpointTemplate
+{
+    const EmberAfEndpointType * endpointType = nullptr;
+    Span<const EmberAfDeviceType> deviceTypes;
+};
+
+/**
+ * Manages the dynamic endpoint slots of the ember attribute storage for
+ * applications, typically bridges, that expose large and frequently changing
+ * sets of endpoints.
+ *
+ * All per-endpoint state (the template pointer and the DataVersion storage)
+ * lives in two slabs allocated once by Init(), indexed by the ember dynamic
+ * endpoint index.  Free slots are kept on a free list and endpoint ids are
+ * resolved through the hashed endpoint index of the attribute storage, so
+ * adding or removing an endpoint is O(1) regardless of how many are present.
+ *
+ * AddEndpoints() and RemoveEndpoints() defer the Descriptor PartsList reports
+ * until the whole batch is applied, so a batch marks each affected PartsList
+ * dirty once instead of once per endpoint.
+ *
+ * Must only be used with the Matter stack lock held.  At most one registry
+ * should own the dynamic endpoint slots at any time.
+ */
+class DynamicEndpointRegistry
+{
+public:
+    struct EndpointDescription
+    {
+        EndpointId id                                    = kInvalidEndpointId;
+        const DynamicEndpointTemplate * endpointTemplate = nullptr;
+        EndpointId parentId                              = kInvalidEndpointId;
+    };
+
+    DynamicEndpointRegistry() = default;
+    ~DynamicEndpointRegistry() { Shutdown(); }
+
+    DynamicEndpointRegistry(const DynamicEndpointRegistry &)             = delete;
+    DynamicEndpointRegistry & operator=(const DynamicEndpointRegistry &) = delete;
+
+    /**
+     * Allocate storage for up to `capacity` endpoints, each exposing at most
+     * `maxServerClustersPerEndpoint` server clusters.  `capacity` must not
+     * exceed the number of dynamic endpoint slots of the attribute storage.
+     */
+    CHIP_ERROR Init(uint8_t maxServerClustersPerEndpoint, uint16_t capacity = CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT);
+
+    /**
+     * Remove every endpoint that was added through this registry and release
+     * its storage.
+     */
+    void Shutdown();
+
+    /**
+     * Add and enable an endpoint.
+     *
+     * @retval CHIP_ERROR_INVALID_ARGUMENT   invalid id or template.
+     * @retval CHIP_ERROR_DUPLICATE_KEY_ID   an endpoint with this id already exists.
+     * @retval CHIP_ERROR_NO_MEMORY          the registry is full.
+     * @retval CHIP_ERROR_BUFFER_TOO_SMALL   the template has more server clusters than
+     *                                       configured in Init().
+     */
+    CHIP_ERROR AddEndpoint(EndpointId id, const DynamicEndpointTemplate & endpointTemplate,
+                           EndpointId parentId = kInvalidEndpointId);
+
+    /**
+     * Disable and remove an endpoint added through this registry.
+     *
+     * @retval CHIP_ERROR_NOT_FOUND   no such endpoint in this registry.
+     */
+    CHIP_ERROR RemoveEndpoint(EndpointId id);
+
+    /**
+     * Add all the given endpoints, or none of them: on failure the endpoints
+     * already added by this call are removed again.
+     */
+    CHIP_ERROR AddEndpoints(Span<const EndpointDescription> endpoints);
+
+    /**
+     * Remove all the given endpoints.  Ids that are not in the registry are
+     * skipped; CHIP_ERROR_NOT_FOUND is returned if there were any.
+     */
+    CHIP_ERROR RemoveEndpoints(Span<const EndpointId> ids);
+
+    bool Contains(EndpointId id) const { return FindSlot(id) != kInvalidSlot; }
+
+    /**
+     * Returns the template the endpoint was added with, or nullptr.
+     */
+    const DynamicEndpointTemplate * GetTemplate(EndpointId id) const;
+
+    /**
+     * Returns the ember dynamic endpoint index of the endpoint, or
+     * kEmberInvalidEndpointIndex.
+     */
+    uint16_t GetDynamicIndex(EndpointId id) const;
+
+    uint16_t Count() const { return mCount; }
+    uint16_t Capacity() const { return mCapacity; }
+
+private:
+    static constexpr uint16_t kInvalidSlot = UINT16_MAX;
+
+    struct Slot
+    {
+        // nullptr when the slot is free.
+        const DynamicEndpointTemplate * endpointTemplate = nullptr;
+        uint16_t nextFree                                = kInvalidSlot;
+    };
+
+    uint16_t FindSlot(EndpointId id) const;
+    void ReleaseSlot(uint16_t slot);
+
+    Platform::ScopedMemoryBuffer<Slot> mSlots;
+    Platform::ScopedMemoryBuffer<DataVersion> mDataVersions;
+    uint16_t mCapacity          = 0;
+    uint16_t mCount             = 0;
+    uint16_t mFirstFree         = kInvalidSlot;
+    uint8_t mMaxClustersPerSlot = 0;
+};
+
+} // namespace app
+} // namespace chip
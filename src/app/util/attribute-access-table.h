@@ -0,0 +1,497 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Compile-time lookup tables for the attributes of the fixed endpoints
+ *      described by zap-generated/endpoint_config.h.
+ *
+ *      The tables are instantiated by zap-generated/attribute_access_tables.h
+ *      and replace the linear searches of the attribute storage with perfect
+ *      hash lookups when CHIP_CONFIG_ATTRIBUTE_ACCESS_TABLES is enabled.
+ */
+
+#pragma once
+
+#include <app-common/zap-generated/attribute-type.h>
+#include <app/att-storage.h>
+#include <app/util/af-types.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/CodeUtils.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * How the value of an attribute is copied in and out of the attribute storage.
+ */
+enum class AttributeAccessor : uint8_t
+{
+    kFixedSize1, ///< Plain value of 1 byte.
+    kFixedSize2, ///< Plain value of 2 bytes.
+    kFixedSize4, ///< Plain value of 4 bytes.
+    kFixedSize8, ///< Plain value of 8 bytes.
+    kFixedSize,  ///< Plain value of any other size.
+    kString,     ///< String with a 1 byte length prefix.
+    kLongString, ///< String with a 2 bytes length prefix.
+    kList,       ///< List, only its 2 bytes length is stored.
+};
+
+namespace Internal {
+
+// Perfect hashing uses the "hash and displace" scheme: keys are spread over buckets by a first hash, and every bucket
+// records the seed of a second hash that sends its keys to distinct slots.  Seeds are searched downwards from 255 so
+// that they can never be confused with the bucket sizes they replace while the table is being built.
+static constexpr uint8_t kPerfectHashMaxSeed         = 255;
+static constexpr uint8_t kPerfectHashMinSeed         = 128;
+static constexpr uint16_t kPerfectHashInvalidIndex   = UINT16_MAX;
+static constexpr size_t kPerfectHashMaxBucketSize    = kPerfectHashMinSeed - 1;
+static constexpr size_t kPerfectHashMaxSlotsPerTable = UINT16_MAX;
+
+constexpr uint32_t PerfectHash(uint32_t key, uint8_t seed)
+{
+    uint32_t hash = key ^ (seed * 0x9E3779B9u);
+    hash ^= hash >> 16;
+    hash *= 0x7FEB352Du;
+    hash ^= hash >> 15;
+    hash *= 0x846CA68Bu;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+/**
+ * Number of slots of a table holding keyCount keys: the smallest power of two, at least 2, keeping the load at or
+ * below 3/4.  Every table has half as many buckets as slots.
+ */
+constexpr size_t PerfectHashSlotCount(size_t keyCount)
+{
+    size_t slotCount = 2;
+    while (slotCount * 3 < keyCount * 4)
+    {
+        slotCount *= 2;
+    }
+    return slotCount;
+}
+
+/**
+ * Places keys 0 to keyCount - 1 for which isKey(i) holds in slots, storing i in the slot of keyAt(i).  slots must be
+ * filled with kPerfectHashInvalidIndex and hold slotMask + 1 entries, seeds (slotMask + 1) / 2 entries.
+ */
+template <typename KeyAt, typename IsKey>
+constexpr bool PlacePerfectHashKeys(KeyAt keyAt, IsKey isKey, size_t keyCount, uint16_t * slots, uint8_t * seeds,
+                                    uint16_t slotMask)
+{
+    const uint16_t bucketMask = static_cast<uint16_t>(slotMask >> 1);
+
+    // Seeds hold the bucket sizes until the buckets are placed.
+    size_t maxBucketSize = 0;
+    for (size_t i = 0; i < keyCount; i++)
+    {
+        if (isKey(i))
+        {
+            uint8_t & size = seeds[PerfectHash(keyAt(i), 0) & bucketMask];
+            if (size == kPerfectHashMaxBucketSize)
+            {
+                return false;
+            }
+            size++;
+            maxBucketSize = (size > maxBucketSize) ? size : maxBucketSize;
+        }
+    }
+
+    // Place the largest buckets first, while most slots are free.
+    for (size_t size = maxBucketSize; size > 0; size--)
+    {
+        for (size_t bucket = 0; bucket <= bucketMask; bucket++)
+        {
+            if (seeds[bucket] != size)
+            {
+                continue;
+            }
+
+            bool placed = false;
+            for (uint8_t seed = kPerfectHashMaxSeed; !placed && seed >= kPerfectHashMinSeed; seed--)
+            {
+                placed = true;
+                for (size_t i = 0; placed && i < keyCount; i++)
+                {
+                    if (!isKey(i) || (PerfectHash(keyAt(i), 0) & bucketMask) != bucket)
+                    {
+                        continue;
+                    }
+                    uint16_t & slot = slots[PerfectHash(keyAt(i), seed) & slotMask];
+                    if (slot == kPerfectHashInvalidIndex)
+                    {
+                        slot = static_cast<uint16_t>(i);
+                    }
+                    else
+                    {
+                        placed = false;
+                    }
+                }
+
+                if (!placed)
+                {
+                    // Undo the keys of this bucket placed with the seed that failed.
+                    for (size_t slot = 0; slot <= slotMask; slot++)
+                    {
+                        if (slots[slot] != kPerfectHashInvalidIndex &&
+                            (PerfectHash(keyAt(slots[slot]), 0) & bucketMask) == bucket)
+                        {
+                            slots[slot] = kPerfectHashInvalidIndex;
+                        }
+                    }
+                }
+                else
+                {
+                    seeds[bucket] = seed;
+                }
+            }
+
+            if (!placed)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+constexpr bool IsServerCluster(const EmberAfCluster & cluster)
+{
+    return (cluster.mask & CLUSTER_MASK_SERVER) != 0;
+}
+
+constexpr AttributeAccessor GetAttributeAccessor(const EmberAfAttributeMetadata & attribute)
+{
+    switch (attribute.attributeType)
+    {
+    case ZCL_CHAR_STRING_ATTRIBUTE_TYPE:
+    case ZCL_OCTET_STRING_ATTRIBUTE_TYPE:
+        return AttributeAccessor::kString;
+    case ZCL_LONG_CHAR_STRING_ATTRIBUTE_TYPE:
+    case ZCL_LONG_OCTET_STRING_ATTRIBUTE_TYPE:
+        return AttributeAccessor::kLongString;
+    case ZCL_ARRAY_ATTRIBUTE_TYPE:
+        return AttributeAccessor::kList;
+    default:
+        break;
+    }
+
+    switch (attribute.size)
+    {
+    case 1:
+        return AttributeAccessor::kFixedSize1;
+    case 2:
+        return AttributeAccessor::kFixedSize2;
+    case 4:
+        return AttributeAccessor::kFixedSize4;
+    case 8:
+        return AttributeAccessor::kFixedSize8;
+    default:
+        return AttributeAccessor::kFixedSize;
+    }
+}
+
+} // namespace Internal
+
+/**
+ * Number of cluster slots needed by an AttributeAccessTable over endpointTypes.
+ */
+template <size_t kEndpointTypeCount>
+constexpr size_t AttributeAccessTableClusterSlotCount(const EmberAfEndpointType (&endpointTypes)[kEndpointTypeCount])
+{
+    size_t slotCount = 0;
+    for (const EmberAfEndpointType & endpointType : endpointTypes)
+    {
+        size_t serverClusterCount = 0;
+        for (uint8_t i = 0; i < endpointType.clusterCount; i++)
+        {
+            serverClusterCount += Internal::IsServerCluster(endpointType.cluster[i]) ? 1 : 0;
+        }
+        slotCount += Internal::PerfectHashSlotCount(serverClusterCount);
+    }
+    return slotCount;
+}
+
+/**
+ * Number of attribute slots needed by an AttributeAccessTable over clusters.
+ */
+template <size_t kClusterCount>
+constexpr size_t AttributeAccessTableAttributeSlotCount(const EmberAfCluster (&clusters)[kClusterCount])
+{
+    size_t slotCount = 0;
+    for (const EmberAfCluster & cluster : clusters)
+    {
+        slotCount += Internal::PerfectHashSlotCount(cluster.attributeCount);
+    }
+    return slotCount;
+}
+
+/**
+ * @brief Lookup tables for the attributes of fixed endpoints, built by the compiler from the arrays generated in
+ * endpoint_config.h.
+ *
+ * Every endpoint type gets a perfect hash table of its server clusters and every cluster a perfect hash table of its
+ * attributes, so that finding an attribute costs two hash computations and two key comparisons whatever the number of
+ * endpoints, clusters and attributes.  The storage offset and the accessor of every attribute are precomputed as well.
+ *
+ * Indices of clusters and attributes are indices in the arrays the table was built from.
+ */
+template <size_t kAttributeCount, size_t kClusterCount, size_t kEndpointTypeCount, size_t kFixedEndpointCount,
+          size_t kClusterSlotCount, size_t kAttributeSlotCount>
+class AttributeAccessTable
+{
+public:
+    static constexpr uint16_t kInvalidIndex = Internal::kPerfectHashInvalidIndex;
+
+    constexpr AttributeAccessTable(const EmberAfAttributeMetadata (&attributes)[kAttributeCount],
+                                   const EmberAfCluster (&clusters)[kClusterCount],
+                                   const EmberAfEndpointType (&endpointTypes)[kEndpointTypeCount],
+                                   const uint8_t (&fixedEndpointTypes)[kFixedEndpointCount]) :
+        mAttributes(attributes)
+    {
+        mValid = BuildClusterTables(clusters, endpointTypes) && BuildAttributeTables(attributes, clusters) &&
+            BuildStorageOffsets(attributes, clusters, endpointTypes, fixedEndpointTypes);
+    }
+
+    /**
+     * False if the arrays the table was built from are inconsistent or too large for the table, in which case it must
+     * not be used.
+     */
+    constexpr bool IsValid() const { return mValid; }
+
+    /**
+     * Returns the index of the server cluster clusterId of the fixed endpoint at endpointIndex, kInvalidIndex if there
+     * is none.
+     */
+    uint16_t FindServerCluster(uint16_t endpointIndex, ClusterId clusterId) const
+    {
+        const Range & range = mEndpointTypeRanges[mFixedEndpointTypes[endpointIndex]];
+        uint16_t slot       = Lookup(range, mClusterSeeds, clusterId);
+        return (mClusterSlotIds[slot] == clusterId) ? mClusterSlots[slot] : kInvalidIndex;
+    }
+
+    /**
+     * Returns the index of the attribute attributeId of the cluster at clusterIndex, kInvalidIndex if there is none.
+     */
+    uint16_t FindAttribute(uint16_t clusterIndex, AttributeId attributeId) const
+    {
+        uint16_t index = mAttributeSlots[Lookup(mClusterRanges[clusterIndex], mAttributeSeeds, attributeId)];
+        return (index != kInvalidIndex && mAttributes[index].attributeId == attributeId) ? index : kInvalidIndex;
+    }
+
+    /**
+     * Returns the offset of the value of the attribute at attributeIndex in the singleton storage if it is a singleton,
+     * in the storage of the fixed endpoint at endpointIndex otherwise.  Meaningless for external attributes.
+     */
+    uint16_t GetStorageOffset(uint16_t endpointIndex, uint16_t attributeIndex) const
+    {
+        if (mAttributes[attributeIndex].mask & ATTRIBUTE_MASK_SINGLETON)
+        {
+            return mStorageOffsets[attributeIndex];
+        }
+        return static_cast<uint16_t>(mFixedEndpointStorageOffsets[endpointIndex] + mStorageOffsets[attributeIndex]);
+    }
+
+    AttributeAccessor GetAccessor(uint16_t attributeIndex) const { return mAccessors[attributeIndex]; }
+
+private:
+    static_assert(kAttributeCount > 0 && kClusterCount > 0 && kEndpointTypeCount > 0 && kFixedEndpointCount > 0,
+                  "Attribute access tables need at least one fixed endpoint with attributes");
+    static_assert(kAttributeCount < kInvalidIndex && kClusterCount < kInvalidIndex,
+                  "Attribute access tables use 16 bits indices");
+    static_assert(kClusterSlotCount <= Internal::kPerfectHashMaxSlotsPerTable &&
+                      kAttributeSlotCount <= Internal::kPerfectHashMaxSlotsPerTable,
+                  "Attribute access tables use 16 bits slot indices");
+
+    // Slots [firstSlot, firstSlot + slotMask] and buckets [firstSlot / 2, (firstSlot + slotMask) / 2] of a table.  Slot
+    // counts are powers of two of at least 2, so firstSlot is always even.
+    struct Range
+    {
+        uint16_t firstSlot = 0;
+        uint16_t slotMask  = 0;
+    };
+
+    static uint16_t Lookup(const Range & range, const uint8_t * seeds, uint32_t key)
+    {
+        const uint8_t * tableSeeds = seeds + (range.firstSlot >> 1);
+        uint8_t seed               = tableSeeds[Internal::PerfectHash(key, 0) & (range.slotMask >> 1)];
+        return static_cast<uint16_t>(range.firstSlot + (Internal::PerfectHash(key, seed) & range.slotMask));
+    }
+
+    constexpr bool BuildClusterTables(const EmberAfCluster (&clusters)[kClusterCount],
+                                      const EmberAfEndpointType (&endpointTypes)[kEndpointTypeCount])
+    {
+        for (size_t slot = 0; slot < kClusterSlotCount; slot++)
+        {
+            mClusterSlots[slot]   = kInvalidIndex;
+            mClusterSlotIds[slot] = kInvalidClusterId;
+        }
+
+        size_t firstSlot = 0;
+        for (size_t type = 0; type < kEndpointTypeCount; type++)
+        {
+            const EmberAfEndpointType & endpointType = endpointTypes[type];
+            const size_t firstCluster                = static_cast<size_t>(endpointType.cluster - clusters);
+            VerifyOrReturnValue(firstCluster + endpointType.clusterCount <= kClusterCount, false);
+
+            size_t serverClusterCount = 0;
+            for (uint8_t i = 0; i < endpointType.clusterCount; i++)
+            {
+                serverClusterCount += Internal::IsServerCluster(clusters[firstCluster + i]) ? 1 : 0;
+            }
+
+            const size_t slotCount = Internal::PerfectHashSlotCount(serverClusterCount);
+            VerifyOrReturnValue(firstSlot + slotCount <= kClusterSlotCount, false);
+            mEndpointTypeRanges[type].firstSlot = static_cast<uint16_t>(firstSlot);
+            mEndpointTypeRanges[type].slotMask  = static_cast<uint16_t>(slotCount - 1);
+
+            auto keyAt = [&](size_t i) -> uint32_t { return clusters[firstCluster + i].clusterId; };
+            auto isKey = [&](size_t i) -> bool { return Internal::IsServerCluster(clusters[firstCluster + i]); };
+            VerifyOrReturnValue(Internal::PlacePerfectHashKeys(keyAt, isKey, endpointType.clusterCount, &mClusterSlots[firstSlot],
+                                                               &mClusterSeeds[firstSlot >> 1],
+                                                               mEndpointTypeRanges[type].slotMask),
+                                false);
+
+            for (size_t slot = firstSlot; slot < firstSlot + slotCount; slot++)
+            {
+                if (mClusterSlots[slot] != kInvalidIndex)
+                {
+                    mClusterSlots[slot]   = static_cast<uint16_t>(firstCluster + mClusterSlots[slot]);
+                    mClusterSlotIds[slot] = clusters[mClusterSlots[slot]].clusterId;
+                }
+            }
+            firstSlot += slotCount;
+        }
+        return firstSlot == kClusterSlotCount;
+    }
+
+    constexpr bool BuildAttributeTables(const EmberAfAttributeMetadata (&attributes)[kAttributeCount],
+                                        const EmberAfCluster (&clusters)[kClusterCount])
+    {
+        for (uint16_t & slot : mAttributeSlots)
+        {
+            slot = kInvalidIndex;
+        }
+
+        size_t firstSlot = 0;
+        for (size_t cluster = 0; cluster < kClusterCount; cluster++)
+        {
+            const size_t attributeCount = clusters[cluster].attributeCount;
+            // Clusters without attributes may have no attribute array.
+            const size_t firstAttribute =
+                (attributeCount == 0) ? 0 : static_cast<size_t>(clusters[cluster].attributes - attributes);
+            VerifyOrReturnValue(firstAttribute + attributeCount <= kAttributeCount, false);
+
+            const size_t slotCount = Internal::PerfectHashSlotCount(attributeCount);
+            VerifyOrReturnValue(firstSlot + slotCount <= kAttributeSlotCount, false);
+            mClusterRanges[cluster].firstSlot = static_cast<uint16_t>(firstSlot);
+            mClusterRanges[cluster].slotMask  = static_cast<uint16_t>(slotCount - 1);
+
+            auto keyAt = [&](size_t i) -> uint32_t { return attributes[firstAttribute + i].attributeId; };
+            auto isKey = [](size_t) -> bool { return true; };
+            VerifyOrReturnValue(Internal::PlacePerfectHashKeys(keyAt, isKey, attributeCount, &mAttributeSlots[firstSlot],
+                                                               &mAttributeSeeds[firstSlot >> 1], mClusterRanges[cluster].slotMask),
+                                false);
+
+            for (size_t slot = firstSlot; slot < firstSlot + slotCount; slot++)
+            {
+                if (mAttributeSlots[slot] != kInvalidIndex)
+                {
+                    mAttributeSlots[slot] = static_cast<uint16_t>(firstAttribute + mAttributeSlots[slot]);
+                }
+            }
+            firstSlot += slotCount;
+        }
+        return firstSlot == kAttributeSlotCount;
+    }
+
+    // Mirrors the layout walked by emAfReadOrWriteAttribute: endpoints, then clusters, then attributes that are
+    // neither external nor singletons are laid out back to back, while singletons are laid out in array order in a
+    // storage of their own.
+    constexpr bool BuildStorageOffsets(const EmberAfAttributeMetadata (&attributes)[kAttributeCount],
+                                       const EmberAfCluster (&clusters)[kClusterCount],
+                                       const EmberAfEndpointType (&endpointTypes)[kEndpointTypeCount],
+                                       const uint8_t (&fixedEndpointTypes)[kFixedEndpointCount])
+    {
+        size_t singletonOffset = 0;
+        for (size_t i = 0; i < kAttributeCount; i++)
+        {
+            mAccessors[i]      = Internal::GetAttributeAccessor(attributes[i]);
+            mStorageOffsets[i] = static_cast<uint16_t>(singletonOffset);
+            if ((attributes[i].mask & ATTRIBUTE_MASK_SINGLETON) && !(attributes[i].mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE))
+            {
+                singletonOffset += attributes[i].size;
+            }
+        }
+        VerifyOrReturnValue(singletonOffset <= UINT16_MAX, false);
+
+        for (const EmberAfEndpointType & endpointType : endpointTypes)
+        {
+            const size_t firstCluster = static_cast<size_t>(endpointType.cluster - clusters);
+            size_t clusterOffset      = 0;
+            for (size_t cluster = firstCluster; cluster < firstCluster + endpointType.clusterCount; cluster++)
+            {
+                size_t offset = clusterOffset;
+                for (size_t i = 0; i < clusters[cluster].attributeCount; i++)
+                {
+                    const size_t attribute = static_cast<size_t>(clusters[cluster].attributes - attributes) + i;
+                    if (!(attributes[attribute].mask & (ATTRIBUTE_MASK_SINGLETON | ATTRIBUTE_MASK_EXTERNAL_STORAGE)))
+                    {
+                        mStorageOffsets[attribute] = static_cast<uint16_t>(offset);
+                        offset += attributes[attribute].size;
+                    }
+                }
+                VerifyOrReturnValue(offset <= clusterOffset + clusters[cluster].clusterSize, false);
+                clusterOffset += clusters[cluster].clusterSize;
+            }
+            VerifyOrReturnValue(clusterOffset <= endpointType.endpointSize, false);
+        }
+
+        size_t endpointOffset = 0;
+        for (size_t endpoint = 0; endpoint < kFixedEndpointCount; endpoint++)
+        {
+            VerifyOrReturnValue(fixedEndpointTypes[endpoint] < kEndpointTypeCount, false);
+            mFixedEndpointTypes[endpoint]          = fixedEndpointTypes[endpoint];
+            mFixedEndpointStorageOffsets[endpoint] = static_cast<uint16_t>(endpointOffset);
+            endpointOffset += endpointTypes[fixedEndpointTypes[endpoint]].endpointSize;
+        }
+        return endpointOffset <= UINT16_MAX;
+    }
+
+    const EmberAfAttributeMetadata * mAttributes;
+
+    Range mEndpointTypeRanges[kEndpointTypeCount]              = {};
+    uint16_t mClusterSlots[kClusterSlotCount]                  = {};
+    ClusterId mClusterSlotIds[kClusterSlotCount]               = {};
+    uint8_t mClusterSeeds[kClusterSlotCount / 2]               = {};
+    Range mClusterRanges[kClusterCount]                        = {};
+    uint16_t mAttributeSlots[kAttributeSlotCount]              = {};
+    uint8_t mAttributeSeeds[kAttributeSlotCount / 2]           = {};
+    uint16_t mStorageOffsets[kAttributeCount]                  = {};
+    AttributeAccessor mAccessors[kAttributeCount]              = {};
+    uint8_t mFixedEndpointTypes[kFixedEndpointCount]           = {};
+    uint16_t mFixedEndpointStorageOffsets[kFixedEndpointCount] = {};
+    bool mValid                                                = false;
+};
+
+} // namespace app
+} // namespace chip
@@ -22,6 +22,7 @@
 #include <app/util/af.h>
 #include <app/util/attribute-storage.h>
 #include <app/util/config.h>
+#include <app/util/endpoint-index-table.h>
 #include <app/util/generic-callbacks.h>
 #include <lib/core/CHIPConfig.h>
 #include <lib/support/CodeUtils.h>
@@ -39,6 +40,10 @@
 //           -> zap-generated/endpoint_config.h
 #include <app-common/zap-generated/callback.h>
 
+#if CHIP_CONFIG_ATTRIBUTE_ACCESS_TABLES
+#include <zap-generated/attribute_access_tables.h>
+#endif
+
 using namespace chip;
 using namespace chip::app;
 
@@ -108,6 +113,17 @@ constexpr const EmberAfCluster generatedClusters[] = GENERATED_CLUSTERS;
 constexpr const EmberAfEndpointType generatedEmberAfEndpointTypes[] = GENERATED_ENDPOINT_TYPES;
 constexpr const EmberAfDeviceType fixedDeviceTypeList[]             = FIXED_DEVICE_TYPES;
 
+#if CHIP_CONFIG_ATTRIBUTE_ACCESS_TABLES
+GENERATED_ATTRIBUTE_ACCESS_TABLE
+
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+// Unit tests switch the tables off to compare them with the search.
+static bool attributeAccessTablesEnabled = true;
+#else
+static constexpr bool attributeAccessTablesEnabled = true;
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+#endif // CHIP_CONFIG_ATTRIBUTE_ACCESS_TABLES
+
 // Not const, because these need to mutate.
 DataVersion fixedEndpointDataVersions[ZAP_FIXED_ENDPOINT_DATA_VERSION_COUNT];
 
@@ -155,6 +171,31 @@ void UnregisterMatchingAttributeAccessInterfaces(F shouldUnregister)
     }
 }
 
+// Endpoint id to emAfEndpoints index.
+EndpointIndexTable<MAX_ENDPOINT_COUNT> endpointIndexTable;
+static_assert(EndpointIndexTable<MAX_ENDPOINT_COUNT>::kInvalidIndex == kEmberInvalidEndpointIndex,
+              "The index table must use the ember invalid endpoint index");
+
+// Endpoints whose Descriptor PartsList changed while reporting was deferred.
+// There is room for every endpoint, so only a batch that removes endpoints and
+// adds others in their place can overflow it; then every enabled endpoint is
+// reported.
+constexpr size_t kMaxDeferredPartsListEndpoints = MAX_ENDPOINT_COUNT;
+PartsListReportDeferral<kMaxDeferredPartsListEndpoints> partsListReportDeferral;
+
+// Returns the emAfEndpoints index of endpoint, or kEmberInvalidEndpointIndex.
+uint16_t LookupEndpointIndex(EndpointId endpoint)
+{
+    return endpointIndexTable.Lookup(endpoint);
+}
+
+void ReportPartsListChange(EndpointId endpoint)
+{
+    VerifyOrReturn(!partsListReportDeferral.Defer(endpoint));
+    MatterReportingAttributeChangeCallback(endpoint, app::Clusters::Descriptor::Id,
+                                           app::Clusters::Descriptor::Attributes::PartsList::Id);
+}
+
 } // anonymous namespace
 
 // Initial configuration
@@ -185,6 +226,8 @@ void emberAfEndpointConfigure()
     }
 #endif // ZAP_FIXED_ENDPOINT_DATA_VERSION_COUNT > 0
 
+    endpointIndexTable.Clear();
+
     emberEndpointCount                = FIXED_ENDPOINT_COUNT;
     DataVersion * currentDataVersions = fixedEndpointDataVersions;
     for (ep = 0; ep < FIXED_ENDPOINT_COUNT; ep++)
@@ -196,6 +239,7 @@ void emberAfEndpointConfigure()
 
         emAfEndpoints[ep].bitmask.Set(EmberAfEndpointOptions::isEnabled);
         emAfEndpoints[ep].bitmask.Set(EmberAfEndpointOptions::isFlatComposition);
+        endpointIndexTable.Insert(emAfEndpoints[ep].endpoint, ep);
 
         // Increment currentDataVersions by 1 (slot) for every server cluster
         // this endpoint has.
@@ -228,15 +272,12 @@ uint16_t emberAfGetDynamicIndexFromEndpoint(EndpointId id)
         return kEmberInvalidEndpointIndex;
     }
 
-    uint16_t index;
-    for (index = FIXED_ENDPOINT_COUNT; index < MAX_ENDPOINT_COUNT; index++)
+    uint16_t index = LookupEndpointIndex(id);
+    if (index == kEmberInvalidEndpointIndex || index < FIXED_ENDPOINT_COUNT)
     {
-        if (emAfEndpoints[index].endpoint == id)
-        {
-            return static_cast<uint8_t>(index - FIXED_ENDPOINT_COUNT);
-        }
+        return kEmberInvalidEndpointIndex;
     }
-    return kEmberInvalidEndpointIndex;
+    return static_cast<uint16_t>(index - FIXED_ENDPOINT_COUNT);
 }
 
 EmberAfStatus emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const EmberAfEndpointType * ep,
@@ -261,12 +302,15 @@ EmberAfStatus emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const Emb
     }
 
     index = static_cast<uint16_t>(realIndex);
-    for (uint16_t i = FIXED_ENDPOINT_COUNT; i < MAX_ENDPOINT_COUNT; i++)
+    if (LookupEndpointIndex(id) != kEmberInvalidEndpointIndex)
     {
-        if (emAfEndpoints[i].endpoint == id)
-        {
-            return EMBER_ZCL_STATUS_DUPLICATE_EXISTS;
-        }
+        return EMBER_ZCL_STATUS_DUPLICATE_EXISTS;
+    }
+
+    if (emAfEndpoints[index].endpoint != kInvalidEndpointId)
+    {
+        // The slot is being reused without having been cleared; forget the old id.
+        endpointIndexTable.Remove(emAfEndpoints[index].endpoint);
     }
 
     emAfEndpoints[index].endpoint       = id;
@@ -276,6 +320,7 @@ EmberAfStatus emberAfSetDynamicEndpoint(uint16_t index, EndpointId id, const Emb
     // Start the endpoint off as disabled.
     emAfEndpoints[index].bitmask.Clear(EmberAfEndpointOptions::isEnabled);
     emAfEndpoints[index].parentEndpointId = parentEndpointId;
+    endpointIndexTable.Insert(id, index);
 
     emberAfSetDynamicEndpointCount(MAX_ENDPOINT_COUNT - FIXED_ENDPOINT_COUNT);
 
@@ -300,13 +345,21 @@ EndpointId emberAfClearDynamicEndpoint(uint16_t index)
 {
     EndpointId ep = 0;
 
-    index = static_cast<uint8_t>(index + FIXED_ENDPOINT_COUNT);
+    if (index >= MAX_ENDPOINT_COUNT - FIXED_ENDPOINT_COUNT)
+    {
+        return ep;
+    }
 
-    if ((index < MAX_ENDPOINT_COUNT) && (emAfEndpoints[index].endpoint != kInvalidEndpointId) &&
-        (emberAfEndpointIndexIsEnabled(index)))
+    index = static_cast<uint16_t>(index + FIXED_ENDPOINT_COUNT);
+
+    if (emAfEndpoints[index].endpoint != kInvalidEndpointId)
     {
         ep = emAfEndpoints[index].endpoint;
-        emberAfEndpointEnableDisable(ep, false);
+        if (emberAfEndpointIndexIsEnabled(index))
+        {
+            emberAfEndpointEnableDisable(ep, false);
+        }
+        endpointIndexTable.Remove(ep);
         emAfEndpoints[index].endpoint = kInvalidEndpointId;
     }
 
@@ -526,6 +579,115 @@ static EmberAfStatus typeSensitiveMemCopy(ClusterId clusterId, uint8_t * dest, u
     return EMBER_ZCL_STATUS_SUCCESS;
 }
 
+#if CHIP_CONFIG_ATTRIBUTE_ACCESS_TABLES
+// Specialization of typeSensitiveMemCopy for attributes that are neither strings nor lists and have a size known at
+// compile time.
+template <uint16_t kSize>
+static EmberAfStatus fixedSizeMemCopy(uint8_t * dest, uint8_t * src, bool write, uint16_t readLength)
+{
+    if (!write && readLength != 0 && readLength < kSize)
+    {
+        return EMBER_ZCL_STATUS_RESOURCE_EXHAUSTED;
+    }
+    if (src == nullptr)
+    {
+        memset(dest, 0, kSize);
+    }
+    else
+    {
+        memmove(dest, src, kSize);
+    }
+    return EMBER_ZCL_STATUS_SUCCESS;
+}
+
+// typeSensitiveMemCopy using the accessor the attribute access tables selected for the attribute.
+static EmberAfStatus accessorMemCopy(AttributeAccessor accessor, ClusterId clusterId, uint8_t * dest, uint8_t * src,
+                                     const EmberAfAttributeMetadata * am, bool write, uint16_t readLength)
+{
+    switch (accessor)
+    {
+    case AttributeAccessor::kFixedSize1:
+        return fixedSizeMemCopy<1>(dest, src, write, readLength);
+    case AttributeAccessor::kFixedSize2:
+        return fixedSizeMemCopy<2>(dest, src, write, readLength);
+    case AttributeAccessor::kFixedSize4:
+        return fixedSizeMemCopy<4>(dest, src, write, readLength);
+    case AttributeAccessor::kFixedSize8:
+        return fixedSizeMemCopy<8>(dest, src, write, readLength);
+    default:
+        return typeSensitiveMemCopy(clusterId, dest, src, am, write, readLength);
+    }
+}
+
+// Same as emAfReadOrWriteAttribute for the fixed endpoint at endpointIndex, with the cluster, the attribute and its
+// storage located through the attribute access tables instead of a search.
+static EmberAfStatus readOrWriteFixedEndpointAttribute(uint16_t endpointIndex, EmberAfAttributeSearchRecord * attRecord,
+                                                       const EmberAfAttributeMetadata ** metadata, uint8_t * buffer,
+                                                       uint16_t readLength, bool write)
+{
+    if (!emberAfEndpointIndexIsEnabled(endpointIndex))
+    {
+        return EMBER_ZCL_STATUS_UNSUPPORTED_ENDPOINT;
+    }
+
+    uint16_t clusterIndex = generatedAttributeAccessTable.FindServerCluster(endpointIndex, attRecord->clusterId);
+    if (clusterIndex == generatedAttributeAccessTable.kInvalidIndex)
+    {
+        return EMBER_ZCL_STATUS_UNSUPPORTED_CLUSTER;
+    }
+
+    uint16_t attributeIndex = generatedAttributeAccessTable.FindAttribute(clusterIndex, attRecord->attributeId);
+    if (attributeIndex == generatedAttributeAccessTable.kInvalidIndex)
+    {
+        return EMBER_ZCL_STATUS_UNSUPPORTED_ATTRIBUTE;
+    }
+
+    const EmberAfAttributeMetadata * am = &generatedAttributes[attributeIndex];
+    if (metadata != nullptr)
+    {
+        *metadata = am;
+    }
+
+    if (write)
+    {
+        if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId, am->attributeId))
+        {
+            return EMBER_ZCL_STATUS_UNSUPPORTED_ACCESS;
+        }
+    }
+    else
+    {
+        if (buffer == nullptr)
+        {
+            return EMBER_ZCL_STATUS_SUCCESS;
+        }
+        if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId, am->attributeId))
+        {
+            return EMBER_ZCL_STATUS_UNSUPPORTED_ACCESS;
+        }
+    }
+
+    if (am->IsExternal())
+    {
+        return (write ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId, am, buffer)
+                      : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId, am, buffer,
+                                                             emberAfAttributeSize(am)));
+    }
+
+    uint8_t * attributeLocation = (am->IsSingleton() ? singletonAttributeData : attributeData) +
+        generatedAttributeAccessTable.GetStorageOffset(endpointIndex, attributeIndex);
+    return accessorMemCopy(generatedAttributeAccessTable.GetAccessor(attributeIndex), attRecord->clusterId,
+                           write ? attributeLocation : buffer, write ? buffer : attributeLocation, am, write, readLength);
+}
+
+#if CONFIG_BUILD_FOR_HOST_UNIT_TEST
+void emberAfSetAttributeAccessTablesEnabled(bool enabled)
+{
+    attributeAccessTablesEnabled = enabled;
+}
+#endif // CONFIG_BUILD_FOR_HOST_UNIT_TEST
+#endif // CHIP_CONFIG_ATTRIBUTE_ACCESS_TABLES
+
 /**
  * @brief Matches a cluster based on cluster id and direction.
  *
@@ -574,7 +736,24 @@ EmberAfStatus emAfReadOrWriteAttribute(EmberAfAttributeSearchRecord * attRecord,
 
     uint16_t attributeOffsetIndex = 0;
 
-    for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
+    uint16_t targetIndex = emberAfIndexFromEndpointIncludingDisabledEndpoints(attRecord->endpoint);
+    if (targetIndex == kEmberInvalidEndpointIndex)
+    {
+        return EMBER_ZCL_STATUS_UNSUPPORTED_ENDPOINT;
+    }
+
+#if CHIP_CONFIG_ATTRIBUTE_ACCESS_TABLES
+    if (attributeAccessTablesEnabled && targetIndex < emberAfFixedEndpointCount())
+    {
+        return readOrWriteFixedEndpointAttribute(targetIndex, attRecord, metadata, buffer, readLength, write);
+    }
+#endif // CHIP_CONFIG_ATTRIBUTE_ACCESS_TABLES
+
+    // Dynamic endpoints do not use attributeData, so there is no storage offset
+    // to accumulate and the search can start right at the target.
+    uint16_t firstIndex = (targetIndex >= emberAfFixedEndpointCount()) ? targetIndex : 0;
+
+    for (uint16_t ep = firstIndex; ep < emberAfEndpointCount(); ep++)
     {
         // Is this a dynamic endpoint?
         bool isDynamicEndpoint = (ep >= emberAfFixedEndpointCount());
@@ -727,19 +906,16 @@ const EmberAfCluster * emberAfFindClusterInType(const EmberAfEndpointType * endp
 
 uint8_t emberAfClusterIndex(EndpointId endpoint, ClusterId clusterId, EmberAfClusterMask mask)
 {
-    for (uint16_t ep = 0; ep < emberAfEndpointCount(); ep++)
+    uint16_t ep = emberAfIndexFromEndpointIncludingDisabledEndpoints(endpoint);
+    if (ep == kEmberInvalidEndpointIndex)
     {
-        // Check the endpoint id first, because that way we avoid examining the
-        // endpoint type for endpoints that are not actually defined.
-        if (emAfEndpoints[ep].endpoint == endpoint)
-        {
-            const EmberAfEndpointType * endpointType = emAfEndpoints[ep].endpointType;
-            uint8_t index                            = 0xFF;
-            if (emberAfFindClusterInType(endpointType, clusterId, mask, &index) != nullptr)
-            {
-                return index;
-            }
-        }
+        return 0xFF;
+    }
+
+    uint8_t index = 0xFF;
+    if (emberAfFindClusterInType(emAfEndpoints[ep].endpointType, clusterId, mask, &index) != nullptr)
+    {
+        return index;
     }
     return 0xFF;
 }
@@ -837,16 +1013,13 @@ static uint16_t findIndexFromEndpoint(EndpointId endpoint, bool ignoreDisabledEn
         return kEmberInvalidEndpointIndex;
     }
 
-    uint16_t epi;
-    for (epi = 0; epi < emberAfEndpointCount(); epi++)
+    uint16_t epi = LookupEndpointIndex(endpoint);
+    if (epi >= emberAfEndpointCount() ||
+        (ignoreDisabledEndpoints && !emAfEndpoints[epi].bitmask.Has(EmberAfEndpointOptions::isEnabled)))
     {
-        if (emAfEndpoints[epi].endpoint == endpoint &&
-            (!ignoreDisabledEndpoints || emAfEndpoints[epi].bitmask.Has(EmberAfEndpointOptions::isEnabled)))
-        {
-            return epi;
-        }
+        return kEmberInvalidEndpointIndex;
     }
-    return kEmberInvalidEndpointIndex;
+    return epi;
 }
 
 uint16_t emberAfGetClusterServerEndpointIndex(EndpointId endpoint, ClusterId cluster, uint16_t fixedClusterServerEndpointCount)
@@ -949,8 +1122,7 @@ bool emberAfEndpointEnableDisable(EndpointId endpoint, bool enable)
         EndpointId parentEndpointId = emberAfParentEndpointFromIndex(index);
         while (parentEndpointId != kInvalidEndpointId)
         {
-            MatterReportingAttributeChangeCallback(parentEndpointId, app::Clusters::Descriptor::Id,
-                                                   app::Clusters::Descriptor::Attributes::PartsList::Id);
+            ReportPartsListChange(parentEndpointId);
             uint16_t parentIndex = emberAfIndexFromEndpoint(parentEndpointId);
             if (parentIndex == kEmberInvalidEndpointIndex)
             {
@@ -960,13 +1132,32 @@ bool emberAfEndpointEnableDisable(EndpointId endpoint, bool enable)
             parentEndpointId = emberAfParentEndpointFromIndex(parentIndex);
         }
 
-        MatterReportingAttributeChangeCallback(/* endpoint = */ 0, app::Clusters::Descriptor::Id,
-                                               app::Clusters::Descriptor::Attributes::PartsList::Id);
+        ReportPartsListChange(/* endpoint = */ 0);
     }
 
     return true;
 }
 
+void emberAfBeginDeferredPartsListReporting()
+{
+    assertChipStackLockedByCurrentThread();
+    partsListReportDeferral.Begin();
+}
+
+void emberAfEndDeferredPartsListReporting()
+{
+    assertChipStackLockedByCurrentThread();
+    partsListReportDeferral.End(ReportPartsListChange, [] {
+        for (uint16_t index = 0; index < emberAfEndpointCount(); index++)
+        {
+            if (emberAfEndpointIndexIsEnabled(index))
+            {
+                ReportPartsListChange(emAfEndpoints[index].endpoint);
+            }
+        }
+    });
+}
+
 // Returns the index of a given endpoint.  Does not consider disabled endpoints.
 uint16_t emberAfIndexFromEndpoint(EndpointId endpoint)
 {
@@ -98,6 +98,12 @@ void emberAfEndpointConfigure(void);
 EmberAfStatus emAfReadOrWriteAttribute(EmberAfAttributeSearchRecord * attRecord, const EmberAfAttributeMetadata ** metadata,
                                        uint8_t * buffer, uint16_t readLength, bool write);
 
+#if CHIP_CONFIG_ATTRIBUTE_ACCESS_TABLES && CONFIG_BUILD_FOR_HOST_UNIT_TEST
+// Make emAfReadOrWriteAttribute locate attributes of fixed endpoints through
+// the attribute access tables (the default) or through the search.
+void emberAfSetAttributeAccessTablesEnabled(bool enabled);
+#endif
+
 bool emAfMatchCluster(const EmberAfCluster * cluster, EmberAfAttributeSearchRecord * attRecord);
 bool emAfMatchAttribute(const EmberAfCluster * cluster, const EmberAfAttributeMetadata * am,
                         EmberAfAttributeSearchRecord * attRecord);
@@ -254,6 +260,14 @@ EmberAfStatus emberAfSetDynamicEndpoint(uint16_t index, chip::EndpointId id, con
 chip::EndpointId emberAfClearDynamicEndpoint(uint16_t index);
 uint16_t emberAfGetDynamicIndexFromEndpoint(chip::EndpointId id);
 
+// Coalesce the Descriptor PartsList reports caused by enabling or disabling
+// endpoints.  Between Begin and the matching End, every affected PartsList is
+// recorded and then reported once when the outermost End is called, so adding
+// or removing many endpoints at once marks each ancestor dirty only once.
+// Calls may be nested.
+void emberAfBeginDeferredPartsListReporting();
+void emberAfEndDeferredPartsListReporting();
+
 // Get the number of attributes of the specific cluster under the endpoint.
 // Returns 0 if the cluster does not exist.
 uint16_t emberAfGetServerAttributeCount(chip::EndpointId endpoint, chip::ClusterId cluster);
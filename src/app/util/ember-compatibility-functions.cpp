@@ -267,6 +267,8 @@ CHIP_ERROR ReadClusterDataVersion(const ConcreteClusterPath & aConcreteClusterPa
                      aConcreteClusterPath.mEndpointId, ChipLogValueMEI(aConcreteClusterPath.mClusterId));
         return CHIP_ERROR_NOT_FOUND;
     }
+    InteractionModelEngine::GetInstance()->GetReportingEngine().GetAttributeChangeCoalescer().OnDataVersionRead(
+        aConcreteClusterPath);
     aDataVersion = *version;
     return CHIP_NO_ERROR;
 }
@@ -1054,6 +1056,8 @@ bool IsClusterDataVersionEqual(const ConcreteClusterPath & aConcreteClusterPath,
         return false;
     }
 
+    InteractionModelEngine::GetInstance()->GetReportingEngine().GetAttributeChangeCoalescer().OnDataVersionRead(
+        aConcreteClusterPath);
     return (*(version)) == aRequiredVersion;
 }
 
@@ -1118,13 +1122,23 @@ void MatterReportingAttributeChangeCallback(EndpointId endpoint, ClusterId clust
     // applications notifying about changes from their end.
     assertChipStackLockedByCurrentThread();
 
-    AttributePathParams info;
-    info.mClusterId   = clusterId;
-    info.mAttributeId = attributeId;
-    info.mEndpointId  = endpoint;
+    auto & reportingEngine = InteractionModelEngine::GetInstance()->GetReportingEngine();
+    auto actions =
+        reportingEngine.GetAttributeChangeCoalescer().OnAttributeChanged(ConcreteAttributePath(endpoint, clusterId, attributeId));
 
-    IncreaseClusterDataVersion(ConcreteClusterPath(endpoint, clusterId));
-    InteractionModelEngine::GetInstance()->GetReportingEngine().SetDirty(info);
+    if (actions.Has(reporting::AttributeChangeCoalescer::Action::kIncreaseDataVersion))
+    {
+        IncreaseClusterDataVersion(ConcreteClusterPath(endpoint, clusterId));
+    }
+
+    if (actions.Has(reporting::AttributeChangeCoalescer::Action::kSetDirty))
+    {
+        AttributePathParams info;
+        info.mClusterId   = clusterId;
+        info.mAttributeId = attributeId;
+        info.mEndpointId  = endpoint;
+        reportingEngine.SetDirty(info);
+    }
 }
 
 void MatterReportingAttributeChangeCallback(const ConcreteAttributePath & aPath)
@@ -0,0 +1,209 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Bookkeeping used by the attribute storage to manage large numbers of
+ *      dynamic endpoints: a hash index from endpoint id to endpoint index, and
+ *      the coalescing of Descriptor PartsList reports over a batch of endpoint
+ *      changes.
+ */
+
+#pragma once
+
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/CodeUtils.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+
+/**
+ * Open-addressed (linear probing) map from endpoint id to endpoint index, so
+ * that id lookups stay O(1) even for bridges exposing thousands of dynamic
+ * endpoints.  Removal uses backward-shift deletion, so no tombstones build up
+ * however often endpoints are added and removed.
+ */
+template <size_t kMaxEntries>
+class EndpointIndexTable
+{
+public:
+    static constexpr uint16_t kInvalidIndex = UINT16_MAX;
+
+    static_assert(kMaxEntries < kInvalidIndex, "Endpoint indices must fit in the index table");
+
+    EndpointIndexTable() { Clear(); }
+
+    void Clear()
+    {
+        for (auto & entry : mEntries)
+        {
+            entry = Entry();
+        }
+    }
+
+    /**
+     * Returns the index of endpoint, or kInvalidIndex.
+     */
+    uint16_t Lookup(EndpointId endpoint) const
+    {
+        for (size_t slot = HomeSlot(endpoint); mEntries[slot].index != kInvalidIndex; slot = NextSlot(slot))
+        {
+            if (mEntries[slot].endpoint == endpoint)
+            {
+                return mEntries[slot].index;
+            }
+        }
+        return kInvalidIndex;
+    }
+
+    /**
+     * Maps endpoint to index.  The caller makes sure that endpoint is not in
+     * the table yet and that at most kMaxEntries endpoints are.
+     */
+    void Insert(EndpointId endpoint, uint16_t index)
+    {
+        size_t slot = HomeSlot(endpoint);
+        while (mEntries[slot].index != kInvalidIndex)
+        {
+            slot = NextSlot(slot);
+        }
+        mEntries[slot] = { endpoint, index };
+    }
+
+    void Remove(EndpointId endpoint)
+    {
+        size_t slot = HomeSlot(endpoint);
+        while (mEntries[slot].endpoint != endpoint)
+        {
+            VerifyOrReturn(mEntries[slot].index != kInvalidIndex);
+            slot = NextSlot(slot);
+        }
+        VerifyOrReturn(mEntries[slot].index != kInvalidIndex);
+
+        // Pull later entries of the probe run into the hole.
+        size_t hole = slot;
+        for (size_t next = NextSlot(hole); mEntries[next].index != kInvalidIndex; next = NextSlot(next))
+        {
+            size_t home = HomeSlot(mEntries[next].endpoint);
+            // Move the entry unless its home slot lies cyclically in (hole, next].
+            if (((next - home) & kMask) >= ((next - hole) & kMask))
+            {
+                mEntries[hole] = mEntries[next];
+                hole           = next;
+            }
+        }
+        mEntries[hole] = Entry();
+    }
+
+private:
+    // At most half full, so that probe runs stay short.
+    static constexpr size_t kSize = [] {
+        size_t size = 1;
+        while (size < 2 * kMaxEntries)
+        {
+            size <<= 1;
+        }
+        return size;
+    }();
+    static constexpr size_t kMask = kSize - 1;
+
+    struct Entry
+    {
+        EndpointId endpoint = kInvalidEndpointId;
+        uint16_t index      = kInvalidIndex;
+    };
+
+    static size_t HomeSlot(EndpointId endpoint) { return (static_cast<uint32_t>(endpoint) * 0x9E3779B1u) & kMask; }
+    static size_t NextSlot(size_t slot) { return (slot + 1) & kMask; }
+
+    Entry mEntries[kSize];
+};
+
+/**
+ * Endpoints whose Descriptor PartsList changed while reporting is deferred.
+ * Deferral may be nested; the changes are handed back when the outermost
+ * deferral ends.  If more than kMaxEndpoints distinct endpoints change, the
+ * set overflows and the owner has to report every endpoint instead.
+ */
+template <size_t kMaxEndpoints>
+class PartsListReportDeferral
+{
+public:
+    void Begin() { mDepth++; }
+
+    /**
+     * Returns false if reporting is not deferred and the change must be
+     * reported right away.  Otherwise records the change.
+     */
+    bool Defer(EndpointId endpoint)
+    {
+        VerifyOrReturnValue(mDepth > 0, false);
+
+        for (size_t i = 0; i < mCount; ++i)
+        {
+            VerifyOrReturnValue(mEndpoints[i] != endpoint, true);
+        }
+        if (mCount < kMaxEndpoints)
+        {
+            mEndpoints[mCount++] = endpoint;
+        }
+        else
+        {
+            mOverflow = true;
+        }
+        return true;
+    }
+
+    /**
+     * Ends one level of deferral.  When it was the outermost one, calls
+     * report(endpoint) once for each endpoint recorded, or reportAll() once if
+     * there were too many to record.  Reporting is no longer deferred by then.
+     */
+    template <typename Report, typename ReportAll>
+    void End(Report && report, ReportAll && reportAll)
+    {
+        VerifyOrReturn(mDepth > 0);
+        VerifyOrReturn(--mDepth == 0);
+
+        if (mOverflow)
+        {
+            reportAll();
+        }
+        else
+        {
+            for (size_t i = 0; i < mCount; ++i)
+            {
+                report(mEndpoints[i]);
+            }
+        }
+
+        mCount    = 0;
+        mOverflow = false;
+    }
+
+private:
+    EndpointId mEndpoints[kMaxEndpoints];
+    size_t mCount   = 0;
+    bool mOverflow  = false;
+    uint16_t mDepth = 0;
+};
+
+} // namespace app
+} // namespace chip
@@ -334,6 +334,16 @@ DataVersion GetVersion()
     return dataVersion;
 }
 
+void SetMockNodeConfig(const MockNodeConfig & config)
+{
+    mockConfig = &config;
+}
+
+void ResetMockNodeConfig()
+{
+    mockConfig = nullptr;
+}
+
 CHIP_ERROR ReadSingleMockClusterData(FabricIndex aAccessingFabricIndex, const ConcreteAttributePath & aPath,
                                      AttributeReportIBs::Builder & aAttributeReports,
                                      AttributeValueEncoder::AttributeEncodeState * apEncoderState)
@@ -0,0 +1,386 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/CommandSender.h>
+#include <controller/TypedCommandCallback.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <messaging/ExchangeMgr.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+#include <transport/Session.h>
+#include <transport/SessionManager.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace Controller {
+
+/*
+ * Gathers the commands an application invokes on a single node and sends them as batched invokes, routing every
+ * response back to the callbacks of the command it belongs to.
+ *
+ * The first command added to an empty batch starts a coalescing window. The batch is sent when that window expires,
+ * when it holds as many commands as the peer accepts in one InvokeRequestMessage (its MaxPathsPerInvoke session
+ * parameter, capped by the maxBatchSize given at construction), when the next command does not fit in the message
+ * or targets a command path already in the batch, or when Flush() is called. Several batches can be in flight at the
+ * same time.
+ *
+ * Callbacks follow the semantics of InvokeCommandRequest: for each successfully added command, exactly one of the
+ * success or error callbacks is eventually called. Commands that require a timed invoke cannot be coalesced, since
+ * the timed request would apply to the whole batch, and must keep using InvokeCommandRequest.
+ *
+ * When batch commands are not supported (CHIP_CONFIG_SENDING_BATCH_COMMANDS_ENABLED is 0, or the peer only accepts one
+ * path per invoke), every command is sent as soon as it is added.
+ *
+ * All methods must be called with the Matter stack lock held.
+ */
+class CommandCoalescer
+{
+public:
+    static constexpr System::Clock::Milliseconds32 kDefaultWindow = System::Clock::Milliseconds32(5);
+    static constexpr uint16_t kDefaultMaxBatchSize                = 32;
+
+    CommandCoalescer(Messaging::ExchangeManager * exchangeMgr, const SessionHandle & session,
+                     System::Clock::Milliseconds32 window = kDefaultWindow, uint16_t maxBatchSize = kDefaultMaxBatchSize);
+
+    /*
+     * Commands that have not been sent yet are failed with CHIP_ERROR_CANCELLED. Batches already sent complete normally.
+     */
+    ~CommandCoalescer();
+
+    CommandCoalescer(const CommandCoalescer &)             = delete;
+    CommandCoalescer & operator=(const CommandCoalescer &) = delete;
+
+    /*
+     * Adds a command to the current batch. The arguments and callbacks are the same as for InvokeCommandRequest.
+     *
+     * If this returns an error, neither callback will be called for this command.
+     */
+    template <typename RequestObjectT, typename std::enable_if_t<!RequestObjectT::MustUseTimedInvoke(), int> = 0>
+    CHIP_ERROR Invoke(EndpointId endpointId, const RequestObjectT & requestCommandData,
+                      typename TypedCommandCallback<typename RequestObjectT::ResponseType>::OnSuccessCallbackType onSuccessCb,
+                      typename TypedCommandCallback<typename RequestObjectT::ResponseType>::OnErrorCallbackType onErrorCb)
+    {
+        app::CommandPathParams commandPath = { endpointId, 0, RequestObjectT::GetClusterId(), RequestObjectT::GetCommandId(),
+                                               (app::CommandPathFlags::kEndpointIdValid) };
+
+        auto decoder =
+            chip::Platform::MakeUnique<TypedCommandCallback<typename RequestObjectT::ResponseType>>(onSuccessCb, onErrorCb);
+        VerifyOrReturnError(decoder != nullptr, CHIP_ERROR_NO_MEMORY);
+        decoder->SetOnDoneCallback(
+            [rawDecoderPtr = decoder.get()](app::CommandSender * commandSender) { chip::Platform::Delete(rawDecoderPtr); });
+
+        ReturnErrorOnFailure(AddCommand(
+            commandPath,
+            [&](app::CommandSender & sender, app::CommandSender::AdditionalCommandParameters & params) {
+                return sender.AddRequestData(commandPath, requestCommandData, params);
+            },
+            decoder.get()));
+
+        // The batch now owns the decoder and deletes it through OnDone.
+        decoder.release();
+        return CHIP_NO_ERROR;
+    }
+
+    /*
+     * Sends the current batch right away, without waiting for the coalescing window to expire.
+     *
+     * If sending fails, the commands of the batch are failed through their error callbacks and the error is returned.
+     */
+    CHIP_ERROR Flush();
+
+    /*
+     * Number of commands added to the current batch and not sent yet.
+     */
+    uint16_t GetPendingCommandCount() const;
+
+private:
+    class Batch;
+
+    template <typename EncodeFunctionT>
+    CHIP_ERROR AddCommand(const app::CommandPathParams & commandPath, EncodeFunctionT && encode,
+                          app::CommandSender::Callback * callback)
+    {
+        ReturnErrorOnFailure(EnsurePendingBatch());
+        if (mPendingBatch->Contains(commandPath))
+        {
+            // A command path may only appear once in an InvokeRequestMessage.
+            ReturnErrorOnFailure(Flush());
+            ReturnErrorOnFailure(EnsurePendingBatch());
+        }
+
+        app::CommandSender::AdditionalCommandParameters params;
+        CHIP_ERROR err = encode(PendingSender(), params);
+        if (err != CHIP_NO_ERROR && GetPendingCommandCount() > 0)
+        {
+            // The command most likely did not fit in the message: send what we have and retry in an empty batch.
+            ReturnErrorOnFailure(Flush());
+            ReturnErrorOnFailure(EnsurePendingBatch());
+
+            params = app::CommandSender::AdditionalCommandParameters();
+            err    = encode(PendingSender(), params);
+        }
+        if (err != CHIP_NO_ERROR)
+        {
+            // A failure on the first command of a batch leaves its CommandSender in an unknown state.
+            DiscardPendingBatch();
+            return err;
+        }
+
+        return OnCommandAdded(commandPath, callback);
+    }
+
+    CHIP_ERROR EnsurePendingBatch();
+    app::CommandSender & PendingSender();
+    void DiscardPendingBatch();
+    CHIP_ERROR OnCommandAdded(const app::CommandPathParams & commandPath, app::CommandSender::Callback * callback);
+
+    static void OnWindowExpired(System::Layer * systemLayer, void * context);
+
+    Messaging::ExchangeManager * mExchangeMgr;
+    SessionHolder mSession;
+    System::Clock::Milliseconds32 mWindow;
+    uint16_t mMaxBatchSize;
+    Batch * mPendingBatch = nullptr;
+};
+
+/*
+ * One batched invoke: the CommandSender carrying the commands and, indexed by CommandRef, the path and callbacks of each
+ * command.
+ *
+ * A batch owns itself once sent, and is destroyed when its CommandSender is done.
+ */
+class CommandCoalescer::Batch final : public app::CommandSender::ExtendableCallback
+{
+public:
+    Batch(Messaging::ExchangeManager * exchangeMgr) : mCommandSender(this, exchangeMgr) {}
+
+    CHIP_ERROR Init(uint16_t capacity)
+    {
+        VerifyOrReturnError(mCommands.Calloc(capacity), CHIP_ERROR_NO_MEMORY);
+        mCapacity = capacity;
+
+        if (capacity > 1)
+        {
+            app::CommandSender::ConfigParameters config;
+            config.SetRemoteMaxPathsPerInvoke(capacity);
+            ReturnErrorOnFailure(mCommandSender.SetCommandSenderConfig(config));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    app::CommandSender & GetCommandSender() { return mCommandSender; }
+    uint16_t GetCount() const { return mCount; }
+    bool IsFull() const { return mCount >= mCapacity; }
+
+    // CommandSender assigns CommandRefs in the order commands are finished, so the index of a command is its CommandRef.
+    void Add(const app::CommandPathParams & commandPath, app::CommandSender::Callback * callback)
+    {
+        mCommands[mCount++] = { commandPath.mEndpointId, commandPath.mClusterId, commandPath.mCommandId, callback };
+    }
+
+    bool Contains(const app::CommandPathParams & commandPath) const
+    {
+        for (uint16_t i = 0; i < mCount; i++)
+        {
+            if (mCommands[i].endpointId == commandPath.mEndpointId && mCommands[i].clusterId == commandPath.mClusterId &&
+                mCommands[i].commandId == commandPath.mCommandId)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    CHIP_ERROR Send(const SessionHandle & session) { return mCommandSender.SendCommandRequest(session); }
+
+    // Fails all the commands of a batch that could not be sent, and destroys it.
+    void Abort(CHIP_ERROR error)
+    {
+        for (uint16_t i = 0; i < mCount; i++)
+        {
+            mCommands[i].callback->OnError(&mCommandSender, error);
+        }
+        OnDone(&mCommandSender);
+    }
+
+private:
+    void OnResponse(app::CommandSender * commandSender, const app::CommandSender::ResponseData & aResponseData) override
+    {
+        // A batch with a single command is sent without CommandRef.
+        uint16_t index = aResponseData.commandRef.ValueOr(0);
+        if (index >= mCount)
+        {
+            ChipLogError(Controller, "Ignoring response with unknown CommandRef %u", index);
+            return;
+        }
+
+        // Path-specific errors reach ExtendableCallback::OnResponse, but go to Callback::OnError.
+        if (aResponseData.statusIB.IsSuccess())
+        {
+            mCommands[index].callback->OnResponse(commandSender, aResponseData.path, aResponseData.statusIB, aResponseData.data);
+        }
+        else
+        {
+            mCommands[index].callback->OnError(commandSender, aResponseData.statusIB.ToChipError());
+        }
+    }
+
+    void OnError(const app::CommandSender * commandSender, const app::CommandSender::ErrorData & aErrorData) override
+    {
+        for (uint16_t i = 0; i < mCount; i++)
+        {
+            mCommands[i].callback->OnError(commandSender, aErrorData.error);
+        }
+    }
+
+    void OnDone(app::CommandSender * commandSender) override
+    {
+        // Commands that got no response are failed by their callback's OnDone.
+        for (uint16_t i = 0; i < mCount; i++)
+        {
+            mCommands[i].callback->OnDone(commandSender);
+        }
+        chip::Platform::Delete(this);
+    }
+
+    struct Command
+    {
+        EndpointId endpointId;
+        ClusterId clusterId;
+        CommandId commandId;
+        app::CommandSender::Callback * callback;
+    };
+
+    app::CommandSender mCommandSender;
+    Platform::ScopedMemoryBuffer<Command> mCommands;
+    uint16_t mCapacity = 0;
+    uint16_t mCount    = 0;
+};
+
+inline CommandCoalescer::CommandCoalescer(Messaging::ExchangeManager * exchangeMgr, const SessionHandle & session,
+                                          System::Clock::Milliseconds32 window, uint16_t maxBatchSize) :
+    mExchangeMgr(exchangeMgr),
+    mSession(session), mWindow(window), mMaxBatchSize(std::max<uint16_t>(maxBatchSize, 1))
+{}
+
+inline CommandCoalescer::~CommandCoalescer()
+{
+    mExchangeMgr->GetSessionManager()->SystemLayer()->CancelTimer(OnWindowExpired, this);
+    if (mPendingBatch != nullptr)
+    {
+        Batch * batch = mPendingBatch;
+        mPendingBatch = nullptr;
+        batch->Abort(CHIP_ERROR_CANCELLED);
+    }
+}
+
+inline CHIP_ERROR CommandCoalescer::Flush()
+{
+    mExchangeMgr->GetSessionManager()->SystemLayer()->CancelTimer(OnWindowExpired, this);
+    VerifyOrReturnError(GetPendingCommandCount() > 0, CHIP_NO_ERROR);
+
+    Batch * batch = mPendingBatch;
+    mPendingBatch = nullptr;
+
+    CHIP_ERROR err                  = CHIP_ERROR_NOT_CONNECTED;
+    Optional<SessionHandle> session = mSession.Get();
+    if (session.HasValue())
+    {
+        err = batch->Send(session.Value());
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Controller, "Failed to send %u coalesced commands: %" CHIP_ERROR_FORMAT, batch->GetCount(), err.Format());
+        batch->Abort(err);
+    }
+    return err;
+}
+
+inline uint16_t CommandCoalescer::GetPendingCommandCount() const
+{
+    return (mPendingBatch != nullptr) ? mPendingBatch->GetCount() : 0;
+}
+
+inline CHIP_ERROR CommandCoalescer::EnsurePendingBatch()
+{
+    VerifyOrReturnError(mPendingBatch == nullptr, CHIP_NO_ERROR);
+    VerifyOrReturnError(mSession, CHIP_ERROR_NOT_CONNECTED);
+    // Batches expect responses, so cannot go over a group session.
+    VerifyOrReturnError(!mSession->IsGroupSession(), CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint16_t capacity = 1;
+#if CHIP_CONFIG_SENDING_BATCH_COMMANDS_ENABLED
+    capacity = std::min(mSession->GetRemoteSessionParameters().GetMaxPathsPerInvoke(), mMaxBatchSize);
+    capacity = std::max<uint16_t>(capacity, 1);
+#endif // CHIP_CONFIG_SENDING_BATCH_COMMANDS_ENABLED
+
+    auto batch = chip::Platform::MakeUnique<Batch>(mExchangeMgr);
+    VerifyOrReturnError(batch != nullptr, CHIP_ERROR_NO_MEMORY);
+    ReturnErrorOnFailure(batch->Init(capacity));
+
+    mPendingBatch = batch.release();
+    return CHIP_NO_ERROR;
+}
+
+inline app::CommandSender & CommandCoalescer::PendingSender()
+{
+    return mPendingBatch->GetCommandSender();
+}
+
+inline void CommandCoalescer::DiscardPendingBatch()
+{
+    VerifyOrReturn(mPendingBatch != nullptr);
+    VerifyOrDie(mPendingBatch->GetCount() == 0);
+
+    chip::Platform::Delete(mPendingBatch);
+    mPendingBatch = nullptr;
+}
+
+inline CHIP_ERROR CommandCoalescer::OnCommandAdded(const app::CommandPathParams & commandPath,
+                                                   app::CommandSender::Callback * callback)
+{
+    mPendingBatch->Add(commandPath, callback);
+
+    // The command now belongs to the batch, so from here on failures are reported through its callbacks.
+    bool sendNow = mPendingBatch->IsFull();
+    if (!sendNow && mPendingBatch->GetCount() == 1)
+    {
+        sendNow = (mExchangeMgr->GetSessionManager()->SystemLayer()->StartTimer(mWindow, OnWindowExpired, this) != CHIP_NO_ERROR);
+    }
+
+    if (sendNow)
+    {
+        (void) Flush();
+    }
+    return CHIP_NO_ERROR;
+}
+
+inline void CommandCoalescer::OnWindowExpired(System::Layer * systemLayer, void * context)
+{
+    (void) static_cast<CommandCoalescer *>(context)->Flush();
+}
+
+} // namespace Controller
+} // namespace chip
@@ -0,0 +1,331 @@
+/*
+ *
+ *    Copyright (c) 2024 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <app/CASESessionManager.h>
+#include <app/data-model/NullObject.h>
+#include <controller/InvokeInteraction.h>
+#include <credentials/GroupDataProvider.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/Optional.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/ScopedBuffer.h>
+#include <lib/support/Span.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <messaging/ExchangeMgr.h>
+#include <system/SystemClock.h>
+
+#include <algorithm>
+#include <type_traits>
+
+namespace chip {
+namespace Controller {
+
+/*
+ * The outcome of a fleet operation on one node.
+ */
+struct FleetNodeResult
+{
+    enum class Delivery : uint8_t
+    {
+        // The command was invoked over a CASE session with the node: error is the outcome of the command, or the reason the
+        // node could not be reached.
+        kUnicast,
+        // The command was sent as a group command. Group commands get no response, so error only tells whether it was sent.
+        kGroupcast,
+    };
+
+    NodeId nodeId;
+    CHIP_ERROR error;
+    Delivery delivery;
+};
+
+/*
+ * Invokes one command on a set of nodes of a fabric, and collects the outcome on every node.
+ *
+ * The command is sent once, as a group command, when the application names a group whose members are exactly the target
+ * nodes, the command needs neither response data nor a timed invoke, and the fabric has keys for the group. Otherwise, or if
+ * the group command cannot be sent, the command is invoked on every node over its CASE session, with at most
+ * maxConcurrentNodes nodes establishing their session or waiting for their response at any time. Sessions are found or
+ * established through the CASESessionManager, which reuses the sessions and OperationalSessionSetup objects it already has.
+ *
+ * The command data is copied, but not the lists or strings it points to, which must stay valid until OnDone() is called.
+ *
+ * An operation must not be destroyed before OnDone() is called, but may be destroyed from OnDone(). All methods must be
+ * called with the Matter stack lock held.
+ */
+class FleetOperation
+{
+public:
+    static constexpr uint16_t kDefaultMaxConcurrentNodes = CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_CASE_CLIENTS;
+
+    class Callback
+    {
+    public:
+        virtual ~Callback() = default;
+
+        /*
+         * Called once for every node, as soon as its outcome is known.
+         */
+        virtual void OnNodeResult(FleetOperation & operation, const FleetNodeResult & result) {}
+
+        /*
+         * Called once every node has its outcome, which GetResults() returns. The operation may be destroyed from here.
+         */
+        virtual void OnDone(FleetOperation & operation) = 0;
+    };
+
+    struct Params
+    {
+        Messaging::ExchangeManager * exchangeMgr           = nullptr;
+        CASESessionManager * caseSessionManager            = nullptr;
+        Credentials::GroupDataProvider * groupDataProvider = nullptr;
+        FabricIndex fabricIndex                            = kUndefinedFabricIndex;
+        // A group whose members are exactly the target nodes, if the application maintains one. Group commands go to every
+        // endpoint of the nodes that is in the group, rather than to the given endpoint.
+        Optional<GroupId> groupId;
+        uint16_t maxConcurrentNodes = kDefaultMaxConcurrentNodes;
+        Optional<uint16_t> timedInvokeTimeoutMs;
+        Optional<System::Clock::Timeout> responseTimeout;
+    };
+
+    FleetOperation(Callback & callback) : mCallback(callback) {}
+
+    FleetOperation(const FleetOperation &)             = delete;
+    FleetOperation & operator=(const FleetOperation &) = delete;
+
+    /*
+     * Starts invoking the command on the given nodes.
+     *
+     * If this returns CHIP_NO_ERROR, OnNodeResult() is called once for every node and then OnDone() is called, possibly
+     * before this returns. Otherwise no callback is called.
+     */
+    template <typename RequestObjectT>
+    CHIP_ERROR Invoke(const Params & params, Span<const NodeId> nodes, EndpointId endpointId, const RequestObjectT & request)
+    {
+        VerifyOrReturnError(!mStarted, CHIP_ERROR_INCORRECT_STATE);
+        VerifyOrReturnError(params.exchangeMgr != nullptr && params.fabricIndex != kUndefinedFabricIndex,
+                            CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrReturnError(!RequestObjectT::MustUseTimedInvoke() || params.timedInvokeTimeoutMs.HasValue(),
+                            CHIP_ERROR_INVALID_ARGUMENT);
+        VerifyOrReturnError(mResults.Calloc(std::max<size_t>(nodes.size(), 1)), CHIP_ERROR_NO_MEMORY);
+
+        mParams                    = params;
+        mParams.maxConcurrentNodes = std::max<uint16_t>(params.maxConcurrentNodes, 1);
+        mNodeCount                 = nodes.size();
+        for (size_t i = 0; i < mNodeCount; i++)
+        {
+            mResults[i] = { nodes[i], CHIP_NO_ERROR, FleetNodeResult::Delivery::kUnicast };
+        }
+
+        constexpr bool groupcastable = std::is_same<typename RequestObjectT::ResponseType, app::DataModel::NullObjectType>::value &&
+            !RequestObjectT::MustUseTimedInvoke();
+        if (groupcastable && CanGroupcast())
+        {
+            CHIP_ERROR err = InvokeGroupCommandRequest(mParams.exchangeMgr, mParams.fabricIndex, mParams.groupId.Value(), request);
+            if (err == CHIP_NO_ERROR)
+            {
+                mStarted = true;
+                CompleteGroupcast();
+                return CHIP_NO_ERROR;
+            }
+            ChipLogError(Controller, "Group command to 0x%04x failed, falling back to unicast: %" CHIP_ERROR_FORMAT,
+                         mParams.groupId.Value(), err.Format());
+        }
+
+        VerifyOrReturnError(mParams.caseSessionManager != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+        mRequest.reset(Platform::New<TypedRequest<RequestObjectT>>(endpointId, request));
+        VerifyOrReturnError(mRequest != nullptr, CHIP_ERROR_NO_MEMORY);
+
+        mStarted = true;
+        StartPendingNodes();
+        return CHIP_NO_ERROR;
+    }
+
+    /*
+     * The outcome on every node, in the order of the nodes given to Invoke(). Complete once OnDone() is called.
+     */
+    Span<const FleetNodeResult> GetResults() const { return Span<const FleetNodeResult>(mResults.Get(), mNodeCount); }
+
+    size_t GetCompletedCount() const { return mCompletedCount; }
+
+private:
+    // Type-erased command data, to invoke it on every node as its session becomes available.
+    class Request
+    {
+    public:
+        virtual ~Request() = default;
+        virtual CHIP_ERROR Invoke(FleetOperation & operation, size_t index, Messaging::ExchangeManager & exchangeMgr,
+                                  const SessionHandle & session) = 0;
+    };
+
+    template <typename RequestObjectT>
+    class TypedRequest final : public Request
+    {
+    public:
+        TypedRequest(EndpointId endpointId, const RequestObjectT & request) : mEndpointId(endpointId), mRequest(request) {}
+
+        CHIP_ERROR Invoke(FleetOperation & operation, size_t index, Messaging::ExchangeManager & exchangeMgr,
+                          const SessionHandle & session) override
+        {
+            FleetOperation * op = &operation;
+            return InvokeCommandRequest(
+                &exchangeMgr, session, mEndpointId, mRequest,
+                [op, index](const app::ConcreteCommandPath & path, const app::StatusIB & status, const auto & response) {
+                    op->CompleteNode(index, CHIP_NO_ERROR);
+                },
+                [op, index](CHIP_ERROR error) { op->CompleteNode(index, error); }, operation.mParams.timedInvokeTimeoutMs,
+                operation.mParams.responseTimeout);
+        }
+
+    private:
+        EndpointId mEndpointId;
+        RequestObjectT mRequest;
+    };
+
+    // Waits for the session of one node. Deletes itself once called back.
+    class NodeConnection
+    {
+    public:
+        NodeConnection(FleetOperation & operation, size_t index) :
+            mOperation(operation), mIndex(index), mOnConnected(OnConnected, this), mOnFailure(OnFailure, this)
+        {}
+
+        void Connect(CASESessionManager & caseSessionManager, const ScopedNodeId & peerId)
+        {
+            caseSessionManager.FindOrEstablishSession(peerId, &mOnConnected, &mOnFailure);
+        }
+
+    private:
+        static void OnConnected(void * context, Messaging::ExchangeManager & exchangeMgr, const SessionHandle & session)
+        {
+            auto * self                = static_cast<NodeConnection *>(context);
+            FleetOperation & operation = self->mOperation;
+            size_t index               = self->mIndex;
+            Platform::Delete(self);
+
+            CHIP_ERROR err = operation.mRequest->Invoke(operation, index, exchangeMgr, session);
+            if (err != CHIP_NO_ERROR)
+            {
+                operation.CompleteNode(index, err);
+            }
+        }
+
+        static void OnFailure(void * context, const ScopedNodeId & peerId, CHIP_ERROR error)
+        {
+            auto * self                = static_cast<NodeConnection *>(context);
+            FleetOperation & operation = self->mOperation;
+            size_t index               = self->mIndex;
+            Platform::Delete(self);
+
+            operation.CompleteNode(index, error);
+        }
+
+        FleetOperation & mOperation;
+        size_t mIndex;
+        chip::Callback::Callback<OnDeviceConnected> mOnConnected;
+        chip::Callback::Callback<OnDeviceConnectionFailure> mOnFailure;
+    };
+
+    bool CanGroupcast() const
+    {
+        VerifyOrReturnValue(mParams.groupId.HasValue() && mParams.groupDataProvider != nullptr, false);
+
+        bool hasKeys = false;
+        auto * iter  = mParams.groupDataProvider->IterateGroupKeys(mParams.fabricIndex);
+        VerifyOrReturnValue(iter != nullptr, false);
+        Credentials::GroupDataProvider::GroupKey mapping;
+        while (!hasKeys && iter->Next(mapping))
+        {
+            hasKeys = (mapping.group_id == mParams.groupId.Value());
+        }
+        iter->Release();
+        return hasKeys;
+    }
+
+    void CompleteGroupcast()
+    {
+        // Results are recorded before any callback, in case OnDone() destroys the operation.
+        for (size_t i = 0; i < mNodeCount; i++)
+        {
+            mResults[i].delivery = FleetNodeResult::Delivery::kGroupcast;
+        }
+        mCompletedCount = mNodeCount;
+
+        for (size_t i = 0; i < mNodeCount; i++)
+        {
+            mCallback.OnNodeResult(*this, mResults[i]);
+        }
+        mCallback.OnDone(*this);
+    }
+
+    // Starts as many nodes as the concurrency limit allows, then reports completion if every node is done. Nodes that
+    // complete synchronously come back through CompleteNode(), which only calls this again once the outer call returned, so
+    // the stack does not grow with the number of nodes.
+    void StartPendingNodes()
+    {
+        VerifyOrReturn(!mStartingNodes);
+        mStartingNodes = true;
+        while (mInFlightCount < mParams.maxConcurrentNodes && mNextNode < mNodeCount)
+        {
+            size_t index = mNextNode++;
+            mInFlightCount++;
+
+            auto * connection = Platform::New<NodeConnection>(*this, index);
+            if (connection == nullptr)
+            {
+                CompleteNode(index, CHIP_ERROR_NO_MEMORY);
+                continue;
+            }
+            connection->Connect(*mParams.caseSessionManager, ScopedNodeId(mResults[index].nodeId, mParams.fabricIndex));
+        }
+        mStartingNodes = false;
+
+        if (mCompletedCount == mNodeCount)
+        {
+            mCallback.OnDone(*this);
+            // Do not touch `this` anymore: OnDone() may have destroyed it.
+        }
+    }
+
+    void CompleteNode(size_t index, CHIP_ERROR error)
+    {
+        mResults[index].error = error;
+        mCompletedCount++;
+        mInFlightCount--;
+        mCallback.OnNodeResult(*this, mResults[index]);
+        StartPendingNodes();
+    }
+
+    Callback & mCallback;
+    Params mParams;
+    Platform::UniquePtr<Request> mRequest;
+    // Indexed like the nodes given to Invoke().
+    Platform::ScopedMemoryBuffer<FleetNodeResult> mResults;
+    size_t mNodeCount      = 0;
+    size_t mNextNode       = 0;
+    size_t mCompletedCount = 0;
+    size_t mInFlightCount  = 0;
+    bool mStarted          = false;
+    bool mStartingNodes    = false;
+};
+
+} // namespace Controller
+} // namespace chip
@@ -53,9 +53,10 @@ using Py_SetNodeIdForNextNOCRequest   = void (*)(void * pyContext, NodeId nodeId
 using Py_SetFabricIdForNextNOCRequest = void (*)(void * pyContext, FabricId fabricId);
 
 namespace {
-const chip::Credentials::AttestationTrustStore * GetTestFileAttestationTrustStore(const char * paaTrustStorePath)
+const chip::Credentials::AttestationTrustStore * GetTestFileAttestationTrustStore(const char * paaTrustStorePath,
+                                                                                 const char * paaTrustStoreIndexPath)
 {
-    static chip::Credentials::FileAttestationTrustStore attestationTrustStore{ paaTrustStorePath };
+    static chip::Credentials::FileAttestationTrustStore attestationTrustStore{ paaTrustStorePath, paaTrustStoreIndexPath };
 
     return &attestationTrustStore;
 }
@@ -458,9 +459,9 @@ PyChipError pychip_OpCreds_AllocateControllerForPythonCommissioningFLow(chip::Co
 // TODO(#25214): Need clean up API
 PyChipError pychip_OpCreds_AllocateController(OpCredsContext * context, chip::Controller::DeviceCommissioner ** outDevCtrl,
                                               FabricId fabricId, chip::NodeId nodeId, chip::VendorId adminVendorId,
-                                              const char * paaTrustStorePath, bool useTestCommissioner,
-                                              bool enableServerInteractions, CASEAuthTag * caseAuthTags, uint32_t caseAuthTagLen,
-                                              chip::python::pychip_P256Keypair * operationalKey)
+                                              const char * paaTrustStorePath, const char * paaTrustStoreIndexPath,
+                                              bool useTestCommissioner, bool enableServerInteractions, CASEAuthTag * caseAuthTags,
+                                              uint32_t caseAuthTagLen, chip::python::pychip_P256Keypair * operationalKey)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
@@ -479,7 +480,8 @@ PyChipError pychip_OpCreds_AllocateController(OpCredsContext * context, chip::Co
     ChipLogProgress(Support, "Using device attestation PAA trust store path %s.", paaTrustStorePath);
 
     // Initialize device attestation verifier
-    const chip::Credentials::AttestationTrustStore * testingRootStore = GetTestFileAttestationTrustStore(paaTrustStorePath);
+    const chip::Credentials::AttestationTrustStore * testingRootStore =
+        GetTestFileAttestationTrustStore(paaTrustStorePath, paaTrustStoreIndexPath);
     SetDeviceAttestationVerifier(GetDefaultDACVerifier(testingRootStore));
 
     chip::Crypto::P256Keypair ephemeralKey;
@@ -1364,6 +1364,49 @@ class ChipDeviceControllerBase():
         else:
             return res.events
 
+    async def ReadMultiple(self, requests: typing.List[typing.Union[
+            typing.Tuple[int, typing.List[typing.Any]],
+            typing.Tuple[int, typing.List[typing.Any], typing.List[typing.Any]]]],
+            maxInFlight: int = 16, returnClusterObject: bool = False, reportInterval: typing.Tuple[int, int] = None,
+            fabricFiltered: bool = True, keepSubscriptions: bool = False, autoResubscribe: bool = True):
+        '''
+        Read from (or subscribe to) many nodes with a single call.
+
+        Unlike awaiting Read once per node, CASE session setup and the reads of all nodes are driven concurrently by the
+        native stack, with at most maxInFlight nodes connecting or waiting for their initial report at any time.
+        Only operational (CASE) sessions are used.
+
+        requests: A list of (nodeid, attributes) or (nodeid, attributes, events) tuples, where attributes and events take
+            the same forms as in Read(). Either may be None or empty.
+        maxInFlight: Upper bound on concurrently connecting/reading nodes. The default matches the size of the CASE
+            client pool (CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_CASE_CLIENTS).
+        returnClusterObject, reportInterval, fabricFiltered, keepSubscriptions, autoResubscribe: as in Read(), applied to
+            every node.
+
+        Returns:
+            - A list with one entry per request, in request order: the AsyncReadTransaction.ReadResponse (or
+              SubscriptionTransaction when reportInterval is given) on success, or the exception raised for that node.
+              A failing node does not affect the others.
+        '''
+        self.CheckIsActive()
+
+        bulkRequests = []
+        for request in requests:
+            nodeid, attributes = request[0], request[1]
+            events = request[2] if len(request) > 2 else None
+            bulkRequests.append(ClusterAttribute.BulkReadRequest(
+                NodeId=nodeid,
+                Attributes=[self._parseAttributePathTuple(v) for v in attributes] if attributes else None,
+                Events=[self._parseEventPathTuple(v) for v in events] if events else None))
+
+        futures = ClusterAttribute.BulkRead(
+            eventLoop=asyncio.get_running_loop(), devCtrl=self, requests=bulkRequests, maxInFlight=maxInFlight,
+            returnClusterObject=returnClusterObject,
+            subscriptionParameters=ClusterAttribute.SubscriptionParameters(
+                reportInterval[0], reportInterval[1]) if reportInterval else None,
+            fabricFiltered=fabricFiltered, keepSubscriptions=keepSubscriptions, autoResubscribe=autoResubscribe)
+        return await asyncio.gather(*futures, return_exceptions=True)
+
     def ZCLSend(self, cluster, command, nodeid, endpoint, groupid, args, blocking=False):
         ''' Wrapper over SendCommand that catches the exceptions
             Returns a tuple of (errorCode, CommandResponse)
@@ -1695,7 +1738,7 @@ class ChipDeviceControllerBase():
             self._dmLib.pychip_DeviceController_GetLogFilter = c_uint8
 
             self._dmLib.pychip_OpCreds_AllocateController.argtypes = [c_void_p, POINTER(
-                c_void_p), c_uint64, c_uint64, c_uint16, c_char_p, c_bool, c_bool, POINTER(c_uint32), c_uint32, c_void_p]
+                c_void_p), c_uint64, c_uint64, c_uint16, c_char_p, c_char_p, c_bool, c_bool, POINTER(c_uint32), c_uint32, c_void_p]
             self._dmLib.pychip_OpCreds_AllocateController.restype = PyChipError
 
             self._dmLib.pychip_OpCreds_AllocateControllerForPythonCommissioningFLow.argtypes = [
@@ -1713,7 +1756,8 @@ class ChipDeviceController(ChipDeviceControllerBase):
     '''
 
     def __init__(self, opCredsContext: ctypes.c_void_p, fabricId: int, nodeId: int, adminVendorId: int, catTags: typing.List[int] = [
-    ], paaTrustStorePath: str = "", useTestCommissioner: bool = False, fabricAdmin: FabricAdmin = None, name: str = None, keypair: p256keypair.P256Keypair = None):
+    ], paaTrustStorePath: str = "", useTestCommissioner: bool = False, fabricAdmin: FabricAdmin = None, name: str = None, keypair: p256keypair.P256Keypair = None,
+            paaTrustStoreIndexPath: str = ""):
         super().__init__(
             name or
             f"caIndex({fabricAdmin.caIndex:x})/fabricId(0x{fabricId:016X})/nodeId(0x{nodeId:016X})"
@@ -1732,7 +1776,7 @@ class ChipDeviceController(ChipDeviceControllerBase):
         self._externalKeyPair = keypair
         self._ChipStack.Call(
             lambda: self._dmLib.pychip_OpCreds_AllocateController(c_void_p(
-                opCredsContext), pointer(devCtrl), fabricId, nodeId, adminVendorId, c_char_p(None if len(paaTrustStorePath) == 0 else str.encode(paaTrustStorePath)), useTestCommissioner, self._ChipStack.enableServerInteractions, c_catTags, len(catTags), None if keypair is None else keypair.native_object)
+                opCredsContext), pointer(devCtrl), fabricId, nodeId, adminVendorId, c_char_p(None if len(paaTrustStorePath) == 0 else str.encode(paaTrustStorePath)), c_char_p(None if len(paaTrustStoreIndexPath) == 0 else str.encode(paaTrustStoreIndexPath)), useTestCommissioner, self._ChipStack.enableServerInteractions, c_catTags, len(catTags), None if keypair is None else keypair.native_object)
         ).raise_on_error()
 
         self._fabricAdmin = fabricAdmin
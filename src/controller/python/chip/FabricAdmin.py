@@ -66,7 +66,8 @@ class FabricAdmin:
         self._activeControllers = []
 
     def NewController(self, nodeId: int = None, paaTrustStorePath: str = "",
-                      useTestCommissioner: bool = False, catTags: List[int] = [], keypair: p256keypair.P256Keypair = None):
+                      useTestCommissioner: bool = False, catTags: List[int] = [], keypair: p256keypair.P256Keypair = None,
+                      paaTrustStoreIndexPath: str = ""):
         ''' Create a new chip.ChipDeviceCtrl.ChipDeviceController instance on this fabric.
 
             When vending ChipDeviceController instances on a given fabric, each controller instance
@@ -77,6 +78,8 @@ class FabricAdmin:
                             is not provided.
 
             paaTrustStorePath:      Path to the PAA trust store. If one isn't provided, a suitable default is selected.
+            paaTrustStoreIndexPath: Path to a file where the PAA trust store index is persisted across runs. The index
+                                    is only kept in memory if one isn't provided.
             useTestCommissioner:    If a test commmisioner is to be created.
             catTags:			    A list of 32-bit CAT tags that will added to the NOC generated for this controller.
         '''
@@ -104,6 +107,7 @@ class FabricAdmin:
             nodeId=nodeId,
             adminVendorId=self._vendorId,
             paaTrustStorePath=paaTrustStorePath,
+            paaTrustStoreIndexPath=paaTrustStoreIndexPath,
             useTestCommissioner=useTestCommissioner,
             fabricAdmin=self,
             catTags=catTags,
@@ -33,6 +33,7 @@ import chip
 import chip.exceptions
 import chip.interaction_model
 import chip.tlv
+import chip.tlv.native
 import construct
 from chip.native import ErrorSDKPart, PyChipError
 from rich.pretty import pprint
@@ -330,6 +331,13 @@ class SubscriptionParameters:
     MaxReportIntervalCeilingSeconds: int
 
 
+@dataclass
+class BulkReadRequest:
+    NodeId: int
+    Attributes: List[AttributePath] = None
+    Events: List[EventPath] = None
+
+
 class DataVersion:
     '''
     A helper class as a key for getting cluster data version when reading attributes without returnClusterObject.
@@ -672,22 +680,40 @@ class AsyncReadTransaction:
     def GetAllEventValues(self):
         return self._events
 
-    def handleAttributeData(self, path: AttributePathWithListIndex, dataVersion: int, status: int, data: bytes):
-        try:
-            imStatus = chip.interaction_model.Status(status)
+    def _handleAttributeValue(self, path: AttributePath, dataVersion: int, status: int, decodeValue: Callable[[], Any]):
+        imStatus = chip.interaction_model.Status(status)
 
-            if (imStatus != chip.interaction_model.Status.Success):
-                attributeValue = ValueDecodeFailure(
-                    None, chip.interaction_model.InteractionModelError(imStatus))
-            else:
-                tlvData = chip.tlv.TLVReader(data).get().get("Any", {})
-                attributeValue = tlvData
+        if (imStatus != chip.interaction_model.Status.Success):
+            attributeValue = ValueDecodeFailure(
+                None, chip.interaction_model.InteractionModelError(imStatus))
+        else:
+            attributeValue = decodeValue()
+
+        self._cache.UpdateTLV(path, dataVersion, attributeValue)
+        self._changedPathSet.add(path)
 
-            self._cache.UpdateTLV(path, dataVersion, attributeValue)
-            self._changedPathSet.add(path)
+    def handleAttributeData(self, path: AttributePathWithListIndex, dataVersion: int, status: int, data: bytes):
+        try:
+            self._handleAttributeValue(path, dataVersion, status, lambda: chip.tlv.TLVReader(data).get().get("Any", {}))
+        except Exception as ex:
+            logging.exception(ex)
 
+    def handleAttributeBatch(self, data: bytes):
+        ''' Handles all attribute data of a report at once. The data was already decoded
+            by the native library into the JSON form understood by chip.tlv.native.
+        '''
+        try:
+            reports = chip.tlv.native.loads(data)
         except Exception as ex:
             logging.exception(ex)
+            return
+
+        for endpoint, cluster, attribute, dataVersion, status, value in reports:
+            try:
+                path = AttributePath(EndpointId=int(endpoint), ClusterId=int(cluster), AttributeId=int(attribute))
+                self._handleAttributeValue(path, int(dataVersion), status, lambda value=value: value)
+            except Exception as ex:
+                logging.exception(ex)
 
     def handleEventData(self, header: EventHeader, path: EventPath, data: bytes, status: int):
         try:
@@ -861,6 +887,8 @@ class AsyncWriteTransaction:
 
 _OnReadAttributeDataCallbackFunct = CFUNCTYPE(
     None, py_object, c_uint32, c_uint16, c_uint32, c_uint32, c_uint8, c_void_p, c_size_t)
+_OnReadAttributeBatchCallbackFunct = CFUNCTYPE(
+    None, py_object, c_void_p, c_size_t)
 _OnSubscriptionEstablishedCallbackFunct = CFUNCTYPE(None, py_object, c_uint32)
 _OnResubscriptionAttemptedCallbackFunct = CFUNCTYPE(None, py_object, PyChipError, c_uint32)
 _OnReadEventDataCallbackFunct = CFUNCTYPE(
@@ -873,6 +901,8 @@ _OnReportBeginCallbackFunct = CFUNCTYPE(
     None, py_object)
 _OnReportEndCallbackFunct = CFUNCTYPE(
     None, py_object)
+_OnBulkReadClientCreatedCallbackFunct = CFUNCTYPE(
+    None, py_object, c_void_p, c_void_p)
 
 
 @_OnReadAttributeDataCallbackFunct
@@ -882,6 +912,11 @@ def _OnReadAttributeDataCallback(closure, dataVersion: int, endpoint: int, clust
         EndpointId=endpoint, ClusterId=cluster, AttributeId=attribute), dataVersion, status, dataBytes[:])
 
 
+@_OnReadAttributeBatchCallbackFunct
+def _OnReadAttributeBatchCallback(closure, data, len):
+    closure.handleAttributeBatch(ctypes.string_at(data, len))
+
+
 @_OnReadEventDataCallbackFunct
 def _OnReadEventDataCallback(closure, endpoint: int, cluster: int, event: c_uint64,
                              number: int, priority: int, timestamp: int, timestampType: int, data, len, status):
@@ -926,6 +961,11 @@ def _OnReadDoneCallback(closure):
     closure.handleDone()
 
 
+@_OnBulkReadClientCreatedCallbackFunct
+def _OnBulkReadClientCreatedCallback(closure, readClient, readCallback):
+    closure.SetClientObjPointers(c_void_p(readClient), c_void_p(readCallback))
+
+
 _OnWriteResponseCallbackFunct = CFUNCTYPE(
     None, py_object, c_uint16, c_uint32, c_uint32, c_uint16)
 _OnWriteErrorCallbackFunct = CFUNCTYPE(
@@ -1024,6 +1064,47 @@ _ReadParams = construct.Struct(
 )
 
 
+def _BuildAttributePathIB(attr: AttributePath) -> bytes:
+    path = chip.interaction_model.AttributePathIBstruct.parse(
+        b'\xff' * chip.interaction_model.AttributePathIBstruct.sizeof())
+    if attr.EndpointId is not None:
+        path.EndpointId = attr.EndpointId
+    if attr.ClusterId is not None:
+        path.ClusterId = attr.ClusterId
+    if attr.AttributeId is not None:
+        path.AttributeId = attr.AttributeId
+    return chip.interaction_model.AttributePathIBstruct.build(path)
+
+
+def _BuildEventPathIB(event: EventPath, isSubscription: bool) -> bytes:
+    path = chip.interaction_model.EventPathIBstruct.parse(
+        b'\xff' * chip.interaction_model.EventPathIBstruct.sizeof())
+    if event.EndpointId is not None:
+        path.EndpointId = event.EndpointId
+    if event.ClusterId is not None:
+        path.ClusterId = event.ClusterId
+    if event.EventId is not None:
+        path.EventId = event.EventId
+    if event.Urgent is not None and isSubscription:
+        path.Urgent = event.Urgent
+    else:
+        path.Urgent = 0
+    return chip.interaction_model.EventPathIBstruct.build(path)
+
+
+def _BuildReadParams(subscriptionParameters: SubscriptionParameters, fabricFiltered: bool, keepSubscriptions: bool,
+                     autoResubscribe: bool) -> bytes:
+    params = _ReadParams.parse(b'\x00' * _ReadParams.sizeof())
+    if subscriptionParameters is not None:
+        params.MinInterval = subscriptionParameters.MinReportIntervalFloorSeconds
+        params.MaxInterval = subscriptionParameters.MaxReportIntervalCeilingSeconds
+        params.AutoResubscribe = autoResubscribe
+        params.IsSubscription = True
+        params.KeepSubscriptions = keepSubscriptions
+    params.IsFabricFiltered = fabricFiltered
+    return _ReadParams.build(params)
+
+
 def Read(future: Future, eventLoop, device, devCtrl,
          attributes: List[AttributePath] = None, dataVersionFilters: List[DataVersionFilter] = None,
          events: List[EventPath] = None, eventNumberFilter: Optional[int] = None, returnClusterObject: bool = True,
@@ -1041,16 +1122,7 @@ def Read(future: Future, eventLoop, device, devCtrl,
 
     if attributes is not None:
         for attr in attributes:
-            path = chip.interaction_model.AttributePathIBstruct.parse(
-                b'\xff' * chip.interaction_model.AttributePathIBstruct.sizeof())
-            if attr.EndpointId is not None:
-                path.EndpointId = attr.EndpointId
-            if attr.ClusterId is not None:
-                path.ClusterId = attr.ClusterId
-            if attr.AttributeId is not None:
-                path.AttributeId = attr.AttributeId
-            path = chip.interaction_model.AttributePathIBstruct.build(path)
-            readargs.append(ctypes.c_char_p(path))
+            readargs.append(ctypes.c_char_p(_BuildAttributePathIB(attr)))
 
     if dataVersionFilters is not None:
         for f in dataVersionFilters:
@@ -1077,34 +1149,13 @@ def Read(future: Future, eventLoop, device, devCtrl,
 
     if events is not None:
         for event in events:
-            path = chip.interaction_model.EventPathIBstruct.parse(
-                b'\xff' * chip.interaction_model.EventPathIBstruct.sizeof())
-            if event.EndpointId is not None:
-                path.EndpointId = event.EndpointId
-            if event.ClusterId is not None:
-                path.ClusterId = event.ClusterId
-            if event.EventId is not None:
-                path.EventId = event.EventId
-            if event.Urgent is not None and subscriptionParameters is not None:
-                path.Urgent = event.Urgent
-            else:
-                path.Urgent = 0
-            path = chip.interaction_model.EventPathIBstruct.build(path)
-            readargs.append(ctypes.c_char_p(path))
+            readargs.append(ctypes.c_char_p(_BuildEventPathIB(event, subscriptionParameters is not None)))
 
     readClientObj = ctypes.POINTER(c_void_p)()
     readCallbackObj = ctypes.POINTER(c_void_p)()
 
     ctypes.pythonapi.Py_IncRef(ctypes.py_object(transaction))
-    params = _ReadParams.parse(b'\x00' * _ReadParams.sizeof())
-    if subscriptionParameters is not None:
-        params.MinInterval = subscriptionParameters.MinReportIntervalFloorSeconds
-        params.MaxInterval = subscriptionParameters.MaxReportIntervalCeilingSeconds
-        params.AutoResubscribe = autoResubscribe
-        params.IsSubscription = True
-        params.KeepSubscriptions = keepSubscriptions
-    params.IsFabricFiltered = fabricFiltered
-    params = _ReadParams.build(params)
+    params = _BuildReadParams(subscriptionParameters, fabricFiltered, keepSubscriptions, autoResubscribe)
     eventNumberFilterPtr = ctypes.POINTER(ctypes.c_ulonglong)()
     if eventNumberFilter is not None:
         eventNumberFilterPtr = ctypes.POINTER(ctypes.c_ulonglong)(ctypes.c_ulonglong(eventNumberFilter))
@@ -1130,6 +1181,62 @@ def Read(future: Future, eventLoop, device, devCtrl,
     return res
 
 
+def BulkRead(eventLoop, devCtrl, requests: List[BulkReadRequest], maxInFlight: int, returnClusterObject: bool = True,
+             subscriptionParameters: SubscriptionParameters = None, fabricFiltered: bool = True,
+             keepSubscriptions: bool = False, autoResubscribe: bool = True) -> List[Future]:
+    ''' Reads from (or subscribes to) every node in requests, with at most maxInFlight of them establishing a session
+        or waiting for their initial report at a time. Sessions are set up and reads are issued by the native library.
+
+        Returns one future per request, resolved exactly like the future passed to Read.
+    '''
+    if not requests:
+        return []
+
+    handle = chip.native.GetLibraryHandle()
+
+    futures = []
+    transactions = []
+    nodeIds = (c_uint64 * len(requests))()
+    numAttributePaths = (c_uint32 * len(requests))()
+    numEventPaths = (c_uint32 * len(requests))()
+    attributePaths = bytearray()
+    eventPaths = bytearray()
+
+    for i, request in enumerate(requests):
+        future = eventLoop.create_future()
+        futures.append(future)
+        transactions.append(AsyncReadTransaction(future, eventLoop, devCtrl, returnClusterObject))
+
+        nodeIds[i] = request.NodeId
+        attributes = request.Attributes or []
+        events = request.Events or []
+        numAttributePaths[i] = len(attributes)
+        numEventPaths[i] = len(events)
+        for attr in attributes:
+            attributePaths += _BuildAttributePathIB(attr)
+        for event in events:
+            eventPaths += _BuildEventPathIB(event, subscriptionParameters is not None)
+
+    appContexts = (py_object * len(requests))(*transactions)
+    params = _BuildReadParams(subscriptionParameters, fabricFiltered, keepSubscriptions, autoResubscribe)
+
+    for transaction in transactions:
+        ctypes.pythonapi.Py_IncRef(ctypes.py_object(transaction))
+
+    res = builtins.chipStack.Call(
+        lambda: handle.pychip_ReadClient_BulkRead(
+            devCtrl.devCtrl, ctypes.c_char_p(params), len(requests), nodeIds, appContexts,
+            numAttributePaths, bytes(attributePaths), numEventPaths, bytes(eventPaths), maxInFlight,
+            _OnBulkReadClientCreatedCallback))
+
+    if not res.is_success:
+        for transaction in transactions:
+            ctypes.pythonapi.Py_DecRef(ctypes.py_object(transaction))
+        res.raise_on_error()
+
+    return futures
+
+
 def ReadAttributes(future: Future, eventLoop, device, devCtrl,
                    attributes: List[AttributePath], dataVersionFilters: List[DataVersionFilter] = None,
                    returnClusterObject: bool = True,
@@ -1175,18 +1282,31 @@ def Init():
                    _OnWriteResponseCallbackFunct, _OnWriteErrorCallbackFunct, _OnWriteDoneCallbackFunct])
         handle.pychip_ReadClient_Read.restype = PyChipError
         setter.Set('pychip_ReadClient_InitCallbacks', None, [
-                   _OnReadAttributeDataCallbackFunct, _OnReadEventDataCallbackFunct,
+                   _OnReadAttributeDataCallbackFunct, _OnReadAttributeBatchCallbackFunct, _OnReadEventDataCallbackFunct,
                    _OnSubscriptionEstablishedCallbackFunct, _OnResubscriptionAttemptedCallbackFunct,
                    _OnReadErrorCallbackFunct, _OnReadDoneCallbackFunct,
                    _OnReportBeginCallbackFunct, _OnReportEndCallbackFunct])
+        setter.Set('pychip_ReadClient_SetBatchAttributeReports', None, [ctypes.c_bool])
+        handle.pychip_ReadClient_BulkRead.restype = PyChipError
+        handle.pychip_ReadClient_BulkRead.argtypes = [
+            c_void_p, ctypes.c_char_p, c_size_t, ctypes.POINTER(c_uint64), ctypes.POINTER(py_object),
+            ctypes.POINTER(c_uint32), ctypes.c_char_p, ctypes.POINTER(c_uint32), ctypes.c_char_p, c_size_t,
+            _OnBulkReadClientCreatedCallbackFunct]
 
     handle.pychip_WriteClient_InitCallbacks(
         _OnWriteResponseCallback, _OnWriteErrorCallback, _OnWriteDoneCallback)
     handle.pychip_ReadClient_InitCallbacks(
-        _OnReadAttributeDataCallback, _OnReadEventDataCallback,
+        _OnReadAttributeDataCallback, _OnReadAttributeBatchCallback, _OnReadEventDataCallback,
         _OnSubscriptionEstablishedCallback, _OnResubscriptionAttemptedCallback, _OnReadErrorCallback, _OnReadDoneCallback,
         _OnReportBeginCallback, _OnReportEndCallback)
 
     _BuildAttributeIndex()
     _BuildClusterIndex()
     _BuildEventIndex()
+
+
+def SetBatchAttributeReports(enabled: bool):
+    ''' Attribute data is decoded by the native library and delivered once per report by default
+        (see chip.tlv.native). Disabling this hands every attribute to python as raw TLV instead.
+    '''
+    chip.native.GetLibraryHandle().pychip_ReadClient_SetBatchAttributeReports(enabled)
@@ -16,9 +16,13 @@
  */
 
 #include "system/SystemClock.h"
+#include <algorithm>
+#include <cinttypes>
 #include <cstdarg>
 #include <memory>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 #include <app/BufferedReadCallback.h>
 #include <app/ChunkedWriteCallback.h>
@@ -28,6 +32,7 @@
 #include <app/WriteClient.h>
 #include <controller/CHIPDeviceController.h>
 #include <controller/python/chip/native/PyChipError.h>
+#include <controller/python/chip/tlv/decode.h>
 #include <lib/support/CodeUtils.h>
 
 #include <cstdio>
@@ -71,6 +76,7 @@ using OnReadAttributeDataCallback       = void (*)(PyObject * appContext, chip::
                                              chip::ClusterId clusterId, chip::AttributeId attributeId,
                                              std::underlying_type_t<Protocols::InteractionModel::Status> imstatus, uint8_t * data,
                                              uint32_t dataLen);
+using OnReadAttributeBatchCallback      = void (*)(PyObject * appContext, const char * json, size_t jsonLen);
 using OnReadEventDataCallback           = void (*)(PyObject * appContext, chip::EndpointId endpointId, chip::ClusterId clusterId,
                                          chip::EventId eventId, chip::EventNumber eventNumber, uint8_t priority, uint64_t timestamp,
                                          uint8_t timestampType, uint8_t * data, uint32_t dataLen,
@@ -84,6 +90,7 @@ using OnReportBeginCallback             = void (*)(PyObject * appContext);
 using OnReportEndCallback               = void (*)(PyObject * appContext);
 
 OnReadAttributeDataCallback gOnReadAttributeDataCallback             = nullptr;
+OnReadAttributeBatchCallback gOnReadAttributeBatchCallback           = nullptr;
 OnReadEventDataCallback gOnReadEventDataCallback                     = nullptr;
 OnSubscriptionEstablishedCallback gOnSubscriptionEstablishedCallback = nullptr;
 OnResubscriptionAttemptedCallback gOnResubscriptionAttemptedCallback = nullptr;
@@ -92,16 +99,28 @@ OnReadDoneCallback gOnReadDoneCallback                               = nullptr;
 OnReportBeginCallback gOnReportBeginCallback                         = nullptr;
 OnReportBeginCallback gOnReportEndCallback                           = nullptr;
 
+// When set, attribute data is converted to JSON (see chip/tlv/native.py) and handed
+// to python once per report instead of once per attribute.
+bool gBatchAttributeReports = true;
+
+// Batches are delivered early once they grow this large, bounding memory use on large reads
+constexpr size_t kAttributeBatchFlushSize = 64 * 1024;
+
 void PythonResubscribePolicy(uint32_t aNumCumulativeRetries, uint32_t & aNextSubscriptionIntervalMsec, bool & aShouldResubscribe)
 {
     aShouldResubscribe = true;
 }
 
+class BulkReadOperation;
+
 class ReadClientCallback : public ReadClient::Callback
 {
 public:
     ReadClientCallback(PyObject * appContext) : mBufferedReadCallback(*this), mAppContext(appContext) {}
 
+    // An aborted subscription is deleted without going through OnDone, it must still hand back its bulk read slot.
+    ~ReadClientCallback() override { ReleaseBulkReadSlot(); }
+
     app::BufferedReadCallback * GetBufferedReadCallback() { return &mBufferedReadCallback; }
 
     void OnAttributeData(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus) override
@@ -111,6 +130,13 @@ public:
         // callback. If we do, that's a bug.
         //
         VerifyOrDie(!aPath.IsListItemOperation());
+
+        if (gBatchAttributeReports)
+        {
+            AddToAttributeBatch(aPath, apData, aStatus);
+            return;
+        }
+
         size_t bufferLen                  = (apData == nullptr ? 0 : apData->GetRemainingLength() + apData->GetLengthRead());
         std::unique_ptr<uint8_t[]> buffer = std::unique_ptr<uint8_t[]>(apData == nullptr ? nullptr : new uint8_t[bufferLen]);
         uint32_t size                     = 0;
@@ -145,6 +171,7 @@ public:
     void OnSubscriptionEstablished(SubscriptionId aSubscriptionId) override
     {
         gOnSubscriptionEstablishedCallback(mAppContext, aSubscriptionId);
+        ReleaseBulkReadSlot();
     }
 
     CHIP_ERROR OnResubscriptionNeeded(ReadClient * apReadClient, CHIP_ERROR aTerminationCause) override
@@ -155,6 +182,8 @@ public:
         }
         gOnResubscriptionAttemptedCallback(mAppContext, ToPyChipError(aTerminationCause),
                                            apReadClient->ComputeTimeTillNextSubscription());
+        // A subscription that has to be retried must not hold back the rest of a bulk operation
+        ReleaseBulkReadSlot();
         if (mAutoResubscribe)
         {
             return CHIP_NO_ERROR;
@@ -201,7 +230,12 @@ public:
             to_underlying(apStatus == nullptr ? Protocols::InteractionModel::Status::Success : apStatus->mStatus));
     }
 
-    void OnError(CHIP_ERROR aError) override { gOnReadErrorCallback(mAppContext, ToPyChipError(aError)); }
+    void OnError(CHIP_ERROR aError) override
+    {
+        FlushAttributeBatch();
+        gOnReadErrorCallback(mAppContext, ToPyChipError(aError));
+        ReleaseBulkReadSlot();
+    }
 
     void OnReportBegin() override { gOnReportBeginCallback(mAppContext); }
     void OnDeallocatePaths(chip::app::ReadPrepareParams && aReadPrepareParams) override
@@ -222,11 +256,17 @@ public:
         }
     }
 
-    void OnReportEnd() override { gOnReportEndCallback(mAppContext); }
+    void OnReportEnd() override
+    {
+        FlushAttributeBatch();
+        gOnReportEndCallback(mAppContext);
+    }
 
     void OnDone(ReadClient *) override
     {
+        FlushAttributeBatch();
         gOnReadDoneCallback(mAppContext);
+        ReleaseBulkReadSlot();
 
         delete this;
     };
@@ -235,13 +275,64 @@ public:
 
     void SetAutoResubscribe(bool autoResubscribe) { mAutoResubscribe = autoResubscribe; }
 
+    /// Notifies the bulk operation that issued this read once the read is done or the subscription is established.
+    void SetBulkReadOperation(BulkReadOperation * operation) { mBulkReadOperation = operation; }
+
 private:
+    void ReleaseBulkReadSlot();
+
+    /// Appends `[endpoint, cluster, attribute, dataVersion, status, value]` to the pending batch.
+    void AddToAttributeBatch(const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData, const StatusIB & aStatus)
+    {
+        const size_t start = mAttributeBatch.size();
+
+        char header[64];
+        snprintf(header, sizeof(header), "%c[%u,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%u,", mAttributeBatch.empty() ? '[' : ',',
+                 static_cast<unsigned>(aPath.mEndpointId), aPath.mClusterId, aPath.mAttributeId, aPath.mDataVersion.ValueOr(0),
+                 static_cast<unsigned>(to_underlying(aStatus.mStatus)));
+        mAttributeBatch.append(header);
+
+        // When the apData is nullptr, means we did not receive a valid attribute data from server, status will be some error
+        // status.
+        if (apData == nullptr)
+        {
+            mAttributeBatch.append("null");
+        }
+        else
+        {
+            CHIP_ERROR err = TlvToPyJson(*apData, mAttributeBatch);
+            if (err != CHIP_NO_ERROR)
+            {
+                mAttributeBatch.resize(start);
+                this->OnError(err);
+                return;
+            }
+        }
+        mAttributeBatch.push_back(']');
+
+        if (mAttributeBatch.size() >= kAttributeBatchFlushSize)
+        {
+            FlushAttributeBatch();
+        }
+    }
+
+    void FlushAttributeBatch()
+    {
+        VerifyOrReturn(!mAttributeBatch.empty());
+
+        mAttributeBatch.push_back(']');
+        gOnReadAttributeBatchCallback(mAppContext, mAttributeBatch.data(), mAttributeBatch.size());
+        mAttributeBatch.clear();
+    }
+
     BufferedReadCallback mBufferedReadCallback;
 
     PyObject * mAppContext;
+    std::string mAttributeBatch; // JSON array of attribute reports not yet delivered to python
 
     std::unique_ptr<ReadClient> mReadClient;
-    bool mAutoResubscribe = true;
+    bool mAutoResubscribe                  = true;
+    BulkReadOperation * mBulkReadOperation = nullptr;
 };
 
 extern "C" {
@@ -305,6 +396,183 @@ private:
     PyObject * mAppContext = nullptr;
 };
 
+using OnBulkReadClientCreatedCallback = void (*)(PyObject * appContext, ReadClient * readClient, ReadClientCallback * callback);
+
+/**
+ * Reads from, or subscribes to, many nodes at once.
+ *
+ * Session setup and the initial report of at most `maxInFlight` nodes are in progress at any time. Every node reports
+ * through its own appContext with the regular ReadClient callbacks, so python sees each node exactly as if it had issued
+ * pychip_ReadClient_Read once the session was up. The operation deletes itself once every node has been handled.
+ */
+class BulkReadOperation
+{
+public:
+    struct Request
+    {
+        Request() : mOnConnected(OnDeviceConnectedFn, this), mOnConnectionFailure(OnDeviceConnectionFailureFn, this) {}
+
+        BulkReadOperation * mOperation = nullptr;
+        NodeId mNodeId                 = kUndefinedNodeId;
+        PyObject * mAppContext         = nullptr;
+        std::vector<AttributePathParams> mAttributePaths;
+        std::vector<EventPathParams> mEventPaths;
+
+        Callback::Callback<OnDeviceConnected> mOnConnected;
+        Callback::Callback<OnDeviceConnectionFailure> mOnConnectionFailure;
+    };
+
+    BulkReadOperation(Controller::DeviceCommissioner * devCtrl, const PyReadAttributeParams & params, size_t numRequests,
+                      size_t maxInFlight, OnBulkReadClientCreatedCallback onReadClientCreated) :
+        mDevCtrl(devCtrl), mParams(params), mRequests(new Request[numRequests]), mNumRequests(numRequests),
+        mMaxInFlight(std::max<size_t>(maxInFlight, 1)), mOnReadClientCreated(onReadClientCreated)
+    {
+        for (size_t i = 0; i < numRequests; i++)
+        {
+            mRequests[i].mOperation = this;
+        }
+    }
+
+    Request & GetRequest(size_t index) { return mRequests[index]; }
+
+    void Start() { StartPendingRequests(); }
+
+    /// Called by a ReadClientCallback once its node no longer needs an in-flight slot.
+    void OnRequestFinished()
+    {
+        mInFlight--;
+        mFinished++;
+
+        // Requests finishing synchronously while new ones are being started are picked up by the running loop
+        VerifyOrReturn(!mStartingRequests);
+        StartPendingRequests();
+    }
+
+private:
+    static void OnDeviceConnectedFn(void * context, Messaging::ExchangeManager & exchangeMgr, const SessionHandle & sessionHandle)
+    {
+        Request * request = static_cast<Request *>(context);
+        CHIP_ERROR err    = request->mOperation->SendRequest(*request, exchangeMgr, sessionHandle);
+        if (err != CHIP_NO_ERROR)
+        {
+            request->mOperation->FailRequest(*request, err);
+        }
+    }
+
+    static void OnDeviceConnectionFailureFn(void * context, const ScopedNodeId & peerId, CHIP_ERROR error)
+    {
+        Request * request = static_cast<Request *>(context);
+        request->mOperation->FailRequest(*request, error);
+    }
+
+    void StartPendingRequests()
+    {
+        mStartingRequests = true;
+        while (mNextRequest < mNumRequests && mInFlight < mMaxInFlight)
+        {
+            Request & request = mRequests[mNextRequest++];
+            mInFlight++;
+
+            CHIP_ERROR err = mDevCtrl->GetConnectedDevice(request.mNodeId, &request.mOnConnected, &request.mOnConnectionFailure);
+            if (err != CHIP_NO_ERROR)
+            {
+                FailRequest(request, err);
+            }
+        }
+        mStartingRequests = false;
+
+        if (mFinished == mNumRequests)
+        {
+            delete this;
+        }
+    }
+
+    void FailRequest(Request & request, CHIP_ERROR err)
+    {
+        gOnReadErrorCallback(request.mAppContext, ToPyChipError(err));
+        gOnReadDoneCallback(request.mAppContext);
+        OnRequestFinished();
+    }
+
+    CHIP_ERROR SendRequest(Request & request, Messaging::ExchangeManager & exchangeMgr, const SessionHandle & sessionHandle)
+    {
+        std::unique_ptr<ReadClientCallback> callback = std::make_unique<ReadClientCallback>(request.mAppContext);
+        std::unique_ptr<ReadClient> readClient       = std::make_unique<ReadClient>(
+            InteractionModelEngine::GetInstance(), &exchangeMgr, *callback->GetBufferedReadCallback(),
+            mParams.isSubscription ? ReadClient::InteractionType::Subscribe : ReadClient::InteractionType::Read);
+
+        ReadPrepareParams params(sessionHandle);
+        params.mIsFabricFiltered = mParams.isFabricFiltered;
+
+        if (mParams.isSubscription)
+        {
+            // Subscriptions keep their paths for re-subscribing, they are released through OnDeallocatePaths.
+            if (!request.mAttributePaths.empty())
+            {
+                params.mpAttributePathParamsList    = new AttributePathParams[request.mAttributePaths.size()];
+                params.mAttributePathParamsListSize = request.mAttributePaths.size();
+                std::copy(request.mAttributePaths.begin(), request.mAttributePaths.end(), params.mpAttributePathParamsList);
+            }
+            if (!request.mEventPaths.empty())
+            {
+                params.mpEventPathParamsList    = new EventPathParams[request.mEventPaths.size()];
+                params.mEventPathParamsListSize = request.mEventPaths.size();
+                std::copy(request.mEventPaths.begin(), request.mEventPaths.end(), params.mpEventPathParamsList);
+            }
+            params.mMinIntervalFloorSeconds   = mParams.minInterval;
+            params.mMaxIntervalCeilingSeconds = mParams.maxInterval;
+            params.mKeepSubscriptions         = mParams.keepSubscriptions;
+            callback->SetAutoResubscribe(mParams.autoResubscribe);
+
+            ReturnErrorOnFailure(readClient->SendAutoResubscribeRequest(std::move(params)));
+        }
+        else
+        {
+            if (!request.mAttributePaths.empty())
+            {
+                params.mpAttributePathParamsList    = request.mAttributePaths.data();
+                params.mAttributePathParamsListSize = request.mAttributePaths.size();
+            }
+            if (!request.mEventPaths.empty())
+            {
+                params.mpEventPathParamsList    = request.mEventPaths.data();
+                params.mEventPathParamsListSize = request.mEventPaths.size();
+            }
+
+            ReturnErrorOnFailure(readClient->SendRequest(params));
+        }
+
+        mOnReadClientCreated(request.mAppContext, readClient.get(), callback.get());
+
+        callback->SetBulkReadOperation(this);
+        callback->AdoptReadClient(std::move(readClient));
+        callback.release();
+
+        return CHIP_NO_ERROR;
+    }
+
+    Controller::DeviceCommissioner * const mDevCtrl;
+    const PyReadAttributeParams mParams;
+    std::unique_ptr<Request[]> mRequests;
+    const size_t mNumRequests;
+    const size_t mMaxInFlight;
+    OnBulkReadClientCreatedCallback const mOnReadClientCreated;
+
+    size_t mNextRequest    = 0;
+    size_t mInFlight       = 0;
+    size_t mFinished       = 0;
+    bool mStartingRequests = false;
+};
+
+void ReadClientCallback::ReleaseBulkReadSlot()
+{
+    VerifyOrReturn(mBulkReadOperation != nullptr);
+
+    BulkReadOperation * operation = mBulkReadOperation;
+    mBulkReadOperation            = nullptr;
+    operation->OnRequestFinished();
+}
+
 } // namespace python
 } // namespace chip
 
@@ -320,6 +588,7 @@ void pychip_WriteClient_InitCallbacks(OnWriteResponseCallback onWriteResponseCal
 }
 
 void pychip_ReadClient_InitCallbacks(OnReadAttributeDataCallback onReadAttributeDataCallback,
+                                     OnReadAttributeBatchCallback onReadAttributeBatchCallback,
                                      OnReadEventDataCallback onReadEventDataCallback,
                                      OnSubscriptionEstablishedCallback onSubscriptionEstablishedCallback,
                                      OnResubscriptionAttemptedCallback onResubscriptionAttemptedCallback,
@@ -327,6 +596,7 @@ void pychip_ReadClient_InitCallbacks(OnReadAttributeDataCallback onReadAttribute
                                      OnReportBeginCallback onReportBeginCallback, OnReportEndCallback onReportEndCallback)
 {
     gOnReadAttributeDataCallback       = onReadAttributeDataCallback;
+    gOnReadAttributeBatchCallback      = onReadAttributeBatchCallback;
     gOnReadEventDataCallback           = onReadEventDataCallback;
     gOnSubscriptionEstablishedCallback = onSubscriptionEstablishedCallback;
     gOnResubscriptionAttemptedCallback = onResubscriptionAttemptedCallback;
@@ -336,6 +606,11 @@ void pychip_ReadClient_InitCallbacks(OnReadAttributeDataCallback onReadAttribute
     gOnReportEndCallback               = onReportEndCallback;
 }
 
+void pychip_ReadClient_SetBatchAttributeReports(bool batchAttributeReports)
+{
+    gBatchAttributeReports = batchAttributeReports;
+}
+
 PyChipError pychip_WriteClient_WriteAttributes(void * appContext, DeviceProxy * device, size_t timedWriteTimeoutMsSizeT,
                                                size_t interactionTimeoutMsSizeT, size_t busyWaitMsSizeT, size_t n, ...)
 {
@@ -602,4 +877,55 @@ exit:
     va_end(args);
     return ToPyChipError(err);
 }
+
+// Reads from (or subscribes to) numRequests nodes, with at most maxInFlight of them connecting or waiting for their initial
+// report at any time. Request i reads the next numAttributePaths[i] entries of attributePaths and numEventPaths[i] entries of
+// eventPaths (arrays of packed python::AttributePath and python::EventPath) and reports to appContexts[i].
+PyChipError pychip_ReadClient_BulkRead(chip::Controller::DeviceCommissioner * devCtrl, uint8_t * readParamsBuf, size_t numRequests,
+                                       const uint64_t * nodeIds, PyObject ** appContexts, const uint32_t * numAttributePaths,
+                                       const uint8_t * attributePaths, const uint32_t * numEventPaths, const uint8_t * eventPaths,
+                                       size_t maxInFlight, OnBulkReadClientCreatedCallback onReadClientCreated)
+{
+    VerifyOrReturnError(devCtrl != nullptr && onReadClientCreated != nullptr, ToPyChipError(CHIP_ERROR_INVALID_ARGUMENT));
+    VerifyOrReturnError(numRequests != 0, ToPyChipError(CHIP_ERROR_INVALID_ARGUMENT));
+
+    PyReadAttributeParams pyParams = {};
+    // The readParamsBuf might be not aligned, using a memcpy to avoid some unexpected behaviors.
+    memcpy(&pyParams, readParamsBuf, sizeof(pyParams));
+
+    auto operation = std::make_unique<BulkReadOperation>(devCtrl, pyParams, numRequests, maxInFlight, onReadClientCreated);
+
+    for (size_t i = 0; i < numRequests; i++)
+    {
+        BulkReadOperation::Request & request = operation->GetRequest(i);
+        request.mNodeId                      = nodeIds[i];
+        request.mAppContext                  = appContexts[i];
+
+        request.mAttributePaths.reserve(numAttributePaths[i]);
+        for (uint32_t j = 0; j < numAttributePaths[i]; j++)
+        {
+            python::AttributePath pathObj;
+            memcpy(&pathObj, attributePaths, sizeof(python::AttributePath));
+            attributePaths += sizeof(python::AttributePath);
+
+            request.mAttributePaths.push_back(AttributePathParams(pathObj.endpointId, pathObj.clusterId, pathObj.attributeId));
+        }
+
+        request.mEventPaths.reserve(numEventPaths[i]);
+        for (uint32_t j = 0; j < numEventPaths[i]; j++)
+        {
+            python::EventPath pathObj;
+            memcpy(&pathObj, eventPaths, sizeof(python::EventPath));
+            eventPaths += sizeof(python::EventPath);
+
+            request.mEventPaths.push_back(
+                EventPathParams(pathObj.endpointId, pathObj.clusterId, pathObj.eventId, pathObj.urgentEvent == 1));
+        }
+    }
+
+    // From here on every request reports its outcome through its appContext, and the operation owns itself.
+    operation.release()->Start();
+
+    return ToPyChipError(CHIP_NO_ERROR);
+}
 }
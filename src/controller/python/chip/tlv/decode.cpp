@@ -0,0 +1,367 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "decode.h"
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#include <lib/core/TLVWriter.h>
+#include <lib/support/CodeUtils.h>
+
+using namespace chip;
+
+namespace chip {
+namespace python {
+
+namespace {
+
+// Markers wrapping values that have no native JSON representation. Must
+// match chip/tlv/native.py.
+constexpr char kSignedMarker[] = "{\"i\":";
+constexpr char kFloatMarker[]  = "{\"f\":";
+constexpr char kBytesMarker[]  = "{\"b\":\"";
+constexpr char kRawTlvMarker[] = "{\"t\":\"";
+
+void AppendHex(std::string & out, const uint8_t * data, size_t len)
+{
+    static constexpr char kHexDigits[] = "0123456789abcdef";
+    for (size_t i = 0; i < len; i++)
+    {
+        out.push_back(kHexDigits[data[i] >> 4]);
+        out.push_back(kHexDigits[data[i] & 0xF]);
+    }
+}
+
+void AppendUnsigned(std::string & out, uint64_t value)
+{
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), "%" PRIu64, value);
+    out.append(buffer);
+}
+
+void AppendSigned(std::string & out, int64_t value)
+{
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), "%" PRId64, value);
+    out.append(buffer);
+}
+
+void AppendDouble(std::string & out, double value)
+{
+    if (std::isnan(value))
+    {
+        out.append("NaN");
+        return;
+    }
+    if (std::isinf(value))
+    {
+        out.append(value < 0 ? "-Infinity" : "Infinity");
+        return;
+    }
+
+    // 17 significant digits round-trip any double exactly
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.17g", value);
+    out.append(buffer);
+
+    // Keep integral values parsed as floats
+    if (strpbrk(buffer, ".e") == nullptr)
+    {
+        out.append(".0");
+    }
+}
+
+/// Strict UTF-8 validation, matching what the Python 'utf-8' codec accepts
+/// (no overlong encodings, surrogates or code points above U+10FFFF).
+bool IsValidUtf8(const uint8_t * data, size_t len)
+{
+    size_t i = 0;
+    while (i < len)
+    {
+        const uint8_t c = data[i];
+        size_t extra;
+        uint32_t codePoint;
+        uint32_t minimum;
+
+        if (c < 0x80)
+        {
+            i++;
+            continue;
+        }
+        if ((c & 0xE0) == 0xC0)
+        {
+            extra     = 1;
+            codePoint = c & 0x1F;
+            minimum   = 0x80;
+        }
+        else if ((c & 0xF0) == 0xE0)
+        {
+            extra     = 2;
+            codePoint = c & 0x0F;
+            minimum   = 0x800;
+        }
+        else if ((c & 0xF8) == 0xF0)
+        {
+            extra     = 3;
+            codePoint = c & 0x07;
+            minimum   = 0x10000;
+        }
+        else
+        {
+            return false;
+        }
+
+        VerifyOrReturnValue(len - i > extra, false);
+        for (size_t j = 1; j <= extra; j++)
+        {
+            VerifyOrReturnValue((data[i + j] & 0xC0) == 0x80, false);
+            codePoint = (codePoint << 6) | (data[i + j] & 0x3F);
+        }
+
+        VerifyOrReturnValue(codePoint >= minimum && codePoint <= 0x10FFFF, false);
+        VerifyOrReturnValue(codePoint < 0xD800 || codePoint > 0xDFFF, false);
+
+        i += extra + 1;
+    }
+    return true;
+}
+
+void AppendJsonString(std::string & out, const uint8_t * data, size_t len)
+{
+    static constexpr char kHexDigits[] = "0123456789abcdef";
+
+    out.push_back('"');
+    for (size_t i = 0; i < len; i++)
+    {
+        const uint8_t c = data[i];
+        if (c == '"' || c == '\\')
+        {
+            out.push_back('\\');
+            out.push_back(static_cast<char>(c));
+        }
+        else if (c < 0x20)
+        {
+            out.append("\\u00");
+            out.push_back(kHexDigits[c >> 4]);
+            out.push_back(kHexDigits[c & 0xF]);
+        }
+        else
+        {
+            // Valid UTF-8 (checked by the caller) is passed through as is
+            out.push_back(static_cast<char>(c));
+        }
+    }
+    out.push_back('"');
+}
+
+CHIP_ERROR AppendElement(TLV::TLVReader & reader, std::string & out);
+
+CHIP_ERROR AppendContainer(TLV::TLVReader & reader, std::string & out, bool isStructure)
+{
+    TLV::TLVType containerType;
+    bool first = true;
+
+    out.push_back(isStructure ? '{' : '[');
+
+    ReturnErrorOnFailure(reader.EnterContainer(containerType));
+
+    CHIP_ERROR err;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        if (!first)
+        {
+            out.push_back(',');
+        }
+        first = false;
+
+        if (isStructure)
+        {
+            const TLV::Tag tag = reader.GetTag();
+            if (tag == TLV::AnonymousTag())
+            {
+                out.append("\"Any\":");
+            }
+            else
+            {
+                VerifyOrReturnError(TLV::IsContextTag(tag), CHIP_ERROR_NOT_IMPLEMENTED);
+                out.push_back('"');
+                AppendUnsigned(out, TLV::TagNumFromTag(tag));
+                out.append("\":");
+            }
+        }
+
+        ReturnErrorOnFailure(AppendElement(reader, out));
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+    ReturnErrorOnFailure(reader.ExitContainer(containerType));
+
+    out.push_back(isStructure ? '}' : ']');
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AppendElement(TLV::TLVReader & reader, std::string & out)
+{
+    switch (reader.GetType())
+    {
+    case TLV::kTLVType_SignedInteger: {
+        int64_t value;
+        ReturnErrorOnFailure(reader.Get(value));
+        // Non-negative signed values would otherwise be decoded as chip.tlv.uint
+        if (value < 0)
+        {
+            AppendSigned(out, value);
+        }
+        else
+        {
+            out.append(kSignedMarker);
+            AppendSigned(out, value);
+            out.push_back('}');
+        }
+        break;
+    }
+    case TLV::kTLVType_UnsignedInteger: {
+        uint64_t value;
+        ReturnErrorOnFailure(reader.Get(value));
+        AppendUnsigned(out, value);
+        break;
+    }
+    case TLV::kTLVType_Boolean: {
+        bool value;
+        ReturnErrorOnFailure(reader.Get(value));
+        out.append(value ? "true" : "false");
+        break;
+    }
+    case TLV::kTLVType_FloatingPointNumber: {
+        double value;
+        ReturnErrorOnFailure(reader.Get(value));
+        if (reader.IsElementDouble())
+        {
+            AppendDouble(out, value);
+        }
+        else
+        {
+            out.append(kFloatMarker);
+            AppendDouble(out, value);
+            out.push_back('}');
+        }
+        break;
+    }
+    case TLV::kTLVType_UTF8String:
+    case TLV::kTLVType_ByteString: {
+        const uint8_t * data = nullptr;
+        const uint32_t len   = reader.GetLength();
+        if (len > 0)
+        {
+            ReturnErrorOnFailure(reader.GetDataPtr(data));
+        }
+
+        // Invalid UTF-8 strings are decoded as bytes, like chip.tlv.TLVReader does
+        if ((reader.GetType() == TLV::kTLVType_UTF8String) && IsValidUtf8(data, len))
+        {
+            AppendJsonString(out, data, len);
+        }
+        else
+        {
+            out.append(kBytesMarker);
+            AppendHex(out, data, len);
+            out.append("\"}");
+        }
+        break;
+    }
+    case TLV::kTLVType_Null:
+        out.append("null");
+        break;
+    case TLV::kTLVType_Structure:
+        return AppendContainer(reader, out, /* isStructure = */ true);
+    case TLV::kTLVType_Array:
+        return AppendContainer(reader, out, /* isStructure = */ false);
+    default:
+        // Paths (TLVList on the python side) are not represented
+        return CHIP_ERROR_NOT_IMPLEMENTED;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR AppendRawTlv(const TLV::TLVReader & reader, std::string & out)
+{
+    // Normalized as a single anonymous element, which is what chip.tlv.TLVReader expects
+    const size_t bufferLen = reader.GetRemainingLength() + reader.GetLengthRead();
+    std::unique_ptr<uint8_t[]> buffer(new uint8_t[bufferLen]);
+
+    TLV::TLVReader copy;
+    copy.Init(reader);
+
+    TLV::TLVWriter writer;
+    writer.Init(buffer.get(), bufferLen);
+    ReturnErrorOnFailure(writer.CopyElement(TLV::AnonymousTag(), copy));
+
+    out.append(kRawTlvMarker);
+    AppendHex(out, buffer.get(), writer.GetLengthWritten());
+    out.append("\"}");
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+CHIP_ERROR TlvToPyJson(const TLV::TLVReader & reader, std::string & out)
+{
+    const size_t start = out.size();
+
+    TLV::TLVReader elementReader;
+    elementReader.Init(reader);
+
+    CHIP_ERROR err = AppendElement(elementReader, out);
+    if (err == CHIP_ERROR_NOT_IMPLEMENTED)
+    {
+        out.resize(start);
+        err = AppendRawTlv(reader, out);
+    }
+    return err;
+}
+
+} // namespace python
+} // namespace chip
+
+extern "C" {
+
+PyChipError pychip_TLV_ToPyJson(const uint8_t * tlv, size_t tlvLen, char * json, size_t * jsonLen)
+{
+    TLV::TLVReader reader;
+    reader.Init(tlv, tlvLen);
+
+    CHIP_ERROR err = reader.Next();
+    VerifyOrReturnError(err == CHIP_NO_ERROR, ToPyChipError(err));
+
+    std::string out;
+    err = python::TlvToPyJson(reader, out);
+    VerifyOrReturnError(err == CHIP_NO_ERROR, ToPyChipError(err));
+
+    // Report the needed size so that callers can retry with a larger buffer
+    const size_t available = *jsonLen;
+    *jsonLen               = out.size();
+    VerifyOrReturnError(out.size() <= available, ToPyChipError(CHIP_ERROR_BUFFER_TOO_SMALL));
+
+    memcpy(json, out.data(), out.size());
+    return ToPyChipError(CHIP_NO_ERROR);
+}
+}
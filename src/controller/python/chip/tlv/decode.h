@@ -0,0 +1,48 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <string>
+
+#include <controller/python/chip/native/PyChipError.h>
+#include <lib/core/TLVReader.h>
+
+namespace chip {
+namespace python {
+
+/**
+ * Appends the TLV element [reader] is positioned on to [out], using the JSON
+ * representation decoded by chip.tlv.native.loads().
+ *
+ * The decoded value is identical to what chip.tlv.TLVReader produces for the
+ * element, but only needs a single pass of the (C implemented) JSON parser on
+ * the Python side. Elements that cannot be represented (paths and profile
+ * tags) are appended as raw TLV, which chip.tlv.native.loads() hands over to
+ * chip.tlv.TLVReader.
+ *
+ * On error, [out] may contain a partial encoding.
+ */
+CHIP_ERROR TlvToPyJson(const TLV::TLVReader & reader, std::string & out);
+
+} // namespace python
+} // namespace chip
+
+extern "C" {
+PyChipError pychip_TLV_ToPyJson(const uint8_t * tlv, size_t tlvLen, char * json, size_t * jsonLen);
+}
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+# coding=utf-8
+
+#
+#   Copyright (c) 2023 Project CHIP Authors
+#   All rights reserved.
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#       http://www.apache.org/licenses/LICENSE-2.0
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+
+#
+#   @file
+#         Fast decoding of TLV data pre-converted by the native library.
+#
+#         The native library (chip/tlv/decode.cpp) walks TLV with the C++ TLVReader
+#         and emits JSON that the C implemented JSON parser turns into the exact same
+#         values chip.tlv.TLVReader would produce:
+#
+#           - unsigned integers, negative signed integers, booleans, null, doubles,
+#             UTF-8 strings and arrays map to their JSON counterparts.
+#           - structures are JSON objects keyed by context tag number ("Any" for
+#             anonymous tags).
+#           - other values are single-member objects keyed by a marker:
+#               {"i": n}     non-negative signed integer
+#               {"f": x}     single precision float (chip.tlv.float32)
+#               {"b": "hex"} byte string, or UTF-8 string that is not valid UTF-8
+#               {"t": "hex"} raw TLV element the JSON form cannot express (e.g. paths),
+#                            decoded with chip.tlv.TLVReader.
+#
+
+import ctypes
+import json
+
+from . import TLVReader, float32, uint
+
+
+def _decodeRawTLV(value: str):
+    return TLVReader(bytes.fromhex(value)).get().get("Any", {})
+
+
+_MARKERS = {
+    "i": int,
+    "f": float32,
+    "b": bytes.fromhex,
+    "t": _decodeRawTLV,
+}
+
+
+def _objectPairsHook(pairs):
+    if len(pairs) == 1:
+        marker = _MARKERS.get(pairs[0][0])
+        if marker is not None:
+            return marker(pairs[0][1])
+
+    return {(key if key == "Any" else int(key)): value for key, value in pairs}
+
+
+def _parseInt(value: str):
+    # Signed non-negative values are wrapped in a marker, so every other
+    # non-negative integer is unsigned
+    if value[0] == "-":
+        return int(value)
+    return uint(int(value))
+
+
+_decoder = json.JSONDecoder(object_pairs_hook=_objectPairsHook, parse_int=_parseInt)
+
+
+def loads(data):
+    """Decode the JSON form of a TLV element (str or UTF-8 bytes) as produced by the native library."""
+    if isinstance(data, (bytes, bytearray)):
+        data = data.decode("utf-8")
+    return _decoder.decode(data)
+
+
+def _handle():
+    # Imported here: this module is also used where only the pure python
+    # packages are installed.
+    import chip.native
+
+    handle = chip.native.GetLibraryHandle(chip.native.HandleFlags(0))
+    if handle.pychip_TLV_ToPyJson.argtypes is None:
+        setter = chip.native.NativeLibraryHandleMethodArguments(handle)
+        setter.Set("pychip_TLV_ToPyJson", chip.native.PyChipError, [ctypes.c_char_p, ctypes.c_size_t,
+                   ctypes.c_char_p, ctypes.POINTER(ctypes.c_size_t)])
+    return handle
+
+
+def decode(tlv: bytes):
+    """Decode a TLV element using the native library.
+
+    Returns the same value as `TLVReader(tlv).get()["Any"]`.
+    """
+    handle = _handle()
+    size = 4 * len(tlv) + 64
+
+    for attempt in range(2):
+        output = ctypes.create_string_buffer(size)
+        outputSize = ctypes.c_size_t(size)
+        err = handle.pychip_TLV_ToPyJson(bytes(tlv), len(tlv), output, ctypes.byref(outputSize))
+        if not err.is_success and outputSize.value > size:
+            # The required size is reported back when the buffer is too small
+            size = outputSize.value
+            continue
+        err.raise_on_error()
+        return loads(output.raw[:outputSize.value])
+
+    raise RuntimeError("Native TLV decoding output size changed between calls")
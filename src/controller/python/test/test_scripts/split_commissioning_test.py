@@ -19,6 +19,7 @@
 
 # Commissioning test.
 
+import asyncio
 import os
 import sys
 from optparse import OptionParser
@@ -127,6 +128,10 @@ def main():
                                     endpoint=LIGHTING_ENDPOINT_ID,
                                     group=GROUP_ID), "Failed to test on off cluster on device 2")
 
+    logger.info("Testing reading both devices at once")
+    FailIfNot(asyncio.run(test.TestReadMultiple(nodeids=[1, 2])),
+              "Failed to read both devices with ReadMultiple")
+
     timeoutTicker.stop()
 
     logger.info("Test finished")
@@ -0,0 +1,132 @@
+#
+#    Copyright (c) 2023 Project CHIP Authors
+#    All rights reserved.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+#
+
+import time
+import unittest
+
+import chip.tlv.native
+from chip.tlv import TLVList, TLVReader, TLVWriter, float32, uint
+
+
+def _encode(value) -> bytes:
+    writer = TLVWriter()
+    writer.put(None, value)
+    return bytes(writer.encoding)
+
+
+def _assertSameValue(test: unittest.TestCase, expected, actual):
+    # assertEqual alone would accept int for uint and float for float32
+    test.assertIs(type(actual), type(expected), f"{actual!r} vs {expected!r}")
+    if isinstance(expected, dict):
+        test.assertEqual(list(actual.keys()), list(expected.keys()))
+        for key in expected:
+            test.assertIs(type(key), type(next(k for k in actual if k == key)))
+            _assertSameValue(test, expected[key], actual[key])
+    elif isinstance(expected, list):
+        test.assertEqual(len(actual), len(expected))
+        for e, a in zip(expected, actual):
+            _assertSameValue(test, e, a)
+    else:
+        test.assertEqual(actual, expected)
+
+
+class TestTLVNativeLoads(unittest.TestCase):
+    def test_scalars(self):
+        _assertSameValue(self, uint(7), chip.tlv.native.loads('7'))
+        _assertSameValue(self, -7, chip.tlv.native.loads('-7'))
+        _assertSameValue(self, 7, chip.tlv.native.loads('{"i":7}'))
+        _assertSameValue(self, float32(1.5), chip.tlv.native.loads('{"f":1.5}'))
+        _assertSameValue(self, 1.5, chip.tlv.native.loads('1.5'))
+        _assertSameValue(self, True, chip.tlv.native.loads('true'))
+        _assertSameValue(self, None, chip.tlv.native.loads('null'))
+        _assertSameValue(self, b'\xde\xad', chip.tlv.native.loads('{"b":"dead"}'))
+        _assertSameValue(self, "café", chip.tlv.native.loads(b'"caf\xc3\xa9"'))
+
+    def test_containers(self):
+        _assertSameValue(self, {1: uint(2), "Any": [uint(3), {0: -1}]},
+                         chip.tlv.native.loads('{"1":2,"Any":[3,{"0":-1}]}'))
+        _assertSameValue(self, {}, chip.tlv.native.loads('{}'))
+        _assertSameValue(self, [], chip.tlv.native.loads('[]'))
+
+    def test_raw_tlv(self):
+        encoded = _encode(TLVList([(None, uint(1)), (2, "x")]))
+        _assertSameValue(self, TLVReader(encoded).get()["Any"],
+                         chip.tlv.native.loads('{"t":"%s"}' % encoded.hex()))
+
+
+class TestTLVNativeDecode(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        try:
+            chip.tlv.native._handle()
+        except Exception as ex:
+            raise unittest.SkipTest(f"native library unavailable: {ex}")
+
+    def _assertDecodesLikeReader(self, encoded: bytes):
+        _assertSameValue(self, TLVReader(encoded).get()["Any"], chip.tlv.native.decode(encoded))
+
+    def test_values(self):
+        self._assertDecodesLikeReader(_encode({
+            0: uint(0),
+            1: uint(0xffffffffffffffff),
+            2: -0x8000000000000000,
+            3: 42,
+            4: 0,
+            5: float32(0.25),
+            6: 1e300,
+            7: 3.0,
+            8: True,
+            9: False,
+            10: None,
+            11: b'',
+            12: b'\x00\xff',
+            13: "",
+            14: "quote \" backslash \\ control \x01\n\t unicode é中\U0001f600",
+            15: [uint(1), [], {}, [{}]],
+            16: {0: {1: {2: "deep"}}},
+        }))
+
+    def test_invalid_utf8_string(self):
+        # Anonymous UTF-8 string of length 2 holding bytes that are not valid UTF-8
+        self._assertDecodesLikeReader(bytes([0x0c, 0x02, 0xc3, 0x28]))
+
+    def test_list_falls_back_to_raw_tlv(self):
+        self._assertDecodesLikeReader(_encode({1: TLVList([(None, uint(1)), (2, "x")]), 2: uint(5)}))
+
+    def test_benchmark(self):
+        items = [{0: uint(i), 1: f"entry-{i}", 2: bytes(range(16)), 3: [uint(j) for j in range(8)], 4: i % 2 == 0, 5: -i}
+                 for i in range(2000)]
+        encoded = _encode(items)
+        self._assertDecodesLikeReader(encoded)
+
+        iterations = 5
+        start = time.perf_counter()
+        for _ in range(iterations):
+            TLVReader(encoded).get()
+        readerTime = (time.perf_counter() - start) / iterations
+
+        start = time.perf_counter()
+        for _ in range(iterations):
+            chip.tlv.native.decode(encoded)
+        nativeTime = (time.perf_counter() - start) / iterations
+
+        print(f"\nTLV decode of {len(encoded)} bytes: TLVReader {readerTime * 1000:.2f} ms, "
+              f"native {nativeTime * 1000:.2f} ms ({readerTime / nativeTime:.1f}x)")
+
+
+if __name__ == '__main__':
+    unittest.main()
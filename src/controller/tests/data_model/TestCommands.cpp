@@ -25,13 +25,22 @@
 #include "app/data-model/NullObject.h"
 #include <app-common/zap-generated/cluster-objects.h>
 #include <app/AppConfig.h>
+#include <app/CASEClientPool.h>
+#include <app/CASESessionManager.h>
+#include <app/CommandPathRegistry.h>
 #include <app/InteractionModelEngine.h>
+#include <app/OperationalSessionSetupPool.h>
 #include <app/tests/AppTestContext.h>
+#include <controller/CommandCoalescer.h>
+#include <controller/FleetOperation.h>
 #include <controller/InvokeInteraction.h>
+#include <credentials/GroupDataProviderImpl.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/ErrorStr.h>
 #include <lib/core/TLV.h>
 #include <lib/core/TLVUtilities.h>
+#include <lib/support/TestGroupData.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
 #include <lib/support/UnitTestContext.h>
 #include <lib/support/UnitTestRegistration.h>
 #include <lib/support/logging/CHIPLogging.h>
@@ -192,10 +201,108 @@ public:
     static void TestMultipleFailures(nlTestSuite * apSuite, void * apContext);
     static void TestSuccessNoDataResponseWithClusterStatus(nlTestSuite * apSuite, void * apContext);
     static void TestFailureWithClusterStatus(nlTestSuite * apSuite, void * apContext);
+    static void TestCoalescedCommands(nlTestSuite * apSuite, void * apContext);
+    static void TestCoalescedCommandFailure(nlTestSuite * apSuite, void * apContext);
+    static void TestCoalescerWindow(nlTestSuite * apSuite, void * apContext);
+    static void TestCoalescerCancelsPendingCommands(nlTestSuite * apSuite, void * apContext);
+    static void TestCoalescerBatchesCommands(nlTestSuite * apSuite, void * apContext);
+    static void TestCoalescerThroughput(nlTestSuite * apSuite, void * apContext);
+    static void TestFleetOperationUnicast(nlTestSuite * apSuite, void * apContext);
+    static void TestFleetOperationFailure(nlTestSuite * apSuite, void * apContext);
+    static void TestFleetOperationGroupcast(nlTestSuite * apSuite, void * apContext);
 
 private:
 };
 
+// Sets the MaxPathsPerInvoke the client side of the test session believes the server supports, for the
+// lifetime of the object.
+class ScopedRemoteMaxPathsPerInvoke
+{
+public:
+    ScopedRemoteMaxPathsPerInvoke(const SessionHandle & session, uint16_t maxPathsPerInvoke) :
+        mSession(session), mOriginalParameters(session->GetRemoteSessionParameters())
+    {
+        SessionParameters parameters = mOriginalParameters;
+        parameters.SetMaxPathsPerInvoke(maxPathsPerInvoke);
+        session->AsSecureSession()->SetRemoteSessionParameters(parameters);
+    }
+    ~ScopedRemoteMaxPathsPerInvoke() { mSession->AsSecureSession()->SetRemoteSessionParameters(mOriginalParameters); }
+
+private:
+    SessionHolder mSession;
+    SessionParameters mOriginalParameters;
+};
+
+// Handles the InvokeRequestMessages sent over the test sessions in place of the InteractionModelEngine, with
+// CommandHandlers that accept kMaxPathsPerInvoke commands in one message. The InteractionModelEngine only accepts
+// CHIP_CONFIG_MAX_PATHS_PER_INVOKE of them, which is 1 by default. The UnitTesting cluster is served on every endpoint.
+class BatchCapableInvokeServer : public Messaging::UnsolicitedMessageHandler,
+                                 public Messaging::ExchangeDelegate,
+                                 public CommandHandler::Callback
+{
+public:
+    static constexpr uint16_t kMaxPathsPerInvoke = 4;
+
+    BatchCapableInvokeServer(Messaging::ExchangeManager & exchangeMgr) : mExchangeMgr(exchangeMgr)
+    {
+        VerifyOrDie(mExchangeMgr.RegisterUnsolicitedMessageHandlerForType(InteractionModel::MsgType::InvokeCommandRequest, this) ==
+                    CHIP_NO_ERROR);
+    }
+    ~BatchCapableInvokeServer() override
+    {
+        mExchangeMgr.UnregisterUnsolicitedMessageHandlerForType(InteractionModel::MsgType::InvokeCommandRequest);
+    }
+
+    size_t mReceivedRequests   = 0;
+    size_t mDispatchedCommands = 0;
+
+private:
+    struct Invocation
+    {
+        Invocation(CommandHandler::Callback * callback) : mHandler(CommandHandler::TestOnlyMarker(), callback, &mRegistry) {}
+
+        BasicCommandPathRegistry<kMaxPathsPerInvoke> mRegistry;
+        CommandHandler mHandler;
+    };
+
+    CHIP_ERROR OnUnsolicitedMessageReceived(const PayloadHeader & payloadHeader,
+                                            Messaging::ExchangeDelegate *& newDelegate) override
+    {
+        newDelegate = this;
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR OnMessageReceived(Messaging::ExchangeContext * ec, const PayloadHeader & payloadHeader,
+                                 System::PacketBufferHandle && payload) override
+    {
+        VerifyOrReturnError(mInvocation == nullptr, CHIP_ERROR_BUSY);
+        mReceivedRequests++;
+        mInvocation = std::make_unique<Invocation>(this);
+        mInvocation->mHandler.OnInvokeCommandRequest(ec, payloadHeader, std::move(payload), /* isTimedInvoke = */ false);
+        return CHIP_NO_ERROR;
+    }
+
+    void OnResponseTimeout(Messaging::ExchangeContext * ec) override {}
+
+    void OnDone(CommandHandler & apCommandObj) override { mInvocation.reset(); }
+
+    void DispatchCommand(CommandHandler & apCommandObj, const ConcreteCommandPath & aCommandPath,
+                         TLV::TLVReader & apPayload) override
+    {
+        mDispatchedCommands++;
+        DispatchSingleClusterCommand(aCommandPath, apPayload, &apCommandObj);
+    }
+
+    InteractionModel::Status CommandExists(const ConcreteCommandPath & aCommandPath) override
+    {
+        return (aCommandPath.mClusterId == Clusters::UnitTesting::Id) ? InteractionModel::Status::Success
+                                                                      : InteractionModel::Status::UnsupportedCluster;
+    }
+
+    Messaging::ExchangeManager & mExchangeMgr;
+    std::unique_ptr<Invocation> mInvocation;
+};
+
 void TestCommandInteraction::TestDataResponse(nlTestSuite * apSuite, void * apContext)
 {
     TestContext & ctx = *static_cast<TestContext *>(apContext);
@@ -540,6 +647,530 @@ void TestCommandInteraction::TestFailureWithClusterStatus(nlTestSuite * apSuite,
     NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
 }
 
+void TestCommandInteraction::TestCoalescedCommands(nlTestSuite * apSuite, void * apContext)
+{
+    struct FakeRequest : public Clusters::UnitTesting::Commands::TestSimpleArgumentRequest::Type
+    {
+        using ResponseType = DataModel::NullObjectType;
+    };
+
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    FakeRequest request;
+    auto sessionHandle = ctx.GetSessionBobToAlice();
+    ScopedRemoteMaxPathsPerInvoke maxPaths(sessionHandle, CHIP_CONFIG_MAX_PATHS_PER_INVOKE);
+
+    size_t successCalls = 0;
+    size_t failureCalls = 0;
+    request.arg1        = true;
+
+    // Passing of stack variables by reference is only safe because of synchronous completion of the interaction. Otherwise, it's
+    // not safe to do so.
+    auto onSuccessCb = [&successCalls](const app::ConcreteCommandPath & commandPath, const app::StatusIB & aStatus,
+                                       const auto & dataResponse) { ++successCalls; };
+    auto onFailureCb = [&failureCalls](CHIP_ERROR aError) { ++failureCalls; };
+
+    responseDirective = kSendSuccessStatusCode;
+
+    {
+        Controller::CommandCoalescer coalescer(&ctx.GetExchangeManager(), sessionHandle);
+        for (size_t i = 0; i < CHIP_IM_MAX_NUM_COMMAND_HANDLER; i++)
+        {
+            NL_TEST_ASSERT(apSuite,
+                           coalescer.Invoke(kTestEndpointId, request, onSuccessCb, onFailureCb) == CHIP_NO_ERROR);
+        }
+        NL_TEST_ASSERT(apSuite, coalescer.Flush() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, coalescer.GetPendingCommandCount() == 0);
+
+        ctx.DrainAndServiceIO();
+    }
+
+    NL_TEST_ASSERT(apSuite, successCalls == CHIP_IM_MAX_NUM_COMMAND_HANDLER);
+    NL_TEST_ASSERT(apSuite, failureCalls == 0);
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
+void TestCommandInteraction::TestCoalescedCommandFailure(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    Clusters::UnitTesting::Commands::TestSimpleArgumentRequest::Type request;
+    auto sessionHandle = ctx.GetSessionBobToAlice();
+    ScopedRemoteMaxPathsPerInvoke maxPaths(sessionHandle, CHIP_CONFIG_MAX_PATHS_PER_INVOKE);
+
+    bool onSuccessWasCalled = false;
+    bool onFailureWasCalled = false;
+    bool statusCheck        = false;
+    request.arg1            = true;
+
+    // Passing of stack variables by reference is only safe because of synchronous completion of the interaction. Otherwise, it's
+    // not safe to do so.
+    auto onSuccessCb = [&onSuccessWasCalled](const app::ConcreteCommandPath & commandPath, const app::StatusIB & aStatus,
+                                             const auto & dataResponse) { onSuccessWasCalled = true; };
+    auto onFailureCb = [&onFailureWasCalled, &statusCheck](CHIP_ERROR aError) {
+        statusCheck        = aError.IsIMStatus() && app::StatusIB(aError).mStatus == Protocols::InteractionModel::Status::Failure;
+        onFailureWasCalled = true;
+    };
+
+    responseDirective = kSendError;
+
+    {
+        Controller::CommandCoalescer coalescer(&ctx.GetExchangeManager(), sessionHandle);
+        NL_TEST_ASSERT(apSuite, coalescer.Invoke(kTestEndpointId, request, onSuccessCb, onFailureCb) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, coalescer.Flush() == CHIP_NO_ERROR);
+
+        ctx.DrainAndServiceIO();
+    }
+
+    NL_TEST_ASSERT(apSuite, !onSuccessWasCalled && onFailureWasCalled && statusCheck);
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
+void TestCommandInteraction::TestCoalescerWindow(nlTestSuite * apSuite, void * apContext)
+{
+    struct FakeRequest : public Clusters::UnitTesting::Commands::TestSimpleArgumentRequest::Type
+    {
+        using ResponseType = DataModel::NullObjectType;
+    };
+
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    FakeRequest request;
+    auto sessionHandle = ctx.GetSessionBobToAlice();
+    // Make room for a second command, so that the batch is held until the window expires.
+    ScopedRemoteMaxPathsPerInvoke maxPaths(sessionHandle, 2);
+
+    bool onSuccessWasCalled = false;
+    bool onFailureWasCalled = false;
+    request.arg1            = true;
+
+    // Passing of stack variables by reference is only safe because of synchronous completion of the interaction. Otherwise, it's
+    // not safe to do so.
+    auto onSuccessCb = [&onSuccessWasCalled](const app::ConcreteCommandPath & commandPath, const app::StatusIB & aStatus,
+                                             const auto & dataResponse) { onSuccessWasCalled = true; };
+    auto onFailureCb = [&onFailureWasCalled](CHIP_ERROR aError) { onFailureWasCalled = true; };
+
+    responseDirective = kSendSuccessStatusCode;
+
+    {
+        Controller::CommandCoalescer coalescer(&ctx.GetExchangeManager(), sessionHandle, System::Clock::Milliseconds32(10));
+        NL_TEST_ASSERT(apSuite, coalescer.Invoke(kTestEndpointId, request, onSuccessCb, onFailureCb) == CHIP_NO_ERROR);
+#if CHIP_CONFIG_SENDING_BATCH_COMMANDS_ENABLED
+        NL_TEST_ASSERT(apSuite, coalescer.GetPendingCommandCount() == 1);
+#endif // CHIP_CONFIG_SENDING_BATCH_COMMANDS_ENABLED
+
+        ctx.GetIOContext().DriveIOUntil(System::Clock::Milliseconds32(2000),
+                                        [&]() { return onSuccessWasCalled || onFailureWasCalled; });
+        NL_TEST_ASSERT(apSuite, coalescer.GetPendingCommandCount() == 0);
+    }
+
+    NL_TEST_ASSERT(apSuite, onSuccessWasCalled && !onFailureWasCalled);
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
+void TestCommandInteraction::TestCoalescerCancelsPendingCommands(nlTestSuite * apSuite, void * apContext)
+{
+#if CHIP_CONFIG_SENDING_BATCH_COMMANDS_ENABLED
+    struct FakeRequest : public Clusters::UnitTesting::Commands::TestSimpleArgumentRequest::Type
+    {
+        using ResponseType = DataModel::NullObjectType;
+    };
+
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    FakeRequest request;
+    auto sessionHandle = ctx.GetSessionBobToAlice();
+    ScopedRemoteMaxPathsPerInvoke maxPaths(sessionHandle, 2);
+
+    bool onSuccessWasCalled = false;
+    CHIP_ERROR failure      = CHIP_NO_ERROR;
+    request.arg1            = true;
+
+    auto onSuccessCb = [&onSuccessWasCalled](const app::ConcreteCommandPath & commandPath, const app::StatusIB & aStatus,
+                                             const auto & dataResponse) { onSuccessWasCalled = true; };
+    auto onFailureCb = [&failure](CHIP_ERROR aError) { failure = aError; };
+
+    {
+        Controller::CommandCoalescer coalescer(&ctx.GetExchangeManager(), sessionHandle);
+        NL_TEST_ASSERT(apSuite, coalescer.Invoke(kTestEndpointId, request, onSuccessCb, onFailureCb) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, coalescer.GetPendingCommandCount() == 1);
+    }
+
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(apSuite, !onSuccessWasCalled && failure == CHIP_ERROR_CANCELLED);
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+#endif // CHIP_CONFIG_SENDING_BATCH_COMMANDS_ENABLED
+}
+
+void TestCommandInteraction::TestCoalescerBatchesCommands(nlTestSuite * apSuite, void * apContext)
+{
+#if CHIP_CONFIG_SENDING_BATCH_COMMANDS_ENABLED
+    struct FakeRequest : public Clusters::UnitTesting::Commands::TestSimpleArgumentRequest::Type
+    {
+        using ResponseType = DataModel::NullObjectType;
+    };
+
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    FakeRequest request;
+    auto sessionHandle = ctx.GetSessionBobToAlice();
+    BatchCapableInvokeServer server(ctx.GetExchangeManager());
+    ScopedRemoteMaxPathsPerInvoke maxPaths(sessionHandle, BatchCapableInvokeServer::kMaxPathsPerInvoke);
+
+    size_t successCalls = 0;
+    size_t failureCalls = 0;
+    request.arg1        = true;
+
+    // Passing of stack variables by reference is only safe because of synchronous completion of the interaction. Otherwise, it's
+    // not safe to do so.
+    auto onSuccessCb = [&successCalls](const app::ConcreteCommandPath & commandPath, const app::StatusIB & aStatus,
+                                       const auto & dataResponse) { ++successCalls; };
+    auto onFailureCb = [&failureCalls](CHIP_ERROR aError) { ++failureCalls; };
+
+    responseDirective = kSendSuccessStatusCode;
+
+    {
+        Controller::CommandCoalescer coalescer(&ctx.GetExchangeManager(), sessionHandle);
+
+        // Commands to distinct endpoints fill a batch, which is sent as soon as it is full.
+        for (EndpointId endpoint = 1; endpoint <= BatchCapableInvokeServer::kMaxPathsPerInvoke; endpoint++)
+        {
+            NL_TEST_ASSERT(apSuite, coalescer.Invoke(endpoint, request, onSuccessCb, onFailureCb) == CHIP_NO_ERROR);
+        }
+        NL_TEST_ASSERT(apSuite, coalescer.GetPendingCommandCount() == 0);
+        ctx.DrainAndServiceIO();
+        NL_TEST_ASSERT(apSuite, server.mReceivedRequests == 1);
+        NL_TEST_ASSERT(apSuite, successCalls == BatchCapableInvokeServer::kMaxPathsPerInvoke);
+
+        // A path already in the batch starts a new one.
+        NL_TEST_ASSERT(apSuite, coalescer.Invoke(kTestEndpointId, request, onSuccessCb, onFailureCb) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, coalescer.Invoke(kTestEndpointId, request, onSuccessCb, onFailureCb) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, coalescer.GetPendingCommandCount() == 1);
+        NL_TEST_ASSERT(apSuite, coalescer.Flush() == CHIP_NO_ERROR);
+
+        ctx.DrainAndServiceIO();
+    }
+
+    NL_TEST_ASSERT(apSuite, server.mReceivedRequests == 3);
+    NL_TEST_ASSERT(apSuite, server.mDispatchedCommands == BatchCapableInvokeServer::kMaxPathsPerInvoke + 2);
+    NL_TEST_ASSERT(apSuite, successCalls == BatchCapableInvokeServer::kMaxPathsPerInvoke + 2);
+    NL_TEST_ASSERT(apSuite, failureCalls == 0);
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+#endif // CHIP_CONFIG_SENDING_BATCH_COMMANDS_ENABLED
+}
+
+// Compares the rate of the same commands sent to one node with a CommandSender each and with a CommandCoalescer, against a
+// server that accepts kMaxPathsPerInvoke commands per invoke.
+void TestCommandInteraction::TestCoalescerThroughput(nlTestSuite * apSuite, void * apContext)
+{
+#if CHIP_CONFIG_SENDING_BATCH_COMMANDS_ENABLED
+    struct FakeRequest : public Clusters::UnitTesting::Commands::TestSimpleArgumentRequest::Type
+    {
+        using ResponseType = DataModel::NullObjectType;
+    };
+
+    constexpr size_t kRounds = 250;
+
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    FakeRequest request;
+    auto sessionHandle = ctx.GetSessionBobToAlice();
+    BatchCapableInvokeServer server(ctx.GetExchangeManager());
+    ScopedRemoteMaxPathsPerInvoke maxPaths(sessionHandle, BatchCapableInvokeServer::kMaxPathsPerInvoke);
+
+    size_t successCalls = 0;
+    size_t failureCalls = 0;
+    request.arg1        = true;
+
+    // Passing of stack variables by reference is only safe because of synchronous completion of the interaction. Otherwise, it's
+    // not safe to do so.
+    auto onSuccessCb = [&successCalls](const app::ConcreteCommandPath & commandPath, const app::StatusIB & aStatus,
+                                       const auto & dataResponse) { ++successCalls; };
+    auto onFailureCb = [&failureCalls](CHIP_ERROR aError) { ++failureCalls; };
+
+    responseDirective = kSendSuccessStatusCode;
+
+    // Each round sends one command to each of the endpoints a batch can hold. The server handles one invoke at a time, so
+    // every invoke is served before the next one is sent.
+    auto run = [&](auto && invoke, auto && flush, const char * label) {
+        successCalls             = 0;
+        failureCalls             = 0;
+        server.mReceivedRequests = 0;
+        size_t sentMessages      = ctx.GetLoopback().mSentMessageCount;
+        uint64_t startMicros     = System::SystemClock().GetMonotonicMicroseconds64().count();
+
+        for (size_t round = 0; round < kRounds; round++)
+        {
+            for (EndpointId endpoint = 1; endpoint <= BatchCapableInvokeServer::kMaxPathsPerInvoke; endpoint++)
+            {
+                NL_TEST_ASSERT(apSuite, invoke(endpoint) == CHIP_NO_ERROR);
+            }
+            NL_TEST_ASSERT(apSuite, flush() == CHIP_NO_ERROR);
+            ctx.DrainAndServiceIO();
+        }
+
+        uint64_t elapsedMicros = std::max<uint64_t>(System::SystemClock().GetMonotonicMicroseconds64().count() - startMicros, 1);
+        NL_TEST_ASSERT(apSuite, successCalls == kRounds * BatchCapableInvokeServer::kMaxPathsPerInvoke);
+        NL_TEST_ASSERT(apSuite, failureCalls == 0);
+        NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+
+        ChipLogProgress(Controller, "%s: %u commands/s, %u invokes and %u messages for %u commands", label,
+                        static_cast<unsigned>(successCalls * 1000000 / elapsedMicros),
+                        static_cast<unsigned>(server.mReceivedRequests),
+                        static_cast<unsigned>(ctx.GetLoopback().mSentMessageCount - sentMessages),
+                        static_cast<unsigned>(successCalls));
+    };
+
+    run(
+        [&](EndpointId endpoint) {
+            CHIP_ERROR err = Controller::InvokeCommandRequest(&ctx.GetExchangeManager(), sessionHandle, endpoint, request,
+                                                              onSuccessCb, onFailureCb);
+            ctx.DrainAndServiceIO();
+            return err;
+        },
+        []() { return CHIP_NO_ERROR; }, "Without coalescing");
+    NL_TEST_ASSERT(apSuite, server.mReceivedRequests == kRounds * BatchCapableInvokeServer::kMaxPathsPerInvoke);
+
+    Controller::CommandCoalescer coalescer(&ctx.GetExchangeManager(), sessionHandle);
+    run([&](EndpointId endpoint) { return coalescer.Invoke(endpoint, request, onSuccessCb, onFailureCb); },
+        [&]() { return coalescer.Flush(); }, "With coalescing");
+    NL_TEST_ASSERT(apSuite, server.mReceivedRequests == kRounds);
+#endif // CHIP_CONFIG_SENDING_BATCH_COMMANDS_ENABLED
+}
+
+// A fleet of nodes served by the in-process server. Every node gets its own pair of CASE sessions, between the controller
+// on Bob's fabric and the server on Alice's fabric, which the controller finds through its CASESessionManager.
+class FleetTestSetup
+{
+public:
+    static constexpr size_t kNodeCount = 3 * CHIP_IM_MAX_NUM_COMMAND_HANDLER + 1;
+    // Stay within the number of commands the server can handle at once.
+    static constexpr uint16_t kMaxConcurrentNodes = CHIP_IM_MAX_NUM_COMMAND_HANDLER;
+
+    FleetTestSetup(TestContext & ctx) : mContext(ctx), mGroupsProvider(kMaxGroupsPerFabric, kMaxGroupKeysPerFabric) {}
+
+    ~FleetTestSetup()
+    {
+        for (auto & session : mSessions)
+        {
+            if (session)
+            {
+                session.Get().Value()->AsSecureSession()->MarkForEviction();
+            }
+        }
+        mCASESessionManager.Shutdown();
+        mGroupsProvider.Finish();
+        Credentials::SetGroupDataProvider(mPreviousGroupsProvider);
+    }
+
+    CHIP_ERROR Init()
+    {
+        mPreviousGroupsProvider = Credentials::GetGroupDataProvider();
+        mGroupsProvider.SetStorageDelegate(&mStorage);
+        mGroupsProvider.SetSessionKeystore(&mContext.GetSessionKeystore());
+        ReturnErrorOnFailure(mGroupsProvider.Init());
+        Credentials::SetGroupDataProvider(&mGroupsProvider);
+
+        uint8_t buf[sizeof(CompressedFabricId)];
+        MutableByteSpan span(buf);
+        ReturnErrorOnFailure(mContext.GetBobFabric()->GetCompressedFabricIdBytes(span));
+        ReturnErrorOnFailure(GroupTesting::InitData(&mGroupsProvider, mContext.GetBobFabricIndex(), span));
+
+        CASESessionManagerConfig config;
+        config.sessionInitParams.sessionManager    = &mContext.GetSecureSessionManager();
+        config.sessionInitParams.exchangeMgr       = &mContext.GetExchangeManager();
+        config.sessionInitParams.fabricTable       = &mContext.GetFabricTable();
+        config.sessionInitParams.groupDataProvider = &mGroupsProvider;
+        config.clientPool                          = &mCASEClientPool;
+        config.sessionSetupPool                    = &mSessionSetupPool;
+        ReturnErrorOnFailure(mCASESessionManager.Init(&mContext.GetSystemLayer(), config));
+
+        NodeId controllerNodeId = mContext.GetBobFabric()->GetNodeId();
+        for (uint16_t i = 0; i < kNodeCount; i++)
+        {
+            mNodes[i]                  = kFirstNodeId + i;
+            uint16_t controllerSession = static_cast<uint16_t>(kFirstControllerSessionId + i);
+            uint16_t serverSession     = static_cast<uint16_t>(kFirstServerSessionId + i);
+            ReturnErrorOnFailure(mContext.GetSecureSessionManager().InjectCaseSessionWithTestKey(
+                mSessions[2 * i], controllerSession, serverSession, controllerNodeId, mNodes[i], mContext.GetBobFabricIndex(),
+                mContext.GetAliceAddress(), CryptoContext::SessionRole::kInitiator));
+            ReturnErrorOnFailure(mContext.GetSecureSessionManager().InjectCaseSessionWithTestKey(
+                mSessions[2 * i + 1], serverSession, controllerSession, mNodes[i], controllerNodeId,
+                mContext.GetAliceFabricIndex(), mContext.GetBobAddress(), CryptoContext::SessionRole::kResponder));
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    Controller::FleetOperation::Params GetParams()
+    {
+        Controller::FleetOperation::Params params;
+        params.exchangeMgr        = &mContext.GetExchangeManager();
+        params.caseSessionManager = &mCASESessionManager;
+        params.groupDataProvider  = &mGroupsProvider;
+        params.fabricIndex        = mContext.GetBobFabricIndex();
+        params.maxConcurrentNodes = kMaxConcurrentNodes;
+        return params;
+    }
+
+    Span<const NodeId> GetNodes() const { return Span<const NodeId>(mNodes); }
+
+private:
+    static constexpr NodeId kFirstNodeId                = 0x1000;
+    static constexpr uint16_t kFirstControllerSessionId = 0x100;
+    static constexpr uint16_t kFirstServerSessionId     = 0x200;
+    static constexpr uint16_t kMaxGroupsPerFabric       = 5;
+    static constexpr uint16_t kMaxGroupKeysPerFabric    = 8;
+
+    TestContext & mContext;
+    TestPersistentStorageDelegate mStorage;
+    Credentials::GroupDataProviderImpl mGroupsProvider;
+    Credentials::GroupDataProvider * mPreviousGroupsProvider = nullptr;
+    CASEClientPool<kMaxConcurrentNodes> mCASEClientPool;
+    OperationalSessionSetupPool<kMaxConcurrentNodes> mSessionSetupPool;
+    CASESessionManager mCASESessionManager;
+    NodeId mNodes[kNodeCount];
+    SessionHolder mSessions[2 * kNodeCount];
+};
+
+class FleetResultCollector : public Controller::FleetOperation::Callback
+{
+public:
+    void OnNodeResult(Controller::FleetOperation & operation, const Controller::FleetNodeResult & result) override
+    {
+        mResultCount++;
+        mSuccessCount += (result.error == CHIP_NO_ERROR) ? 1 : 0;
+        mGroupcastCount += (result.delivery == Controller::FleetNodeResult::Delivery::kGroupcast) ? 1 : 0;
+    }
+
+    void OnDone(Controller::FleetOperation & operation) override { mDoneCount++; }
+
+    size_t mResultCount    = 0;
+    size_t mSuccessCount   = 0;
+    size_t mGroupcastCount = 0;
+    size_t mDoneCount      = 0;
+};
+
+// The server responds to TestSimpleArgumentRequest with a TestStructArrayArgumentResponse, see TestDataResponse.
+struct FleetDataRequest : public Clusters::UnitTesting::Commands::TestSimpleArgumentRequest::Type
+{
+    using ResponseType = Clusters::UnitTesting::Commands::TestStructArrayArgumentResponse::DecodableType;
+};
+
+// A command without response data, which can be sent to a group.
+struct FleetGroupRequest : public Clusters::UnitTesting::Commands::TestSimpleArgumentRequest::Type
+{
+    using ResponseType = DataModel::NullObjectType;
+};
+
+void TestCommandInteraction::TestFleetOperationUnicast(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    FleetTestSetup fleet(ctx);
+    NL_TEST_ASSERT(apSuite, fleet.Init() == CHIP_NO_ERROR);
+
+    // A command with a data response cannot be sent to a group, even if the application names one.
+    FleetDataRequest request;
+    request.arg1 = true;
+
+    Controller::FleetOperation::Params params = fleet.GetParams();
+    params.groupId.SetValue(ctx.GetFriendsGroupId());
+
+    responseDirective = kSendDataResponse;
+
+    FleetResultCollector collector;
+    Controller::FleetOperation operation(collector);
+    NL_TEST_ASSERT(apSuite, operation.Invoke(params, fleet.GetNodes(), kTestEndpointId, request) == CHIP_NO_ERROR);
+
+    // Sessions already exist, so the first nodes are sent their command right away, and no more of them than allowed.
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == FleetTestSetup::kMaxConcurrentNodes);
+
+    ctx.DrainAndServiceIO();
+
+    NL_TEST_ASSERT(apSuite, collector.mDoneCount == 1);
+    NL_TEST_ASSERT(apSuite, collector.mResultCount == FleetTestSetup::kNodeCount);
+    NL_TEST_ASSERT(apSuite, collector.mSuccessCount == FleetTestSetup::kNodeCount);
+    NL_TEST_ASSERT(apSuite, collector.mGroupcastCount == 0);
+    NL_TEST_ASSERT(apSuite, operation.GetResults().size() == FleetTestSetup::kNodeCount);
+    for (size_t i = 0; i < operation.GetResults().size(); i++)
+    {
+        const auto & result = operation.GetResults()[i];
+        NL_TEST_ASSERT(apSuite, result.nodeId == fleet.GetNodes()[i]);
+        NL_TEST_ASSERT(apSuite, result.delivery == Controller::FleetNodeResult::Delivery::kUnicast);
+    }
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
+void TestCommandInteraction::TestFleetOperationFailure(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    FleetTestSetup fleet(ctx);
+    NL_TEST_ASSERT(apSuite, fleet.Init() == CHIP_NO_ERROR);
+
+    FleetGroupRequest request;
+    request.arg1 = true;
+
+    responseDirective = kSendError;
+
+    FleetResultCollector collector;
+    Controller::FleetOperation operation(collector);
+    NL_TEST_ASSERT(apSuite, operation.Invoke(fleet.GetParams(), fleet.GetNodes(), kTestEndpointId, request) == CHIP_NO_ERROR);
+
+    ctx.DrainAndServiceIO();
+
+    // Every node reports its own failure, and a failed node does not hold back the others.
+    NL_TEST_ASSERT(apSuite, collector.mDoneCount == 1);
+    NL_TEST_ASSERT(apSuite, collector.mResultCount == FleetTestSetup::kNodeCount);
+    NL_TEST_ASSERT(apSuite, collector.mSuccessCount == 0);
+    for (const auto & result : operation.GetResults())
+    {
+        NL_TEST_ASSERT(apSuite, result.error == CHIP_IM_GLOBAL_STATUS(Failure));
+    }
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
+void TestCommandInteraction::TestFleetOperationGroupcast(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx = *static_cast<TestContext *>(apContext);
+    FleetTestSetup fleet(ctx);
+    NL_TEST_ASSERT(apSuite, fleet.Init() == CHIP_NO_ERROR);
+
+    FleetGroupRequest request;
+    request.arg1 = true;
+
+    responseDirective = kSendSuccessStatusCode;
+
+    // The fabric has keys for the group, so the whole fleet gets a single message.
+    {
+        Controller::FleetOperation::Params params = fleet.GetParams();
+        params.groupId.SetValue(ctx.GetFriendsGroupId());
+
+        FleetResultCollector collector;
+        Controller::FleetOperation operation(collector);
+        uint32_t sentMessages = ctx.GetLoopback().mSentMessageCount;
+        NL_TEST_ASSERT(apSuite, operation.Invoke(params, fleet.GetNodes(), kTestEndpointId, request) == CHIP_NO_ERROR);
+
+        NL_TEST_ASSERT(apSuite, collector.mDoneCount == 1);
+        NL_TEST_ASSERT(apSuite, collector.mGroupcastCount == FleetTestSetup::kNodeCount);
+        NL_TEST_ASSERT(apSuite, collector.mSuccessCount == FleetTestSetup::kNodeCount);
+        NL_TEST_ASSERT(apSuite, ctx.GetLoopback().mSentMessageCount - sentMessages == 1);
+
+        ctx.DrainAndServiceIO();
+    }
+
+    // Without keys for the group, every node is sent the command over its own session.
+    {
+        Controller::FleetOperation::Params params = fleet.GetParams();
+        params.groupId.SetValue(static_cast<GroupId>(0x0999));
+
+        FleetResultCollector collector;
+        Controller::FleetOperation operation(collector);
+        NL_TEST_ASSERT(apSuite, operation.Invoke(params, fleet.GetNodes(), kTestEndpointId, request) == CHIP_NO_ERROR);
+
+        ctx.DrainAndServiceIO();
+
+        NL_TEST_ASSERT(apSuite, collector.mDoneCount == 1);
+        NL_TEST_ASSERT(apSuite, collector.mGroupcastCount == 0);
+        NL_TEST_ASSERT(apSuite, collector.mSuccessCount == FleetTestSetup::kNodeCount);
+    }
+
+    NL_TEST_ASSERT(apSuite, ctx.GetExchangeManager().GetNumActiveExchanges() == 0);
+}
+
 const nlTest sTests[] = {
     NL_TEST_DEF("TestDataResponse", TestCommandInteraction::TestDataResponse),
     NL_TEST_DEF("TestSuccessNoDataResponse", TestCommandInteraction::TestSuccessNoDataResponse),
@@ -549,6 +1180,15 @@ const nlTest sTests[] = {
     NL_TEST_DEF("TestMultipleFailures", TestCommandInteraction::TestMultipleFailures),
     NL_TEST_DEF("TestSuccessNoDataResponseWithClusterStatus", TestCommandInteraction::TestSuccessNoDataResponseWithClusterStatus),
     NL_TEST_DEF("TestFailureWithClusterStatus", TestCommandInteraction::TestFailureWithClusterStatus),
+    NL_TEST_DEF("TestCoalescedCommands", TestCommandInteraction::TestCoalescedCommands),
+    NL_TEST_DEF("TestCoalescedCommandFailure", TestCommandInteraction::TestCoalescedCommandFailure),
+    NL_TEST_DEF("TestCoalescerWindow", TestCommandInteraction::TestCoalescerWindow),
+    NL_TEST_DEF("TestCoalescerCancelsPendingCommands", TestCommandInteraction::TestCoalescerCancelsPendingCommands),
+    NL_TEST_DEF("TestCoalescerBatchesCommands", TestCommandInteraction::TestCoalescerBatchesCommands),
+    NL_TEST_DEF("TestCoalescerThroughput", TestCommandInteraction::TestCoalescerThroughput),
+    NL_TEST_DEF("TestFleetOperationUnicast", TestCommandInteraction::TestFleetOperationUnicast),
+    NL_TEST_DEF("TestFleetOperationFailure", TestCommandInteraction::TestFleetOperationFailure),
+    NL_TEST_DEF("TestFleetOperationGroupcast", TestCommandInteraction::TestFleetOperationGroupcast),
     NL_TEST_SENTINEL(),
 };
 
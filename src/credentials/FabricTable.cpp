@@ -53,6 +53,30 @@ constexpr TLV::Tag kFabricIndicesTag            = TLV::ContextTag(1);
 constexpr TLV::Tag kMarkerFabricIndexTag = TLV::ContextTag(0);
 constexpr TLV::Tag kMarkerIsAdditionTag  = TLV::ContextTag(1);
 
+// Multiplicative (Fibonacci) hashing, spreads keys that differ in few bits, such as fabric indices, over the table.
+size_t FabricLookupHash(uint64_t key, size_t tableSize)
+{
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & (tableSize - 1);
+}
+
+// Key for the <root public key, fabric ID> lookup table: leading X coordinate bytes of the root key mixed with the fabric ID.
+uint64_t RootAndFabricIdLookupKey(const P256PublicKey & rootPubKey, FabricId fabricId)
+{
+    return Encoding::BigEndian::Get64(rootPubKey.ConstBytes() + 1) ^ fabricId;
+}
+
+template <size_t N>
+void InsertInFabricLookupTable(uint8_t (&table)[N], uint64_t key, size_t statePosition)
+{
+    // Tables are sized to stay at most half full, so a free slot is always found.
+    size_t pos = FabricLookupHash(key, N);
+    while (table[pos] != 0)
+    {
+        pos = (pos + 1) & (N - 1);
+    }
+    table[pos] = static_cast<uint8_t>(statePosition + 1);
+}
+
 constexpr size_t CommitMarkerContextTLVMaxSize()
 {
     // Add 2x uncommitted uint64_t to leave space for backwards/forwards
@@ -437,6 +461,49 @@ CHIP_ERROR FabricTable::VerifyCredentials(const ByteSpan & noc, const ByteSpan &
     return CHIP_NO_ERROR;
 }
 
+template <typename Predicate>
+const FabricInfo * FabricTable::FindInFabricLookupTable(const FabricLookupTable & table, uint64_t key, Predicate predicate) const
+{
+    size_t pos = FabricLookupHash(key, kFabricLookupTableSize);
+    for (size_t probes = 0; (probes < kFabricLookupTableSize) && (table[pos] != 0); ++probes)
+    {
+        const FabricInfo & fabric = mStates[table[pos] - 1];
+        if (fabric.IsInitialized() && predicate(fabric))
+        {
+            return &fabric;
+        }
+        pos = (pos + 1) & (kFabricLookupTableSize - 1);
+    }
+
+    return nullptr;
+}
+
+void FabricTable::RebuildFabricLookupTables()
+{
+    memset(mFabricIndexLookup, 0, sizeof(mFabricIndexLookup));
+    memset(mCompressedIdLookup, 0, sizeof(mCompressedIdLookup));
+    memset(mRootAndFabricIdLookup, 0, sizeof(mRootAndFabricIdLookup));
+
+    for (size_t statePosition = 0; statePosition < ArraySize(mStates); ++statePosition)
+    {
+        const FabricInfo & fabric = mStates[statePosition];
+        if (!fabric.IsInitialized())
+        {
+            continue;
+        }
+
+        InsertInFabricLookupTable(mFabricIndexLookup, fabric.GetFabricIndex(), statePosition);
+        InsertInFabricLookupTable(mCompressedIdLookup, fabric.GetCompressedFabricId(), statePosition);
+
+        P256PublicKey rootPubKey;
+        if (fabric.FetchRootPubkey(rootPubKey) == CHIP_NO_ERROR)
+        {
+            InsertInFabricLookupTable(mRootAndFabricIdLookup, RootAndFabricIdLookupKey(rootPubKey, fabric.GetFabricId()),
+                                      statePosition);
+        }
+    }
+}
+
 const FabricInfo * FabricTable::FindFabric(const Crypto::P256PublicKey & rootPubKey, FabricId fabricId) const
 {
     return FindFabricCommon(rootPubKey, fabricId);
@@ -463,25 +530,13 @@ const FabricInfo * FabricTable::FindFabricCommon(const Crypto::P256PublicKey & r
         }
     }
 
-    for (auto & fabric : mStates)
-    {
-        auto matchingNodeId = (nodeId == kUndefinedNodeId) ? fabric.GetNodeId() : nodeId;
-
-        if (!fabric.IsInitialized())
-        {
-            continue;
-        }
-        if (fabric.FetchRootPubkey(candidatePubKey) != CHIP_NO_ERROR)
-        {
-            continue;
-        }
-        if (rootPubKey.Matches(candidatePubKey) && fabricId == fabric.GetFabricId() && matchingNodeId == fabric.GetNodeId())
-        {
-            return &fabric;
-        }
-    }
-
-    return nullptr;
+    return FindInFabricLookupTable(mRootAndFabricIdLookup, RootAndFabricIdLookupKey(rootPubKey, fabricId),
+                                   [&](const FabricInfo & fabric) {
+                                       auto matchingNodeId = (nodeId == kUndefinedNodeId) ? fabric.GetNodeId() : nodeId;
+                                       return (fabric.FetchRootPubkey(candidatePubKey) == CHIP_NO_ERROR) &&
+                                           rootPubKey.Matches(candidatePubKey) && fabricId == fabric.GetFabricId() &&
+                                           matchingNodeId == fabric.GetNodeId();
+                                   });
 }
 
 FabricInfo * FabricTable::GetMutableFabricByIndex(FabricIndex fabricIndex)
@@ -492,20 +547,10 @@ FabricInfo * FabricTable::GetMutableFabricByIndex(FabricIndex fabricIndex)
         return &mPendingFabric;
     }
 
-    for (auto & fabric : mStates)
-    {
-        if (!fabric.IsInitialized())
-        {
-            continue;
-        }
-
-        if (fabric.GetFabricIndex() == fabricIndex)
-        {
-            return &fabric;
-        }
-    }
-
-    return nullptr;
+    // Lookup results always point into mStates, which we own mutably.
+    auto hasFabricIndex       = [fabricIndex](const FabricInfo & fabric) { return fabric.GetFabricIndex() == fabricIndex; };
+    const FabricInfo * fabric = FindInFabricLookupTable(mFabricIndexLookup, fabricIndex, hasFabricIndex);
+    return const_cast<FabricInfo *>(fabric);
 }
 
 const FabricInfo * FabricTable::FindFabricWithIndex(FabricIndex fabricIndex) const
@@ -521,20 +566,8 @@ const FabricInfo * FabricTable::FindFabricWithIndex(FabricIndex fabricIndex) con
         return &mPendingFabric;
     }
 
-    for (const auto & fabric : mStates)
-    {
-        if (!fabric.IsInitialized())
-        {
-            continue;
-        }
-
-        if (fabric.GetFabricIndex() == fabricIndex)
-        {
-            return &fabric;
-        }
-    }
-
-    return nullptr;
+    return FindInFabricLookupTable(mFabricIndexLookup, fabricIndex,
+                                   [fabricIndex](const FabricInfo & fabric) { return fabric.GetFabricIndex() == fabricIndex; });
 }
 
 const FabricInfo * FabricTable::FindFabricWithCompressedId(CompressedFabricId compressedFabricId) const
@@ -545,19 +578,9 @@ const FabricInfo * FabricTable::FindFabricWithCompressedId(CompressedFabricId co
         return &mPendingFabric;
     }
 
-    for (auto & fabric : mStates)
-    {
-        if (!fabric.IsInitialized())
-        {
-            continue;
-        }
-
-        if (compressedFabricId == fabric.GetPeerId().GetCompressedFabricId())
-        {
-            return &fabric;
-        }
-    }
-    return nullptr;
+    return FindInFabricLookupTable(mCompressedIdLookup, compressedFabricId, [compressedFabricId](const FabricInfo & fabric) {
+        return compressedFabricId == fabric.GetPeerId().GetCompressedFabricId();
+    });
 }
 
 CHIP_ERROR FabricTable::FetchRootCert(FabricIndex fabricIndex, MutableByteSpan & outCert) const
@@ -669,9 +692,12 @@ CHIP_ERROR FabricTable::LoadFromStorage(FabricInfo * fabric, FabricIndex newFabr
         ChipLogError(FabricProvisioning, "Failed to load Fabric (0x%x): %" CHIP_ERROR_FORMAT, static_cast<unsigned>(newFabricIndex),
                      err.Format());
         fabric->Reset();
+        RebuildFabricLookupTables();
         return err;
     }
 
+    RebuildFabricLookupTables();
+
     ChipLogProgress(FabricProvisioning,
                     "Fabric index 0x%x was retrieved from storage. Compressed FabricId 0x" ChipLogFormatX64
                     ", FabricId 0x" ChipLogFormatX64 ", NodeId 0x" ChipLogFormatX64 ", VendorId 0x%04X",
@@ -877,7 +903,12 @@ FabricTable::AddOrUpdateInner(FabricIndex fabricIndex, bool isAddition, Crypto::
     newFabricInfo.advertiseIdentity = (advertiseIdentity == AdvertiseIdentity::Yes);
 
     // Update local copy of fabric data. For add it's a new entry, for update, it's `mPendingFabric` shadow entry.
-    ReturnErrorOnFailure(fabricEntry->Init(newFabricInfo));
+    CHIP_ERROR initErr = fabricEntry->Init(newFabricInfo);
+    if (isAddition)
+    {
+        RebuildFabricLookupTables();
+    }
+    ReturnErrorOnFailure(initErr);
 
     // Set the label, matching add/update semantics of empty/existing.
     fabricEntry->SetFabricLabel(fabricLabel);
@@ -979,6 +1010,7 @@ CHIP_ERROR FabricTable::Delete(FabricIndex fabricIndex)
 
     // Since fabricIsInitialized was true, fabric is not null.
     fabricInfo->Reset();
+    RebuildFabricLookupTables();
 
     if (!mNextAvailableFabricIndex.HasValue())
     {
@@ -1057,6 +1089,7 @@ CHIP_ERROR FabricTable::Init(const FabricTable::InitParams & initParams)
     {
         fabric.Reset();
     }
+    RebuildFabricLookupTables();
     mNextAvailableFabricIndex.SetValue(kMinValidFabricIndex);
 
     // Init failure of Last Known Good Time is non-fatal.  If Last Known Good
@@ -1121,6 +1154,7 @@ void FabricTable::Forget(FabricIndex fabricIndex)
 
     RevertPendingFabricData();
     fabricInfo->Reset();
+    RebuildFabricLookupTables();
 }
 
 void FabricTable::Shutdown()
@@ -1144,6 +1178,7 @@ void FabricTable::Shutdown()
         // direct lookups fail.
         fabricInfo.Reset();
     }
+    RebuildFabricLookupTables();
 
     mStorage = nullptr;
 }
@@ -1901,6 +1936,7 @@ CHIP_ERROR FabricTable::CommitPendingFabricData()
             // Commit the pending entry to local in-memory fabric metadata, which
             // also moves operational keys if not backed by OperationalKeystore
             *existingFabricToUpdate = std::move(mPendingFabric);
+            RebuildFabricLookupTables();
         }
 
         // Store pending metadata first
@@ -1081,6 +1081,32 @@ private:
     const FabricInfo * FindFabricCommon(const Crypto::P256PublicKey & rootPubKey, FabricId fabricId,
                                         NodeId nodeId = kUndefinedNodeId) const;
 
+    // Smallest power of two that keeps the lookup tables at most half full.
+    static constexpr size_t kFabricLookupTableSize = [] {
+        size_t size = 1;
+        while (size < 2 * CHIP_CONFIG_MAX_FABRICS)
+        {
+            size *= 2;
+        }
+        return size;
+    }();
+    static_assert(CHIP_CONFIG_MAX_FABRICS < UINT8_MAX, "Lookup table entries must fit in a uint8_t");
+
+    // Open-addressed (linear probing) hash table of mStates positions. Each element holds the
+    // position in mStates plus one, or 0 when empty.
+    using FabricLookupTable = uint8_t[kFabricLookupTableSize];
+
+    /**
+     * Rebuild the lookup tables used by FindFabricWithIndex, FindFabricWithCompressedId and
+     * FindFabricCommon. Must be called whenever an entry of mStates is initialized, replaced or reset.
+     * Entries are inserted in mStates order, so that lookups keep returning the first matching entry.
+     */
+    void RebuildFabricLookupTables();
+
+    // Returns the first initialized entry of mStates found in `table` under `key` for which `predicate` is true.
+    template <typename Predicate>
+    const FabricInfo * FindInFabricLookupTable(const FabricLookupTable & table, uint64_t key, Predicate predicate) const;
+
     /**
      * UpdateNextAvailableFabricIndex should only be called when
      * mNextAvailableFabricIndex has a value and that value stops being
@@ -1164,6 +1190,12 @@ private:
     FabricInfo mStates[CHIP_CONFIG_MAX_FABRICS];
     // Used for UpdateNOC pending fabric updates
     FabricInfo mPendingFabric;
+
+    // Lookup tables over mStates (the pending fabric is always checked separately), see RebuildFabricLookupTables().
+    FabricLookupTable mFabricIndexLookup     = {};
+    FabricLookupTable mCompressedIdLookup    = {};
+    FabricLookupTable mRootAndFabricIdLookup = {};
+
     PersistentStorageDelegate * mStorage                    = nullptr;
     Crypto::OperationalKeystore * mOperationalKeystore      = nullptr;
     Credentials::OperationalCertificateStore * mOpCertStore = nullptr;
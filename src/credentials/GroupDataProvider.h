@@ -295,6 +295,16 @@ public:
      */
     virtual CHIP_ERROR GetIpkKeySet(FabricIndex fabric_index, KeySet & out_keyset) = 0;
 
+    /**
+     * @brief Obtain a counter that changes whenever a key set of any fabric is set or removed,
+     *        so that callers holding on to IPK key sets can tell when to reload them.
+     *
+     * @param out_generation - Set to the current key set generation on success
+     * @return true on success, false if key set changes are not tracked, in which case key sets
+     *         obtained earlier must be read again before being trusted.
+     */
+    virtual bool GetKeySetGeneration(uint32_t & out_generation) { return false; }
+
     /**
      *  Creates an iterator that may be used to obtain the list of key sets associated with the given fabric.
      *  In order to release the allocated memory, the Release() method must be called after the iteration is finished.
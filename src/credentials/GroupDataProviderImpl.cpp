@@ -832,11 +832,14 @@ void GroupDataProviderImpl::Finish()
     mKeySetIterators.ReleaseAll();
     mGroupSessionsIterator.ReleaseAll();
     mGroupKeyContexPool.ReleaseAll();
+    InvalidateGroupSessionCache();
 }
 
 void GroupDataProviderImpl::SetStorageDelegate(PersistentStorageDelegate * storage)
 {
     VerifyOrDie(storage != nullptr);
+    InvalidateGroupSessionCache();
+    mKeySetGeneration++;
     mStorage = storage;
 }
 
@@ -1349,6 +1352,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveEndpoints(chip::FabricIndex fabric_index
 CHIP_ERROR GroupDataProviderImpl::SetGroupKeyAt(chip::FabricIndex fabric_index, size_t index, const GroupKey & in_map)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeyMapData map(fabric_index);
@@ -1415,6 +1419,7 @@ CHIP_ERROR GroupDataProviderImpl::GetGroupKeyAt(chip::FabricIndex fabric_index,
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_index, size_t index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     KeyMapData map;
@@ -1447,6 +1452,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_inde
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeys(chip::FabricIndex fabric_index)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
 
     FabricData fabric(fabric_index);
     VerifyOrReturnError(CHIP_NO_ERROR == fabric.Load(mStorage), CHIP_ERROR_INVALID_FABRIC_INDEX);
@@ -1523,6 +1529,8 @@ CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, cons
                                             const KeySet & in_keyset)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
+    mKeySetGeneration++;
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1594,6 +1602,8 @@ CHIP_ERROR GroupDataProviderImpl::GetKeySet(chip::FabricIndex fabric_index, uint
 CHIP_ERROR GroupDataProviderImpl::RemoveKeySet(chip::FabricIndex fabric_index, uint16_t target_id)
 {
     VerifyOrReturnError(IsInitialized(), CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionCache();
+    mKeySetGeneration++;
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1695,6 +1705,9 @@ void GroupDataProviderImpl::KeySetIteratorImpl::Release()
 
 CHIP_ERROR GroupDataProviderImpl::RemoveFabric(chip::FabricIndex fabric_index)
 {
+    InvalidateGroupSessionCache();
+    mKeySetGeneration++;
+
     FabricData fabric(fabric_index);
 
     // Fabric data defaults to zero, so if not entry is found, no mappings, or keys are removed
@@ -1762,7 +1775,14 @@ Crypto::SymmetricKeyContext * GroupDataProviderImpl::GetKeyContext(FabricIndex f
             Crypto::GroupOperationalCredentials * creds = keyset.GetCurrentGroupCredentials();
             if (nullptr != creds)
             {
-                return mGroupKeyContexPool.CreateObject(*this, creds->encryption_key, creds->hash, creds->privacy_key);
+                GroupKeyContext * context = mGroupKeyContexPool.CreateObject(*this);
+                VerifyOrReturnError(context != nullptr, nullptr);
+                if (CHIP_NO_ERROR != context->Initialize(creds->encryption_key, creds->hash, creds->privacy_key))
+                {
+                    mGroupKeyContexPool.ReleaseObject(context);
+                    return nullptr;
+                }
+                return context;
             }
         }
     }
@@ -1842,9 +1862,121 @@ GroupDataProviderImpl::GroupSessionIterator * GroupDataProviderImpl::IterateGrou
     return mGroupSessionsIterator.CreateObject(*this, session_id);
 }
 
+bool GroupDataProviderImpl::LoadGroupSessionCache()
+{
+    VerifyOrReturnValue(kGroupSessionCacheMax > 0 && !mGroupSessionCacheUnusable, false);
+    VerifyOrReturnValue(!mGroupSessionCacheLoaded, true);
+
+    FabricList fabric_list;
+    CHIP_ERROR err = fabric_list.Load(mStorage);
+    if (CHIP_ERROR_NOT_FOUND == err)
+    {
+        // No fabrics, hence no group sessions
+        mGroupSessionCacheLoaded = true;
+        return true;
+    }
+    if (CHIP_NO_ERROR != err)
+    {
+        mGroupSessionCacheUnusable = true;
+        return false;
+    }
+
+    FabricData fabric(fabric_list.first_entry);
+    for (size_t i = 0; i < fabric_list.entry_count; i++, fabric.fabric_index = fabric.next)
+    {
+        VerifyOrExit(CHIP_NO_ERROR == fabric.Load(mStorage), err = CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+
+        KeyMapData mapping(fabric.fabric_index, fabric.first_map);
+        for (uint16_t j = 0; j < fabric.map_count; ++j, mapping.id = mapping.next)
+        {
+            VerifyOrExit(CHIP_NO_ERROR == mapping.Load(mStorage), err = CHIP_ERROR_PERSISTED_STORAGE_FAILED);
+
+            KeySetData keyset;
+            VerifyOrExit(keyset.Find(mStorage, fabric, mapping.keyset_id), err = CHIP_ERROR_KEY_NOT_FOUND);
+
+            for (uint16_t k = 0; k < keyset.keys_count; ++k)
+            {
+                VerifyOrExit(mGroupSessionCacheCount < kGroupSessionCacheMax, err = CHIP_ERROR_NO_MEMORY);
+                const Crypto::GroupOperationalCredentials & creds = keyset.operational_keys[k];
+                CachedGroupSession * session =
+                    mGroupSessionCachePool.CreateObject(*this, fabric.fabric_index, mapping.group_id, keyset.policy, creds.hash);
+                VerifyOrExit(session != nullptr, err = CHIP_ERROR_NO_MEMORY);
+                err = session->keyContext.Initialize(creds.encryption_key, creds.hash, creds.privacy_key);
+                if (CHIP_NO_ERROR != err)
+                {
+                    mGroupSessionCachePool.ReleaseObject(session);
+                    ExitNow();
+                }
+
+                // Insert sorted by session id
+                size_t index = mGroupSessionCacheCount++;
+                for (; index > 0 && mGroupSessionCache[index - 1]->session_id > session->session_id; index--)
+                {
+                    mGroupSessionCache[index] = mGroupSessionCache[index - 1];
+                }
+                mGroupSessionCache[index] = session;
+            }
+        }
+    }
+    mGroupSessionCacheLoaded = true;
+
+exit:
+    if (CHIP_NO_ERROR != err)
+    {
+        InvalidateGroupSessionCache();
+        // Don't try again for every message, only once something changed
+        mGroupSessionCacheUnusable = true;
+        return false;
+    }
+    return true;
+}
+
+void GroupDataProviderImpl::InvalidateGroupSessionCache()
+{
+    for (size_t i = 0; i < mGroupSessionCacheCount; i++)
+    {
+        mGroupSessionCache[i]->keyContext.ReleaseKeys();
+        mGroupSessionCachePool.ReleaseObject(mGroupSessionCache[i]);
+        mGroupSessionCache[i] = nullptr;
+    }
+    mGroupSessionCacheCount    = 0;
+    mGroupSessionCacheLoaded   = false;
+    mGroupSessionCacheUnusable = false;
+    mGroupSessionCacheGeneration++;
+}
+
 GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupDataProviderImpl & provider, uint16_t session_id) :
     mProvider(provider), mSessionId(session_id), mGroupKeyContext(provider)
 {
+    if (provider.LoadGroupSessionCache())
+    {
+        // Find the range of cached sessions with the target session id
+        size_t low  = 0;
+        size_t high = provider.mGroupSessionCacheCount;
+        while (low < high)
+        {
+            size_t mid = low + (high - low) / 2;
+            if (provider.mGroupSessionCache[mid]->session_id < session_id)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+        mCacheFirst = low;
+        mCacheEnd   = low;
+        while (mCacheEnd < provider.mGroupSessionCacheCount && provider.mGroupSessionCache[mCacheEnd]->session_id == session_id)
+        {
+            mCacheEnd++;
+        }
+        mCacheIndex      = mCacheFirst;
+        mCacheGeneration = provider.mGroupSessionCacheGeneration;
+        mCached          = true;
+        return;
+    }
+
     FabricList fabric_list;
     ReturnOnFailure(fabric_list.Load(provider.mStorage));
     mFirstFabric = fabric_list.first_entry;
@@ -1857,6 +1989,11 @@ GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupD
 
 size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
 {
+    if (mCached)
+    {
+        return (mCacheGeneration == mProvider.mGroupSessionCacheGeneration) ? (mCacheEnd - mCacheFirst) : 0;
+    }
+
     FabricData fabric(mFirstFabric);
     size_t count = 0;
 
@@ -1896,8 +2033,24 @@ size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
     return count;
 }
 
+bool GroupDataProviderImpl::GroupSessionIteratorImpl::NextCached(GroupSession & output)
+{
+    // The cached sessions are gone if the cache was dropped since the iterator was created
+    VerifyOrReturnValue(mCacheGeneration == mProvider.mGroupSessionCacheGeneration, false);
+    VerifyOrReturnValue(mCacheIndex < mCacheEnd, false);
+
+    CachedGroupSession * session = mProvider.mGroupSessionCache[mCacheIndex++];
+    output.fabric_index          = session->fabric_index;
+    output.group_id              = session->group_id;
+    output.security_policy       = session->security_policy;
+    output.keyContext            = &session->keyContext;
+    return true;
+}
+
 bool GroupDataProviderImpl::GroupSessionIteratorImpl::Next(GroupSession & output)
 {
+    VerifyOrReturnValue(!mCached, NextCached(output));
+
     while (mFabricCount < mFabricTotal)
     {
         FabricData fabric(mFabric);
@@ -1938,7 +2091,8 @@ bool GroupDataProviderImpl::GroupSessionIteratorImpl::Next(GroupSession & output
         Crypto::GroupOperationalCredentials & creds = keyset.operational_keys[mKeyIndex++];
         if (creds.hash == mSessionId)
         {
-            mGroupKeyContext.Initialize(creds.encryption_key, mSessionId, creds.privacy_key);
+            VerifyOrReturnValue(CHIP_NO_ERROR == mGroupKeyContext.Initialize(creds.encryption_key, mSessionId, creds.privacy_key),
+                                false);
             output.fabric_index    = fabric.fabric_index;
             output.group_id        = mapping.group_id;
             output.security_policy = keyset.policy;
@@ -27,7 +27,8 @@ namespace Credentials {
 class GroupDataProviderImpl : public GroupDataProvider
 {
 public:
-    static constexpr size_t kIteratorsMax = CHIP_CONFIG_MAX_GROUP_CONCURRENT_ITERATORS;
+    static constexpr size_t kIteratorsMax         = CHIP_CONFIG_MAX_GROUP_CONCURRENT_ITERATORS;
+    static constexpr size_t kGroupSessionCacheMax = CHIP_CONFIG_MAX_CACHED_GROUP_SESSIONS;
 
     GroupDataProviderImpl() = default;
     GroupDataProviderImpl(uint16_t maxGroupsPerFabric, uint16_t maxGroupKeysPerFabric) :
@@ -88,6 +89,11 @@ public:
     CHIP_ERROR GetKeySet(FabricIndex fabric_index, chip::KeysetId keyset_id, KeySet & keys) override;
     CHIP_ERROR RemoveKeySet(FabricIndex fabric_index, chip::KeysetId keyset_id) override;
     CHIP_ERROR GetIpkKeySet(FabricIndex fabric_index, KeySet & out_keyset) override;
+    bool GetKeySetGeneration(uint32_t & out_generation) override
+    {
+        out_generation = mKeySetGeneration;
+        return true;
+    }
     KeySetIterator * IterateKeySets(FabricIndex fabric_index) override;
 
     // Fabrics
@@ -156,16 +162,12 @@ protected:
     public:
         GroupKeyContext(GroupDataProviderImpl & provider) : mProvider(provider) {}
 
-        GroupKeyContext(GroupDataProviderImpl & provider, const Crypto::Symmetric128BitsKeyByteArray & encryptionKey, uint16_t hash,
-                        const Crypto::Symmetric128BitsKeyByteArray & privacyKey) :
-            mProvider(provider)
-
-        {
-            Initialize(encryptionKey, hash, privacyKey);
-        }
-
-        void Initialize(const Crypto::Symmetric128BitsKeyByteArray & encryptionKey, uint16_t hash,
-                        const Crypto::Symmetric128BitsKeyByteArray & privacyKey)
+        /**
+         * Loads the keys in the session keystore.  On failure, e.g. because the keystore is out of key slots, no key is
+         * left loaded and the context must not be used.
+         */
+        CHIP_ERROR Initialize(const Crypto::Symmetric128BitsKeyByteArray & encryptionKey, uint16_t hash,
+                              const Crypto::Symmetric128BitsKeyByteArray & privacyKey)
         {
             ReleaseKeys();
             mKeyHash = hash;
@@ -176,8 +178,16 @@ protected:
             // like more work, so let's use the transitional code below for now.
 
             Crypto::SessionKeystore * keystore = mProvider.GetSessionKeystore();
-            keystore->CreateKey(encryptionKey, mEncryptionKey);
-            keystore->CreateKey(privacyKey, mPrivacyKey);
+            CHIP_ERROR err                     = keystore->CreateKey(encryptionKey, mEncryptionKey);
+            if (CHIP_NO_ERROR == err)
+            {
+                err = keystore->CreateKey(privacyKey, mPrivacyKey);
+            }
+            if (CHIP_NO_ERROR != err)
+            {
+                ReleaseKeys();
+            }
+            return err;
         }
 
         void ReleaseKeys()
@@ -221,6 +231,24 @@ protected:
         size_t mTotal       = 0;
     };
 
+    /**
+     * Group session with its keys loaded in the session keystore, see LoadGroupSessionCache().
+     */
+    struct CachedGroupSession
+    {
+        CachedGroupSession(GroupDataProviderImpl & provider, FabricIndex fabric, GroupId group, SecurityPolicy policy,
+                           uint16_t session) :
+            session_id(session),
+            fabric_index(fabric), group_id(group), security_policy(policy), keyContext(provider)
+        {}
+
+        uint16_t session_id;
+        FabricIndex fabric_index;
+        GroupId group_id;
+        SecurityPolicy security_policy;
+        GroupKeyContext keyContext;
+    };
+
     class GroupSessionIteratorImpl : public GroupSessionIterator
     {
     public:
@@ -230,7 +258,15 @@ protected:
         void Release() override;
 
     protected:
+        bool NextCached(GroupSession & output);
+
         GroupDataProviderImpl & mProvider;
+        // Set when iterating over the group session cache, in which case the storage fields below are unused.
+        bool mCached              = false;
+        uint32_t mCacheGeneration = 0;
+        size_t mCacheFirst        = 0;
+        size_t mCacheIndex        = 0;
+        size_t mCacheEnd          = 0;
         uint16_t mSessionId      = 0;
         FabricIndex mFirstFabric = kUndefinedFabricIndex;
         FabricIndex mFabric      = kUndefinedFabricIndex;
@@ -246,6 +282,23 @@ protected:
     bool IsInitialized() { return (mStorage != nullptr); }
     CHIP_ERROR RemoveEndpoints(FabricIndex fabric_index, GroupId group_id);
 
+    /**
+     * Loads the group sessions of all fabrics into the group session cache, unless already loaded.
+     *
+     * The cache lets incoming group messages be matched to their candidate keys without reading the persistent storage
+     * or loading keys in the session keystore for every message.  It is indexed by session id and dropped whenever the
+     * group keys, key sets or fabrics change.
+     *
+     * Every cached session holds two keys (encryption and privacy) in the session keystore, so a full cache takes
+     * 2 * kGroupSessionCacheMax keystore slots for as long as it is loaded.
+     *
+     * @return false if the cache can't be used, e.g. because there are more group sessions than kGroupSessionCacheMax
+     *         or the keystore ran out of slots, in which case the group sessions must be read from storage.  A cache
+     *         that failed to load is not tried again until it is invalidated.
+     */
+    bool LoadGroupSessionCache();
+    void InvalidateGroupSessionCache();
+
     PersistentStorageDelegate * mStorage       = nullptr;
     Crypto::SessionKeystore * mSessionKeystore = nullptr;
     ObjectPool<GroupInfoIteratorImpl, kIteratorsMax> mGroupInfoIterators;
@@ -254,6 +307,18 @@ protected:
     ObjectPool<KeySetIteratorImpl, kIteratorsMax> mKeySetIterators;
     ObjectPool<GroupSessionIteratorImpl, kIteratorsMax> mGroupSessionsIterator;
     ObjectPool<GroupKeyContext, kIteratorsMax> mGroupKeyContexPool;
+
+    // Group session cache, sorted by session id.
+    ObjectPool<CachedGroupSession, (kGroupSessionCacheMax > 0) ? kGroupSessionCacheMax : 1> mGroupSessionCachePool;
+    CachedGroupSession * mGroupSessionCache[(kGroupSessionCacheMax > 0) ? kGroupSessionCacheMax : 1] = {};
+    size_t mGroupSessionCacheCount = 0;
+    // Incremented whenever the cache is dropped, so that iterators over the cache can tell it went away.
+    uint32_t mGroupSessionCacheGeneration = 0;
+    bool mGroupSessionCacheLoaded         = false;
+    // Set if loading the cache failed, until the next change.
+    bool mGroupSessionCacheUnusable = false;
+    // Incremented whenever a key set is set or removed, see GetKeySetGeneration().
+    uint32_t mKeySetGeneration = 0;
 };
 
 } // namespace Credentials
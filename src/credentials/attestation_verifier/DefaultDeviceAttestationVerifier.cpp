@@ -29,6 +29,9 @@
 #include <lib/support/CodeUtils.h>
 #include <lib/support/ScopedBuffer.h>
 #include <lib/support/Span.h>
+#include <system/SystemClock.h>
+
+#include <string.h>
 
 using namespace chip::Crypto;
 using chip::TestCerts::GetTestPaaRootStore;
@@ -308,6 +311,42 @@ AttestationVerificationResult MapError(CertificateChainValidationResult certific
         return AttestationVerificationResult::kInternalError;
     }
 }
+
+constexpr System::Clock::Seconds32 kVerificationCacheTimeout(CHIP_CONFIG_ATTESTATION_VERIFICATION_CACHE_TIMEOUT_SECS);
+
+// Returns the unexpired entry of a verification cache that matches `digest`, if any.
+template <typename Entry, size_t N>
+Entry * FindVerificationCacheEntry(std::array<Entry, N> & cache, const uint8_t * digest, System::Clock::Timestamp now)
+{
+    for (auto & entry : cache)
+    {
+        if (entry.expiry > now && memcmp(entry.digest, digest, sizeof(entry.digest)) == 0)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+// Returns the entry of a verification cache to overwrite with a new result: an expired one if any, otherwise
+// the least recently used one. Returns nullptr if caching is disabled.
+template <typename Entry, size_t N>
+Entry * AllocateVerificationCacheEntry(std::array<Entry, N> & cache, uint32_t useCounter, System::Clock::Timestamp now)
+{
+    Entry * candidate = nullptr;
+    for (auto & entry : cache)
+    {
+        if (entry.expiry <= now)
+        {
+            return &entry;
+        }
+        if (candidate == nullptr || (useCounter - entry.lastUsed) > (useCounter - candidate->lastUsed))
+        {
+            candidate = &entry;
+        }
+    }
+    return candidate;
+}
 } // namespace
 
 void DefaultDACVerifier::VerifyAttestationInformation(const DeviceAttestationVerifier::AttestationInfo & info,
@@ -320,6 +359,10 @@ void DefaultDACVerifier::VerifyAttestationInformation(const DeviceAttestationVer
     AttestationCertVidPid dacVidPid;
     AttestationCertVidPid paiVidPid;
     AttestationCertVidPid paaVidPid;
+    ByteSpan paaCertSpan;
+    uint8_t paiDigest[kSHA256_Hash_Length];
+    System::Clock::Timestamp now     = System::SystemClock().GetMonotonicTimestamp();
+    CachedPaiChain * cachedPaiChain = nullptr;
 
     VerifyOrExit(!info.attestationElementsBuffer.empty() && !info.attestationChallengeBuffer.empty() &&
                      !info.attestationSignatureBuffer.empty() && !info.dacDerBuffer.empty() &&
@@ -332,9 +375,19 @@ void DefaultDACVerifier::VerifyAttestationInformation(const DeviceAttestationVer
     // Ensure PAI is present
     VerifyOrExit(!info.paiDerBuffer.empty(), attestationError = AttestationVerificationResult::kPaiMissing);
 
+    // Checks that only depend on the PAI and its PAA are skipped when the PAI was recently verified.
+    VerifyOrExit(Hash_SHA256(info.paiDerBuffer.data(), info.paiDerBuffer.size(), paiDigest) == CHIP_NO_ERROR,
+                 attestationError = AttestationVerificationResult::kInternalError);
+    cachedPaiChain = FindVerificationCacheEntry(mPaiChainCache, paiDigest, now);
+    if (cachedPaiChain != nullptr)
+    {
+        cachedPaiChain->lastUsed = ++mCacheUseCounter;
+    }
+
     // Validate Proper Certificate Format
     {
-        VerifyOrExit(VerifyAttestationCertificateFormat(info.paiDerBuffer, AttestationCertType::kPAI) == CHIP_NO_ERROR,
+        VerifyOrExit(cachedPaiChain != nullptr ||
+                         VerifyAttestationCertificateFormat(info.paiDerBuffer, AttestationCertType::kPAI) == CHIP_NO_ERROR,
                      attestationError = AttestationVerificationResult::kPaiFormatInvalid);
         VerifyOrExit(VerifyAttestationCertificateFormat(info.dacDerBuffer, AttestationCertType::kDAC) == CHIP_NO_ERROR,
                      attestationError = AttestationVerificationResult::kDacFormatInvalid);
@@ -344,8 +397,15 @@ void DefaultDACVerifier::VerifyAttestationInformation(const DeviceAttestationVer
     {
         VerifyOrExit(ExtractVIDPIDFromX509Cert(info.dacDerBuffer, dacVidPid) == CHIP_NO_ERROR,
                      attestationError = AttestationVerificationResult::kDacFormatInvalid);
-        VerifyOrExit(ExtractVIDPIDFromX509Cert(info.paiDerBuffer, paiVidPid) == CHIP_NO_ERROR,
-                     attestationError = AttestationVerificationResult::kPaiFormatInvalid);
+        if (cachedPaiChain != nullptr)
+        {
+            paiVidPid = cachedPaiChain->paiVidPid;
+        }
+        else
+        {
+            VerifyOrExit(ExtractVIDPIDFromX509Cert(info.paiDerBuffer, paiVidPid) == CHIP_NO_ERROR,
+                         attestationError = AttestationVerificationResult::kPaiFormatInvalid);
+        }
         VerifyOrExit(paiVidPid.mVendorId.HasValue() && paiVidPid.mVendorId == dacVidPid.mVendorId,
                      attestationError = AttestationVerificationResult::kDacVendorIdMismatch);
         VerifyOrExit(dacVidPid.mProductId.HasValue(), attestationError = AttestationVerificationResult::kDacProductIdMismatch);
@@ -373,6 +433,12 @@ void DefaultDACVerifier::VerifyAttestationInformation(const DeviceAttestationVer
                      attestationError = AttestationVerificationResult::kAttestationSignatureInvalid);
     }
 
+    if (cachedPaiChain != nullptr)
+    {
+        paaCertSpan = ByteSpan(cachedPaiChain->paaCert, cachedPaiChain->paaCertLength);
+        paaVidPid   = cachedPaiChain->paaVidPid;
+    }
+    else
     {
         uint8_t akidBuf[Crypto::kAuthorityKeyIdentifierLength];
         MutableByteSpan akid(akidBuf);
@@ -405,6 +471,8 @@ void DefaultDACVerifier::VerifyAttestationInformation(const DeviceAttestationVer
         }
 
         VerifyOrExit(!paaVidPid.mProductId.HasValue(), attestationError = AttestationVerificationResult::kPaaFormatInvalid);
+
+        paaCertSpan = paaDerBuffer;
     }
 
 #if !defined(CURRENT_TIME_NOT_IMPLEMENTED)
@@ -413,7 +481,7 @@ void DefaultDACVerifier::VerifyAttestationInformation(const DeviceAttestationVer
 #endif
 
     CertificateChainValidationResult chainValidationResult;
-    VerifyOrExit(ValidateCertificateChain(paaDerBuffer.data(), paaDerBuffer.size(), info.paiDerBuffer.data(),
+    VerifyOrExit(ValidateCertificateChain(paaCertSpan.data(), paaCertSpan.size(), info.paiDerBuffer.data(),
                                           info.paiDerBuffer.size(), info.dacDerBuffer.data(), info.dacDerBuffer.size(),
                                           chainValidationResult) == CHIP_NO_ERROR,
                  attestationError = MapError(chainValidationResult));
@@ -436,11 +504,21 @@ void DefaultDACVerifier::VerifyAttestationInformation(const DeviceAttestationVer
             .paaVendorId  = paaVidPid.mVendorId.ValueOr(VendorId::NotSpecified),
         };
 
-        MutableByteSpan paaSKID(deviceInfo.paaSKID);
-        VerifyOrExit(ExtractSKIDFromX509Cert(paaDerBuffer, paaSKID) == CHIP_NO_ERROR,
-                     attestationError = AttestationVerificationResult::kPaaFormatInvalid);
-        VerifyOrExit(paaSKID.size() == sizeof(deviceInfo.paaSKID),
-                     attestationError = AttestationVerificationResult::kPaaFormatInvalid);
+        if (cachedPaiChain != nullptr)
+        {
+            memcpy(deviceInfo.paaSKID, cachedPaiChain->paaSkid, sizeof(deviceInfo.paaSKID));
+        }
+        else
+        {
+            MutableByteSpan paaSKID(deviceInfo.paaSKID);
+            VerifyOrExit(ExtractSKIDFromX509Cert(paaCertSpan, paaSKID) == CHIP_NO_ERROR,
+                         attestationError = AttestationVerificationResult::kPaaFormatInvalid);
+            VerifyOrExit(paaSKID.size() == sizeof(deviceInfo.paaSKID),
+                         attestationError = AttestationVerificationResult::kPaaFormatInvalid);
+
+            // The PAI chained up to its PAA, remember it for the next devices of the same product line.
+            CachePaiChain(paiDigest, paaCertSpan, paiVidPid, paaVidPid, ByteSpan(deviceInfo.paaSKID), now);
+        }
 
         VerifyOrExit(DeconstructAttestationElements(info.attestationElementsBuffer, certificationDeclarationSpan,
                                                     attestationNonceSpan, timestampDeconstructed, firmwareInfoSpan,
@@ -462,9 +540,48 @@ exit:
     onCompletion->mCall(onCompletion->mContext, info, attestationError);
 }
 
+void DefaultDACVerifier::CachePaiChain(const uint8_t * paiDigest, const ByteSpan & paaCert, const AttestationCertVidPid & paiVidPid,
+                                       const AttestationCertVidPid & paaVidPid, const ByteSpan & paaSkid,
+                                       System::Clock::Timestamp now)
+{
+    CachedPaiChain * entry = AllocateVerificationCacheEntry(mPaiChainCache, mCacheUseCounter, now);
+    VerifyOrReturn(entry != nullptr && paaCert.size() <= sizeof(entry->paaCert) && paaSkid.size() == sizeof(entry->paaSkid));
+
+    memcpy(entry->digest, paiDigest, sizeof(entry->digest));
+    memcpy(entry->paaCert, paaCert.data(), paaCert.size());
+    entry->paaCertLength = paaCert.size();
+    entry->paiVidPid     = paiVidPid;
+    entry->paaVidPid     = paaVidPid;
+    memcpy(entry->paaSkid, paaSkid.data(), sizeof(entry->paaSkid));
+    entry->expiry   = now + kVerificationCacheTimeout;
+    entry->lastUsed = ++mCacheUseCounter;
+}
+
+void DefaultDACVerifier::ClearVerificationCache()
+{
+    mPaiChainCache          = {};
+    mCertificationDeclCache = {};
+}
+
 AttestationVerificationResult DefaultDACVerifier::ValidateCertificationDeclarationSignature(const ByteSpan & cmsEnvelopeBuffer,
                                                                                             ByteSpan & certDeclBuffer)
 {
+    uint8_t cmsDigest[kSHA256_Hash_Length];
+    System::Clock::Timestamp now = System::SystemClock().GetMonotonicTimestamp();
+    VerifyOrReturnError(Hash_SHA256(cmsEnvelopeBuffer.data(), cmsEnvelopeBuffer.size(), cmsDigest) == CHIP_NO_ERROR,
+                        AttestationVerificationResult::kInternalError);
+
+    CachedCertificationDeclaration * cached = FindVerificationCacheEntry(mCertificationDeclCache, cmsDigest, now);
+    if (cached != nullptr)
+    {
+        // Test key support may have been disabled since the signature was verified.
+        VerifyOrReturnError(!cached->signedWithTestKey || IsCdTestKeySupported(),
+                            AttestationVerificationResult::kCertificationDeclarationNoCertificateFound);
+        cached->lastUsed = ++mCacheUseCounter;
+        certDeclBuffer   = cmsEnvelopeBuffer.SubSpan(cached->contentOffset, cached->contentLength);
+        return AttestationVerificationResult::kSuccess;
+    }
+
     ByteSpan kid;
     VerifyOrReturnError(CMS_ExtractKeyId(cmsEnvelopeBuffer, kid) == CHIP_NO_ERROR,
                         AttestationVerificationResult::kCertificationDeclarationNoKeyId);
@@ -482,6 +599,19 @@ AttestationVerificationResult DefaultDACVerifier::ValidateCertificationDeclarati
     VerifyOrReturnError(CMS_Verify(cmsEnvelopeBuffer, verifyingKey, certDeclBuffer) == CHIP_NO_ERROR,
                         AttestationVerificationResult::kCertificationDeclarationInvalidSignature);
 
+    // The CD content lies within the envelope, so only its location needs to be remembered.
+    CachedCertificationDeclaration * entry = AllocateVerificationCacheEntry(mCertificationDeclCache, mCacheUseCounter, now);
+    if (entry != nullptr && certDeclBuffer.data() >= cmsEnvelopeBuffer.data() &&
+        certDeclBuffer.data() + certDeclBuffer.size() <= cmsEnvelopeBuffer.data() + cmsEnvelopeBuffer.size())
+    {
+        memcpy(entry->digest, cmsDigest, sizeof(entry->digest));
+        entry->contentOffset     = static_cast<size_t>(certDeclBuffer.data() - cmsEnvelopeBuffer.data());
+        entry->contentLength     = certDeclBuffer.size();
+        entry->signedWithTestKey = mCdKeysTrustStore.IsCdTestKey(kid);
+        entry->expiry            = now + kVerificationCacheTimeout;
+        entry->lastUsed          = ++mCacheUseCounter;
+    }
+
     return AttestationVerificationResult::kSuccess;
 }
 
@@ -17,12 +17,14 @@
 #pragma once
 
 #include <array>
+#include <credentials/CHIPCert.h>
 #include <credentials/attestation_verifier/DeviceAttestationVerifier.h>
 #include <crypto/CHIPCryptoPAL.h>
 #include <lib/core/CHIPConfig.h>
 #include <lib/core/CHIPError.h>
 #include <lib/support/Span.h>
 #include <stdlib.h>
+#include <system/SystemClock.h>
 
 namespace chip {
 namespace Credentials {
@@ -76,11 +78,53 @@ public:
 
     CsaCdKeysTrustStore * GetCertificationDeclarationTrustStore() override { return &mCdKeysTrustStore; }
 
+    /**
+     * @brief Forget all cached PAI chain and Certification Declaration verification results.
+     *
+     * Cached results otherwise expire after CHIP_CONFIG_ATTESTATION_VERIFICATION_CACHE_TIMEOUT_SECS, so this
+     * should be called when a PAA is removed from the trust store and must stop being accepted right away.
+     */
+    void ClearVerificationCache();
+
 protected:
     DefaultDACVerifier() {}
 
+    // A PAI that chained up to a trusted PAA, with everything derived from the PAI and PAA that
+    // does not depend on the DAC.
+    struct CachedPaiChain
+    {
+        uint8_t digest[Crypto::kSHA256_Hash_Length];
+        uint8_t paaCert[kMaxDERCertLength];
+        size_t paaCertLength;
+        Crypto::AttestationCertVidPid paiVidPid;
+        Crypto::AttestationCertVidPid paaVidPid;
+        uint8_t paaSkid[Crypto::kSubjectKeyIdentifierLength];
+        System::Clock::Timestamp expiry;
+        uint32_t lastUsed;
+    };
+
+    // A CMS envelope with a valid Certification Declaration signature, and where the CD content lies in it.
+    struct CachedCertificationDeclaration
+    {
+        uint8_t digest[Crypto::kSHA256_Hash_Length];
+        size_t contentOffset;
+        size_t contentLength;
+        bool signedWithTestKey;
+        System::Clock::Timestamp expiry;
+        uint32_t lastUsed;
+    };
+
+    static constexpr size_t kVerificationCacheSize = CHIP_CONFIG_ATTESTATION_VERIFICATION_CACHE_SIZE;
+
+    void CachePaiChain(const uint8_t * paiDigest, const ByteSpan & paaCert, const Crypto::AttestationCertVidPid & paiVidPid,
+                       const Crypto::AttestationCertVidPid & paaVidPid, const ByteSpan & paaSkid, System::Clock::Timestamp now);
+
     CsaCdKeysTrustStore mCdKeysTrustStore;
     const AttestationTrustStore * mAttestationTrustStore;
+
+    std::array<CachedPaiChain, kVerificationCacheSize> mPaiChainCache                         = {};
+    std::array<CachedCertificationDeclaration, kVerificationCacheSize> mCertificationDeclCache = {};
+    uint32_t mCacheUseCounter                                                                  = 0;
 };
 
 /**
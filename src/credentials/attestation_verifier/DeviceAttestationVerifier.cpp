@@ -98,6 +98,38 @@ CHIP_ERROR DeviceAttestationVerifier::ValidateAttestationSignature(const P256Pub
     return CHIP_NO_ERROR;
 }
 
+void DeviceAttestationVerifier::VerifyAttestationInformationBatch(
+    const Span<const AttestationInfo> & infos, Callback::Callback<OnAttestationInformationVerification> * onCompletion)
+{
+    Platform::ScopedMemoryBuffer<bool> verified;
+    if (infos.empty() || !verified.Calloc(infos.size()))
+    {
+        for (const auto & info : infos)
+        {
+            VerifyAttestationInformation(info, onCompletion);
+        }
+        return;
+    }
+
+    // Verify all the entries sharing a PAI with the first entry not verified yet, then move on to the next PAI.
+    for (size_t i = 0; i < infos.size(); i++)
+    {
+        if (verified[i])
+        {
+            continue;
+        }
+
+        for (size_t j = i; j < infos.size(); j++)
+        {
+            if (!verified[j] && infos[j].paiDerBuffer.data_equal(infos[i].paiDerBuffer))
+            {
+                verified[j] = true;
+                VerifyAttestationInformation(infos[j], onCompletion);
+            }
+        }
+    }
+}
+
 DeviceAttestationVerifier * GetDeviceAttestationVerifier()
 {
     return gDacVerifier;
@@ -342,6 +342,19 @@ public:
     virtual void VerifyAttestationInformation(const AttestationInfo & info,
                                               Callback::Callback<OnAttestationInformationVerification> * onCompletion) = 0;
 
+    /**
+     * @brief Verify the attestation information of several devices, e.g. on a production line.
+     *
+     * Entries sharing the same PAI are verified back to back, so that verifiers caching PAI chain and
+     * Certification Declaration results only do that work once per product line. onCompletion is
+     * called once per entry, which may not be in the order of `infos`.
+     *
+     * @param[in] infos        The attestation information of each device.
+     * @param[in] onCompletion Callback handler called with the result of each entry.
+     */
+    virtual void VerifyAttestationInformationBatch(const Span<const AttestationInfo> & infos,
+                                                   Callback::Callback<OnAttestationInformationVerification> * onCompletion);
+
     /**
      * @brief Verify a CMS Signed Data signature against the CSA certificate of Subject Key Identifier that matches
      *        the subjectKeyIdentifier field of cmsEnvelopeBuffer.
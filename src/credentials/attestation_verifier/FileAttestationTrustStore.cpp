@@ -17,18 +17,31 @@
 #include "FileAttestationTrustStore.h"
 
 #include <crypto/CHIPCryptoPAL.h>
+#include <lib/support/BytesToHex.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <cinttypes>
+#include <climits>
 #include <cstdio>
 #include <cstring>
 #include <string>
 
 extern "C" {
 #include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 }
 
 namespace chip {
 namespace Credentials {
 
 namespace {
+
+// Header line of the persisted SKID index. Bump the version whenever the line format changes.
+constexpr char kPAAIndexHeader[] = "CHIP-PAA-SKID-INDEX 1\n";
+
 const char * GetFilenameExtension(const char * filename)
 {
     const char * dot = strrchr(filename, '.');
@@ -38,18 +51,63 @@ const char * GetFilenameExtension(const char * filename)
     }
     return dot + 1;
 }
+
+bool IsDerFilename(const char * filename)
+{
+    return strncmp(GetFilenameExtension(filename), "der", strlen("der")) == 0;
+}
+
+int64_t GetModificationTime(const struct stat & fileStat)
+{
+#if defined(__APPLE__)
+    return static_cast<int64_t>(fileStat.st_mtimespec.tv_sec) * 1000000000 + fileStat.st_mtimespec.tv_nsec;
+#else
+    return static_cast<int64_t>(fileStat.st_mtim.tv_sec) * 1000000000 + fileStat.st_mtim.tv_nsec;
+#endif
+}
+
+// Checks that `certificate` is a well-formed PAA certificate and extracts its subject key identifier.
+CHIP_ERROR ExtractPAASKID(const ByteSpan & certificate, MutableByteSpan & skid)
+{
+    VerifyOrReturnError(!certificate.empty() && certificate.size() <= kMaxDERCertLength, CHIP_ERROR_INVALID_ARGUMENT);
+    ReturnErrorOnFailure(VerifyAttestationCertificateFormat(certificate, Crypto::AttestationCertType::kPAA));
+    return Crypto::ExtractSKIDFromX509Cert(certificate, skid);
+}
+
+// Reads a PAA certificate file, checking its format and extracting its subject key identifier.
+CHIP_ERROR ReadPAACertificate(const std::string & path, std::vector<uint8_t> & certificate, MutableByteSpan & skid)
+{
+    FILE * file = fopen(path.c_str(), "rb");
+    VerifyOrReturnError(file != nullptr, CHIP_ERROR_OPEN_FAILED);
+
+    certificate.resize(kMaxDERCertLength + 1);
+    size_t certificateLength = fread(certificate.data(), sizeof(uint8_t), certificate.size(), file);
+    fclose(file);
+
+    certificate.resize(certificateLength);
+    return ExtractPAASKID(ByteSpan{ certificate.data(), certificate.size() }, skid);
+}
+
 } // namespace
 
-FileAttestationTrustStore::FileAttestationTrustStore(const char * paaTrustStorePath)
+FileAttestationTrustStore::MappedCertificate::~MappedCertificate()
+{
+    munmap(mData, mSize);
+}
+
+FileAttestationTrustStore::FileAttestationTrustStore(const char * paaTrustStorePath, const char * paaIndexPath)
 {
     VerifyOrReturn(paaTrustStorePath != nullptr);
 
-    if (paaTrustStorePath != nullptr)
+    mTrustStorePath = paaTrustStorePath;
+    if (paaIndexPath != nullptr)
     {
-        mPAADerCerts = LoadAllX509DerCerts(paaTrustStorePath);
-        VerifyOrReturn(paaCount());
+        mIndexPath = paaIndexPath;
     }
 
+    RefreshIndex(true /* force */);
+    VerifyOrReturn(paaCount());
+
     mIsInitialized = true;
 }
 
@@ -70,93 +128,296 @@ std::vector<std::vector<uint8_t>> LoadAllX509DerCerts(const char * trustStorePat
         dirent * entry;
         while ((entry = readdir(dir)) != nullptr)
         {
-            const char * fileExtension = GetFilenameExtension(entry->d_name);
-            if (strncmp(fileExtension, "der", strlen("der")) == 0)
+            if (IsDerFilename(entry->d_name))
             {
-                std::vector<uint8_t> certificate(kMaxDERCertLength + 1);
+                std::vector<uint8_t> certificate;
                 std::string filename(trustStorePath);
 
                 filename += std::string("/") + std::string(entry->d_name);
 
-                FILE * file = fopen(filename.c_str(), "rb");
-                if (file == nullptr)
+                // Only accumulate certificate if it has a subject key ID extension. On bad files, just skip.
+                uint8_t kidBuf[Crypto::kSubjectKeyIdentifierLength] = { 0 };
+                MutableByteSpan kidSpan{ kidBuf };
+                if (CHIP_NO_ERROR == ReadPAACertificate(filename, certificate, kidSpan))
                 {
-                    // On bad files, just skip.
-                    continue;
+                    certs.push_back(std::move(certificate));
                 }
+            }
+        }
+        closedir(dir);
+    }
+
+    return certs;
+}
+
+FileAttestationTrustStore::~FileAttestationTrustStore()
+{
+    Cleanup();
+}
+
+void FileAttestationTrustStore::Cleanup()
+{
+    mPAAIndex.clear();
+    mDirectoryModificationTime = 0;
+    mIsInitialized             = false;
+}
+
+bool FileAttestationTrustStore::RefreshIndex(bool force) const
+{
+    // Adding, removing or renaming a certificate updates the modification time of the directory, so a
+    // single stat() is enough to tell whether the index is still current.
+    struct stat dirStat;
+    if (stat(mTrustStorePath.c_str(), &dirStat) != 0)
+    {
+        bool hadEntries = !mPAAIndex.empty();
+        mPAAIndex.clear();
+        mDirectoryModificationTime = 0;
+        return hadEntries;
+    }
+
+    int64_t directoryModificationTime = GetModificationTime(dirStat);
+    if (!force && directoryModificationTime == mDirectoryModificationTime)
+    {
+        return false;
+    }
+
+    // Entries of the previous index (or of the persisted index on first load) are reused as-is for files
+    // whose size and modification time did not change, so unchanged certificates are never read again.
+    PAAIndex previousIndex;
+    previousIndex.swap(mPAAIndex);
+    if (previousIndex.empty())
+    {
+        LoadPersistedIndex(previousIndex);
+    }
+
+    std::unordered_map<std::string, std::string> previousSkidByFileName;
+    for (const auto & item : previousIndex)
+    {
+        previousSkidByFileName.emplace(item.second.fileName, item.first);
+    }
+
+    size_t reusedCount = 0;
+    size_t parsedCount = 0;
+
+    DIR * dir = opendir(mTrustStorePath.c_str());
+    if (dir != nullptr)
+    {
+        // Nested directories are not handled.
+        dirent * dirEntry;
+        while ((dirEntry = readdir(dir)) != nullptr)
+        {
+            if (!IsDerFilename(dirEntry->d_name))
+            {
+                continue;
+            }
+
+            std::string fileName(dirEntry->d_name);
+            std::string path = mTrustStorePath + "/" + fileName;
+
+            struct stat fileStat;
+            if (stat(path.c_str(), &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+            {
+                continue;
+            }
 
-                size_t certificateLength = fread(certificate.data(), sizeof(uint8_t), certificate.size(), file);
-                if ((certificateLength > 0) && (certificateLength <= kMaxDERCertLength))
+            uint64_t fileSize        = static_cast<uint64_t>(fileStat.st_size);
+            int64_t modificationTime = GetModificationTime(fileStat);
+
+            auto previousSkid = previousSkidByFileName.find(fileName);
+            if (previousSkid != previousSkidByFileName.end())
+            {
+                auto previous = previousIndex.find(previousSkid->second);
+                if (previous->second.fileSize == fileSize && previous->second.modificationTime == modificationTime)
                 {
-                    certificate.resize(certificateLength);
-                    // Only accumulate certificate if it has a subject key ID extension
+                    if (mPAAIndex.emplace(previous->first, std::move(previous->second)).second)
                     {
-                        uint8_t kidBuf[Crypto::kSubjectKeyIdentifierLength] = { 0 };
-                        MutableByteSpan kidSpan{ kidBuf };
-                        ByteSpan certSpan{ certificate.data(), certificate.size() };
-
-                        if (CHIP_NO_ERROR != VerifyAttestationCertificateFormat(certSpan, Crypto::AttestationCertType::kPAA))
-                        {
-                            continue;
-                        }
-
-                        if (CHIP_NO_ERROR == Crypto::ExtractSKIDFromX509Cert(certSpan, kidSpan))
-                        {
-                            certs.push_back(certificate);
-                        }
+                        reusedCount++;
                     }
+                    continue;
                 }
-                fclose(file);
             }
+
+            std::vector<uint8_t> certificate;
+            uint8_t skidBuf[Crypto::kSubjectKeyIdentifierLength] = { 0 };
+            MutableByteSpan skidSpan{ skidBuf };
+            parsedCount++;
+            if (CHIP_NO_ERROR != ReadPAACertificate(path, certificate, skidSpan))
+            {
+                continue;
+            }
+
+            PAAIndexEntry entry;
+            entry.fileName         = std::move(fileName);
+            entry.fileSize         = fileSize;
+            entry.modificationTime = modificationTime;
+            mPAAIndex.emplace(std::string(reinterpret_cast<const char *>(skidSpan.data()), skidSpan.size()), std::move(entry));
         }
         closedir(dir);
     }
 
-    return certs;
+    mDirectoryModificationTime = directoryModificationTime;
+
+    ChipLogProgress(NotSpecified, "Indexed %u PAA certificates from %s (%u parsed, %u reused)",
+                    static_cast<unsigned>(mPAAIndex.size()), mTrustStorePath.c_str(), static_cast<unsigned>(parsedCount),
+                    static_cast<unsigned>(reusedCount));
+
+    bool changed = (parsedCount != 0) || (reusedCount != previousIndex.size());
+    if (changed)
+    {
+        StorePersistedIndex();
+    }
+    return changed;
 }
 
-FileAttestationTrustStore::~FileAttestationTrustStore()
+void FileAttestationTrustStore::LoadPersistedIndex(PAAIndex & index) const
 {
-    Cleanup();
+    VerifyOrReturn(!mIndexPath.empty());
+
+    FILE * file = fopen(mIndexPath.c_str(), "r");
+    VerifyOrReturn(file != nullptr);
+
+    // Each line is "<SKID as hex> <file size> <modification time> <file name>".
+    char line[NAME_MAX + 128];
+    if (fgets(line, sizeof(line), file) != nullptr && strcmp(line, kPAAIndexHeader) == 0)
+    {
+        while (fgets(line, sizeof(line), file) != nullptr)
+        {
+            char skidHex[2 * Crypto::kSubjectKeyIdentifierLength + 1];
+            uint8_t skidBuf[Crypto::kSubjectKeyIdentifierLength];
+            PAAIndexEntry entry;
+            int fileNameOffset = -1;
+
+            sscanf(line, "%40s %" SCNu64 " %" SCNd64 " %n", skidHex, &entry.fileSize, &entry.modificationTime, &fileNameOffset);
+            if (fileNameOffset < 0 || Encoding::HexToBytes(skidHex, strlen(skidHex), skidBuf, sizeof(skidBuf)) != sizeof(skidBuf))
+            {
+                continue;
+            }
+
+            entry.fileName = line + fileNameOffset;
+            if (!entry.fileName.empty() && entry.fileName.back() == '\n')
+            {
+                entry.fileName.pop_back();
+            }
+            if (entry.fileName.empty() || entry.fileName.find('/') != std::string::npos)
+            {
+                continue;
+            }
+
+            index.emplace(std::string(reinterpret_cast<const char *>(skidBuf), sizeof(skidBuf)), std::move(entry));
+        }
+    }
+
+    fclose(file);
 }
 
-void FileAttestationTrustStore::Cleanup()
+void FileAttestationTrustStore::StorePersistedIndex() const
 {
-    mPAADerCerts.clear();
-    mIsInitialized = false;
+    VerifyOrReturn(!mIndexPath.empty());
+
+    // Write to a temporary file and rename it over the index, so that a concurrent reader never sees a partial index.
+    std::string temporaryPath = mIndexPath + ".tmp";
+    FILE * file               = fopen(temporaryPath.c_str(), "w");
+    if (file == nullptr)
+    {
+        ChipLogError(NotSpecified, "Failed to write PAA index %s", mIndexPath.c_str());
+        return;
+    }
+
+    bool success = fputs(kPAAIndexHeader, file) >= 0;
+    for (const auto & item : mPAAIndex)
+    {
+        char skidHex[2 * Crypto::kSubjectKeyIdentifierLength + 1];
+        if (Encoding::BytesToUppercaseHexString(reinterpret_cast<const uint8_t *>(item.first.data()), item.first.size(), skidHex,
+                                                sizeof(skidHex)) != CHIP_NO_ERROR)
+        {
+            continue;
+        }
+        success = success &&
+            fprintf(file, "%s %" PRIu64 " %" PRId64 " %s\n", skidHex, item.second.fileSize, item.second.modificationTime,
+                    item.second.fileName.c_str()) > 0;
+    }
+
+    success = (fclose(file) == 0) && success;
+    if (!success || rename(temporaryPath.c_str(), mIndexPath.c_str()) != 0)
+    {
+        ChipLogError(NotSpecified, "Failed to write PAA index %s", mIndexPath.c_str());
+        unlink(temporaryPath.c_str());
+    }
+}
+
+CHIP_ERROR FileAttestationTrustStore::MapCertificate(const std::string & skid, PAAIndexEntry & entry) const
+{
+    std::string path = mTrustStorePath + "/" + entry.fileName;
+
+    int fd = open(path.c_str(), O_RDONLY);
+    VerifyOrReturnError(fd >= 0, CHIP_ERROR_OPEN_FAILED);
+
+    // The file must still be the one that was indexed.
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || static_cast<uint64_t>(fileStat.st_size) != entry.fileSize ||
+        GetModificationTime(fileStat) != entry.modificationTime || entry.fileSize == 0 || entry.fileSize > kMaxDERCertLength)
+    {
+        close(fd);
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+
+    size_t size = static_cast<size_t>(entry.fileSize);
+    void * data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    VerifyOrReturnError(data != MAP_FAILED, CHIP_ERROR_NO_MEMORY);
+
+    std::unique_ptr<MappedCertificate> mapping(new MappedCertificate(data, size));
+
+    // Entries may come from the persisted index, so check the certificate itself before handing it out.
+    uint8_t skidBuf[Crypto::kSubjectKeyIdentifierLength] = { 0 };
+    MutableByteSpan skidSpan{ skidBuf };
+    ReturnErrorOnFailure(ExtractPAASKID(mapping->Span(), skidSpan));
+    VerifyOrReturnError(skidSpan.data_equal(ByteSpan{ reinterpret_cast<const uint8_t *>(skid.data()), skid.size() }),
+                        CHIP_ERROR_INCORRECT_STATE);
+
+    entry.mapping = std::move(mapping);
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR FileAttestationTrustStore::GetProductAttestationAuthorityCert(const ByteSpan & skid,
                                                                          MutableByteSpan & outPaaDerBuffer) const
 {
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    if (!mTrustStorePath.empty())
+    {
+        RefreshIndex(false /* force */);
+    }
+
     // If the constructor has not tried to initialize the PAA certificates database, return CHIP_ERROR_NOT_IMPLEMENTED to use the
     // testing trust store if the DefaultAttestationVerifier is in use.
-    if (mIsInitialized && paaCount() == 0)
+    if (mIsInitialized && mPAAIndex.empty())
     {
         return CHIP_ERROR_NOT_IMPLEMENTED;
     }
 
-    VerifyOrReturnError(!mPAADerCerts.empty(), CHIP_ERROR_CA_CERT_NOT_FOUND);
+    VerifyOrReturnError(!mPAAIndex.empty(), CHIP_ERROR_CA_CERT_NOT_FOUND);
     VerifyOrReturnError(!skid.empty() && (skid.data() != nullptr), CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(skid.size() == Crypto::kSubjectKeyIdentifierLength, CHIP_ERROR_INVALID_ARGUMENT);
 
-    for (auto candidate : mPAADerCerts)
-    {
-        uint8_t skidBuf[Crypto::kSubjectKeyIdentifierLength] = { 0 };
-        MutableByteSpan candidateSkidSpan{ skidBuf };
-        if (CHIP_NO_ERROR != Crypto::ExtractSKIDFromX509Cert(ByteSpan{ candidate.data(), candidate.size() }, candidateSkidSpan))
-        {
-            continue;
-        }
+    std::string key(reinterpret_cast<const char *>(skid.data()), skid.size());
+    auto match = mPAAIndex.find(key);
+    VerifyOrReturnError(match != mPAAIndex.end(), CHIP_ERROR_CA_CERT_NOT_FOUND);
 
-        if (skid.data_equal(candidateSkidSpan))
+    if (!match->second.mapping && MapCertificate(key, match->second) != CHIP_NO_ERROR)
+    {
+        // The certificate changed without the directory being touched (e.g. rewritten in place): re-index and
+        // try once more.
+        RefreshIndex(true /* force */);
+        match = mPAAIndex.find(key);
+        VerifyOrReturnError(match != mPAAIndex.end(), CHIP_ERROR_CA_CERT_NOT_FOUND);
+        if (!match->second.mapping)
         {
-            // Found a match
-            return CopySpanToMutableSpan(ByteSpan{ candidate.data(), candidate.size() }, outPaaDerBuffer);
+            VerifyOrReturnError(MapCertificate(key, match->second) == CHIP_NO_ERROR, CHIP_ERROR_CA_CERT_NOT_FOUND);
         }
     }
 
-    return CHIP_ERROR_CA_CERT_NOT_FOUND;
+    return CopySpanToMutableSpan(match->second.mapping->Span(), outPaaDerBuffer);
 }
 
 } // namespace Credentials
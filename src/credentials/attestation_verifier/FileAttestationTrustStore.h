@@ -20,6 +20,10 @@
 #include <credentials/attestation_verifier/DeviceAttestationVerifier.h>
 
 #include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace chip {
@@ -37,24 +41,80 @@ namespace Credentials {
  */
 std::vector<std::vector<uint8_t>> LoadAllX509DerCerts(const char * trustStorePath);
 
+/**
+ * @brief Attestation trust store backed by a directory of PAA certificates in DER format.
+ *
+ * At construction, the directory is indexed by subject key identifier (SKID). Certificates are only
+ * memory-mapped from disk the first time they are looked up, so lookups are O(1) in the number of PAAs
+ * and startup cost does not depend on certificate sizes.
+ *
+ * If an index path is provided, the SKID index is persisted there. On later startups, certificates whose
+ * file size and modification time match the persisted index are not read or parsed at all.
+ *
+ * Changes to the directory (files added, removed or renamed) are detected on lookup and only the changed
+ * files are re-indexed. Certificates are expected to be replaced atomically (write then rename), not
+ * rewritten in place.
+ *
+ * Lookups update the index, so they are serialized by an internal lock and may be made from any thread.
+ */
 class FileAttestationTrustStore : public AttestationTrustStore
 {
 public:
-    FileAttestationTrustStore(const char * paaTrustStorePath = nullptr);
+    FileAttestationTrustStore(const char * paaTrustStorePath = nullptr, const char * paaIndexPath = nullptr);
     ~FileAttestationTrustStore();
 
     CHIP_ERROR GetProductAttestationAuthorityCert(const ByteSpan & skid, MutableByteSpan & outPaaDerBuffer) const override;
 
     bool IsInitialized() const { return mIsInitialized; }
-    size_t paaCount() const { return mPAADerCerts.size(); };
-
-protected:
-    std::vector<std::vector<uint8_t>> mPAADerCerts;
+    size_t paaCount() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mPAAIndex.size();
+    };
 
 private:
-    bool mIsInitialized = false;
+    // Read-only mapping of a certificate file, established on first lookup.
+    class MappedCertificate
+    {
+    public:
+        MappedCertificate(void * data, size_t size) : mData(data), mSize(size) {}
+        ~MappedCertificate();
+
+        MappedCertificate(const MappedCertificate &)             = delete;
+        MappedCertificate & operator=(const MappedCertificate &) = delete;
+
+        ByteSpan Span() const { return ByteSpan{ static_cast<const uint8_t *>(mData), mSize }; }
+
+    private:
+        void * mData;
+        size_t mSize;
+    };
+
+    struct PAAIndexEntry
+    {
+        std::string fileName;
+        uint64_t fileSize        = 0;
+        int64_t modificationTime = 0;
+        std::unique_ptr<MappedCertificate> mapping;
+    };
+
+    // Keyed by the raw SKID bytes.
+    using PAAIndex = std::unordered_map<std::string, PAAIndexEntry>;
 
     void Cleanup();
+    bool RefreshIndex(bool force) const;
+    void LoadPersistedIndex(PAAIndex & index) const;
+    void StorePersistedIndex() const;
+    CHIP_ERROR MapCertificate(const std::string & skid, PAAIndexEntry & entry) const;
+
+    std::string mTrustStorePath;
+    std::string mIndexPath;
+    bool mIsInitialized = false;
+
+    // Lookups are const, but hot reload and lazy loading update the index, under mMutex.
+    mutable std::mutex mMutex;
+    mutable PAAIndex mPAAIndex;
+    mutable int64_t mDirectoryModificationTime = 0;
 };
 
 } // namespace Credentials
@@ -31,6 +31,7 @@
 #include <lib/support/CHIPMem.h>
 #include <lib/support/Span.h>
 #include <lib/support/UnitTestRegistration.h>
+#include <system/SystemClock.h>
 
 #include <nlunit-test.h>
 
@@ -46,6 +47,37 @@ namespace {
 static const ByteSpan kExpectedDacPublicKey = DevelopmentCerts::kDacPublicKey;
 static const ByteSpan kExpectedPaiPublicKey = DevelopmentCerts::kPaiPublicKey;
 
+const uint8_t kAttestationElementsTestVector[] = {
+    0x15, 0x30, 0x01, 0xeb, 0x30, 0x81, 0xe8, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x07, 0x02, 0xa0, 0x81,
+    0xda, 0x30, 0x81, 0xd7, 0x02, 0x01, 0x03, 0x31, 0x0d, 0x30, 0x0b, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04,
+    0x02, 0x01, 0x30, 0x45, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x07, 0x01, 0xa0, 0x38, 0x04, 0x36, 0x15,
+    0x24, 0x00, 0x01, 0x25, 0x01, 0xf1, 0xff, 0x36, 0x02, 0x05, 0x00, 0x80, 0x18, 0x25, 0x03, 0x34, 0x12, 0x2c, 0x04, 0x13,
+    0x5a, 0x49, 0x47, 0x32, 0x30, 0x31, 0x34, 0x31, 0x5a, 0x42, 0x33, 0x33, 0x30, 0x30, 0x30, 0x31, 0x2d, 0x32, 0x34, 0x24,
+    0x05, 0x00, 0x24, 0x06, 0x00, 0x25, 0x07, 0x94, 0x26, 0x24, 0x08, 0x00, 0x18, 0x31, 0x7c, 0x30, 0x7a, 0x02, 0x01, 0x03,
+    0x80, 0x14, 0x62, 0xfa, 0x82, 0x33, 0x59, 0xac, 0xfa, 0xa9, 0x96, 0x3e, 0x1c, 0xfa, 0x14, 0x0a, 0xdd, 0xf5, 0x04, 0xf3,
+    0x71, 0x60, 0x30, 0x0b, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x01, 0x30, 0x0a, 0x06, 0x08, 0x2a,
+    0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x04, 0x46, 0x30, 0x44, 0x02, 0x20, 0x43, 0xa6, 0x3f, 0x2b, 0x94, 0x3d, 0xf3,
+    0x3c, 0x38, 0xb3, 0xe0, 0x2f, 0xca, 0xa7, 0x5f, 0xe3, 0x53, 0x2a, 0xeb, 0xbf, 0x5e, 0x63, 0xf5, 0xbb, 0xdb, 0xc0, 0xb1,
+    0xf0, 0x1d, 0x3c, 0x4f, 0x60, 0x02, 0x20, 0x4c, 0x1a, 0xbf, 0x5f, 0x18, 0x07, 0xb8, 0x18, 0x94, 0xb1, 0x57, 0x6c, 0x47,
+    0xe4, 0x72, 0x4e, 0x4d, 0x96, 0x6c, 0x61, 0x2e, 0xd3, 0xfa, 0x25, 0xc1, 0x18, 0xc3, 0xf2, 0xb3, 0xf9, 0x03, 0x69, 0x30,
+    0x02, 0x20, 0xe0, 0x42, 0x1b, 0x91, 0xc6, 0xfd, 0xcd, 0xb4, 0x0e, 0x2a, 0x4d, 0x2c, 0xf3, 0x1d, 0xb2, 0xb4, 0xe1, 0x8b,
+    0x41, 0x1b, 0x1d, 0x3a, 0xd4, 0xd1, 0x2a, 0x9d, 0x90, 0xaa, 0x8e, 0x52, 0xfa, 0xe2, 0x26, 0x03, 0xfd, 0xc6, 0x5b, 0x28,
+    0xd0, 0xf1, 0xff, 0x3e, 0x00, 0x01, 0x00, 0x17, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x5f, 0x76, 0x65, 0x6e, 0x64, 0x6f,
+    0x72, 0x5f, 0x72, 0x65, 0x73, 0x65, 0x72, 0x76, 0x65, 0x64, 0x31, 0xd0, 0xf1, 0xff, 0x3e, 0x00, 0x03, 0x00, 0x18, 0x76,
+    0x65, 0x6e, 0x64, 0x6f, 0x72, 0x5f, 0x72, 0x65, 0x73, 0x65, 0x72, 0x76, 0x65, 0x64, 0x33, 0x5f, 0x65, 0x78, 0x61, 0x6d,
+    0x70, 0x6c, 0x65, 0x18
+};
+const uint8_t kAttestationChallengeTestVector[] = { 0x7a, 0x49, 0x53, 0x05, 0xd0, 0x77, 0x79, 0xa4, 0x94, 0xdd, 0x39, 0xa0, 0x85,
+                                                    0x1b, 0x66, 0x0d };
+const uint8_t kAttestationSignatureTestVector[] = { 0x79, 0x82, 0x53, 0x5d, 0x24, 0xcf, 0xe1, 0x4a, 0x71, 0xab, 0x04, 0x24, 0xcf,
+                                                    0x0b, 0xac, 0xf1, 0xe3, 0x45, 0x48, 0x7e, 0xd5, 0x0f, 0x1a, 0xc0, 0xbc, 0x25,
+                                                    0x9e, 0xcc, 0xfb, 0x39, 0x08, 0x1e, 0x61, 0xa9, 0x26, 0x7e, 0x74, 0xf8, 0x55,
+                                                    0xda, 0x53, 0x63, 0x83, 0x74, 0xa0, 0x16, 0x71, 0xcf, 0x3d, 0x7d, 0xb8, 0xcc,
+                                                    0x17, 0x0b, 0x38, 0x03, 0x45, 0xe6, 0x0b, 0xc8, 0x6f, 0xdf, 0x45, 0x9e };
+const uint8_t kAttestationNonceTestVector[]     = { 0xe0, 0x42, 0x1b, 0x91, 0xc6, 0xfd, 0xcd, 0xb4, 0x0e, 0x2a, 0x4d, 0x2c, 0xf3,
+                                                    0x1d, 0xb2, 0xb4, 0xe1, 0x8b, 0x41, 0x1b, 0x1d, 0x3a, 0xd4, 0xd1, 0x2a, 0x9d,
+                                                    0x90, 0xaa, 0x8e, 0x52, 0xfa, 0xe2 };
+
 } // namespace
 
 static void TestDACProvidersExample_Providers(nlTestSuite * inSuite, void * inContext)
@@ -158,37 +190,6 @@ static void OnAttestationInformationVerificationCallback(void * context, const D
 
 static void TestDACVerifierExample_AttestationInfoVerification(nlTestSuite * inSuite, void * inContext)
 {
-    uint8_t attestationElementsTestVector[] = {
-        0x15, 0x30, 0x01, 0xeb, 0x30, 0x81, 0xe8, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x07, 0x02, 0xa0, 0x81,
-        0xda, 0x30, 0x81, 0xd7, 0x02, 0x01, 0x03, 0x31, 0x0d, 0x30, 0x0b, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04,
-        0x02, 0x01, 0x30, 0x45, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x07, 0x01, 0xa0, 0x38, 0x04, 0x36, 0x15,
-        0x24, 0x00, 0x01, 0x25, 0x01, 0xf1, 0xff, 0x36, 0x02, 0x05, 0x00, 0x80, 0x18, 0x25, 0x03, 0x34, 0x12, 0x2c, 0x04, 0x13,
-        0x5a, 0x49, 0x47, 0x32, 0x30, 0x31, 0x34, 0x31, 0x5a, 0x42, 0x33, 0x33, 0x30, 0x30, 0x30, 0x31, 0x2d, 0x32, 0x34, 0x24,
-        0x05, 0x00, 0x24, 0x06, 0x00, 0x25, 0x07, 0x94, 0x26, 0x24, 0x08, 0x00, 0x18, 0x31, 0x7c, 0x30, 0x7a, 0x02, 0x01, 0x03,
-        0x80, 0x14, 0x62, 0xfa, 0x82, 0x33, 0x59, 0xac, 0xfa, 0xa9, 0x96, 0x3e, 0x1c, 0xfa, 0x14, 0x0a, 0xdd, 0xf5, 0x04, 0xf3,
-        0x71, 0x60, 0x30, 0x0b, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x01, 0x30, 0x0a, 0x06, 0x08, 0x2a,
-        0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x04, 0x46, 0x30, 0x44, 0x02, 0x20, 0x43, 0xa6, 0x3f, 0x2b, 0x94, 0x3d, 0xf3,
-        0x3c, 0x38, 0xb3, 0xe0, 0x2f, 0xca, 0xa7, 0x5f, 0xe3, 0x53, 0x2a, 0xeb, 0xbf, 0x5e, 0x63, 0xf5, 0xbb, 0xdb, 0xc0, 0xb1,
-        0xf0, 0x1d, 0x3c, 0x4f, 0x60, 0x02, 0x20, 0x4c, 0x1a, 0xbf, 0x5f, 0x18, 0x07, 0xb8, 0x18, 0x94, 0xb1, 0x57, 0x6c, 0x47,
-        0xe4, 0x72, 0x4e, 0x4d, 0x96, 0x6c, 0x61, 0x2e, 0xd3, 0xfa, 0x25, 0xc1, 0x18, 0xc3, 0xf2, 0xb3, 0xf9, 0x03, 0x69, 0x30,
-        0x02, 0x20, 0xe0, 0x42, 0x1b, 0x91, 0xc6, 0xfd, 0xcd, 0xb4, 0x0e, 0x2a, 0x4d, 0x2c, 0xf3, 0x1d, 0xb2, 0xb4, 0xe1, 0x8b,
-        0x41, 0x1b, 0x1d, 0x3a, 0xd4, 0xd1, 0x2a, 0x9d, 0x90, 0xaa, 0x8e, 0x52, 0xfa, 0xe2, 0x26, 0x03, 0xfd, 0xc6, 0x5b, 0x28,
-        0xd0, 0xf1, 0xff, 0x3e, 0x00, 0x01, 0x00, 0x17, 0x73, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x5f, 0x76, 0x65, 0x6e, 0x64, 0x6f,
-        0x72, 0x5f, 0x72, 0x65, 0x73, 0x65, 0x72, 0x76, 0x65, 0x64, 0x31, 0xd0, 0xf1, 0xff, 0x3e, 0x00, 0x03, 0x00, 0x18, 0x76,
-        0x65, 0x6e, 0x64, 0x6f, 0x72, 0x5f, 0x72, 0x65, 0x73, 0x65, 0x72, 0x76, 0x65, 0x64, 0x33, 0x5f, 0x65, 0x78, 0x61, 0x6d,
-        0x70, 0x6c, 0x65, 0x18
-    };
-    uint8_t attestationChallengeTestVector[] = { 0x7a, 0x49, 0x53, 0x05, 0xd0, 0x77, 0x79, 0xa4,
-                                                 0x94, 0xdd, 0x39, 0xa0, 0x85, 0x1b, 0x66, 0x0d };
-    uint8_t attestationSignatureTestVector[] = { 0x79, 0x82, 0x53, 0x5d, 0x24, 0xcf, 0xe1, 0x4a, 0x71, 0xab, 0x04, 0x24, 0xcf,
-                                                 0x0b, 0xac, 0xf1, 0xe3, 0x45, 0x48, 0x7e, 0xd5, 0x0f, 0x1a, 0xc0, 0xbc, 0x25,
-                                                 0x9e, 0xcc, 0xfb, 0x39, 0x08, 0x1e, 0x61, 0xa9, 0x26, 0x7e, 0x74, 0xf8, 0x55,
-                                                 0xda, 0x53, 0x63, 0x83, 0x74, 0xa0, 0x16, 0x71, 0xcf, 0x3d, 0x7d, 0xb8, 0xcc,
-                                                 0x17, 0x0b, 0x38, 0x03, 0x45, 0xe6, 0x0b, 0xc8, 0x6f, 0xdf, 0x45, 0x9e };
-    uint8_t attestationNonceTestVector[]     = { 0xe0, 0x42, 0x1b, 0x91, 0xc6, 0xfd, 0xcd, 0xb4, 0x0e, 0x2a, 0x4d,
-                                                 0x2c, 0xf3, 0x1d, 0xb2, 0xb4, 0xe1, 0x8b, 0x41, 0x1b, 0x1d, 0x3a,
-                                                 0xd4, 0xd1, 0x2a, 0x9d, 0x90, 0xaa, 0x8e, 0x52, 0xfa, 0xe2 };
-
     // Make sure default verifier exists and is not implemented on at least one method
     DeviceAttestationVerifier * default_verifier = GetDeviceAttestationVerifier();
     NL_TEST_ASSERT(inSuite, default_verifier != nullptr);
@@ -211,14 +212,106 @@ static void TestDACVerifierExample_AttestationInfoVerification(nlTestSuite * inS
         OnAttestationInformationVerificationCallback, &attestationResult);
 
     Credentials::DeviceAttestationVerifier::AttestationInfo info(
-        ByteSpan(attestationElementsTestVector), ByteSpan(attestationChallengeTestVector), ByteSpan(attestationSignatureTestVector),
-        TestCerts::sTestCert_PAI_FFF1_8000_Cert, TestCerts::sTestCert_DAC_FFF1_8000_0004_Cert, ByteSpan(attestationNonceTestVector),
-        static_cast<VendorId>(0xFFF1), 0x8000);
+        ByteSpan(kAttestationElementsTestVector), ByteSpan(kAttestationChallengeTestVector),
+        ByteSpan(kAttestationSignatureTestVector), TestCerts::sTestCert_PAI_FFF1_8000_Cert,
+        TestCerts::sTestCert_DAC_FFF1_8000_0004_Cert, ByteSpan(kAttestationNonceTestVector), static_cast<VendorId>(0xFFF1), 0x8000);
     default_verifier->VerifyAttestationInformation(info, &attestationInformationVerificationCallback);
 
     NL_TEST_ASSERT(inSuite, attestationResult == AttestationVerificationResult::kSuccess);
 }
 
+struct BatchVerificationResults
+{
+    size_t successCount                       = 0;
+    size_t failureCount                       = 0;
+    AttestationVerificationResult lastFailure = AttestationVerificationResult::kSuccess;
+};
+
+static void OnBatchVerificationCallback(void * context, const DeviceAttestationVerifier::AttestationInfo & info,
+                                        AttestationVerificationResult result)
+{
+    BatchVerificationResults * results = reinterpret_cast<BatchVerificationResults *>(context);
+    if (result == AttestationVerificationResult::kSuccess)
+    {
+        results->successCount++;
+    }
+    else
+    {
+        results->failureCount++;
+        results->lastFailure = result;
+    }
+}
+
+static void TestDACVerifierExample_VerificationCache(nlTestSuite * inSuite, void * inContext)
+{
+    DefaultDACVerifier verifier(GetTestAttestationTrustStore());
+
+    AttestationVerificationResult attestationResult = AttestationVerificationResult::kNotImplemented;
+    Callback::Callback<DeviceAttestationVerifier::OnAttestationInformationVerification> attestationInformationVerificationCallback(
+        OnAttestationInformationVerificationCallback, &attestationResult);
+
+    uint8_t wrongNonce[sizeof(kAttestationNonceTestVector)];
+    memcpy(wrongNonce, kAttestationNonceTestVector, sizeof(wrongNonce));
+    wrongNonce[0] ^= 0xFF;
+
+    DeviceAttestationVerifier::AttestationInfo info(
+        ByteSpan(kAttestationElementsTestVector), ByteSpan(kAttestationChallengeTestVector),
+        ByteSpan(kAttestationSignatureTestVector), TestCerts::sTestCert_PAI_FFF1_8000_Cert,
+        TestCerts::sTestCert_DAC_FFF1_8000_0004_Cert, ByteSpan(kAttestationNonceTestVector), static_cast<VendorId>(0xFFF1), 0x8000);
+    DeviceAttestationVerifier::AttestationInfo wrongNonceInfo(
+        ByteSpan(kAttestationElementsTestVector), ByteSpan(kAttestationChallengeTestVector),
+        ByteSpan(kAttestationSignatureTestVector), TestCerts::sTestCert_PAI_FFF1_8000_Cert,
+        TestCerts::sTestCert_DAC_FFF1_8000_0004_Cert, ByteSpan(wrongNonce), static_cast<VendorId>(0xFFF1), 0x8000);
+
+    // Commissioning throughput with and without cached PAI chain and CD verification results.
+    constexpr size_t kCommissioningCount = 50;
+    uint64_t start                       = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (size_t i = 0; i < kCommissioningCount; i++)
+    {
+        verifier.ClearVerificationCache();
+        attestationResult = AttestationVerificationResult::kNotImplemented;
+        verifier.VerifyAttestationInformation(info, &attestationInformationVerificationCallback);
+        NL_TEST_ASSERT(inSuite, attestationResult == AttestationVerificationResult::kSuccess);
+    }
+    uint64_t uncachedDuration = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+
+    start = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (size_t i = 0; i < kCommissioningCount; i++)
+    {
+        attestationResult = AttestationVerificationResult::kNotImplemented;
+        verifier.VerifyAttestationInformation(info, &attestationInformationVerificationCallback);
+        NL_TEST_ASSERT(inSuite, attestationResult == AttestationVerificationResult::kSuccess);
+    }
+    uint64_t cachedDuration = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+
+    ChipLogProgress(Crypto, "%u attestation verifications: %u us without cache, %u us with cache",
+                    static_cast<unsigned>(kCommissioningCount), static_cast<unsigned>(uncachedDuration),
+                    static_cast<unsigned>(cachedDuration));
+
+    // Checks that depend on the device are still done when the PAI chain and CD are cached.
+    attestationResult = AttestationVerificationResult::kNotImplemented;
+    verifier.VerifyAttestationInformation(wrongNonceInfo, &attestationInformationVerificationCallback);
+    NL_TEST_ASSERT(inSuite, attestationResult == AttestationVerificationResult::kAttestationNonceMismatch);
+
+    // A cached CD signed with the test key is rejected once test key support gets disabled.
+    verifier.EnableCdTestKeySupport(false);
+    attestationResult = AttestationVerificationResult::kNotImplemented;
+    verifier.VerifyAttestationInformation(info, &attestationInformationVerificationCallback);
+    NL_TEST_ASSERT(inSuite, attestationResult == AttestationVerificationResult::kCertificationDeclarationNoCertificateFound);
+    verifier.EnableCdTestKeySupport(true);
+
+    // Batched verification reports a result for each entry.
+    verifier.ClearVerificationCache();
+    const DeviceAttestationVerifier::AttestationInfo infos[] = { info, wrongNonceInfo, info, info };
+    BatchVerificationResults batchResults;
+    Callback::Callback<DeviceAttestationVerifier::OnAttestationInformationVerification> batchCallback(OnBatchVerificationCallback,
+                                                                                                      &batchResults);
+    verifier.VerifyAttestationInformationBatch(Span<const DeviceAttestationVerifier::AttestationInfo>(infos), &batchCallback);
+    NL_TEST_ASSERT(inSuite, batchResults.successCount == 3);
+    NL_TEST_ASSERT(inSuite, batchResults.failureCount == 1);
+    NL_TEST_ASSERT(inSuite, batchResults.lastFailure == AttestationVerificationResult::kAttestationNonceMismatch);
+}
+
 static void TestDACVerifierExample_CertDeclarationVerification(nlTestSuite * inSuite, void * inContext)
 {
     // -> format_version = 1
@@ -441,6 +534,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test the 'for testing' Paa Root Store", TestAttestationTrustStore),
     NL_TEST_DEF("Test Example Device Attestation Information Verification", TestDACVerifierExample_AttestationInfoVerification),
     NL_TEST_DEF("Test Example Device Attestation Certification Declaration Verification", TestDACVerifierExample_CertDeclarationVerification),
+    NL_TEST_DEF("Test Device Attestation Verification Cache", TestDACVerifierExample_VerificationCache),
     NL_TEST_DEF("Test Example Device Attestation Node Operational CSR Information Verification", TestDACVerifierExample_NocsrInformationVerification),
     NL_TEST_SENTINEL()
 };
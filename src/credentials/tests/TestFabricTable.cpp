@@ -39,6 +39,7 @@
 #include <lib/support/UnitTestExtendedAssertions.h>
 #include <lib/support/UnitTestRegistration.h>
 #include <platform/ConfigurationManager.h>
+#include <system/SystemClock.h>
 
 #include <lib/support/BytesToHex.h>
 
@@ -2401,6 +2402,121 @@ void TestFabricLookup(nlTestSuite * inSuite, void * inContext)
     }
 }
 
+void TestFabricLookupScale(nlTestSuite * inSuite, void * inContext)
+{
+    // Fills the fabric table and exercises every lookup flavor, reporting the time taken,
+    // then validates that lookups stay consistent as fabrics are removed and re-added.
+    constexpr size_t kLookupRounds   = 1000;
+    constexpr uint16_t kVendorId     = 0xFFF1u;
+    constexpr FabricId kFabricIdBase = 0x1000;
+    constexpr NodeId kNodeIdBase     = 0x4000;
+
+    Credentials::TestOnlyLocalCertificateAuthority fabricCertAuthority;
+    NL_TEST_ASSERT(inSuite, fabricCertAuthority.Init().IsSuccess());
+
+    chip::TestPersistentStorageDelegate storage;
+    ScopedFabricTable fabricTableHolder;
+    NL_TEST_ASSERT(inSuite, fabricTableHolder.Init(&storage) == CHIP_NO_ERROR);
+    FabricTable & fabricTable = fabricTableHolder.GetFabricTable();
+
+    auto addFabric = [&](FabricId fabricId, NodeId nodeId) -> FabricIndex {
+        uint8_t csrBuf[chip::Crypto::kMIN_CSR_Buffer_Size];
+        MutableByteSpan csrSpan{ csrBuf };
+        NL_TEST_ASSERT_SUCCESS(inSuite, fabricTable.AllocatePendingOperationalKey(chip::NullOptional, csrSpan));
+        NL_TEST_ASSERT_SUCCESS(inSuite, fabricCertAuthority.GenerateNocChain(fabricId, nodeId, csrSpan).GetStatus());
+
+        FabricIndex newFabricIndex = kUndefinedFabricIndex;
+        NL_TEST_ASSERT_SUCCESS(inSuite, fabricTable.AddNewPendingTrustedRootCert(fabricCertAuthority.GetRcac()));
+        NL_TEST_ASSERT_SUCCESS(inSuite,
+                               fabricTable.AddNewPendingFabricWithOperationalKeystore(
+                                   fabricCertAuthority.GetNoc(), fabricCertAuthority.GetIcac(), kVendorId, &newFabricIndex));
+        NL_TEST_ASSERT_SUCCESS(inSuite, fabricTable.CommitPendingFabricData());
+        return newFabricIndex;
+    };
+
+    FabricIndex fabricIndices[CHIP_CONFIG_MAX_FABRICS];
+    for (size_t i = 0; i < CHIP_CONFIG_MAX_FABRICS; ++i)
+    {
+        fabricIndices[i] = addFabric(kFabricIdBase + i, kNodeIdBase + i);
+    }
+    NL_TEST_ASSERT_EQUALS(inSuite, fabricTable.FabricCount(), CHIP_CONFIG_MAX_FABRICS);
+
+    Crypto::P256PublicKey rootPubKey;
+    NL_TEST_ASSERT_SUCCESS(inSuite, fabricTable.FetchRootPubkey(fabricIndices[0], rootPubKey));
+
+    // Collected by iterating the table, so that it does not depend on the lookups under test.
+    auto getCompressedFabricId = [&](FabricIndex fabricIndex) -> CompressedFabricId {
+        for (const auto & fabricInfo : fabricTable)
+        {
+            if (fabricInfo.GetFabricIndex() == fabricIndex)
+            {
+                return fabricInfo.GetCompressedFabricId();
+            }
+        }
+        return kUndefinedCompressedFabricId;
+    };
+
+    CompressedFabricId compressedFabricIds[CHIP_CONFIG_MAX_FABRICS];
+    for (size_t i = 0; i < CHIP_CONFIG_MAX_FABRICS; ++i)
+    {
+        compressedFabricIds[i] = getCompressedFabricId(fabricIndices[i]);
+    }
+
+    // Validates that all lookups for the i-th fabric agree, or all fail if it is not expected to be present.
+    auto checkLookups = [&](size_t i, bool expectPresent) {
+        const FabricInfo * byIndex        = fabricTable.FindFabricWithIndex(fabricIndices[i]);
+        const FabricInfo * byCompressedId = fabricTable.FindFabricWithCompressedId(compressedFabricIds[i]);
+        const FabricInfo * byRootAndId    = fabricTable.FindFabric(rootPubKey, kFabricIdBase + i);
+        const FabricInfo * byIdentity     = fabricTable.FindIdentity(rootPubKey, kFabricIdBase + i, kNodeIdBase + i);
+
+        if (!expectPresent)
+        {
+            return (byIndex == nullptr) && (byCompressedId == nullptr) && (byRootAndId == nullptr) && (byIdentity == nullptr);
+        }
+
+        return (byIndex != nullptr) && (byIndex->GetFabricIndex() == fabricIndices[i]) && (byCompressedId == byIndex) &&
+            (byRootAndId == byIndex) && (byIdentity == byIndex) && (byIndex->GetNodeId() == kNodeIdBase + i);
+    };
+
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    size_t numMismatches                = 0;
+    for (size_t round = 0; round < kLookupRounds; ++round)
+    {
+        for (size_t i = 0; i < CHIP_CONFIG_MAX_FABRICS; ++i)
+        {
+            numMismatches += checkLookups(i, /* expectPresent = */ true) ? 0 : 1;
+        }
+    }
+    System::Clock::Microseconds64 elapsed = System::SystemClock().GetMonotonicMicroseconds64() - start;
+    NL_TEST_ASSERT_EQUALS(inSuite, numMismatches, 0u);
+
+    ChipLogProgress(FabricProvisioning, "%u rounds of 4 lookups over %u fabrics took %u us",
+                    static_cast<unsigned>(kLookupRounds), static_cast<unsigned>(CHIP_CONFIG_MAX_FABRICS),
+                    static_cast<unsigned>(elapsed.count()));
+
+    // Unknown keys must not match anything.
+    NL_TEST_ASSERT(inSuite, fabricTable.FindFabricWithIndex(kUndefinedFabricIndex) == nullptr);
+    NL_TEST_ASSERT(inSuite, fabricTable.FindFabric(rootPubKey, kFabricIdBase + CHIP_CONFIG_MAX_FABRICS) == nullptr);
+    NL_TEST_ASSERT(inSuite,
+                   fabricTable.FindIdentity(rootPubKey, kFabricIdBase, kNodeIdBase + CHIP_CONFIG_MAX_FABRICS) == nullptr);
+
+    // Remove a fabric from the middle of the table: only its lookups must start failing.
+    constexpr size_t kRemovedPosition = CHIP_CONFIG_MAX_FABRICS / 2;
+    NL_TEST_ASSERT_SUCCESS(inSuite, fabricTable.Delete(fabricIndices[kRemovedPosition]));
+    for (size_t i = 0; i < CHIP_CONFIG_MAX_FABRICS; ++i)
+    {
+        NL_TEST_ASSERT(inSuite, checkLookups(i, /* expectPresent = */ i != kRemovedPosition));
+    }
+
+    // Adding it back (at a new fabric index) makes it reachable again through every lookup.
+    fabricIndices[kRemovedPosition] = addFabric(kFabricIdBase + kRemovedPosition, kNodeIdBase + kRemovedPosition);
+    compressedFabricIds[kRemovedPosition] = getCompressedFabricId(fabricIndices[kRemovedPosition]);
+    for (size_t i = 0; i < CHIP_CONFIG_MAX_FABRICS; ++i)
+    {
+        NL_TEST_ASSERT(inSuite, checkLookups(i, /* expectPresent = */ true));
+    }
+}
+
 void TestFetchCATs(nlTestSuite * inSuite, void * inContext)
 {
     // Initialize a fabric table.
@@ -3018,6 +3134,7 @@ static const nlTest sTests[] =
     NL_TEST_DEF("Test fabric label changes", TestFabricLabelChange),
     NL_TEST_DEF("Test compressed fabric ID is properly generated", TestCompressedFabricId),
     NL_TEST_DEF("Test fabric lookup by <root public key, fabric ID>", TestFabricLookup),
+    NL_TEST_DEF("Test fabric lookups on a full fabric table", TestFabricLookupScale),
     NL_TEST_DEF("Test Fetching CATs", TestFetchCATs),
     NL_TEST_DEF("Test AddNOC root collision", TestAddNocRootCollision),
     NL_TEST_DEF("Test invalid chaining in AddNOC and UpdateNOC", TestInvalidChaining),
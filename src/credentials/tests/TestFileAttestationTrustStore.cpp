@@ -0,0 +1,298 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <crypto/CHIPCryptoPAL.h>
+
+#include <credentials/attestation_verifier/FileAttestationTrustStore.h>
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/Span.h>
+#include <lib/support/UnitTestExtendedAssertions.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <system/SystemClock.h>
+
+#include <nlunit-test.h>
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Crypto;
+using namespace chip::Credentials;
+
+namespace {
+
+bool CopyFile(const std::string & from, const std::string & to)
+{
+    FILE * in = fopen(from.c_str(), "rb");
+    if (in == nullptr)
+    {
+        return false;
+    }
+    FILE * out = fopen(to.c_str(), "wb");
+    if (out == nullptr)
+    {
+        fclose(in);
+        return false;
+    }
+
+    bool success = true;
+    uint8_t buf[512];
+    size_t len;
+    while ((len = fread(buf, 1, sizeof(buf), in)) > 0)
+    {
+        success = success && (fwrite(buf, 1, len, out) == len);
+    }
+    fclose(in);
+    return (fclose(out) == 0) && success;
+}
+
+std::vector<std::string> ListDerFiles(const std::string & dirPath)
+{
+    std::vector<std::string> names;
+    DIR * dir = opendir(dirPath.c_str());
+    if (dir == nullptr)
+    {
+        return names;
+    }
+
+    dirent * entry;
+    while ((entry = readdir(dir)) != nullptr)
+    {
+        std::string name(entry->d_name);
+        if (name.size() > 4 && name.compare(name.size() - 4, 4, ".der") == 0)
+        {
+            names.push_back(name);
+        }
+    }
+    closedir(dir);
+    return names;
+}
+
+uint64_t NowMicroseconds()
+{
+    return System::SystemClock().GetMonotonicMicroseconds64().count();
+}
+
+void TestPAALookups(nlTestSuite * inSuite, void * inContext)
+{
+    std::string sourcePath("../../../../../credentials/production/paa-root-certs");
+    DIR * sourceDir = opendir(sourcePath.c_str());
+    while (sourceDir == nullptr && (sourcePath.find("../") == 0))
+    {
+        sourcePath = sourcePath.substr(3);
+        sourceDir  = opendir(sourcePath.c_str());
+    }
+    if (sourceDir == nullptr)
+    {
+        ChipLogError(Crypto, "Couldn't open folder with production PAA certificates.");
+        return;
+    }
+    closedir(sourceDir);
+
+    // Work on a copy of the certificates, so that the directory can be modified.
+    char trustStorePathBuf[] = "/tmp/chip-paa-store-XXXXXX";
+    NL_TEST_ASSERT(inSuite, mkdtemp(trustStorePathBuf) != nullptr);
+    std::string trustStorePath(trustStorePathBuf);
+    std::string indexPath = trustStorePath + ".index";
+
+    std::vector<std::string> fileNames = ListDerFiles(sourcePath);
+    for (const auto & name : fileNames)
+    {
+        NL_TEST_ASSERT(inSuite, CopyFile(sourcePath + "/" + name, trustStorePath + "/" + name));
+    }
+
+    std::vector<std::vector<uint8_t>> expectedCerts = LoadAllX509DerCerts(trustStorePath.c_str());
+    NL_TEST_ASSERT(inSuite, !expectedCerts.empty());
+
+    std::vector<std::vector<uint8_t>> skids;
+    for (const auto & cert : expectedCerts)
+    {
+        uint8_t skidBuf[kSubjectKeyIdentifierLength];
+        MutableByteSpan skidSpan{ skidBuf };
+        NL_TEST_ASSERT_SUCCESS(inSuite, ExtractSKIDFromX509Cert(ByteSpan{ cert.data(), cert.size() }, skidSpan));
+        skids.emplace_back(skidSpan.data(), skidSpan.data() + skidSpan.size());
+    }
+
+    auto checkAllLookups = [&](const FileAttestationTrustStore & store) {
+        for (size_t i = 0; i < expectedCerts.size(); i++)
+        {
+            uint8_t paaBuf[kMaxDERCertLength];
+            MutableByteSpan paaSpan{ paaBuf };
+            NL_TEST_ASSERT_SUCCESS(inSuite,
+                                   store.GetProductAttestationAuthorityCert(ByteSpan{ skids[i].data(), skids[i].size() }, paaSpan));
+            NL_TEST_ASSERT(inSuite, paaSpan.data_equal(ByteSpan{ expectedCerts[i].data(), expectedCerts[i].size() }));
+        }
+    };
+
+    // Cold start: every certificate is parsed and the index gets persisted.
+    uint64_t start = NowMicroseconds();
+    FileAttestationTrustStore coldStore(trustStorePath.c_str(), indexPath.c_str());
+    uint64_t coldStartup = NowMicroseconds() - start;
+    NL_TEST_ASSERT(inSuite, coldStore.IsInitialized());
+    NL_TEST_ASSERT(inSuite, coldStore.paaCount() == expectedCerts.size());
+    NL_TEST_ASSERT(inSuite, access(indexPath.c_str(), R_OK) == 0);
+
+    // Warm start: the persisted index is reused and no certificate is read until looked up.
+    start = NowMicroseconds();
+    FileAttestationTrustStore warmStore(trustStorePath.c_str(), indexPath.c_str());
+    uint64_t warmStartup = NowMicroseconds() - start;
+    NL_TEST_ASSERT(inSuite, warmStore.IsInitialized());
+    NL_TEST_ASSERT(inSuite, warmStore.paaCount() == expectedCerts.size());
+
+    start = NowMicroseconds();
+    checkAllLookups(warmStore);
+    uint64_t firstLookups = NowMicroseconds() - start;
+
+    start = NowMicroseconds();
+    checkAllLookups(warmStore);
+    uint64_t cachedLookups = NowMicroseconds() - start;
+
+    checkAllLookups(coldStore);
+
+    ChipLogProgress(Crypto, "%u PAAs: cold startup %u us, warm startup %u us, first lookups %u us, cached lookups %u us",
+                    static_cast<unsigned>(expectedCerts.size()), static_cast<unsigned>(coldStartup),
+                    static_cast<unsigned>(warmStartup), static_cast<unsigned>(firstLookups), static_cast<unsigned>(cachedLookups));
+
+    // Unknown and malformed SKIDs.
+    {
+        uint8_t unknownSkid[kSubjectKeyIdentifierLength] = { 0 };
+        uint8_t paaBuf[kMaxDERCertLength];
+        MutableByteSpan paaSpan{ paaBuf };
+        NL_TEST_ASSERT(inSuite, warmStore.GetProductAttestationAuthorityCert(ByteSpan{ unknownSkid }, paaSpan) ==
+                           CHIP_ERROR_CA_CERT_NOT_FOUND);
+        NL_TEST_ASSERT(inSuite, warmStore.GetProductAttestationAuthorityCert(ByteSpan{ unknownSkid, 4 }, paaSpan) ==
+                           CHIP_ERROR_INVALID_ARGUMENT);
+    }
+
+    // Hot reload: removing a certificate from the directory and adding it back is picked up on lookup.
+    {
+        std::string removedPath;
+        size_t removedIndex = expectedCerts.size();
+        for (const auto & name : fileNames)
+        {
+            std::vector<uint8_t> fileContents;
+            FILE * file = fopen((trustStorePath + "/" + name).c_str(), "rb");
+            NL_TEST_ASSERT(inSuite, file != nullptr);
+            fileContents.resize(kMaxDERCertLength + 1);
+            fileContents.resize(fread(fileContents.data(), 1, fileContents.size(), file));
+            fclose(file);
+
+            for (size_t i = 0; i < expectedCerts.size(); i++)
+            {
+                if (expectedCerts[i] == fileContents)
+                {
+                    removedPath  = trustStorePath + "/" + name;
+                    removedIndex = i;
+                }
+            }
+            if (!removedPath.empty())
+            {
+                break;
+            }
+        }
+        NL_TEST_ASSERT(inSuite, removedIndex < expectedCerts.size());
+
+        ByteSpan removedSkid{ skids[removedIndex].data(), skids[removedIndex].size() };
+        uint8_t paaBuf[kMaxDERCertLength];
+        MutableByteSpan paaSpan{ paaBuf };
+
+        std::string savedPath = trustStorePath + ".saved";
+        NL_TEST_ASSERT(inSuite, rename(removedPath.c_str(), savedPath.c_str()) == 0);
+        NL_TEST_ASSERT(inSuite, warmStore.GetProductAttestationAuthorityCert(removedSkid, paaSpan) == CHIP_ERROR_CA_CERT_NOT_FOUND);
+        NL_TEST_ASSERT(inSuite, warmStore.paaCount() == expectedCerts.size() - 1);
+
+        NL_TEST_ASSERT(inSuite, rename(savedPath.c_str(), removedPath.c_str()) == 0);
+        paaSpan = MutableByteSpan{ paaBuf };
+        NL_TEST_ASSERT_SUCCESS(inSuite, warmStore.GetProductAttestationAuthorityCert(removedSkid, paaSpan));
+        NL_TEST_ASSERT(inSuite,
+                       paaSpan.data_equal(ByteSpan{ expectedCerts[removedIndex].data(), expectedCerts[removedIndex].size() }));
+        NL_TEST_ASSERT(inSuite, warmStore.paaCount() == expectedCerts.size());
+    }
+
+    for (const auto & name : fileNames)
+    {
+        unlink((trustStorePath + "/" + name).c_str());
+    }
+    rmdir(trustStorePath.c_str());
+    unlink(indexPath.c_str());
+}
+
+void TestUninitializedStore(nlTestSuite * inSuite, void * inContext)
+{
+    FileAttestationTrustStore store;
+    NL_TEST_ASSERT(inSuite, !store.IsInitialized());
+    NL_TEST_ASSERT(inSuite, store.paaCount() == 0);
+
+    uint8_t skid[kSubjectKeyIdentifierLength] = { 0 };
+    uint8_t paaBuf[kMaxDERCertLength];
+    MutableByteSpan paaSpan{ paaBuf };
+    NL_TEST_ASSERT(inSuite, store.GetProductAttestationAuthorityCert(ByteSpan{ skid }, paaSpan) == CHIP_ERROR_CA_CERT_NOT_FOUND);
+}
+
+int TestFileAttestationTrustStore_Setup(void * inContext)
+{
+    CHIP_ERROR error = chip::Platform::MemoryInit();
+
+    if (error != CHIP_NO_ERROR)
+    {
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+int TestFileAttestationTrustStore_Teardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+// clang-format off
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Test PAA lookups, index persistence and hot reload", TestPAALookups),
+    NL_TEST_DEF("Test uninitialized trust store", TestUninitializedStore),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestFileAttestationTrustStore()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "File Attestation Trust Store",
+        &sTests[0],
+        TestFileAttestationTrustStore_Setup,
+        TestFileAttestationTrustStore_Teardown
+    };
+    // clang-format on
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestFileAttestationTrustStore);
@@ -160,6 +160,25 @@ public:
 };
 static TestListener sListener;
 
+// Session keystore that counts the keys it creates and can be made to run out of key slots.
+class TestSessionKeystore : public chip::Crypto::DefaultSessionKeystore
+{
+public:
+    using chip::Crypto::DefaultSessionKeystore::CreateKey;
+
+    size_t created_count = 0;
+    bool out_of_slots    = false;
+
+    CHIP_ERROR CreateKey(const chip::Crypto::Symmetric128BitsKeyByteArray & keyMaterial,
+                         chip::Crypto::Aes128KeyHandle & key) override
+    {
+        VerifyOrReturnError(!out_of_slots, CHIP_ERROR_INTERNAL);
+        created_count++;
+        return chip::Crypto::DefaultSessionKeystore::CreateKey(keyMaterial, key);
+    }
+};
+static TestSessionKeystore sSessionKeystore;
+
 void ResetProvider(GroupDataProvider * provider)
 {
     provider->RemoveFabric(kFabric1);
@@ -1196,6 +1215,105 @@ void TestGroupDecryption(nlTestSuite * apSuite, void * apContext)
     }
 }
 
+static size_t CountGroupSessions(GroupDataProvider * provider, uint16_t session_id, GroupId group_id)
+{
+    size_t count = 0;
+    GroupSession session;
+    auto it = provider->IterateGroupSessions(session_id);
+    VerifyOrReturnValue(it != nullptr, 0);
+    while (it->Next(session))
+    {
+        if (session.group_id == group_id && session.keyContext != nullptr)
+        {
+            count++;
+        }
+    }
+    it->Release();
+    return count;
+}
+
+void TestGroupSessionCache(nlTestSuite * apSuite, void * apContext)
+{
+    GroupDataProvider * provider = GetGroupDataProvider();
+
+    // Start from a clean slate
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->RemoveFabric(kFabric1));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->RemoveFabric(kFabric2));
+
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet3));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric1, 0, kGroup1Keyset3));
+
+    Crypto::SymmetricKeyContext * key_context = provider->GetKeyContext(kFabric1, kGroup1);
+    NL_TEST_ASSERT(apSuite, nullptr != key_context);
+    VerifyOrReturn(nullptr != key_context);
+    uint16_t session_id = key_context->GetKeyHash();
+    key_context->Release();
+
+    NL_TEST_ASSERT(apSuite, 1 == CountGroupSessions(provider, session_id, kGroup1));
+    NL_TEST_ASSERT(apSuite, 0 == CountGroupSessions(provider, session_id, kGroup3));
+
+    // New mappings are seen by the next lookup
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric1, 1, kGroup3Keyset3));
+    NL_TEST_ASSERT(apSuite, 1 == CountGroupSessions(provider, session_id, kGroup1));
+    NL_TEST_ASSERT(apSuite, 1 == CountGroupSessions(provider, session_id, kGroup3));
+
+    // Iterations started before a change end early instead of returning stale sessions
+    GroupSession session;
+    auto it = provider->IterateGroupSessions(session_id);
+    NL_TEST_ASSERT(apSuite, it != nullptr);
+    if (it)
+    {
+        NL_TEST_ASSERT(apSuite, it->Next(session));
+        NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->RemoveGroupKeyAt(kFabric1, 1));
+        while (it->Next(session))
+        {
+            NL_TEST_ASSERT(apSuite, session.group_id != kGroup3);
+        }
+        it->Release();
+    }
+    NL_TEST_ASSERT(apSuite, 1 == CountGroupSessions(provider, session_id, kGroup1));
+    NL_TEST_ASSERT(apSuite, 0 == CountGroupSessions(provider, session_id, kGroup3));
+
+    // More group sessions than fit in the cache are still all found
+    const GroupId groups[] = { kGroup1, kGroup2, kGroup3, kGroup4, kGroup5 };
+    for (size_t i = 1; i < ArraySize(groups); i++)
+    {
+        NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric1, i, GroupKey(groups[i], kKeysetId3)));
+    }
+    for (GroupId group : groups)
+    {
+        NL_TEST_ASSERT(apSuite, 1 == CountGroupSessions(provider, session_id, group));
+    }
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->RemoveGroupKeyAt(kFabric1, ArraySize(groups) - 1));
+    NL_TEST_ASSERT(apSuite, 0 == CountGroupSessions(provider, session_id, groups[ArraySize(groups) - 1]));
+    NL_TEST_ASSERT(apSuite, 1 == CountGroupSessions(provider, session_id, kGroup1));
+
+    // Removed key sets are not used anymore
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->RemoveKeySet(kFabric1, kKeysetId3));
+    NL_TEST_ASSERT(apSuite, 0 == CountGroupSessions(provider, session_id, kGroup1));
+
+    // A cache that failed to load, here because the keystore ran out of slots, is not loaded again for every message
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet3));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric1, 0, kGroup1Keyset3));
+    sSessionKeystore.out_of_slots = true;
+    NL_TEST_ASSERT(apSuite, 0 == CountGroupSessions(provider, session_id, kGroup1));
+    sSessionKeystore.out_of_slots  = false;
+    sSessionKeystore.created_count = 0;
+    NL_TEST_ASSERT(apSuite, 1 == CountGroupSessions(provider, session_id, kGroup1));
+    NL_TEST_ASSERT(apSuite, 1 == CountGroupSessions(provider, session_id, kGroup1));
+    // Only the keys of the matching session were loaded, twice
+    NL_TEST_ASSERT(apSuite, 4 == sSessionKeystore.created_count);
+
+    // The next change lets the cache load again, with the keys of every session loaded once
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric1, 0, kGroup1Keyset3));
+    sSessionKeystore.created_count = 0;
+    NL_TEST_ASSERT(apSuite, 1 == CountGroupSessions(provider, session_id, kGroup1));
+    NL_TEST_ASSERT(apSuite, 1 == CountGroupSessions(provider, session_id, kGroup1));
+    NL_TEST_ASSERT(apSuite, 2 * kKeySet3.num_keys_used == sSessionKeystore.created_count);
+
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->RemoveFabric(kFabric1));
+}
+
 } // namespace TestGroups
 } // namespace app
 } // namespace chip
@@ -1203,7 +1321,6 @@ void TestGroupDecryption(nlTestSuite * apSuite, void * apContext)
 namespace {
 
 static chip::TestPersistentStorageDelegate sDelegate;
-static chip::Crypto::DefaultSessionKeystore sSessionKeystore;
 static GroupDataProviderImpl sProvider(chip::app::TestGroups::kMaxGroupsPerFabric, chip::app::TestGroups::kMaxGroupKeysPerFabric);
 
 static EpochKey kEpochKeys0[] = {
@@ -1236,7 +1353,7 @@ int Test_Setup(void * inContext)
 
     // Initialize Group Data Provider
     sProvider.SetStorageDelegate(&sDelegate);
-    sProvider.SetSessionKeystore(&sSessionKeystore);
+    sProvider.SetSessionKeystore(&chip::app::TestGroups::sSessionKeystore);
     sProvider.SetListener(&chip::app::TestGroups::sListener);
     VerifyOrReturnError(CHIP_NO_ERROR == sProvider.Init(), FAILURE);
     SetGroupDataProvider(&sProvider);
@@ -1275,6 +1392,7 @@ const nlTest sTests[] = { NL_TEST_DEF("TestStorageDelegate", chip::app::TestGrou
                           NL_TEST_DEF("TestIpk", chip::app::TestGroups::TestIpk),
                           NL_TEST_DEF("TestPerFabricData", chip::app::TestGroups::TestPerFabricData),
                           NL_TEST_DEF("TestGroupDecryption", chip::app::TestGroups::TestGroupDecryption),
+                          NL_TEST_DEF("TestGroupSessionCache", chip::app::TestGroups::TestGroupSessionCache),
                           NL_TEST_SENTINEL() };
 } // namespace
 
@@ -104,6 +104,7 @@ public:
     const PeerId & GetPeerId() const { return mPeerId; }
     System::Clock::Milliseconds32 GetMinLookupTime() const { return mMinLookupTimeMs; }
     System::Clock::Milliseconds32 GetMaxLookupTime() const { return mMaxLookupTimeMs; }
+    bool GetBypassCache() const { return mBypassCache; }
 
     /// The minimum lookup time is how much to wait for additional DNSSD
     /// queries even if a reply has already been received or to allow for
@@ -141,6 +142,15 @@ public:
         return *this;
     }
 
+    /// Set when the lookup is retried because the previously resolved data
+    /// did not work (e.g. no session could be established with it), in which
+    /// case records cached by the DNSSD layer are dropped rather than reused.
+    NodeLookupRequest & SetBypassCache(bool value)
+    {
+        mBypassCache = value;
+        return *this;
+    }
+
 private:
     static constexpr uint32_t kMinLookupTimeMsDefault = 200;
     static constexpr uint32_t kMaxLookupTimeMsDefault = 45000;
@@ -148,6 +158,7 @@ private:
     PeerId mPeerId;
     System::Clock::Milliseconds32 mMinLookupTimeMs{ kMinLookupTimeMsDefault };
     System::Clock::Milliseconds32 mMaxLookupTimeMs{ kMaxLookupTimeMsDefault };
+    bool mBypassCache = false;
 };
 
 /// These things are expected to be defined by the implementation header.
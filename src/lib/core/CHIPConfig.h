@@ -918,6 +918,30 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_SERVER_MAX_NUM_DIRTY_SET 8
 #endif
 
+/**
+ * @def CHIP_IM_SERVER_MAX_NUM_COALESCED_CLUSTERS
+ *
+ * @brief Defines the number of clusters for which the reporting engine coalesces repeated attribute changes between two
+ *        report runs (skipping redundant dirty marking and data version increases) and keeps change rate statistics.
+ *        Changes to clusters beyond that number are processed without coalescing.  Disabled (0) by default: 8 is a
+ *        reasonable value for devices that want it.
+ */
+#ifndef CHIP_IM_SERVER_MAX_NUM_COALESCED_CLUSTERS
+#define CHIP_IM_SERVER_MAX_NUM_COALESCED_CLUSTERS 0
+#endif
+
+/**
+ * @def CHIP_IM_SERVER_ENCODED_LIST_BUFFER_SIZE
+ *
+ * @brief Size of the buffer in which the reporting engine encodes the rest of a list attribute that does not fit in a report
+ *        chunk, so that the following chunks copy the encoded list items instead of reading the attribute again from the
+ *        resume index.  The buffer is allocated from the heap only while a ReadHandler is chunking a list; if that fails, or
+ *        if this is set to 0, the list is read again for every chunk.
+ */
+#ifndef CHIP_IM_SERVER_ENCODED_LIST_BUFFER_SIZE
+#define CHIP_IM_SERVER_ENCODED_LIST_BUFFER_SIZE 4096
+#endif
+
 /**
  * @def CHIP_IM_MAX_NUM_WRITE_HANDLER
  *
@@ -1019,6 +1043,18 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_CASE_CLIENTS 16
 #endif
 
+/**
+ * @def CHIP_CONFIG_ENABLE_CASE_CLIENT_ADMISSION_CONTROL
+ *
+ * @brief If true, an OperationalSessionSetup that has resolved its peer address while
+ *        all CASE clients are busy waits for one to be released instead of failing with
+ *        CHIP_ERROR_NO_MEMORY.  The number of concurrent CASE handshakes is bounded by
+ *        the size of the CASE client pool (e.g. CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_CASE_CLIENTS).
+ */
+#ifndef CHIP_CONFIG_ENABLE_CASE_CLIENT_ADMISSION_CONTROL
+#define CHIP_CONFIG_ENABLE_CASE_CLIENT_ADMISSION_CONTROL 1
+#endif
+
 /**
  * @def CHIP_CONFIG_DEVICE_MAX_ACTIVE_CASE_CLIENTS
  *
@@ -1094,6 +1130,24 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_GROUP_CONCURRENT_ITERATORS 2
 #endif
 
+/**
+ * @def CHIP_CONFIG_MAX_CACHED_GROUP_SESSIONS
+ *
+ * @brief Defines the number of group sessions, i.e. group-key mappings times keys of the mapped key set, that the
+ *        group data provider keeps in RAM with their keys loaded, across all fabrics.
+ *
+ * Incoming group messages are matched against the cached sessions instead of reading the group-key mappings and key sets
+ * from persistent storage.  If the device has more group sessions than this, they are read from storage as if there
+ * were no cache.  Set to 0 to disable the cache.
+ *
+ * Each cached session keeps its encryption and privacy keys loaded in the session keystore, so the cache holds up to
+ * twice this number of keystore key slots.  Platforms whose keystore has few slots (e.g. PSA crypto) should lower this;
+ * if the keystore runs out of slots, the cache is not used until the group keys change.
+ */
+#ifndef CHIP_CONFIG_MAX_CACHED_GROUP_SESSIONS
+#define CHIP_CONFIG_MAX_CACHED_GROUP_SESSIONS (CHIP_CONFIG_MAX_GROUPS_PER_FABRIC * 3)
+#endif
+
 /**
  * @def CHIP_CONFIG_MAX_GROUP_NAME_LENGTH
  *
@@ -1223,6 +1277,38 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD 512
 #endif /* CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD */
 
+/**
+ * @def CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE
+ *
+ * @brief The number of events of each event log buffer whose length and priority are remembered, so that making room for new
+ *   events moves or drops the oldest ones without parsing them.  Each entry takes 4 bytes per buffer.  When a buffer holds more
+ *   events than that, the events that did not fit are parsed once, a whole index at a time, when the indexed ones are evicted.
+ */
+#ifndef CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE
+#define CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE 32
+#endif /* CHIP_CONFIG_EVENT_LOGGING_INDEX_SIZE */
+
+/**
+ * @def CHIP_CONFIG_EVENT_STAGING_RING_SIZE
+ *
+ * @brief The number of events of each priority level that threads other than the CHIP thread can stage with
+ *   EventManagement::StageEvent before they are merged into the event log.  Must be a power of two.  Set to 0 to disable
+ *   event staging, in which case events can only be logged on the CHIP thread.
+ */
+#ifndef CHIP_CONFIG_EVENT_STAGING_RING_SIZE
+#define CHIP_CONFIG_EVENT_STAGING_RING_SIZE 0
+#endif /* CHIP_CONFIG_EVENT_STAGING_RING_SIZE */
+
+/**
+ * @def CHIP_CONFIG_EVENT_STAGING_MAX_EVENT_DATA_SIZE
+ *
+ * @brief The largest event data, in bytes, that can be staged with EventManagement::StageEvent.  Every slot of the staging
+ *   rings reserves that much memory.
+ */
+#ifndef CHIP_CONFIG_EVENT_STAGING_MAX_EVENT_DATA_SIZE
+#define CHIP_CONFIG_EVENT_STAGING_MAX_EVENT_DATA_SIZE 128
+#endif /* CHIP_CONFIG_EVENT_STAGING_MAX_EVENT_DATA_SIZE */
+
 /**
  * @def CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
  *
@@ -1319,6 +1405,19 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_ATTRIBUTE_STORE_ELEMENT_SIZE 1003
 #endif // CHIP_CONFIG_MAX_ATTRIBUTE_STORE_ELEMENT_SIZE
 
+/*
+ * @def CHIP_CONFIG_ATTRIBUTE_ACCESS_TABLES
+ *
+ * @brief If enabled, attributes of fixed endpoints are located through the
+ * compile-time perfect hash tables of zap-generated/attribute_access_tables.h
+ * instead of a linear search of the endpoint configuration.  This makes reads
+ * and writes of stored attributes independent of the size of the data model,
+ * at the cost of a few bytes of flash per attribute.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_ACCESS_TABLES
+#define CHIP_CONFIG_ATTRIBUTE_ACCESS_TABLES 0
+#endif // CHIP_CONFIG_ATTRIBUTE_ACCESS_TABLES
+
 /*
  * @def CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST
  *
@@ -1346,6 +1445,81 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES 2
 #endif // CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES
 
+/*
+ * @def CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+ *
+ * @brief Enables usage of heap in the minmdns resolver for tracking pending
+ *        resolve attempts and SRV records being processed.
+ *
+ *        When set, these pools grow on demand up to
+ *        CHIP_CONFIG_MINMDNS_MAX_DYNAMIC_RESOLVES entries and incoming records
+ *        are matched to pending lookups through hash indexes, which allows
+ *        controllers to resolve many nodes at once (e.g. reconnecting to a
+ *        whole fabric after a restart).
+ *
+ *        When this is not set, CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES
+ *        determines the statically allocated number of parallel resolves.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+#define CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS 0
+#endif // CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+
+/*
+ * @def CHIP_CONFIG_MINMDNS_MAX_DYNAMIC_RESOLVES
+ *
+ * @brief Upper bound for the pools enabled by CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS.
+ *        Once reached, the oldest pending resolves are replaced as in the static case.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_MAX_DYNAMIC_RESOLVES
+#define CHIP_CONFIG_MINMDNS_MAX_DYNAMIC_RESOLVES 4096
+#endif // CHIP_CONFIG_MINMDNS_MAX_DYNAMIC_RESOLVES
+
+/*
+ * @def CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+ *
+ * @brief Number of operational DNS-SD resource records (PTR/SRV/TXT/A/AAAA)
+ *        that the minmdns resolver remembers between resolves.
+ *
+ *        Records are learned from query responses as well as from unsolicited
+ *        announcements and are used to answer ResolveNodeId without sending a
+ *        query while their TTL is fresh. A resolved node typically uses one
+ *        SRV, one TXT and one to three AAAA records, so controllers talking to
+ *        many nodes may want to increase this. Set to 0 to disable caching.
+ *
+ *        Every entry holds CHIP_CONFIG_MINMDNS_RECORD_CACHE_MAX_RECORD_SIZE
+ *        bytes of record data, so caching is disabled by default and enabled
+ *        by platforms that can afford the RAM (e.g. Linux).
+ */
+#ifndef CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE 0
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+
+/*
+ * @def CHIP_CONFIG_MINMDNS_RECORD_CACHE_MAX_RECORD_SIZE
+ *
+ * @brief Maximum size of a single resource record (uncompressed name, header
+ *        and data) kept by the minmdns record cache. Larger records are not cached.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_RECORD_CACHE_MAX_RECORD_SIZE
+#define CHIP_CONFIG_MINMDNS_RECORD_CACHE_MAX_RECORD_SIZE 128
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_MAX_RECORD_SIZE
+
+/*
+ * @def CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+ *
+ * @brief Number of fully encoded replies the minmdns advertiser keeps, keyed by
+ *        interface and question.
+ *
+ *        Repeated queries for the same question (common on busy networks and for
+ *        devices advertising many operational instances, such as bridges) are
+ *        then answered by copying the cached packet rather than walking all
+ *        responders and serializing every record again. Each entry uses a full
+ *        reply packet worth of RAM. Set to 0 to disable the cache.
+ */
+#ifndef CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE 0
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+
 /**
  * def CHIP_CONFIG_MDNS_RESOLVE_LOOKUP_RESULTS
  *
@@ -1403,6 +1577,32 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_NUM_CD_KEY_SLOTS 5
 #endif // CHIP_CONFIG_NUM_CD_KEY_SLOTS
 
+/**
+ * @def CHIP_CONFIG_ATTESTATION_VERIFICATION_CACHE_SIZE
+ *
+ * @brief Number of successfully verified PAI certificate chains, and of Certification Declaration
+ *        signatures, remembered by the default DAC verifier.
+ *
+ *        Devices of a product line share their PAI and Certification Declaration, so only the
+ *        DAC-specific checks need to be repeated when commissioning many of them. Set to 0 to
+ *        disable caching.
+ *
+ */
+#ifndef CHIP_CONFIG_ATTESTATION_VERIFICATION_CACHE_SIZE
+#define CHIP_CONFIG_ATTESTATION_VERIFICATION_CACHE_SIZE 4
+#endif // CHIP_CONFIG_ATTESTATION_VERIFICATION_CACHE_SIZE
+
+/**
+ * @def CHIP_CONFIG_ATTESTATION_VERIFICATION_CACHE_TIMEOUT_SECS
+ *
+ * @brief How long a verification result cached by the default DAC verifier is trusted, which bounds
+ *        how long removing a PAA from the trust store can go unnoticed.
+ *
+ */
+#ifndef CHIP_CONFIG_ATTESTATION_VERIFICATION_CACHE_TIMEOUT_SECS
+#define CHIP_CONFIG_ATTESTATION_VERIFICATION_CACHE_TIMEOUT_SECS 3600
+#endif // CHIP_CONFIG_ATTESTATION_VERIFICATION_CACHE_TIMEOUT_SECS
+
 /**
  * @def CHIP_CONFIG_MAX_SUBSCRIPTION_RESUMPTION_STORAGE_CONCURRENT_ITERATORS
  *
@@ -1666,6 +1866,26 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION_MAX_RETRY_INTERVAL_SECS (3600 * 6)
 #endif // CHIP_CONFIG_SUBSCRIPTION_TIMEOUT_RESUMPTION_MAX_RETRY_INTERVAL_SECS
 
+/**
+ *  @def CHIP_CONFIG_SUBSCRIPTION_RESUMPTION_MAX_CONCURRENT
+ *
+ *  @brief The maximum number of persisted subscriptions being resumed at the same time, i.e. waiting for their CASE session.
+ *         Subscriptions that are due while this many resumptions are in flight wait for one of them to complete.
+ */
+#ifndef CHIP_CONFIG_SUBSCRIPTION_RESUMPTION_MAX_CONCURRENT
+#define CHIP_CONFIG_SUBSCRIPTION_RESUMPTION_MAX_CONCURRENT 2
+#endif // CHIP_CONFIG_SUBSCRIPTION_RESUMPTION_MAX_CONCURRENT
+
+/**
+ *  @def CHIP_CONFIG_SUBSCRIPTION_RESUMPTION_MAX_JITTER_MS
+ *
+ *  @brief The maximum random delay added to the min interval of a persisted subscription before it is resumed, so that
+ *         subscriptions sharing a min interval are not all resumed at the same instant.
+ */
+#ifndef CHIP_CONFIG_SUBSCRIPTION_RESUMPTION_MAX_JITTER_MS
+#define CHIP_CONFIG_SUBSCRIPTION_RESUMPTION_MAX_JITTER_MS 2000
+#endif // CHIP_CONFIG_SUBSCRIPTION_RESUMPTION_MAX_JITTER_MS
+
 /**
  * @def CHIP_CONFIG_SYNCHRONOUS_REPORTS_ENABLED
  *
@@ -1721,6 +1941,50 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_ICD_OBSERVERS_POOL_SIZE 2
 #endif
 
+/**
+ * @def CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND
+ *
+ * @brief Controls whether the server persists attribute store values through WriteBehindAttributePersistenceProvider, which
+ *        batches the changes of each cluster into a single storage record written on a timer, instead of writing every
+ *        change of every attribute to its own storage key right away.
+ *
+ *        Values that changed since the last flush are lost if the device loses power.  The records are not read by
+ *        DefaultAttributePersistenceProvider, so values written with this enabled are not restored once it is disabled.
+ */
+#ifndef CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND
+#define CHIP_CONFIG_ENABLE_ATTRIBUTE_WRITE_BEHIND 0
+#endif
+
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_INTERVAL_MS
+ *
+ * @brief The time after the first change of an attribute value at which WriteBehindAttributePersistenceProvider writes
+ *        the changed values to storage.  This bounds both the rate of storage writes and the changes lost on power loss.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_INTERVAL_MS
+#define CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_INTERVAL_MS 5000
+#endif
+
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_CACHE_SIZE
+ *
+ * @brief The number of changed attribute values WriteBehindAttributePersistenceProvider holds until they are written to
+ *        storage.  Once all are in use, the next change of another attribute writes them all right away.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_CACHE_SIZE
+#define CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_CACHE_SIZE 16
+#endif
+
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_RECORD_SIZE
+ *
+ * @brief The maximum size of the storage record holding the persisted attribute values of a cluster instance.  Values
+ *        that do not fit are stored under their own key.  Must not be reduced on a device that already stores records.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_RECORD_SIZE
+#define CHIP_CONFIG_ATTRIBUTE_WRITE_BEHIND_RECORD_SIZE 512
+#endif
+
 /**
  * @}
  */
@@ -39,6 +39,7 @@
 #include <lib/support/CodeUtils.h>
 
 #include <stdint.h>
+#include <string.h>
 
 namespace chip {
 namespace TLV {
@@ -221,6 +222,40 @@ void TLVCircularBuffer::GetCurrentWritableBuffer(uint8_t *& outBufStart, uint32_
     }
 }
 
+CHIP_ERROR TLVCircularBuffer::DiscardHead(uint32_t inLength)
+{
+    VerifyOrReturnError(inLength <= mQueueLength, CHIP_ERROR_INVALID_ARGUMENT);
+
+    mQueueHead = mQueue + ((static_cast<size_t>(mQueueHead - mQueue) + inLength) % mQueueSize);
+    mQueueLength -= inLength;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR TLVCircularBuffer::AppendData(const uint8_t * inData, uint32_t inLength)
+{
+    VerifyOrReturnError(inLength <= AvailableDataLength(), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    while (inLength > 0)
+    {
+        uint8_t * tail;
+        uint32_t contiguousLength;
+
+        GetCurrentWritableBuffer(tail, contiguousLength);
+        if (contiguousLength > inLength)
+        {
+            contiguousLength = inLength;
+        }
+
+        memcpy(tail, inData, contiguousLength);
+        mQueueLength += contiguousLength;
+        inData += contiguousLength;
+        inLength -= contiguousLength;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
 /**
  * @brief
  *   FinalizeBuffer adjust the `TLVCircularBuffer` state on
@@ -139,6 +139,30 @@ protected:
      */
     void GetCurrentWritableBuffer(uint8_t *& outBufStart, uint32_t & outBufLen) const;
 
+    /**
+     * @brief
+     *   Removes the first bytes of the queue without reading them.  The caller is responsible for dropping whole elements.
+     *
+     * @param[in] inLength The number of bytes to remove from the head of the queue.
+     *
+     * @retval #CHIP_NO_ERROR               On success.
+     * @retval #CHIP_ERROR_INVALID_ARGUMENT If the queue holds fewer than \c inLength bytes.
+     */
+    CHIP_ERROR DiscardHead(uint32_t inLength);
+
+    /**
+     * @brief
+     *   Copies already encoded elements to the tail of the queue, wrapping around the end of the buffer if needed.  Unlike a
+     *   TLVWriter, this never evicts elements: the caller has to make room for the data first.
+     *
+     * @param[in] inData   The encoded elements.
+     * @param[in] inLength The length of \c inData in bytes.
+     *
+     * @retval #CHIP_NO_ERROR              On success.
+     * @retval #CHIP_ERROR_BUFFER_TOO_SMALL If fewer than \c inLength bytes are available.
+     */
+    CHIP_ERROR AppendData(const uint8_t * inData, uint32_t inLength);
+
 private:
     uint8_t * mQueue;
     uint32_t mQueueSize;
@@ -25,6 +25,16 @@ using namespace chip;
 
 namespace mdns {
 namespace Minimal {
+namespace {
+
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+size_t HashPeerId(const PeerId & peerId)
+{
+    return std::hash<uint64_t>()(peerId.GetCompressedFabricId() ^ (peerId.GetNodeId() * 0x9E3779B97F4A7C15ull));
+}
+#endif
+
+} // namespace
 
 constexpr chip::System::Clock::Timeout ActiveResolveAttempts::kMaxRetryDelay;
 
@@ -35,18 +45,82 @@ void ActiveResolveAttempts::Reset()
     {
         item.attempt.Clear();
     }
+    mScanStart = 0;
+
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+    mRetryQueue.clear();
+    mPeerIndex.clear();
+    mFreeEntries.clear();
+#endif
 }
 
-void ActiveResolveAttempts::Complete(const PeerId & peerId)
+void ActiveResolveAttempts::ReleaseEntry(RetryEntry & entry)
+{
+    entry.attempt.Clear();
+
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+    mFreeEntries.push_back(static_cast<size_t>(&entry - mRetryQueue.data()));
+#endif
+}
+
+ActiveResolveAttempts::RetryEntry * ActiveResolveAttempts::FindResolve(const PeerId & peerId)
 {
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+    auto range = mPeerIndex.equal_range(HashPeerId(peerId));
+    for (auto it = range.first; it != range.second; it++)
+    {
+        RetryEntry & item = mRetryQueue[it->second];
+        if (item.attempt.Matches(peerId))
+        {
+            return &item;
+        }
+    }
+#else
     for (auto & item : mRetryQueue)
     {
         if (item.attempt.Matches(peerId))
         {
-            item.attempt.Clear();
-            return;
+            return &item;
         }
     }
+#endif
+    return nullptr;
+}
+
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+void ActiveResolveAttempts::Compact()
+{
+    mRetryQueue.erase(std::remove_if(mRetryQueue.begin(), mRetryQueue.end(),
+                                     [](const RetryEntry & item) { return item.attempt.IsEmpty(); }),
+                      mRetryQueue.end());
+
+    mPeerIndex.clear();
+    for (size_t i = 0; i < mRetryQueue.size(); i++)
+    {
+        IndexEntry(i);
+    }
+    mFreeEntries.clear();
+    mScanStart = 0;
+}
+
+void ActiveResolveAttempts::IndexEntry(size_t index)
+{
+    const ScheduledAttempt & attempt = mRetryQueue[index].attempt;
+    if (attempt.IsResolve())
+    {
+        mPeerIndex.emplace(HashPeerId(attempt.ResolveData().peerId), index);
+    }
+}
+#endif
+
+void ActiveResolveAttempts::Complete(const PeerId & peerId)
+{
+    RetryEntry * item = FindResolve(peerId);
+    if (item != nullptr)
+    {
+        ReleaseEntry(*item);
+        return;
+    }
 
 #if CHIP_MINMDNS_HIGH_VERBOSITY
     // This may happen during boot time adverisements: nodes come online
@@ -61,7 +135,7 @@ void ActiveResolveAttempts::CompleteCommissioner(const chip::Dnssd::DiscoveredNo
     {
         if (item.attempt.Matches(data, chip::Dnssd::DiscoveryType::kCommissionerNode))
         {
-            item.attempt.Clear();
+            ReleaseEntry(item);
             return;
         }
     }
@@ -73,7 +147,7 @@ void ActiveResolveAttempts::CompleteCommissionable(const chip::Dnssd::Discovered
     {
         if (item.attempt.Matches(data, chip::Dnssd::DiscoveryType::kCommissionableNode))
         {
-            item.attempt.Clear();
+            ReleaseEntry(item);
             return;
         }
     }
@@ -103,7 +177,7 @@ void ActiveResolveAttempts::CompleteIpResolution(SerializedQNameIterator targetH
     {
         if (item.attempt.MatchesIpResolve(targetHostName))
         {
-            item.attempt.Clear();
+            ReleaseEntry(item);
             return;
         }
     }
@@ -115,7 +189,7 @@ CHIP_ERROR ActiveResolveAttempts::CompleteAllBrowses()
     {
         if (item.attempt.IsBrowse())
         {
-            item.attempt.Clear();
+            ReleaseEntry(item);
         }
     }
 
@@ -124,12 +198,13 @@ CHIP_ERROR ActiveResolveAttempts::CompleteAllBrowses()
 
 void ActiveResolveAttempts::NodeIdResolutionNoLongerNeeded(const PeerId & peerId)
 {
-    for (auto & item : mRetryQueue)
+    RetryEntry * item = FindResolve(peerId);
+    if (item != nullptr)
     {
-        if (item.attempt.Matches(peerId))
+        item->attempt.ConsumerRemoved();
+        if (item->attempt.IsEmpty())
         {
-            item.attempt.ConsumerRemoved();
-            return;
+            ReleaseEntry(*item);
         }
     }
 }
@@ -149,8 +224,51 @@ void ActiveResolveAttempts::MarkPending(ScheduledAttempt::IpResolve && resolve)
     MarkPending(ScheduledAttempt(std::move(resolve), /* firstSend */ true));
 }
 
-void ActiveResolveAttempts::MarkPending(ScheduledAttempt && attempt)
+ActiveResolveAttempts::RetryEntry * ActiveResolveAttempts::SelectEntry(const ScheduledAttempt & attempt)
 {
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+    if (attempt.IsResolve())
+    {
+        RetryEntry * existing = FindResolve(attempt.ResolveData().peerId);
+        if (existing != nullptr)
+        {
+            return existing;
+        }
+    }
+    else
+    {
+        for (auto & item : mRetryQueue)
+        {
+            if (item.attempt.Matches(attempt))
+            {
+                return &item;
+            }
+        }
+    }
+
+    while (!mFreeEntries.empty())
+    {
+        RetryEntry & entry = mRetryQueue[mFreeEntries.back()];
+        mFreeEntries.pop_back();
+        if (entry.attempt.IsEmpty())
+        {
+            return &entry;
+        }
+    }
+
+    if ((mPeerIndex.size() > 2 * mRetryQueue.size() + kRetryQueueSize) || (mRetryQueue.size() >= mMaxAttempts))
+    {
+        // Drop unused entries and stale index data before growing (or evicting)
+        Compact();
+    }
+
+    if (mRetryQueue.size() < mMaxAttempts)
+    {
+        mRetryQueue.emplace_back();
+        return &mRetryQueue.back();
+    }
+#endif
+
     // Strategy when picking the peer id to use:
     //   1 if a matching peer id is already found, use that one
     //   2 if an 'unused' entry is found, use that
@@ -158,16 +276,17 @@ void ActiveResolveAttempts::MarkPending(ScheduledAttempt && attempt)
     //     or if equal nextRetryDelay, pick the one with the oldest
     //     queryDueTime
 
-    RetryEntry * entryToUse = &mRetryQueue[0];
+    RetryEntry * entryToUse = mRetryQueue.data();
+    const size_t entryCount = std::min(mMaxAttempts, mRetryQueue.size());
 
-    for (size_t i = 1; i < kRetryQueueSize; i++)
+    for (size_t i = 1; i < entryCount; i++)
     {
         if (entryToUse->attempt.Matches(attempt))
         {
             break; // best match possible
         }
 
-        RetryEntry * entry = mRetryQueue + i;
+        RetryEntry * entry = mRetryQueue.data() + i;
 
         // Rule 1: attempt match always matches
         if (entry->attempt.Matches(attempt))
@@ -202,7 +321,15 @@ void ActiveResolveAttempts::MarkPending(ScheduledAttempt && attempt)
         }
     }
 
-    if ((!entryToUse->attempt.IsEmpty()) && (!entryToUse->attempt.Matches(attempt)))
+    return entryToUse;
+}
+
+void ActiveResolveAttempts::MarkPending(ScheduledAttempt && attempt)
+{
+    RetryEntry * entryToUse   = SelectEntry(attempt);
+    const bool alreadyPending = entryToUse->attempt.Matches(attempt);
+
+    if ((!entryToUse->attempt.IsEmpty()) && !alreadyPending)
     {
         // TODO: node was evicted here, if/when resolution failures are
         // supported this could be a place for error callbacks
@@ -218,6 +345,16 @@ void ActiveResolveAttempts::MarkPending(ScheduledAttempt && attempt)
     entryToUse->attempt        = attempt;
     entryToUse->queryDueTime   = mClock->GetMonotonicTimestamp();
     entryToUse->nextRetryDelay = System::Clock::Seconds16(1);
+
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+    if (!alreadyPending)
+    {
+        IndexEntry(static_cast<size_t>(entryToUse - mRetryQueue.data()));
+    }
+#endif
+
+    // New entry is due now, so it may be before the scan start
+    mScanStart = 0;
 }
 
 Optional<System::Clock::Timeout> ActiveResolveAttempts::GetTimeUntilNextExpectedResponse() const
@@ -253,8 +390,16 @@ Optional<ActiveResolveAttempts::ScheduledAttempt> ActiveResolveAttempts::NextSch
 {
     chip::System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
 
-    for (auto & entry : mRetryQueue)
+    if (now != mScanTime)
     {
+        mScanStart = 0;
+        mScanTime  = now;
+    }
+
+    for (; mScanStart < mRetryQueue.size(); mScanStart++)
+    {
+        RetryEntry & entry = mRetryQueue[mScanStart];
+
         if (entry.attempt.IsEmpty())
         {
             continue; // not a pending item
@@ -268,7 +413,7 @@ Optional<ActiveResolveAttempts::ScheduledAttempt> ActiveResolveAttempts::NextSch
         if (entry.nextRetryDelay > kMaxRetryDelay)
         {
             ChipLogError(Discovery, "Timeout waiting for mDNS resolution.");
-            entry.attempt.Clear();
+            ReleaseEntry(entry);
             continue;
         }
 
@@ -20,6 +20,7 @@
 #include <cstddef>
 #include <cstdint>
 
+#include <lib/core/CHIPConfig.h>
 #include <lib/core/Optional.h>
 #include <lib/core/PeerId.h>
 #include <lib/dnssd/Resolver.h>
@@ -27,6 +28,13 @@
 #include <lib/support/Variant.h>
 #include <system/SystemClock.h>
 
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+#include <unordered_map>
+#include <vector>
+#else
+#include <array>
+#endif
+
 namespace mdns {
 namespace Minimal {
 
@@ -38,6 +46,11 @@ namespace Minimal {
 ///    - figuring out a 'next query time' for items in the list
 ///    - iterating through the 'schedule now' items of the list
 ///
+/// When CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS is enabled, the list is
+/// heap allocated and grows up to the `maxAttempts` given at construction
+/// before evicting entries. Otherwise at most kRetryQueueSize attempts are
+/// tracked.
+///
 class ActiveResolveAttempts
 {
 public:
@@ -242,7 +255,11 @@ public:
         bool firstSend = false;
     };
 
-    ActiveResolveAttempts(chip::System::Clock::ClockBase * clock) : mClock(clock) { Reset(); }
+    ActiveResolveAttempts(chip::System::Clock::ClockBase * clock, size_t maxAttempts = kRetryQueueSize) :
+        mClock(clock), mMaxAttempts(maxAttempts > 0 ? maxAttempts : 1)
+    {
+        Reset();
+    }
 
     /// Clear out the internal queue
     void Reset();
@@ -308,9 +325,47 @@ private:
         //      least a factor of two
         chip::System::Clock::Timeout nextRetryDelay = chip::System::Clock::Seconds16(1);
     };
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+    using RetryQueue = std::vector<RetryEntry>;
+#else
+    using RetryQueue = std::array<RetryEntry, kRetryQueueSize>;
+#endif
+
     void MarkPending(ScheduledAttempt && attempt);
+
+    /// Find the entry for a pending operational resolve of [peerId], if any
+    RetryEntry * FindResolve(const chip::PeerId & peerId);
+
+    /// Pick the entry to use for a new attempt: a matching one, an unused one
+    /// or (if out of space) the oldest one.
+    RetryEntry * SelectEntry(const ScheduledAttempt & attempt);
+
+    /// Mark the given entry as unused
+    void ReleaseEntry(RetryEntry & entry);
+
     chip::System::Clock::ClockBase * mClock;
-    RetryEntry mRetryQueue[kRetryQueueSize];
+    const size_t mMaxAttempts;
+    RetryQueue mRetryQueue;
+
+    // NextScheduled is called in a loop until no more attempts are due. Entries
+    // before mScanStart were already found not due at mScanTime, which allows
+    // skipping them while the time does not change and nothing new is added.
+    size_t mScanStart = 0;
+    chip::System::Clock::Timestamp mScanTime;
+
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+    /// Remove unused entries and rebuild mPeerIndex
+    void Compact();
+    void IndexEntry(size_t index);
+
+    // Maps a PeerId hash to indexes in mRetryQueue. Entries are not removed
+    // when an attempt completes, so they are verified on use and the index is
+    // rebuilt when the queue is compacted.
+    std::unordered_multimap<size_t, size_t> mPeerIndex;
+
+    // Indexes of released entries, reused before growing mRetryQueue.
+    std::vector<size_t> mFreeEntries;
+#endif
 };
 
 } // namespace Minimal
@@ -0,0 +1,167 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <lib/dnssd/IncrementalResolverPool.h>
+
+#include <ctype.h>
+
+namespace chip {
+namespace Dnssd {
+
+using namespace mdns::Minimal;
+
+uint32_t IncrementalResolverPool::HashName(SerializedQNameIterator name)
+{
+    // FNV-1a
+    constexpr uint32_t kPrime = 16777619u;
+    uint32_t hash             = 2166136261u;
+
+    while (name.Next())
+    {
+        for (const char * c = name.Value(); *c != '\0'; c++)
+        {
+            hash = (hash ^ static_cast<uint8_t>(tolower(static_cast<unsigned char>(*c)))) * kPrime;
+        }
+        hash = (hash ^ static_cast<uint8_t>('.')) * kPrime;
+    }
+
+    return hash;
+}
+
+size_t IncrementalResolverPool::ActiveCount() const
+{
+    size_t count = 0;
+    for (auto & resolver : mResolvers)
+    {
+        if (resolver.IsActive())
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+
+void IncrementalResolverPool::IndexResolver(size_t index)
+{
+    IncrementalResolver & resolver = mResolvers[index];
+
+    const uint32_t recordHash = HashName(resolver.GetRecordName());
+    const uint32_t targetHash = HashName(resolver.GetTargetHostName());
+
+    mNameIndex.emplace(recordHash, index);
+    if (targetHash != recordHash)
+    {
+        mNameIndex.emplace(targetHash, index);
+    }
+}
+
+void IncrementalResolverPool::BeginPacket()
+{
+    while (!mResolvers.empty() && !mResolvers.back().IsActive())
+    {
+        mResolvers.pop_back();
+    }
+
+    mNameIndex.clear();
+    mFreeResolvers.clear();
+
+    for (size_t i = 0; i < mResolvers.size(); i++)
+    {
+        if (mResolvers[i].IsActive())
+        {
+            IndexResolver(i);
+        }
+        else
+        {
+            mFreeResolvers.push_back(i);
+        }
+    }
+}
+
+CHIP_ERROR IncrementalResolverPool::InitializeParsing(SerializedQNameIterator name, const SrvRecord & srv)
+{
+    const uint32_t nameHash = HashName(name);
+
+    auto range = mNameIndex.equal_range(nameHash);
+    for (auto it = range.first; it != range.second; it++)
+    {
+        IncrementalResolver & resolver = mResolvers[it->second];
+        if (resolver.IsActive() && (resolver.GetRecordName() == name))
+        {
+            return CHIP_ERROR_INCORRECT_STATE;
+        }
+    }
+
+    size_t index = mResolvers.size();
+    while (!mFreeResolvers.empty())
+    {
+        const size_t candidate = mFreeResolvers.back();
+        mFreeResolvers.pop_back();
+        if (!mResolvers[candidate].IsActive())
+        {
+            index = candidate;
+            break;
+        }
+    }
+
+    if (index == mResolvers.size())
+    {
+        VerifyOrReturnError(mResolvers.size() < mMaxResolvers, CHIP_ERROR_NO_MEMORY);
+        mResolvers.emplace_back();
+    }
+
+    CHIP_ERROR err = mResolvers[index].InitializeParsing(name, srv);
+    if (err != CHIP_NO_ERROR)
+    {
+        mFreeResolvers.push_back(index);
+        return err;
+    }
+
+    IndexResolver(index);
+    return CHIP_NO_ERROR;
+}
+
+#else
+
+void IncrementalResolverPool::BeginPacket() {}
+
+CHIP_ERROR IncrementalResolverPool::InitializeParsing(SerializedQNameIterator name, const SrvRecord & srv)
+{
+    for (auto & resolver : mResolvers)
+    {
+        if (resolver.IsActive() && (resolver.GetRecordName() == name))
+        {
+            return CHIP_ERROR_INCORRECT_STATE;
+        }
+    }
+
+    for (size_t i = 0; (i < mResolvers.size()) && (i < mMaxResolvers); i++)
+    {
+        if (!mResolvers[i].IsActive())
+        {
+            return mResolvers[i].InitializeParsing(name, srv);
+        }
+    }
+
+    return CHIP_ERROR_NO_MEMORY;
+}
+
+#endif // CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+
+} // namespace Dnssd
+} // namespace chip
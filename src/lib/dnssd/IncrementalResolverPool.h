@@ -0,0 +1,121 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/dnssd/IncrementalResolve.h>
+
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+#include <unordered_map>
+#include <vector>
+#else
+#include <array>
+#endif
+
+namespace chip {
+namespace Dnssd {
+
+/// A set of `IncrementalResolver`s processing SRV records in parallel.
+///
+/// By default this is a fixed array of CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES
+/// resolvers and every received record is offered to every active resolver.
+///
+/// With CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS, resolvers are allocated on
+/// demand (up to the limit given at construction) and records are only offered
+/// to resolvers whose record name or target host name hash matches, so that the
+/// cost per record does not grow with the number of parallel resolves.
+class IncrementalResolverPool
+{
+public:
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+    using Storage = std::vector<IncrementalResolver>;
+#else
+    using Storage = std::array<IncrementalResolver, CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES>;
+#endif
+
+    IncrementalResolverPool(size_t maxResolvers = CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES) : mMaxResolvers(maxResolvers) {}
+
+    IncrementalResolver * begin() { return mResolvers.data(); }
+    IncrementalResolver * end() { return mResolvers.data() + mResolvers.size(); }
+
+    /// Prepares for processing a new packet.
+    ///
+    /// Resolvers may become inactive outside of the pool control (e.g. once
+    /// their data is taken), so this releases unused resolvers and refreshes
+    /// any lookup indexes.
+    void BeginPacket();
+
+    /// Start processing the given SRV record in an unused resolver.
+    ///
+    /// Returns CHIP_ERROR_INCORRECT_STATE if the record is already being
+    /// processed, CHIP_ERROR_NO_MEMORY if no resolver is available and
+    /// otherwise whatever `IncrementalResolver::InitializeParsing` returns.
+    CHIP_ERROR InitializeParsing(mdns::Minimal::SerializedQNameIterator name, const mdns::Minimal::SrvRecord & srv);
+
+    /// Calls `callback(IncrementalResolver &)` for active resolvers that may
+    /// be interested in a record with the given name.
+    ///
+    /// The callback may be called for resolvers that end up not using the
+    /// record, so resolvers are still expected to filter records.
+    template <typename Function>
+    void ForEachCandidate(mdns::Minimal::SerializedQNameIterator name, Function && callback)
+    {
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+        auto range = mNameIndex.equal_range(HashName(name));
+        for (auto it = range.first; it != range.second; it++)
+        {
+            IncrementalResolver & resolver = mResolvers[it->second];
+            if (resolver.IsActive())
+            {
+                callback(resolver);
+            }
+        }
+#else
+        for (auto & resolver : mResolvers)
+        {
+            if (resolver.IsActive())
+            {
+                callback(resolver);
+            }
+        }
+#endif
+    }
+
+    size_t ActiveCount() const;
+
+private:
+    /// Case insensitive hash of a QName, consistent with QName comparisons
+    static uint32_t HashName(mdns::Minimal::SerializedQNameIterator name);
+
+    const size_t mMaxResolvers;
+    Storage mResolvers;
+
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+    void IndexResolver(size_t index);
+
+    // Record and target host name hashes of active resolvers, mapped to
+    // their index in mResolvers. Rebuilt for every packet.
+    std::unordered_multimap<uint32_t, size_t> mNameIndex;
+    std::vector<size_t> mFreeResolvers;
+#endif
+};
+
+} // namespace Dnssd
+} // namespace chip
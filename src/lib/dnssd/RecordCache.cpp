@@ -0,0 +1,532 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <lib/dnssd/RecordCache.h>
+
+#include <string.h>
+
+#include <lib/dnssd/ServiceNaming.h>
+#include <lib/dnssd/minimal_mdns/RecordData.h>
+#include <lib/dnssd/minimal_mdns/core/RecordWriter.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/SafeInt.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <tracing/macros.h>
+
+namespace chip {
+namespace Dnssd {
+
+using namespace mdns::Minimal;
+using namespace chip::System::Clock::Literals;
+
+namespace {
+
+constexpr QNamePart kOperationalSuffix[] = { kOperationalServiceName, kOperationalProtocol, kLocalDomain };
+
+// RFC 6762 section 10.2: records with the cache-flush bit set only replace
+// records that were received more than one second ago.
+constexpr System::Clock::Milliseconds64 kCacheFlushGracePeriod = 1000_ms64;
+
+/// Checks that [name] is `<prefixLabels labels>._matter._tcp.local`
+bool IsOperationalServiceName(SerializedQNameIterator name, size_t prefixLabels)
+{
+    for (size_t i = 0; i < prefixLabels; i++)
+    {
+        if (!name.Next() || !name.IsValid())
+        {
+            return false;
+        }
+    }
+    return name == kOperationalSuffix;
+}
+
+/// Determines if a record is operational discovery related, based on its name.
+///
+/// Operational PTR records are either `_matter._tcp.local` or
+/// `_I<fabric>._sub._matter._tcp.local`, SRV and TXT records are
+/// `<fabric>-<node>._matter._tcp.local`.
+bool IsOperationalRecord(const ResourceData & data)
+{
+    switch (data.GetType())
+    {
+    case QType::PTR:
+        return IsOperationalServiceName(data.GetName(), 0) || IsOperationalServiceName(data.GetName(), 2);
+    case QType::SRV:
+    case QType::TXT:
+        return IsOperationalServiceName(data.GetName(), 1);
+    default:
+        return false;
+    }
+}
+
+bool IsAddressRecord(const ResourceData & data)
+{
+    return (data.GetType() == QType::A) || (data.GetType() == QType::AAAA);
+}
+
+bool SameBytes(const BytesRange & a, const BytesRange & b)
+{
+    return (a.Size() == b.Size()) && (memcmp(a.Start(), b.Start(), a.Size()) == 0);
+}
+
+/// Feeds relevant records of a packet into a cache.
+///
+/// Names of services are processed before host addresses, so that addresses
+/// can be filtered based on the SRV targets of the same packet.
+class CacheFiller : public ParserDelegate
+{
+public:
+    enum class Pass
+    {
+        kServiceRecords,
+        kAddressRecords,
+    };
+
+    CacheFiller(RecordCache & cache, Inet::InterfaceId interface, const BytesRange & packet) :
+        mCache(cache), mInterface(interface), mPacket(packet)
+    {}
+
+    void SetPass(Pass pass) { mPass = pass; }
+
+    void OnHeader(ConstHeaderRef & header) override { mIsResponse = header.GetFlags().IsResponse(); }
+    void OnQuery(const QueryData & data) override {}
+    void OnResource(ResourceType type, const ResourceData & data) override
+    {
+        if (!mIsResponse)
+        {
+            return;
+        }
+
+        if (mPass == Pass::kServiceRecords ? IsAddressRecord(data) : !IsAddressRecord(data))
+        {
+            return;
+        }
+
+        CHIP_ERROR err = mCache.AddRecord(mInterface, data, mPacket);
+        if ((err != CHIP_NO_ERROR) && (err != CHIP_ERROR_NOT_FOUND))
+        {
+#if CHIP_MINMDNS_HIGH_VERBOSITY
+            ChipLogError(Discovery, "Failed to cache DNSSD record: %" CHIP_ERROR_FORMAT, err.Format());
+#endif
+        }
+    }
+
+private:
+    RecordCache & mCache;
+    const Inet::InterfaceId mInterface;
+    const BytesRange mPacket;
+    Pass mPass       = Pass::kServiceRecords;
+    bool mIsResponse = false;
+};
+
+} // namespace
+
+ResourceData RecordCache::Entry::Data() const
+{
+    ResourceData data;
+    const uint8_t * start = record;
+
+    data.Parse(Range(), &start);
+    return data;
+}
+
+void RecordCache::Clear()
+{
+    for (auto & entry : mEntries)
+    {
+        entry.recordLength = 0;
+    }
+}
+
+size_t RecordCache::Count() const
+{
+    size_t count = 0;
+    for (size_t i = 0; i < kCacheSize; i++)
+    {
+        if (mEntries[i].IsUsed())
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+void RecordCache::ObservePacket(Inet::InterfaceId interface, const BytesRange & packet)
+{
+    if (kCacheSize == 0)
+    {
+        return;
+    }
+
+    MATTER_TRACE_SCOPE("Caching DNSSD records", "RecordCache");
+
+    CacheFiller filler(*this, interface, packet);
+
+    filler.SetPass(CacheFiller::Pass::kServiceRecords);
+    if (!ParsePacket(packet, &filler))
+    {
+        return;
+    }
+
+    filler.SetPass(CacheFiller::Pass::kAddressRecords);
+    ParsePacket(packet, &filler);
+}
+
+CHIP_ERROR RecordCache::Serialize(const ResourceData & data, const BytesRange & packet, Entry & entry)
+{
+    Encoding::BigEndian::BufferWriter output(entry.record, sizeof(entry.record));
+    RecordWriter writer(&output);
+
+    writer.WriteQName(data.GetName())
+        .Put16(static_cast<uint16_t>(data.GetType()))
+        .Put16(static_cast<uint16_t>(data.GetClass()))
+        .Put32(static_cast<uint32_t>(data.GetTtlSeconds()));
+
+    const size_t lengthOffset = output.Needed();
+    writer.Put16(0); // RDLENGTH, updated below
+    const size_t dataOffset = output.Needed();
+
+    // Names within the record data may point anywhere within the original
+    // packet, so they are re-written. Compression is still allowed as long
+    // as it points within this record.
+    switch (data.GetType())
+    {
+    case QType::SRV: {
+        SrvRecord srv;
+        VerifyOrReturnError(srv.Parse(data.GetData(), packet), CHIP_ERROR_INVALID_ARGUMENT);
+        writer.Put16(srv.GetPriority()).Put16(srv.GetWeight()).Put16(srv.GetPort()).WriteQName(srv.GetName());
+        break;
+    }
+    case QType::PTR: {
+        SerializedQNameIterator target;
+        VerifyOrReturnError(ParsePtrRecord(data.GetData(), packet, &target), CHIP_ERROR_INVALID_ARGUMENT);
+        writer.WriteQName(target);
+        break;
+    }
+    default:
+        writer.Put(data.GetData());
+        break;
+    }
+
+    VerifyOrReturnError(writer.Fit(), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    const size_t dataLength = output.Needed() - dataOffset;
+    VerifyOrReturnError(CanCastTo<uint16_t>(output.Needed()), CHIP_ERROR_BUFFER_TOO_SMALL);
+    Encoding::BigEndian::Put16(entry.record + lengthOffset, static_cast<uint16_t>(dataLength));
+
+    entry.recordLength = static_cast<uint16_t>(output.Needed());
+    return CHIP_NO_ERROR;
+}
+
+bool RecordCache::IsSameRecord(const Entry & a, const Entry & b)
+{
+    ResourceData dataA = a.Data();
+    ResourceData dataB = b.Data();
+
+    if ((dataA.GetType() != dataB.GetType()) || (dataA.GetName() != dataB.GetName()))
+    {
+        return false;
+    }
+
+    switch (dataA.GetType())
+    {
+    case QType::SRV:
+    case QType::TXT:
+        // A service instance has a single SRV and TXT record
+        return true;
+    case QType::PTR: {
+        SerializedQNameIterator targetA;
+        SerializedQNameIterator targetB;
+        return ParsePtrRecord(dataA.GetData(), a.Range(), &targetA) && ParsePtrRecord(dataB.GetData(), b.Range(), &targetB) &&
+            (targetA == targetB);
+    }
+    default:
+        // Hosts may have several addresses, each of them being a separate record
+        return SameBytes(dataA.GetData(), dataB.GetData());
+    }
+}
+
+bool RecordCache::IsKnownTarget(SerializedQNameIterator hostName) const
+{
+    for (size_t i = 0; i < kCacheSize; i++)
+    {
+        const Entry & entry = mEntries[i];
+        if (!entry.IsUsed())
+        {
+            continue;
+        }
+
+        ResourceData data = entry.Data();
+        SrvRecord srv;
+        if ((data.GetType() == QType::SRV) && srv.Parse(data.GetData(), entry.Range()) && (srv.GetName() == hostName))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void RecordCache::ExpireStale(System::Clock::Timestamp now)
+{
+    for (size_t i = 0; i < kCacheSize; i++)
+    {
+        Entry & entry = mEntries[i];
+        if (entry.IsUsed() && (entry.expiresAt <= now))
+        {
+            entry.recordLength = 0;
+            mStatistics.expirations++;
+        }
+    }
+}
+
+CHIP_ERROR RecordCache::AddRecord(Inet::InterfaceId interface, const ResourceData & data, const BytesRange & packet)
+{
+    VerifyOrReturnError(kCacheSize > 0, CHIP_ERROR_NO_MEMORY);
+
+    if (IsAddressRecord(data))
+    {
+        VerifyOrReturnError(IsKnownTarget(data.GetName()), CHIP_ERROR_NOT_FOUND);
+    }
+    else
+    {
+        VerifyOrReturnError(IsOperationalRecord(data), CHIP_ERROR_NOT_FOUND);
+    }
+
+    const System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
+    ExpireStale(now);
+
+    Entry received;
+    ReturnErrorOnFailure(Serialize(data, packet, received));
+
+    const uint64_t ttlSeconds = data.GetTtlSeconds();
+    const bool flushOthers    = (static_cast<uint16_t>(data.GetClass()) & kQClassResponseFlushBit) != 0;
+
+    received.interfaceId = interface;
+    received.insertedAt  = now;
+    received.refreshAt   = now + System::Clock::Milliseconds64(ttlSeconds * 800);
+    received.expiresAt   = now + System::Clock::Milliseconds64(ttlSeconds * 1000);
+
+    Entry * slot     = nullptr;
+    Entry * freeSlot = nullptr;
+    Entry * oldest   = nullptr;
+
+    for (size_t i = 0; i < kCacheSize; i++)
+    {
+        Entry & entry = mEntries[i];
+        if (!entry.IsUsed())
+        {
+            freeSlot = (freeSlot == nullptr) ? &entry : freeSlot;
+            continue;
+        }
+
+        if (IsSameRecord(entry, received))
+        {
+            slot = &entry;
+            continue;
+        }
+
+        if (flushOthers && (entry.insertedAt + kCacheFlushGracePeriod < now))
+        {
+            ResourceData existing = entry.Data();
+            if ((existing.GetType() == data.GetType()) && (existing.GetName() == data.GetName()))
+            {
+                entry.recordLength = 0;
+                mStatistics.expirations++;
+                freeSlot = (freeSlot == nullptr) ? &entry : freeSlot;
+                continue;
+            }
+        }
+
+        if ((oldest == nullptr) || (entry.expiresAt < oldest->expiresAt))
+        {
+            oldest = &entry;
+        }
+    }
+
+    if (ttlSeconds == 0)
+    {
+        // Goodbye packet: the record is no longer valid
+        if (slot != nullptr)
+        {
+            slot->recordLength = 0;
+            mStatistics.expirations++;
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    if (slot != nullptr)
+    {
+        mStatistics.refreshes++;
+    }
+    else if (freeSlot != nullptr)
+    {
+        slot = freeSlot;
+        mStatistics.insertions++;
+    }
+    else
+    {
+        // Drop whatever was going to expire first
+        slot = oldest;
+        mStatistics.insertions++;
+        mStatistics.evictions++;
+    }
+
+    *slot = received;
+    return CHIP_NO_ERROR;
+}
+
+template <typename Predicate>
+void RecordCache::ForgetMatching(Predicate predicate)
+{
+    for (size_t i = 0; i < kCacheSize; i++)
+    {
+        Entry & entry = mEntries[i];
+        if (entry.IsUsed() && predicate(entry))
+        {
+            entry.recordLength = 0;
+            mStatistics.flushes++;
+        }
+    }
+}
+
+void RecordCache::Forget(const PeerId & peerId)
+{
+    char instanceName[kMaxOperationalServiceNameSize];
+    VerifyOrReturn(MakeInstanceName(instanceName, sizeof(instanceName), peerId) == CHIP_NO_ERROR);
+
+    const QNamePart instanceQName[] = { instanceName, kOperationalServiceName, kOperationalProtocol, kLocalDomain };
+    const FullQName serviceName(instanceQName);
+
+    // Addresses go first, while the SRV records naming their host are still around.
+    for (size_t i = 0; i < kCacheSize; i++)
+    {
+        const Entry & service = mEntries[i];
+        if (!service.IsUsed())
+        {
+            continue;
+        }
+
+        ResourceData data = service.Data();
+        SrvRecord srv;
+        if ((data.GetType() != QType::SRV) || (data.GetName() != serviceName) || !srv.Parse(data.GetData(), service.Range()))
+        {
+            continue;
+        }
+
+        ForgetMatching([&srv](const Entry & entry) {
+            ResourceData address = entry.Data();
+            return IsAddressRecord(address) && (address.GetName() == srv.GetName());
+        });
+    }
+
+    ForgetMatching([&serviceName](const Entry & entry) {
+        ResourceData data = entry.Data();
+        return ((data.GetType() == QType::SRV) || (data.GetType() == QType::TXT)) && (data.GetName() == serviceName);
+    });
+}
+
+void RecordCache::ForgetAddress(const char * hostName, const Inet::IPAddress & address)
+{
+    const QNamePart hostQName[] = { hostName, kLocalDomain };
+    const FullQName host(hostQName);
+
+    ForgetMatching([&host, &address](const Entry & entry) {
+        ResourceData data = entry.Data();
+        Inet::IPAddress cached;
+        bool parsed = ((data.GetType() == QType::A) && ParseARecord(data.GetData(), &cached)) ||
+            ((data.GetType() == QType::AAAA) && ParseAAAARecord(data.GetData(), &cached));
+        return parsed && (cached == address) && (data.GetName() == host);
+    });
+}
+
+bool RecordCache::Lookup(const PeerId & peerId, IncrementalResolver & resolver)
+{
+    MATTER_TRACE_SCOPE("Lookup", "RecordCache");
+
+    const System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
+    ExpireStale(now);
+
+    char instanceName[kMaxOperationalServiceNameSize];
+    if (MakeInstanceName(instanceName, sizeof(instanceName), peerId) != CHIP_NO_ERROR)
+    {
+        mStatistics.misses++;
+        return false;
+    }
+
+    const QNamePart instanceQName[] = { instanceName, kOperationalServiceName, kOperationalProtocol, kLocalDomain };
+    const FullQName serviceName(instanceQName);
+
+    for (size_t i = 0; (i < kCacheSize) && !resolver.IsActive(); i++)
+    {
+        const Entry & entry = mEntries[i];
+        if (!entry.IsUsed() || (entry.refreshAt <= now))
+        {
+            continue;
+        }
+
+        ResourceData data = entry.Data();
+        SrvRecord srv;
+        if ((data.GetType() != QType::SRV) || (data.GetName() != serviceName) || !srv.Parse(data.GetData(), entry.Range()))
+        {
+            continue;
+        }
+
+        if (resolver.InitializeParsing(data.GetName(), srv) != CHIP_NO_ERROR)
+        {
+            break;
+        }
+    }
+
+    if (!resolver.IsActive())
+    {
+        mStatistics.misses++;
+        return false;
+    }
+
+    for (size_t i = 0; i < kCacheSize; i++)
+    {
+        const Entry & entry = mEntries[i];
+        if (!entry.IsUsed())
+        {
+            continue;
+        }
+
+        // TXT data is optional (defaults apply), so it is used for its whole
+        // lifetime. Addresses are what makes a resolve succeed and must be fresh.
+        ResourceData data = entry.Data();
+        if ((data.GetType() != QType::TXT) && (entry.refreshAt <= now))
+        {
+            continue;
+        }
+
+        // Errors are expected here (e.g. addresses on more interfaces than
+        // the resolver supports) and are not fatal as long as some data is found.
+        resolver.OnRecord(entry.interfaceId, data, entry.Range());
+    }
+
+    if (resolver.GetMissingRequiredInformation().HasAny())
+    {
+        resolver.ResetToInactive();
+        mStatistics.misses++;
+        return false;
+    }
+
+    mStatistics.hits++;
+    return true;
+}
+
+} // namespace Dnssd
+} // namespace chip
@@ -0,0 +1,139 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <inet/InetInterface.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/PeerId.h>
+#include <lib/dnssd/IncrementalResolve.h>
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <system/SystemClock.h>
+
+namespace chip {
+namespace Dnssd {
+
+/// Keeps operational DNS-SD resource records (PTR/SRV/TXT/A/AAAA) that were
+/// seen on the network for the duration of their TTL.
+///
+/// Records are fed from every received mDNS response, including unsolicited
+/// announcements, and are stored in uncompressed wire format so that they can
+/// be replayed through an `IncrementalResolver` without any network traffic.
+///
+/// Following RFC 6762 section 5.2, data is only considered fresh enough to
+/// answer a resolve until 80% of its TTL has elapsed; after that the resolver
+/// is expected to query (and the response will refresh the cache).
+class RecordCache
+{
+public:
+    static constexpr size_t kCacheSize     = CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE;
+    static constexpr size_t kMaxRecordSize = CHIP_CONFIG_MINMDNS_RECORD_CACHE_MAX_RECORD_SIZE;
+
+    struct Statistics
+    {
+        uint32_t hits        = 0; // lookups answered fully from the cache
+        uint32_t misses      = 0; // lookups that require a network query
+        uint32_t insertions  = 0; // new records stored
+        uint32_t refreshes   = 0; // already known records whose TTL was renewed
+        uint32_t evictions   = 0; // still valid records dropped to make room
+        uint32_t expirations = 0; // records dropped because of TTL expiry or goodbye packets
+        uint32_t flushes     = 0; // records dropped because they were reported as not working
+    };
+
+    RecordCache(chip::System::Clock::ClockBase * clock) : mClock(clock) { Clear(); }
+
+    /// Forget all cached records. Statistics are preserved.
+    void Clear();
+
+    /// Remember all relevant records contained in the given mDNS packet.
+    ///
+    /// Queries are ignored. Records that do not belong to an operational
+    /// service (or to a host providing one) are ignored as well, since minmdns
+    /// receives all mDNS traffic of the network.
+    void ObservePacket(chip::Inet::InterfaceId interface, const mdns::Minimal::BytesRange & packet);
+
+    /// Remember a single resource record.
+    ///
+    /// [packet] is the range of valid data for the purpose of QName parsing.
+    CHIP_ERROR AddRecord(chip::Inet::InterfaceId interface, const mdns::Minimal::ResourceData & data,
+                         const mdns::Minimal::BytesRange & packet);
+
+    /// Feed all fresh records for the given operational peer into [resolver].
+    ///
+    /// Returns true if the cached data was sufficient to fully resolve the peer
+    /// (i.e. `GetMissingRequiredInformation()` of the resolver is empty). On
+    /// false, [resolver] is left inactive.
+    bool Lookup(const chip::PeerId & peerId, IncrementalResolver & resolver);
+
+    /// Drop the SRV and TXT records of the given operational peer, along with
+    /// the addresses of its host, so that the next lookup misses.
+    ///
+    /// Used when a resolve is retried because the cached data did not work
+    /// (e.g. no session could be established with the resolved address).
+    void Forget(const chip::PeerId & peerId);
+
+    /// Drop the given address of the host `<hostName>.local`.
+    void ForgetAddress(const char * hostName, const chip::Inet::IPAddress & address);
+
+    /// Number of records currently held (including not yet swept expired ones).
+    size_t Count() const;
+
+    const Statistics & GetStatistics() const { return mStatistics; }
+
+private:
+    struct Entry
+    {
+        chip::System::Clock::Timestamp insertedAt;
+        chip::System::Clock::Timestamp refreshAt; // no longer fresh after this time
+        chip::System::Clock::Timestamp expiresAt;
+        chip::Inet::InterfaceId interfaceId;
+        uint16_t recordLength = 0; // 0 means the entry is unused
+        uint8_t record[kMaxRecordSize];
+
+        bool IsUsed() const { return recordLength != 0; }
+        mdns::Minimal::BytesRange Range() const { return mdns::Minimal::BytesRange(record, record + recordLength); }
+
+        /// Parses the stored record. Always succeeds for used entries as the
+        /// content was validated when stored.
+        mdns::Minimal::ResourceData Data() const;
+    };
+
+    /// Serialize [data] into [entry] with all QNames expanded.
+    static CHIP_ERROR Serialize(const mdns::Minimal::ResourceData & data, const mdns::Minimal::BytesRange & packet,
+                                Entry & entry);
+
+    /// Determines if two entries describe the same record (i.e. one should replace the other).
+    static bool IsSameRecord(const Entry & a, const Entry & b);
+
+    /// Determines if [hostName] is the target of any cached SRV record.
+    bool IsKnownTarget(mdns::Minimal::SerializedQNameIterator hostName) const;
+
+    void ExpireStale(chip::System::Clock::Timestamp now);
+
+    /// Drop all entries whose data matches [predicate].
+    template <typename Predicate>
+    void ForgetMatching(Predicate predicate);
+
+    chip::System::Clock::ClockBase * mClock;
+    Statistics mStatistics;
+    Entry mEntries[kCacheSize > 0 ? kCacheSize : 1];
+};
+
+} // namespace Dnssd
+} // namespace chip
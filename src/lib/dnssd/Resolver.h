@@ -426,7 +426,8 @@ public:
     /**
      * Requests resolution of the given operational node service.
      *
-     * This will trigger a DNSSD query.
+     * This will trigger a DNSSD query, unless the implementation still has
+     * fresh cached records for the node (see ForgetNodeId).
      *
      * When the operation succeeds or fails, and a resolver delegate has been registered,
      * the result of the operation is passed to the delegate's `OnOperationalNodeResolved` or
@@ -461,6 +462,15 @@ public:
      */
     virtual void NodeIdResolutionNoLongerNeeded(const PeerId & peerId) = 0;
 
+    /**
+     * Drop any records cached for the given operational node, so that the next
+     * ResolveNodeId for it queries the network.
+     *
+     * Used when previously resolved data did not work, e.g. because no session
+     * could be established with the resolved address.
+     */
+    virtual void ForgetNodeId(const PeerId & peerId) {}
+
     /**
      * Finds all commissionable nodes matching the given filter.
      *
@@ -22,7 +22,9 @@
 #include <lib/core/CHIPConfig.h>
 #include <lib/dnssd/ActiveResolveAttempts.h>
 #include <lib/dnssd/IncrementalResolve.h>
+#include <lib/dnssd/IncrementalResolverPool.h>
 #include <lib/dnssd/MinimalMdnsServer.h>
+#include <lib/dnssd/RecordCache.h>
 #include <lib/dnssd/ServiceNaming.h>
 #include <lib/dnssd/minimal_mdns/Logging.h>
 #include <lib/dnssd/minimal_mdns/Parser.h>
@@ -55,7 +57,8 @@ using namespace mdns::Minimal;
 class PacketParser : private ParserDelegate
 {
 public:
-    PacketParser(ActiveResolveAttempts & activeResolves) : mActiveResolves(activeResolves) {}
+    PacketParser(ActiveResolveAttempts & activeResolves) : mActiveResolves(activeResolves), mResolvers(kMinMdnsNumParallelResolvers)
+    {}
 
     /// Goes through the given SRV records within a response packet
     /// and sets up data resolution
@@ -67,8 +70,8 @@ public:
     /// Must be called AFTER ParseSrvRecords has been called.
     void ParseNonSrvRecords(Inet::InterfaceId interface, const BytesRange & packet);
 
-    IncrementalResolver * ResolverBegin() { return mResolvers; }
-    IncrementalResolver * ResolverEnd() { return mResolvers + kMinMdnsNumParallelResolvers; }
+    IncrementalResolver * ResolverBegin() { return mResolvers.begin(); }
+    IncrementalResolver * ResolverEnd() { return mResolvers.end(); }
 
 private:
     // ParserDelegate implementation
@@ -84,7 +87,7 @@ private:
 
     /// Called IFF parsing state is in RecordParsing
     ///
-    /// Forwards the resource to all active resolvers.
+    /// Forwards the resource to all active resolvers that may be interested in it.
     void ParseResource(const ResourceData & data);
 
     enum class RecordParsingState
@@ -94,7 +97,11 @@ private:
         kRecordParsing,
     };
 
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+    static constexpr size_t kMinMdnsNumParallelResolvers = CHIP_CONFIG_MINMDNS_MAX_DYNAMIC_RESOLVES;
+#else
     static constexpr size_t kMinMdnsNumParallelResolvers = CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES;
+#endif
 
     // Individual parse set
     bool mIsResponse               = false;
@@ -104,7 +111,7 @@ private:
 
     // resolvers kept between parse steps
     ActiveResolveAttempts & mActiveResolves;
-    IncrementalResolver mResolvers[kMinMdnsNumParallelResolvers];
+    IncrementalResolverPool mResolvers;
 };
 
 void PacketParser::OnHeader(ConstHeaderRef & header)
@@ -161,27 +168,23 @@ void PacketParser::OnResource(ResourceType type, const ResourceData & data)
 
 void PacketParser::ParseResource(const ResourceData & data)
 {
-    for (auto & resolver : mResolvers)
-    {
-        if (resolver.IsActive())
-        {
-            CHIP_ERROR err = resolver.OnRecord(mInterfaceId, data, mPacketRange);
+    mResolvers.ForEachCandidate(data.GetName(), [this, &data](IncrementalResolver & resolver) {
+        CHIP_ERROR err = resolver.OnRecord(mInterfaceId, data, mPacketRange);
 
-            //
-            // CHIP_ERROR_NO_MEMORY usually gets returned when we have no more memory available to hold the
-            // resolved data. This gets emitted fairly frequently in dense environments or when receiving records
-            // from devices with lots of interfaces. Consequently, don't log that unless we have DNS verbosity
-            // logging enabled.
-            //
-            if (err != CHIP_NO_ERROR)
-            {
+        //
+        // CHIP_ERROR_NO_MEMORY usually gets returned when we have no more memory available to hold the
+        // resolved data. This gets emitted fairly frequently in dense environments or when receiving records
+        // from devices with lots of interfaces. Consequently, don't log that unless we have DNS verbosity
+        // logging enabled.
+        //
+        if (err != CHIP_NO_ERROR)
+        {
 #if !CHIP_MINMDNS_HIGH_VERBOSITY
-                if (err != CHIP_ERROR_NO_MEMORY)
+            if (err != CHIP_ERROR_NO_MEMORY)
 #endif
-                    ChipLogError(Discovery, "DNSSD parse error: %" CHIP_ERROR_FORMAT, err.Format());
-            }
+                ChipLogError(Discovery, "DNSSD parse error: %" CHIP_ERROR_FORMAT, err.Format());
         }
-    }
+    });
 
     // Once an IP address is received, stop requesting it.
     if (data.GetType() == QType::AAAA)
@@ -199,40 +202,26 @@ void PacketParser::ParseSRVResource(const ResourceData & data)
         return;
     }
 
-    for (auto & resolver : mResolvers)
+    CHIP_ERROR err = mResolvers.InitializeParsing(data.GetName(), srv);
+    if (err == CHIP_ERROR_INCORRECT_STATE)
     {
-        if (resolver.IsActive() && (resolver.GetRecordName() == data.GetName()))
-        {
-            ChipLogDetail(Discovery, "SRV record already actively processed.");
-            return;
-        }
+        ChipLogDetail(Discovery, "SRV record already actively processed.");
     }
-
-    for (auto & resolver : mResolvers)
+    else if (err == CHIP_ERROR_NO_MEMORY)
     {
-        if (resolver.IsActive())
-        {
-            continue;
-        }
-
-        CHIP_ERROR err = resolver.InitializeParsing(data.GetName(), srv);
-        if (err != CHIP_NO_ERROR)
-        {
-            // Receiving records that we do not need to parse is normal:
-            // MinMDNS may receive all DNSSD packets on the network, only
-            // interested in a subset that is matter-specific
-#ifdef MINMDNS_RESOLVER_OVERLY_VERBOSE
-            ChipLogError(Discovery, "Could not start SRV record processing: %" CHIP_ERROR_FORMAT, err.Format());
+#if CHIP_MINMDNS_HIGH_VERBOSITY
+        ChipLogError(Discovery, "Insufficient parsers to process all SRV entries.");
 #endif
-        }
-
-        // Done finding an inactive resolver and attempting to use it.
-        return;
     }
-
-#if CHIP_MINMDNS_HIGH_VERBOSITY
-    ChipLogError(Discovery, "Insufficient parsers to process all SRV entries.");
+    else if (err != CHIP_NO_ERROR)
+    {
+        // Receiving records that we do not need to parse is normal:
+        // MinMDNS may receive all DNSSD packets on the network, only
+        // interested in a subset that is matter-specific
+#ifdef MINMDNS_RESOLVER_OVERLY_VERBOSE
+        ChipLogError(Discovery, "Could not start SRV record processing: %" CHIP_ERROR_FORMAT, err.Format());
 #endif
+    }
 }
 
 void PacketParser::ParseSrvRecords(const BytesRange & packet)
@@ -241,6 +230,7 @@ void PacketParser::ParseSrvRecords(const BytesRange & packet)
 
     mParsingState = RecordParsingState::kSrvInitialization;
     mPacketRange  = packet;
+    mResolvers.BeginPacket();
 
     if (!ParsePacket(packet, this))
     {
@@ -269,7 +259,9 @@ void PacketParser::ParseNonSrvRecords(Inet::InterfaceId interface, const BytesRa
 class MinMdnsResolver : public Resolver, public MdnsPacketDelegate
 {
 public:
-    MinMdnsResolver() : mActiveResolves(&chip::System::SystemClock()), mPacketParser(mActiveResolves)
+    MinMdnsResolver() :
+        mActiveResolves(&chip::System::SystemClock(), kMaxActiveResolves), mPacketParser(mActiveResolves),
+        mRecordCache(&chip::System::SystemClock())
     {
         GlobalMinimalMdnsServer::Instance().SetResponseDelegate(this);
     }
@@ -285,17 +277,32 @@ public:
     void SetOperationalDelegate(OperationalResolveDelegate * delegate) override { mOperationalDelegate = delegate; }
     CHIP_ERROR ResolveNodeId(const PeerId & peerId) override;
     void NodeIdResolutionNoLongerNeeded(const PeerId & peerId) override;
+    void ForgetNodeId(const PeerId & peerId) override { mRecordCache.Forget(peerId); }
     CHIP_ERROR DiscoverCommissionableNodes(DiscoveryFilter filter, DiscoveryContext & context) override;
     CHIP_ERROR DiscoverCommissioners(DiscoveryFilter filter, DiscoveryContext & context) override;
     CHIP_ERROR StopDiscovery(DiscoveryContext & context) override;
     CHIP_ERROR ReconfirmRecord(const char * hostname, Inet::IPAddress address, Inet::InterfaceId interfaceId) override;
 
 private:
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+    static constexpr size_t kMaxActiveResolves = CHIP_CONFIG_MINMDNS_MAX_DYNAMIC_RESOLVES;
+#else
+    static constexpr size_t kMaxActiveResolves = ActiveResolveAttempts::kRetryQueueSize;
+#endif
+
     OperationalResolveDelegate * mOperationalDelegate = nullptr;
     DiscoveryContext * mDiscoveryContext              = nullptr;
     System::Layer * mSystemLayer                      = nullptr;
     ActiveResolveAttempts mActiveResolves;
     PacketParser mPacketParser;
+    RecordCache mRecordCache;
+
+    // Operational resolves answered from mRecordCache. Delegates are called
+    // asynchronously as callers expect ResolveNodeId to return before results
+    // are reported.
+    static constexpr size_t kMaxPendingCachedResolves = CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES;
+    ResolvedNodeData mPendingCachedResolves[kMaxPendingCachedResolves];
+    size_t mPendingCachedResolveCount = 0;
 
     void SetDiscoveryContext(DiscoveryContext * context);
     void ScheduleIpAddressResolve(SerializedQNameIterator hostName);
@@ -306,6 +313,12 @@ private:
     /// Prepare a query for the given schedule attempt
     CHIP_ERROR BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt & attempt);
 
+    /// Sets up `builder` with a new, empty, query packet
+    CHIP_ERROR StartQueryPacket(QueryBuilder & builder);
+
+    /// Sends the queries in `builder`, if any.
+    CHIP_ERROR SendQueryPacket(QueryBuilder & builder, bool unicastAnswers);
+
     /// Prepare a query for specific resolve types
     CHIP_ERROR BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt::Browse & data, bool firstSend);
     CHIP_ERROR BuildQuery(QueryBuilder & builder, const ActiveResolveAttempts::ScheduledAttempt::Resolve & data, bool firstSend);
@@ -317,6 +330,13 @@ private:
 
     static void RetryCallback(System::Layer *, void * self);
 
+    /// Attempt to answer an operational resolve from mRecordCache.
+    ///
+    /// Returns true if the result was scheduled for delivery to the operational delegate.
+    bool ResolveFromCache(const PeerId & peerId);
+    void ReportCachedResolves();
+    static void CachedResolvesCallback(System::Layer *, void * self);
+
     CHIP_ERROR BrowseNodes(DiscoveryType type, DiscoveryFilter subtype);
     template <typename... Args>
     mdns::Minimal::FullQName CheckAndAllocateQName(Args &&... parts)
@@ -471,6 +491,9 @@ void MinMdnsResolver::OnMdnsPacketData(const BytesRange & data, const chip::Inet
 {
     MATTER_TRACE_SCOPE("Received MDNS Packet", "MinMdnsResolver");
 
+    // Passively learn records, including unsolicited announcements
+    mRecordCache.ObservePacket(info->Interface, data);
+
     // Fill up any relevant data
     mPacketParser.ParseSrvRecords(data);
     mPacketParser.ParseNonSrvRecords(info->Interface, data);
@@ -501,6 +524,13 @@ bool MinMdnsResolver::IsInitialized()
 
 void MinMdnsResolver::Shutdown()
 {
+    if (mSystemLayer != nullptr)
+    {
+        mSystemLayer->CancelTimer(&CachedResolvesCallback, this);
+    }
+    mPendingCachedResolveCount = 0;
+    mRecordCache.Clear();
+
     GlobalMinimalMdnsServer::Instance().ShutdownServer();
 }
 
@@ -557,8 +587,8 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
         .SetAnswerViaUnicast(firstSend) //
         ;
 
+    ReturnErrorCodeIf(!builder.TryAddQuery(query), CHIP_ERROR_BUFFER_TOO_SMALL);
     mdns::Minimal::Logging::LogSendingQuery(query);
-    builder.AddQuery(query);
 
     return CHIP_NO_ERROR;
 }
@@ -580,8 +610,8 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
         .SetAnswerViaUnicast(firstSend) //
         ;
 
+    ReturnErrorCodeIf(!builder.TryAddQuery(query), CHIP_ERROR_BUFFER_TOO_SMALL);
     mdns::Minimal::Logging::LogSendingQuery(query);
-    builder.AddQuery(query);
 
     return CHIP_NO_ERROR;
 }
@@ -598,8 +628,8 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
         .SetAnswerViaUnicast(firstSend) //
         ;
 
+    ReturnErrorCodeIf(!builder.TryAddQuery(query), CHIP_ERROR_BUFFER_TOO_SMALL);
     mdns::Minimal::Logging::LogSendingQuery(query);
-    builder.AddQuery(query);
 
     return CHIP_NO_ERROR;
 }
@@ -627,8 +657,39 @@ CHIP_ERROR MinMdnsResolver::BuildQuery(QueryBuilder & builder, const ActiveResol
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR MinMdnsResolver::StartQueryPacket(QueryBuilder & builder)
+{
+    System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kMdnsMaxPacketSize);
+    ReturnErrorCodeIf(buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+    builder.Reset(std::move(buffer));
+    builder.Header().SetMessageId(0);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR MinMdnsResolver::SendQueryPacket(QueryBuilder & builder, bool unicastAnswers)
+{
+    if (!builder.HasPacketBuffer() || (builder.QueryCount() == 0))
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    if (unicastAnswers)
+    {
+        return GlobalMinimalMdnsServer::Server().BroadcastUnicastQuery(builder.ReleasePacket(), kMdnsPort);
+    }
+
+    return GlobalMinimalMdnsServer::Server().BroadcastSend(builder.ReleasePacket(), kMdnsPort);
+}
+
 CHIP_ERROR MinMdnsResolver::SendAllPendingQueries()
 {
+    // Queries are packed into as few packets as possible. Initial queries
+    // request unicast answers and are sent separately from retries.
+    QueryBuilder unicastBuilder;
+    QueryBuilder multicastBuilder;
+
     while (true)
     {
         Optional<ActiveResolveAttempts::ScheduledAttempt> resolve = mActiveResolves.NextScheduled();
@@ -638,24 +699,28 @@ CHIP_ERROR MinMdnsResolver::SendAllPendingQueries()
             break;
         }
 
-        System::PacketBufferHandle buffer = System::PacketBufferHandle::New(kMdnsMaxPacketSize);
-        ReturnErrorCodeIf(buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
-
-        QueryBuilder builder(std::move(buffer));
-        builder.Header().SetMessageId(0);
-
-        ReturnErrorOnFailure(BuildQuery(builder, resolve.Value()));
+        const bool unicastAnswers = resolve.Value().firstSend;
+        QueryBuilder & builder    = unicastAnswers ? unicastBuilder : multicastBuilder;
 
-        if (resolve.Value().firstSend)
+        if (!builder.HasPacketBuffer())
         {
-            ReturnErrorOnFailure(GlobalMinimalMdnsServer::Server().BroadcastUnicastQuery(builder.ReleasePacket(), kMdnsPort));
+            ReturnErrorOnFailure(StartQueryPacket(builder));
         }
-        else
+
+        CHIP_ERROR err = BuildQuery(builder, resolve.Value());
+        if (err == CHIP_ERROR_BUFFER_TOO_SMALL && builder.QueryCount() > 0)
         {
-            ReturnErrorOnFailure(GlobalMinimalMdnsServer::Server().BroadcastSend(builder.ReleasePacket(), kMdnsPort));
+            // Current packet is full: send it and retry in a new one
+            ReturnErrorOnFailure(SendQueryPacket(builder, unicastAnswers));
+            ReturnErrorOnFailure(StartQueryPacket(builder));
+            err = BuildQuery(builder, resolve.Value());
         }
+        ReturnErrorOnFailure(err);
     }
 
+    ReturnErrorOnFailure(SendQueryPacket(unicastBuilder, /* unicastAnswers = */ true));
+    ReturnErrorOnFailure(SendQueryPacket(multicastBuilder, /* unicastAnswers = */ false));
+
     ExpireIncrementalResolvers();
 
     return ScheduleRetries();
@@ -710,7 +775,12 @@ CHIP_ERROR MinMdnsResolver::StopDiscovery(DiscoveryContext & context)
 
 CHIP_ERROR MinMdnsResolver::ReconfirmRecord(const char * hostname, Inet::IPAddress address, Inet::InterfaceId interfaceId)
 {
-    return CHIP_ERROR_NOT_IMPLEMENTED;
+    VerifyOrReturnError(hostname != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    // minmdns has no daemon to verify the record with: dropping it from the cache makes the
+    // next resolve query the network, which refreshes the record if it is still valid.
+    mRecordCache.ForgetAddress(hostname, address);
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR MinMdnsResolver::BrowseNodes(DiscoveryType type, DiscoveryFilter filter)
@@ -722,6 +792,11 @@ CHIP_ERROR MinMdnsResolver::BrowseNodes(DiscoveryType type, DiscoveryFilter filt
 
 CHIP_ERROR MinMdnsResolver::ResolveNodeId(const PeerId & peerId)
 {
+    if (ResolveFromCache(peerId))
+    {
+        return CHIP_NO_ERROR;
+    }
+
     mActiveResolves.MarkPending(peerId);
 
     return SendAllPendingQueries();
@@ -754,6 +829,65 @@ void MinMdnsResolver::RetryCallback(System::Layer *, void * self)
     reinterpret_cast<MinMdnsResolver *>(self)->SendAllPendingQueries();
 }
 
+bool MinMdnsResolver::ResolveFromCache(const PeerId & peerId)
+{
+    VerifyOrReturnValue(mSystemLayer != nullptr, false);
+    VerifyOrReturnValue(mPendingCachedResolveCount < kMaxPendingCachedResolves, false);
+
+    IncrementalResolver resolver;
+    if (!mRecordCache.Lookup(peerId, resolver))
+    {
+        return false;
+    }
+
+    if (resolver.Take(mPendingCachedResolves[mPendingCachedResolveCount]) != CHIP_NO_ERROR)
+    {
+        return false;
+    }
+
+    if (mPendingCachedResolveCount == 0)
+    {
+        if (mSystemLayer->ScheduleWork(&CachedResolvesCallback, this) != CHIP_NO_ERROR)
+        {
+            return false;
+        }
+    }
+
+    mPendingCachedResolveCount++;
+
+    MATTER_TRACE_INSTANT("Record cache hit", "MinMdnsResolver");
+    ChipLogDetail(Discovery, "Resolved " ChipLogFormatX64 ":" ChipLogFormatX64 " from DNSSD record cache",
+                  ChipLogValueX64(peerId.GetCompressedFabricId()), ChipLogValueX64(peerId.GetNodeId()));
+
+    return true;
+}
+
+void MinMdnsResolver::ReportCachedResolves()
+{
+    // Delegates may issue new resolves, so grab the results before calling them.
+    ResolvedNodeData results[kMaxPendingCachedResolves];
+    const size_t count = mPendingCachedResolveCount;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        results[i] = mPendingCachedResolves[i];
+    }
+    mPendingCachedResolveCount = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (mOperationalDelegate != nullptr)
+        {
+            mOperationalDelegate->OnOperationalNodeResolved(results[i]);
+        }
+    }
+}
+
+void MinMdnsResolver::CachedResolvesCallback(System::Layer *, void * self)
+{
+    reinterpret_cast<MinMdnsResolver *>(self)->ReportCachedResolves();
+}
+
 MinMdnsResolver gResolver;
 
 } // namespace
@@ -157,6 +157,8 @@ bool ParsePacket(const BytesRange & packetData, ParserDelegate * delegate)
 
     {
         QueryData queryData;
+        queryData.SetHasKnownAnswers(header.GetAnswerCount() != 0);
+
         for (uint16_t i = 0; i < header.GetQueryCount(); i++)
         {
             if (!queryData.Parse(packetData, &data))
@@ -49,6 +49,11 @@ public:
     bool IsAnnounceBroadcast() const { return mIsAnnounceBroadcast; }
     void SetIsAnnounceBroadcast(bool isAnnounceBroadcast) { mIsAnnounceBroadcast = isAnnounceBroadcast; }
 
+    /// Set when the packet containing this query also lists answers the
+    /// querier already knows about (RFC 6762 section 7.1).
+    bool HasKnownAnswers() const { return mHasKnownAnswers; }
+    void SetHasKnownAnswers(bool hasKnownAnswers) { mHasKnownAnswers = hasKnownAnswers; }
+
     SerializedQNameIterator GetName() const { return mNameIterator; }
 
     /// Parses a query structure
@@ -70,6 +75,7 @@ private:
     /// Flag as an internal broadcast, controls reply construction (e.g. no
     /// filtering applied)
     bool mIsAnnounceBroadcast = false;
+    bool mHasKnownAnswers     = false;
 };
 
 class ResourceData
@@ -25,11 +25,18 @@
 namespace mdns {
 namespace Minimal {
 
+/// Writes MDNS queries into a given packet buffer.
+///
+/// Multiple queries may be written into the same packet, in which case
+/// common name suffixes are compressed.
 class QueryBuilder
 {
 public:
-    QueryBuilder() : mHeader(nullptr) {}
-    QueryBuilder(chip::System::PacketBufferHandle && packet) : mHeader(nullptr) { Reset(std::move(packet)); }
+    QueryBuilder() : mHeader(nullptr), mEndianOutput(nullptr, 0), mWriter(&mEndianOutput) {}
+    QueryBuilder(chip::System::PacketBufferHandle && packet) : mHeader(nullptr), mEndianOutput(nullptr, 0), mWriter(&mEndianOutput)
+    {
+        Reset(std::move(packet));
+    }
 
     QueryBuilder & Reset(chip::System::PacketBufferHandle && packet)
     {
@@ -40,6 +47,7 @@ public:
         {
             mPacket->SetDataLength(HeaderRef::kSizeBytes);
             mHeader.Clear();
+            mQueryBuildOk = true;
         }
         else
         {
@@ -47,6 +55,13 @@ public:
         }
 
         mHeader.SetFlags(mHeader.GetFlags().SetQuery());
+
+        mEndianOutput =
+            chip::Encoding::BigEndian::BufferWriter(mPacket->Start(), mPacket->DataLength() + mPacket->AvailableDataLength());
+        mEndianOutput.Skip(mPacket->DataLength());
+
+        mWriter.Reset();
+
         return *this;
     }
 
@@ -62,30 +77,53 @@ public:
 
     QueryBuilder & AddQuery(const Query & query)
     {
-        if (!mQueryBuildOk)
+        if (mQueryBuildOk && !TryAddQuery(query))
         {
-            return *this;
+            mQueryBuildOk = false;
         }
+        return *this;
+    }
 
-        chip::Encoding::BigEndian::BufferWriter out(mPacket->Start() + mPacket->DataLength(), mPacket->AvailableDataLength());
-        RecordWriter writer(&out);
-
-        if (!query.Append(mHeader, writer))
+    /// Attempts to add a query to the current packet buffer.
+    ///
+    /// On success, the packet buffer data length and header query count are updated.
+    /// On failure (e.g. the query does not fit), the packet is left unchanged and
+    /// the builder remains usable, so that the caller may send the current packet
+    /// and add the query to a new one.
+    bool TryAddQuery(const Query & query)
+    {
+        if (!mQueryBuildOk)
         {
-            mQueryBuildOk = false;
+            return false;
         }
-        else
+
+        const size_t committedLength = mPacket->DataLength();
+        const RecordWriter committedWriter(mWriter);
+
+        if (!query.Append(mHeader, mWriter))
         {
-            mPacket->SetDataLength(static_cast<uint16_t>(mPacket->DataLength() + out.Needed()));
+            // Discard any partial write, including qname compression
+            // offsets that may point into the discarded data.
+            mWriter = committedWriter;
+            mEndianOutput =
+                chip::Encoding::BigEndian::BufferWriter(mPacket->Start(), mPacket->DataLength() + mPacket->AvailableDataLength());
+            mEndianOutput.Skip(committedLength);
+            return false;
         }
-        return *this;
+
+        mPacket->SetDataLength(static_cast<uint16_t>(mEndianOutput.Needed()));
+        return true;
     }
 
     bool Ok() const { return mQueryBuildOk; }
+    bool HasPacketBuffer() const { return !mPacket.IsNull(); }
+    uint16_t QueryCount() const { return mHeader.GetQueryCount(); }
 
 private:
     chip::System::PacketBufferHandle mPacket;
     HeaderRef mHeader;
+    chip::Encoding::BigEndian::BufferWriter mEndianOutput;
+    RecordWriter mWriter;
     bool mQueryBuildOk = true;
 };
 
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <lib/support/Span.h>
 #include <system/SystemPacketBuffer.h>
 
 #include <lib/dnssd/minimal_mdns/Parser.h>
@@ -123,6 +124,9 @@ public:
     bool Ok() const { return mBuildOk; }
     bool HasPacketBuffer() const { return !mPacket.IsNull(); }
 
+    /// Data written into the packet so far. Only valid while a packet buffer is held.
+    chip::ByteSpan PacketData() const { return chip::ByteSpan(mPacket->Start(), mPacket->DataLength()); }
+
 private:
     chip::System::PacketBufferHandle mPacket;
     HeaderRef mHeader;
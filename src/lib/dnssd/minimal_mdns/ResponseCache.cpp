@@ -0,0 +1,170 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "ResponseCache.h"
+
+#include <string.h>
+
+namespace mdns {
+namespace Minimal {
+
+bool ResponseCache::Key::Set(chip::Inet::InterfaceId interfaceId, const QueryData & query, bool includeQuery,
+                             chip::Optional<uint32_t> ttlSecondsOverride)
+{
+    // FNV-1a over the uncompressed name. Names are compared case sensitively
+    // since the reply echoes the question as it was received.
+    constexpr uint32_t kPrime = 16777619u;
+    uint32_t hash             = 2166136261u;
+    size_t length             = 0;
+
+    SerializedQNameIterator name = query.GetName();
+    while (name.Next())
+    {
+        const size_t labelLength = strlen(name.Value());
+        VerifyOrReturnValue(length + 1 + labelLength <= kMaxNameLength, false);
+
+        mName[length++] = static_cast<uint8_t>(labelLength);
+        memcpy(&mName[length], name.Value(), labelLength);
+        length += labelLength;
+    }
+    VerifyOrReturnValue(name.IsValid(), false);
+
+    for (size_t i = 0; i < length; i++)
+    {
+        hash = (hash ^ mName[i]) * kPrime;
+    }
+
+    mInterfaceId        = interfaceId;
+    mTtlSecondsOverride = ttlSecondsOverride;
+    mNameHash           = hash;
+    mNameLength         = static_cast<uint8_t>(length);
+    mType               = query.GetType();
+    mClass              = query.GetClass();
+    mUnicastAnswer      = query.RequestedUnicastAnswer();
+    mIncludeQuery       = includeQuery;
+
+    return true;
+}
+
+bool ResponseCache::Key::operator==(const Key & other) const
+{
+    return (mNameHash == other.mNameHash) && (mNameLength == other.mNameLength) && (mType == other.mType) &&
+        (mClass == other.mClass) && (mUnicastAnswer == other.mUnicastAnswer) && (mIncludeQuery == other.mIncludeQuery) &&
+        (mInterfaceId == other.mInterfaceId) && (mTtlSecondsOverride == other.mTtlSecondsOverride) &&
+        (memcmp(mName, other.mName, mNameLength) == 0);
+}
+
+void ResponseCache::Clear()
+{
+    for (auto & entry : mEntries)
+    {
+        entry.used = false;
+    }
+    mStatistics.invalidations++;
+}
+
+size_t ResponseCache::Count() const
+{
+    size_t count = 0;
+    for (auto & entry : mEntries)
+    {
+        if (entry.used)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+bool ResponseCache::Lookup(const Key & key, chip::ByteSpan & reply)
+{
+    const chip::System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
+
+    for (auto & entry : mEntries)
+    {
+        if (!entry.used || (entry.key != key))
+        {
+            continue;
+        }
+
+        if (now > entry.insertedAt + kMaxAge)
+        {
+            entry.used = false;
+            break;
+        }
+
+        entry.lastUsed = now;
+        reply          = chip::ByteSpan(entry.reply, entry.replyLength);
+        mStatistics.hits++;
+        return true;
+    }
+
+    mStatistics.misses++;
+    return false;
+}
+
+void ResponseCache::Insert(const Key & key, chip::ByteSpan reply)
+{
+    VerifyOrReturn(kCacheSize > 0);
+    VerifyOrReturn(reply.size() <= kMaxReplySize);
+
+    const chip::System::Clock::Timestamp now = mClock->GetMonotonicTimestamp();
+
+    // Prefer replacing the same question, then an unused or expired entry,
+    // then the least recently used one.
+    Entry * target = nullptr;
+    for (auto & entry : mEntries)
+    {
+        if (entry.used && (entry.key == key))
+        {
+            target = &entry;
+            break;
+        }
+
+        if (!entry.used || (now > entry.insertedAt + kMaxAge))
+        {
+            entry.used = false;
+            if ((target == nullptr) || target->used)
+            {
+                target = &entry;
+            }
+        }
+        else if ((target == nullptr) || (target->used && (entry.lastUsed < target->lastUsed)))
+        {
+            target = &entry;
+        }
+    }
+
+    if (target->used && (target->key != key))
+    {
+        mStatistics.evictions++;
+    }
+
+    target->key         = key;
+    target->insertedAt  = now;
+    target->lastUsed    = now;
+    target->used        = true;
+    target->replyLength = static_cast<uint16_t>(reply.size());
+    if (!reply.empty())
+    {
+        memcpy(target->reply, reply.data(), reply.size());
+    }
+    mStatistics.insertions++;
+}
+
+} // namespace Minimal
+} // namespace mdns
@@ -0,0 +1,122 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <inet/InetInterface.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/Optional.h>
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <lib/support/Span.h>
+#include <system/SystemClock.h>
+
+namespace mdns {
+namespace Minimal {
+
+/// Keeps fully encoded unicast replies of the minimal mDNS responder, keyed by
+/// the interface and question they answer.
+///
+/// Entries are not tied to the data that was used to build them, so the owner
+/// is expected to call `Clear()` whenever responders are added, removed or
+/// changed. Interface addresses may change without notice, which is why
+/// entries are also dropped once they are older than `kMaxAge`.
+class ResponseCache
+{
+public:
+    static constexpr size_t kCacheSize    = CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE;
+    static constexpr size_t kMaxReplySize = 512;
+
+    // Longest question name (in uncompressed wire format) that can be cached
+    static constexpr size_t kMaxNameLength = 128;
+
+    static constexpr chip::System::Clock::Seconds16 kMaxAge = chip::System::Clock::Seconds16(5);
+
+    struct Statistics
+    {
+        uint32_t hits          = 0; // queries answered from the cache
+        uint32_t misses        = 0; // cacheable queries that required building a reply
+        uint32_t insertions    = 0; // replies stored
+        uint32_t evictions     = 0; // still valid replies dropped to make room
+        uint32_t invalidations = 0; // calls to Clear()
+    };
+
+    /// Identifies a question and everything else that affects the content of
+    /// the reply to it.
+    class Key
+    {
+    public:
+        /// Returns false if the question cannot be cached (e.g. its name is too long).
+        bool Set(chip::Inet::InterfaceId interfaceId, const QueryData & query, bool includeQuery,
+                 chip::Optional<uint32_t> ttlSecondsOverride);
+
+        bool operator==(const Key & other) const;
+        bool operator!=(const Key & other) const { return !(*this == other); }
+
+    private:
+        chip::Inet::InterfaceId mInterfaceId;
+        chip::Optional<uint32_t> mTtlSecondsOverride;
+        uint32_t mNameHash  = 0;
+        uint8_t mNameLength = 0;
+        QType mType         = QType::ANY;
+        QClass mClass       = QClass::ANY;
+        bool mUnicastAnswer = false;
+        bool mIncludeQuery  = false;
+        uint8_t mName[kMaxNameLength];
+    };
+
+    ResponseCache(chip::System::Clock::ClockBase * clock) : mClock(clock) {}
+
+    /// Forget all cached replies. Statistics are preserved.
+    void Clear();
+
+    /// Looks up the reply for [key].
+    ///
+    /// On success, [reply] is set to the cached packet, which stays valid until
+    /// the next call that modifies the cache. An empty [reply] means that
+    /// nothing needs to be sent back.
+    bool Lookup(const Key & key, chip::ByteSpan & reply);
+
+    /// Remember the reply for [key], evicting the least recently used entry if
+    /// needed. An empty [reply] records that the question requires no answer.
+    void Insert(const Key & key, chip::ByteSpan reply);
+
+    /// Number of replies currently held (including not yet swept expired ones).
+    size_t Count() const;
+
+    const Statistics & GetStatistics() const { return mStatistics; }
+
+private:
+    struct Entry
+    {
+        Key key;
+        chip::System::Clock::Timestamp insertedAt;
+        chip::System::Clock::Timestamp lastUsed;
+        bool used            = false;
+        uint16_t replyLength = 0;
+        uint8_t reply[kMaxReplySize];
+    };
+
+    chip::System::Clock::ClockBase * mClock;
+    Statistics mStatistics;
+    Entry mEntries[kCacheSize > 0 ? kCacheSize : 1];
+};
+
+} // namespace Minimal
+} // namespace mdns
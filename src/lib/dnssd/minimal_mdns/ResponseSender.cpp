@@ -62,12 +62,14 @@ CHIP_ERROR ResponseSender::AddQueryResponder(QueryResponderBase * queryResponder
         if (responder == nullptr || responder == queryResponder)
         {
             responder = queryResponder;
+            InvalidateResponseCache();
             return CHIP_NO_ERROR;
         }
     }
 
 #if CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST
     mResponders.push_back(queryResponder);
+    InvalidateResponseCache();
     return CHIP_NO_ERROR;
 #else
     return CHIP_ERROR_NO_MEMORY;
@@ -84,6 +86,7 @@ CHIP_ERROR ResponseSender::RemoveQueryResponder(QueryResponderBase * queryRespon
 #if CHIP_CONFIG_MINMDNS_DYNAMIC_OPERATIONAL_RESPONDER_LIST
             mResponders.erase(it);
 #endif
+            InvalidateResponseCache();
             return CHIP_NO_ERROR;
         }
     }
@@ -102,6 +105,54 @@ bool ResponseSender::HasQueryResponders() const
     return false;
 }
 
+void ResponseSender::InvalidateResponseCache()
+{
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    mResponseCache.Clear();
+#endif
+}
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
+bool ResponseSender::IsCacheableQuery() const
+{
+    // Multicast replies are rate limited per record (see lastMulticastTime), so their content
+    // depends on timing. Known answers are not kept by the parser, so queries listing them
+    // are always answered in full rather than from (or into) the cache.
+    const QueryData & query = *mSendState.GetQuery();
+    return mSendState.SendUnicast() && !query.IsAnnounceBroadcast() && !query.HasKnownAnswers();
+}
+
+CHIP_ERROR ResponseSender::SendCachedReply(chip::ByteSpan reply)
+{
+    ReturnErrorCodeIf(reply.empty(), CHIP_NO_ERROR); // nothing to answer
+
+    chip::System::PacketBufferHandle buffer = chip::System::PacketBufferHandle::NewWithData(reply.data(), reply.size());
+    ReturnErrorCodeIf(buffer.IsNull(), CHIP_ERROR_NO_MEMORY);
+
+    HeaderRef(buffer->Start()).SetMessageId(mSendState.GetMessageId());
+
+    return mServer->DirectSend(std::move(buffer), mSendState.GetSourceAddress(), mSendState.GetSourcePort(),
+                               mSendState.GetSourceInterfaceId());
+}
+
+void ResponseSender::CacheReply(chip::ByteSpan reply)
+{
+    VerifyOrReturn(mCachingReply);
+
+    // Replies split over several packets are not cached
+    if (mReplyCached || ((reply.size() >= HeaderRef::kSizeBytes) && ConstHeaderRef(reply.data()).GetFlags().IsTruncated()))
+    {
+        mCachingReply = false;
+        return;
+    }
+
+    mResponseCache.Insert(mCacheKey, reply);
+    mReplyCached = true;
+}
+
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+
 CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query, const chip::Inet::IPPacketInfo * querySource,
                                    const ResponseConfiguration & configuration)
 {
@@ -113,6 +164,21 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
         mSendState.MarkWasSent(ResponseItemsSent::kServiceListingData);
     }
 
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    mCachingReply = false;
+    mReplyCached  = false;
+    if (IsCacheableQuery() &&
+        mCacheKey.Set(querySource->Interface, query, mSendState.IncludeQuery(), configuration.GetTtlSecondsOverride()))
+    {
+        chip::ByteSpan cachedReply;
+        if (mResponseCache.Lookup(mCacheKey, cachedReply))
+        {
+            return SendCachedReply(cachedReply);
+        }
+        mCachingReply = true;
+    }
+#endif
+
     // Responder has a stateful 'additional replies required' that is used within the response
     // loop. 'no additionals required' is set at the start and additionals are marked as the query
     // reply is built.
@@ -195,7 +261,17 @@ CHIP_ERROR ResponseSender::Respond(uint16_t messageId, const QueryData & query,
         }
     }
 
-    return FlushReply();
+    ReturnErrorOnFailure(FlushReply());
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    if (mCachingReply && !mReplyCached)
+    {
+        // Nothing matched: remember that no reply is needed
+        CacheReply(chip::ByteSpan());
+    }
+#endif
+
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR ResponseSender::FlushReply()
@@ -209,6 +285,9 @@ CHIP_ERROR ResponseSender::FlushReply()
 
         if (mSendState.SendUnicast())
         {
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+            CacheReply(mResponseBuilder.PacketData());
+#endif
 #if CHIP_MINMDNS_HIGH_VERBOSITY
             ChipLogDetail(Discovery, "Directly sending mDns reply to peer %s on port %d", srcAddressString,
                           mSendState.GetSourcePort());
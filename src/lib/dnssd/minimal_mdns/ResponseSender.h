@@ -21,6 +21,10 @@
 #include "ResponseBuilder.h"
 #include "Server.h"
 
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+#include "ResponseCache.h"
+#endif
+
 #include <lib/dnssd/minimal_mdns/responders/QueryResponder.h>
 
 #include <system/SystemPacketBuffer.h>
@@ -128,7 +132,11 @@ private:
 class ResponseSender : public ResponderDelegate
 {
 public:
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    ResponseSender(ServerBase * server) : mServer(server), mResponseCache(&chip::System::SystemClock()) {}
+#else
     ResponseSender(ServerBase * server) : mServer(server) {}
+#endif
 
     CHIP_ERROR AddQueryResponder(QueryResponderBase * queryResponder);
     CHIP_ERROR RemoveQueryResponder(QueryResponderBase * queryResponder);
@@ -145,6 +153,15 @@ public:
 
     void SetServer(ServerBase * server) { mServer = server; }
 
+    /// Drop all cached replies. Must be called whenever data served by any of
+    /// the registered responders changes (adding/removing responders is
+    /// handled internally).
+    void InvalidateResponseCache();
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    const ResponseCache::Statistics & GetResponseCacheStatistics() const { return mResponseCache.GetStatistics(); }
+#endif
+
 private:
     CHIP_ERROR FlushReply();
     CHIP_ERROR PrepareNewReplyPacket();
@@ -155,6 +172,18 @@ private:
     /// Current send state
     ResponseBuilder mResponseBuilder;          // packet being built
     Internal::ResponseSendingState mSendState; // sending state
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    /// Checks if the reply to the current query may be served from (and stored in) the cache
+    bool IsCacheableQuery() const;
+    CHIP_ERROR SendCachedReply(chip::ByteSpan reply);
+    void CacheReply(chip::ByteSpan reply);
+
+    ResponseCache mResponseCache;
+    ResponseCache::Key mCacheKey; // key of the reply being built
+    bool mCachingReply = false;   // reply being built is to be stored in the cache
+    bool mReplyCached  = false;   // reply being built was stored in the cache
+#endif
 };
 
 } // namespace Minimal
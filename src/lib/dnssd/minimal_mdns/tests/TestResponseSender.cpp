@@ -16,6 +16,7 @@
  */
 #include <lib/dnssd/minimal_mdns/ResponseSender.h>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -29,6 +30,8 @@
 
 #include <lib/support/CHIPMem.h>
 #include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
 
 #include <nlunit-test.h>
 
@@ -344,6 +347,235 @@ void PtrSrvTxtMultipleRespondersToServiceListing(nlTestSuite * inSuite, void * i
     NL_TEST_ASSERT(inSuite, common1->server.GetHeaderFound());
 }
 
+/// Keeps a copy of the last unicast reply sent
+class RecordingServer : private chip::PoolImpl<ServerBase::EndpointInfo, 0, chip::ObjectPoolMem::kInline,
+                                               ServerBase::EndpointInfoPoolType::Interface>,
+                        public ServerBase
+{
+public:
+    RecordingServer() : ServerBase(*static_cast<ServerBase::EndpointInfoPoolType *>(this)) {}
+
+    CHIP_ERROR DirectSend(chip::System::PacketBufferHandle && data, const chip::Inet::IPAddress & addr, uint16_t port,
+                          chip::Inet::InterfaceId interface) override
+    {
+        mSendCount++;
+        mLastReply.assign(data->Start(), data->Start() + data->DataLength());
+        return CHIP_NO_ERROR;
+    }
+
+    size_t GetSendCount() const { return mSendCount; }
+    const std::vector<uint8_t> & GetLastReply() const { return mLastReply; }
+
+private:
+    size_t mSendCount = 0;
+    std::vector<uint8_t> mLastReply;
+};
+
+void CachedReplyToInstance(nlTestSuite * inSuite, void * inContext)
+{
+    CommonTestElements common(inSuite, "test");
+    RecordingServer server;
+    ResponseSender responseSender(&server);
+    NL_TEST_ASSERT(inSuite, responseSender.AddQueryResponder(&common.queryResponder) == CHIP_NO_ERROR);
+    common.queryResponder.AddResponder(&common.srvResponder);
+    common.queryResponder.AddResponder(&common.txtResponder);
+
+    common.recordWriter.WriteQName(common.instance);
+    QueryData queryData = QueryData(QType::ANY, QClass::IN, false, common.requestNameStart, common.requestBytesRange);
+
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(1, queryData, &common.packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, server.GetSendCount() == 1);
+    const std::vector<uint8_t> firstReply = server.GetLastReply();
+
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(2, queryData, &common.packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, server.GetSendCount() == 2);
+    const std::vector<uint8_t> & secondReply = server.GetLastReply();
+
+    // Same content, answering the new message id
+    NL_TEST_ASSERT(inSuite, firstReply.size() > HeaderRef::kSizeBytes);
+    NL_TEST_ASSERT(inSuite, firstReply.size() == secondReply.size());
+    NL_TEST_ASSERT(inSuite, ConstHeaderRef(firstReply.data()).GetMessageId() == 1);
+    NL_TEST_ASSERT(inSuite, ConstHeaderRef(secondReply.data()).GetMessageId() == 2);
+    NL_TEST_ASSERT(inSuite, memcmp(firstReply.data() + 2, secondReply.data() + 2, firstReply.size() - 2) == 0);
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    NL_TEST_ASSERT(inSuite, responseSender.GetResponseCacheStatistics().hits == 1);
+    NL_TEST_ASSERT(inSuite, responseSender.GetResponseCacheStatistics().misses == 1);
+#endif
+
+    // A different question is answered separately
+    QueryData srvQuery = QueryData(QType::SRV, QClass::IN, false, common.requestNameStart, common.requestBytesRange);
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(3, srvQuery, &common.packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, server.GetSendCount() == 3);
+    NL_TEST_ASSERT(inSuite, server.GetLastReply().size() < firstReply.size());
+}
+
+void CachedReplyInvalidation(nlTestSuite * inSuite, void * inContext)
+{
+    auto common1 = std::make_unique<CommonTestElements>(inSuite, "test1");
+    auto common2 = std::make_unique<CommonTestElements>(inSuite, "test2");
+    RecordingServer server;
+    ResponseSender responseSender(&server);
+    NL_TEST_ASSERT(inSuite, responseSender.AddQueryResponder(&common1->queryResponder) == CHIP_NO_ERROR);
+    common1->queryResponder.AddResponder(&common1->srvResponder);
+
+    common1->recordWriter.WriteQName(common1->instance);
+    QueryData queryData = QueryData(QType::ANY, QClass::IN, false, common1->requestNameStart, common1->requestBytesRange);
+
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(1, queryData, &common1->packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, server.GetSendCount() == 1);
+    const size_t srvOnlySize = server.GetLastReply().size();
+
+    // Data changed in place: owner invalidates explicitly
+    common1->queryResponder.AddResponder(&common1->txtResponder);
+    responseSender.InvalidateResponseCache();
+
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(2, queryData, &common1->packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, server.GetSendCount() == 2);
+    NL_TEST_ASSERT(inSuite, server.GetLastReply().size() > srvOnlySize);
+
+    // Questions without an answer are remembered too, until responders are added
+    common2->recordWriter.WriteQName(common2->instance);
+    QueryData otherQuery = QueryData(QType::ANY, QClass::IN, false, common2->requestNameStart, common2->requestBytesRange);
+
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(3, otherQuery, &common1->packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(4, otherQuery, &common1->packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, server.GetSendCount() == 2);
+
+    NL_TEST_ASSERT(inSuite, responseSender.AddQueryResponder(&common2->queryResponder) == CHIP_NO_ERROR);
+    common2->queryResponder.AddResponder(&common2->srvResponder);
+
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(5, otherQuery, &common1->packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, server.GetSendCount() == 3);
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    NL_TEST_ASSERT(inSuite, responseSender.GetResponseCacheStatistics().hits == 1);
+#endif
+}
+
+void KnownAnswersBypassCache(nlTestSuite * inSuite, void * inContext)
+{
+    CommonTestElements common(inSuite, "test");
+    RecordingServer server;
+    ResponseSender responseSender(&server);
+    NL_TEST_ASSERT(inSuite, responseSender.AddQueryResponder(&common.queryResponder) == CHIP_NO_ERROR);
+    common.queryResponder.AddResponder(&common.srvResponder);
+
+    common.recordWriter.WriteQName(common.instance);
+    QueryData queryData = QueryData(QType::SRV, QClass::IN, false, common.requestNameStart, common.requestBytesRange);
+    queryData.SetHasKnownAnswers(true);
+
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(1, queryData, &common.packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, responseSender.Respond(2, queryData, &common.packetInfo, ResponseConfiguration()) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, server.GetSendCount() == 2);
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE > 0
+    NL_TEST_ASSERT(inSuite, responseSender.GetResponseCacheStatistics().hits == 0);
+    NL_TEST_ASSERT(inSuite, responseSender.GetResponseCacheStatistics().insertions == 0);
+#endif
+}
+
+/// An operational instance as advertised by a bridge (one per fabric)
+struct OperationalInstance
+{
+    uint8_t instanceStorage[128];
+    uint8_t hostStorage[64];
+    uint8_t txtStorage[64];
+    FullQName instance;
+    FullQName host;
+    FullQName txt;
+
+    PtrResponder ptrResponder;
+    SrvResponder srvResponder;
+    TxtResponder txtResponder;
+
+    uint8_t requestStorage[128];
+    QueryData query;
+
+    OperationalInstance(const FullQName & service, const char * instanceName, const char * hostName) :
+        instance(FlatAllocatedQName::Build(instanceStorage, instanceName, "_matter", "_tcp", "local")),
+        host(FlatAllocatedQName::Build(hostStorage, hostName, "local")),
+        txt(FlatAllocatedQName::Build(txtStorage, "SII=5000", "SAI=300", "T=1")), ptrResponder(service, instance),
+        srvResponder(SrvResourceRecord(instance, host, 5540)), txtResponder(TxtResourceRecord(instance, txt))
+    {
+        Encoding::BigEndian::BufferWriter writer(requestStorage + HeaderRef::kSizeBytes,
+                                                 sizeof(requestStorage) - HeaderRef::kSizeBytes);
+        RecordWriter recordWriter(&writer);
+        recordWriter.WriteQName(instance);
+
+        query = QueryData(QType::ANY, QClass::IN, false, requestStorage + HeaderRef::kSizeBytes,
+                          BytesRange(requestStorage, requestStorage + sizeof(requestStorage)));
+    }
+};
+
+void ResponsesPerSecondManyInstances(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kInstanceCount = 16;
+    constexpr size_t kQueryCount    = 5000;
+
+    uint8_t serviceStorage[64];
+    const FullQName service = FlatAllocatedQName::Build(serviceStorage, "_matter", "_tcp", "local");
+
+    std::vector<std::unique_ptr<OperationalInstance>> instances;
+    auto queryResponder = std::make_unique<QueryResponder<kInstanceCount * 3 + 1>>();
+    queryResponder->Init();
+
+    for (size_t i = 0; i < kInstanceCount; i++)
+    {
+        char instanceName[64];
+        char hostName[32];
+        snprintf(instanceName, sizeof(instanceName), "87E1B004E235A130-%016X", static_cast<unsigned>(i + 1));
+        snprintf(hostName, sizeof(hostName), "AABBCCDDEE%06X", static_cast<unsigned>(i));
+
+        instances.push_back(std::make_unique<OperationalInstance>(service, instanceName, hostName));
+        OperationalInstance & op = *instances.back();
+
+        queryResponder->AddResponder(&op.ptrResponder).SetReportInServiceListing(true).SetReportAdditional(op.instance);
+        queryResponder->AddResponder(&op.srvResponder);
+        queryResponder->AddResponder(&op.txtResponder);
+    }
+
+    RecordingServer server;
+    auto responseSender = std::make_unique<ResponseSender>(&server);
+    NL_TEST_ASSERT(inSuite, responseSender->AddQueryResponder(queryResponder.get()) == CHIP_NO_ERROR);
+
+    Inet::IPPacketInfo packetInfo;
+
+    // Every reply built from scratch
+    uint64_t start = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (size_t i = 0; i < kQueryCount; i++)
+    {
+        responseSender->InvalidateResponseCache();
+        responseSender->Respond(static_cast<uint16_t>(i), instances[i % kInstanceCount]->query, &packetInfo,
+                                ResponseConfiguration());
+    }
+    const uint64_t uncachedUs = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+
+    NL_TEST_ASSERT(inSuite, server.GetSendCount() == kQueryCount);
+    const std::vector<uint8_t> builtReply = server.GetLastReply();
+
+    // Replies served from the cache when enabled
+    start = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (size_t i = 0; i < kQueryCount; i++)
+    {
+        responseSender->Respond(static_cast<uint16_t>(i), instances[i % kInstanceCount]->query, &packetInfo,
+                                ResponseConfiguration());
+    }
+    const uint64_t cachedUs = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+
+    NL_TEST_ASSERT(inSuite, server.GetSendCount() == 2 * kQueryCount);
+    NL_TEST_ASSERT(inSuite, server.GetLastReply() == builtReply);
+
+#if CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE >= 16
+    NL_TEST_ASSERT(inSuite, responseSender->GetResponseCacheStatistics().hits >= kQueryCount - kInstanceCount);
+#endif
+
+    ChipLogProgress(Discovery, "%u instances: %u responses/sec built, %u responses/sec with response cache",
+                    static_cast<unsigned>(kInstanceCount),
+                    static_cast<unsigned>(kQueryCount * 1000000 / (uncachedUs > 0 ? uncachedUs : 1)),
+                    static_cast<unsigned>(kQueryCount * 1000000 / (cachedUs > 0 ? cachedUs : 1)));
+}
+
 const nlTest sTests[] = {
     NL_TEST_DEF("SrvAnyResponseToInstance", SrvAnyResponseToInstance),                                       //
     NL_TEST_DEF("SrvTxtAnyResponseToInstance", SrvTxtAnyResponseToInstance),                                 //
@@ -355,6 +587,10 @@ const nlTest sTests[] = {
     NL_TEST_DEF("AddManyQueryResponders", AddManyQueryResponders),                                           //
     NL_TEST_DEF("PtrSrvTxtMultipleRespondersToInstance", PtrSrvTxtMultipleRespondersToInstance),             //
     NL_TEST_DEF("PtrSrvTxtMultipleRespondersToServiceListing", PtrSrvTxtMultipleRespondersToServiceListing), //
+    NL_TEST_DEF("CachedReplyToInstance", CachedReplyToInstance),                                             //
+    NL_TEST_DEF("CachedReplyInvalidation", CachedReplyInvalidation),                                         //
+    NL_TEST_DEF("KnownAnswersBypassCache", KnownAnswersBypassCache),                                         //
+    NL_TEST_DEF("ResponsesPerSecondManyInstances", ResponsesPerSecondManyInstances),                         //
 
     NL_TEST_SENTINEL() //
 };
@@ -382,6 +382,41 @@ void TestCombination(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, !attempts.NextScheduled().HasValue());
 }
 
+void TestManyParallelResolves(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kPeerCount = 100;
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+    constexpr size_t kExpectedTracked = kPeerCount;
+#else
+    constexpr size_t kExpectedTracked = mdns::Minimal::ActiveResolveAttempts::kRetryQueueSize;
+#endif
+
+    System::Clock::Internal::MockClock mockClock;
+    mdns::Minimal::ActiveResolveAttempts attempts(&mockClock, kPeerCount);
+
+    for (int round = 0; round < 2; round++)
+    {
+        for (NodeId i = 1; i <= kPeerCount; i++)
+        {
+            attempts.MarkPending(MakePeerId(i));
+        }
+
+        size_t scheduled = 0;
+        while (attempts.NextScheduled().HasValue())
+        {
+            scheduled++;
+        }
+        NL_TEST_ASSERT(inSuite, scheduled == kExpectedTracked);
+
+        // Completed entries are reused by the next round
+        for (NodeId i = 1; i <= kPeerCount; i++)
+        {
+            attempts.Complete(MakePeerId(i));
+        }
+        NL_TEST_ASSERT(inSuite, !attempts.GetTimeUntilNextExpectedResponse().HasValue());
+    }
+}
+
 const nlTest sTests[] = {
     NL_TEST_DEF("TestSinglePeerAddRemove", TestSinglePeerAddRemove),     //
     NL_TEST_DEF("TestSingleBrowseAddRemove", TestSingleBrowseAddRemove), //
@@ -390,6 +425,7 @@ const nlTest sTests[] = {
     NL_TEST_DEF("TestLRU", TestLRU),                                     //
     NL_TEST_DEF("TestNextPeerOrdering", TestNextPeerOrdering),           //
     NL_TEST_DEF("TestCombination", TestCombination),                     //
+    NL_TEST_DEF("TestManyParallelResolves", TestManyParallelResolves),   //
     NL_TEST_SENTINEL()                                                   //
 };
 
@@ -0,0 +1,457 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/dnssd/IncrementalResolverPool.h>
+
+#include <lib/dnssd/ActiveResolveAttempts.h>
+#include <lib/dnssd/ServiceNaming.h>
+#include <lib/dnssd/minimal_mdns/Parser.h>
+#include <lib/dnssd/minimal_mdns/QueryBuilder.h>
+#include <lib/dnssd/minimal_mdns/RecordData.h>
+#include <lib/dnssd/minimal_mdns/records/IP.h>
+#include <lib/dnssd/minimal_mdns/records/ResourceRecord.h>
+#include <lib/dnssd/minimal_mdns/records/Srv.h>
+#include <lib/dnssd/minimal_mdns/records/Txt.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+#include <system/SystemPacketBuffer.h>
+
+#include <nlunit-test.h>
+
+#include <algorithm>
+#include <stdio.h>
+#include <vector>
+
+using namespace chip;
+using namespace chip::Dnssd;
+using namespace mdns::Minimal;
+
+namespace {
+
+constexpr uint16_t kTestPort      = 5540;
+constexpr size_t kQueryPacketSize = 1024;
+constexpr size_t kNodesPerReply   = 8;
+
+const char * kTestTxt[] = { "SII=1234", "SAI=3000" };
+
+PeerId TestPeerId(size_t index)
+{
+    return PeerId().SetCompressedFabricId(0x1234).SetNodeId(index + 1);
+}
+
+/// Holds the names used by a simulated node.
+class TestNodeNames
+{
+public:
+    TestNodeNames(const PeerId & peerId)
+    {
+        VerifyOrDie(MakeInstanceName(mInstance, sizeof(mInstance), peerId) == CHIP_NO_ERROR);
+        snprintf(mHost, sizeof(mHost), "%016" PRIX64, peerId.GetNodeId());
+    }
+
+    FullQName Instance() const { return FullQName(mInstanceParts); }
+    FullQName Host() const { return FullQName(mHostParts); }
+
+private:
+    char mInstance[kMaxOperationalServiceNameSize];
+    char mHost[17];
+
+    const QNamePart mInstanceParts[4] = { mInstance, "_matter", "_tcp", "local" };
+    const QNamePart mHostParts[2]     = { mHost, "local" };
+};
+
+Inet::IPAddress TestAddress(const PeerId & peerId)
+{
+    char addressString[Inet::IPAddress::kMaxStringLength];
+    snprintf(addressString, sizeof(addressString), "fd00::%x", static_cast<unsigned>(peerId.GetNodeId()));
+
+    Inet::IPAddress addr;
+    VerifyOrDie(Inet::IPAddress::FromString(addressString, addr));
+    return addr;
+}
+
+/// Builds mDNS response packets in a flat buffer, the way a responder would.
+class TestResponse
+{
+public:
+    TestResponse() : mOutput(mBuffer, sizeof(mBuffer)), mWriter(&mOutput), mHeader(mBuffer)
+    {
+        mHeader.Clear();
+        mHeader.SetFlags(mHeader.GetFlags().SetResponse().SetAuthoritative());
+        mOutput.Skip(HeaderRef::kSizeBytes);
+    }
+
+    void AddNode(const PeerId & peerId)
+    {
+        TestNodeNames names(peerId);
+
+        VerifyOrDie(SrvResourceRecord(names.Instance(), names.Host(), kTestPort).Append(mHeader, ResourceType::kAnswer, mWriter));
+        VerifyOrDie(TxtResourceRecord(names.Instance(), kTestTxt).Append(mHeader, ResourceType::kAnswer, mWriter));
+        VerifyOrDie(IPResourceRecord(names.Host(), TestAddress(peerId)).Append(mHeader, ResourceType::kAnswer, mWriter));
+    }
+
+    size_t RecordCount() const { return mHeader.GetAnswerCount(); }
+    BytesRange Range() const { return BytesRange(mBuffer, mBuffer + mOutput.Needed()); }
+
+private:
+    uint8_t mBuffer[2048];
+    Encoding::BigEndian::BufferWriter mOutput;
+    RecordWriter mWriter;
+    HeaderRef mHeader;
+};
+
+/// Collects the peer ids of operational queries within a query packet.
+class QueriedPeers : public ParserDelegate
+{
+public:
+    void OnHeader(ConstHeaderRef & header) override {}
+    void OnResource(ResourceType type, const ResourceData & data) override {}
+
+    void OnQuery(const QueryData & data) override
+    {
+        SerializedQNameIterator name = data.GetName();
+        PeerId peerId;
+
+        if (name.Next() && (ExtractIdFromInstanceName(name.Value(), &peerId) == CHIP_NO_ERROR))
+        {
+            peers.push_back(peerId);
+        }
+    }
+
+    std::vector<PeerId> peers;
+};
+
+/// Feeds response packets through an IncrementalResolverPool, the same way
+/// the minimal mDNS resolver does: SRV records first, then everything else.
+class PoolPacketParser : public ParserDelegate
+{
+public:
+    PoolPacketParser(IncrementalResolverPool & pool) : mPool(pool) {}
+
+    void Parse(const BytesRange & packet)
+    {
+        mPacket = packet;
+        mPool.BeginPacket();
+
+        mSrvPass = true;
+        VerifyOrDie(ParsePacket(packet, this));
+
+        mSrvPass = false;
+        VerifyOrDie(ParsePacket(packet, this));
+    }
+
+    void OnHeader(ConstHeaderRef & header) override {}
+    void OnQuery(const QueryData & data) override {}
+
+    void OnResource(ResourceType type, const ResourceData & data) override
+    {
+        if (mSrvPass)
+        {
+            SrvRecord srv;
+            if ((data.GetType() == QType::SRV) && srv.Parse(data.GetData(), mPacket))
+            {
+                initErrors += (mPool.InitializeParsing(data.GetName(), srv) != CHIP_NO_ERROR) ? 1 : 0;
+            }
+            return;
+        }
+
+        recordCount++;
+        mPool.ForEachCandidate(data.GetName(), [this, &data](IncrementalResolver & resolver) {
+            candidateCount++;
+            VerifyOrDie(resolver.OnRecord(Inet::InterfaceId::Null(), data, mPacket) == CHIP_NO_ERROR);
+        });
+    }
+
+    size_t initErrors     = 0;
+    size_t recordCount    = 0;
+    size_t candidateCount = 0;
+
+private:
+    IncrementalResolverPool & mPool;
+    BytesRange mPacket;
+    bool mSrvPass = false;
+};
+
+void TestPoolLimits(nlTestSuite * inSuite, void * inContext)
+{
+    IncrementalResolverPool pool(2);
+    TestResponse response;
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        response.AddNode(TestPeerId(i));
+    }
+
+    PoolPacketParser parser(pool);
+    parser.Parse(response.Range());
+
+    // Only 2 resolvers are available for the 3 SRV records
+    NL_TEST_ASSERT(inSuite, pool.ActiveCount() == 2);
+    NL_TEST_ASSERT(inSuite, parser.initErrors == 1);
+
+    // Records for resolves already in progress are not duplicated
+    parser.Parse(response.Range());
+    NL_TEST_ASSERT(inSuite, pool.ActiveCount() == 2);
+
+    IncrementalResolver * first = pool.begin();
+    NL_TEST_ASSERT(inSuite, first->IsActive());
+    NL_TEST_ASSERT(inSuite, !first->GetMissingRequiredInformation().HasAny());
+
+    ResolvedNodeData nodeData;
+    NL_TEST_ASSERT(inSuite, first->Take(nodeData) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !first->IsActive());
+    NL_TEST_ASSERT(inSuite, nodeData.resolutionData.port == kTestPort);
+
+    // A taken resolver is reused for the next packet
+    parser.Parse(response.Range());
+    NL_TEST_ASSERT(inSuite, pool.ActiveCount() == 2);
+}
+
+void TestCandidateMatching(nlTestSuite * inSuite, void * inContext)
+{
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+    constexpr size_t kNodes = kNodesPerReply;
+#else
+    constexpr size_t kNodes = CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES;
+#endif
+
+    IncrementalResolverPool pool(kNodes);
+    TestResponse response;
+
+    for (size_t i = 0; i < kNodes; i++)
+    {
+        response.AddNode(TestPeerId(i));
+    }
+
+    PoolPacketParser parser(pool);
+    parser.Parse(response.Range());
+
+    NL_TEST_ASSERT(inSuite, pool.ActiveCount() == kNodes);
+    NL_TEST_ASSERT(inSuite, parser.recordCount == response.RecordCount());
+
+    // Every record is seen by at least the resolver it belongs to
+    NL_TEST_ASSERT(inSuite, parser.candidateCount >= parser.recordCount);
+
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+    // Records are only offered to the resolver whose names they match
+    NL_TEST_ASSERT(inSuite, parser.candidateCount == parser.recordCount);
+#endif
+
+    for (auto & resolver : pool)
+    {
+        NL_TEST_ASSERT(inSuite, resolver.IsActiveOperationalParse());
+        NL_TEST_ASSERT(inSuite, !resolver.GetMissingRequiredInformation().HasAny());
+    }
+}
+
+void TestQueryPacking(nlTestSuite * inSuite, void * inContext)
+{
+    QueryBuilder builder(System::PacketBufferHandle::New(kQueryPacketSize));
+    NL_TEST_ASSERT(inSuite, builder.Ok());
+
+    size_t added = 0;
+    while (true)
+    {
+        TestNodeNames names(TestPeerId(added));
+        Query query(names.Instance());
+        query.SetType(QType::ANY).SetClass(QClass::IN);
+
+        if (!builder.TryAddQuery(query))
+        {
+            // a failed add leaves the packet intact
+            NL_TEST_ASSERT(inSuite, builder.QueryCount() == added);
+            NL_TEST_ASSERT(inSuite, builder.Ok());
+            break;
+        }
+        added++;
+    }
+
+    NL_TEST_ASSERT(inSuite, builder.QueryCount() == added);
+
+    // Instance names share the "_matter._tcp.local" suffix, which is only
+    // written once per packet.
+    const size_t uncompressedQuerySize = kMaxOperationalServiceNameSize + 2 * sizeof(uint16_t);
+    NL_TEST_ASSERT(inSuite, added > kQueryPacketSize / uncompressedQuerySize);
+
+    System::PacketBufferHandle packet = builder.ReleasePacket();
+    QueriedPeers queried;
+    NL_TEST_ASSERT(inSuite, ParsePacket(BytesRange(packet->Start(), packet->Start() + packet->DataLength()), &queried));
+    NL_TEST_ASSERT(inSuite, queried.peers.size() == added);
+
+    for (size_t i = 0; i < queried.peers.size(); i++)
+    {
+        NL_TEST_ASSERT(inSuite, queried.peers[i] == TestPeerId(i));
+    }
+}
+
+/// Resolves many nodes in parallel through a simulated local responder.
+///
+/// The responder runs in-process (no socket IO): query packets built by
+/// QueryBuilder are parsed and answered with SRV/TXT/AAAA records for every
+/// queried node, and answers are fed through an IncrementalResolverPool.
+void TestResolveManyNodes(nlTestSuite * inSuite, void * inContext)
+{
+#if CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+    constexpr size_t kNodeCount = 1000;
+#else
+    constexpr size_t kNodeCount = CHIP_CONFIG_MINMDNS_MAX_PARALLEL_RESOLVES;
+#endif
+
+    System::Clock::Internal::MockClock mockClock;
+    ActiveResolveAttempts attempts(&mockClock, kNodeCount);
+    IncrementalResolverPool pool(kNodeCount);
+    PoolPacketParser parser(pool);
+
+    std::vector<bool> resolved(kNodeCount, false);
+    size_t resolvedCount     = 0;
+    size_t queryPackets      = 0;
+    size_t responsePackets   = 0;
+    size_t maxQueriesPerSend = 0;
+
+    const uint64_t start = System::SystemClock().GetMonotonicMicroseconds64().count();
+
+    for (size_t i = 0; i < kNodeCount; i++)
+    {
+        attempts.MarkPending(TestPeerId(i));
+    }
+
+    auto respond = [&](QueryBuilder & builder) {
+        queryPackets++;
+        maxQueriesPerSend = std::max<size_t>(maxQueriesPerSend, builder.QueryCount());
+
+        System::PacketBufferHandle packet = builder.ReleasePacket();
+        QueriedPeers queried;
+        NL_TEST_ASSERT(inSuite, ParsePacket(BytesRange(packet->Start(), packet->Start() + packet->DataLength()), &queried));
+
+        for (size_t i = 0; i < queried.peers.size(); i += kNodesPerReply)
+        {
+            TestResponse response;
+            for (size_t j = i; (j < queried.peers.size()) && (j < i + kNodesPerReply); j++)
+            {
+                response.AddNode(queried.peers[j]);
+            }
+
+            parser.Parse(response.Range());
+            responsePackets++;
+
+            for (auto & resolver : pool)
+            {
+                if (!resolver.IsActive() || resolver.GetMissingRequiredInformation().HasAny())
+                {
+                    continue;
+                }
+
+                ResolvedNodeData nodeData;
+                NL_TEST_ASSERT(inSuite, resolver.Take(nodeData) == CHIP_NO_ERROR);
+                NL_TEST_ASSERT(inSuite, nodeData.resolutionData.numIPs == 1);
+                NL_TEST_ASSERT(inSuite, nodeData.resolutionData.ipAddress[0] == TestAddress(nodeData.operationalData.peerId));
+
+                const size_t index = static_cast<size_t>(nodeData.operationalData.peerId.GetNodeId() - 1);
+                NL_TEST_ASSERT(inSuite, index < kNodeCount);
+                if ((index < kNodeCount) && !resolved[index])
+                {
+                    resolved[index] = true;
+                    resolvedCount++;
+                }
+
+                attempts.Complete(nodeData.operationalData.peerId);
+            }
+        }
+    };
+
+    QueryBuilder builder;
+    while (true)
+    {
+        Optional<ActiveResolveAttempts::ScheduledAttempt> attempt = attempts.NextScheduled();
+        if (!attempt.HasValue())
+        {
+            break;
+        }
+        NL_TEST_ASSERT(inSuite, attempt.Value().IsResolve());
+
+        char nameBuffer[kMaxOperationalServiceNameSize];
+        NL_TEST_ASSERT(inSuite,
+                       MakeInstanceName(nameBuffer, sizeof(nameBuffer), attempt.Value().ResolveData().peerId) == CHIP_NO_ERROR);
+        const char * instanceQName[] = { nameBuffer, "_matter", "_tcp", "local" };
+        Query query(instanceQName);
+        query.SetClass(QClass::IN).SetType(QType::ANY).SetAnswerViaUnicast(attempt.Value().firstSend);
+
+        if (!builder.HasPacketBuffer())
+        {
+            builder.Reset(System::PacketBufferHandle::New(kQueryPacketSize));
+        }
+
+        if (!builder.TryAddQuery(query))
+        {
+            respond(builder);
+            builder.Reset(System::PacketBufferHandle::New(kQueryPacketSize));
+            NL_TEST_ASSERT(inSuite, builder.TryAddQuery(query));
+        }
+    }
+
+    if (builder.HasPacketBuffer() && (builder.QueryCount() > 0))
+    {
+        respond(builder);
+    }
+
+    const uint64_t elapsedUs = System::SystemClock().GetMonotonicMicroseconds64().count() - start;
+
+    NL_TEST_ASSERT(inSuite, resolvedCount == kNodeCount);
+    NL_TEST_ASSERT(inSuite, pool.ActiveCount() == 0);
+    NL_TEST_ASSERT(inSuite, parser.initErrors == 0);
+    NL_TEST_ASSERT(inSuite, !attempts.GetTimeUntilNextExpectedResponse().HasValue());
+
+    // Many SRV names are asked within the same packet
+    NL_TEST_ASSERT(inSuite, maxQueriesPerSend >= std::min<size_t>(kNodeCount, 20));
+    NL_TEST_ASSERT(inSuite, queryPackets < kNodeCount);
+
+    ChipLogProgress(Discovery, "Resolved %u nodes in %u us using %u query packets and %u response packets",
+                    static_cast<unsigned>(resolvedCount), static_cast<unsigned>(elapsedUs), static_cast<unsigned>(queryPackets),
+                    static_cast<unsigned>(responsePackets));
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("PoolLimits", TestPoolLimits),               //
+    NL_TEST_DEF("CandidateMatching", TestCandidateMatching), //
+    NL_TEST_DEF("QueryPacking", TestQueryPacking),           //
+    NL_TEST_DEF("ResolveManyNodes", TestResolveManyNodes),   //
+    NL_TEST_SENTINEL()                                       //
+};
+
+int TestSetup(void * inContext)
+{
+    return Platform::MemoryInit() == CHIP_NO_ERROR ? SUCCESS : FAILURE;
+}
+
+int TestTeardown(void * inContext)
+{
+    Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+} // namespace
+
+int TestIncrementalResolverPool()
+{
+    nlTestSuite theSuite = { "IncrementalResolverPool", sTests, &TestSetup, &TestTeardown };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestIncrementalResolverPool)
@@ -0,0 +1,371 @@
+/*
+ *
+ *    Copyright (c) 2023 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <lib/dnssd/RecordCache.h>
+
+#include <lib/dnssd/ServiceNaming.h>
+#include <lib/dnssd/minimal_mdns/core/tests/QNameStrings.h>
+#include <lib/dnssd/minimal_mdns/records/IP.h>
+#include <lib/dnssd/minimal_mdns/records/Ptr.h>
+#include <lib/dnssd/minimal_mdns/records/ResourceRecord.h>
+#include <lib/dnssd/minimal_mdns/records/Srv.h>
+#include <lib/dnssd/minimal_mdns/records/Txt.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemClock.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::Dnssd;
+using namespace chip::System::Clock::Literals;
+using namespace mdns::Minimal;
+
+namespace {
+
+constexpr uint64_t kTestCompressedFabricId = 0x1234567898765432;
+constexpr NodeId kTestNodeId               = 0xABCDEFEDCBAABCDE;
+constexpr uint16_t kTestPort               = 5540;
+
+const auto kTestOperationalName = testing::TestQName<4>({ "1234567898765432-ABCDEFEDCBAABCDE", "_matter", "_tcp", "local" });
+const auto kTestServiceName     = testing::TestQName<3>({ "_matter", "_tcp", "local" });
+const auto kTestHostName        = testing::TestQName<2>({ "abcd", "local" });
+const auto kOtherHostName       = testing::TestQName<2>({ "printer", "local" });
+const auto kOtherServiceName    = testing::TestQName<4>({ "printer", "_ipp", "_tcp", "local" });
+
+const char * kTestTxt[] = { "SII=1234", "SAI=3000" };
+
+PeerId TestPeerId()
+{
+    return PeerId().SetCompressedFabricId(kTestCompressedFabricId).SetNodeId(kTestNodeId);
+}
+
+Inet::IPAddress ParseAddress(const char * str)
+{
+    Inet::IPAddress addr;
+    VerifyOrDie(Inet::IPAddress::FromString(str, addr));
+    return addr;
+}
+
+/// Builds mDNS packets in a flat buffer, the way a responder would.
+class TestPacket
+{
+public:
+    TestPacket(bool isResponse = true) : mOutput(mBuffer, sizeof(mBuffer)), mWriter(&mOutput), mHeader(mBuffer)
+    {
+        mHeader.Clear();
+        if (isResponse)
+        {
+            mHeader.SetFlags(mHeader.GetFlags().SetResponse().SetAuthoritative());
+        }
+        mOutput.Skip(HeaderRef::kSizeBytes);
+    }
+
+    TestPacket & Add(const ResourceRecord & record, ResourceType type = ResourceType::kAnswer)
+    {
+        VerifyOrDie(record.Append(mHeader, type, mWriter));
+        return *this;
+    }
+
+    BytesRange Range() const { return BytesRange(mBuffer, mBuffer + mOutput.Needed()); }
+
+private:
+    uint8_t mBuffer[512];
+    Encoding::BigEndian::BufferWriter mOutput;
+    RecordWriter mWriter;
+    HeaderRef mHeader;
+};
+
+/// Adds a full operational answer (PTR, SRV, TXT and AAAA) to [packet].
+void AddOperationalAnswer(TestPacket & packet, const Inet::IPAddress & address, uint32_t ttl)
+{
+    packet.Add(PtrResourceRecord(kTestServiceName.Full(), kTestOperationalName.Full()).SetTtl(ttl))
+        .Add(SrvResourceRecord(kTestOperationalName.Full(), kTestHostName.Full(), kTestPort).SetTtl(ttl),
+             ResourceType::kAdditional)
+        .Add(TxtResourceRecord(kTestOperationalName.Full(), kTestTxt).SetTtl(ttl), ResourceType::kAdditional)
+        .Add(IPResourceRecord(kTestHostName.Full(), address).SetTtl(ttl), ResourceType::kAdditional);
+}
+
+void TestCachesOperationalRecords(nlTestSuite * inSuite, void * inContext)
+{
+    System::Clock::Internal::MockClock mockClock;
+    RecordCache cache(&mockClock);
+
+    TestPacket packet;
+    AddOperationalAnswer(packet, ParseAddress("fe80::1"), 120);
+
+    // unrelated records seen on the network are not cached
+    packet.Add(SrvResourceRecord(kOtherServiceName.Full(), kOtherHostName.Full(), 631), ResourceType::kAdditional)
+        .Add(IPResourceRecord(kOtherHostName.Full(), ParseAddress("fe80::2")), ResourceType::kAdditional);
+
+    cache.ObservePacket(Inet::InterfaceId::Null(), packet.Range());
+    NL_TEST_ASSERT(inSuite, cache.Count() == 4);
+    NL_TEST_ASSERT(inSuite, cache.GetStatistics().insertions == 4);
+
+    IncrementalResolver resolver;
+    NL_TEST_ASSERT(inSuite, cache.Lookup(TestPeerId(), resolver));
+    NL_TEST_ASSERT(inSuite, cache.GetStatistics().hits == 1);
+
+    ResolvedNodeData nodeData;
+    NL_TEST_ASSERT(inSuite, resolver.Take(nodeData) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, nodeData.operationalData.peerId == TestPeerId());
+    NL_TEST_ASSERT(inSuite, nodeData.resolutionData.port == kTestPort);
+    NL_TEST_ASSERT(inSuite, nodeData.resolutionData.numIPs == 1);
+    NL_TEST_ASSERT(inSuite, nodeData.resolutionData.ipAddress[0] == ParseAddress("fe80::1"));
+    NL_TEST_ASSERT(inSuite, nodeData.resolutionData.GetMrpRetryIntervalIdle() == MakeOptional(1234_ms32));
+    NL_TEST_ASSERT(inSuite, nodeData.resolutionData.GetMrpRetryIntervalActive() == MakeOptional(3000_ms32));
+
+    // Seeing the same records again only refreshes them
+    cache.ObservePacket(Inet::InterfaceId::Null(), packet.Range());
+    NL_TEST_ASSERT(inSuite, cache.Count() == 4);
+    NL_TEST_ASSERT(inSuite, cache.GetStatistics().refreshes == 4);
+
+    // Unknown peers are a miss
+    NL_TEST_ASSERT(inSuite, !cache.Lookup(PeerId().SetCompressedFabricId(1).SetNodeId(2), resolver));
+    NL_TEST_ASSERT(inSuite, !resolver.IsActive());
+    NL_TEST_ASSERT(inSuite, cache.GetStatistics().misses == 1);
+}
+
+void TestIgnoresQueries(nlTestSuite * inSuite, void * inContext)
+{
+    System::Clock::Internal::MockClock mockClock;
+    RecordCache cache(&mockClock);
+
+    // Known-answer lists within queries are not authoritative data
+    TestPacket packet(/* isResponse = */ false);
+    AddOperationalAnswer(packet, ParseAddress("fe80::1"), 120);
+
+    cache.ObservePacket(Inet::InterfaceId::Null(), packet.Range());
+    NL_TEST_ASSERT(inSuite, cache.Count() == 0);
+}
+
+void TestAddressRequiresService(nlTestSuite * inSuite, void * inContext)
+{
+    System::Clock::Internal::MockClock mockClock;
+    RecordCache cache(&mockClock);
+
+    // An SRV without any address is not enough to resolve
+    TestPacket srvPacket;
+    srvPacket.Add(SrvResourceRecord(kTestOperationalName.Full(), kTestHostName.Full(), kTestPort));
+    cache.ObservePacket(Inet::InterfaceId::Null(), srvPacket.Range());
+
+    IncrementalResolver resolver;
+    NL_TEST_ASSERT(inSuite, !cache.Lookup(TestPeerId(), resolver));
+    NL_TEST_ASSERT(inSuite, !resolver.IsActive());
+
+    // Addresses for the SRV target arriving separately complete the data
+    TestPacket addressPacket;
+    addressPacket.Add(IPResourceRecord(kTestHostName.Full(), ParseAddress("fe80::1")))
+        .Add(IPResourceRecord(kTestHostName.Full(), ParseAddress("fd00::1")));
+    cache.ObservePacket(Inet::InterfaceId::Null(), addressPacket.Range());
+    NL_TEST_ASSERT(inSuite, cache.Count() == 3);
+
+    NL_TEST_ASSERT(inSuite, cache.Lookup(TestPeerId(), resolver));
+
+    ResolvedNodeData nodeData;
+    NL_TEST_ASSERT(inSuite, resolver.Take(nodeData) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, nodeData.resolutionData.numIPs == 2);
+    NL_TEST_ASSERT(inSuite, !nodeData.resolutionData.GetMrpRetryIntervalIdle().HasValue());
+}
+
+void TestTtl(nlTestSuite * inSuite, void * inContext)
+{
+    System::Clock::Internal::MockClock mockClock;
+    RecordCache cache(&mockClock);
+    IncrementalResolver resolver;
+
+    mockClock.AdvanceMonotonic(1000_ms64);
+
+    TestPacket packet;
+    AddOperationalAnswer(packet, ParseAddress("fe80::1"), 100);
+    cache.ObservePacket(Inet::InterfaceId::Null(), packet.Range());
+
+    // Fresh until 80% of the TTL has passed
+    mockClock.AdvanceMonotonic(79_s);
+    NL_TEST_ASSERT(inSuite, cache.Lookup(TestPeerId(), resolver));
+    resolver.ResetToInactive();
+
+    mockClock.AdvanceMonotonic(2_s);
+    NL_TEST_ASSERT(inSuite, !cache.Lookup(TestPeerId(), resolver));
+    NL_TEST_ASSERT(inSuite, cache.Count() == 4);
+
+    // A re-announcement makes the data fresh again
+    cache.ObservePacket(Inet::InterfaceId::Null(), packet.Range());
+    NL_TEST_ASSERT(inSuite, cache.Lookup(TestPeerId(), resolver));
+    resolver.ResetToInactive();
+
+    // Records are dropped once expired
+    mockClock.AdvanceMonotonic(100_s);
+    NL_TEST_ASSERT(inSuite, !cache.Lookup(TestPeerId(), resolver));
+    NL_TEST_ASSERT(inSuite, cache.Count() == 0);
+    NL_TEST_ASSERT(inSuite, cache.GetStatistics().expirations == 4);
+}
+
+void TestGoodbyeAndCacheFlush(nlTestSuite * inSuite, void * inContext)
+{
+    System::Clock::Internal::MockClock mockClock;
+    RecordCache cache(&mockClock);
+    IncrementalResolver resolver;
+    ResolvedNodeData nodeData;
+
+    TestPacket packet;
+    AddOperationalAnswer(packet, ParseAddress("fe80::1"), 120);
+    cache.ObservePacket(Inet::InterfaceId::Null(), packet.Range());
+
+    // The host changes its address: the cache-flush bit replaces the previous one
+    mockClock.AdvanceMonotonic(2_s);
+    TestPacket flushPacket;
+    flushPacket.Add(IPResourceRecord(kTestHostName.Full(), ParseAddress("fe80::2")).SetCacheFlush(true));
+    cache.ObservePacket(Inet::InterfaceId::Null(), flushPacket.Range());
+    NL_TEST_ASSERT(inSuite, cache.Count() == 4);
+
+    NL_TEST_ASSERT(inSuite, cache.Lookup(TestPeerId(), resolver));
+    NL_TEST_ASSERT(inSuite, resolver.Take(nodeData) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, nodeData.resolutionData.numIPs == 1);
+    NL_TEST_ASSERT(inSuite, nodeData.resolutionData.ipAddress[0] == ParseAddress("fe80::2"));
+
+    // A goodbye (TTL 0) removes the record
+    TestPacket goodbyePacket;
+    goodbyePacket.Add(IPResourceRecord(kTestHostName.Full(), ParseAddress("fe80::2")).SetTtl(0));
+    cache.ObservePacket(Inet::InterfaceId::Null(), goodbyePacket.Range());
+    NL_TEST_ASSERT(inSuite, cache.Count() == 3);
+    NL_TEST_ASSERT(inSuite, !cache.Lookup(TestPeerId(), resolver));
+}
+
+void TestEviction(nlTestSuite * inSuite, void * inContext)
+{
+    System::Clock::Internal::MockClock mockClock;
+    RecordCache cache(&mockClock);
+
+    for (unsigned i = 0; i < RecordCache::kCacheSize + 3; i++)
+    {
+        char instance[kMaxOperationalServiceNameSize];
+        NL_TEST_ASSERT(inSuite,
+                       MakeInstanceName(instance, sizeof(instance), PeerId().SetCompressedFabricId(1).SetNodeId(i + 1)) ==
+                           CHIP_NO_ERROR);
+        const QNamePart instanceParts[] = { instance, "_matter", "_tcp", "local" };
+
+        TestPacket packet;
+        packet.Add(PtrResourceRecord(kTestServiceName.Full(), FullQName(instanceParts)).SetTtl(100 + i));
+        cache.ObservePacket(Inet::InterfaceId::Null(), packet.Range());
+    }
+
+    NL_TEST_ASSERT(inSuite, cache.Count() == RecordCache::kCacheSize);
+    NL_TEST_ASSERT(inSuite, cache.GetStatistics().evictions == 3);
+}
+
+void TestForget(nlTestSuite * inSuite, void * inContext)
+{
+    System::Clock::Internal::MockClock mockClock;
+    RecordCache cache(&mockClock);
+    IncrementalResolver resolver;
+    ResolvedNodeData nodeData;
+
+    TestPacket packet;
+    AddOperationalAnswer(packet, ParseAddress("fe80::1"), 120);
+    packet.Add(IPResourceRecord(kTestHostName.Full(), ParseAddress("fe80::2")).SetTtl(120), ResourceType::kAdditional);
+    cache.ObservePacket(Inet::InterfaceId::Null(), packet.Range());
+    NL_TEST_ASSERT(inSuite, cache.Count() == 5);
+
+    // An address that did not work is dropped, the other one is still used
+    cache.ForgetAddress("abcd", ParseAddress("fe80::1"));
+    NL_TEST_ASSERT(inSuite, cache.Count() == 4);
+    NL_TEST_ASSERT(inSuite, cache.GetStatistics().flushes == 1);
+
+    NL_TEST_ASSERT(inSuite, cache.Lookup(TestPeerId(), resolver));
+    NL_TEST_ASSERT(inSuite, resolver.Take(nodeData) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, nodeData.resolutionData.numIPs == 1);
+    NL_TEST_ASSERT(inSuite, nodeData.resolutionData.ipAddress[0] == ParseAddress("fe80::2"));
+
+    // Forgetting the peer drops its SRV, TXT and host addresses, so that a retried resolve queries the network
+    cache.Forget(TestPeerId());
+    NL_TEST_ASSERT(inSuite, cache.Count() == 1);
+    NL_TEST_ASSERT(inSuite, cache.GetStatistics().flushes == 4);
+    NL_TEST_ASSERT(inSuite, !cache.Lookup(TestPeerId(), resolver));
+}
+
+/// Compares resolving a node through a responder round trip against answering it
+/// from the cache.
+///
+/// The responder is simulated in-process (no socket IO), so the numbers only
+/// reflect CPU cost. On a real network a cache miss additionally costs at least
+/// one multicast round trip.
+void TestResolveBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr unsigned kIterations = 1000;
+
+    System::Clock::Internal::MockClock mockClock;
+    RecordCache cache(&mockClock);
+    const Inet::IPAddress address = ParseAddress("fe80::1");
+
+    // Uncached: every resolve parses a full response packet
+    const uint64_t uncachedStart = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (unsigned i = 0; i < kIterations; i++)
+    {
+        TestPacket response;
+        AddOperationalAnswer(response, address, 120);
+
+        IncrementalResolver resolver;
+        RecordCache perQueryCache(&mockClock);
+        perQueryCache.ObservePacket(Inet::InterfaceId::Null(), response.Range());
+        NL_TEST_ASSERT(inSuite, perQueryCache.Lookup(TestPeerId(), resolver));
+    }
+    const uint64_t uncachedUs = System::SystemClock().GetMonotonicMicroseconds64().count() - uncachedStart;
+
+    TestPacket announcement;
+    AddOperationalAnswer(announcement, address, 120);
+    cache.ObservePacket(Inet::InterfaceId::Null(), announcement.Range());
+
+    const uint64_t cachedStart = System::SystemClock().GetMonotonicMicroseconds64().count();
+    for (unsigned i = 0; i < kIterations; i++)
+    {
+        IncrementalResolver resolver;
+        NL_TEST_ASSERT(inSuite, cache.Lookup(TestPeerId(), resolver));
+    }
+    const uint64_t cachedUs = System::SystemClock().GetMonotonicMicroseconds64().count() - cachedStart;
+
+    NL_TEST_ASSERT(inSuite, cache.GetStatistics().hits == kIterations);
+    NL_TEST_ASSERT(inSuite, cache.GetStatistics().misses == 0);
+
+    ChipLogProgress(Discovery, "%u resolves: %u us via responder packets, %u us from record cache", kIterations,
+                    static_cast<unsigned>(uncachedUs), static_cast<unsigned>(cachedUs));
+}
+
+const nlTest sTests[] = {
+#if CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    NL_TEST_DEF("CachesOperationalRecords", TestCachesOperationalRecords), //
+    NL_TEST_DEF("IgnoresQueries", TestIgnoresQueries),                     //
+    NL_TEST_DEF("AddressRequiresService", TestAddressRequiresService),     //
+    NL_TEST_DEF("Ttl", TestTtl),                                           //
+    NL_TEST_DEF("GoodbyeAndCacheFlush", TestGoodbyeAndCacheFlush),         //
+    NL_TEST_DEF("Eviction", TestEviction),                                 //
+    NL_TEST_DEF("Forget", TestForget),                                     //
+    NL_TEST_DEF("ResolveBenchmark", TestResolveBenchmark),                 //
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE > 0
+    NL_TEST_SENTINEL()                                                     //
+};
+
+} // namespace
+
+int TestRecordCache()
+{
+    nlTestSuite theSuite = { "RecordCache", sTests, nullptr, nullptr };
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestRecordCache)
@@ -173,6 +173,15 @@ public:
         return StorageKeyName::Formatted("g/a/%x/%" PRIx32 "/%" PRIx32, endpointId, clusterId, attributeId);
     }
 
+    // Returns the key for the record holding the stored attribute values of a
+    // cluster, see WriteBehindAttributePersistenceProvider.
+    static StorageKeyName ClusterAttributeValues(EndpointId endpointId, ClusterId clusterId)
+    {
+        // Needs at most 18 chars: 6 for "g/ac//", 4 for the endpoint id, 8 for
+        // the cluster id.
+        return StorageKeyName::Formatted("g/ac/%x/%" PRIx32, endpointId, clusterId);
+    }
+
     // Returns the key for Safely stored attributes.
     static StorageKeyName SafeAttributeValue(EndpointId endpointId, ClusterId clusterId, AttributeId attributeId)
     {
@@ -208,6 +217,7 @@ public:
         return StorageKeyName::Formatted("g/su/%x", static_cast<unsigned>(index));
     }
     static StorageKeyName SubscriptionResumptionMaxCount() { return StorageKeyName::Formatted("g/sum"); }
+    static StorageKeyName SubscriptionResumptionIndex() { return StorageKeyName::FromConst("g/sui"); }
 
     // Number of scenes stored in a given endpoint's scene table, across all fabrics.
     static StorageKeyName EndpointSceneCountKey(EndpointId endpoint) { return StorageKeyName::Formatted("g/scc/e/%x", endpoint); }
@@ -64,6 +64,22 @@ using CHIP_CONFIG_PERSISTED_STORAGE_KEY_TYPE = const char *;
 #define CHIP_CONFIG_BDX_MAX_NUM_TRANSFERS 1
 #endif // CHIP_CONFIG_BDX_MAX_NUM_TRANSFERS
 
+#ifndef CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+#define CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS 1
+#endif // CHIP_CONFIG_MINMDNS_DYNAMIC_RESOLVE_POOLS
+
+#ifndef CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE 16
+#endif // CHIP_CONFIG_MINMDNS_RESPONSE_CACHE_SIZE
+
+#ifndef CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+#define CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE 16
+#endif // CHIP_CONFIG_MINMDNS_RECORD_CACHE_SIZE
+
+#ifndef CHIP_CONFIG_EVENT_STAGING_RING_SIZE
+#define CHIP_CONFIG_EVENT_STAGING_RING_SIZE 16
+#endif // CHIP_CONFIG_EVENT_STAGING_RING_SIZE
+
 // ==================== Security Configuration Overrides ====================
 
 #ifndef CHIP_CONFIG_KVS_PATH
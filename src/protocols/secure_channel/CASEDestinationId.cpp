@@ -16,11 +16,13 @@
  */
 
 #include <stdint.h>
+#include <string.h>
 
 #include <credentials/FabricTable.h>
 #include <credentials/GroupDataProvider.h>
 #include <lib/core/CHIPError.h>
 #include <lib/support/BufferWriter.h>
+#include <lib/support/CodeUtils.h>
 #include <lib/support/Span.h>
 
 #include "CASEDestinationId.h"
@@ -28,6 +30,13 @@
 namespace chip {
 
 using namespace chip::Crypto;
+using Credentials::GroupDataProvider;
+
+namespace {
+
+constexpr size_t kDestinationMessageLen = kSigmaParamRandomNumberSize + kP256_PublicKey_Length + sizeof(FabricId) + sizeof(NodeId);
+
+} // namespace
 
 CHIP_ERROR GenerateCaseDestinationId(const ByteSpan & ipk, const ByteSpan & initiatorRandom, const ByteSpan & rootPubKey,
                                      FabricId fabricId, NodeId nodeId, MutableByteSpan & outDestinationId)
@@ -37,8 +46,6 @@ CHIP_ERROR GenerateCaseDestinationId(const ByteSpan & ipk, const ByteSpan & init
     VerifyOrReturnError(rootPubKey.size() == kP256_PublicKey_Length, CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(outDestinationId.size() >= kSHA256_Hash_Length, CHIP_ERROR_INVALID_ARGUMENT);
 
-    constexpr size_t kDestinationMessageLen =
-        kSigmaParamRandomNumberSize + kP256_PublicKey_Length + sizeof(FabricId) + sizeof(NodeId);
     uint8_t destinationMessage[kDestinationMessageLen];
 
     Encoding::LittleEndian::BufferWriter bbuf(destinationMessage, sizeof(destinationMessage));
@@ -62,4 +69,194 @@ CHIP_ERROR GenerateCaseDestinationId(const ByteSpan & ipk, const ByteSpan & init
     return err;
 }
 
+CHIP_ERROR CASEDestinationIdIndex::Init(FabricTable * fabricTable, GroupDataProvider * groupDataProvider)
+{
+    VerifyOrReturnError(fabricTable != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(groupDataProvider != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    Shutdown();
+
+    ReturnErrorOnFailure(fabricTable->AddFabricDelegate(this));
+    mFabricTable       = fabricTable;
+    mGroupDataProvider = groupDataProvider;
+
+    return CHIP_NO_ERROR;
+}
+
+void CASEDestinationIdIndex::Shutdown()
+{
+    if (mFabricTable != nullptr)
+    {
+        mFabricTable->RemoveFabricDelegate(this);
+    }
+
+    mFabricTable       = nullptr;
+    mGroupDataProvider = nullptr;
+    Invalidate();
+}
+
+void CASEDestinationIdIndex::Invalidate()
+{
+    for (size_t entryIdx = 0; entryIdx < mEntryCount; ++entryIdx)
+    {
+        ClearSecretData(&mEntries[entryIdx].ipks[0][0], sizeof(mEntries[entryIdx].ipks));
+    }
+
+    mEntryCount = 0;
+    mIsValid    = false;
+}
+
+CHIP_ERROR CASEDestinationIdIndex::Rebuild()
+{
+    Invalidate();
+
+    // Read the generation first, so that a key set changed while rebuilding makes the index stale.
+    mTracksKeySets = mGroupDataProvider->GetKeySetGeneration(mKeySetGeneration);
+
+    for (const FabricInfo & fabricInfo : *mFabricTable)
+    {
+        // Fabrics without a usable IPK can never match, same as for the full scan in CASESession.
+        // They still get an entry, so that the entries mirror the fabric table.
+        GroupDataProvider::KeySet ipkKeySet;
+        CHIP_ERROR err = mGroupDataProvider->GetIpkKeySet(fabricInfo.GetFabricIndex(), ipkKeySet);
+        bool hasIpk    = (err == CHIP_NO_ERROR) &&
+            ((ipkKeySet.num_keys_used > 0) && (ipkKeySet.num_keys_used <= GroupDataProvider::KeySet::kEpochKeysMax));
+
+        err = AddEntry(fabricInfo, hasIpk ? &ipkKeySet : nullptr);
+        ipkKeySet.ClearKeys();
+        if (err != CHIP_NO_ERROR)
+        {
+            Invalidate();
+            return err;
+        }
+    }
+
+    mIsValid = true;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR CASEDestinationIdIndex::AddEntry(const FabricInfo & fabricInfo, const GroupDataProvider::KeySet * ipkKeySet)
+{
+    VerifyOrReturnError(mEntryCount < ArraySize(mEntries), CHIP_ERROR_NO_MEMORY);
+
+    P256PublicKey rootPubKey;
+    ReturnErrorOnFailure(fabricInfo.FetchRootPubkey(rootPubKey));
+
+    Entry & entry     = mEntries[mEntryCount];
+    entry.fabricIndex = fabricInfo.GetFabricIndex();
+    entry.fabricId    = fabricInfo.GetFabricId();
+    entry.nodeId      = fabricInfo.GetNodeId();
+    entry.numKeys     = (ipkKeySet != nullptr) ? ipkKeySet->num_keys_used : 0;
+
+    for (size_t keyIdx = 0; keyIdx < entry.numKeys; ++keyIdx)
+    {
+        memcpy(entry.ipks[keyIdx], ipkKeySet->epoch_keys[keyIdx].key, kIPKSize);
+    }
+
+    Encoding::LittleEndian::BufferWriter bbuf(entry.messageSuffix, sizeof(entry.messageSuffix));
+    bbuf.Put(rootPubKey.ConstBytes(), rootPubKey.Length());
+    bbuf.Put64(entry.fabricId);
+    bbuf.Put64(entry.nodeId);
+    VerifyOrReturnError(bbuf.Fit(), CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    ++mEntryCount;
+    return CHIP_NO_ERROR;
+}
+
+bool CASEDestinationIdIndex::IsStale() const
+{
+    VerifyOrReturnValue(mIsValid, true);
+
+    uint32_t keySetGeneration;
+    if (mTracksKeySets)
+    {
+        VerifyOrReturnValue(mGroupDataProvider->GetKeySetGeneration(keySetGeneration), true);
+        VerifyOrReturnValue(keySetGeneration == mKeySetGeneration, true);
+    }
+
+    return !MatchesFabricTable();
+}
+
+bool CASEDestinationIdIndex::MatchesFabricTable() const
+{
+    // Only compares in-memory fabric data, which is much cheaper than the HMACs of a lookup.
+    size_t entryIdx = 0;
+    for (const FabricInfo & fabricInfo : *mFabricTable)
+    {
+        VerifyOrReturnValue(entryIdx < mEntryCount, false);
+        const Entry & entry = mEntries[entryIdx++];
+        VerifyOrReturnValue(fabricInfo.GetFabricIndex() == entry.fabricIndex, false);
+        VerifyOrReturnValue(fabricInfo.GetFabricId() == entry.fabricId && fabricInfo.GetNodeId() == entry.nodeId, false);
+
+        P256PublicKey rootPubKey;
+        VerifyOrReturnValue(fabricInfo.FetchRootPubkey(rootPubKey) == CHIP_NO_ERROR, false);
+        VerifyOrReturnValue(memcmp(rootPubKey.ConstBytes(), entry.messageSuffix, kP256_PublicKey_Length) == 0, false);
+    }
+
+    return entryIdx == mEntryCount;
+}
+
+bool CASEDestinationIdIndex::IsKeyCurrent(const Entry & entry, size_t keyIdx) const
+{
+    GroupDataProvider::KeySet ipkKeySet;
+    VerifyOrReturnValue(mGroupDataProvider->GetIpkKeySet(entry.fabricIndex, ipkKeySet) == CHIP_NO_ERROR, false);
+    bool isCurrent = (keyIdx < ipkKeySet.num_keys_used) && (keyIdx < GroupDataProvider::KeySet::kEpochKeysMax) &&
+        (memcmp(ipkKeySet.epoch_keys[keyIdx].key, entry.ipks[keyIdx], kIPKSize) == 0);
+    ipkKeySet.ClearKeys();
+
+    return isCurrent;
+}
+
+CHIP_ERROR CASEDestinationIdIndex::FindLocalNode(const ByteSpan & destinationId, const ByteSpan & initiatorRandom,
+                                                 FabricIndex & outFabricIndex, NodeId & outNodeId, MutableByteSpan & outIpk)
+{
+    VerifyOrReturnError(mFabricTable != nullptr && mGroupDataProvider != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(initiatorRandom.size() == kSigmaParamRandomNumberSize, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(outIpk.size() >= kIPKSize, CHIP_ERROR_BUFFER_TOO_SMALL);
+    VerifyOrReturnError(destinationId.size() == kSHA256_Hash_Length, CHIP_ERROR_KEY_NOT_FOUND);
+
+    if (IsStale())
+    {
+        ReturnErrorOnFailure(Rebuild());
+    }
+
+    // The initiator random is the only per-Sigma1 input, so it is written once and each
+    // fabric only swaps in its pre-serialized suffix.
+    uint8_t destinationMessage[kDestinationMessageLen];
+    static_assert(sizeof(destinationMessage) == kSigmaParamRandomNumberSize + kMessageSuffixLength,
+                  "Destination message layout mismatch");
+    memcpy(destinationMessage, initiatorRandom.data(), kSigmaParamRandomNumberSize);
+
+    for (size_t entryIdx = 0; entryIdx < mEntryCount; ++entryIdx)
+    {
+        const Entry & entry = mEntries[entryIdx];
+        memcpy(&destinationMessage[kSigmaParamRandomNumberSize], entry.messageSuffix, kMessageSuffixLength);
+
+        for (size_t keyIdx = 0; keyIdx < entry.numKeys; ++keyIdx)
+        {
+            uint8_t candidateDestinationId[kSHA256_Hash_Length];
+            HMAC_sha hmac;
+            CHIP_ERROR err = hmac.HMAC_SHA256(entry.ipks[keyIdx], kIPKSize, destinationMessage, sizeof(destinationMessage),
+                                              candidateDestinationId, sizeof(candidateDestinationId));
+            if ((err != CHIP_NO_ERROR) || !destinationId.data_equal(ByteSpan(candidateDestinationId)))
+            {
+                continue;
+            }
+
+            // Without key set change tracking, confirm the matched epoch key is still the fabric's IPK.
+            if (!mTracksKeySets && !IsKeyCurrent(entry, keyIdx))
+            {
+                Invalidate();
+                return CHIP_ERROR_NOT_FOUND;
+            }
+
+            outFabricIndex = entry.fabricIndex;
+            outNodeId      = entry.nodeId;
+            return CopySpanToMutableSpan(ByteSpan(entry.ipks[keyIdx]), outIpk);
+        }
+    }
+
+    return mTracksKeySets ? CHIP_ERROR_KEY_NOT_FOUND : CHIP_ERROR_NOT_FOUND;
+}
+
 } // namespace chip
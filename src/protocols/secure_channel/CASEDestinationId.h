@@ -34,4 +34,92 @@ inline constexpr uint16_t kIPKSize                    = Crypto::CHIP_CRYPTO_SYMM
 CHIP_ERROR GenerateCaseDestinationId(const ByteSpan & ipk, const ByteSpan & initiatorRandom, const ByteSpan & rootPubKey,
                                      FabricId fabricId, NodeId nodeId, MutableByteSpan & outDestinationId);
 
+/**
+ * Index of the inputs needed to match an incoming Sigma1 destination identifier against
+ * every (fabric, IPK epoch key) candidate of a responder.
+ *
+ * Without the index, each Sigma1 fetches the root public key and loads the IPK key set from
+ * persistent storage for every fabric before computing the candidate destination identifiers.
+ * The index keeps the IPK epoch keys and the pre-serialized, initiator-independent part of the
+ * destination message for each fabric, so a lookup only has to compute the HMACs.
+ *
+ * The index is rebuilt lazily whenever it is stale: after fabric table changes, after any key set
+ * change reported by GroupDataProvider::GetKeySetGeneration(), or when the fabrics it holds no
+ * longer match the fabric table (reverting pending fabric data is not signaled to delegates).
+ * An up to date index is authoritative, so a miss does not need to be confirmed by a full scan.
+ *
+ * When the group data provider does not track key set changes, the matched IPK is re-read
+ * before being returned, and a miss cannot rule out a newly installed IPK: callers are expected
+ * to fall back to a full scan, and to call Invalidate() if that full scan finds a match.
+ */
+class CASEDestinationIdIndex : public FabricTable::Delegate
+{
+public:
+    CASEDestinationIdIndex() = default;
+    ~CASEDestinationIdIndex() override { Shutdown(); }
+
+    CASEDestinationIdIndex(const CASEDestinationIdIndex &)             = delete;
+    CASEDestinationIdIndex & operator=(const CASEDestinationIdIndex &) = delete;
+
+    CHIP_ERROR Init(FabricTable * fabricTable, Credentials::GroupDataProvider * groupDataProvider);
+    void Shutdown();
+
+    /**
+     * Drop all cached entries; the next lookup rebuilds the index.
+     */
+    void Invalidate();
+
+    /**
+     * Find the local fabric and node whose destination identifier for `initiatorRandom` is `destinationId`.
+     *
+     * @param[in]  destinationId   Destination identifier received in Sigma1.
+     * @param[in]  initiatorRandom Initiator random received in Sigma1.
+     * @param[out] outFabricIndex  Fabric index of the matching fabric.
+     * @param[out] outNodeId       Local node id on the matching fabric.
+     * @param[out] outIpk          IPK that produced the match, must be at least kIPKSize bytes.
+     *
+     * @return CHIP_ERROR_KEY_NOT_FOUND if no candidate matches,
+     *         CHIP_ERROR_NOT_FOUND if no candidate matches but the index cannot rule out a match
+     *         because key set changes are not tracked, other errors on failure.
+     */
+    CHIP_ERROR FindLocalNode(const ByteSpan & destinationId, const ByteSpan & initiatorRandom, FabricIndex & outFabricIndex,
+                             NodeId & outNodeId, MutableByteSpan & outIpk);
+
+    //// FabricTable::Delegate Implementation ////
+    void OnFabricRemoved(const FabricTable & fabricTable, FabricIndex fabricIndex) override { Invalidate(); }
+    void OnFabricCommitted(const FabricTable & fabricTable, FabricIndex fabricIndex) override { Invalidate(); }
+    void OnFabricUpdated(const FabricTable & fabricTable, FabricIndex fabricIndex) override { Invalidate(); }
+
+private:
+    // Root public key, fabric id and node id, in the layout they take in the destination message.
+    static constexpr size_t kMessageSuffixLength = Crypto::kP256_PublicKey_Length + sizeof(FabricId) + sizeof(NodeId);
+
+    struct Entry
+    {
+        FabricIndex fabricIndex = kUndefinedFabricIndex;
+        FabricId fabricId       = kUndefinedFabricId;
+        NodeId nodeId           = kUndefinedNodeId;
+        uint8_t numKeys         = 0;
+        uint8_t ipks[Credentials::GroupDataProvider::KeySet::kEpochKeysMax][kIPKSize];
+        uint8_t messageSuffix[kMessageSuffixLength];
+    };
+
+    CHIP_ERROR Rebuild();
+    CHIP_ERROR AddEntry(const FabricInfo & fabricInfo, const Credentials::GroupDataProvider::KeySet * ipkKeySet);
+    bool IsStale() const;
+    bool MatchesFabricTable() const;
+    bool IsKeyCurrent(const Entry & entry, size_t keyIdx) const;
+
+    FabricTable * mFabricTable                          = nullptr;
+    Credentials::GroupDataProvider * mGroupDataProvider = nullptr;
+
+    // One entry per fabric of the fabric table, in iteration order, including fabrics without IPK.
+    Entry mEntries[CHIP_CONFIG_MAX_FABRICS];
+    size_t mEntryCount = 0;
+    bool mIsValid      = false;
+    // Key set generation the entries were built from, if mTracksKeySets.
+    uint32_t mKeySetGeneration = 0;
+    bool mTracksKeySets        = false;
+};
+
 } // namespace chip
@@ -48,6 +48,15 @@ CHIP_ERROR CASEServer::ListenForSessionEstablishment(Messaging::ExchangeManager
     // Set up the group state provider that persists across all handshakes.
     GetSession().SetGroupDataProvider(mGroupDataProvider);
 
+    if ((mFabrics != nullptr) && (mDestinationIdIndex.Init(mFabrics, mGroupDataProvider) == CHIP_NO_ERROR))
+    {
+        GetSession().SetDestinationIdIndex(&mDestinationIdIndex);
+    }
+    else
+    {
+        GetSession().SetDestinationIdIndex(nullptr);
+    }
+
     ChipLogProgress(Inet, "CASE Server enabling CASE session setups");
     mExchangeManager->RegisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1, this);
 
@@ -50,6 +50,7 @@ public:
 
         GetSession().Clear();
         mPinnedSecureSession.ClearValue();
+        mDestinationIdIndex.Shutdown();
     }
 
     CHIP_ERROR ListenForSessionEstablishment(Messaging::ExchangeManager * exchangeManager, SessionManager * sessionManager,
@@ -96,6 +97,9 @@ private:
     FabricTable * mFabrics                              = nullptr;
     Credentials::GroupDataProvider * mGroupDataProvider = nullptr;
 
+    // Speeds up matching Sigma1 destination identifiers when serving many fabrics.
+    CASEDestinationIdIndex mDestinationIdIndex;
+
     CHIP_ERROR InitCASEHandshake(Messaging::ExchangeContext * ec);
 
     /*
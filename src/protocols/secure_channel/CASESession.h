@@ -117,6 +117,16 @@ public:
      */
     void SetGroupDataProvider(Credentials::GroupDataProvider * groupDataProvider) { mGroupDataProvider = groupDataProvider; }
 
+    /**
+     * @brief Set the index used by a responder to match Sigma1 destination identifiers
+     *
+     * The index MUST be initialized with the same FabricTable and GroupDataProvider that this
+     * session uses. If not set (the default), every Sigma1 scans all fabrics and IPK epoch keys.
+     *
+     * @param destinationIdIndex - Pointer to the index, or nullptr to always do a full scan.
+     */
+    void SetDestinationIdIndex(CASEDestinationIdIndex * destinationIdIndex) { mDestinationIdIndex = destinationIdIndex; }
+
     /**
      * Parse a sigma1 message.  This function will return success only if the
      * message passes schema checks.  Specifically:
@@ -203,6 +213,7 @@ public:
         kFinishedViaResume   = 7,
         kSendSigma3Pending   = 8,
         kHandleSigma3Pending = 9,
+        kHandleSigma2Pending = 10,
     };
 
     State GetState() { return mState; }
@@ -239,7 +250,12 @@ private:
                                 ByteSpan initiatorRandom);
     CHIP_ERROR SendSigma2();
     CHIP_ERROR HandleSigma2_and_SendSigma3(System::PacketBufferHandle && msg);
-    CHIP_ERROR HandleSigma2(System::PacketBufferHandle && msg);
+
+    struct HandleSigma2Data;
+    CHIP_ERROR HandleSigma2a(System::PacketBufferHandle && msg);
+    static CHIP_ERROR HandleSigma2b(HandleSigma2Data & data, bool & cancel);
+    CHIP_ERROR HandleSigma2c(HandleSigma2Data & data, CHIP_ERROR status);
+
     CHIP_ERROR HandleSigma2Resume(System::PacketBufferHandle && msg);
 
     struct SendSigma3Data;
@@ -293,6 +309,7 @@ private:
     Crypto::P256ECDHDerivedSecret mSharedSecret;
     Credentials::ValidationContext mValidContext;
     Credentials::GroupDataProvider * mGroupDataProvider = nullptr;
+    CASEDestinationIdIndex * mDestinationIdIndex        = nullptr;
 
     uint8_t mMessageDigest[Crypto::kSHA256_Hash_Length];
     uint8_t mIPK[kIPKSize];
@@ -312,6 +329,7 @@ private:
 
     template <class DATA>
     class WorkHelper;
+    Platform::SharedPtr<WorkHelper<HandleSigma2Data>> mHandleSigma2Helper;
     Platform::SharedPtr<WorkHelper<SendSigma3Data>> mSendSigma3Helper;
     Platform::SharedPtr<WorkHelper<HandleSigma3Data>> mHandleSigma3Helper;
 
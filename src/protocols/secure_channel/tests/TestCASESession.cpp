@@ -21,10 +21,15 @@
  *      This file implements unit tests for the CASESession implementation.
  */
 
+#include <app/CASEClientPool.h>
+#include <app/CASESessionManager.h>
+#include <app/OperationalSessionSetupPool.h>
 #include <credentials/CHIPCert.h>
 #include <credentials/GroupDataProviderImpl.h>
 #include <credentials/PersistentStorageOpCertStore.h>
+#include <credentials/TestOnlyLocalCertificateAuthority.h>
 #include <crypto/DefaultSessionKeystore.h>
+#include <ctype.h>
 #include <errno.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/CHIPSafeCasts.h>
@@ -68,8 +73,9 @@ public:
 void ServiceEvents(TestContext & ctx)
 {
     // Takes a few rounds of this because handling IO messages may schedule work,
-    // and scheduled work may queue messages for sending...
-    for (int i = 0; i < 3; ++i)
+    // and scheduled work may queue messages for sending...  Both Sigma2 and
+    // Sigma3 are validated via background work, so allow a round for each.
+    for (int i = 0; i < 4; ++i)
     {
         ctx.DrainAndServiceIO();
 
@@ -370,8 +376,13 @@ public:
     static void SecurePairingHandshakeTest(nlTestSuite * inSuite, void * inContext);
     static void SecurePairingHandshakeServerTest(nlTestSuite * inSuite, void * inContext);
     static void ClientReceivesBusyTest(nlTestSuite * inSuite, void * inContext);
+    static void ReconnectManyTest(nlTestSuite * inSuite, void * inContext);
+#if CHIP_CONFIG_ENABLE_CASE_CLIENT_ADMISSION_CONTROL && CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    static void CASEClientAdmissionTest(nlTestSuite * inSuite, void * inContext);
+#endif // CHIP_CONFIG_ENABLE_CASE_CLIENT_ADMISSION_CONTROL && CONFIG_BUILD_FOR_HOST_UNIT_TEST
     static void Sigma1ParsingTest(nlTestSuite * inSuite, void * inContext);
     static void DestinationIdTest(nlTestSuite * inSuite, void * inContext);
+    static void DestinationIdIndexTest(nlTestSuite * inSuite, void * inContext);
     static void SessionResumptionStorage(nlTestSuite * inSuite, void * inContext);
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     static void SimulateUpdateNOCInvalidatePendingEstablishment(nlTestSuite * inSuite, void * inContext);
@@ -644,6 +655,193 @@ void TestCASESession::ClientReceivesBusyTest(nlTestSuite * inSuite, void * inCon
     gPairingServer.Shutdown();
 }
 
+void TestCASESession::ReconnectManyTest(nlTestSuite * inSuite, void * inContext)
+{
+    // Simulates a controller re-establishing CASE sessions after a restart, one
+    // handshake after the other over loopback, and reports the time taken.
+    // Raise kReconnectCount locally to measure larger fleets.
+    constexpr uint32_t kReconnectCount = 50;
+
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    NL_TEST_ASSERT(inSuite,
+                   gPairingServer.ListenForSessionEstablishment(&ctx.GetExchangeManager(), &ctx.GetSecureSessionManager(),
+                                                                &gDeviceFabrics, nullptr, nullptr,
+                                                                &gDeviceGroupDataProvider) == CHIP_NO_ERROR);
+
+    TestCASESecurePairingDelegate delegateCommissioner;
+    System::Clock::Timestamp start = System::SystemClock().GetMonotonicTimestamp();
+
+    for (uint32_t i = 0; i < kReconnectCount; ++i)
+    {
+        auto * pairingCommissioner = chip::Platform::New<CASESession>();
+        NL_TEST_ASSERT(inSuite, pairingCommissioner != nullptr);
+        VerifyOrReturn(pairingCommissioner != nullptr);
+        pairingCommissioner->SetGroupDataProvider(&gCommissionerGroupDataProvider);
+
+        ExchangeContext * contextCommissioner = ctx.NewUnauthenticatedExchangeToBob(pairingCommissioner);
+        NL_TEST_ASSERT(inSuite,
+                       pairingCommissioner->EstablishSession(ctx.GetSecureSessionManager(), &gCommissionerFabrics,
+                                                             ScopedNodeId{ Node01_01, gCommissionerFabricIndex },
+                                                             contextCommissioner, nullptr, nullptr, &delegateCommissioner,
+                                                             NullOptional) == CHIP_NO_ERROR);
+        ServiceEvents(ctx);
+
+        chip::Platform::Delete(pairingCommissioner);
+    }
+
+    System::Clock::Milliseconds64 elapsed =
+        std::chrono::duration_cast<System::Clock::Milliseconds64>(System::SystemClock().GetMonotonicTimestamp() - start);
+
+    NL_TEST_ASSERT(inSuite, delegateCommissioner.mNumPairingComplete == kReconnectCount);
+    NL_TEST_ASSERT(inSuite, delegateCommissioner.mNumPairingErrors == 0);
+
+    ChipLogProgress(SecureChannel, "Established %u CASE sessions in %u ms", static_cast<unsigned>(kReconnectCount),
+                    static_cast<unsigned>(elapsed.count()));
+
+    gPairingServer.Shutdown();
+}
+
+#if CHIP_CONFIG_ENABLE_CASE_CLIENT_ADMISSION_CONTROL && CONFIG_BUILD_FOR_HOST_UNIT_TEST
+namespace {
+
+// Records the order in which session setups completed: the name of the setup in
+// upper case if it connected, in lower case if it failed.
+struct AdmissionLog
+{
+    void Add(char entry)
+    {
+        if (mLength < sizeof(mEntries) - 1)
+        {
+            mEntries[mLength++] = entry;
+        }
+    }
+
+    char mEntries[8] = {};
+    size_t mLength   = 0;
+};
+
+// CASEClientPool only bounds the number of clients when pools do not use the heap.
+class SingleCASEClientPool : public CASEClientPoolDelegate
+{
+public:
+    CASEClient * Allocate() override
+    {
+        VerifyOrReturnValue(!mInUse, nullptr);
+        CASEClient * client = mPool.Allocate();
+        mInUse              = (client != nullptr);
+        return client;
+    }
+
+    void Release(CASEClient * client) override
+    {
+        mPool.Release(client);
+        mInUse = false;
+    }
+
+private:
+    CASEClientPool<1> mPool;
+    bool mInUse = false;
+};
+
+class AdmissionTestPeer
+{
+public:
+    AdmissionTestPeer(char name, AdmissionLog & log) :
+        mName(name), mLog(log), mOnConnected(OnConnected, this), mOnFailure(OnFailure, this)
+    {}
+
+    Callback::Callback<OnDeviceConnected> * GetOnConnected() { return &mOnConnected; }
+    Callback::Callback<OnDeviceConnectionFailure> * GetOnFailure() { return &mOnFailure; }
+
+private:
+    static void OnConnected(void * context, Messaging::ExchangeManager & exchangeMgr, const SessionHandle & sessionHandle)
+    {
+        auto * self = static_cast<AdmissionTestPeer *>(context);
+        self->mLog.Add(self->mName);
+    }
+
+    static void OnFailure(void * context, const ScopedNodeId & peerId, CHIP_ERROR error)
+    {
+        auto * self = static_cast<AdmissionTestPeer *>(context);
+        self->mLog.Add(static_cast<char>(tolower(self->mName)));
+    }
+
+    char mName;
+    AdmissionLog & mLog;
+    Callback::Callback<OnDeviceConnected> mOnConnected;
+    Callback::Callback<OnDeviceConnectionFailure> mOnFailure;
+};
+
+} // namespace
+
+void TestCASESession::CASEClientAdmissionTest(nlTestSuite * inSuite, void * inContext)
+{
+    // More session setups than CASE clients: the setups that do not get a client
+    // wait for one and are admitted in the order in which they started waiting.
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    NL_TEST_ASSERT(inSuite,
+                   gPairingServer.ListenForSessionEstablishment(&ctx.GetExchangeManager(), &ctx.GetSecureSessionManager(),
+                                                                &gDeviceFabrics, nullptr, nullptr,
+                                                                &gDeviceGroupDataProvider) == CHIP_NO_ERROR);
+
+    SingleCASEClientPool clientPool;
+    OperationalSessionSetupPool<4> sessionSetupPool;
+    CASESessionManager caseSessionManager;
+
+    CASESessionManagerConfig config;
+    config.sessionInitParams.sessionManager    = &ctx.GetSecureSessionManager();
+    config.sessionInitParams.exchangeMgr       = &ctx.GetExchangeManager();
+    config.sessionInitParams.fabricTable       = &gCommissionerFabrics;
+    config.sessionInitParams.groupDataProvider = &gCommissionerGroupDataProvider;
+    config.clientPool                          = &clientPool;
+    config.sessionSetupPool                    = &sessionSetupPool;
+    NL_TEST_ASSERT(inSuite, caseSessionManager.Init(&ctx.GetSystemLayer(), config) == CHIP_NO_ERROR);
+
+    AdmissionLog log;
+    AdmissionTestPeer peerA('A', log);
+    AdmissionTestPeer peerB('B', log);
+    AdmissionTestPeer peerC('C', log);
+
+    // The device does not know Node01_02, so the handshake of C fails.
+    const ScopedNodeId device{ Node01_01, gCommissionerFabricIndex };
+    const ScopedNodeId unknownPeer{ Node01_02, gCommissionerFabricIndex };
+    const CASEClientInitParams & params = config.sessionInitParams;
+    OperationalSessionSetup * setupA    = sessionSetupPool.Allocate(params, &clientPool, device, &caseSessionManager);
+    OperationalSessionSetup * setupB    = sessionSetupPool.Allocate(params, &clientPool, device, &caseSessionManager);
+    OperationalSessionSetup * setupC    = sessionSetupPool.Allocate(params, &clientPool, unknownPeer, &caseSessionManager);
+    OperationalSessionSetup * setupD    = sessionSetupPool.Allocate(params, &clientPool, device, &caseSessionManager);
+    NL_TEST_ASSERT(inSuite, setupA != nullptr && setupB != nullptr && setupC != nullptr && setupD != nullptr);
+    VerifyOrReturn(setupA != nullptr && setupB != nullptr && setupC != nullptr && setupD != nullptr);
+
+    // A takes the only CASE client, then C and B wait for it, in that order.
+    setupA->TestOnlyConnectToAddress(ctx.GetBobAddress(), peerA.GetOnConnected(), peerA.GetOnFailure());
+    setupC->TestOnlyConnectToAddress(ctx.GetBobAddress(), peerC.GetOnConnected(), peerC.GetOnFailure());
+    setupB->TestOnlyConnectToAddress(ctx.GetBobAddress(), peerB.GetOnConnected(), peerB.GetOnFailure());
+    NL_TEST_ASSERT(inSuite, !setupA->IsWaitingForCASEClient());
+    NL_TEST_ASSERT(inSuite, setupC->IsWaitingForCASEClient());
+    NL_TEST_ASSERT(inSuite, setupB->IsWaitingForCASEClient());
+
+    // Releasing a session setup that never had a CASE client runs an admission
+    // pass while A still holds the client: C must keep its place in line.
+    caseSessionManager.ReleaseSession(setupD);
+    ctx.DrainAndServiceIO();
+    NL_TEST_ASSERT(inSuite, sessionSetupPool.FindSessionSetupWaitingForCASEClient() == setupC);
+
+    for (int i = 0; i < 4 && log.mLength < 3; ++i)
+    {
+        ServiceEvents(ctx);
+    }
+
+    NL_TEST_ASSERT(inSuite, strcmp(log.mEntries, "AcB") == 0);
+    NL_TEST_ASSERT(inSuite, sessionSetupPool.FindSessionSetupWaitingForCASEClient() == nullptr);
+
+    caseSessionManager.Shutdown();
+    gPairingServer.Shutdown();
+}
+#endif // CHIP_CONFIG_ENABLE_CASE_CLIENT_ADMISSION_CONTROL && CONFIG_BUILD_FOR_HOST_UNIT_TEST
+
 struct Sigma1Params
 {
     // Purposefully not using constants like kSigmaParamRandomNumberSize that
@@ -719,6 +917,159 @@ void TestCASESession::DestinationIdTest(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, !destinationIdSpan.data_equal(ByteSpan(kExpectedDestinationIdFromSpec)));
 }
 
+namespace {
+
+class ReadCountingStorageDelegate : public TestPersistentStorageDelegate
+{
+public:
+    CHIP_ERROR SyncGetKeyValue(const char * key, void * buffer, uint16_t & size) override
+    {
+        ++mNumReads;
+        return TestPersistentStorageDelegate::SyncGetKeyValue(key, buffer, size);
+    }
+
+    size_t mNumReads = 0;
+};
+
+} // namespace
+
+void TestCASESession::DestinationIdIndexTest(nlTestSuite * inSuite, void * inContext)
+{
+    // Matches Sigma1 destination identifiers on a responder joined to the maximum number of
+    // fabrics, each with a full set of IPK epoch keys, with and without the lookup index,
+    // and reports the time taken by each.
+    constexpr size_t kNumIpks        = GroupDataProvider::KeySet::kEpochKeysMax;
+    constexpr size_t kNumCandidates  = CHIP_CONFIG_MAX_FABRICS * kNumIpks;
+    constexpr FabricId kFabricIdBase = 0x1000;
+    constexpr NodeId kNodeIdBase     = 0xDEDEDEDE00020000;
+
+    const uint8_t kInitiatorRandom[kSigmaParamRandomNumberSize] = { 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8,
+                                                                    0xB1, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8,
+                                                                    0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8,
+                                                                    0xD1, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8 };
+
+    ReadCountingStorageDelegate storage;
+    Credentials::PersistentStorageOpCertStore opCertStore;
+    Crypto::DefaultSessionKeystore sessionKeystore;
+    GroupDataProviderImpl groupDataProvider;
+    FabricTable fabricTable;
+    CASEDestinationIdIndex destinationIdIndex;
+    TestOnlyLocalCertificateAuthority certAuthority;
+
+    NL_TEST_ASSERT(inSuite, InitFabricTable(fabricTable, &storage, /* opKeyStore = */ nullptr, &opCertStore) == CHIP_NO_ERROR);
+    groupDataProvider.SetStorageDelegate(&storage);
+    groupDataProvider.SetSessionKeystore(&sessionKeystore);
+    NL_TEST_ASSERT(inSuite, groupDataProvider.Init() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, certAuthority.Init().IsSuccess());
+
+    uint8_t destinationIds[kNumCandidates][Crypto::kSHA256_Hash_Length];
+    FabricIndex expectedFabricIndices[kNumCandidates];
+    NodeId expectedNodeIds[kNumCandidates];
+
+    for (size_t fabricIdx = 0; fabricIdx < CHIP_CONFIG_MAX_FABRICS; ++fabricIdx)
+    {
+        const FabricId fabricId = kFabricIdBase + fabricIdx;
+        const NodeId nodeId     = kNodeIdBase + fabricIdx;
+
+        Crypto::P256Keypair opKey;
+        Crypto::P256SerializedKeypair opKeySerialized;
+        NL_TEST_ASSERT(inSuite, opKey.Initialize(Crypto::ECPKeyTarget::ECDSA) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, opKey.Serialize(opKeySerialized) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, certAuthority.GenerateNocChain(fabricId, nodeId, opKey.Pubkey()).IsSuccess());
+
+        FabricIndex fabricIndex = kUndefinedFabricIndex;
+        NL_TEST_ASSERT(inSuite,
+                       fabricTable.AddNewFabricForTest(certAuthority.GetRcac(), certAuthority.GetIcac(), certAuthority.GetNoc(),
+                                                       ByteSpan(opKeySerialized.ConstBytes(), opKeySerialized.Length()),
+                                                       &fabricIndex) == CHIP_NO_ERROR);
+        const FabricInfo * fabricInfo = fabricTable.FindFabricWithIndex(fabricIndex);
+        NL_TEST_ASSERT(inSuite, fabricInfo != nullptr);
+        VerifyOrReturn(fabricInfo != nullptr);
+        NL_TEST_ASSERT(inSuite, InitTestIpk(groupDataProvider, *fabricInfo, kNumIpks) == CHIP_NO_ERROR);
+
+        Crypto::P256PublicKey rootPubKey;
+        NL_TEST_ASSERT(inSuite, fabricInfo->FetchRootPubkey(rootPubKey) == CHIP_NO_ERROR);
+
+        // The IPKs are the operational keys derived from the epoch keys set up by InitTestIpk.
+        GroupDataProvider::KeySet ipkKeySet;
+        NL_TEST_ASSERT(inSuite, groupDataProvider.GetIpkKeySet(fabricIndex, ipkKeySet) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, ipkKeySet.num_keys_used == kNumIpks);
+
+        for (size_t keyIdx = 0; keyIdx < kNumIpks; ++keyIdx)
+        {
+            size_t candidateIdx = (fabricIdx * kNumIpks) + keyIdx;
+            MutableByteSpan destinationIdSpan(destinationIds[candidateIdx]);
+            ByteSpan rootPubKeySpan(rootPubKey.ConstBytes(), rootPubKey.Length());
+            NL_TEST_ASSERT(inSuite,
+                           GenerateCaseDestinationId(ByteSpan(ipkKeySet.epoch_keys[keyIdx].key), ByteSpan(kInitiatorRandom),
+                                                     rootPubKeySpan, fabricId, nodeId, destinationIdSpan) == CHIP_NO_ERROR);
+            expectedFabricIndices[candidateIdx] = fabricIndex;
+            expectedNodeIds[candidateIdx]       = nodeId;
+        }
+    }
+
+    CASESession caseSession;
+    caseSession.SetGroupDataProvider(&groupDataProvider);
+    caseSession.mFabricsTable = &fabricTable;
+
+    auto matchAllCandidates = [&]() -> System::Clock::Microseconds64 {
+        System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+        for (size_t candidateIdx = 0; candidateIdx < kNumCandidates; ++candidateIdx)
+        {
+            NL_TEST_ASSERT(inSuite,
+                           caseSession.FindLocalNodeFromDestinationId(ByteSpan(destinationIds[candidateIdx]),
+                                                                      ByteSpan(kInitiatorRandom)) == CHIP_NO_ERROR);
+            NL_TEST_ASSERT(inSuite, caseSession.mFabricIndex == expectedFabricIndices[candidateIdx]);
+            NL_TEST_ASSERT(inSuite, caseSession.mLocalNodeId == expectedNodeIds[candidateIdx]);
+        }
+        return System::SystemClock().GetMonotonicMicroseconds64() - start;
+    };
+
+    System::Clock::Microseconds64 fullScanTime = matchAllCandidates();
+
+    NL_TEST_ASSERT(inSuite, destinationIdIndex.Init(&fabricTable, &groupDataProvider) == CHIP_NO_ERROR);
+    caseSession.SetDestinationIdIndex(&destinationIdIndex);
+    System::Clock::Microseconds64 indexedTime = matchAllCandidates();
+
+    ChipLogProgress(SecureChannel, "Matched %u Sigma1 destination ids over %u fabrics x %u IPKs: full scan %u us, indexed %u us",
+                    static_cast<unsigned>(kNumCandidates), static_cast<unsigned>(CHIP_CONFIG_MAX_FABRICS),
+                    static_cast<unsigned>(kNumIpks), static_cast<unsigned>(fullScanTime.count()),
+                    static_cast<unsigned>(indexedTime.count()));
+
+    // An up to date index neither re-reads the key sets on a hit nor falls back to the full scan on a miss.
+    const uint8_t kUnknownDestinationId[Crypto::kSHA256_Hash_Length] = { 0 };
+    storage.mNumReads                                                = 0;
+    matchAllCandidates();
+    NL_TEST_ASSERT(inSuite,
+                   caseSession.FindLocalNodeFromDestinationId(ByteSpan(kUnknownDestinationId), ByteSpan(kInitiatorRandom)) ==
+                       CHIP_ERROR_KEY_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, storage.mNumReads == 0);
+
+    // A removed IPK key set bumps the key set generation, which makes the index stale.
+    NL_TEST_ASSERT(inSuite,
+                   groupDataProvider.RemoveKeySet(expectedFabricIndices[0], GroupDataProvider::kIdentityProtectionKeySetId) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   caseSession.FindLocalNodeFromDestinationId(ByteSpan(destinationIds[0]), ByteSpan(kInitiatorRandom)) ==
+                       CHIP_ERROR_KEY_NOT_FOUND);
+
+    // A removed fabric must stop matching, while the other fabrics still match.
+    constexpr size_t kLastCandidateIdx = kNumCandidates - 1;
+    NL_TEST_ASSERT(inSuite, fabricTable.Delete(expectedFabricIndices[kLastCandidateIdx]) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   caseSession.FindLocalNodeFromDestinationId(ByteSpan(destinationIds[kLastCandidateIdx]),
+                                                              ByteSpan(kInitiatorRandom)) == CHIP_ERROR_KEY_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite,
+                   caseSession.FindLocalNodeFromDestinationId(ByteSpan(destinationIds[kNumIpks]), ByteSpan(kInitiatorRandom)) ==
+                       CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, caseSession.mFabricIndex == expectedFabricIndices[kNumIpks]);
+
+    caseSession.mFabricsTable = nullptr;
+    caseSession.SetDestinationIdIndex(nullptr);
+    destinationIdIndex.Shutdown();
+    groupDataProvider.Finish();
+}
+
 template <typename Params>
 static CHIP_ERROR EncodeSigma1(MutableByteSpan & buf)
 {
@@ -1222,8 +1573,13 @@ static const nlTest sTests[] =
     NL_TEST_DEF("Handshake",   chip::TestCASESession::SecurePairingHandshakeTest),
     NL_TEST_DEF("ServerHandshake", chip::TestCASESession::SecurePairingHandshakeServerTest),
     NL_TEST_DEF("ClientReceivesBusy", chip::TestCASESession::ClientReceivesBusyTest),
+    NL_TEST_DEF("ReconnectMany", chip::TestCASESession::ReconnectManyTest),
+#if CHIP_CONFIG_ENABLE_CASE_CLIENT_ADMISSION_CONTROL && CONFIG_BUILD_FOR_HOST_UNIT_TEST
+    NL_TEST_DEF("CASEClientAdmission", chip::TestCASESession::CASEClientAdmissionTest),
+#endif // CHIP_CONFIG_ENABLE_CASE_CLIENT_ADMISSION_CONTROL && CONFIG_BUILD_FOR_HOST_UNIT_TEST
     NL_TEST_DEF("Sigma1Parsing", chip::TestCASESession::Sigma1ParsingTest),
     NL_TEST_DEF("DestinationId", chip::TestCASESession::DestinationIdTest),
+    NL_TEST_DEF("DestinationIdIndex", chip::TestCASESession::DestinationIdIndexTest),
     NL_TEST_DEF("SessionResumptionStorage", chip::TestCASESession::SessionResumptionStorage),
 #if CONFIG_BUILD_FOR_HOST_UNIT_TEST
     // This is compiled for host tests which is enough test coverage to ensure updating NOC invalidates
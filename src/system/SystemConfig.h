@@ -358,6 +358,22 @@
 #define CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE 15
 #endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE */
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_SLAB_CACHE_SIZE
+ *
+ *  @brief
+ *      When packet buffers are allocated from the heap (#CHIP_SYSTEM_CONFIG_PACKETBUFFER_POOL_SIZE is zero), this is the
+ *      number of released buffers kept for reuse in each of the small, MTU and large size classes, instead of being
+ *      returned to the platform allocator.
+ *
+ *      This may be set to zero (0) to allocate and free every packet buffer with Platform::MemoryAlloc() and
+ *      Platform::MemoryFree(). Cached buffers are not freed on Platform::MemoryShutdown(), so the cache should only be
+ *      enabled when blocks of the platform allocator stay valid across it, as they do with malloc.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PACKETBUFFER_SLAB_CACHE_SIZE
+#define CHIP_SYSTEM_CONFIG_PACKETBUFFER_SLAB_CACHE_SIZE 0
+#endif /* CHIP_SYSTEM_CONFIG_PACKETBUFFER_SLAB_CACHE_SIZE */
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_PACKETBUFFER_LWIP_PBUF_RAM
  *
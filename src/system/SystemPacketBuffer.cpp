@@ -41,6 +41,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <limits.h>
 #include <limits>
 #include <stddef.h>
@@ -113,6 +114,139 @@ PacketBuffer * PacketBuffer::BuildFreeList()
 // Heap allocation for PacketBuffer objects.
 //
 
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_SLAB
+//
+// Released heap blocks are kept for reuse in one cache per size class, so that steady traffic does not go through
+// Platform::MemoryAlloc() and Platform::MemoryFree() for every message. Every block of a class has room for the
+// largest buffer of the class, and the class of a buffer is given by its alloc_size, so any cached block can serve
+// any later allocation of its class. The caches are shared by all threads, since buffers are commonly allocated on
+// one thread and released on another, and are deliberately not freed at exit, which may follow MemoryShutdown().
+//
+
+namespace {
+
+constexpr uint16_t kSlabClassCapacity[] = {
+    std::min<uint16_t>(256, PacketBuffer::kMaxSizeWithoutReserve),  // Small: status reports, acks, short commands.
+    std::min<uint16_t>(1280, PacketBuffer::kMaxSizeWithoutReserve), // MTU: anything that fits an IPv6 minimum MTU.
+    PacketBuffer::kMaxSizeWithoutReserve,                           // Large: receive buffers and report chunks.
+};
+constexpr size_t kSlabClassCount = ArraySize(kSlabClassCapacity);
+
+static_assert(kSlabClassCount * CHIP_SYSTEM_CONFIG_PACKETBUFFER_SLAB_CACHE_SIZE <= CHIP_SYS_STATS_COUNT_MAX,
+              "Cached packet buffers must be countable by SystemStats");
+
+size_t SlabClass(size_t aAllocSize)
+{
+    size_t sizeClass = 0;
+    while (sizeClass < kSlabClassCount - 1 && kSlabClassCapacity[sizeClass] < aAllocSize)
+    {
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+struct SlabCache
+{
+    SlabCache()
+    {
+#if !CHIP_SYSTEM_CONFIG_NO_LOCKING
+        Mutex::Init(mMutex);
+#endif // !CHIP_SYSTEM_CONFIG_NO_LOCKING
+    }
+
+    void Lock()
+    {
+#if !CHIP_SYSTEM_CONFIG_NO_LOCKING
+        mMutex.Lock();
+#endif // !CHIP_SYSTEM_CONFIG_NO_LOCKING
+    }
+
+    void Unlock()
+    {
+#if !CHIP_SYSTEM_CONFIG_NO_LOCKING
+        mMutex.Unlock();
+#endif // !CHIP_SYSTEM_CONFIG_NO_LOCKING
+    }
+
+#if !CHIP_SYSTEM_CONFIG_NO_LOCKING
+    Mutex mMutex;
+#endif // !CHIP_SYSTEM_CONFIG_NO_LOCKING
+    PacketBuffer * mFreeList[kSlabClassCount] = {};
+    uint16_t mCount[kSlabClassCount]          = {};
+};
+
+SlabCache sSlabCache;
+
+} // namespace
+
+PacketBuffer * PacketBuffer::SlabAllocate(size_t aAllocSize)
+{
+    const size_t sizeClass = SlabClass(aAllocSize);
+
+    sSlabCache.Lock();
+    PacketBuffer * lPacket = sSlabCache.mFreeList[sizeClass];
+    if (lPacket != nullptr)
+    {
+        sSlabCache.mFreeList[sizeClass] = lPacket->ChainedBuffer();
+        sSlabCache.mCount[sizeClass]--;
+        SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumCachedPacketBufs);
+    }
+    sSlabCache.Unlock();
+
+    if (lPacket == nullptr)
+    {
+        lPacket = reinterpret_cast<PacketBuffer *>(
+            chip::Platform::MemoryAlloc(PacketBuffer::kStructureSize + kSlabClassCapacity[sizeClass]));
+    }
+    return lPacket;
+}
+
+void PacketBuffer::SlabRelease(PacketBuffer * aPacket, size_t aSizeClass)
+{
+    sSlabCache.Lock();
+    if (sSlabCache.mCount[aSizeClass] < CHIP_SYSTEM_CONFIG_PACKETBUFFER_SLAB_CACHE_SIZE)
+    {
+        aPacket->next                    = sSlabCache.mFreeList[aSizeClass];
+        sSlabCache.mFreeList[aSizeClass] = aPacket;
+        sSlabCache.mCount[aSizeClass]++;
+        SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumCachedPacketBufs);
+        aPacket = nullptr;
+    }
+    sSlabCache.Unlock();
+
+    if (aPacket != nullptr)
+    {
+        chip::Platform::MemoryFree(aPacket);
+    }
+}
+
+void PacketBuffer::SlabReleaseAll()
+{
+    PacketBuffer * lFreeList[kSlabClassCount];
+
+    sSlabCache.Lock();
+    for (size_t i = 0; i < kSlabClassCount; i++)
+    {
+        lFreeList[i]            = sSlabCache.mFreeList[i];
+        sSlabCache.mFreeList[i] = nullptr;
+        sSlabCache.mCount[i]    = 0;
+    }
+    SYSTEM_STATS_RESET(chip::System::Stats::kSystemLayer_NumCachedPacketBufs);
+    sSlabCache.Unlock();
+
+    for (PacketBuffer * lPacket : lFreeList)
+    {
+        while (lPacket != nullptr)
+        {
+            PacketBuffer * lNextPacket = lPacket->ChainedBuffer();
+            chip::Platform::MemoryFree(lPacket);
+            lPacket = lNextPacket;
+        }
+    }
+}
+
+#endif // CHIP_SYSTEM_PACKETBUFFER_FROM_SLAB
+
 #if CHIP_SYSTEM_PACKETBUFFER_HAS_CHECK
 void PacketBuffer::InternalCheck(const PacketBuffer * buffer)
 {
@@ -146,8 +280,18 @@ void PacketBufferHandle::InternalRightSize()
         return;
     }
 
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_SLAB
+    // Within a size class the block stays the same, so a copy would save nothing.
+    if (SlabClass(usedSize) == SlabClass(mBuffer->alloc_size))
+    {
+        return;
+    }
+
+    PacketBuffer * newBuffer = PacketBuffer::SlabAllocate(usedSize);
+#else
     const size_t blockSize   = usedSize + PacketBuffer::kStructureSize;
     PacketBuffer * newBuffer = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(blockSize));
+#endif // CHIP_SYSTEM_PACKETBUFFER_FROM_SLAB
     if (newBuffer == nullptr)
     {
         ChipLogError(chipSystemLayer, "PacketBuffer: pool EMPTY.");
@@ -525,6 +669,12 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
 
     UNLOCK_BUF_POOL();
 
+#elif CHIP_SYSTEM_PACKETBUFFER_FROM_SLAB
+
+    static_cast<void>(lBlockSize);
+    lPacket = PacketBuffer::SlabAllocate(lAllocSize);
+    SYSTEM_STATS_INCREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
+
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
 
     lPacket = reinterpret_cast<PacketBuffer *>(chip::Platform::MemoryAlloc(lBlockSize));
@@ -551,6 +701,13 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
     return PacketBufferHandle(lPacket);
 }
 
+void PacketBufferHandle::ReleaseCachedBuffers()
+{
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_SLAB
+    PacketBuffer::SlabReleaseAll();
+#endif
+}
+
 PacketBufferHandle PacketBufferHandle::NewWithData(const void * aData, size_t aDataSize, uint16_t aAdditionalSize,
                                                    uint16_t aReservedSize)
 {
@@ -606,11 +763,16 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
             SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
             ::chip::Platform::MemoryDebugCheckPointer(aPacket, aPacket->alloc_size + kStructureSize);
+#endif
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_SLAB
+            const size_t lSizeClass = SlabClass(aPacket->alloc_size);
 #endif
             aPacket->Clear();
 #if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
             aPacket->next = sFreeList;
             sFreeList     = aPacket;
+#elif CHIP_SYSTEM_PACKETBUFFER_FROM_SLAB
+            SlabRelease(aPacket, lSizeClass);
 #elif CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP
             chip::Platform::MemoryFree(aPacket);
 #endif
@@ -373,6 +373,12 @@ private:
     static void InternalCheck(const PacketBuffer * buffer);
 #endif
 
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_SLAB
+    static PacketBuffer * SlabAllocate(size_t aAllocSize);
+    static void SlabRelease(PacketBuffer * aPacket, size_t aSizeClass);
+    static void SlabReleaseAll();
+#endif // CHIP_SYSTEM_PACKETBUFFER_FROM_SLAB
+
     void AddRef();
     bool HasSoleOwnership() const { return (this->ref == 1); }
     static void Free(PacketBuffer * aPacket);
@@ -633,6 +639,12 @@ public:
     static PacketBufferHandle NewWithData(const void * aData, size_t aDataSize, uint16_t aAdditionalSize = 0,
                                           uint16_t aReservedSize = PacketBuffer::kDefaultHeaderReserve);
 
+    /**
+     * Frees the released buffers kept for reuse by the heap slab cache (see #CHIP_SYSTEM_CONFIG_PACKETBUFFER_SLAB_CACHE_SIZE),
+     * e.g. when memory is needed for something else. Does nothing in other configurations.
+     */
+    static void ReleaseCachedBuffers();
+
     /**
      * Creates a copy of a packet buffer (or chain).
      *
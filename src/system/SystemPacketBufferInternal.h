@@ -42,6 +42,17 @@
 #define CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP 0
 #endif
 
+/**
+ * CHIP_SYSTEM_PACKETBUFFER_FROM_SLAB
+ *
+ * True if heap-allocated packet buffers are sized by class and cached for reuse when released.
+ */
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_HEAP && (CHIP_SYSTEM_CONFIG_PACKETBUFFER_SLAB_CACHE_SIZE > 0)
+#define CHIP_SYSTEM_PACKETBUFFER_FROM_SLAB 1
+#else
+#define CHIP_SYSTEM_PACKETBUFFER_FROM_SLAB 0
+#endif
+
 /**
  * CHIP_SYSTEM_PACKETBUFFER_FROM_CHIP_POOL
  *
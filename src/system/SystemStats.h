@@ -58,6 +58,9 @@ enum
 #undef LWIP_PBUF_MEMPOOL
 #else
     kSystemLayer_NumPacketBufs,
+#endif
+#if CHIP_SYSTEM_CONFIG_PACKETBUFFER_SLAB_CACHE_SIZE > 0
+    kSystemLayer_NumCachedPacketBufs,
 #endif
     kSystemLayer_NumTimers,
 #if INET_CONFIG_NUM_TCP_ENDPOINTS
@@ -39,7 +39,9 @@
 #include <lib/support/UnitTestContext.h>
 #include <lib/support/UnitTestRegistration.h>
 #include <platform/CHIPDeviceLayer.h>
+#include <system/SystemClock.h>
 #include <system/SystemPacketBuffer.h>
+#include <system/SystemStats.h>
 
 #if CHIP_SYSTEM_CONFIG_USE_LWIP
 #include <lwip/init.h>
@@ -134,6 +136,8 @@ public:
     static void CheckHandleCloneData(nlTestSuite * inSuite, void * inContext);
     static void CheckPacketBufferWriter(nlTestSuite * inSuite, void * inContext);
     static void CheckBuildFreeList(nlTestSuite * inSuite, void * inContext);
+    static void CheckSlabCache(nlTestSuite * inSuite, void * inContext);
+    static void CheckSendReceiveBenchmark(nlTestSuite * inSuite, void * inContext);
 
     static void PrintHandle(const char * tag, const PacketBuffer * buffer)
     {
@@ -1966,6 +1970,92 @@ void PacketBufferTest::CheckPacketBufferWriter(nlTestSuite * inSuite, void * inC
     NL_TEST_ASSERT(inSuite, memcmp(yayBuffer->Start(), kPayload, sizeof kPayload) == 0);
 }
 
+/**
+ *  Test the heap slab cache.
+ *
+ *  Description: Released buffers are reused by later allocations of the same size class, not by allocations of other
+ *               classes, and no more than CHIP_SYSTEM_CONFIG_PACKETBUFFER_SLAB_CACHE_SIZE buffers are kept per class.
+ */
+void PacketBufferTest::CheckSlabCache(nlTestSuite * inSuite, void * inContext)
+{
+#if CHIP_SYSTEM_PACKETBUFFER_FROM_SLAB
+    PacketBufferHandle::ReleaseCachedBuffers();
+
+    PacketBufferHandle handle = PacketBufferHandle::New(100, 0);
+    PacketBuffer * buffer     = handle.mBuffer;
+    NL_TEST_ASSERT(inSuite, buffer != nullptr);
+    handle = nullptr;
+
+    // Another size class does not take the cached buffer.
+    handle = PacketBufferHandle::New(PacketBuffer::kMaxSizeWithoutReserve, 0);
+    NL_TEST_ASSERT(inSuite, handle.mBuffer != buffer);
+    handle = nullptr;
+
+    // Any size of the same class does, and keeps the requested size.
+    handle = PacketBufferHandle::New(200, 0);
+    NL_TEST_ASSERT(inSuite, handle.mBuffer == buffer);
+    NL_TEST_ASSERT(inSuite, handle->AvailableDataLength() == 200);
+    handle = nullptr;
+
+    // The cache of a class is bounded.
+    constexpr size_t kBufferCount = CHIP_SYSTEM_CONFIG_PACKETBUFFER_SLAB_CACHE_SIZE + 2;
+    PacketBufferHandle buffers[kBufferCount];
+    for (auto & b : buffers)
+    {
+        b = PacketBufferHandle::New(10, 0);
+        NL_TEST_ASSERT(inSuite, !b.IsNull());
+    }
+    for (auto & b : buffers)
+    {
+        b = nullptr;
+    }
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    // Besides the small buffers, one buffer is cached in the large class.
+    NL_TEST_ASSERT(inSuite,
+                   chip::System::Stats::GetResourcesInUse()[chip::System::Stats::kSystemLayer_NumCachedPacketBufs] ==
+                       CHIP_SYSTEM_CONFIG_PACKETBUFFER_SLAB_CACHE_SIZE + 1);
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+    PacketBufferHandle::ReleaseCachedBuffers();
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    NL_TEST_ASSERT(inSuite,
+                   chip::System::Stats::GetResourcesInUse()[chip::System::Stats::kSystemLayer_NumCachedPacketBufs] == 0);
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+#endif // CHIP_SYSTEM_PACKETBUFFER_FROM_SLAB
+}
+
+/**
+ *  Measure the buffer work of exchanging messages.
+ *
+ *  Description: For every message, allocate a maximum-size receive buffer, clone the received message as a layer
+ *               keeping a copy would, and allocate a response. Logs the average time per message.
+ */
+void PacketBufferTest::CheckSendReceiveBenchmark(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kMessageCount     = 10000;
+    static const uint8_t kRequest[100] = { 1 };
+    static const uint8_t kResponse[60] = { 2 };
+
+    chip::System::Clock::Microseconds64 start = chip::System::SystemClock().GetMonotonicMicroseconds64();
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        PacketBufferHandle received = PacketBufferHandle::New(PacketBuffer::kMaxSizeWithoutReserve, 0);
+        NL_TEST_ASSERT(inSuite, !received.IsNull());
+        memcpy(received->Start(), kRequest, sizeof(kRequest));
+        received->SetDataLength(sizeof(kRequest));
+
+        PacketBufferHandle copy = received.CloneData();
+        NL_TEST_ASSERT(inSuite, !copy.IsNull());
+
+        PacketBufferHandle response = PacketBufferHandle::NewWithData(kResponse, sizeof(kResponse));
+        NL_TEST_ASSERT(inSuite, !response.IsNull());
+    }
+    chip::System::Clock::Microseconds64 elapsed = chip::System::SystemClock().GetMonotonicMicroseconds64() - start;
+
+    printf("Send/receive: %u messages, %u ns per message\n", static_cast<unsigned>(kMessageCount),
+           static_cast<unsigned>(elapsed.count() * 1000 / kMessageCount));
+}
+
 /**
  *   Test Suite. It lists all the test functions.
  */
@@ -2006,6 +2096,8 @@ const nlTest sTests[] =
     NL_TEST_DEF("PacketBuffer::HandleRightSize",        PacketBufferTest::CheckHandleRightSize),
     NL_TEST_DEF("PacketBuffer::HandleCloneData",        PacketBufferTest::CheckHandleCloneData),
     NL_TEST_DEF("PacketBuffer::PacketBufferWriter",     PacketBufferTest::CheckPacketBufferWriter),
+    NL_TEST_DEF("PacketBuffer::SlabCache",              PacketBufferTest::CheckSlabCache),
+    NL_TEST_DEF("PacketBuffer::SendReceiveBenchmark",   PacketBufferTest::CheckSendReceiveBenchmark),
 
     NL_TEST_SENTINEL()
 };
@@ -33,6 +33,7 @@
 #include <app/util/basic-types.h>
 #include <credentials/GroupDataProvider.h>
 #include <inttypes.h>
+#include <lib/core/CHIPEncoding.h>
 #include <lib/core/CHIPKeyIds.h>
 #include <lib/core/Global.h>
 #include <lib/support/CodeUtils.h>
@@ -787,6 +788,46 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & partialPa
     }
 }
 
+/**
+ * Helper function to tell, before copying and decrypting a groupcast message, whether it can have been sent
+ * with the given group key: the destination group id, deobfuscated with the privacy key if applicable, must
+ * be the group of the key.  Only the privacy header is deobfuscated, on the stack.
+ *
+ * @param[in] partialPacketHeader The partial packet header with non-obfuscated message fields (result of calling DecodeFixed).
+ * @param[in] msg The received message
+ * @param[in] applyPrivacy Whether to apply privacy deobfuscation
+ * @param[in] mac The MAC of the message
+ * @param[in] groupContext The group context to use for decryption key material
+ *
+ * @return false if the message was not sent with the given group key
+ * @return true if the message needs to be decrypted to tell
+ */
+static bool GroupKeyMatchesDestination(const PacketHeader & partialPacketHeader, const System::PacketBufferHandle & msg,
+                                       bool applyPrivacy, const MessageAuthenticationCode & mac,
+                                       const Credentials::GroupDataProvider::GroupSession & groupContext)
+{
+    // The destination group id is the last field of the privacy header, leave any other layout to the full decoding.
+    VerifyOrReturnValue(partialPacketHeader.HasDestinationGroupId() && !partialPacketHeader.HasDestinationNodeId(), true);
+
+    uint8_t privacyHeader[PacketHeader::kPrivacyHeaderMinLength + sizeof(NodeId) + sizeof(GroupId)];
+    size_t privacyLength = partialPacketHeader.PrivacyHeaderLength();
+    VerifyOrReturnValue(privacyLength <= sizeof(privacyHeader), true);
+    VerifyOrReturnValue(PacketHeader::kPrivacyHeaderOffset + privacyLength <= msg->DataLength(), true);
+    memcpy(privacyHeader, partialPacketHeader.PrivacyHeader(msg->Start()), privacyLength);
+
+    if (applyPrivacy)
+    {
+        CryptoContext context(groupContext.keyContext);
+        if (CHIP_NO_ERROR != context.PrivacyDecrypt(privacyHeader, privacyLength, privacyHeader, partialPacketHeader, mac))
+        {
+            return false;
+        }
+    }
+
+    GroupId groupId = Encoding::LittleEndian::Get16(&privacyHeader[privacyLength - sizeof(GroupId)]);
+    return groupId == groupContext.group_id;
+}
+
 /**
  * Helper function to implement a single attempt to decrypt a groupcast message
  * using the given group key and privacy setting.
@@ -889,20 +930,23 @@ void SessionManager::SecureGroupMessageDispatch(const PacketHeader & partialPack
     bool decrypted = false;
     while (!decrypted && iter->Next(groupContext))
     {
-        CryptoContext context(groupContext.keyContext);
-        msgCopy = msg.CloneData();
-        if (msgCopy.IsNull())
+        // Only copy the message for the keys of the message's group, the decryption is done in place.
+        bool privacy = partialPacketHeader.HasPrivacyFlag();
+        if (GroupKeyMatchesDestination(partialPacketHeader, msg, privacy, mac, groupContext))
         {
-            ChipLogError(Inet, "Failed to clone Groupcast message buffer. Discarding.");
-            return;
-        }
+            msgCopy = msg.CloneData();
+            if (msgCopy.IsNull())
+            {
+                ChipLogError(Inet, "Failed to clone Groupcast message buffer. Discarding.");
+                return;
+            }
 
-        bool privacy = partialPacketHeader.HasPrivacyFlag();
-        decrypted =
-            GroupKeyDecryptAttempt(partialPacketHeader, packetHeaderCopy, payloadHeader, privacy, msgCopy, mac, groupContext);
+            decrypted =
+                GroupKeyDecryptAttempt(partialPacketHeader, packetHeaderCopy, payloadHeader, privacy, msgCopy, mac, groupContext);
+        }
 
 #if CHIP_CONFIG_PRIVACY_ACCEPT_NONSPEC_SVE2
-        if (privacy && !decrypted)
+        if (privacy && !decrypted && GroupKeyMatchesDestination(partialPacketHeader, msg, false, mac, groupContext))
         {
             // Try processing the P=1 message again without privacy as a work-around for invalid early-SVE2 nodes.
             msgCopy = msg.CloneData();
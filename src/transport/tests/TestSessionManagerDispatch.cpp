@@ -34,6 +34,7 @@
 #include <lib/support/UnitTestContext.h>
 #include <lib/support/UnitTestRegistration.h>
 #include <protocols/secure_channel/MessageCounterManager.h>
+#include <system/SystemClock.h>
 #include <transport/SessionManager.h>
 #include <transport/TransportMgr.h>
 #include <transport/tests/LoopbackTransportManager.h>
@@ -511,8 +512,14 @@ void TestSessionManagerInit(nlTestSuite * inSuite, TestContext & ctx, SessionMan
     static secure_channel::MessageCounterManager gMessageCounterManager;
     static chip::TestPersistentStorageDelegate deviceStorage;
     static chip::Crypto::DefaultSessionKeystore sessionKeystore;
+    static bool fabricTableHolderInitialized = false;
 
-    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == fabricTableHolder.Init());
+    // The fabric table and group data provider are shared by all the tests of the suite.
+    if (!fabricTableHolderInitialized)
+    {
+        NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == fabricTableHolder.Init());
+        fabricTableHolderInitialized = true;
+    }
     NL_TEST_ASSERT(inSuite,
                    CHIP_NO_ERROR ==
                        sessionManager.Init(&ctx.GetSystemLayer(), &ctx.GetTransportMgr(), &gMessageCounterManager, &deviceStorage,
@@ -609,6 +616,63 @@ void TestSessionManagerDispatch(nlTestSuite * inSuite, void * inContext)
     sessionManager.Shutdown();
 }
 
+#if !CHIP_CONFIG_SECURITY_TEST_MODE
+void TestSessionManagerGroupcastIngress(nlTestSuite * inSuite, void * inContext)
+{
+    constexpr size_t kMessageCount = 500;
+
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    SessionManager sessionManager;
+    TestSessionManagerCallback callback;
+
+    TestSessionManagerInit(inSuite, ctx, sessionManager);
+    sessionManager.SetMessageDelegate(&callback);
+    callback.mSuite = inSuite;
+
+    unsigned testVectorIndex = 0;
+    while (testVectorIndex < theMessageTestVectorLength &&
+           strcmp(theMessageTestVector[testVectorIndex].name, "private group message") != 0)
+    {
+        testVectorIndex++;
+    }
+    NL_TEST_ASSERT(inSuite, testVectorIndex < theMessageTestVectorLength);
+    VerifyOrReturn(testVectorIndex < theMessageTestVectorLength);
+    MessageTestEntry & testEntry = theMessageTestVector[testVectorIndex];
+    callback.ResetTest(testVectorIndex);
+
+    // Map the message's key set to as many groups as possible, the message's group last, so that every message has
+    // several candidate group sessions with the same session id.
+    SessionHolder testGroupSession;
+    GroupDataProvider * provider = GetGroupDataProvider();
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == InjectGroupSessionWithTestKey(testGroupSession, testEntry));
+    NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == provider->RemoveGroupKeys(kFabricIndex));
+    for (uint16_t i = 0; i < kMaxGroupsPerFabric; i++)
+    {
+        GroupId groupId = (i + 1 < kMaxGroupsPerFabric) ? static_cast<GroupId>(0x100 + i) : testEntry.groupId;
+        NL_TEST_ASSERT(inSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabricIndex, i, GroupKey(groupId, 0)));
+    }
+
+    const PeerAddress peerAddress       = AddressFromString(testEntry.peerAddr);
+    System::Clock::Microseconds64 start = System::SystemClock().GetMonotonicMicroseconds64();
+    for (size_t i = 0; i < kMessageCount; i++)
+    {
+        System::PacketBufferHandle msg =
+            MessagePacketBuffer::NewWithData(reinterpret_cast<const uint8_t *>(testEntry.privacy), testEntry.privacyLength);
+        NL_TEST_ASSERT(inSuite, !msg.IsNull());
+        sessionManager.OnMessageReceived(peerAddress, std::move(msg));
+    }
+    System::Clock::Microseconds64 elapsed = System::SystemClock().GetMonotonicMicroseconds64() - start;
+
+    // The same message counter is sent every time, at most the first message can be delivered.
+    NL_TEST_ASSERT(inSuite, callback.NumMessagesReceived() <= 1);
+    ChipLogProgress(Test, "Groupcast ingress: %u messages, %u candidate group sessions each, %u us per message",
+                    static_cast<unsigned>(kMessageCount), static_cast<unsigned>(kMaxGroupsPerFabric),
+                    static_cast<unsigned>(elapsed.count() / kMessageCount));
+
+    sessionManager.Shutdown();
+}
+#endif // !CHIP_CONFIG_SECURITY_TEST_MODE
+
 // ============================================================================
 //              Test Suite Instrumenation
 // ============================================================================
@@ -638,6 +702,9 @@ int Finalize(void * aContext)
 const nlTest sTests[] =
 {
     NL_TEST_DEF("Test Session Manager Dispatch",  TestSessionManagerDispatch),
+#if !CHIP_CONFIG_SECURITY_TEST_MODE
+    NL_TEST_DEF("Test Session Manager Groupcast Ingress",  TestSessionManagerGroupcastIngress),
+#endif // !CHIP_CONFIG_SECURITY_TEST_MODE
 
     NL_TEST_SENTINEL()
 };